@@ -0,0 +1,5 @@
+int plain;
+char *backslash = "\\"; int after_backslash;
+int tilde = ~0;
+/* { */ int japanese;
+int mixed; /* \ { ~ */
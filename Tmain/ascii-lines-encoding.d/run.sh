@@ -0,0 +1,19 @@
+# Copyright: 2026 Universal Ctags Team
+# License: GPL-2
+
+CTAGS=$1
+
+. ../utils.sh
+
+if ${CTAGS} --quiet --options=NONE --list-features | grep -q multibyte ; then
+	# Shift_JIS turns '\' and '~' into other characters: the lines having
+	# them must go through iconv even if they are made only of ASCII.
+	${CTAGS} --quiet --options=NONE --sort=no \
+			 --input-encoding=SHIFT_JIS --output-encoding=UTF-8 \
+			 -o - input.c
+	${CTAGS} --quiet --options=NONE --sort=no \
+			 --input-encoding=CP932 --output-encoding=UTF-8 \
+			 -o - input.c
+else
+	skip "multibyte feature is not available"
+fi
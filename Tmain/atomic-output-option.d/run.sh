@@ -0,0 +1,42 @@
+#!/bin/sh
+# Copyright: 2026 Universal Ctags Team
+# License: GPL-2
+
+CTAGS=$1
+. ../utils.sh
+
+O="--quiet --options=NONE --pseudo-tags="
+
+D=/tmp/ctags-tmain-$$
+mkdir -p $D
+printf 'int a;\n' > $D/a.c
+printf 'int b;\n' > $D/b.c
+
+cd $D || exit 1
+
+echo '# writing'
+${CTAGS} $O --atomic-output -o tags a.c
+cat tags
+echo '# replacing'
+${CTAGS} $O --atomic-output -o tags b.c
+cat tags
+echo '# appending'
+${CTAGS} $O --atomic-output --append -o tags a.c
+cat tags
+echo '# updating'
+printf 'int c;\n' > b.c
+${CTAGS} $O --atomic-output --update -o tags b.c
+cat tags
+echo '# unsorted'
+${CTAGS} $O --atomic-output --sort=no -o u.tags b.c a.c
+cat u.tags
+echo '# with a name index'
+${CTAGS} $O --atomic-output --name-index -o i.tags b.c a.c
+echo '# etags'
+${CTAGS} $O --atomic-output -e -o TAGS a.c
+cat TAGS
+echo '# files left'
+ls
+
+cd /
+rm -rf $D
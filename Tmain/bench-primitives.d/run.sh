@@ -0,0 +1,10 @@
+# Copyright: 2026 Universal Ctags Team
+# License: GPL-2
+
+CTAGS=$1
+
+# The names and the units, without the times
+${CTAGS} --quiet --options=NONE --_bench-primitives=vstring.new-delete,mio.getc,keyword \
+	| awk '{print $1, $3}'
+
+${CTAGS} --quiet --options=NONE --_bench-primitives=mio.get
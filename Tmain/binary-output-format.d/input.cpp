@@ -0,0 +1,15 @@
+namespace N {
+	struct Point {
+		int x;
+		int y;
+	};
+
+	int x (const Point &p);
+}
+
+static int y;
+
+int N::x (const Point &p)
+{
+	return p.x + y;
+}
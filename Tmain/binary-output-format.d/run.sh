@@ -0,0 +1,26 @@
+# Copyright: 2026 Universal Ctags Team
+# License: GPL-2
+
+CTAGS=$1
+
+O=/tmp/ctags-tmain-$$.bin
+
+echo '# file'
+${CTAGS} --quiet --options=NONE --output-format=binary --extras=+fq -o $O input.cpp &&
+	${CTAGS} --quiet --options=NONE --_dump-binary-index=$O
+
+echo '# overwriting'
+${CTAGS} --quiet --options=NONE --output-format=binary --sort=yes -o $O input.cpp &&
+	${CTAGS} --quiet --options=NONE --_dump-binary-index=$O
+
+echo '# stdout'
+${CTAGS} --quiet --options=NONE --output-format=binary -o - input.cpp > $O &&
+	${CTAGS} --quiet --options=NONE --_dump-binary-index=$O
+
+echo '# append'
+${CTAGS} --quiet --options=NONE --output-format=binary --append -o $O input.cpp 2>&1
+
+echo '# not an index'
+${CTAGS} --quiet --options=NONE --_dump-binary-index=input.cpp 2>&1
+
+rm -f $O
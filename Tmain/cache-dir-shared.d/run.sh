@@ -0,0 +1,25 @@
+# Copyright: 2026 Universal Ctags Team
+# License: GPL-2
+
+CTAGS=$1
+
+O="--quiet --options=NONE"
+D=./cache
+
+rm -rf $D
+
+run()
+{
+	t=$1
+	shift
+	echo "#" -o $t "$@"
+	${CTAGS} $O --cache-dir=$D --verbose -o $t "$@" 2>&1 | grep '^reusing' | sort
+}
+
+run a.tags src/a.c src/common.h
+run b.tags src/b.c src/common.h
+run b.tags --param-CPreProcessor:define=N=2 src/b.c src/common.h
+run src/c.tags --tag-relative=yes src/common.h
+run src/d.tags --tag-relative=yes src/common.h
+
+rm -rf $D a.tags b.tags src/c.tags src/d.tags
@@ -0,0 +1,3 @@
+#define N 1
+struct common { int x; };
+int common_f (void);
@@ -0,0 +1,30 @@
+# Copyright: 2026 Universal Ctags Team
+# License: GPL-2
+
+CTAGS=$1
+
+O="--quiet --options=NONE"
+D=./cache
+
+rm -rf $D src/c.sh
+
+run()
+{
+	echo "#" "$@"
+	${CTAGS} $O --cache-dir=$D --verbose "$@" -R -o cached.tags src 2>&1 | grep '^reusing' | sort
+	${CTAGS} $O "$@" -R -o plain.tags src
+	if cmp plain.tags cached.tags > /dev/null; then
+		echo same
+	else
+		diff -u plain.tags cached.tags
+	fi
+}
+
+run
+run
+echo 'c () { :; }' > src/c.sh
+run
+run --fields=+n
+run --fields=+n
+
+rm -rf $D src/c.sh cached.tags plain.tags
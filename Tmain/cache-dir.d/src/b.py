@@ -0,0 +1,3 @@
+class B:
+    def m(self):
+        pass
@@ -0,0 +1,15 @@
+# A remote tag cache kept in the directory $1
+while read command key path; do
+	case $command in
+		get)
+			if cp "$1/$key" "$path" 2> /dev/null; then
+				echo hit
+			else
+				echo miss
+			fi
+			;;
+		put)
+			cp "$path" "$1/$key"
+			;;
+	esac
+done
@@ -0,0 +1,25 @@
+# Copyright: 2026 Universal Ctags Team
+# License: GPL-2
+
+CTAGS="$1 --quiet --options=NONE"
+
+O=/tmp/ctags-tmain-$$
+rm -rf $O.local1 $O.local2 $O.local3 $O.remote
+mkdir $O.remote
+
+echo '# store'
+${CTAGS} --cache-dir=$O.local1 --cache-remote="sh remote.sh $O.remote" -o - input.c
+ls $O.remote | wc -l
+
+# An empty cache directory gets the entry of the remote cache.
+echo '# fetch'
+${CTAGS} --verbose --cache-dir=$O.local2 --cache-remote="sh remote.sh $O.remote" -o - input.c 2>&1 \
+	| grep -e '^reusing' -e 'input\.c	'
+ls $O.local2 | wc -l
+
+# A helper which is gone is not asked again.
+echo '# gone'
+${CTAGS} --cache-dir=$O.local3 --cache-remote=true -o - input.c input.c 2>&1 \
+	| sed -e 's/^.*remote tag cache/remote tag cache/'
+
+rm -rf $O.local1 $O.local2 $O.local3 $O.remote
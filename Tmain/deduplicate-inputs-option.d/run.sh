@@ -0,0 +1,27 @@
+#!/bin/sh
+# Copyright: 2026 Universal Ctags Team
+# License: GPL-2
+
+CTAGS=$1
+. ../utils.sh
+
+O="--quiet --options=NONE --sort=no --extras=+f --fields=+e"
+
+D=/tmp/ctags-tmain-$$
+mkdir -p $D/v1/lib $D/v2/lib $D/v3/lib
+printf 'int foo(void) { return 0; }\nstruct s { int m; };\n' > $D/v1/lib/x.c
+cp $D/v1/lib/x.c $D/v2/lib/x.c
+# The same contents, but another base name: another parser
+cp $D/v1/lib/x.c $D/v3/lib/x.h
+
+cd $D || exit 1
+
+echo '# --deduplicate-inputs'
+${CTAGS} $O --verbose --deduplicate-inputs -f dedup.tags v1/lib/x.c v2/lib/x.c v3/lib/x.h 2>&1 \
+	| grep '^reusing'
+${CTAGS} $O -f plain.tags v1/lib/x.c v2/lib/x.c v3/lib/x.h
+cmp dedup.tags plain.tags && echo same as parsing all the files
+grep v2/lib dedup.tags
+
+cd /
+rm -rf $D
@@ -0,0 +1,36 @@
+#!/bin/sh
+# Copyright: 2026 Universal Ctags Team
+# License: GPL-2
+
+CTAGS=$1
+. ../utils.sh
+
+O="--quiet --options=NONE --sort=no"
+
+D=/tmp/ctags-tmain-$$
+mkdir -p $D/lib
+printf 'int shared;\nstruct s { int m; };\n' > $D/lib/x.h
+printf 'int a;\n' > $D/a.c
+# A failed pass of the Fortran parser, whose tags are written again
+cp rescan.f90 $D/rescan.f90
+
+cd $D || exit 1
+
+echo '# without --deduplicate-tags'
+${CTAGS} $O -o - lib/x.h a.c lib/x.h | wc -l | tr -d ' '
+echo '# --deduplicate-tags'
+${CTAGS} $O --deduplicate-tags -o - lib/x.h a.c lib/x.h
+echo '# to a file, with --jobs'
+${CTAGS} $O --deduplicate-tags -j 2 -o dedup.tags lib/x.h a.c lib/x.h lib/x.h 2>/dev/null
+grep -v '^!_' dedup.tags
+echo '# rescanning'
+${CTAGS} $O --deduplicate-tags -o rescan.tags rescan.f90
+${CTAGS} $O -o plain.tags rescan.f90
+cmp rescan.tags plain.tags && echo same as without --deduplicate-tags
+echo '# xref'
+${CTAGS} $O --deduplicate-tags -x lib/x.h lib/x.h
+echo '# etags'
+${CTAGS} $O --deduplicate-tags -e -o - lib/x.h
+
+cd /
+rm -rf $D
@@ -0,0 +1,14 @@
+# Copyright: 2026 Universal Ctags Team
+# License: GPL-2
+
+CTAGS=$1
+
+. ../utils.sh
+
+if ! ${CTAGS} --quiet --options=NONE --list-features | grep -q multibyte ; then
+	skip "multibyte feature is not available"
+fi
+
+# The lines of a section are converted once.
+${CTAGS} --quiet --options=NONE --input-encoding=iso-8859-1 --output-encoding=utf-8 \
+		 -e -o - input.c
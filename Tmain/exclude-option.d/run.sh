@@ -0,0 +1,20 @@
+# Copyright: 2026 Universal Ctags Team
+# License: GPL-2
+
+CTAGS=$1
+
+echo '# names, suffixes, and other patterns'
+${CTAGS} --quiet --options=NONE \
+	 --exclude='*.o' --exclude='*.pyc' --exclude=node_modules \
+	 --exclude='test_*' --exclude='*.min.js' --exclude='[Bb]uild' \
+	 -R --print-language input | LC_ALL=C sort
+
+echo '# a path'
+${CTAGS} --quiet --options=NONE \
+	 --exclude=input/a/b \
+	 -R --print-language input | LC_ALL=C sort
+
+echo '# resetting'
+${CTAGS} --quiet --options=NONE \
+	 --exclude='*.o' --exclude= --exclude=node_modules \
+	 -R --print-language input/a input/node_modules | LC_ALL=C sort
@@ -0,0 +1,31 @@
+#!/bin/sh
+# Copyright: 2026 Universal Ctags Team
+# License: GPL-2
+
+CTAGS=$1
+. ../utils.sh
+
+O="--quiet --options=NONE --fields=+n"
+T='--filter-terminator=__END__
+'
+
+D=/tmp/ctags-tmain-$$
+mkdir -p $D
+printf 'int a;\n' > $D/a.c
+printf 'int b;\nint c;\n' > $D/b.c
+printf 'def d():\n    pass\n' > $D/d.py
+
+cd $D || exit 1
+
+echo '# numbered terminators'
+printf 'a.c\n--fields=-n\nb.c\nd.py\n' | ${CTAGS} $O --filter --filter-terminator-id "$T"
+echo '# batched'
+printf 'a.c\n--fields=-n\nb.c\nd.py\n' | ${CTAGS} $O --filter --filter-batch=65536 --filter-terminator-id "$T"
+echo '# no time to keep the tags'
+printf 'a.c\nb.c\nd.py\n' | ${CTAGS} $O --sort=no --filter --filter-batch=4096:0 "$T"
+echo '# invalid'
+${CTAGS} $O --filter --filter-batch=x
+${CTAGS} $O --filter --filter-batch=1:x
+
+cd /
+rm -rf $D
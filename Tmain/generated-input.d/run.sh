@@ -0,0 +1,23 @@
+# Copyright: 2026 Universal Ctags Team
+# License: GPL-2
+
+CTAGS=$1
+
+O="--quiet --options=NONE --kinds-C=+l --kinds-Python=+l -o -"
+
+# gen.c and gen.py are marked as generated, blob.c is made of base64;
+# plain.c is gen.c without its marker.
+echo '# tag'
+${CTAGS} $O --generated-input=tag src/gen.c src/gen.py src/plain.c src/blob.c
+
+echo '# shallow'
+${CTAGS} $O --generated-input=shallow src/gen.c src/gen.py src/plain.c src/blob.c
+
+echo '# skip'
+${CTAGS} $O --generated-input=skip src/gen.c src/gen.py src/plain.c src/blob.c
+
+echo '# skip by size'
+${CTAGS} $O --generated-input=skip --generated-input-size=100 src/plain.c
+
+echo '# invalid'
+${CTAGS} $O --generated-input=drop src/plain.c
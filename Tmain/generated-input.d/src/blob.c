@@ -0,0 +1,107 @@
+static const char blob[] =
+"pU3KGCUwux1tEyze1iN7LtkeP3IfyxlxF0SU1kk8nVw0YL4xIB5p/tqg7ui5mX9cfCmZ/a/lkyU8"
+"1lSvTfrXFCegrrP+6SMvivIhH57kkcWxC+y1Vjv8Hm+TQn7LyP4pVeXNjkbcjtS3wnZNKlpNdncG"
+"+F2GkAJK1r2jQBvpyMvMyTX2zR9hImrhUziuGjQATTO6DSRqwEyBsbryPjv57vX3nytJNK+H9VIL"
+"ablLDZguhbtVtnKocmN6zXRm/LYODo/xhGOw5LK6KXA0dPBkrGj3APWwKz3GZvRb3qosyu3NK1FX"
+"QQ5N7krys09DCgc0R95jbA6AbJV7poTWQx+16tdCTQnhXQJMWEjyPR+m9zYdf2GNFTLnDiDipmaN"
+"5/R+hGflRtU+yOKhJXvbJWybPk+7SYFG73Awy/lTclLczq3XZLajL7sJrerhCcSplyA5dTUrh4sU"
+"XIpC2ITPTP2nLY4dXdkliQgthSpxIoc+6AWt1YlCFno4UoYZXGefnGmU5FuKsQmAEgcJYfN95Dbd"
+"/cmdbnWvZUfPsRtCBySC3FMcK8OQfJYX615QieQBhrqopX0Rnm+2XQCrwyrzjmZ/Ai6HLUnMFckL"
+"mZt3K0/Hpv1MkUoW20cIdSsPFUS4NcDnGQl9+ocB6SMvIfKBJod4aXbr/MMn9ZMXZSdLqYKbRAb2"
+"H/iJMm/6lJLt7u48Zp8r8giU6ifmicZrayYuSIa4Q485unb++MkMUQH75s+aSNWwwKE9qQCmrcs9"
+"ZAaUgb4hyccnuNuMGI80GpJMf4jfoWG/2w7MaCkZ0uZGkvgZQVfx1K+QmIKFz3qa98k9VVImav5w"
+"56rm2kdifC5Zry6jeryEZwrTxNNrwIqtH/+OuEBuL4p/xMzk3Z8LQRDZ8voAJcjv5X83ck9NN+or"
+"FABAdxObQYDfOTIkmWLGhXIABZrrjqF883h+DtKdHAtj/9cpg3TZvXT8Ea3XucplA5Uiaf1mn2N2"
+"7nGHlzf9X3L41RxKyRttDEjUGh5eyeagOShUqGFe7xCfwb+p4lY3ASiPKbPXP2rCtp7dLBnyZL7k"
+"YqW68g/Sfs8UwBHtIB+DYyCtuYurFoaijZgBIQx3NvPuxYDc/EP+XQSbTXino+u5KGXIUX7QIRH2"
+"plLaNSSHK2ox1//kWHdE1et4PpaWj4m+goVl4H5ffXhOkGCnIcqAfXYz7RI0AvN25b8Ulnc9GWFj"
+"Jr5b5YUDNrNvE7yuSBZoghNoBafRvl6fJ2gQ/fcg0DPKTy5Ty4rRkZ3VGp+21NUJumTIz2gD3lDY"
+"Oi7PuutTQgcaSMstvVdKspFSVyI3xPtlmkAW96EbxixScc9k8l1vFcxQxLc/TH5iFROlPMfpnNed"
+"f9nHvOTgWwsB+u545Opb8sw2IkG33Lsu4hQUQiqgKBvBRQ0hOGND+5NUcSGzgVGljOlJgvVqhnmj"
+"vhJlXc5SjqfAVoc6GLjnNYHJvofAvEq4qSnidVoYl4GeoAARcUyU3dW6GEP6dBcLGwG1mza2ctOa"
+"RGi781FEB3xM5jEgSorNhwUcs+P8f1QAFh8Mz195UR01BmRI02bUWZ4gmRj0A8Df7innWXM1hXYT"
+"P6uGGojfh5dvKwdWhXhnUadix6h6wvDxAw3fd51syCdXShANOTZSsEgODxVGFSIXIbpmIcQ2fmlo"
+"ORERLJP0M0MyaJajrNiFCrODkBi8pPOTD9MP3zKx8BhuLpNX3wBnkxsCsvsw+179sYVRkW12/1Q4"
+"Kfs1p7Ywzcos2Ay+aZuG21fCd+tAEbKnT+alVu3gg3ZAq+x5YoiaT09+p7JSeKdghDRUNGTETUua"
+"mN6MZDc2j2nG7REGzN9xl+0LSIPPAnzc13V1XD/o3aCFMtZ8zFCA2PfpCtFdpwXH+jYTgG9SZrIz"
+"6WjzCL2v0ulrXsg+thyBjMPMHwYm1te0hzdym81wyOxsVEIjYvBzSrTT75ZA8LV1iMCB2l/2AY+3"
+"fZqk9fjbK7lOm8UdK6ZHsAcFaySWgDNJd1/nsU5qzlUumGX9bSjgOzyH1ndH8vwd9+9J+37/VANS"
+"pO/+l+6/2tYmXLgOChepMPf4SRFt1ECtMLuu8muR3q/YgBqUlbX8zqqLsGj8PKlioplBLBTMzxnM"
+"mTcDF2HzHsBLKmwU6lkzXBLXMwa8R56Eml7XEaMK3Bv+FDzXz+QiB8ZP89M0KvFsTQfaAgQ+LW8+"
+"QvEJjXzmXxm7SiuW/+uCGhAFHwcox5+fVPkeobzg8FVKO7lT1fTF54uqlY8fqgdNntt+wMbAd+eR"
+"AKSGidhQFZNIS4z/sSv4w2Z3nh3K7mmCBMXrLLUgd8uEpPRnYGxiL1yUubfOTH4W/L82vu0pT6EP"
+"sI8KMBFo+G2Fj9ox5EOCE61mXMEqDhoRver5IMs9LoOjdy3JXeVRvXhxWBODtB4OGIT3HDNKogJl"
+"mOE18aW+g8c/v/bCVuF6SQbvYxJQcCe/R+QxxQsm562ld/Q7u0mpcR1c50rgTIjW0n5PDYqXq1WF"
+"+zei6fc6Th1s9JI9g2e63YV6eTHHlNRTHZZJCOKuR+IAkl+43hTRb41cRlx1WWQoLP2MWWlGYp1n"
+"BSHQHLGrkPwuB9H0RIh/X7sSU74CtuQkPbZ9pMMflTf95A1ECnwtcl1VNJ+ADwkxY4UJ7XrjNLMw"
+"WxeLP+78jzg+Ps9GdHRL7MtUCcfXEsoaua3Ne6vfpM0bpku0f9gFujdfI6bdZgpzR9fL6BcUEYiL"
+"EjOAPgbeeRSTOZyxVT0eiSvuS+E/Q5bQk4x8LJPoccVnu+ub9PCeD3yqcWDEyga0U3qlpvuKkW6X"
+"HQtRIrLhH8bhtTdzT9WstEdnjTDziUHTNALSPP7LTNWPOMLn6pO0lbTIxKQD/8LjmV6bSt/Bdi2p"
+"pXymaNoFDRiD/pmf39zH7bcUs+cFInUy0b/NTmDX+c3hry9XuaK7Jp9ZOJav11CUamDTXR42tBXS"
+"BQGdApvLMgcPZFn+iEll0j5KUDYOMyZX++/cHwalSXm1jVYQiDIgsmLmxQobcMoW4Rt6f3IWUVih"
+"A+mb1oH9InzHcdOezPgLfCxYV7fCXwOUyrk6q8WrziE/2LN9xmHvkbB53xGODK5Pe0IvZIpB4u96"
+"Uby0bs/AapjzaHTnQ4XhvH7ObEA+LorFDkqfB8csWnakYDciuZhiIZ8tc5NAzJC2zu1DjVoPu7PT"
+"DOx/zbQyXZU6inAUzxRS3GWbT8IUn1t0/oLesgA5khUYfTgTo2uwLNXJcY8ustnirucbadtB+mAW"
+"hVlTeIV/Hla3sdIvZ59GRfn3eXsD40SzmURIe6o82VZP7M9pOpQGuPlpFh6Pm2Q4nuU5Uqbj77mU"
+"ViQXBe/4KqmHN/re+mGkBLcukoB9KEYODMpKl7xfVjSep8JetqN1vEW9gXodFTbOGW792P9QmSlI"
+"dFNG4s0tFOH1YW++ARDZSZEkHNetIOAEWlTBlwLismTwK6Xr20/NKR6pmNe89kaZrw5gceUrS77V"
+"uHvhyoU6dFxnOXGBMGCA+nTqczkp0CXhRDo068hXYvMvRr8dz3kYvhUHbeuZPUXaLGc6tVa7rgWC"
+"Pnq+tvoWtDO2pzkRfIK1YuQK4ToK+TglhF5MlMJJgInjBwyvTfn3EBImXcjzUeXJdSa4qG6fQxZs"
+"Vrjvqe/GtaADq/eqdAp/6xdKSYvEiyCGtkcRMGbaMrmQeUgkm665fbPPqx6spfa8fHiyTUVpA+jP"
+"5MqaViFJmp2BriVhKFubtO+22yL4o1mNgwtUiXkKbxjM5WaQMmR7HUIYKCWuRQJgigelDmykpw34"
+"z6xZHdQXLKv9zIPtBg2ioBzUqFAvCU9rSS63udiwTql1hPQQnuiOuYxDgQTzM7lNdM0uDkQ+Hmhd"
+"hLtMWlIOs3zi/22wx+tspQ03ByHNsx50wNHAcg+ACobee3a1aKbZjpj/blD0iEWZkC2pAvh/UqPn"
+"bBpruBfgXd5HmAw5TQREmk20MVbtyy7UrcurEHhnBxNFdtw1ChiiITg9+UXbAVtySzm1/ieybnIl"
+"i1oHh4kjFmQY0LmIBaYV6JCp0onM2KLWxE3GxdFJAnqCwXtlOywRGc+m4qHpAPLwr8J4wbUgyYik"
+"JHKHhvKy9HFIIbpoVrt6WE7rWhakw7nbPtFOgMA0uraa5y2MypTkOeb0WUwDQrv6eb2uw4EJZgCE"
+"HVucjKWCe4fgLvwtZ0HYlL4W4sC7FZfQ3IO0esVCYr4gaKgkKOTCydT+DTfs7N/U8loh4cv7RQR2"
+"Zs0UlqnG6zwucScHNP4tbugcZqv3HNVH0BlKpKthA1+MhiygxIKYytcanZt/wt+DnGdDGmq/7fpI"
+"u65m6RqgBCLRpRKMcOCVZmvoz+NoaB1c3j8ZRiT+XAdU/3GWbFFKaTPuMGcuGdRyg+LZTx1EFVHk"
+"lnejTp6Epm1NdsgQp8JPlXIvZe1MXtyqzToTtD5rJZT6sgn+L2b4j5stZ0fwinSZEDMAsGNNmRlY"
+"qrPm9n6ouls4mCPoMDlSyewSERQx00PUtCe/U7hWLqkC9ZtMhTA2ejtO/oo8pu99UxWDu2WRzmhB"
+"enowBzYb+mt1LFdOhw/ZyTiVPStvd3wffSWsMhVuWZuvK+xdBaLS0BAtfUtVTbBHaGVwqSIB9RP+"
+"qCMgZRm70i+yU/z+RYSbG+5U3sWZOyKBdnpl6nn8GcjKr8LPLHSt2pwCmfoIOPPW0pnqSqttKrXJ"
+"7hCVqy2KX+LQez1uFcBex4qqTblVcrPJnf+jYFPIBABZNX3ogLQzwEWB1Sap44iXuZzAHv/8ugkd"
+"PMHln03qEab3RgOKSWAXyFiPe5UN19Arwvy4jqVS/RixR2YfU51XnxuYxLhfi57zZaTgzjeFucmj"
+"xfGIOWjm0VGhFk2O8NInjMi5ypM+hOYGFZy1uId8IzHTOJ1UWjzOya7MyP+ss19J05NEba0h0yIB"
+"eN3ObYxDTXF6P5ARw5NDxIwii21ynjC4KLgLJD6mbwHqR+SMHuQQFO8493KWrql1b2qQD3JYDonZ"
+"vyCMLTnMx9FzHL6ogCT0RNzo6GGuYTnOVJBjJwjgZWSHZ5cLCCC1adUGh7VTobWcNRZZtdcP6DSv"
+"Nk668fgqrKPzQTeAx2u1gApijt/EUt9ERgY4bcIOBCztFmgkpa3s+GkDfGi1wzUyQGbh6eEiG/BW"
+"zHrw8Ug8/sMgenUCyHITfDBmABPuGM17cBbThhVO7wn1NTFfSVOlNsMBJA8rJxuU6ssDagxf6mo+"
+"ats4LLQwLHozLbyMmp6XS/yrYgMoJhY6bcXp0GsoCx4PRdwcXJbigkSBmbIOpsMwU+JT8qaMfwbT"
+"Cq52tqgAeq8oUjUSoNmsuyA+6lJsG33QLWxvkwaF3Dxa4FWRyH+ugw4ua4RIIyLImycgIgcluSZI"
+"OfyM5lszgpvK0VjjMOuvpWkPxnM2arOrjgVhJS1Qn4ZcF0n2MR3Egi1yHyGXB4lCtbpaRr2AvbtV"
+"OX9UksIPcmNwxLt78YYDGTLBvXiQD/Hg+Ts46/svzzz49Vh22uEfPGEiiLjj8HqtHSRx927AOB7d"
+"HHpXoWwzKvSH7+tDJueiMmmPuCI98/aDXAUM8BB3/0e6SsakFbxddAjqKeZvEpLgR2KboGYhzQxU"
+"Brj3dyH0v/tsbmLwZ57pinOkENBar9MLv1J6AE+E6PPFRoV7PYzVTEZFpB1Vd9hVKefRgXJNidAw"
+"Gt81CJQkk1lG1yXAmTvkfP+9Yt8mgcNcgnnSu4MlHfFspwTj865c7qZ33C1q0c1Ed724wv26QXFu"
+"iDkSRc/XJ/Doqraw36FZ9glSyb07lWh/ZL2aglMh6BdlB9OLDiMCWCt/Alh1WYd5CQw6Ki1lTPCr"
+"JbKjldX1hKocKodThy4gGoZDqK77SGAaTtjFlwh1nyTxMCFNYefvdi/x3kYGYm436nuE2KkdD3UM"
+"cZRs6GJeaJ+FQ1Afc+2tnsuhnByhLZYZpnlNWX3sD2WkPbnznyY2I8bf9yKBceai9Na+5KEaNeks"
+"jkQTQiDuEZkjrt8rSskwGhCTRTYkoVPQVnpYxtqtuT986jsuhMXyc16T7slnQmP7Nq1+DoLwTKSg"
+"WK5g1hwAdrAFghQTp3SiiLuav7TJwZE4dAbSfRpXTZ2BpsLfnUR6rBywWKNHGOmt8Oxtrrh/IDM8"
+"pw0NdL0kIv4aZezNn/TBnvCjsJ+0NiP35NUGdGpqubk/EezdDEPbL16UtjNxHXC73VDCJ9Vnp5qo"
+"X/sFScFUXQg5uRscagtu7E9tSU7gD9lFhI13127vGy8CrlR5gnZZdllnOOxui9ka+gDiLCPUSKPr"
+"V26s0X1ldFLRtt+bnlJv5CtIYqE/l17V9eH48o3xZfFKVncltMQjzjO12au0yE3uAxX0tc3dmFAC"
+"SrvMp3CuUM5dkjtFDaX14f2MugqzpvQ7qoLGhQi9xiK5Bo2qk/1SwQsmYmseR0ufdHAd34c+Nkkt"
+"TN5iFP7F2C9bQJoTKxxSPxMLp1Y57VI2XGW3Zbg93qbI0YHkd/cMWVRcTbMe5BHhB+fgC6zKSxhI"
+"/lnEUAICudRgwtGq9VKhwGGJbAKnooasUfqMKvsXTNsq1JbaAixENMCNOt7igynlvDES/JltIYSO"
+"vWnajumizfI8F0qXG0O0wH+EEeP0DSwpEW7t8CmUr15FPV+FrFRTcvJygIQfcVKaIMTjbDLV8KAe"
+"xHbt9mSEUj2iz1VG8PD8ibwy/qhTrzC8wjlH/5CpxVugDqJo6j+R6b259mVZuGBhmZZ9INcFayRp"
+"PHk4kjNiAIgZ2iyPoATUs1wGZ1tyNGs+iKXEzw0i2TiKS9u6Cw0b2sVSvrtEt72CSFNQTUw4P1Ge"
+"Mf7T7QcdeNhHeQJ7tnsv9Mbbq/MVcRnnehNcZSOFKqktrSjYnSXkfU9YnN2mNttUF/4+UB2RFKsY"
+"NGHPVnVr3YToLnrvAXLLM2XQLJO6q3+IqXETzdXcI08rJB1ihjPD+oFjMv3llSDyQEgi999BDF4X"
+"JjmkehtxibJXu9CNUuDgWwFDLtx4T4U7OsIvcQFOFbUrnKLiZJ9o96xAv7VxjkEL1txeFpaNPOS/"
+"83/AlJbNEIP3pG3nt5zouCy4anfdgrsIix+uuNEQ35x1rqzxN1/5NL1kivkWQ63X4JPXT6BOXVC0"
+"jx99qRJYG9rZYk2/PTmL4cuCCsjHX8IFvjqkqkARYGkKdpYyZnt38aQ+EqYu6z55bOGf1bkHdDup"
+"zHvYfKp7wRObifD17wYbwux0WfDGUTWF4S6f7GwBIi8uXrwC3dLplLK8VjP8Or6Ua3DGt6uMkSu9"
+"OrunRqg6rVLVC7hxzQFSZeS4z4R3WOpUvx0OwHCkzRX+8WVYIllfhEVXoJRE9zhEjJ6aZnHio0C6"
+"/OVUHjYpEEuII1oLCHXhLOh6XWegrQ1DrL4hJAs9GVGVjpksaOGPAh6SdJ0u90nD7cDpZHCPin5E"
+"nMoXcjBv4bzssvgNts1rUbH+z1BO2V7xa2V/tDCHjbI+9pDAb6HfAJqCRkBXlTDe79/fYDNP0lhM"
+"onHexo5MM11hUvNi4fgyCGbjEzTeb5x0WLG+NfUhUJ1OgTMeGWV/aSuCgSyG+l2AAJnscr580zpy"
+"BDqoN+f7C3NrsxKgxtLIcp/VJeHf84xb0NBsGW7sfTwovNwEBoT5UGLwQ5neaEnJAZcLw+Kmdqwi"
+"QRgokhaXnFM7LiKZDLxbytQ+PO2Z+ePENt50wmak9cHJjjgV5YZnTuHHjblOV9lMi3k+CNUpEeOb"
+"4SA0N8+aCcC6QPItCA1NcSkuYyRGlNXhgHugGDHRnB05M9sgbo7+lF/fCpDpppmMKzD9rnW8OqKV"
+"nb9+04x73u6DaEVBByiDWbiEY8zsWTGZNV7z1hZhyMjZZL+SzszKYMdIrO4SKXsmWLiJ6/Oqn7xe"
+"WlctT2z0rDRPSXKok5oqiGnKBt5wwu4G4cAAMHTOgXsMMuzWLn7lkm0dvhA/CvhKzE/siLHMUmEu"
+"q95jlKYYvjQTqoKFjNzk";
@@ -0,0 +1,8 @@
+/* @generated by tablegen */
+struct point { int x; int y; };
+static int table_lookup (int k)
+{
+	int local = k * 2;
+	return local;
+}
+int top;
@@ -0,0 +1,9 @@
+# Code generated by protoc. DO NOT EDIT.
+class Msg:
+    def field(self):
+        def inner():
+            pass
+        return 1
+def top():
+    v = 1
+X = 1
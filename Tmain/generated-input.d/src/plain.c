@@ -0,0 +1,7 @@
+struct point { int x; int y; };
+static int table_lookup (int k)
+{
+	int local = k * 2;
+	return local;
+}
+int top;
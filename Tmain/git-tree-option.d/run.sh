@@ -0,0 +1,42 @@
+#!/bin/sh
+# Copyright: 2026 Universal Ctags Team
+# License: GPL-2
+
+CTAGS=$1
+. ../utils.sh
+
+O="--quiet --options=NONE"
+
+if ! git --version > /dev/null 2>&1; then
+	skip "git is not available"
+fi
+
+D=/tmp/ctags-tmain-$$
+mkdir -p $D/src
+printf 'int foo(void) { return 0; }\n' > $D/src/a.c
+printf 'def bar():\n    pass\n' > $D/b.py
+ln -s b.py $D/link.py
+(
+	cd $D &&
+	git init -q &&
+	git add . &&
+	git -c user.name=ctags -c user.email=ctags@example.com commit -q -m first
+) || skip "cannot make a git repository"
+
+# The files of the tree are tagged, not the ones in the work tree.
+printf 'int baz;\n' > $D/src/a.c
+rm $D/b.py
+
+echo '# --git-tree=HEAD'
+( cd $D && ${CTAGS} $O --git-tree=HEAD -o - )
+
+echo '# --git-tree=HEAD --exclude=*.py --cache-dir'
+( cd $D && ${CTAGS} $O --git-tree=HEAD --exclude='*.py' --cache-dir=cache -o - )
+
+echo '# --git-tree=HEAD --cache-dir (reused)'
+( cd $D && ${CTAGS} $O --git-tree=HEAD --exclude='*.py' --cache-dir=cache --verbose -o - 2>&1 | grep '^reusing' )
+
+echo '# --git-tree=no-such-rev'
+( cd $D && ${CTAGS} $O --git-tree=no-such-rev -o - 2>&1 > /dev/null | grep '^ctags:' )
+
+rm -rf $D
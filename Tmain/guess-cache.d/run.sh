@@ -0,0 +1,13 @@
+# Copyright: 2026 Universal Ctags Team
+# License: GPL-2
+
+CTAGS=$1
+
+O="--quiet --options=NONE"
+
+# Only src/a/1.h tells it is ObjectiveC, not C++.
+echo '# without cache'
+${CTAGS} $O --print-language src/a/1.h src/a/2.h src/b/3.h
+
+echo '# with cache'
+${CTAGS} $O --guess-cache --print-language src/a/1.h src/a/2.h src/b/3.h
@@ -0,0 +1,18 @@
+# Copyright: 2026 Universal Ctags Team
+# License: GPL-2
+
+CTAGS=$1
+
+echo '# without ignore files'
+${CTAGS} --quiet --options=NONE \
+	 -R --print-language input | LC_ALL=C sort
+
+echo '# ctags.ignore and more.ignore'
+${CTAGS} --quiet --options=NONE \
+	 --ignore-file=ctags.ignore --ignore-file=more.ignore \
+	 -R --print-language input | LC_ALL=C sort
+
+echo '# resetting'
+${CTAGS} --quiet --options=NONE \
+	 --ignore-file=ctags.ignore --ignore-file= --ignore-file=more.ignore \
+	 -R --print-language input | LC_ALL=C sort
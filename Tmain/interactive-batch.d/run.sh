@@ -0,0 +1,42 @@
+#!/bin/sh
+# Copyright: 2026 Universal Ctags Team
+# License: GPL-2
+
+CTAGS=$1
+. ../utils.sh
+
+is_feature_available ${CTAGS} interactive
+
+# It seems that the output format is slightly different between libjansson versions
+s()
+{
+	sed -e s/':"'/': "'/g
+}
+
+CTAGS="$CTAGS --options=NONE"
+
+echo generate tags from files and data in one request
+echo =======================================
+(
+  echo '{"command":"generate-tags-batch", "id":1, "files":[{"filename":"test.rb", "id":"a"}, {"filename":"inline.rb", "content":"def inline() end\n"}, {"filename":"stream.rb", "size":17, "id":"b"}]}'
+  echo 'def foobaz() end'
+) | ${CTAGS} --_interactive |s
+
+echo
+echo error with the id of the request
+echo =======================================
+(
+  echo '{"command":"generate-tags-batch", "id":2, "files":[{"size":17}, {"filename":"stream.rb", "size":17}]}'
+  echo 'def foobaz() end'
+  echo 'def foobaz() end'
+  echo '{"command":"generate-tags-batch", "id":3}'
+) | ${CTAGS} --_interactive |s
+
+echo
+echo request longer than 1024 bytes
+echo =======================================
+c=
+for i in 0 1 2 3 4 5 6 7 8 9; do
+	c="$c"'def long_function_name_for_filling_the_request_'$i'() end\n'
+done
+echo '{"command":"generate-tags", "id":4, "filename":"long.rb", "content":"'"$c$c$c"'"}' | ${CTAGS} --_interactive |s | grep -c '"_type": "tag"'
@@ -0,0 +1,36 @@
+#!/bin/sh
+# Copyright: 2026 Universal Ctags Team
+# License: GPL-2
+
+CTAGS=$1
+. ../utils.sh
+
+is_feature_available ${CTAGS} interactive
+
+# It seems that the output format is slightly different between libjansson versions
+s()
+{
+	sed -e s/':"'/': "'/g
+}
+
+CTAGS="$CTAGS --options=NONE"
+
+echo cancel a request being parsed
+echo =======================================
+# Both requests are written at once, so the cancel request is there
+# when the first line of the file is read.
+printf '%s\n%s\n' \
+	'{"command":"generate-tags", "id":1, "filename":"test.rb"}' \
+	'{"command":"cancel", "id":2, "target":1}' | ${CTAGS} --_interactive |s
+
+echo
+echo cancel nothing
+echo =======================================
+printf '%s\n' \
+	'{"command":"cancel", "id":3, "target":4}' | ${CTAGS} --_interactive |s
+
+echo
+echo deadline not reached
+echo =======================================
+printf '%s\n' \
+	'{"command":"generate-tags", "id":5, "filename":"test.rb", "deadline_ms":600000}' | ${CTAGS} --_interactive |s
@@ -0,0 +1,7 @@
+class Test
+  def foobar
+  end
+
+  def baz(a=1)
+  end
+end
@@ -0,0 +1,39 @@
+#!/bin/sh
+# Copyright: 2026 Universal Ctags Team
+# License: GPL-2
+
+CTAGS=$1
+. ../utils.sh
+
+is_feature_available ${CTAGS} interactive
+
+# It seems that the output format is slightly different between libjansson versions
+s()
+{
+	sed -e s/':"'/': "'/g
+}
+
+CTAGS="$CTAGS --options=NONE"
+
+echo edit a retained buffer
+echo =======================================
+(
+	printf '%s\n' '{"command":"generate-tags", "id":1, "filename":"a.c", "retain":true, "size":14}'
+	printf 'int a;\nint b;\n'
+	printf '%s\n' '{"command":"edit-buffer", "id":2, "filename":"a.c", "offset":11, "length":1, "content":"bb"}'
+	printf '%s\n' '{"command":"edit-buffer", "id":3, "filename":"a.c", "offset":0, "size":7}'
+	printf 'int z;\n'
+	printf '%s\n' '{"command":"close-buffer", "id":4, "filename":"a.c"}'
+) | ${CTAGS} --_interactive |s
+
+echo
+echo errors
+echo =======================================
+(
+	printf '%s\n' '{"command":"generate-tags", "id":5, "filename":"test.rb", "retain":true}'
+	printf '%s\n' '{"command":"generate-tags", "id":6, "filename":"a.c", "retain":true, "content":"int a;\n"}'
+	printf '%s\n' '{"command":"edit-buffer", "id":7, "filename":"a.c", "offset":8, "content":"int b;\n"}'
+	printf '%s\n' '{"command":"edit-buffer", "id":8, "filename":"b.c", "offset":0, "content":"int b;\n"}'
+	printf '%s\n' '{"command":"edit-buffer", "id":9, "filename":"a.c"}'
+	printf '%s\n' '{"command":"close-buffer", "id":10, "filename":"b.c"}'
+) | ${CTAGS} --_interactive |s
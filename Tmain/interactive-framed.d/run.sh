@@ -0,0 +1,25 @@
+# Copyright: 2026 Universal Ctags Team
+# License: GPL-2
+
+CTAGS=$1
+. ../utils.sh
+
+is_feature_available ${CTAGS} interactive
+
+O=/tmp/ctags-tmain-$$.pb
+
+# Each request is a Request message preceded with its size:
+# - generate-tags of input.c, id 1
+# - generate-tags of the 11 bytes following it, id 2
+# - a cancel request given as JSON, id 3
+# - a broken one, having a string member as a varint
+{
+	printf '\032\n\015generate-tags\022\007input.c\040\001'
+	printf '\034\n\015generate-tags\022\007input.c\030\013\040\002'
+	printf 'int count;\n'
+	printf '\031z\025{"command": "cancel"}\040\003'
+	printf '\002\010\001'
+} | ${CTAGS} --quiet --options=NONE --_interactive=framed > $O
+${CTAGS} --quiet --options=NONE --_dump-protobuf-stream=$O | sed -e 's/"version": "[^"]*"/"version": ""/'
+
+rm -f $O
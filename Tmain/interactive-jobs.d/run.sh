@@ -0,0 +1,27 @@
+#!/bin/sh
+# Copyright: 2026 Universal Ctags Team
+# License: GPL-2
+
+CTAGS=$1
+. ../utils.sh
+
+is_feature_available ${CTAGS} interactive
+is_feature_available ${CTAGS} jobs
+
+# It seems that the output format is slightly different between libjansson versions
+s()
+{
+	sed -e s/':"'/': "'/g
+}
+
+CTAGS="$CTAGS --options=NONE"
+
+# The responses may come in any order.
+(
+  echo '{"command":"generate-tags", "id":1, "filename":"test.rb"}'
+  echo '{"command":"generate-tags", "id":2, "filename":"test.c"}'
+  echo '{"command":"generate-tags", "id":3, "filename":"nonexistent.c"}'
+  echo '{"command":"generate-tags", "id":4, "filename":"stream.rb", "size":17}'
+  echo 'def foobaz() end'
+  echo '{"command":"generate-tags-batch", "id":5, "files":[{"filename":"test.c", "id":"5a"}, {"filename":"inline.rb", "content":"def inline() end\n", "id":"5b"}]}'
+) | ${CTAGS} --_interactive --jobs=2 |s | LC_ALL=C sort
@@ -0,0 +1,34 @@
+#!/bin/sh
+# Copyright: 2026 Universal Ctags Team
+# License: GPL-2
+
+CTAGS=$1
+. ../utils.sh
+
+is_feature_available ${CTAGS} interactive
+
+# It seems that the output format is slightly different between libjansson versions
+s()
+{
+	sed -e s/':"'/': "'/g
+}
+
+CTAGS="$CTAGS --options=NONE"
+
+echo generate tags from a range of a mapped file
+echo =======================================
+(
+  echo '{"command":"generate-tags", "id":1, "filename":"a.rb", "mapped":"blob.txt", "offset":17, "size":17}'
+  echo '{"command":"generate-tags", "id":2, "filename":"b.rb", "mapped":"blob.txt", "offset":34}'
+  echo '{"command":"generate-tags-batch", "id":3, "files":[{"filename":"c.rb", "mapped":"blob.txt", "offset":17, "id":"a"}, {"filename":"d.rb", "size":17, "id":"b"}]}'
+  echo 'def foobaz() end'
+) | ${CTAGS} --_interactive |s
+
+echo
+echo range out of the mapped file
+echo =======================================
+(
+  echo '{"command":"generate-tags", "id":4, "filename":"a.rb", "mapped":"blob.txt", "offset":17, "size":1000}'
+  echo '{"command":"generate-tags", "id":5, "filename":"a.rb", "mapped":"blob.txt", "offset":-1}'
+) | ${CTAGS} --_interactive |s
+
@@ -0,0 +1 @@
+struct point { int x; int y; };
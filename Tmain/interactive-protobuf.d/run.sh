@@ -0,0 +1,21 @@
+# Copyright: 2026 Universal Ctags Team
+# License: GPL-2
+
+CTAGS=$1
+. ../utils.sh
+
+is_feature_available ${CTAGS} interactive
+
+O=/tmp/ctags-tmain-$$.pb
+
+# The responses are records of the stream, between the tags.
+${CTAGS} --quiet --options=NONE --output-format=protobuf --_interactive > $O <<EOF
+{"command": "generate-tags", "filename": "input.c", "id": 1}
+{"command": "generate-tags", "filename": "input.c", "size": 11, "id": 2}
+int count;
+{"command": "generate-tags", "filename": "input.c", "content": "int x;", "retain": true, "id": 3}
+{"command": "watch", "path": "input.c", "id": 4}
+EOF
+${CTAGS} --quiet --options=NONE --_dump-protobuf-stream=$O | sed -e 's/"version": "[^"]*"/"version": ""/'
+
+rm -f $O
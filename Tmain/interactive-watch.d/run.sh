@@ -0,0 +1,52 @@
+#!/bin/sh
+# Copyright: 2026 Universal Ctags Team
+# License: GPL-2
+
+CTAGS=$1
+. ../utils.sh
+
+is_feature_available ${CTAGS} interactive
+
+# It seems that the output format is slightly different between libjansson versions
+s()
+{
+	sed -e s/':"'/': "'/g
+}
+
+D=/tmp/ctags-tmain-$$
+mkdir -p $D/src/sub
+printf 'int foo(void) { return 0; }\n' > $D/src/a.c
+printf 'int bar;\n' > $D/src/b.c
+
+# The files are changed after ctags has answered the request before.
+mkfifo $D/in
+: > $D/out
+( cd $D && ${CTAGS} --quiet --options=NONE --_interactive < in > out ) &
+exec 3> $D/in
+
+request()
+{
+	n=$(( n + 1 ))
+	echo "$1" >&3
+	for i in 1 2 3 4 5 6 7 8 9 10; do
+		[ $(wc -l < $D/out) -gt $n ] && break
+		sleep 1
+	done
+}
+
+n=0
+request '{"command":"watch", "path":"src"}'
+printf 'int foo2(void) { return 0; }\n' > $D/src/a.c
+printf 'int baz;\n' > $D/src/sub/c.c
+rm $D/src/b.c
+request '{"command":"write-tags", "filename":"tags"}'
+echo '{"command":"find-tags", "name":"foo2"}' >&3
+echo '{"command":"find-tags", "name":"bar"}' >&3
+exec 3>&-
+wait
+
+s < $D/out
+echo
+cat $D/tags
+
+rm -rf $D
@@ -0,0 +1,4 @@
+      program free
+      integer :: a, &
+                 b
+      end program free
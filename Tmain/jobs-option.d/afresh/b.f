@@ -0,0 +1,5 @@
+C     A fixed form file
+      PROGRAM FIXED
+      INTEGER M(10)
+      INTEGER N
+      END
@@ -0,0 +1 @@
+define(`greeting', `hello')
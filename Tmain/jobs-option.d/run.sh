@@ -0,0 +1,59 @@
+# Copyright: 2026 Universal Ctags Team
+# License: GPL-2
+
+CTAGS=$1
+
+. ../utils.sh
+
+is_feature_available ${CTAGS} jobs
+
+O="--quiet --options=NONE"
+
+compare()
+{
+	echo "# $*"
+	${CTAGS} $O "$@" -R -o - src > serial.tags
+	${CTAGS} $O "$@" -j 3 -R -o - src > parallel.tags
+	if cmp serial.tags parallel.tags > /dev/null; then
+		echo same
+	else
+		diff -u serial.tags parallel.tags
+	fi
+}
+
+compare --sort=no
+compare --sort=yes
+compare --sort=no -e
+compare --sort=no -x
+
+# A serial run parses all the files in one process, a worker only some of
+# them; each run must start every file afresh for the outputs to match.
+echo "# each file parsed afresh"
+F="afresh/a.f afresh/b.f afresh/c.robot afresh/d.robot afresh/e.ac afresh/f.m4 afresh/g.tex afresh/h.tex"
+O1="$O --sort=no --extras=+f-p --fields=+l"
+rm -f serial.tags parallel.tags
+${CTAGS} $O1 -o serial.tags $F
+cat serial.tags
+${CTAGS} $O1 -j 2 -o parallel.tags $F
+for f in $F; do
+	${CTAGS} $O1 -o one.tags $f
+	cat one.tags
+done > each.tags
+for t in parallel.tags each.tags; do
+	if cmp serial.tags $t > /dev/null; then
+		echo same
+	else
+		diff -u serial.tags $t
+	fi
+done
+
+echo "# option between file names"
+${CTAGS} $O -u --jobs=2 -o - src/a.c src/b.py --language-force=Sh src/sub/c.sh src/sub/d.rb
+
+echo "# invalid number of jobs"
+${CTAGS} $O --jobs=0 -o - src/a.c
+${CTAGS} $O -j 0 -o - src/a.c
+
+rm -f serial.tags parallel.tags one.tags each.tags
+
+exit 0
@@ -0,0 +1,2 @@
+int a_var;
+static void a_func (void) { }
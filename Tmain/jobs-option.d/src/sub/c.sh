@@ -0,0 +1,4 @@
+c_func ()
+{
+	:
+}
@@ -0,0 +1,4 @@
+module D
+  def d_method
+  end
+end
@@ -0,0 +1,3 @@
+class Foo:
+    def doIt():
+        pass
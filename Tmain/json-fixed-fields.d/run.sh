@@ -0,0 +1,16 @@
+# Copyright: 2026 Universal Ctags Team
+# License: GPL-2
+
+CTAGS="$1 --quiet --options=NONE --sort=no"
+
+echo '# pattern and path disabled'
+${CTAGS} --output-format=json --fields=-P-F+n -o - input.py
+
+echo '# a set of fields keeps them'
+${CTAGS} --output-format=json --fields=nK -o - input.py
+
+echo '# name'
+${CTAGS} --output-format=json --fields=-N -o - input.py
+
+echo '# before --output-format'
+${CTAGS} --fields=-P --output-format=json -o - input.py
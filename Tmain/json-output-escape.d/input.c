@@ -0,0 +1,6 @@
+char *s = "a\"b\\c/d";	/* tab */
+int café;
+int bad;
+struct S {
+int	m;
+};
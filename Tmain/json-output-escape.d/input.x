@@ -0,0 +1,4 @@
+def café
+def bad
+def ctlx
+def q"b\s
@@ -0,0 +1,16 @@
+# Copyright: 2026 Universal Ctags Team
+# License: GPL-2
+
+CTAGS=$1
+
+. ../utils.sh
+
+is_feature_available "${CTAGS}" json
+
+${CTAGS} --quiet --options=NONE --sort=no --fields='+n' --extras=-p \
+		 --output-format=json -o - input.c
+
+${CTAGS} --quiet --options=NONE --sort=no --fields='+n' --extras=-p \
+		 --langdef=X --map-X=.x --kinddef-X=d,def,definitions \
+		 --regex-X='/^def (.+)$/\1/d/' \
+		 --output-format=json -o - input.x
@@ -0,0 +1,30 @@
+# Copyright: 2026 Universal Ctags Team
+# License: GPL-2
+
+CTAGS=$1
+
+echo '# a pattern with a wildcard before a pattern without'
+${CTAGS} --quiet --options=NONE \
+	 --langdef=A --map-A=+'(*.conf)' --langdef=B --map-B=+'(app.conf)' \
+	 --print-language app.conf other.conf
+
+echo '# disabling the first parser'
+${CTAGS} --quiet --options=NONE \
+	 --langdef=A --map-A=+'(*.conf)' --langdef=B --map-B=+'(app.conf)' \
+	 --languages=-A \
+	 --print-language app.conf other.conf
+
+echo '# removing and adding maps'
+${CTAGS} --quiet --options=NONE \
+	 --langdef=A --map-A=+.Zz --langdef=B --map-B=+'(Input.Zz)' \
+	 --map-B=-'(Input.Zz)' --map-B=+.Zz --map-A=-.Zz \
+	 --print-language Input.Zz
+
+echo '# aliases with and without a wildcard'
+${CTAGS} --quiet --options=NONE -G \
+	 --langdef=A --alias-A=+foo2 --langdef=B --alias-B=+'foo*' \
+	 --print-language script
+${CTAGS} --quiet --options=NONE -G \
+	 --langdef=A --alias-A=+foo2 --langdef=B --alias-B=+'foo*' \
+	 --alias-A=-foo2 \
+	 --print-language script
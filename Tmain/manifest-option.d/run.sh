@@ -0,0 +1,41 @@
+# Copyright: 2026 Universal Ctags Team
+# License: GPL-2
+
+CTAGS=$1
+
+O="--quiet --options=NONE"
+
+# Files modified in the second they are tagged are parsed again anyway.
+old()
+{
+	touch -t 200001010000 "$@"
+}
+
+run()
+{
+	echo "#" "$@"
+	${CTAGS} $O --manifest --verbose "$@" -R -o tags src 2>&1 | grep -E '^(skipping|removing|ignoring)' | sort
+	${CTAGS} $O "$@" -R -o full.tags src
+	if cmp full.tags tags > /dev/null; then
+		echo same
+	else
+		diff -u full.tags tags
+	fi
+}
+
+rm -f tags tags.manifest
+printf 'int a;\nint b;\n' > src/a.c
+printf 'int d;\n' > src/d.c
+old src/a.c src/d.c src/b.py src/sub/c.sh
+
+run
+run
+
+printf 'int a2;\nint b;\n' > src/a.c
+rm src/d.c
+printf 'int e;\n' > src/e.c
+old src/a.c src/e.c
+run
+run --fields=+n
+
+rm -f src/a.c src/e.c tags tags.manifest full.tags
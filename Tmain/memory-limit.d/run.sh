@@ -0,0 +1,30 @@
+# Copyright: 2026 Universal Ctags Team
+# License: GPL-2
+
+CTAGS=$1
+
+. ../utils.sh
+
+if ${CTAGS} --quiet --options=NONE --memory-limit=64 --version 2>&1 | grep -q 'not supported'; then
+	skip "--memory-limit is not supported on this platform"
+fi
+
+O=/tmp/ctags-tmain-$$
+awk 'BEGIN { for (i = 0; i < 200000; i++) print "int v" (i * 7919 % 200000) ";" }' > $O.c
+
+# Near the limit, the sort spills its runs sooner; the tags stay the same.
+echo '# memory-limit'
+${CTAGS} --quiet --options=NONE --sort=yes -o $O.tags $O.c
+${CTAGS} --quiet --options=NONE --sort=yes --memory-limit=32 -o $O.limited $O.c
+if cmp -s $O.tags $O.limited; then
+	echo same
+fi
+
+echo '# exceeded'
+${CTAGS} --quiet --options=NONE --sort=yes --memory-limit=1 -o $O.limited $O.c
+echo $?
+
+rm -f $O.c $O.tags $O.limited
+
+echo '# invalid'
+${CTAGS} --quiet --options=NONE --memory-limit=1G -o /dev/null $O.c
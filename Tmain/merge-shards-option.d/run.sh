@@ -0,0 +1,39 @@
+#!/bin/sh
+# Copyright: 2026 Universal Ctags Team
+# License: GPL-2
+
+CTAGS=$1
+. ../utils.sh
+
+O="--quiet --options=NONE --pseudo-tags=TAG_FILE_SORTED --pseudo-tags=+TAG_KIND_DESCRIPTION"
+
+D=/tmp/ctags-tmain-$$
+mkdir -p $D/a $D/b
+printf 'int foo(void) { return 0; }\nint common;\n' > $D/a/x.c
+printf 'int bar(void) { return 1; }\nint common;\n' > $D/b/y.c
+printf 'int Zed;\n' > $D/z.c
+
+cd $D || exit 1
+
+# A sorted shard is merged, an unsorted one sorted; a shard given twice
+# adds its tags once.
+${CTAGS} $O -f a.tags a/x.c
+${CTAGS} $O -f b.tags --sort=no b/y.c
+${CTAGS} $O -f z.tags z.c
+echo '# --merge-shards'
+${CTAGS} $O --merge-shards -f all.tags a.tags b.tags z.tags z.tags
+cat all.tags
+${CTAGS} $O -f ref.tags a/x.c b/y.c z.c
+cmp all.tags ref.tags && echo same as tagging all the files
+
+echo '# --merge-shards --sort=foldcase'
+${CTAGS} $O --merge-shards --sort=foldcase -f - a.tags z.tags | grep -v '^!'
+
+echo '# --merge-shards --sort=no'
+${CTAGS} $O --merge-shards --sort=no -f all.tags a.tags 2>&1
+
+echo '# not a tag file'
+${CTAGS} $O --merge-shards -f all.tags a/x.c 2>&1
+
+cd /
+rm -rf $D
@@ -0,0 +1,15 @@
+# Copyright: 2026 Universal Ctags Team
+# License: GPL-2
+
+CTAGS=$1
+
+O="--quiet --options=NONE"
+
+echo '# -z -L -'
+printf 'src/a b.c\0src/-b.c\0\0src/c.c' | ${CTAGS} $O -z -L - -o -
+
+echo '# --nul-separated-list -L FILE'
+printf 'src/c.c\0src/a b.c\0' > list
+${CTAGS} $O --nul-separated-list -L list -o -
+
+rm -f list
@@ -0,0 +1,4 @@
+int a;
+int b;
+static int c (void) { return 0; }
+struct d { int e; };
@@ -0,0 +1,28 @@
+# Copyright: 2026 Universal Ctags Team
+# License: GPL-2
+
+CTAGS=$1
+
+O=/tmp/ctags-tmain-$$
+
+for size in 0 16 1048576; do
+	echo "# $size"
+	${CTAGS} --quiet --options=NONE --pseudo-tags= --output-buffer-size=$size -o $O input.c
+	cat $O
+	${CTAGS} --quiet --options=NONE --pseudo-tags= --output-buffer-size=$size --sort=no -o $O input.c
+	cat $O
+done
+
+echo '# append'
+${CTAGS} --quiet --options=NONE --pseudo-tags= --output-buffer-size=16 --sort=no -a -o $O input.c
+cat $O
+
+echo '# etags'
+${CTAGS} --quiet --options=NONE --output-buffer-size=16 -e -o TAGS.tmp input.c
+cat TAGS.tmp
+rm -f TAGS.tmp
+
+echo '# invalid'
+${CTAGS} --quiet --options=NONE --output-buffer-size=large -o $O input.c
+
+rm -f $O
@@ -0,0 +1,36 @@
+#!/bin/sh
+# Copyright: 2026 Universal Ctags Team
+# License: GPL-2
+
+CTAGS=$1
+. ../utils.sh
+
+O="--quiet --options=NONE --pseudo-tags=TAG_FILE_SORTED --fields=+n"
+
+D=/tmp/ctags-tmain-$$
+mkdir -p $D
+printf 'int b;\nint a (void) { return b; }\n' > $D/a.c
+
+cd $D || exit 1
+
+echo '# writing'
+${CTAGS} $O -o tags --output=json:tags.json --output=etags:TAGS --output=xref:xref a.c
+cat tags
+cat tags.json
+cat TAGS
+cat xref
+echo '# the same as one format at a time'
+${CTAGS} $O -o one.tags a.c
+${CTAGS} $O --output-format=json -o one.json a.c
+cmp tags one.tags && cmp tags.json one.json && echo same
+echo '# the format of the tag file'
+${CTAGS} $O -o e.tags --output=u-ctags:u.tags a.c
+echo '# twice the same format'
+${CTAGS} $O -o e.tags --output=json:1.json --output=json:2.json a.c
+echo '# binary'
+${CTAGS} $O -o e.tags --output=binary:tags.bin a.c
+echo '# appending'
+${CTAGS} $O -a -o tags --output=json:tags.json a.c
+
+cd /
+rm -rf $D
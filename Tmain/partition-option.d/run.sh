@@ -0,0 +1,36 @@
+#!/bin/sh
+# Copyright: 2026 Universal Ctags Team
+# License: GPL-2
+
+CTAGS=$1
+. ../utils.sh
+
+O="--quiet --options=NONE --pseudo-tags=TAG_FILE_SORTED --fields=+n"
+
+D=/tmp/ctags-tmain-$$
+mkdir -p $D/src/lib $D/doc
+printf 'int top;\n' > $D/top.c
+printf 'int b;\nint a (void) { return b; }\n' > $D/src/lib/a.c
+printf 'def f():\n    pass\n' > $D/src/f.py
+printf 'int d;\n' > $D/doc/d.c
+
+cd $D || exit 1
+
+echo '# language'
+${CTAGS} $O --partition=language top.c src/lib/a.c src/f.py doc/d.c
+for f in tags tags.C tags.Python; do echo "## $f"; cat $f; done
+rm -f tags*
+echo '# directory'
+${CTAGS} $O --partition=directory top.c src/lib/a.c src/f.py doc/d.c
+for f in tags src/tags doc/tags; do echo "## $f"; cat $f; done
+rm -f tags src/tags doc/tags
+echo '# directory:2'
+${CTAGS} $O --partition=directory:2 top.c src/lib/a.c src/f.py doc/d.c
+for f in tags src/lib/tags; do echo "## $f"; cat $f; done
+echo '# standard output'
+${CTAGS} $O --partition=language -o - top.c
+echo '# appending'
+${CTAGS} $O --partition=language -a top.c
+
+cd /
+rm -rf $D
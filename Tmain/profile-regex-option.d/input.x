@@ -0,0 +1,4 @@
+def alpha
+var beta
+end gamma
+def delta
@@ -0,0 +1,31 @@
+#!/bin/sh
+# Copyright: 2026 Universal Ctags Team
+# License: GPL-2
+
+CTAGS=$1
+
+# The ranking depends on the time taken: the times are dropped, and the
+# lines after the first N of the report are sorted.
+profile()
+{
+	n=$1
+	shift
+	${CTAGS} --quiet --options=NONE \
+			 --langdef=X --map-X=.x --kinddef-X=d,def,definitions \
+			 --regex-X='/^def[ \t]+([a-z]+)/\1/d/' \
+			 --regex-X='/^nomatch/x/d/' \
+			 --mline-regex-X='/^end[ \t]+([a-z]+)/\1/d/{mgroup=1}' \
+			 --_tabledef-X=main \
+			 --_mtable-regex-X='main/var[ \t]+([a-z]+)/\1/d/' \
+			 --_mtable-regex-X='main/.//' \
+			 "$@" -o /dev/null input.x 2>&1 \
+		| sed -e 's/^ *[0-9][0-9.]* //' -e 's/"seconds": [0-9.]*, //' -e 's/},$/}/' \
+		| awk -v n=$n 'NR <= n { print; next } { print | "LC_ALL=C sort" }'
+}
+
+echo '# unknown argument'
+${CTAGS} --quiet --options=NONE --_profile-regex=xml 2>&1
+echo '# text'
+profile 3 --_profile-regex
+echo '# json'
+profile 1 --_profile-regex=json
@@ -0,0 +1,9 @@
+#if A
+class X {
+#else
+class X {
+#endif
+int g;
+}
+}
+class Y {}
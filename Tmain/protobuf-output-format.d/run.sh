@@ -0,0 +1,28 @@
+# Copyright: 2026 Universal Ctags Team
+# License: GPL-2
+
+CTAGS=$1
+
+O=/tmp/ctags-tmain-$$.pb
+
+# input.cs is parsed twice: the strings of the first pass are
+# written again after it is taken back.
+echo '# file'
+${CTAGS} --quiet --options=NONE --output-format=protobuf --fields=+n -o $O input.cs &&
+	${CTAGS} --quiet --options=NONE --_dump-protobuf-stream=$O
+
+echo '# overwriting'
+${CTAGS} --quiet --options=NONE --output-format=protobuf --sort=yes --fields=-P -o $O input.cs &&
+	${CTAGS} --quiet --options=NONE --_dump-protobuf-stream=$O
+
+echo '# stdout'
+${CTAGS} --quiet --options=NONE --output-format=protobuf --fields=-F -o - input.cs > $O &&
+	${CTAGS} --quiet --options=NONE --_dump-protobuf-stream=$O
+
+echo '# append'
+${CTAGS} --quiet --options=NONE --output-format=protobuf --append -o $O input.cs 2>&1
+
+echo '# not a stream'
+${CTAGS} --quiet --options=NONE --_dump-protobuf-stream=input.cs 2>&1
+
+rm -f $O
@@ -0,0 +1,42 @@
+int var_00;
+int var_01;
+int var_02;
+int var_03;
+int var_04;
+int var_05;
+int var_06;
+int var_07;
+int var_08;
+int var_09;
+int var_10;
+int var_11;
+int var_12;
+int var_13;
+int var_14;
+int var_15;
+int var_16;
+int var_17;
+int var_18;
+int var_19;
+int var_20;
+int var_21;
+int var_22;
+int var_23;
+int var_24;
+int var_25;
+int var_26;
+int var_27;
+int var_28;
+int var_29;
+int var_30;
+int var_31;
+int var_32;
+int var_33;
+int var_34;
+int var_35;
+int var_36;
+int var_37;
+int var_38;
+int var_39;
+struct point { int x; int y; };
+int Point_X (struct point *p) { return p->x; }
@@ -0,0 +1,46 @@
+# Copyright: 2026 Universal Ctags Team
+# License: GPL-2
+
+CTAGS=$1
+READTAGS=$3
+
+. ../utils.sh
+
+if ! [ -x "${READTAGS}" ]; then
+	skip "no readtags"
+fi
+is_feature_available ${CTAGS} gzip
+
+O=/tmp/ctags-tmain-$$
+
+# Frames of a few lines each
+${CTAGS} --quiet --options=NONE --compress=gzip --compress-frame-size=64 -o $O input.c
+${CTAGS} --quiet --options=NONE --compress=gzip --compress-frame-size=64 --name-index \
+		 --sort=foldcase -o $O.fold input.c
+${CTAGS} --quiet --options=NONE -o $O.plain input.c
+
+echo '# decompressed'
+gzip -dc < $O | cmp - $O.plain && echo same
+
+echo '# listing'
+${READTAGS} -t $O -l > $O.list
+${READTAGS} -t $O.plain -l | cmp - $O.list && echo same
+
+echo '# searching'
+${READTAGS} -t $O - var_00 var_17 var_39 point nothing
+${READTAGS} -t $O -p - var_2 Poi
+${READTAGS} -t $O -i - point_x
+
+echo '# searching with a name index'
+${READTAGS} -t $O.fold -i - POINT var_33
+${READTAGS} -t $O.fold -cip - var_1
+
+echo '# a tag file compressed with gzip'
+gzip -c $O.plain > $O.gz
+${READTAGS} -t $O.gz - var_05 Point_X
+
+echo '# not compatible'
+${CTAGS} --quiet --options=NONE --compress=gzip -o - input.c 2>&1
+${CTAGS} --quiet --options=NONE --compress=gzip --append -o $O input.c 2>&1
+
+rm -f $O $O.fold $O.fold.idx $O.plain $O.gz $O.list
@@ -0,0 +1,11 @@
+int point;
+int Point;
+int POINT;
+int pointer;
+int point_x, point_y;
+int very_long_name_prefix_a;
+int very_long_name_prefix_b;
+int very_long_name_prefix;
+int very_long_name_p;
+int VERY_LONG_NAME_PREFIX_C;
+static int point_x (int x) { return x; }
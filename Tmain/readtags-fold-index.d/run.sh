@@ -0,0 +1,34 @@
+# Copyright: 2026 Universal Ctags Team
+# License: GPL-2
+
+CTAGS=$1
+READTAGS=$3
+
+. ../utils.sh
+
+if ! [ -x "${READTAGS}" ]; then
+	skip "no readtags"
+fi
+
+O=/tmp/ctags-tmain-$$
+
+${CTAGS} --quiet --options=NONE --sort=yes --fold-index -o $O input.c
+[ -f $O.fidx ] && echo "index written"
+cp $O $O.noindex
+
+for t in $O $O.noindex; do
+	echo '# ignoring case'
+	${READTAGS} -t $t -i - point POINT_X very_long_name_prefix_c VERY_LONG_NAME_P nothing
+	echo '# ignoring case, partial'
+	${READTAGS} -t $t -ip - very_long_name_prefix_ POINT_ | sort
+	echo '# ignoring case, counting'
+	${READTAGS} -t $t -ci - point Point_X nothing
+	${READTAGS} -t $t -cip - POINT very_long_name_prefix ''
+done
+
+echo '# foldcase'
+${CTAGS} --quiet --options=NONE --sort=foldcase --fold-index -o $O.foldcase input.c
+echo '# stdout'
+${CTAGS} --quiet --options=NONE --fold-index -o - input.c
+
+rm -f $O $O.fidx $O.noindex $O.foldcase
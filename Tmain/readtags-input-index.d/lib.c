@@ -0,0 +1,2 @@
+int lib_init (void) { return 0; }
+int lib_count;
@@ -0,0 +1,36 @@
+# Copyright: 2026 Universal Ctags Team
+# License: GPL-2
+
+CTAGS=$1
+READTAGS=$3
+
+. ../utils.sh
+
+if ! [ -x "${READTAGS}" ]; then
+	skip "no readtags"
+fi
+
+O=/tmp/ctags-tmain-$$
+
+${CTAGS} --quiet --options=NONE --sort=yes --input-index -R -o $O lib.c src
+[ -f $O.iidx ] && echo "index written"
+cp $O $O.noindex
+
+for t in $O $O.noindex; do
+	echo '# input'
+	${READTAGS} -t $t -F - src/a.c src/very/long/directory/name/c.c lib.c src/nothing.c
+	echo '# input, with kind'
+	${READTAGS} -t $t -F -e -k v src/a.c
+	echo '# input, partial'
+	${READTAGS} -t $t -Fp - src/very/ src/ | sort
+	echo '# input, counting'
+	${READTAGS} -t $t -cF - src/a.c src/very/long/directory/name/c.c src/
+	${READTAGS} -t $t -cFp - src/ ''
+	echo '# input, ignoring case'
+	${READTAGS} -t $t -Fi - LIB.C
+done
+
+echo '# stdout'
+${CTAGS} --quiet --options=NONE --input-index -o - lib.c
+
+rm -f $O $O.iidx $O.noindex
@@ -0,0 +1,3 @@
+struct point { int x; int y; };
+int main (void) { return 0; }
+static int helper;
@@ -0,0 +1,2 @@
+int main_b (void) { return 1; }
+int helper_b;
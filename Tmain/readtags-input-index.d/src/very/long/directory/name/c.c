@@ -0,0 +1,3 @@
+int deep (void) { return 2; }
+int deep_count;
+struct point3 { int x; };
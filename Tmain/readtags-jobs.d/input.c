@@ -0,0 +1,9 @@
+struct point { int x; int y; };
+struct Point3 { int x; int y; int z; };
+
+static int xmax;
+int ymax;
+
+int point_x (struct point *p) { return p->x; }
+int point_y (struct point *p) { return p->y; }
+int Point_x (struct Point3 *p) { return p->x; }
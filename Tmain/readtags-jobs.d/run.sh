@@ -0,0 +1,37 @@
+# Copyright: 2026 Universal Ctags Team
+# License: GPL-2
+
+CTAGS=$1
+READTAGS=$3
+
+. ../utils.sh
+
+if ! [ -x "${READTAGS}" ]; then
+	skip "no readtags"
+fi
+
+if ! ( "${READTAGS}" -h | grep -q -e -Q ); then
+	skip "no qualifier function in readtags"
+fi
+
+O=/tmp/ctags-tmain-$$
+
+${CTAGS} --quiet --options=NONE --fields=+n -o $O input.c
+${READTAGS} -t $O -e -l > $O.serial
+
+for j in 2 3 16; do
+	${READTAGS} -t $O -e -j $j -l > $O.parallel
+	if cmp -s $O.serial $O.parallel; then
+		echo "# -j $j: same"
+	else
+		echo "# -j $j: different"
+	fi
+done
+
+echo '# -Q'
+${READTAGS} -t $O -j 4 -Q '(eq? $kind "m")' -l
+echo '# -Q with an error'
+${READTAGS} -t $O -j 4 -Q '(not (and (eq? $name "point_y") (< $name 1)))' -l
+echo "exit: $?"
+
+rm -f $O $O.serial $O.parallel
@@ -0,0 +1,18 @@
+# Copyright: 2026 Universal Ctags Team
+# License: GPL-2
+
+CTAGS=$1
+READTAGS=$3
+
+. ../utils.sh
+
+if ! [ -x "${READTAGS}" ]; then
+	skip "no readtags"
+fi
+
+echo '# -l'
+${READTAGS} -t input.tags -l
+echo '# -e -l'
+${READTAGS} -t input.tags -e -l
+echo '# -e -n -l'
+${READTAGS} -t input.tags -e -n -l
@@ -0,0 +1,3 @@
+int point;
+int common;
+static int helper (void) { return 0; }
@@ -0,0 +1,38 @@
+# Copyright: 2026 Universal Ctags Team
+# License: GPL-2
+
+CTAGS=$1
+READTAGS=$3
+
+. ../utils.sh
+
+if ! [ -x "${READTAGS}" ]; then
+	skip "no readtags"
+fi
+
+O=/tmp/ctags-tmain-$$
+
+${CTAGS} --quiet --options=NONE -o $O.a a.c
+${CTAGS} --quiet --options=NONE -o $O.b b.c
+
+for j in 1 2; do
+	echo "# -j $j"
+	${READTAGS} -j $j -t $O.a -T $O.b - common point nothing
+	echo "# -j $j, partial"
+	${READTAGS} -j $j -t $O.b -T $O.a -p - point
+	echo "# -j $j, counting"
+	${READTAGS} -j $j -t $O.a -T $O.b -T $O.a -c - common helper nothing
+	echo "# -j $j, listing"
+	${READTAGS} -j $j -t $O.a -T $O.b -l
+done
+
+echo '# -t starts over'
+${READTAGS} -t $O.a -T $O.b -t $O.b - common
+
+echo '# missing tag file'
+${READTAGS} -t $O.a -T $O.none - common 2> /dev/null
+echo $?
+${READTAGS} -j 2 -t $O.a -T $O.none - common 2> /dev/null
+echo $?
+
+rm -f $O.a $O.b
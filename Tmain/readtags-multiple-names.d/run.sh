@@ -0,0 +1,30 @@
+# Copyright: 2026 Universal Ctags Team
+# License: GPL-2
+
+CTAGS=$1
+READTAGS=$3
+
+. ../utils.sh
+
+if ! [ -x "${READTAGS}" ]; then
+	skip "no readtags"
+fi
+
+O=/tmp/ctags-tmain-$$
+
+for sort in yes foldcase; do
+	${CTAGS} --quiet --options=NONE --sort=$sort -o $O.$sort input.c
+done
+
+echo '# sorted'
+${READTAGS} -t $O.yes -e - x point_x nothing y Point_x point z
+echo '# sorted, partial'
+${READTAGS} -t $O.yes -p - point_ x P y
+echo '# foldcase, ignoring case'
+${READTAGS} -t $O.foldcase -i - point_x POINT y Nothing point3
+echo '# foldcase, ignoring case, partial'
+${READTAGS} -t $O.foldcase -ip - POINT_ x P
+echo '# two tag files'
+${READTAGS} -t $O.yes - xmax -t $O.foldcase - ymax
+
+rm -f $O.yes $O.foldcase
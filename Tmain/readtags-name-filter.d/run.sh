@@ -0,0 +1,43 @@
+# Copyright: 2026 Universal Ctags Team
+# License: GPL-2
+
+CTAGS=$1
+READTAGS=$3
+
+. ../utils.sh
+
+if ! [ -x "${READTAGS}" ]; then
+	skip "no readtags"
+fi
+
+O=/tmp/ctags-tmain-$$
+
+${CTAGS} --quiet --options=NONE --sort=no --name-filter -o $O input.c
+[ -f $O.bflt ] && echo "filter written"
+cp $O $O.nofilter
+
+for t in $O $O.nofilter; do
+	echo '# exact'
+	${READTAGS} -t $t - point POINT_X very_long_name_prefix_c nothing
+	echo '# ignoring case'
+	${READTAGS} -t $t -i - POINT_X nothing
+	echo '# partial'
+	${READTAGS} -t $t -p - very_long_name_prefix_ | sort
+	echo '# counting'
+	${READTAGS} -t $t -c - point point_x nothing
+	${READTAGS} -t $t -ci - POINT NOTHING
+	echo '# pseudo tags'
+	${READTAGS} -t $t -c - '!_TAG_FILE_SORTED'
+done
+
+echo '# changed tag file'
+${CTAGS} --quiet --options=NONE --sort=no -o $O.new input.c
+echo 'nothing	input.c	/^int nothing;$/' >> $O.new
+touch -r $O.bflt $O.new
+mv $O.new $O
+${READTAGS} -t $O - nothing
+
+echo '# stdout'
+${CTAGS} --quiet --options=NONE --name-filter -o - input.c
+
+rm -f $O $O.bflt $O.nofilter
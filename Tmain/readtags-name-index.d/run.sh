@@ -0,0 +1,43 @@
+# Copyright: 2026 Universal Ctags Team
+# License: GPL-2
+
+CTAGS=$1
+READTAGS=$3
+
+. ../utils.sh
+
+if ! [ -x "${READTAGS}" ]; then
+	skip "no readtags"
+fi
+
+O=/tmp/ctags-tmain-$$
+
+for sort in yes foldcase; do
+	${CTAGS} --quiet --options=NONE --sort=$sort --name-index -o $O.$sort input.c
+	[ -f $O.$sort.idx ] && echo "$sort: index written"
+done
+
+echo '# sorted'
+${READTAGS} -t $O.yes - point_x POINT very_long_name_prefix very_long_name_p nothing
+echo '# sorted, partial'
+${READTAGS} -t $O.yes -p - very_long_name_prefix_ point_ VERY
+echo '# sorted, counting'
+${READTAGS} -t $O.yes -c - point_x point nothing
+${READTAGS} -t $O.yes -cp - point very_long_name_p very_long_name_prefix_ ''
+echo '# foldcase, ignoring case'
+${READTAGS} -t $O.foldcase -i - point very_long_name_prefix_c
+echo '# foldcase, ignoring case, counting'
+${READTAGS} -t $O.foldcase -ci - point Point_X
+${READTAGS} -t $O.foldcase -cip - POINT very_long_name_prefix
+
+echo '# index of another tag file'
+cp $O.foldcase.idx $O.yes.idx
+${READTAGS} -t $O.yes -cp - point very_long_name_prefix
+${READTAGS} -t $O.yes - very_long_name_p
+
+echo '# unsorted'
+${CTAGS} --quiet --options=NONE --sort=no --name-index -o $O.no input.c
+echo '# stdout'
+${CTAGS} --quiet --options=NONE --name-index -o - input.c
+
+rm -f $O.yes $O.yes.idx $O.foldcase $O.foldcase.idx $O.no
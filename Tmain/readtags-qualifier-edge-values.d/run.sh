@@ -0,0 +1,33 @@
+#!/bin/sh
+
+# Copyright: 2026 Universal Ctags Team
+# License: GPL-2
+
+READTAGS=$3
+
+. ../utils.sh
+
+if ! [ -x "${READTAGS}" ]; then
+	skip "no readtags"
+fi
+
+if ! ( "${READTAGS}" -h | grep -q -e -Q ); then
+    skip "no qualifier function in readtags"
+fi
+
+for e in \
+	'(member "" $inherits)' \
+	'(and (member "p" $inherits) (eq? (member "p" $inherits) (member "p" (member "p" $inherits))))' \
+	'(eq? (member "q" $inherits) (member "q" $inherits))' \
+	'(null? $inherits)' \
+	'(eq? $end 0)' \
+	'(and (eq? $name "a") (< $end 10))' \
+	'(eq? $scope-kind "")' \
+	'(not $scope-name)' \
+	'(eq? 1 1.0)' \
+	'(or (< $name 1) #f)' \
+	'(and #t (< $name 1))' \
+	; do
+	echo ";; $e"
+	${READTAGS} -t input.tags -Q "$e" -l
+done
@@ -0,0 +1,51 @@
+# Copyright: 2026 Universal Ctags Team
+# License: GPL-2
+
+CTAGS=$1
+READTAGS=$3
+
+. ../utils.sh
+
+if ! [ -x "${READTAGS}" ]; then
+	skip "no readtags"
+fi
+
+if ! ( "${READTAGS}" -h | grep -q -e '-S socket' ); then
+	skip "no server function in readtags"
+fi
+
+O=/tmp/ctags-tmain-$$
+S=$O.sock
+
+${CTAGS} --quiet --options=NONE --fields=+n -o $O input.c
+
+${READTAGS} -t $O -S $S &
+SERVER=$!
+i=0
+while ! [ -S $S ] && [ $i -lt 50 ]; do
+	sleep 0.1
+	i=$((i + 1))
+done
+
+for q in "point_x" "-e -n Point_x" "-i point_x" "-p point" "-c -i -p point" \
+		 "-k s -p P" "-e -k m -l" "-l" "no_such_tag" "xmax ymax"; do
+	${READTAGS} -t $O $q > $O.direct
+	${READTAGS} -C $S $q > $O.served
+	if cmp -s $O.direct $O.served; then
+		echo "# $q: same"
+	else
+		echo "# $q: different"
+	fi
+done
+
+echo '# -k s -p point'
+${READTAGS} -C $S -k s -p point
+
+kill $SERVER
+wait $SERVER 2> /dev/null
+
+echo '# no server'
+${READTAGS} -C $S point_x 2> /dev/null
+echo "exit: $?"
+
+rm -f $O $O.direct $O.served $S
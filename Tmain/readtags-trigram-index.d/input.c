@@ -0,0 +1,8 @@
+struct cacheEntry { int key; };
+struct lruCache { int size; };
+int CacheSize;
+int lookupCache (int key) { return key; }
+int cacheLookup (int key) { return key; }
+static int precache;
+int CacheSize;
+int ab;
@@ -0,0 +1,45 @@
+# Copyright: 2026 Universal Ctags Team
+# License: GPL-2
+
+CTAGS=$1
+READTAGS=$3
+
+. ../utils.sh
+
+if ! [ -x "${READTAGS}" ]; then
+	skip "no readtags"
+fi
+
+O=/tmp/ctags-tmain-$$
+
+${CTAGS} --quiet --options=NONE --sort=no --trigram-index -o $O input.c
+[ -f $O.tidx ] && echo "index written"
+cp $O $O.noindex
+
+for t in $O $O.noindex; do
+	echo '# substring'
+	${READTAGS} -t $t -m - Cache
+	echo '# ignoring case'
+	${READTAGS} -t $t -mi - CACHE
+	echo '# shorter than a trigram'
+	${READTAGS} -t $t -m - ab
+	echo '# missing'
+	${READTAGS} -t $t -m - cachex Cachesize
+	echo '# counting'
+	${READTAGS} -t $t -cm - Cache Size nothing
+	${READTAGS} -t $t -cmi - cache
+	echo '# pseudo tags'
+	${READTAGS} -t $t -cm - TAG_
+done
+
+echo '# changed tag file'
+${CTAGS} --quiet --options=NONE --sort=no -o $O.new input.c
+echo 'anotherCache	input.c	1' >> $O.new
+touch -r $O.tidx $O.new
+mv $O.new $O
+${READTAGS} -t $O -m - otherCa
+
+echo '# stdout'
+${CTAGS} --quiet --options=NONE --trigram-index -o - input.c
+
+rm -f $O $O.tidx $O.noindex
@@ -0,0 +1 @@
+def alpha
@@ -0,0 +1 @@
+def beta
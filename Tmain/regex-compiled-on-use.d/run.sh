@@ -0,0 +1,23 @@
+#!/bin/sh
+# Copyright: 2026 Universal Ctags Team
+# License: GPL-2
+
+CTAGS="$1 --quiet --options=NONE"
+
+# The patterns of a language are compiled when a file of it is parsed
+# first, even those no line of the file may match.
+run()
+{
+	${CTAGS} --langdef=X --map-X=.x --kinddef-X=d,def,definitions \
+			 --regex-X='/^def[ \t]+([a-z]+)/\1/d/' \
+			 --regex-X='/^bad(/\1/d/' \
+			 --regex-X='/^worse[[:foo:]]/\1/d/' \
+			 --langdef=Y --map-Y=.y --kinddef-Y=d,def,definitions \
+			 --regex-Y='/^def[ \t]+([a-z]+)/\1/d/' \
+			 -o - "$@" 2>&1 | sed -e 's/\.exe//g'
+}
+
+echo '# no file of X'
+run input.y
+echo '# a file of X'
+run input.x
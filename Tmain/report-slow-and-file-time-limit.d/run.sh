@@ -0,0 +1,34 @@
+# Copyright: 2026 Universal Ctags Team
+# License: GPL-2
+
+CTAGS=$1
+
+# The times depend on the machine, and so the order of the files.
+filter()
+{
+	sed -e 's/^ *[0-9.]* s  */N s /' -e 's/  */ /g' | sort
+}
+
+echo '# report-slow'
+${CTAGS} --quiet --options=NONE --report-slow=3 -o /dev/null input.c input.py 2>&1 | filter
+
+echo '# report-slow with jobs'
+${CTAGS} --quiet --options=NONE --report-slow=2 --jobs=2 -o /dev/null input.c input.py 2>&1 | filter
+
+# A file taking far longer than 1 ms is cut with a warning.
+O=/tmp/ctags-tmain-$$
+awk 'BEGIN { for (i = 0; i < 300000; i++) print "int v" i ";" }' > $O.c
+
+echo '# file-time-limit'
+${CTAGS} --quiet --options=NONE --file-time-limit=1 -o $O.tags $O.c 2>&1 | sed -e "s|$O|input|"
+if [ $(wc -l < $O.tags) -lt 300000 ]; then
+	echo cut
+fi
+
+echo '# no file-time-limit'
+${CTAGS} --quiet --options=NONE --file-time-limit=0 -o - input.c
+
+rm -f $O.c $O.tags
+
+echo '# invalid'
+${CTAGS} --quiet --options=NONE --file-time-limit=1s -o /dev/null input.c
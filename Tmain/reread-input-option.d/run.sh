@@ -0,0 +1,22 @@
+# Copyright: 2026 Universal Ctags Team
+# License: GPL-2
+
+CTAGS=$1
+
+echo '# tags'
+${CTAGS} --quiet --options=NONE --reread-input=no --fields=+n -o - input.c
+
+echo '# excmd=pattern is overridden'
+${CTAGS} --quiet --options=NONE --reread-input=no --excmd=pattern -o - input.c
+
+echo '# json'
+${CTAGS} --quiet --options=NONE --reread-input=no --output-format=json -o - input.c
+
+echo '# xformat'
+${CTAGS} --quiet --options=NONE --reread-input=no -x --_xformat='%N %n %K' -o - input.c
+
+echo '# compact field'
+${CTAGS} --quiet --options=NONE --reread-input=no --fields=+C -o - input.c
+
+echo '# xref'
+${CTAGS} --quiet --options=NONE --reread-input=no -x -o - input.c
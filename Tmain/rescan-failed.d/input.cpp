@@ -0,0 +1,7 @@
+namespace N1
+{
+  namespace N2
+  {
+    class C12{}
+  }
+}
@@ -0,0 +1,16 @@
+# Copyright: 2026 Universal Ctags Team
+# License: GPL-2
+
+CTAGS=$1
+
+# The C++ parser fails on the first pass over input.cpp, and scans it
+# again. The tags of the failed pass must not be in the output.
+
+echo '# ctags'
+${CTAGS} --quiet --options=NONE --pseudo-tags= --fields=+n -o - input.cpp
+
+echo '# etags'
+${CTAGS} --quiet --options=NONE -e -o - input.cpp
+
+echo '# totals'
+${CTAGS} --quiet --options=NONE --totals -o - input.cpp 2>&1 > /dev/null | grep rescan
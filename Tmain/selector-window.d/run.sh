@@ -0,0 +1,19 @@
+# Copyright: 2026 Universal Ctags Team
+# License: GPL-2
+
+CTAGS=$1
+
+O="--quiet --options=NONE"
+
+# The #import telling input.m is ObjectiveC is on its 21st line.
+echo '# whole file'
+${CTAGS} $O --selector-window=0 --print-language input.m
+
+echo '# default window'
+${CTAGS} $O --print-language input.m
+
+echo '# window before the #import'
+${CTAGS} $O --selector-window=64 --print-language input.m
+
+echo '# invalid'
+${CTAGS} $O --selector-window=x --print-language input.m
@@ -0,0 +1,6 @@
+int beta;
+int Alpha;
+int alpha;
+int ALPHA;
+int _gamma;
+int Beta;
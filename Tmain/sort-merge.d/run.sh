@@ -0,0 +1,26 @@
+# Copyright: 2026 Universal Ctags Team
+# License: GPL-2
+
+CTAGS=$1
+
+. ../utils.sh
+
+# The simple internal sort keeps lines differing only in case.
+is_feature_available ${CTAGS} "!" internal-sort
+
+O="--quiet --options=NONE --fields=-t --extras=-p"
+
+for sort in yes foldcase; do
+	echo "# sort=$sort"
+	# A duplicated input file yields duplicated tag lines; only one is kept.
+	${CTAGS} $O --sort=$sort -o - input.c input.c
+	echo "# sort=$sort, to a file"
+	${CTAGS} $O --sort=$sort -o sorted.tags input.c input.c
+	grep -v '^!_' sorted.tags
+done
+
+# Of the blank lines, one is kept like sort -u does.
+echo "# blank lines"
+${CTAGS} $O --sort=yes --output-format=xref --_xformat='%{scope}' -o - input.c
+
+rm -f sorted.tags
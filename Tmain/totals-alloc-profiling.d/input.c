@@ -0,0 +1,4 @@
+int x;
+static void f (void)
+{
+}
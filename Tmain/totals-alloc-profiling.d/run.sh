@@ -0,0 +1,13 @@
+# Copyright: 2026 Universal Ctags Team
+# License: GPL-2
+
+CTAGS=$1
+
+. ../utils.sh
+
+is_feature_available ${CTAGS} alloc-profiling
+
+# The numbers depend on the machine.
+${CTAGS} --quiet --options=NONE --totals -o /dev/null input.c 2>&1 \
+	| sed -n -e '/^ALLOCATION TOTALS/,$p' \
+	| sed -e 's/[0-9][0-9]*/N/g' -e 's/  */ /g'
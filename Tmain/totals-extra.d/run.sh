@@ -0,0 +1,26 @@
+# Copyright: 2026 Universal Ctags Team
+# License: GPL-2
+
+CTAGS=$1
+
+# The numbers depend on the machine. The longest tag line of debug builds
+# and the allocation totals of --enable-alloc-profiling builds are dropped.
+filter()
+{
+	sed -e '/^longest tag line = /d' \
+		-e '/"allocations": /,/]},$/d' \
+		-e '/^$/N' -e '/^\nALLOCATION TOTALS$/,/ (all)$/d' \
+		-e 's/ in [0-9.]* seconds.*//' -e 's/[0-9][0-9.]*/N/g' -e 's/  */ /g'
+}
+
+echo '# extra'
+${CTAGS} --quiet --options=NONE --totals=extra -o /dev/null input.c 2>&1 | filter
+
+echo '# json'
+${CTAGS} --quiet --options=NONE --totals=json -o /dev/null input.c 2>&1 | filter
+
+echo '# kinds'
+${CTAGS} --quiet --options=NONE --totals=kinds --extras=+q -o /dev/null input.c 2>&1 | filter
+
+echo '# invalid'
+${CTAGS} --quiet --options=NONE --totals=all -o /dev/null input.c
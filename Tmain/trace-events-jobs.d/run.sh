@@ -0,0 +1,18 @@
+# Copyright: 2026 Universal Ctags Team
+# License: GPL-2
+
+CTAGS=$1
+
+. ../utils.sh
+
+is_feature_available ${CTAGS} jobs
+
+O=/tmp/ctags-tmain-$$
+
+# A track for each worker
+${CTAGS} --quiet --options=NONE --jobs=2 --trace-events=$O.json -o /dev/null input.c input.c
+grep -c '"name": "worker [12]"' $O.json
+grep -c '"name": "parse"' $O.json
+tail -1 $O.json
+
+rm -f $O.json
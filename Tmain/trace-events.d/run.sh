@@ -0,0 +1,15 @@
+# Copyright: 2026 Universal Ctags Team
+# License: GPL-2
+
+CTAGS=$1
+
+O=/tmp/ctags-tmain-$$
+
+# The events in the order they end, without the times and the process ids
+${CTAGS} --quiet --options=NONE --trace-events=$O.json -o /dev/null input.c
+sed -e 's/"ts": [0-9.]*, "dur": [0-9.]*, //' -e 's/"pid": [0-9]*/"pid": N/' \
+	-e 's/"tid": [0-9]*/"tid": N/' $O.json
+
+rm -f $O.json
+
+${CTAGS} --quiet --options=NONE --trace-events= -o /dev/null input.c
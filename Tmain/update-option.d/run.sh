@@ -0,0 +1,67 @@
+# Copyright: 2026 Universal Ctags Team
+# License: GPL-2
+
+CTAGS=$1
+
+O="--quiet --options=NONE"
+
+update()
+{
+	echo "#" "$@"
+	printf 'int a;\nint b;\n' > src/a.c
+	printf 'int d;\n' > src/d.c
+	rm -f src/e.c
+	${CTAGS} $O "$@" -R -o updated.tags src
+
+	printf 'int a2;\nint b;\n' > src/a.c
+	rm src/d.c
+	printf 'int e;\n' > src/e.c
+	${CTAGS} $O "$@" --update -o updated.tags src/a.c src/d.c src/e.c
+	${CTAGS} $O "$@" -R -o full.tags src
+	if cmp full.tags updated.tags > /dev/null; then
+		echo same
+	else
+		diff -u full.tags updated.tags
+	fi
+}
+
+update
+update --sort=foldcase
+update --tag-relative=always
+update --output-format=e-ctags
+
+echo "# unsorted"
+grep -v '^!_' updated.tags > unsorted.tags
+${CTAGS} $O --sort=no --update -o unsorted.tags src/a.c src/sub/c.sh
+cat unsorted.tags
+
+echo "# errors"
+${CTAGS} $O --update -o - src/a.c 2>&1
+${CTAGS} $O --update -e -o TAGS src/a.c 2>&1
+
+# The tags of the files under a deleted directory go with it, whether
+# the directory is given or found with -R; those of src/gone.c stay.
+removed_directory()
+{
+	echo "#" "$@"
+	mkdir -p src/gone/deeper
+	printf 'int g;\n' > src/gone/g.c
+	printf 'int h;\n' > src/gone/deeper/h.c
+	printf 'int gone;\n' > src/gone.c
+	${CTAGS} $O -R -o updated.tags src
+
+	rm -rf src/gone
+	${CTAGS} $O --update -o updated.tags "$@"
+	${CTAGS} $O -R -o full.tags src
+	if cmp full.tags updated.tags > /dev/null; then
+		echo same
+	else
+		diff -u full.tags updated.tags
+	fi
+	rm -f src/gone.c
+}
+
+removed_directory src/gone
+removed_directory -R src
+
+rm -f src/a.c src/e.c updated.tags full.tags unsorted.tags
@@ -0,0 +1 @@
+static int g (void) { return 0; }
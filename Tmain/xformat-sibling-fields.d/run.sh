@@ -0,0 +1,12 @@
+# Copyright: 2026 Universal Ctags Team
+# License: GPL-2
+
+CTAGS=$1
+
+# {*.properties} initializes the C++ parser after {C.properties} is
+# compiled, adding its properties field as a sibling of the field of
+# the C parser.
+${CTAGS} --quiet --options=NONE \
+	 -x \
+	 --_xformat="%-8N|%8K|%-8{C.properties}|%8{*.properties}|%F" \
+	 input.c input.h
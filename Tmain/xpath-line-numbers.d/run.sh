@@ -0,0 +1,23 @@
+# Copyright: 2026 Universal Ctags Team
+# License: GPL-2
+
+CTAGS=$1
+
+. ../utils.sh
+
+is_feature_available ${CTAGS} xpath
+
+# The line numbers of the elements past line 65535 of an XML file
+O=/tmp/ctags-tmain-$$
+{
+	echo '<project xmlns="http://maven.apache.org/POM/4.0.0">'
+	echo '  <groupId>first</groupId>'
+	awk 'BEGIN { for (i = 0; i < 70000; i++) print "" }'
+	echo '  <artifactId>last</artifactId>'
+	echo '</project>'
+} > $O.xml
+
+${CTAGS} --quiet --options=NONE --language-force=Maven2 --fields=+n -o - $O.xml \
+	| sed -e "s|$O|input|"
+
+rm -f $O.xml
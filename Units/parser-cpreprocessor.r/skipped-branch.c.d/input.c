@@ -0,0 +1,30 @@
+#if 0
+int skipped1 (void);  /* #endif in a comment
+#endif
+*/
+char *s = "a string spanning \
+#endif
+lines";
+int skipped2 (void); // a C++ comment \
+#endif
+#define SKIPPED3 1
+#if 1
+int skipped4 (void);
+#endif
+#else
+int active1 (void);
+#endif
+#if 0
+int skipped5 (void);
+??=endif
+int active2 (void);
+#if 0
+int skipped6 (void);
+%:endif
+int active3 (void);
+#if 0
+int skipped7 (void); \
+#endif
+int skipped8 (void);
+#endif
+int active4 (void);
@@ -0,0 +1,48 @@
+// The function bodies are skipped when nothing found in them could be
+// emitted: what follows them must still be found.
+namespace N
+{
+	int f(int a)
+	{
+		struct S { int m; void g() {} } s;
+		const char * p = "}}}";
+		const char * r = R"xx(}})xx";
+		char c = '}';
+		// }
+		/* } */
+		auto l = [](int q) { return q; };
+		return a;
+	}
+
+	int v1;
+
+	int g(int a)
+	{
+		switch(a)
+		{
+			case 1:
+				return 0;
+			default:
+				break;
+		}
+		if(a > 0)
+		{
+#if 0
+		}
+#endif
+		}
+		return (a > 0) ? a : -a;
+	}
+
+	int v2;
+}
+
+void N::k()
+{
+	for(int i = 0; i < 10; i++)
+	{
+		call([&]{ v1 += i; });
+	}
+}
+
+int v3;
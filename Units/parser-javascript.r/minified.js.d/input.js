@@ -0,0 +1 @@
+!function(e){var t={};function n(r){return t[r]}n.m=e}([function(e,t){e.exports=function(){return 1}}]);var a=1,b=function(c,d){return c+d},D=class extends X{m(){}};const K=[1,2,3],L={x:1,y:function(){}};let z;function f(a,b){function inner(){}if(a){return"}"}return/}/.test(b)}function*g(){yield 1}class C{constructor(){this.p=1}}export function ef(x){}export default class DC{}export const ec=`${a}}`;if(a){var notTop=1}async function af(){}/* the lines of a minified file are long: xxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxx */
@@ -0,0 +1,21 @@
+(defun f0 (x) x)
+(defvar v0 "a string with
+(defun not-f1 ()) at the start of a line")
+#|
+(defun not-f2 ())
+#| nested |#
+(defun not-f3 ())
+|#
+(defparameter v1 #\( "paren")
+(cl:defun f1 ()
+  (list #\) #\"
+;; (defun not-f4 ())
+"(defun not-f5 ())"))
+(foo::defmacro m0 () nil)
+(defun 'f2 () nil)
+(defun (quote f3) () nil)
+'(defun not-f6 ())
+(eval-when (:compile-toplevel)
+  (defun not-f7 ()))
+(progn
+(defun f4 () nil))
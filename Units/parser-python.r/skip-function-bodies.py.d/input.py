@@ -0,0 +1,46 @@
+# The function bodies are skipped with --param-Python:nested=false:
+# what follows them must still be found, and they must still end.
+import os
+
+def f(a, b=(1,
+            2)):
+    def inner():
+        pass
+    s = """
+def not_a_function():
+    pass
+"""
+    t = 'it''s' + "\"" # def neither(): pass
+    u = [
+x for x in a
+]
+    v = a + \
+b
+    class Local:
+        pass
+
+    # a comment at the left margin does not end the body
+# def commented():
+    return s
+
+class C:
+    def m(self):
+        import sys
+        if self:
+            return 1
+	# a tab counts for 8
+        return 2
+
+    def n(self): return 3
+
+    x = 1
+
+@decorator
+async def g():
+    y = 2
+    return y
+
+z = f(1)
+
+def last():
+    w = 0
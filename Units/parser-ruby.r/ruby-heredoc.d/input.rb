@@ -0,0 +1,32 @@
+module M
+  def before
+    text = <<~EOS
+      def not_a_method
+      end
+    EOS
+    text
+  end
+
+  def two
+    puts(<<-ONE, <<"TWO")
+      class NotAClass
+      ONE
+module NotAModule
+TWO
+  end
+
+  def shifted
+    list = []
+    list << value
+    list <<other
+    class << self
+    end
+  end
+
+  SQL = <<'SQL'
+def not_sql; end
+SQL
+
+  def after
+  end
+end
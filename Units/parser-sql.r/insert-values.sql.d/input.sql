@@ -0,0 +1,18 @@
+-- The rows of INSERT statements are skipped without tokens: what
+-- follows them must still be found.
+create table t1 (id int, name varchar(30));
+
+insert into t1 values (1, 'a;b'), (2, 'it''s'), (3, 'create table bad1 (x int);'),
+  (4, 'back\'slash;'), (5, "double;"), (6, (select 1));
+
+insert into t1 (id, name) values (7, 'x');
+create table t2 (id int);
+
+insert into t2 values (8) on duplicate key update id = 9;
+create view v1 as select * from t1;
+
+insert into t2 select id from t1;
+create index i1 on t1 (id);
+
+insert into t2 values (10)
+create table t3 (id int);
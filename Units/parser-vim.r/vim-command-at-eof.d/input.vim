@@ -0,0 +1,2 @@
+com -
+" aaaaaaaaaaaaaaaaaaaaaaaaaaaaaa
\ No newline at end of file
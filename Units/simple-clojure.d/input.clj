@@ -10,3 +10,12 @@
 
 (ns another.name)
 (defn x [])
+'[(defn quoted-in-vector [])]
+`{:f (defn quoted-in-map [])}
+
+#?(:clj
+   (defn rc [] 1)
+   :cljs
+   (defn rc-js [] "(defn in-string [])"))
+#?@(:clj [(defn spliced [])])
+(defn after-conditionals [])
@@ -22,6 +22,21 @@
 /*
  * Types
  */
+
+/* Instructions of the compiled form of an expression, see "Bytecode" */
+enum OpCode {
+	OP_NONE,					/* not compiled */
+	OP_CONST,
+	OP_ERROR,
+	OP_AND,
+	OP_OR,
+	OP_NULL, OP_NOT, OP_EQ, OP_LT, OP_GT, OP_LE, OP_GE,
+	OP_PREFIX, OP_SUFFIX, OP_SUBSTR, OP_MEMBER, OP_ENTRY_REF,
+	OP_NAME, OP_INPUT, OP_ACCESS, OP_FILE, OP_LANGUAGE, OP_IMPLEMENTATION,
+	OP_LINE, OP_KIND, OP_ROLE, OP_PATTERN, OP_INHERITS, OP_SCOPE_KIND,
+	OP_SCOPE_NAME, OP_END,
+};
+
 typedef struct sCode Code;
 typedef EsObject* (* EsEntryProc)  (EsObject *args, tagEntry *entry);
 enum ProcAttr {
@@ -83,44 +98,45 @@ struct sCode {
 	enum ProcAttr flags;
 	int arity;
 	const char* helpstr;
+	enum OpCode op;
 } codes [] = {
-	{ "null?",    builtin_null,   NULL, CHECK_ARITY, 1 },
-	{ "and",     builtin_and,    NULL, SELF_EVAL },
-	{ "or",      builtin_or,     NULL, SELF_EVAL },
-	{ "not",     builtin_not,    NULL, CHECK_ARITY, 1},
-	{ "eq?",     builtin_eq,     NULL, CHECK_ARITY, 2 },
-	{ "<",       builtin_lt,     NULL, CHECK_ARITY, 2 },
-	{ ">",       builtin_gt,     NULL, CHECK_ARITY, 2 },
-	{ "<=",      builtin_le,     NULL, CHECK_ARITY, 2 },
-	{ ">=",      builtin_ge,     NULL, CHECK_ARITY, 2 },
+	{ "null?",    builtin_null,   NULL, CHECK_ARITY, 1, .op = OP_NULL },
+	{ "and",     builtin_and,    NULL, SELF_EVAL, .op = OP_AND },
+	{ "or",      builtin_or,     NULL, SELF_EVAL, .op = OP_OR },
+	{ "not",     builtin_not,    NULL, CHECK_ARITY, 1, .op = OP_NOT },
+	{ "eq?",     builtin_eq,     NULL, CHECK_ARITY, 2, .op = OP_EQ },
+	{ "<",       builtin_lt,     NULL, CHECK_ARITY, 2, .op = OP_LT },
+	{ ">",       builtin_gt,     NULL, CHECK_ARITY, 2, .op = OP_GT },
+	{ "<=",      builtin_le,     NULL, CHECK_ARITY, 2, .op = OP_LE },
+	{ ">=",      builtin_ge,     NULL, CHECK_ARITY, 2, .op = OP_GE },
 	{ "prefix?", builtin_prefix, NULL, CHECK_ARITY, 2,
-	  .helpstr = "(prefix? TARGET<string> PREFIX<string>) -> <boolean>" },
+	  .helpstr = "(prefix? TARGET<string> PREFIX<string>) -> <boolean>", .op = OP_PREFIX },
 	{ "suffix?", builtin_suffix, NULL, CHECK_ARITY, 2,
-	  .helpstr = "(suffix? TARGET<string> SUFFIX<string>) -> <boolean>" },
+	  .helpstr = "(suffix? TARGET<string> SUFFIX<string>) -> <boolean>", .op = OP_SUFFIX },
 	{ "substr?", builtin_substr, NULL, CHECK_ARITY, 2,
-	  .helpstr = "(substr? TARGET<string> SUBSTR<string>) -> <boolean>" },
+	  .helpstr = "(substr? TARGET<string> SUBSTR<string>) -> <boolean>", .op = OP_SUBSTR },
 	{ "member",  builtin_member, NULL, CHECK_ARITY, 2,
-	  .helpstr = "(member ELEMENT LIST) -> #f|<list>'" },
+	  .helpstr = "(member ELEMENT LIST) -> #f|<list>'", .op = OP_MEMBER },
 	{ "$",       builtin_entry_ref, NULL, CHECK_ARITY, 1,
-	  .helpstr = "($ NAME) -> #f|<string>'" },
+	  .helpstr = "($ NAME) -> #f|<string>'", .op = OP_ENTRY_REF },
 
-	{ "$name",           value_name,           NULL, MEMORABLE, 0UL,},
+	{ "$name",           value_name,           NULL, MEMORABLE, 0UL, .op = OP_NAME },
 	{ "$input",          value_input,          NULL, MEMORABLE, 0UL,
-	  .helpstr = "input file name" },
-	{ "$access",         value_access,         NULL, MEMORABLE, 0UL },
+	  .helpstr = "input file name", .op = OP_INPUT },
+	{ "$access",         value_access,         NULL, MEMORABLE, 0UL, .op = OP_ACCESS },
 	{ "$file",           value_file,           NULL, MEMORABLE, 0UL,
-	  .helpstr = "file scope<boolean>" },
-	{ "$language",       value_language,       NULL, MEMORABLE, 0UL },
-	{ "$implementation", value_implementation, NULL, MEMORABLE, 0UL },
-	{ "$line",           value_line,           NULL, MEMORABLE, 0UL },
-	{ "$kind",           value_kind,           NULL, MEMORABLE, 0UL },
-	{ "$role",           value_role,           NULL, MEMORABLE, 0UL },
-	{ "$pattern",        value_pattern,        NULL, MEMORABLE, 0UL },
+	  .helpstr = "file scope<boolean>", .op = OP_FILE },
+	{ "$language",       value_language,       NULL, MEMORABLE, 0UL, .op = OP_LANGUAGE },
+	{ "$implementation", value_implementation, NULL, MEMORABLE, 0UL, .op = OP_IMPLEMENTATION },
+	{ "$line",           value_line,           NULL, MEMORABLE, 0UL, .op = OP_LINE },
+	{ "$kind",           value_kind,           NULL, MEMORABLE, 0UL, .op = OP_KIND },
+	{ "$role",           value_role,           NULL, MEMORABLE, 0UL, .op = OP_ROLE },
+	{ "$pattern",        value_pattern,        NULL, MEMORABLE, 0UL, .op = OP_PATTERN },
 	{ "$inherits",       value_inherits,       NULL, MEMORABLE, 0UL,
-	  .helpstr = "<list>" },
-	{ "$scope-kind",     value_scope_kind,     NULL, MEMORABLE, 0UL },
-	{ "$scope-name",     value_scope_name,     NULL, MEMORABLE, 0UL },
-	{ "$end",            value_end,            NULL, MEMORABLE, 0UL },
+	  .helpstr = "<list>", .op = OP_INHERITS },
+	{ "$scope-kind",     value_scope_kind,     NULL, MEMORABLE, 0UL, .op = OP_SCOPE_KIND },
+	{ "$scope-name",     value_scope_name,     NULL, MEMORABLE, 0UL, .op = OP_SCOPE_NAME },
+	{ "$end",            value_end,            NULL, MEMORABLE, 0UL, .op = OP_END },
 };
 
 static void define (Code *code)
@@ -645,18 +661,618 @@ static EsObject* value_scope_name (EsObject *args, tagEntry *entry)
 
 
 /*
- * QCode
+ * Bytecode
+ *
+ * An expression is compiled into a flat program run on a stack of
+ * values. The values borrow the strings of the tag entry instead of
+ * copying them into objects, so that qualifying an entry allocates
+ * nothing. The program gives the same results and errors as eval, and
+ * and/or still evaluate their arguments lazily. An expression using
+ * something the program does not handle, like a function used as a
+ * variable, is left to eval; so is an entry whose end field is not a
+ * plain number.
  */
 
+enum ValueType {
+	V_FALSE,
+	V_TRUE,
+	V_NIL,
+	V_STRING,
+	V_INTEGER,
+	V_REAL,
+	V_LIST,						/* a non-empty tail of $inherits */
+	V_ERROR,
+};
+
+typedef struct sValue {
+	enum ValueType type;
+	union {
+		struct {
+			const char *ptr;	/* not always terminated */
+			size_t len;
+		} string;
+		int integer;
+		double real;
+		unsigned int list;		/* index of the first element */
+		struct {
+			EsObject *error;
+			EsObject *object;
+		} error;
+	} u;
+} Value;
+
+typedef struct sInsn {
+	enum OpCode op;
+	Value value;				/* for OP_CONST and OP_ERROR */
+	unsigned int jump;			/* for OP_AND and OP_OR */
+	EsObject *symbol;			/* the function, for its errors */
+} Insn;
+
+typedef struct sPiece {
+	const char *ptr;
+	size_t len;
+} Piece;
+
 struct sQCode
 {
 	EsObject *es;
+
+	/* The program, or NULL if the expression is left to eval */
+	Insn *insns;
+	unsigned int count;
+	unsigned int size;
+	unsigned int depth;
+	unsigned int maxDepth;
+	Value *stack;
+
+	/* $inherits of the entry being qualified */
+	Piece *pieces;
+	unsigned int pieceCount;
+	unsigned int pieceSize;
+	int piecesReady;
 };
 
+static const Value False = { .type = V_FALSE };
+static const Value True  = { .type = V_TRUE };
+
+static int emit (QCode *code, enum OpCode op, EsObject *symbol);
+static int compile_error (QCode *code, EsObject *error, EsObject *object);
+
+/* Compile OBJECT, and return 0 if the program cannot evaluate it. */
+static int compile (QCode *code, EsObject *object)
+{
+	Code *c;
+	EsObject *car, *cdr, *args;
+	int l;
+
+	if (es_null (object))
+	{
+		if (!emit (code, OP_CONST, NULL))
+			return 0;
+		code->insns [code->count - 1].value.type = V_NIL;
+		return 1;
+	}
+	else if (es_symbol_p (object))
+	{
+		c = es_symbol_get_data (object);
+		if (c == NULL)
+			return compile_error (code, ERR_UNBOUND_VARIABLE, object);
+		if (! (c->flags & MEMORABLE) || (c->flags & PURE_PROC))
+			return 0;
+		return emit (code, c->op, object);
+	}
+	else if (es_atom (object))
+	{
+		Value v;
+
+		if (es_integer_p (object))
+		{
+			v.type = V_INTEGER;
+			v.u.integer = es_integer_get (object);
+		}
+		else if (es_real_p (object))
+		{
+			v.type = V_REAL;
+			v.u.real = es_real_get (object);
+		}
+		else if (es_string_p (object))
+		{
+			v.type = V_STRING;
+			v.u.string.ptr = es_string_get (object);
+			v.u.string.len = strlen (v.u.string.ptr);
+		}
+		else if (es_boolean_p (object))
+			v = es_boolean_get (object)? True: False;
+		else
+			return 0;
+
+		if (!emit (code, OP_CONST, NULL))
+			return 0;
+		code->insns [code->count - 1].value = v;
+		return 1;
+	}
+
+	car = es_car (object);
+	cdr = es_cdr (object);
+	if (! es_symbol_p (car))
+		return 0;
+	c = es_symbol_get_data (car);
+	if (c == NULL)
+		return compile_error (code, ERR_UNBOUND_VARIABLE, car);
+	if (c->flags & MEMORABLE)
+		return 0;
+	for (args = cdr, l = 0; es_cons_p (args); args = es_cdr (args))
+		l++;
+	if (! es_null (args))
+		return 0;
+
+	if (c->flags & CHECK_ARITY)
+	{
+		if (l < c->arity)
+			return compile_error (code, ERR_TOO_FEW_ARGUMENTS, car);
+		else if (l > c->arity)
+			return compile_error (code, ERR_TOO_MANY_ARGUMENTS, car);
+	}
+
+	if (c->op == OP_AND || c->op == OP_OR)
+	{
+		unsigned int first = code->count;
+		unsigned int i;
+
+		for (args = cdr; !es_null (args); args = es_cdr (args))
+		{
+			if (!compile (code, es_car (args)))
+				return 0;
+			if (!emit (code, c->op, car))
+				return 0;
+			code->depth -= 2;
+		}
+		if (!emit (code, OP_CONST, NULL))
+			return 0;
+		code->insns [code->count - 1].value = (c->op == OP_AND)? True: False;
+		for (i = first; i < code->count; i++)
+			if (code->insns [i].op == c->op && code->insns [i].jump == 0)
+				code->insns [i].jump = code->count;
+		return 1;
+	}
+
+	for (args = cdr; !es_null (args); args = es_cdr (args))
+		if (!compile (code, es_car (args)))
+			return 0;
+	if (!emit (code, c->op, car))
+		return 0;
+	code->depth -= l;
+	return 1;
+}
+
+static int emit (QCode *code, enum OpCode op, EsObject *symbol)
+{
+	Insn *insn;
+
+	if (code->count == code->size)
+	{
+		unsigned int size = code->size? code->size * 2: 16;
+		Insn *insns = realloc (code->insns, sizeof (Insn) * size);
+		if (insns == NULL)
+			return 0;
+		code->insns = insns;
+		code->size = size;
+	}
+	insn = code->insns + code->count++;
+	memset (insn, 0, sizeof (*insn));
+	insn->op = op;
+	insn->symbol = symbol;
+	if (++code->depth > code->maxDepth)
+		code->maxDepth = code->depth;
+	return 1;
+}
+
+static int compile_error (QCode *code, EsObject *error, EsObject *object)
+{
+	if (!emit (code, OP_ERROR, NULL))
+		return 0;
+	code->insns [code->count - 1].value.type = V_ERROR;
+	code->insns [code->count - 1].value.u.error.error = es_object_ref (error);
+	code->insns [code->count - 1].value.u.error.object = es_object_ref (object);
+	return 1;
+}
+
+static Value string_value (const char *ptr, size_t len)
+{
+	Value v;
+
+	v.type = V_STRING;
+	v.u.string.ptr = ptr;
+	v.u.string.len = len;
+	return v;
+}
+
+static Value error_value (EsObject *error, EsObject *object)
+{
+	Value v;
+
+	v.type = V_ERROR;
+	v.u.error.error = error;
+	v.u.error.object = object;
+	return v;
+}
+
+static Value xget_value (tagEntry *entry, const char *name)
+{
+	const char *value = entry_xget (entry, name);
+
+	if (value)
+		return string_value (value, strlen (value));
+	else
+		return False;
+}
+
+/* Split $inherits as value_inherits does. */
+static int split_inherits (QCode *code, tagEntry *entry)
+{
+	const char *h = entry_xget (entry, "inherits");
+	const char *t;
+
+	code->pieceCount = 0;
+	code->piecesReady = 1;
+	while (h != NULL)
+	{
+		if (code->pieceCount == code->pieceSize)
+		{
+			unsigned int size = code->pieceSize? code->pieceSize * 2: 8;
+			Piece *pieces = realloc (code->pieces, sizeof (Piece) * size);
+			if (pieces == NULL)
+			{
+				fprintf(stderr, "MEMORY EXHAUSTED\n");
+				exit (1);
+			}
+			code->pieces = pieces;
+			code->pieceSize = size;
+		}
+		t = strchr (h, ',');
+		if (t == NULL && *h == '\0')
+			break;
+		code->pieces [code->pieceCount].ptr = h;
+		code->pieces [code->pieceCount].len = t? (size_t) (t - h): strlen (h);
+		code->pieceCount++;
+		h = t? t + 1: NULL;
+	}
+	return code->pieceCount;
+}
+
+static Value piece_value (QCode *code, unsigned int i)
+{
+	return string_value (code->pieces [i].ptr, code->pieces [i].len);
+}
+
+/* Like es_object_equal */
+static int value_equal (QCode *code, Value a, Value b)
+{
+	switch (a.type)
+	{
+	case V_FALSE:
+	case V_TRUE:
+	case V_NIL:
+		return a.type == b.type;
+	case V_STRING:
+		return b.type == V_STRING && a.u.string.len == b.u.string.len
+			&& memcmp (a.u.string.ptr, b.u.string.ptr, a.u.string.len) == 0;
+	case V_INTEGER:
+		return b.type == V_INTEGER && a.u.integer == b.u.integer;
+	case V_REAL:
+		return b.type == V_REAL && a.u.real == b.u.real;
+	case V_LIST:
+	{
+		unsigned int i = a.u.list, j;
+
+		if (b.type != V_LIST)
+			return 0;
+		for (j = b.u.list; i < code->pieceCount && j < code->pieceCount; i++, j++)
+			if (!value_equal (code, piece_value (code, i), piece_value (code, j)))
+				return 0;
+		return i == code->pieceCount && j == code->pieceCount;
+	}
+	case V_ERROR:
+		return a.u.error.error == b.u.error.error;
+	}
+	return 0;
+}
+
+static double number_get (Value v)
+{
+	return (v.type == V_INTEGER)? (double) v.u.integer: v.u.real;
+}
+
+/* An integer as es_read_from_string reads it, or -1 */
+static int read_integer (const char *s)
+{
+	int n = 0;
+	int i;
+
+	if (s [0] == '0')
+		return (s [1] == '\0')? 0: -1;
+	for (i = 0; s [i] != '\0'; i++)
+	{
+		if (i == 9 || s [i] < '0' || s [i] > '9')
+			return -1;
+		n = n * 10 + (s [i] - '0');
+	}
+	return (i == 0)? -1: n;
+}
+
+/* Evaluate the program for ENTRY into *RESULT, and return 0 if eval
+ * has to be used. */
+static int run (QCode *code, tagEntry *entry, Value *result)
+{
+	Value *sp = code->stack;
+	unsigned int pc = 0;
+
+	code->piecesReady = 0;
+	while (pc < code->count)
+	{
+		const Insn *insn = code->insns + pc++;
+		Value a, b;
+		const char *s;
+
+		switch (insn->op)
+		{
+		case OP_NONE:
+			return 0;
+		case OP_CONST:
+		case OP_ERROR:
+			*sp++ = insn->value;
+			continue;
+		case OP_AND:
+			a = *--sp;
+			if (a.type == V_FALSE || a.type == V_ERROR)
+			{
+				*sp++ = a;
+				pc = insn->jump;
+			}
+			continue;
+		case OP_OR:
+			a = *--sp;
+			if (a.type != V_FALSE)
+			{
+				*sp++ = True;
+				pc = insn->jump;
+			}
+			continue;
+
+		case OP_NAME:
+			*sp++ = string_value (entry->name, strlen (entry->name));
+			continue;
+		case OP_INPUT:
+			*sp++ = string_value (entry->file, strlen (entry->file));
+			continue;
+		case OP_ACCESS:
+			*sp++ = xget_value (entry, "access");
+			continue;
+		case OP_FILE:
+			*sp++ = entry->fileScope? True: False;
+			continue;
+		case OP_LANGUAGE:
+			*sp++ = xget_value (entry, "language");
+			continue;
+		case OP_IMPLEMENTATION:
+			*sp++ = xget_value (entry, "implementation");
+			continue;
+		case OP_LINE:
+			if (entry->address.lineNumber == 0)
+				*sp++ = False;
+			else
+			{
+				sp->type = V_INTEGER;
+				sp->u.integer = (int) entry->address.lineNumber;
+				sp++;
+			}
+			continue;
+		case OP_KIND:
+			*sp++ = entry->kind? string_value (entry->kind, strlen (entry->kind)): False;
+			continue;
+		case OP_ROLE:
+			*sp++ = xget_value (entry, "role");
+			continue;
+		case OP_PATTERN:
+			s = entry->address.pattern;
+			*sp++ = s? string_value (s, strlen (s)): False;
+			continue;
+		case OP_INHERITS:
+			if (!code->piecesReady)
+				split_inherits (code, entry);
+			if (code->pieceCount == 0)
+				sp->type = V_NIL;
+			else
+			{
+				sp->type = V_LIST;
+				sp->u.list = 0;
+			}
+			sp++;
+			continue;
+		case OP_SCOPE_KIND:
+		case OP_SCOPE_NAME:
+		{
+			const char *scope = entry_xget (entry, "scope");
+			const char *kind = scope? strchr (scope, ':'): NULL;
+
+			if (kind == NULL)
+				*sp++ = False;
+			else if (insn->op == OP_SCOPE_KIND)
+				*sp++ = string_value (scope, kind - scope);
+			else if (kind [1] == '\0')
+				*sp++ = False;
+			else
+				*sp++ = string_value (kind + 1, strlen (kind + 1));
+			continue;
+		}
+		case OP_END:
+			s = entry_xget (entry, "end");
+			if (s == NULL)
+				*sp++ = False;
+			else if (read_integer (s) < 0)
+				return 0;
+			else
+			{
+				sp->type = V_INTEGER;
+				sp->u.integer = read_integer (s);
+				sp++;
+			}
+			continue;
+		default:
+			break;
+		}
+
+		/* The functions, whose arguments are all evaluated */
+		if (insn->op == OP_NULL || insn->op == OP_NOT || insn->op == OP_ENTRY_REF)
+		{
+			a = *--sp;
+			if (a.type == V_ERROR)
+			{
+				*sp++ = a;
+				continue;
+			}
+		}
+		else
+		{
+			b = *--sp;
+			a = *--sp;
+			if (a.type == V_ERROR || b.type == V_ERROR)
+			{
+				*sp++ = (a.type == V_ERROR)? a: b;
+				continue;
+			}
+		}
+
+		switch (insn->op)
+		{
+		case OP_NULL:
+			*sp++ = (a.type == V_NIL)? True: False;
+			break;
+		case OP_NOT:
+			*sp++ = (a.type == V_FALSE)? True: False;
+			break;
+		case OP_EQ:
+			*sp++ = value_equal (code, a, b)? True: False;
+			break;
+		case OP_LT:
+		case OP_GT:
+		case OP_LE:
+		case OP_GE:
+			if ((a.type != V_INTEGER && a.type != V_REAL)
+				|| (b.type != V_INTEGER && b.type != V_REAL))
+				*sp++ = error_value (ERR_NUMBER_REQUIRED, insn->symbol);
+			else if (insn->op == OP_LT)
+				*sp++ = (number_get (a) <  number_get (b))? True: False;
+			else if (insn->op == OP_GT)
+				*sp++ = (number_get (a) >  number_get (b))? True: False;
+			else if (insn->op == OP_LE)
+				*sp++ = (number_get (a) <= number_get (b))? True: False;
+			else
+				*sp++ = (number_get (a) >= number_get (b))? True: False;
+			break;
+		case OP_PREFIX:
+		case OP_SUFFIX:
+		case OP_SUBSTR:
+			if (a.type != V_STRING || b.type != V_STRING)
+				*sp++ = error_value (ERR_WRONG_TYPE_ARGUMENT, insn->symbol);
+			else if (a.u.string.len < b.u.string.len)
+				*sp++ = False;
+			else if (insn->op == OP_PREFIX)
+				*sp++ = (memcmp (a.u.string.ptr, b.u.string.ptr,
+								 b.u.string.len) == 0)? True: False;
+			else if (insn->op == OP_SUFFIX)
+				*sp++ = (memcmp (a.u.string.ptr + a.u.string.len - b.u.string.len,
+								 b.u.string.ptr, b.u.string.len) == 0)? True: False;
+			else
+			{
+				size_t i;
+
+				*sp = False;
+				for (i = 0; i + b.u.string.len <= a.u.string.len; i++)
+					if (memcmp (a.u.string.ptr + i, b.u.string.ptr, b.u.string.len) == 0)
+					{
+						*sp = True;
+						break;
+					}
+				sp++;
+			}
+			break;
+		case OP_MEMBER:
+			if (b.type == V_NIL)
+				*sp++ = False;
+			else if (b.type != V_LIST)
+				*sp++ = error_value (ERR_WRONG_TYPE_ARGUMENT, insn->symbol);
+			else
+			{
+				unsigned int i;
+
+				*sp = False;
+				for (i = b.u.list; i < code->pieceCount; i++)
+					if (value_equal (code, a, piece_value (code, i)))
+					{
+						sp->type = V_LIST;
+						sp->u.list = i;
+						break;
+					}
+				sp++;
+			}
+			break;
+		case OP_ENTRY_REF:
+			if (a.type != V_STRING)
+				*sp++ = error_value (ERR_WRONG_TYPE_ARGUMENT, insn->symbol);
+			else
+			{
+				unsigned int i;
+
+				*sp = False;
+				for (i = 0; i < entry->fields.count; ++i)
+				{
+					const char *key = entry->fields.list [i].key;
+					if (strncmp (key, a.u.string.ptr, a.u.string.len) == 0
+						&& key [a.u.string.len] == '\0')
+					{
+						s = entry->fields.list [i].value;
+						*sp = string_value (s, strlen (s));
+						break;
+					}
+				}
+				sp++;
+			}
+			break;
+		default:
+			return 0;
+		}
+	}
+
+	*result = sp [-1];
+	return 1;
+}
+
+/*
+ * QCode
+ */
+
+static void release_program (QCode *code)
+{
+	unsigned int i;
+
+	for (i = 0; i < code->count; i++)
+		if (code->insns [i].op == OP_ERROR)
+		{
+			es_object_unref (code->insns [i].value.u.error.error);
+			es_object_unref (code->insns [i].value.u.error.object);
+		}
+	free (code->insns);
+	free (code->stack);
+	code->insns = NULL;
+	code->stack = NULL;
+	code->count = 0;
+}
+
 QCode  *q_compile (EsObject *exp)
 {
-	static QCode code;
 	static int initialized;
+	QCode *code;
 
 	if (!initialized)
 	{
@@ -664,31 +1280,54 @@ QCode  *q_compile (EsObject *exp)
 		initialized = 1;
 	}
 
-	code.es = es_object_ref (exp);
-	return &code;
+	code = calloc (1, sizeof (QCode));
+	if (code == NULL)
+		return NULL;
+	code->es = es_object_ref (exp);
+
+	if (compile (code, code->es) && code->depth == 1)
+		code->stack = malloc (sizeof (Value) * code->maxDepth);
+	if (code->stack == NULL)
+		release_program (code);
+	return code;
+}
+
+static enum QRESULT report_error (EsObject *r)
+{
+	MIO  *mioerr = mio_new_fp (stderr, NULL);;
+
+	fprintf(stderr, "GOT ERROR in QUALIFYING: %s: ",
+		 es_error_name (r));
+	es_print(es_error_get_object(r), mioerr);
+	putc('\n', stderr);
+
+	mio_free(mioerr);
+	return Q_ERROR;
 }
 
 enum QRESULT q_is_acceptable  (QCode *code, tagEntry *entry)
 {
 	EsObject *r;
+	Value v;
 	int i;
 
+	if (code->insns && run (code, entry, &v))
+	{
+		if (v.type == V_FALSE)
+			return Q_REJECT;
+		else if (v.type == V_ERROR)
+			return report_error (es_error_set_object (v.u.error.error,
+													  v.u.error.object));
+		else
+			return Q_ACCEPT;
+	}
+
 	es_autounref_pool_push ();
 	r = eval (code->es, entry);
 	if (es_object_equal (r, es_false))
 		i = Q_REJECT;
 	else if (es_error_p (r))
-	{
-		MIO  *mioerr = mio_new_fp (stderr, NULL);;
-
-		fprintf(stderr, "GOT ERROR in QUALIFYING: %s: ",
-			 es_error_name (r));
-		es_print(es_error_get_object(r), mioerr);
-		putc('\n', stderr);
-		i = Q_ERROR;
-
-		mio_free(mioerr);
-	}
+		i = report_error (r);
 	else
 		i = Q_ACCEPT;
 	es_autounref_pool_pop ();
@@ -700,6 +1339,8 @@ enum QRESULT q_is_acceptable  (QCode *code, tagEntry *entry)
 
 void    q_destroy (QCode *code)
 {
+	release_program (code);
+	free (code->pieces);
 	es_object_unref (code->es);
 	free (code);
 }
@@ -153,6 +153,34 @@ static char* nextFileLine (FILE* const fp)
 	return result;
 }
 
+/* Items are taken as they are, blanks included; empty items are skipped. */
+static char* nextFileNulItem (FILE* const fp)
+{
+	char* result = NULL;
+	Assert (fp != NULL);
+	if (! feof (fp))
+	{
+		vString* vs = vStringNew ();
+		int c;
+
+		do
+			c = fgetc (fp);
+		while (c == '\0');
+		while (c != EOF  &&  c != '\0')
+		{
+			vStringPut (vs, c);
+			c = fgetc (fp);
+		}
+		if (vStringLength (vs) > 0)
+		{
+			result = xMalloc (vStringLength (vs) + 1, char);
+			strcpy (result, vStringValue (vs));
+		}
+		vStringDelete (vs);
+	}
+	return result;
+}
+
 static bool isCommentLine (char* line)
 {
 	while (isspace(*line))
@@ -178,7 +206,9 @@ static char* nextFileLineSkippingComments (FILE* const fp)
 static char* nextFileString (const Arguments* const current, FILE* const fp)
 {
 	char* result;
-	if (current->lineMode)
+	if (current->nulMode)
+		result = nextFileNulItem (fp);
+	else if (current->lineMode)
 		result = nextFileLineSkippingComments (fp);
 	else
 		result = nextFileArg (fp);
@@ -227,6 +257,17 @@ extern Arguments* argNewFromLineFile (FILE* const fp)
 	return result;
 }
 
+extern Arguments* argNewFromNulFile (FILE* const fp)
+{
+	Arguments* result = xMalloc (1, Arguments);
+	memset (result, 0, sizeof (Arguments));
+	result->type = ARG_FILE;
+	result->nulMode = true;
+	result->u.fileArgs.fp = fp;
+	result->item = nextFileString (result, result->u.fileArgs.fp);
+	return result;
+}
+
 extern char *argItem (const Arguments* const current)
 {
 	Assert (current != NULL);
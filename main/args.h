@@ -38,6 +38,7 @@ typedef struct sArgs {
 	} u;
 	char* item;
 	bool lineMode;
+	bool nulMode;
 } Arguments;
 
 /*
@@ -47,6 +48,7 @@ extern Arguments* argNewFromString (const char* const string);
 extern Arguments* argNewFromArgv (char* const* const argv);
 extern Arguments* argNewFromFile (FILE* const fp);
 extern Arguments* argNewFromLineFile (FILE* const fp);
+extern Arguments* argNewFromNulFile (FILE* const fp);
 extern char *argItem (const Arguments* const current);
 extern bool argOff (const Arguments* const current);
 extern void argSetWordMode (Arguments* const current);
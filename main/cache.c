@@ -0,0 +1,1115 @@
+/*
+*   Copyright (c) 2026, Universal Ctags Team
+*
+*   This source code is released for free distribution under the terms of the
+*   GNU General Public License version 2 or (at your option) any later version.
+*
+*   This module contains functions for the tag cache (--cache-dir): the
+*   tags made for an input file are stored in the cache directory, and
+*   reused instead of parsing the file again while the file, its name,
+*   and the options stay the same.
+*
+*   An entry holds the output of the writer for the file, a tag file
+*   fragment, so the writer and its options are part of the key. Entries
+*   are never removed by ctags; remove the directory to clean it. The
+*   entries for the blobs of --git-tree are keyed by the blob ids instead of
+*   the contents, so that a blob found in the cache is not read at all.
+*
+*   It also contains functions for the manifest (--manifest), a cheaper
+*   way to the same end: "TAGFILE.manifest" lists the files tagged into
+*   TAGFILE with their modification times, sizes, and serial numbers. A
+*   file whose status is the same is not read at all; its tags are kept
+*   while the tag file is updated as with --update.
+*
+*   And it contains functions for --deduplicate-inputs: the tags made for
+*   the contents of a file are kept in memory for the run, and written
+*   again with the input field of another file with the same contents
+*   and base name instead of parsing that file.
+*/
+
+/*
+*   INCLUDE FILES
+*/
+#include "general.h"  /* must always come first */
+
+#include <stdio.h>
+#include <string.h>
+#include <stdint.h>
+#include <time.h>
+#ifdef HAVE_SYS_TYPES_H
+# include <sys/types.h>
+#endif
+#ifdef HAVE_SYS_STAT_H
+# include <sys/stat.h>
+#endif
+#ifdef HAVE_UNISTD_H
+# include <unistd.h>
+#endif
+#ifdef HAVE_DIRECT_H
+# include <direct.h>  /* to declare _mkdir () */
+#endif
+#ifdef HAVE_WORKING_FORK
+# include <errno.h>
+# include <sys/socket.h>
+# ifdef HAVE_SYS_WAIT_H
+#  include <sys/wait.h>
+# endif
+#endif
+
+#include "cache.h"
+#include "ctags.h"
+#include "debug.h"
+#include "entry.h"
+#include "htable.h"
+#include "main.h"
+#include "mio.h"
+#include "options.h"
+#include "parse.h"
+#include "ptag.h"
+#include "read.h"
+#include "routines.h"
+#include "vstring.h"
+#include "writer.h"
+
+/*
+*   MACROS
+*/
+#define CACHE_MAGIC  "!_CTAGS_CACHE"
+#define CACHE_FORMAT 1
+
+#define MANIFEST_MAGIC  "!_CTAGS_MANIFEST"
+#define MANIFEST_FORMAT 1
+
+/* The tags of distinct contents kept for --deduplicate-inputs */
+#ifndef DEDUP_MEMORY_BUDGET
+# define DEDUP_MEMORY_BUDGET (64 * 1024 * 1024)
+#endif
+
+#if defined (HAVE_WORKING_FORK) && ! defined (MSG_NOSIGNAL)
+# define MSG_NOSIGNAL 0
+#endif
+
+/* 64 bit FNV-1a */
+#define HASH_OFFSET_BASIS UINT64_C(0xcbf29ce484222325)
+#define HASH_PRIME        UINT64_C(0x100000001b3)
+
+/*
+*   DATA DECLARATIONS
+*/
+typedef struct sCacheEntry {
+	tagFileFragment fragment;
+	long files, lines;
+	const char *output;
+} cacheEntry;
+
+typedef struct sDuplicateEntry {
+	tagFileFragment fragment;
+	long files, lines;
+	size_t size;				/* of the contents */
+	size_t inputLength;			/* of the input field in OUTPUT */
+	char *output;
+} duplicateEntry;
+
+#ifdef HAVE_WORKING_FORK
+typedef struct sRemoteCache {
+	pid_t pid;					/* of the helper, 0 if not running */
+	pid_t owner;				/* the process which started it */
+	int fd;						/* socket to the helper */
+	bool broken;				/* not to be asked again */
+} remoteCache;
+#endif
+
+typedef struct sManifestEntry {
+	unsigned long mtime, size, inode;
+	bool seen;					/* in this run */
+} manifestEntry;
+
+/*
+*   DATA DEFINITIONS
+*/
+static bool CacheDirectoryReady;
+#ifdef HAVE_WORKING_FORK
+static remoteCache Remote = { .fd = -1 };
+#endif
+
+static hashTable *OldManifest;	/* file name -> manifestEntry */
+static unsigned long OldManifestStart;
+static MIO *NewManifest;
+static unsigned long NewManifestStart;
+
+static hashTable *Duplicates;	/* key -> duplicateEntry */
+static size_t DuplicatesSize;
+
+/*
+*   FUNCTION DEFINITIONS
+*/
+
+extern bool canUseTagCache (void)
+{
+	/* The entries keep the lines of the tag file only. */
+	if (Option.cacheDir == NULL || Option.outputs
+		|| Option.partition != PARTITION_NONE
+		|| Option.filter || Option.interactive || Option.printLanguage)
+		return false;
+
+	/* Pseudo tags for parsers are emitted when a parser runs first time. */
+	return ! (isPtagEnabled (PTAG_KIND_DESCRIPTION) || isPtagEnabled (PTAG_KIND_SEPARATOR));
+}
+
+static uint64_t hashBytes (uint64_t hash, const void *data, size_t length)
+{
+	const unsigned char *p = data;
+	const unsigned char *const end = p + length;
+
+	for (; p < end; p++)
+	{
+		hash ^= *p;
+		hash *= HASH_PRIME;
+	}
+	return hash;
+}
+
+static uint64_t hashString (uint64_t hash, const char *s)
+{
+	/* With the terminator, so that "ab" "c" differs from "a" "bc" */
+	return hashBytes (hash, s, strlen (s) + 1);
+}
+
+static uint64_t hashConfiguration (void)
+{
+	uint64_t hash = HASH_OFFSET_BASIS;
+
+	hash = hashString (hash, PROGRAM_VERSION);
+	hash = hashString (hash, ctags_repoinfo? ctags_repoinfo: "");
+	hash = hashString (hash, getOptionHistory ());
+	return hashString (hash, CurrentDirectory? CurrentDirectory: "");
+}
+
+static void formatKey (char hex [17], uint64_t key)
+{
+	snprintf (hex, 17, "%08lx%08lx",
+			  (unsigned long) (key >> 32), (unsigned long) (key & 0xffffffffUL));
+}
+
+/*  The key covers everything the tags of a file depend on: the ctags
+ *  build, the options, the name of the input, the name written in the
+ *  input field of its tags, and the contents of the input. The tag file
+ *  name is not part of it: it matters only through the input field, so
+ *  that a header tagged into the tag files of several components is
+ *  parsed once.
+ */
+static uint64_t makeCacheKey (const char *const fileName,
+							  const unsigned char *data, size_t size)
+{
+	uint64_t hash = hashConfiguration ();
+	vString *tagPath = makeInputTagPath (fileName);
+
+	hash = hashString (hash, vStringValue (tagPath));
+	vStringDelete (tagPath);
+	hash = hashString (hash, fileName);
+	return hashBytes (hash, data, size);
+}
+
+/*  For contents known by the id of a blob in a version control system,
+ *  which stands for the contents themselves.
+ */
+static uint64_t makeBlobCacheKey (const char *const fileName,
+								  const char *const blobId)
+{
+	uint64_t hash = hashConfiguration ();
+	vString *tagPath = makeInputTagPath (fileName);
+
+	hash = hashString (hash, vStringValue (tagPath));
+	vStringDelete (tagPath);
+	hash = hashString (hash, fileName);
+	hash = hashString (hash, "blob");
+	return hashString (hash, blobId);
+}
+
+static bool prepareCacheDirectory (void)
+{
+	fileStatus *status;
+	bool ready;
+
+	if (CacheDirectoryReady)
+		return true;
+
+	status = eStat (Option.cacheDir);
+	ready = status->isDirectory;
+	eStatFree (status);
+	if (! ready)
+	{
+#if defined (HAVE_DIRECT_H) && ! defined (HAVE_UNISTD_H)
+		ready = (_mkdir (Option.cacheDir) == 0);
+#else
+		ready = (mkdir (Option.cacheDir, 0777) == 0);
+#endif
+		if (! ready)
+			error (WARNING | PERROR, "cannot create cache directory \"%s\"",
+				   Option.cacheDir);
+	}
+	CacheDirectoryReady = ready;
+	return ready;
+}
+
+static char *cacheEntryName (uint64_t key)
+{
+	char hex [17];
+
+	formatKey (hex, key);
+	return combinePathAndFile (Option.cacheDir, hex);
+}
+
+/*  Fill ENTRY from the cache entry held in DATA, and return whether it
+ *  was stored for FILENAME with SIZE bytes of contents. Hash collisions
+ *  are unlikely, but cheap to detect.
+ */
+static bool parseCacheEntry (const char *data, size_t length,
+							 const char *const fileName, size_t size,
+							 cacheEntry *entry)
+{
+	unsigned int format;
+	unsigned long inputSize, numTags, maxLine, maxTag;
+	long files, lines, outputSize;
+	char header [256];
+	const char *nl = memchr (data, '\n', length);
+	const char *name;
+	const size_t nameLength = strlen (fileName);
+	const char *const end = data + length;
+
+	/* DATA is not nul-terminated */
+	if (nl == NULL || (size_t) (nl - data) >= sizeof (header))
+		return false;
+	memcpy (header, data, nl - data);
+	header [nl - data] = '\0';
+	if (sscanf (header, CACHE_MAGIC "\t%u\t%lu\t%ld\t%ld\t%lu\t%lu\t%lu\t%ld",
+				&format, &inputSize, &files, &lines,
+				&numTags, &maxLine, &maxTag, &outputSize) != 8
+		|| format != CACHE_FORMAT || inputSize != size)
+		return false;
+
+	name = nl + 1;
+	if ((size_t) (end - name) < nameLength + 1
+		|| memcmp (name, fileName, nameLength) != 0 || name [nameLength] != '\n')
+		return false;
+
+	entry->output = name + nameLength + 1;
+	if (outputSize < 0 || end - entry->output != outputSize)
+		return false;
+
+	entry->fragment.size = outputSize;
+	entry->fragment.numTags = numTags;
+	entry->fragment.maxLine = maxLine;
+	entry->fragment.maxTag = maxTag;
+	entry->files = files;
+	entry->lines = lines;
+	return true;
+}
+
+static vString *makeTemporaryName (const char *const name)
+{
+	vString *tmpName = vStringNewInit (name);
+#ifdef HAVE_UNISTD_H
+	char pid [32];
+
+	snprintf (pid, sizeof (pid), ".%ld", (long) getpid ());
+	vStringCatS (tmpName, pid);
+#else
+	vStringCatS (tmpName, ".tmp");
+#endif
+	return tmpName;
+}
+
+/*  Write the entry into a file of its own first, so that a concurrent
+ *  reader (a worker of --jobs or another ctags) never sees a partial
+ *  entry.
+ */
+static bool storeCacheEntry (const char *const entryName,
+							 const char *const fileName, size_t size,
+							 const cacheEntry *entry)
+{
+	vString *tmpName = makeTemporaryName (entryName);
+	MIO *mio;
+	bool failed;
+
+	mio = mio_new_file (vStringValue (tmpName), "wb");
+	if (mio == NULL)
+	{
+		error (WARNING | PERROR, "cannot write cache entry \"%s\"",
+			   vStringValue (tmpName));
+		vStringDelete (tmpName);
+		return false;
+	}
+
+	mio_printf (mio, CACHE_MAGIC "\t%u\t%lu\t%ld\t%ld\t%lu\t%lu\t%lu\t%ld\n%s\n",
+				CACHE_FORMAT, (unsigned long) size, entry->files, entry->lines,
+				entry->fragment.numTags,
+				(unsigned long) entry->fragment.maxLine,
+				(unsigned long) entry->fragment.maxTag,
+				entry->fragment.size, fileName);
+	if (entry->fragment.size > 0)
+		mio_write (mio, entry->output, 1, entry->fragment.size);
+
+	failed = mio_error (mio);
+	if (mio_free (mio) != 0)
+		failed = true;
+	if (failed || rename (vStringValue (tmpName), entryName) != 0)
+	{
+		error (WARNING | PERROR, "cannot write cache entry \"%s\"", entryName);
+		remove (vStringValue (tmpName));
+		failed = true;
+	}
+	vStringDelete (tmpName);
+	return ! failed;
+}
+
+/*
+ *  Remote tag cache
+ *
+ *  The helper of --cache-remote is run with "sh -c", and reads requests
+ *  from its standard input, one per line:
+ *
+ *    get KEY PATH    fetch the entry KEY into the file PATH, and answer
+ *                    "hit" or "miss" on a line of its standard output
+ *    put KEY PATH    store the entry KEY in the file PATH; no answer
+ *
+ *  PATH is the rest of the line. The helper may store entries in the
+ *  background, but must be done with them when its input ends. A worker
+ *  of --jobs starts a helper of its own.
+ */
+#ifdef HAVE_WORKING_FORK
+static void breakRemoteCache (const char *const what)
+{
+	error (WARNING, "remote tag cache \"%s\" %s; not used any more",
+		   Option.cacheRemote, what);
+	Remote.broken = true;
+}
+
+static bool startRemoteCache (void)
+{
+	int fds [2];
+
+	if (Remote.broken)
+		return false;
+	if (Remote.pid > 0)
+	{
+		if (Remote.owner == getpid ())
+			return true;
+		/* The helper of the parent, inherited by a worker of --jobs */
+		close (Remote.fd);
+		Remote.pid = 0;
+	}
+
+	if (socketpair (AF_UNIX, SOCK_STREAM, 0, fds) < 0)
+	{
+		error (WARNING | PERROR, "cannot create a socket for \"%s\"",
+			   Option.cacheRemote);
+		Remote.broken = true;
+		return false;
+	}
+
+	/* The child must not write the buffered data of the parent again. */
+	fflush (NULL);
+	Remote.pid = fork ();
+	if (Remote.pid < 0)
+	{
+		error (WARNING | PERROR, "cannot run \"%s\"", Option.cacheRemote);
+		close (fds [0]);
+		close (fds [1]);
+		Remote.pid = 0;
+		Remote.broken = true;
+		return false;
+	}
+	else if (Remote.pid == 0)
+	{
+		dup2 (fds [1], STDIN_FILENO);
+		dup2 (fds [1], STDOUT_FILENO);
+		close (fds [0]);
+		close (fds [1]);
+		execl ("/bin/sh", "sh", "-c", Option.cacheRemote, (char *) NULL);
+		fprintf (stderr, "%s: cannot run %s: %s\n",
+				 getExecutableName (), Option.cacheRemote, strerror (errno));
+		_exit (127);
+	}
+
+	close (fds [1]);
+	Remote.fd = fds [0];
+	Remote.owner = getpid ();
+	verbose ("remote tag cache: started \"%s\"\n", Option.cacheRemote);
+	return true;
+}
+
+/*  Send a request for the entry ENTRYNAME, stored in or fetched into
+ *  PATH. A helper which is gone breaks the remote cache instead of
+ *  raising SIGPIPE.
+ */
+static bool requestRemoteCache (const char *const command,
+								const char *const entryName,
+								const char *const path)
+{
+	vString *request = vStringNewInit (command);
+	const char *p;
+	size_t left;
+	bool sent = true;
+
+	vStringPut (request, ' ');
+	vStringCatS (request, baseFilename (entryName));
+	vStringPut (request, ' ');
+	vStringCatS (request, path);
+	vStringPut (request, '\n');
+
+	p = vStringValue (request);
+	left = vStringLength (request);
+	while (left > 0)
+	{
+		const ssize_t n = send (Remote.fd, p, left, MSG_NOSIGNAL);
+
+		if (n < 0 && errno == EINTR)
+			continue;
+		if (n <= 0)
+		{
+			breakRemoteCache ("is gone");
+			sent = false;
+			break;
+		}
+		p += n;
+		left -= n;
+	}
+	vStringDelete (request);
+	return sent;
+}
+
+/*  Read the answer to a "get" request, and return whether it is "hit". */
+static bool isRemoteCacheHit (void)
+{
+	char answer [16];
+	size_t length = 0;
+
+	for (;;)
+	{
+		char c;
+		const ssize_t n = read (Remote.fd, &c, 1);
+
+		if (n < 0 && errno == EINTR)
+			continue;
+		if (n <= 0)
+		{
+			breakRemoteCache ("is gone");
+			return false;
+		}
+		if (c == '\n')
+			break;
+		if (length < sizeof (answer) - 1)
+			answer [length++] = c;
+	}
+	answer [length] = '\0';
+
+	if (strcmp (answer, "hit") == 0)
+		return true;
+	else if (strcmp (answer, "miss") != 0)
+		breakRemoteCache ("gave an unknown answer");
+	return false;
+}
+
+/*  Fetch the entry ENTRYNAME missing from the cache directory. The
+ *  helper writes it into a file of its own, as in storeCacheEntry ().
+ */
+static bool fetchRemoteCacheEntry (const char *const entryName)
+{
+	vString *tmpName;
+	bool hit;
+
+	if (Option.cacheRemote == NULL || strchr (entryName, '\n')
+		|| ! startRemoteCache ())
+		return false;
+
+	tmpName = makeTemporaryName (entryName);
+	hit = (requestRemoteCache ("get", entryName, vStringValue (tmpName))
+		   && isRemoteCacheHit ());
+	if (hit && rename (vStringValue (tmpName), entryName) != 0)
+		hit = false;
+	if (! hit)
+		remove (vStringValue (tmpName));
+	vStringDelete (tmpName);
+	return hit;
+}
+
+static void storeRemoteCacheEntry (const char *const entryName)
+{
+	if (Option.cacheRemote && strchr (entryName, '\n') == NULL
+		&& startRemoteCache ())
+		requestRemoteCache ("put", entryName, entryName);
+}
+
+extern void closeRemoteTagCache (void)
+{
+	int status;
+
+	if (Remote.pid == 0 || Remote.owner != getpid ())
+		return;
+
+	/* The end of its input tells the helper to finish. */
+	close (Remote.fd);
+	while (waitpid (Remote.pid, &status, 0) < 0)
+	{
+		if (errno != EINTR)
+		{
+			status = 0;
+			break;
+		}
+	}
+	if (! WIFEXITED (status) || WEXITSTATUS (status) != 0)
+		error (WARNING, "remote tag cache \"%s\" failed", Option.cacheRemote);
+	Remote.pid = 0;
+	Remote.fd = -1;
+}
+#else
+static bool fetchRemoteCacheEntry (const char *const entryName CTAGS_ATTR_UNUSED)
+{
+	return false;
+}
+
+static void storeRemoteCacheEntry (const char *const entryName CTAGS_ATTR_UNUSED)
+{
+}
+
+extern void closeRemoteTagCache (void)
+{
+}
+#endif
+
+static bool parseFileIntoCache (const char *const fileName, MIO *input,
+								bool executable,
+								const char *const entryName, size_t size)
+{
+	MIO *output = mio_new_memory (NULL, 0, eRealloc, eFree);
+	long files0, lines0, bytes0, files1, lines1, bytes1;
+	cacheEntry entry;
+	bool resize;
+
+	getTotals (&files0, &lines0, &bytes0);
+	openTagFileFragment (output);
+	resize = parseFileWithMioAsExecutable (fileName, input, executable);
+	closeTagFileFragment (&entry.fragment);
+	getTotals (&files1, &lines1, &bytes1);
+
+	entry.files = files1 - files0;
+	entry.lines = lines1 - lines0;
+	entry.output = (const char *) mio_memory_get_data (output, NULL);
+
+	/* A newline would break the entry header. The tags of a file cut by
+	   --file-time-limit, or by a stopped interactive request, are not
+	   kept. */
+	if (strchr (fileName, '\n') == NULL && ! isInputFileTimedOut ()
+		&& storeCacheEntry (entryName, fileName, size, &entry))
+		storeRemoteCacheEntry (entryName);
+	appendTagFileFragment (entry.output, &entry.fragment);
+
+	mio_free (output);
+	return resize;
+}
+
+/*  Append the tags stored in ENTRYNAME if it was made for FILENAME with
+ *  SIZE bytes of contents.
+ */
+static bool appendCacheEntry (const char *const entryName,
+							  const char *const fileName, size_t size)
+{
+	MIO *stored = mio_new_mapped_file (entryName);
+	size_t length = 0;
+	const char *content;
+	cacheEntry entry;
+	bool hit;
+
+	if (stored == NULL)
+		return false;
+
+	content = (const char *) mio_memory_get_data (stored, &length);
+	hit = parseCacheEntry (content, length, fileName, size, &entry);
+	if (hit)
+	{
+		verbose ("reusing cached tags of %s\n", fileName);
+		appendTagFileFragment (entry.output, &entry.fragment);
+		addTotals ((unsigned int) entry.files, entry.lines,
+				   (entry.files > 0 && Option.printTotals)? size: 0);
+	}
+	mio_free (stored);
+	return hit;
+}
+
+/*  Like appendCacheEntry (), with the entry fetched from the remote tag
+ *  cache if the cache directory does not have it.
+ */
+static bool reuseCacheEntry (const char *const entryName,
+							 const char *const fileName, size_t size)
+{
+	return (appendCacheEntry (entryName, fileName, size)
+			|| (fetchRemoteCacheEntry (entryName)
+				&& appendCacheEntry (entryName, fileName, size)));
+}
+
+extern bool parseFileWithTagCache (const char *const fileName)
+{
+	MIO *input;
+	const unsigned char *data;
+	size_t size = 0;
+	fileStatus *status;
+	bool executable;
+	char *entryName;
+	bool resize = false;
+
+	if (! prepareCacheDirectory ())
+		return parseFileWithMio (fileName, NULL);
+
+	input = getMio (fileName, "rb", false);
+	if (input == NULL)
+		return parseFileWithMio (fileName, NULL);  /* for the diagnostics */
+
+	data = mio_memory_get_data (input, &size);
+	entryName = cacheEntryName (makeCacheKey (fileName, data, size));
+
+	if (! reuseCacheEntry (entryName, fileName, size))
+	{
+		status = eStatInputFile (fileName);
+		executable = status->isExecutable;
+		eStatFree (status);
+		resize = parseFileIntoCache (fileName, input, executable,
+									 entryName, size);
+	}
+
+	eFree (entryName);
+	mio_free (input);
+	return resize;
+}
+
+/*  Like parseFileWithTagCache (), for the SIZE bytes of DATA read from
+ *  INPUT already.
+ */
+static bool parseMioWithTagCache (const char *const fileName, MIO *input,
+								  bool executable,
+								  const unsigned char *data, size_t size)
+{
+	char *entryName = cacheEntryName (makeCacheKey (fileName, data, size));
+	bool resize = false;
+
+	if (! reuseCacheEntry (entryName, fileName, size))
+		resize = parseFileIntoCache (fileName, input, executable,
+									 entryName, size);
+	eFree (entryName);
+	return resize;
+}
+
+extern bool parseBlobWithTagCache (const char *const fileName,
+								   const char *const blobId, size_t size,
+								   bool executable,
+								   MIO *(* readBlob) (void *data), void *data)
+{
+	MIO *input;
+	char *entryName = NULL;
+	bool resize = false;
+
+	if (canUseTagCache () && prepareCacheDirectory ())
+	{
+		entryName = cacheEntryName (makeBlobCacheKey (fileName, blobId));
+		if (reuseCacheEntry (entryName, fileName, size))
+		{
+			eFree (entryName);
+			return false;
+		}
+	}
+
+	input = readBlob (data);
+	if (input)
+	{
+		if (entryName)
+			resize = parseFileIntoCache (fileName, input, executable,
+										 entryName, size);
+		else
+			resize = parseFileWithMioAsExecutable (fileName, input, executable);
+		mio_free (input);
+	}
+
+	if (entryName)
+		eFree (entryName);
+	return resize;
+}
+
+/*
+ *  Duplicate inputs
+ */
+
+extern bool canDeduplicateInputs (void)
+{
+	if (! Option.deduplicateInputs || Option.outputs
+		|| Option.partition != PARTITION_NONE
+		|| Option.filter || Option.interactive || Option.printLanguage)
+		return false;
+
+	/* The input field is rewritten in the tag lines; a #line directive
+	   would have put another one there. */
+	if (Option.lineDirectives)
+		return false;
+	return (getTagWriterType () == WRITER_U_CTAGS
+			|| getTagWriterType () == WRITER_E_CTAGS);
+}
+
+/*  The tags of a file depend on its name only through the input field,
+ *  and the base name, which chooses the parser and names the file tag.
+ *  The options are in the key, since they can change between the files
+ *  of the command line.
+ */
+static char *makeDuplicateKey (const char *const fileName, bool executable,
+							   const unsigned char *data, size_t size)
+{
+	uint64_t hash = HASH_OFFSET_BASIS;
+	char hex [17];
+
+	hash = hashString (hash, getOptionHistory ());
+	hash = hashString (hash, baseFilename (fileName));
+	hash = hashString (hash, executable? "x": "");
+	formatKey (hex, hashBytes (hash, data, size));
+	return eStrdup (hex);
+}
+
+static void deleteDuplicateEntry (void *data)
+{
+	duplicateEntry *entry = data;
+
+	eFree (entry->output);
+	eFree (entry);
+}
+
+static void rememberDuplicate (char *key, const char *const fileName,
+							   size_t size, const char *output,
+							   const tagFileFragment *fragment,
+							   long files, long lines)
+{
+	duplicateEntry *entry;
+	vString *input;
+
+	if (DuplicatesSize + fragment->size > DEDUP_MEMORY_BUDGET)
+	{
+		eFree (key);
+		return;
+	}
+	/* The copies remembered are only a saving; give them up. */
+	if (isMemoryTight ())
+	{
+		freeDuplicateInputs ();
+		eFree (key);
+		return;
+	}
+
+	input = makeInputField (fileName);
+	entry = xMalloc (1, duplicateEntry);
+	entry->fragment = *fragment;
+	entry->files = files;
+	entry->lines = lines;
+	entry->size = size;
+	entry->inputLength = vStringLength (input);
+	entry->output = xMalloc (fragment->size + 1, char);
+	memcpy (entry->output, output, fragment->size);
+	entry->output [fragment->size] = '\0';
+	vStringDelete (input);
+
+	if (Duplicates == NULL)
+		Duplicates = hashTableNew (1021, hashCstrhash, hashCstreq,
+								   eFree, deleteDuplicateEntry);
+	hashTablePutItem (Duplicates, key, entry);
+	DuplicatesSize += fragment->size;
+}
+
+/*  Append the tags of ENTRY with the input field of FILENAME. The pseudo
+ *  tags a parser writes the first time it runs are left out.
+ */
+static void replayDuplicate (const duplicateEntry *entry,
+							 const char *const fileName)
+{
+	vString *input = makeInputField (fileName);
+	vString *output = vStringNew ();
+	const char *line = entry->output;
+	const char *const end = line + entry->fragment.size;
+	tagFileFragment fragment = entry->fragment;
+	const size_t prefixLength = strlen (PSEUDO_TAG_PREFIX);
+
+	while (line < end)
+	{
+		const char *nl = memchr (line, '\n', end - line);
+		const char *next = nl? nl + 1: end;
+		const char *tab = memchr (line, '\t', next - line);
+
+		if ((size_t) (next - line) > prefixLength
+			&& strncmp (line, PSEUDO_TAG_PREFIX, prefixLength) == 0)
+			fragment.numTags--;
+		else if (tab == NULL
+				 || (size_t) (next - tab) <= entry->inputLength + 1)
+			vStringNCatS (output, line, next - line);
+		else
+		{
+			vStringNCatS (output, line, tab + 1 - line);
+			vStringCat (output, input);
+			vStringNCatS (output, tab + 1 + entry->inputLength,
+						  next - (tab + 1 + entry->inputLength));
+		}
+		line = next;
+	}
+
+	fragment.size = (long) vStringLength (output);
+	if (fragment.maxLine > 0)
+		fragment.maxLine = fragment.maxLine + vStringLength (input)
+			- entry->inputLength;
+	verbose ("reusing the tags of the same contents for %s\n", fileName);
+	appendTagFileFragment (vStringValue (output), &fragment);
+	addTotals ((unsigned int) entry->files, entry->lines,
+			   (entry->files > 0 && Option.printTotals)? entry->size: 0);
+
+	vStringDelete (output);
+	vStringDelete (input);
+}
+
+extern bool parseFileDeduplicated (const char *const fileName)
+{
+	MIO *input, *output;
+	const unsigned char *data;
+	size_t size = 0;
+	fileStatus *status;
+	bool executable;
+	char *key;
+	duplicateEntry *entry;
+	long files0, lines0, bytes0, files1, lines1, bytes1;
+	tagFileFragment fragment;
+	bool resize;
+
+	input = getMio (fileName, "rb", false);
+	if (input == NULL)
+		return parseFileWithMio (fileName, NULL);  /* for the diagnostics */
+
+	status = eStatInputFile (fileName);
+	executable = status->isExecutable;
+	eStatFree (status);
+
+	data = mio_memory_get_data (input, &size);
+	key = makeDuplicateKey (fileName, executable, data, size);
+	entry = Duplicates? hashTableGetItem (Duplicates, key): NULL;
+	if (entry && entry->size == size)
+	{
+		replayDuplicate (entry, fileName);
+		eFree (key);
+		mio_free (input);
+		return false;
+	}
+
+	output = mio_new_memory (NULL, 0, eRealloc, eFree);
+	getTotals (&files0, &lines0, &bytes0);
+	openTagFileFragment (output);
+	if (canUseTagCache () && prepareCacheDirectory ())
+		resize = parseMioWithTagCache (fileName, input, executable, data, size);
+	else
+		resize = parseFileWithMioAsExecutable (fileName, input, executable);
+	closeTagFileFragment (&fragment);
+	getTotals (&files1, &lines1, &bytes1);
+
+	/* Like the tag cache, the tags of a cut file are not kept. */
+	if (entry == NULL && ! isInputFileTimedOut ())
+		rememberDuplicate (key, fileName, size,
+						   (const char *) mio_memory_get_data (output, NULL),
+						   &fragment, files1 - files0, lines1 - lines0);
+	else
+		eFree (key);
+	appendTagFileFragment ((const char *) mio_memory_get_data (output, NULL),
+						   &fragment);
+
+	mio_free (output);
+	mio_free (input);
+	return resize;
+}
+
+extern void freeDuplicateInputs (void)
+{
+	if (Duplicates)
+	{
+		hashTableDelete (Duplicates);
+		Duplicates = NULL;
+	}
+	DuplicatesSize = 0;
+}
+
+/*
+ *  Manifest
+ */
+
+static char *manifestName (const char *const tagFile)
+{
+	vString *name = vStringNewInit (tagFile);
+
+	vStringCatS (name, ".manifest");
+	return vStringDeleteUnwrap (name);
+}
+
+static unsigned long tagFileSize (const char *const tagFile)
+{
+	struct stat status;
+
+	return (stat (tagFile, &status) == 0)? (unsigned long) status.st_size: 0;
+}
+
+/*  The header of a manifest: the configuration, the size of the tag file
+ *  written with it, and when the run started. A file modified in the
+ *  second it was tagged may have been modified after being read, so it
+ *  is not trusted to be unchanged.
+ */
+static void writeManifestHeader (MIO *mio, unsigned long size, unsigned long start)
+{
+	char key [17];
+
+	formatKey (key, hashConfiguration ());
+	mio_printf (mio, MANIFEST_MAGIC "\t%u\t%s\t%lu\t%lu\n",
+				MANIFEST_FORMAT, key, size, start);
+}
+
+static bool readManifest (MIO *mio, const char *const tagFile)
+{
+	vString *vLine = vStringNew ();
+	char key [17];
+	unsigned int format;
+	char storedKey [17];
+	unsigned long size;
+	bool valid;
+
+	formatKey (key, hashConfiguration ());
+	valid = (readLineRaw (vLine, mio) != NULL
+			 && sscanf (vStringValue (vLine), MANIFEST_MAGIC "\t%u\t%16s\t%lu\t%lu",
+						&format, storedKey, &size, &OldManifestStart) == 4
+			 && format == MANIFEST_FORMAT
+			 && strcmp (storedKey, key) == 0
+			 && size == tagFileSize (tagFile));
+
+	while (valid && readLineRaw (vLine, mio) != NULL)
+	{
+		manifestEntry *entry = xMalloc (1, manifestEntry);
+		char *p = vStringValue (vLine);
+
+		entry->mtime = strtoul (p, &p, 10);
+		entry->size = strtoul (p, &p, 10);
+		entry->inode = strtoul (p, &p, 10);
+		entry->seen = false;
+		vStringStripNewline (vLine);
+		if (*p != '\t' || p [1] == '\0'
+			|| hashTableHasItem (OldManifest, p + 1))
+		{
+			eFree (entry);
+			continue;
+		}
+		hashTablePutItem (OldManifest, eStrdup (p + 1), entry);
+	}
+	vStringDelete (vLine);
+	return valid;
+}
+
+extern bool openManifest (const char *const tagFile, bool tagFileExists)
+{
+	char *name = manifestName (tagFile);
+	bool valid = false;
+	MIO *mio;
+
+	NewManifest = mio_new_memory (NULL, 0, eRealloc, eFree);
+	OldManifest = hashTableNew (1021, hashCstrhash, hashCstreq, eFree, eFree);
+
+	if (tagFileExists && (mio = mio_new_file (name, "rb")) != NULL)
+	{
+		valid = readManifest (mio, tagFile);
+		mio_free (mio);
+		if (! valid)
+		{
+			verbose ("ignoring %s: made for another tag file or other options\n", name);
+			hashTableClear (OldManifest);
+		}
+	}
+	eFree (name);
+
+	NewManifestStart = (unsigned long) time (NULL);
+	return valid;
+}
+
+extern bool recordFileInManifest (const char *const fileName,
+								  const fileStatus *const status)
+{
+	manifestEntry *entry;
+	bool unchanged = false;
+
+	if (NewManifest == NULL || strchr (fileName, '\n') != NULL)
+		return false;
+
+	entry = hashTableGetItem (OldManifest, fileName);
+	if (entry)
+	{
+		unchanged = (! entry->seen
+					 && entry->mtime < OldManifestStart
+					 && entry->mtime == status->mtime
+					 && entry->size == status->size
+					 && entry->inode == status->inode);
+		entry->seen = true;
+	}
+	mio_printf (NewManifest, "%lu\t%lu\t%lu\t%s\n",
+				status->mtime, status->size, status->inode, fileName);
+	return unchanged;
+}
+
+static void forgetVanishedFile (void *key, void *value, void *user_data CTAGS_ATTR_UNUSED)
+{
+	manifestEntry *entry = value;
+
+	if (! entry->seen)
+	{
+		verbose ("removing tags of \"%s\" (not found)\n", (const char *) key);
+		forgetTagsOfFile (key);
+	}
+}
+
+extern void forgetTagsOfVanishedFiles (void)
+{
+	if (OldManifest)
+		hashTableForeachItem (OldManifest, forgetVanishedFile, NULL);
+}
+
+extern void closeManifest (const char *const tagFile)
+{
+	char *name;
+	vString *tmpName;
+	MIO *mio;
+	size_t size = 0;
+	const unsigned char *data;
+	bool failed;
+
+	if (NewManifest == NULL)
+		return;
+
+	name = manifestName (tagFile);
+	tmpName = makeTemporaryName (name);
+	data = mio_memory_get_data (NewManifest, &size);
+
+	mio = mio_new_file (vStringValue (tmpName), "wb");
+	if (mio == NULL)
+		failed = true;
+	else
+	{
+		writeManifestHeader (mio, tagFileSize (tagFile), NewManifestStart);
+		if (size > 0)
+			mio_write (mio, data, 1, size);
+		failed = mio_error (mio);
+		if (mio_free (mio) != 0)
+			failed = true;
+	}
+	if (failed || rename (vStringValue (tmpName), name) != 0)
+	{
+		error (WARNING | PERROR, "cannot write manifest \"%s\"", name);
+		remove (vStringValue (tmpName));
+	}
+
+	vStringDelete (tmpName);
+	eFree (name);
+	mio_free (NewManifest);
+	NewManifest = NULL;
+	hashTableDelete (OldManifest);
+	OldManifest = NULL;
+}
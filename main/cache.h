@@ -0,0 +1,62 @@
+/*
+*   Copyright (c) 2026, Universal Ctags Team
+*
+*   This source code is released for free distribution under the terms of the
+*   GNU General Public License version 2 or (at your option) any later version.
+*
+*   External interface to cache.c
+*/
+#ifndef CTAGS_MAIN_CACHE_H
+#define CTAGS_MAIN_CACHE_H
+
+/*
+*   INCLUDE FILES
+*/
+#include "general.h"  /* must always come first */
+
+#include "mio.h"
+#include "routines.h"
+
+/*
+*   FUNCTION PROTOTYPES
+*/
+extern bool canUseTagCache (void);
+
+/* Like parseFile (), but reuse the tags stored in the cache directory
+   when FILENAME, its contents and the options have not changed. */
+extern bool parseFileWithTagCache (const char *const fileName);
+
+/* Like parseFileWithTagCache (), for the SIZE bytes of the blob BLOBID
+   (the id of its contents in a version control system), which are read
+   with READBLOB (DATA) only when the tags are not in the cache. The tag
+   cache is used only if canUseTagCache (). EXECUTABLE is as for
+   parseFileWithMioAsExecutable (). */
+extern bool parseBlobWithTagCache (const char *const fileName,
+								   const char *const blobId, size_t size,
+								   bool executable,
+								   MIO *(* readBlob) (void *data), void *data);
+
+/* Wait for the helper of --cache-remote, if this process started one,
+   to be done with the entries given to it. */
+extern void closeRemoteTagCache (void);
+
+extern bool canDeduplicateInputs (void);
+
+/* Like parseFile (), but write again the tags of the last file with the
+   same contents and base name parsed in this run, with the input field
+   of FILENAME. */
+extern bool parseFileDeduplicated (const char *const fileName);
+extern void freeDuplicateInputs (void);
+
+/* Start a manifest for TAGFILE. Return whether the manifest of the last
+   run is valid, so that the tag file can be updated. */
+extern bool openManifest (const char *const tagFile, bool tagFileExists);
+/* Record FILENAME, and return whether it is unchanged since the last run. */
+extern bool recordFileInManifest (const char *const fileName,
+								  const fileStatus *const status);
+/* forgetTagsOfFile () for the files of the last run not recorded. */
+extern void forgetTagsOfVanishedFiles (void);
+/* Write the manifest for TAGFILE, which has been closed. */
+extern void closeManifest (const char *const tagFile);
+
+#endif  /* CTAGS_MAIN_CACHE_H */
@@ -0,0 +1,439 @@
+/*
+*   Copyright (c) 2026, Universal Ctags Team
+*
+*   This source code is released for free distribution under the terms of the
+*   GNU General Public License version 2 or (at your option) any later version.
+*
+*   This module contains functions for reading compressed input files
+*   (gzip with zlib, zstd with libzstd). A compressed file is recognized
+*   by its magic number, and decoded in chunks into a growing buffer
+*   which becomes the memory stream the parsers read; no uncompressed
+*   copy is written anywhere. The parser is chosen by the name of the
+*   file without the compression suffix.
+*
+*   It also contains the function writing a compressed tag file
+*   (--compress=gzip), which readtags searches by decompressing only the
+*   frames it looks into. The tag file is cut into frames of whole lines,
+*   each a gzip member compressed alone, so that "gzip -d" still restores
+*   it. A frame index and a footer follow, as members without contents:
+*
+*     frame index  members with the FEXTRA subfield "CI", holding for each
+*                  frame in order its compressed and uncompressed sizes as
+*                  32 bit little endian numbers, up to 8191 frames a member
+*     footer       the last 42 bytes: a member with the subfield "CT" of
+*                  16 bytes, the offset of the first member of the index
+*                  (64 bits), the number of frames (32 bits), and the
+*                  version of the format (32 bits), all little endian
+*/
+
+/*
+*   INCLUDE FILES
+*/
+#include "general.h"  /* must always come first */
+
+#include <stdio.h>
+#include <string.h>
+
+#ifdef HAVE_ZLIB
+# include <zlib.h>
+#endif
+#ifdef HAVE_ZSTD
+# include <zstd.h>
+#endif
+
+#include "compressed.h"
+#include "debug.h"
+#include "options.h"
+#include "routines.h"
+#include "vstring.h"
+
+/*
+*   MACROS
+*/
+
+/* The first guess of the size of the decompressed contents, when the
+   input tells nothing trustworthy, is this many times the compressed
+   size. */
+#define COMPRESSION_RATIO_GUESS 4
+
+/* Don't trust a size written in the input beyond this ratio. */
+#define COMPRESSION_RATIO_MAX 1032
+
+#define CHUNK_SIZE (64 * 1024)
+
+#define FRAME_INDEX_SUBFIELD "CI"
+#define FRAME_FOOTER_SUBFIELD "CT"
+#define FRAME_FORMAT_VERSION 1
+#define FRAME_FOOTER_SIZE 42
+#define FRAME_INDEX_ENTRY_SIZE 8
+#define FRAME_INDEX_MAX_ENTRIES ((0xffff - 4) / FRAME_INDEX_ENTRY_SIZE)
+
+/*
+*   DATA DECLARATIONS
+*/
+typedef struct sCompressionFormat {
+	const char *name;
+	const char *suffix;
+	const unsigned char *magic;
+	size_t magicLength;
+	/* Decode the LENGTH bytes of DATA into *OUTPUT, whose size is
+	   *OUTPUTSIZE, growing it if needed, and return the decoded length,
+	   or -1 on error. */
+	long (* decode) (const unsigned char *data, size_t length,
+					 unsigned char **output, size_t *outputSize);
+} compressionFormat;
+
+/*
+*   FUNCTION DEFINITIONS
+*/
+
+#if defined (HAVE_ZLIB) || defined (HAVE_ZSTD)
+static size_t initialOutputSize (size_t length, unsigned long long claimed)
+{
+	if (claimed > 0 && claimed / COMPRESSION_RATIO_MAX <= length)
+		return (size_t) claimed + 1;
+	return length * COMPRESSION_RATIO_GUESS + CHUNK_SIZE;
+}
+
+/*  Make room for another chunk after the first USED bytes of *OUTPUT.
+ */
+static void reserveChunk (unsigned char **output, size_t *outputSize, size_t used)
+{
+	if (*outputSize - used < CHUNK_SIZE)
+	{
+		*outputSize = (*outputSize < CHUNK_SIZE? CHUNK_SIZE: *outputSize) * 2;
+		*output = eRealloc (*output, *outputSize);
+	}
+}
+
+#endif
+
+#ifdef HAVE_ZLIB
+static long decodeGzip (const unsigned char *data, size_t length,
+						unsigned char **output, size_t *outputSize)
+{
+	z_stream z;
+	int r = Z_OK;
+	size_t used = 0;
+	/* ISIZE, the trailer of the last member, is the size modulo 2^32. */
+	const unsigned long long claimed = (length >= 18)
+		? ((unsigned long long) data [length - 4]
+		   | (unsigned long long) data [length - 3] << 8
+		   | (unsigned long long) data [length - 2] << 16
+		   | (unsigned long long) data [length - 1] << 24)
+		: 0;
+
+	memset (&z, 0, sizeof (z));
+	if (inflateInit2 (&z, 15 + 16) != Z_OK)  /* gzip header only */
+		return -1;
+
+	*outputSize = initialOutputSize (length, claimed);
+	*output = eMalloc (*outputSize);
+
+	z.next_in = (Bytef *) data;
+	while (length > 0)
+	{
+		/* avail_in is an unsigned int. */
+		const size_t in = length < (1U << 30)? length: (1U << 30);
+
+		z.avail_in = (uInt) in;
+		do
+		{
+			reserveChunk (output, outputSize, used);
+			z.next_out = *output + used;
+			z.avail_out = (uInt) ((*outputSize - used) < (1U << 30)
+								  ? (*outputSize - used): (1U << 30));
+			r = inflate (&z, Z_NO_FLUSH);
+			used = (size_t) (z.next_out - *output);
+
+			/* The members of a file made by "cat a.gz b.gz" */
+			if (r == Z_STREAM_END && (z.avail_in > 0 || length > in))
+				r = inflateReset (&z);
+		}
+		while (r == Z_OK && (z.avail_in > 0 || z.avail_out == 0));
+
+		if (r != Z_OK && r != Z_STREAM_END)
+			break;
+		length -= in;
+	}
+	inflateEnd (&z);
+
+	return (r == Z_STREAM_END)? (long) used: -1;
+}
+
+static const unsigned char gzipMagic [] = { 0x1f, 0x8b };
+#endif
+
+#ifdef HAVE_ZSTD
+static long decodeZstd (const unsigned char *data, size_t length,
+						unsigned char **output, size_t *outputSize)
+{
+	ZSTD_DStream *z = ZSTD_createDStream ();
+	ZSTD_inBuffer in = { data, length, 0 };
+	size_t r;
+	size_t used = 0;
+	unsigned long long claimed = ZSTD_getFrameContentSize (data, length);
+
+	if (z == NULL)
+		return -1;
+	if (claimed == ZSTD_CONTENTSIZE_UNKNOWN || claimed == ZSTD_CONTENTSIZE_ERROR)
+		claimed = 0;
+
+	*outputSize = initialOutputSize (length, claimed);
+	*output = eMalloc (*outputSize);
+
+	/* R is 0 at the end of each frame, and tells that the decoder holds
+	   more of the frame otherwise. */
+	for (;;)
+	{
+		ZSTD_outBuffer out;
+
+		reserveChunk (output, outputSize, used);
+		out.dst = *output + used;
+		out.size = *outputSize - used;
+		out.pos = 0;
+		r = ZSTD_decompressStream (z, &out, &in);
+		if (ZSTD_isError (r))
+			break;
+		used += out.pos;
+		if (in.pos == in.size && (r == 0 || out.pos == 0))
+			break;
+	}
+	ZSTD_freeDStream (z);
+
+	return (r == 0)? (long) used: -1;
+}
+
+static const unsigned char zstdMagic [] = { 0x28, 0xb5, 0x2f, 0xfd };
+#endif
+
+static const compressionFormat CompressionFormats [] = {
+#ifdef HAVE_ZLIB
+	{ "gzip", ".gz",  gzipMagic, sizeof (gzipMagic), decodeGzip },
+#endif
+#ifdef HAVE_ZSTD
+	{ "zstd", ".zst", zstdMagic, sizeof (zstdMagic), decodeZstd },
+#endif
+	{ NULL, },
+};
+
+extern MIO *decompressInput (MIO *mio, const char *const fileName)
+{
+	const compressionFormat *format;
+	const unsigned char *data;
+	size_t length = 0;
+
+	if (mio == NULL)
+		return NULL;
+	data = mio_memory_get_data (mio, &length);
+	if (data == NULL)
+		return mio;
+
+	for (format = CompressionFormats; format->name; format++)
+	{
+		unsigned char *output = NULL;
+		size_t outputSize = 0;
+		long decoded;
+		MIO *decompressed;
+
+		if (length < format->magicLength
+			|| memcmp (data, format->magic, format->magicLength) != 0)
+			continue;
+
+		verbose ("decompressing %s (%s)\n", fileName, format->name);
+		decoded = format->decode (data, length, &output, &outputSize);
+		mio_free (mio);
+		/* A broken file is tagged as an empty one, after the warning. */
+		if (decoded < 0)
+		{
+			error (WARNING, "cannot decompress \"%s\" (%s)", fileName, format->name);
+			decoded = 0;
+		}
+		else if (outputSize - (size_t) decoded > CHUNK_SIZE)
+			output = eRealloc (output, (size_t) decoded + 1);
+		decompressed = mio_new_memory (output, (size_t) decoded, eRealloc, eFree);
+		if (decompressed == NULL && output)
+			eFree (output);
+		return decompressed;
+	}
+	return mio;
+}
+
+extern char *baseFilenameSansCompressionSuffixNew (const char *const fileName)
+{
+	const compressionFormat *format;
+
+	for (format = CompressionFormats; format->name; format++)
+	{
+		char *base = baseFilenameSansExtensionNew (fileName, format->suffix);
+
+		if (base)
+			return base;
+	}
+	return NULL;
+}
+
+#ifdef HAVE_ZLIB
+static void putNumber (unsigned char *bytes, unsigned long long n, unsigned int size)
+{
+	unsigned int i;
+
+	for (i = 0; i < size; i++, n >>= 8)
+		bytes [i] = (unsigned char) (n & 0xff);
+}
+
+/*  A gzip member without contents, whose header has the FEXTRA subfield
+ *  ID with the LENGTH bytes of DATA.
+ */
+static bool writeEmptyMember (FILE *fp, const char id [2],
+							  const unsigned char *data, size_t length)
+{
+	unsigned char header [16] = {
+		0x1f, 0x8b, 8 /* deflate */, 4 /* FEXTRA */, 0, 0, 0, 0 /* mtime */,
+		0 /* xfl */, 255 /* OS unknown */,
+	};
+	/* A final fixed Huffman block with no symbols, the CRC and the size */
+	static const unsigned char trailer [10] = { 0x03, 0x00, };
+
+	putNumber (header + 10, length + 4, 2);
+	header [12] = (unsigned char) id [0];
+	header [13] = (unsigned char) id [1];
+	putNumber (header + 14, length, 2);
+
+	return (fwrite (header, 1, sizeof (header), fp) == sizeof (header)
+			&& fwrite (data, 1, length, fp) == length
+			&& fwrite (trailer, 1, sizeof (trailer), fp) == sizeof (trailer));
+}
+
+/*  Compress the LENGTH bytes of DATA as a gzip member into *OUTPUT,
+ *  whose size is *OUTPUTSIZE, and return the size of the member.
+ */
+static size_t compressFrame (z_stream *z, const unsigned char *data, size_t length,
+							 unsigned char **output, size_t *outputSize)
+{
+	const size_t bound = deflateBound (z, (uLong) length);
+
+	if (*outputSize < bound)
+	{
+		*outputSize = bound;
+		*output = eRealloc (*output, *outputSize);
+	}
+	deflateReset (z);
+	z->next_in = (Bytef *) data;
+	z->avail_in = (uInt) length;
+	z->next_out = *output;
+	z->avail_out = (uInt) *outputSize;
+	if (deflate (z, Z_FINISH) != Z_STREAM_END)
+		error (FATAL, "cannot compress the tag file");
+	return *outputSize - z->avail_out;
+}
+
+/*  Cut DATA, the tag file, into frames of whole lines of FRAMESIZE bytes
+ *  or more, and write them into FP, followed by the index and the footer.
+ */
+static bool writeFrames (FILE *fp, const unsigned char *data, size_t size,
+						 size_t frameSize)
+{
+	z_stream z;
+	unsigned char *output = NULL;
+	size_t outputSize = 0;
+	vString *index = vStringNew ();
+	unsigned long frames = 0;
+	unsigned long long offset = 0;
+	unsigned char footer [16];
+	size_t pos = 0, i;
+	bool ok = true;
+
+	memset (&z, 0, sizeof (z));
+	if (deflateInit2 (&z, Z_DEFAULT_COMPRESSION, Z_DEFLATED,
+					  15 + 16 /* gzip */, 8, Z_DEFAULT_STRATEGY) != Z_OK)
+		error (FATAL, "cannot compress the tag file");
+
+	while (ok && pos < size)
+	{
+		size_t end = (size - pos > frameSize)? pos + frameSize: size;
+		const unsigned char *newline;
+		unsigned char entry [FRAME_INDEX_ENTRY_SIZE];
+		size_t length;
+
+		newline = memchr (data + end - 1, '\n', size - (end - 1));
+		end = newline? (size_t) (newline - data) + 1: size;
+		if (end - pos > 0xffffffffUL)
+			error (FATAL, "a line of the tag file is too long to be compressed");
+
+		length = compressFrame (&z, data + pos, end - pos, &output, &outputSize);
+		ok = (fwrite (output, 1, length, fp) == length);
+
+		putNumber (entry, length, 4);
+		putNumber (entry + 4, end - pos, 4);
+		vStringNCatSUnsafe (index, (const char *) entry, sizeof (entry));
+		offset += length;
+		frames++;
+		pos = end;
+	}
+	deflateEnd (&z);
+	if (output)
+		eFree (output);
+
+	for (i = 0; ok && i < vStringLength (index);
+		 i += FRAME_INDEX_MAX_ENTRIES * FRAME_INDEX_ENTRY_SIZE)
+	{
+		size_t length = vStringLength (index) - i;
+
+		if (length > FRAME_INDEX_MAX_ENTRIES * FRAME_INDEX_ENTRY_SIZE)
+			length = FRAME_INDEX_MAX_ENTRIES * FRAME_INDEX_ENTRY_SIZE;
+		ok = writeEmptyMember (fp, FRAME_INDEX_SUBFIELD,
+							   (const unsigned char *) vStringValue (index) + i,
+							   length);
+	}
+	vStringDelete (index);
+
+	putNumber (footer, offset, 8);
+	putNumber (footer + 8, frames, 4);
+	putNumber (footer + 12, FRAME_FORMAT_VERSION, 4);
+	return ok && writeEmptyMember (fp, FRAME_FOOTER_SUBFIELD, footer, sizeof (footer));
+}
+
+extern char *compressTagFile (const char *const tagFile, size_t frameSize)
+{
+	MIO *input = mio_new_mapped_file (tagFile);
+	const unsigned char *data;
+	size_t size = 0;
+	vString *tmpName;
+	FILE *fp;
+	bool ok;
+
+	if (input == NULL)
+		error (FATAL | PERROR, "cannot read tag file \"%s\"", tagFile);
+	data = mio_memory_get_data (input, &size);
+
+	tmpName = vStringNewInit (tagFile);
+	vStringCatS (tmpName, ".compressing");
+	fp = fopen (vStringValue (tmpName), "wb");
+	if (fp == NULL)
+		error (FATAL | PERROR, "cannot open \"%s\"", vStringValue (tmpName));
+
+	verbose ("compressing %s in frames of %lu bytes\n", tagFile,
+			 (unsigned long) frameSize);
+	ok = writeFrames (fp, data, size, frameSize);
+	if (fclose (fp) != 0)
+		ok = false;
+	mio_free (input);
+	if (! ok)
+	{
+		remove (vStringValue (tmpName));
+		error (FATAL | PERROR, "cannot write \"%s\"", vStringValue (tmpName));
+	}
+	return vStringDeleteUnwrap (tmpName);
+}
+
+#else
+
+extern char *compressTagFile (const char *const tagFile CTAGS_ATTR_UNUSED,
+							  size_t frameSize CTAGS_ATTR_UNUSED)
+{
+	error (FATAL, "compressed tag files are not supported: ctags is built without zlib");
+	return NULL;
+}
+
+#endif
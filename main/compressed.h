@@ -0,0 +1,38 @@
+/*
+*   Copyright (c) 2026, Universal Ctags Team
+*
+*   This source code is released for free distribution under the terms of the
+*   GNU General Public License version 2 or (at your option) any later version.
+*
+*   External interface to compressed.c
+*/
+#ifndef CTAGS_MAIN_COMPRESSED_H
+#define CTAGS_MAIN_COMPRESSED_H
+
+/*
+*   INCLUDE FILES
+*/
+#include "general.h"  /* must always come first */
+
+#include "mio.h"
+
+/*
+*   FUNCTION PROTOTYPES
+*/
+
+/* If MIO, read from FILENAME, is compressed in a format ctags can read,
+   free it and return a memory stream of the decompressed contents, which
+   is empty if it cannot be decompressed. Otherwise return MIO. */
+extern MIO *decompressInput (MIO *mio, const char *const fileName);
+
+/* The base name of FILENAME without the suffix of a compression format
+   ctags can read (e.g. "a.c" for "dir/a.c.gz"), or NULL if it has none.
+   The caller frees it. */
+extern char *baseFilenameSansCompressionSuffixNew (const char *const fileName);
+
+/* Write TAGFILE compressed in frames of FRAMESIZE bytes or more (see
+   compressed.c) into a new file, and return the name of the new file,
+   which the caller renames to TAGFILE and frees. */
+extern char *compressTagFile (const char *const tagFile, size_t frameSize);
+
+#endif	/* CTAGS_MAIN_COMPRESSED_H */
@@ -116,12 +116,17 @@ extern void debugEntry (const tagEntryInfo *const tag)
 
 extern void debugAssert (const char *assertion, const char *file, unsigned int line, const char *function)
 {
+	/* Describing the input may fail an assertion in turn, e.g. with an
+	 * empty language stack; don't come back here for that one. */
+	static bool describingInput;
+
 	fprintf(stderr, "ctags: %s:%u: %s%sAssertion `%s' failed.\n",
 	        file, line,
 	        function ? function : "", function ? ": " : "",
 	        assertion);
-	if (getInputFileName())
+	if (!describingInput && getInputFileName())
 	{
+		describingInput = true;
 		fprintf(stderr, "ctags: %s:%u: parsing %s:%lu as %s\n",
 		        file, line,
 		        getInputFileName(), getInputLineNumber(),
@@ -229,14 +229,16 @@ extern subparser* teardownSubparsersInUse (struct slaveControlBlock *controlBloc
 		s = tmp;
 	}
 
-	if (s)
-		return s;
-
+	/* A subparser is chosen for the current input only: clear the marks
+	 * even when S is already known, so that the next input starts afresh. */
+	const bool explicitlyScheduled = (s != NULL);
 	while (tmp)
 	{
 		if (tmp->chosenAsExclusiveSubparser)
 		{
-			s = tmp;
+			tmp->chosenAsExclusiveSubparser = false;
+			if (!explicitlyScheduled)
+				s = tmp;
 		}
 		tmp = tmp->next;
 	}
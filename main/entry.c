@@ -15,6 +15,7 @@
 #include <string.h>
 #include <ctype.h>        /* to define isspace () */
 #include <errno.h>
+#include <limits.h>
 
 #if defined (HAVE_SYS_TYPES_H)
 # include <sys/types.h>	  /* to declare off_t on some hosts */
@@ -38,12 +39,16 @@
 
 #include <stdint.h>
 
+#include "cache.h"
+#include "compressed.h"
 #include "debug.h"
 #include "entry.h"
 #include "field.h"
 #include "fmt.h"
+#include "htable.h"
 #include "kind.h"
 #include "main.h"
+#include "nameindex.h"
 #include "options.h"
 #include "ptag.h"
 #include "read.h"
@@ -51,6 +56,7 @@
 #include "ptrarray.h"
 #include "sort.h"
 #include "strlist.h"
+#include "traceevent.h"
 #include "trashbox.h"
 #include "writer.h"
 #include "xtag.h"
@@ -76,6 +82,42 @@
 #endif
 
 
+/*  A tag file of --output=FORMAT:FILE, written from the tags of the one
+ *  given with -o. The lines of an input file are written to MIO, and
+ *  moved to SORTER, or to FILE if not sorting, when the file is parsed.
+ */
+typedef struct sTagOutput {
+	writerType type;
+	char *name;
+	MIO *mio;
+	MIO *file;
+#ifdef EXTERNAL_SORT
+	tagSorter *sorter;
+#endif
+	bool *fields;		/* see swapFieldEnabledTable () */
+	unsigned int fieldCount;
+	unsigned long numTags;
+	long mark;			/* set by tagFilePosition () */
+} tagOutput;
+
+/*  A tag file of --partition, having the tags of some of the input
+ *  files: their lines are moved to SORTER instead of that of the tag
+ *  file, and their input fields are made relative to DIRECTORY.
+ */
+typedef struct sTagPartition {
+	char *name;
+	char *directory;
+#ifdef EXTERNAL_SORT
+	tagSorter *sorter;
+#endif
+} tagPartition;
+
+/*  What enterTagOutput () replaces. */
+typedef struct sTagOutputSaved {
+	writerType wtype;
+	bool *fields;
+} tagOutputSaved;
+
 /*  Maintains the state of the tag file.
  */
 typedef struct eTagFile {
@@ -85,17 +127,107 @@ typedef struct eTagFile {
 	struct sNumTags { unsigned long added, prev; } numTags;
 	struct sMax { size_t line, tag; } max;
 	vString *vLine;
+	vString *subword;	/* the subwords of a tag name (--extras=+{subword}) */
 
 	unsigned int cork;
+	struct sCorkArenaChunk *arena;	/* the strings of the cork queue */
+	struct sCorkArenaChunk *arenaLast;
+	hashTable *scopeNames;		/* interned scope names of the cork queue */
+	unsigned int scopeNameCount;
 	struct sCorkQueue {
 		struct sTagEntryInfo* queue;
+		const char **qualifiedNames;	/* memoised, indexed like queue */
 		unsigned int length;
-		unsigned int count;
+		unsigned int count;		/* index of the next entry */
+		unsigned int flushed;	/* entries written by flushCorkQueue ();
+								   entry N is at queue [N - flushed] */
 	} corkQueue;
 
 	bool patternCacheValid;
+
+#ifdef EXTERNAL_SORT
+	/* When sorting, tag lines are written into MIO (a memory stream),
+	   and moved to SORTER after each input file. */
+	tagSorter *sorter;
+
+	/* --update: the tag file being updated, and whether it is sorted
+	   the way the tags are sorted now. */
+	MIO *base;
+	bool baseSorted;
+
+	/* --merge-shards: the number of tag files given to the sorter */
+	unsigned int shards;
+#endif
+	/* --update: the input fields of the files whose tags are replaced,
+	   and the prefixes of those of the files under the directories
+	   whose tags all are */
+	hashTable *staleFiles;
+	stringList *staleDirectories;
+
+	/* --deduplicate-tags: the fingerprints of the tag lines written,
+	   in chunks which are not moved, as the keys of TABLE. The lines
+	   after MARK, set by tagFilePosition (), are forgotten when a parser
+	   rescans the input. */
+	struct sSeenLines {
+		hashTable *table;
+		uint64_t **chunks;
+		size_t chunkCount;
+		size_t count;
+		size_t mark;
+		unsigned long dropped;
+		MIO *line;		/* the line being written */
+	} seenLines;
+
+	/* The temporary file holding the entries when the writer makes the
+	   tag file from them at the end (see rewriteOutput of tagWriter) */
+	char *entriesName;
+
+	/* --atomic-output: the tag file NAME, written next to it, replaces */
+	char *publishedName;
+
+	/* --output: the other tag files */
+	tagOutput *outputs;
+	unsigned int outputCount;
+
+	/* --partition: the partitions by their keys, the tag file itself
+	   as TOP, and the one the tags are written to */
+	hashTable *partitions;
+	tagPartition top;
+	tagPartition *partition;
+
+	/* The outputs replaced by nested openTagFileFragment () calls */
+	struct sTagFileOutput {
+		MIO *mio;
+		struct sNumTags numTags;
+		struct sMax max;
+#ifdef EXTERNAL_SORT
+		tagSorter *sorter;
+#endif
+	} savedOutputs [3];
+	unsigned int fragmentDepth;
 } tagFile;
 
+/*  The strings of the entries in the cork queue are allocated in chunks,
+ *  released all at once by uncorkTagFile (), or by flushCorkQueue ()
+ *  when all the entries having strings in a chunk are flushed.
+ */
+typedef struct sCorkArenaChunk {
+	struct sCorkArenaChunk *next;
+	size_t used;
+	size_t size;
+	unsigned int lastIndex;		/* of the entries having strings here */
+} corkArenaChunk;
+
+#define CORK_ARENA_CHUNK_SIZE (64 * 1024)
+
+/*  The scope names are interned, so that the entries in a scope share
+ *  one string. flushCorkQueue () starts a new table when this many names
+ *  are interned.
+ */
+#define SCOPE_NAME_TABLE_SIZE 8191
+
+#define SEEN_LINES_CHUNK_SIZE 4096
+
 /*
 *   DATA DEFINITIONS
 */
@@ -108,16 +240,35 @@ static tagFile TagFile = {
     { 0, 0 },        /* max */
     NULL,                /* vLine */
     .cork = false,
+    .arena = NULL,
+    .arenaLast = NULL,
+    .scopeNames = NULL,
+    .scopeNameCount = 0,
     .corkQueue = {
 	    .queue = NULL,
+	    .qualifiedNames = NULL,
 	    .length = 0,
-	    .count  = 0
+	    .count  = 0,
+	    .flushed = 0,
     },
     .patternCacheValid = false,
 };
 
+static unsigned int hashSeenLine (const void *key);
+static bool isSameSeenLine (const void *a, const void *b);
+static void forgetSeenLines (void);
+
 static bool TagsToStdout = false;
 
+/*  With --filter-batch, the tags written to stdout are flushed by the
+ *  filter loop, which may keep them for those of the next file names.
+ */
+static bool isTagOutputFlushedByFilter (void)
+{
+	return TagsToStdout && Option.filter && ! Option.interactive
+		&& Option.filterBatchSize > 0;
+}
+
 /*
 *   FUNCTION PROTOTYPES
 */
@@ -137,7 +288,12 @@ extern void freeTagFileResources (void)
 {
 	if (TagFile.directory != NULL)
 		eFree (TagFile.directory);
+	if (TagFile.staleFiles)
+		hashTableDelete (TagFile.staleFiles);
+	if (TagFile.staleDirectories)
+		stringListDelete (TagFile.staleDirectories);
 	vStringDelete (TagFile.vLine);
+	vStringDelete (TagFile.subword);
 }
 
 extern const char *tagFileName (void)
@@ -145,6 +301,19 @@ extern const char *tagFileName (void)
 	return TagFile.name;
 }
 
+/*  Open NAME for writing tags, with the buffer of --output-buffer-size
+ *  so that the many short lines go out in few large writes.
+ */
+extern MIO *newTagFileOutput (const char *const name, const char *const mode)
+{
+	MIO *const mio = mio_new_file (name, mode);
+
+	if (mio != NULL && Option.outputBufferSize > 0
+		&& mio_set_buffer (mio, Option.outputBufferSize) != 0)
+		verbose ("cannot set the output buffer of \"%s\"\n", name);
+	return mio;
+}
+
 /*
 *   Pseudo tag support
 */
@@ -248,10 +417,38 @@ static void updateSortedFlag (
 	}
 }
 
+/*  Count the lines from the position of MIO to the end, a block at a
+ *  time: the tag lines themselves are not needed.
+ */
+static unsigned long countRemainingLines (MIO *const mio)
+{
+	enum { BlockSize = 64 * 1024 };
+	char *const block = xMalloc (BlockSize, char);
+	unsigned long count = 0;
+	bool partial = false;		/* a line without its newline yet */
+	size_t length;
+
+	while ((length = mio_read (mio, block, 1, BlockSize)) > 0)
+	{
+		const char *p = block;
+		const char *const end = block + length;
+		const char *nl;
+
+		while ((nl = memchr (p, '\n', end - p)) != NULL)
+		{
+			count++;
+			p = nl + 1;
+		}
+		partial = (p < end);
+	}
+	eFree (block);
+	return count + (partial? 1: 0);
+}
+
 /*  Look through all line beginning with "!_TAG_FILE", and update those which
  *  require it.
  */
-static long unsigned int updatePseudoTags (MIO *const mio)
+static long unsigned int updatePseudoTags (MIO *const mio, bool countTags)
 {
 	enum { maxEntryLength = 20 };
 	char entry [maxEntryLength + 1];
@@ -277,18 +474,22 @@ static long unsigned int updatePseudoTags (MIO *const mio)
 				tab == '\t')
 			{
 				if (strcmp (classType, "_SORTED") == 0)
+				{
+#ifdef EXTERNAL_SORT
+					const char *const value = strchr (line, '\t') + 1;
+					TagFile.baseSorted = (value [0] == '0' + (int) Option.sorted
+										  && value [1] == '\t');
+#endif
 					updateSortedFlag (line, mio, startOfLine);
+				}
 			}
 			mio_getpos (mio, &startOfLine);
 		}
 		line = readLineRaw (TagFile.vLine, mio);
 	}
-	while (line != NULL)  /* skip to end of file */
-	{
-		++linesRead;
-		line = readLineRaw (TagFile.vLine, mio);
-	}
-	return linesRead;
+	if (! countTags || line == NULL)
+		return linesRead;  /* the others are counted when merged */
+	return linesRead + 1 + countRemainingLines (mio);
 }
 
 /*
@@ -374,12 +575,677 @@ static bool isTagFile (const char *const filename)
 		if (line == NULL)
 			ok = true;
 		else
-			ok = (bool) (isCtagsLine (line) || isEtagsLine (line));
+			ok = (bool) (isCtagsLine (line) || isEtagsLine (line)
+						 || strncmp (line, BINARY_INDEX_MAGIC,
+									 strlen (BINARY_INDEX_MAGIC)) == 0);
+		if (! ok)
+		{
+			unsigned char head [32];
+
+			mio_rewind (mio);
+			ok = isProtobufTagStream (head, mio_read (mio, head, 1, sizeof (head)));
+		}
 		mio_free (mio);
 	}
 	return ok;
 }
 
+#ifdef EXTERNAL_SORT
+static void openTagFileSorter (void)
+{
+	TagFile.mio = mio_new_memory (NULL, 0, eRealloc, eFree);
+	TagFile.sorter = tagSorterNew ();
+}
+
+/*  The lines already in the tag file are sorted with the new ones. */
+static void openTagFileSorterWithFile (const char *const name)
+{
+	MIO *mio = mio_new_file (name, "r");
+
+	if (mio == NULL)
+		error (FATAL | PERROR, "cannot open tag file");
+	openTagFileSorter ();
+	tagSorterAddFile (TagFile.sorter, mio, NULL, NULL);
+	mio_free (mio);
+}
+
+/*  Move the tag lines written so far to the sorter. The bytes after the
+ *  current position are garbage left by a parser rescan.
+ */
+static void flushTagFileSorter (void)
+{
+	size_t size;
+	unsigned char *data = mio_memory_get_data (TagFile.mio, &size);
+	long end = mio_tell (TagFile.mio);
+
+	tagSorterAddLines (TagFile.sorter, (char *) data, (size_t) end);
+	mio_seek (TagFile.mio, 0L, SEEK_SET);
+}
+
+/*  Whether LINE of the tag file being updated should be kept: pseudo
+ *  tags are, and the tags of the files given to forgetTagsOfFile () or
+ *  under a directory given to forgetTagsUnderDirectory () are not.
+ */
+static bool isTagLineUpToDate (const char *line, void *data CTAGS_ATTR_UNUSED)
+{
+	const char *input, *tab;
+	unsigned int i;
+
+	if ((TagFile.staleFiles == NULL && TagFile.staleDirectories == NULL)
+		|| strncmp (line, PSEUDO_TAG_PREFIX, strlen (PSEUDO_TAG_PREFIX)) == 0)
+		return true;
+
+	input = strchr (line, '\t');
+	if (input == NULL)
+		return true;
+	input++;
+	tab = strchr (input, '\t');
+	if (tab == NULL)
+		return true;
+
+	if (TagFile.staleDirectories)
+		for (i = 0; i < stringListCount (TagFile.staleDirectories); i++)
+		{
+			const vString *const prefix = stringListItem (TagFile.staleDirectories, i);
+
+			if ((size_t) (tab - input) > vStringLength (prefix)
+				&& strncmp (input, vStringValue (prefix), vStringLength (prefix)) == 0)
+				return false;
+		}
+
+	if (TagFile.staleFiles == NULL)
+		return true;
+	vStringNCopyS (TagFile.vLine, input, tab - input);
+	return ! hashTableHasItem (TagFile.staleFiles, vStringValue (TagFile.vLine));
+}
+
+/*  Give the lines of the tag file being updated to the sorter, or write
+ *  them to MIO first when not sorting. Return the number of lines
+ *  written to MIO.
+ */
+static unsigned long mergeTagFileBase (MIO *mio)
+{
+	unsigned long written = 0;
+	vString *vLine;
+
+	if (Option.sorted != SO_UNSORTED && TagFile.baseSorted)
+	{
+		verbose ("merging tags into %s\n", TagFile.name);
+		tagSorterMergeFile (TagFile.sorter, TagFile.base, isTagLineUpToDate, NULL);
+		TagFile.base = NULL;
+		return 0;
+	}
+
+	if (Option.sorted != SO_UNSORTED)
+		tagSorterAddFile (TagFile.sorter, TagFile.base, isTagLineUpToDate, NULL);
+	else
+	{
+		vLine = vStringNew ();
+		while (readLineRaw (vLine, TagFile.base) != NULL)
+		{
+			if (isTagLineUpToDate (vStringValue (vLine), NULL))
+			{
+				mio_puts (mio, vStringValue (vLine));
+				written++;
+			}
+		}
+		vStringDelete (vLine);
+	}
+	mio_free (TagFile.base);
+	TagFile.base = NULL;
+	return written;
+}
+
+/*  Whether LINE of a shard goes to the merged tag file: the pseudo tags
+ *  common to all the parsers are written again for the merged file, and
+ *  those of a parser (e.g. "!_TAG_KIND_DESCRIPTION!C") are kept.
+ */
+static bool isShardLineKept (const char *line, void *data CTAGS_ATTR_UNUSED)
+{
+	const size_t prefixLength = strlen (PSEUDO_TAG_PREFIX);
+	const char *end;
+	ptagType type;
+
+	if (strncmp (line, PSEUDO_TAG_PREFIX, prefixLength) != 0)
+		return true;
+
+	line += prefixLength;
+	end = strpbrk (line, "!\t");
+	if (end == NULL || *end == '!')
+		return true;
+
+	vStringNCopyS (TagFile.vLine, line, end - line);
+	type = getPtagTypeForName (vStringValue (TagFile.vLine));
+	return ! (type != PTAG_UNKNOWN && isPtagCommonInParsers (type));
+}
+
+/*  Return the value of the "!_TAG_FILE_SORTED" pseudo tag of the tag file
+ *  read by MIO, or -1 if it has none, and rewind MIO.
+ */
+static int readShardSorted (MIO *mio, const char *const fileName)
+{
+	const char *const entry = PSEUDO_TAG_PREFIX "TAG_FILE_SORTED\t";
+	const char *line;
+	int sorted = -1;
+
+	line = readLineRaw (TagFile.vLine, mio);
+	if (line != NULL && ! isCtagsLine (line))
+		error (FATAL, "\"%s\" doesn't look like a tag file", fileName);
+	while (line != NULL && strncmp (line, PSEUDO_TAG_PREFIX,
+									strlen (PSEUDO_TAG_PREFIX)) == 0)
+	{
+		if (strncmp (line, entry, strlen (entry)) == 0
+			&& isdigit ((unsigned char) line [strlen (entry)]))
+			sorted = line [strlen (entry)] - '0';
+		line = readLineRaw (TagFile.vLine, mio);
+	}
+	mio_seek (mio, 0L, SEEK_SET);
+	return sorted;
+}
+
+/*  With --merge-shards, merge the tag file FILENAME, written by another
+ *  run of ctags, into the tag file. A shard sorted the way the tags are
+ *  sorted now is read while merging; any other is sorted first.
+ */
+extern void mergeTagFileShard (const char *const fileName)
+{
+	MIO *mio = mio_new_file (fileName, "r");
+	int sorted;
+
+	if (mio == NULL)
+		error (FATAL | PERROR, "cannot open shard \"%s\"", fileName);
+
+	sorted = readShardSorted (mio, fileName);
+	TagFile.shards++;
+	if (sorted == (int) Option.sorted)
+	{
+		verbose ("merging shard %s\n", fileName);
+		tagSorterMergeFile (TagFile.sorter, mio, isShardLineKept, NULL);
+	}
+	else
+	{
+		verbose ("sorting shard %s\n", fileName);
+		tagSorterAddFile (TagFile.sorter, mio, isShardLineKept, NULL);
+		mio_free (mio);
+	}
+}
+
+static void closeTagFileSorter (void)
+{
+	MIO *mio;
+	vString *tmpName = NULL;
+	unsigned long written = 0;
+	const bool updating = (TagFile.base != NULL);
+	const bool merging = (updating || TagFile.shards > 0);
+
+	flushTagFileSorter ();
+	if (mio_free (TagFile.mio) != 0)
+		error (FATAL | PERROR, "cannot close tag file");
+	TagFile.mio = NULL;
+
+	if (Option.append && ! updating && TagFile.numTags.added == 0 && !TagsToStdout)
+	{
+		/* Nothing to add; the pseudo tags are already updated in place. */
+		tagSorterFinish (TagFile.sorter, NULL, false);
+		TagFile.sorter = NULL;
+		return;
+	}
+
+	if (TagsToStdout)
+		mio = mio_new_fp (stdout, NULL);
+	else if (updating)
+	{
+		/* The tag file is read while writing the new one. */
+		tmpName = vStringNewInit (tagFileName ());
+		vStringCatS (tmpName, ".new");
+		mio = newTagFileOutput (vStringValue (tmpName), "w");
+	}
+	else
+		mio = newTagFileOutput (tagFileName (), "w");
+	if (mio == NULL)
+		error (FATAL | PERROR, "cannot open tag file");
+
+	if (updating)
+		written = mergeTagFileBase (mio);
+
+	verbose ("sorting tag file\n");
+	beginTraceSpan ("sort", NULL, NULL);
+	/* Without tags, the pseudo tags are written in the order they came. */
+	written += tagSorterFinish (TagFile.sorter, mio,
+								Option.sorted != SO_UNSORTED
+								&& (TagFile.numTags.added > 0L || merging));
+	endTraceSpan ();
+	TagFile.sorter = NULL;
+
+	if ((! isTagOutputFlushedByFilter () && mio_flush (mio) != 0)
+		|| mio_free (mio) != 0)
+		error (FATAL | PERROR, "cannot close tag file");
+
+	if (tmpName)
+	{
+		if (rename (vStringValue (tmpName), tagFileName ()) != 0)
+			error (FATAL | PERROR, "cannot replace tag file \"%s\"", tagFileName ());
+		vStringDelete (tmpName);
+	}
+	if (merging)
+		TagFile.numTags.prev = written - TagFile.numTags.added;
+	TagFile.shards = 0;
+}
+#endif
+
+/*  With --update, the tags of FILENAME in the tag file are left out of
+ *  the updated one: it has been parsed again, or removed.
+ */
+extern vString *makeInputField (const char *const fileName)
+{
+	vString *tagPath = makeInputTagPath (fileName);
+
+	if (getTagWriterType () == WRITER_U_CTAGS)
+	{
+		/* The input field is escaped by the writer. */
+		vString *escaped = vStringNew ();
+		vStringCatSWithEscaping (escaped, vStringValue (tagPath));
+		vStringDelete (tagPath);
+		tagPath = escaped;
+	}
+	return tagPath;
+}
+
+extern void forgetTagsOfFile (const char *const fileName)
+{
+	vString *tagPath = makeInputField (fileName);
+	char *key;
+
+	if (TagFile.staleFiles == NULL)
+		TagFile.staleFiles = hashTableNew (1021, hashCstrhash, hashCstreq,
+										   eFree, NULL);
+	key = vStringDeleteUnwrap (tagPath);
+	if (hashTableHasItem (TagFile.staleFiles, key))
+		eFree (key);
+	else
+		hashTablePutItem (TagFile.staleFiles, key, key);
+}
+
+extern void forgetTagsUnderDirectory (const char *const dirName)
+{
+	vString *dir = vStringNewInit (dirName);
+	vString *prefix;
+
+	while (vStringLength (dir) > 1
+		   && vStringLast (dir) == OUTPUT_PATH_SEPARATOR)
+		vStringChop (dir);
+	prefix = makeInputField (vStringValue (dir));
+	vStringDelete (dir);
+
+	vStringPut (prefix, OUTPUT_PATH_SEPARATOR);
+	if (TagFile.staleDirectories == NULL)
+		TagFile.staleDirectories = stringListNew ();
+	stringListAdd (TagFile.staleDirectories, prefix);
+}
+
+/*  With --atomic-output, the tag file is written to a file next to it,
+ *  renamed to the tag file when it is complete, so that a reader sees
+ *  either the old tag file or the new one. When the tags are appended,
+ *  the new file starts with a copy of the old one.
+ */
+static void beginAtomicTagFile (bool keep)
+{
+	vString *name = vStringNewInit (TagFile.name);
+#ifdef HAVE_UNISTD_H
+	char pid [32];
+
+	snprintf (pid, sizeof (pid), ".%ld", (long) getpid ());
+	vStringCatS (name, pid);
+#else
+	vStringCatS (name, ".tmp");
+#endif
+
+	if (keep)
+	{
+		MIO *from = mio_new_file (TagFile.name, "rb");
+		MIO *to = from? mio_new_file (vStringValue (name), "wb"): NULL;
+		char buffer [BUFSIZ];
+		size_t n;
+
+		if (to == NULL)
+			error (FATAL | PERROR, "cannot copy tag file \"%s\"", TagFile.name);
+		while ((n = mio_read (from, buffer, 1, sizeof (buffer))) > 0)
+			if (mio_write (to, buffer, 1, n) != n)
+				break;
+		if (mio_error (from) || mio_error (to) || mio_free (to) != 0)
+			error (FATAL | PERROR, "cannot copy tag file \"%s\"", TagFile.name);
+		mio_free (from);
+	}
+
+	TagFile.publishedName = TagFile.name;
+	TagFile.name = vStringDeleteUnwrap (name);
+}
+
+static void publishTagFile (void)
+{
+#ifdef HAVE_FSYNC
+	const int fd = open (TagFile.name, O_RDONLY);
+
+	/* The contents are on the disk before the name refers to them. */
+	if (fd == -1 || fsync (fd) != 0)
+		error (WARNING | PERROR, "cannot sync tag file \"%s\"", TagFile.name);
+	if (fd != -1)
+		close (fd);
+#endif
+	if (rename (TagFile.name, TagFile.publishedName) != 0)
+	{
+		remove (TagFile.name);
+		error (FATAL | PERROR, "cannot replace tag file \"%s\"", TagFile.publishedName);
+	}
+	eFree (TagFile.name);
+	TagFile.name = TagFile.publishedName;
+	TagFile.publishedName = NULL;
+}
+
+/*  Write as the writer of OUT does until leaveTagOutput () is called. */
+static void enterTagOutput (tagOutput *const out, tagOutputSaved *saved)
+{
+	saved->wtype = getTagWriterType ();
+	saved->fields = swapFieldEnabledTable (&out->fields, &out->fieldCount);
+	setTagWriter (out->type);
+}
+
+static void leaveTagOutput (const tagOutputSaved *saved)
+{
+	setTagWriter (saved->wtype);
+	setFieldEnabledTable (saved->fields);
+}
+
+/*  The lines of OUT are sorted as those of the tag file, unless they
+ *  are etags sections.
+ */
+static bool isTagOutputSorted (const tagOutput *const out)
+{
+	return (Option.sorted != SO_UNSORTED && out->type != WRITER_ETAGS);
+}
+
+/*  Write the common pseudo tags to OUT as its writer does, as if OUT
+ *  were the tag file.
+ */
+static void addTagOutputPseudoTags (tagOutput *const out)
+{
+	tagOutputSaved saved;
+	MIO *const mio = TagFile.mio;
+	const struct sNumTags numTags = TagFile.numTags;
+	const struct sMax max = TagFile.max;
+	const bool jsonVersion = enablePtag (PTAG_JSON_OUTPUT_VERSION,
+										 out->type == WRITER_JSON);
+	const bool outputMode = isPtagEnabled (PTAG_OUTPUT_MODE);
+
+	/* See setJsonMode (). */
+	if (out->type == WRITER_JSON)
+		enablePtag (PTAG_OUTPUT_MODE, false);
+
+	enterTagOutput (out, &saved);
+	TagFile.mio = out->mio;
+	if (writerCanPrintPtag ())
+		addCommonPseudoTags ();
+	TagFile.mio = mio;
+	TagFile.numTags = numTags;
+	TagFile.max = max;
+	leaveTagOutput (&saved);
+
+	enablePtag (PTAG_JSON_OUTPUT_VERSION, jsonVersion);
+	enablePtag (PTAG_OUTPUT_MODE, outputMode);
+}
+
+static void openTagOutputs (void)
+{
+	unsigned int i;
+
+	if (Option.outputs == NULL)
+		return;
+
+	TagFile.outputs = xCalloc (stringListCount (Option.outputs), tagOutput);
+	for (i = 0; i < stringListCount (Option.outputs); i++)
+	{
+		const char *const spec = vStringValue (stringListItem (Option.outputs, i));
+		const char *const colon = strchr (spec, ':');
+		tagOutput *const out = TagFile.outputs + i;
+		tagOutputSaved saved;
+
+		out->type = getNamedTagWriterType (spec, colon - spec);
+		out->name = eStrdup (colon + 1);
+		out->file = newTagFileOutput (out->name, "w");
+		if (out->file == NULL)
+			error (FATAL | PERROR, "cannot open tag file \"%s\"", out->name);
+		out->mio = mio_new_memory (NULL, 0, eRealloc, eFree);
+#ifdef EXTERNAL_SORT
+		if (isTagOutputSorted (out))
+			out->sorter = tagSorterNew ();
+#endif
+		/* The fields are those of the tag file before its writer adds
+		   the ones it needs. */
+		enterTagOutput (out, &saved);
+		leaveTagOutput (&saved);
+
+		/* Not counted yet: the pseudo tags go to OUT only. */
+		if (isXtagEnabled (XTAG_PSEUDO_TAGS))
+			addTagOutputPseudoTags (out);
+	}
+	TagFile.outputCount = i;
+}
+
+/*  Move the lines written to OUT for an input file. The bytes after the
+ *  current position are garbage left by a parser rescan.
+ */
+static void flushTagOutput (tagOutput *const out)
+{
+	unsigned char *data = mio_memory_get_data (out->mio, NULL);
+	const long end = mio_tell (out->mio);
+
+#ifdef EXTERNAL_SORT
+	if (out->sorter)
+		tagSorterAddLines (out->sorter, (char *) data, (size_t) end);
+	else
+#endif
+	if (end > 0 && mio_write (out->file, data, 1, (size_t) end) != (size_t) end)
+		error (FATAL | PERROR, "cannot write tag file \"%s\"", out->name);
+	mio_seek (out->mio, 0L, SEEK_SET);
+}
+
+static void closeTagOutputs (void)
+{
+	unsigned int i;
+
+	for (i = 0; i < TagFile.outputCount; i++)
+	{
+		tagOutput *const out = TagFile.outputs + i;
+
+		flushTagOutput (out);
+#ifdef EXTERNAL_SORT
+		/* Without tags, the pseudo tags are written in the order they came. */
+		if (out->sorter)
+			tagSorterFinish (out->sorter, out->file, out->numTags > 0);
+#endif
+		if (mio_flush (out->file) != 0 || mio_free (out->file) != 0)
+			error (FATAL | PERROR, "cannot close tag file \"%s\"", out->name);
+		mio_free (out->mio);
+		eFree (out->fields);
+		eFree (out->name);
+	}
+	if (TagFile.outputs)
+		eFree (TagFile.outputs);
+	TagFile.outputs = NULL;
+	TagFile.outputCount = 0;
+}
+
+static void deleteTagPartition (void *data)
+{
+	tagPartition *p = data;
+
+	eFree (p->name);
+	eFree (p->directory);
+	eFree (p);
+}
+
+static void openTagPartitions (void)
+{
+#ifdef EXTERNAL_SORT
+	if (Option.partition == PARTITION_NONE)
+		return;
+
+	TagFile.partitions = hashTableNew (256, hashCstrhash, hashCstreq,
+									   eFree, deleteTagPartition);
+	TagFile.top.name = TagFile.name;
+	TagFile.top.directory = TagFile.directory;
+	TagFile.top.sorter = TagFile.sorter;
+	TagFile.partition = &TagFile.top;
+#endif
+}
+
+#ifdef EXTERNAL_SORT
+/*  Write the tags to P from now on. */
+static void switchTagPartition (tagPartition *const p)
+{
+	if (p == TagFile.partition)
+		return;
+
+	/* The lines written so far are of the partition left. */
+	flushTagFileSorter ();
+	TagFile.sorter = p->sorter;
+	TagFile.directory = p->directory;
+	TagFile.partition = p;
+}
+
+/*  The key of the partition of FILENAME, the directories of its first
+ *  Option.partitionDepth levels, or NULL if it is not that deep and has
+ *  its tags in the tag file.
+ */
+static vString *makeDirectoryPartitionKey (const char *const fileName)
+{
+	const char *start = fileName;
+	const char *p;
+	unsigned int depth;
+	vString *key;
+
+	while (start [0] == '.' && (start [1] == '/' || start [1] == PATH_SEPARATOR))
+		start += 2;
+
+	p = start;
+	if (*p == '/' || *p == PATH_SEPARATOR)
+		p++;
+	for (depth = 0; depth < Option.partitionDepth; depth++)
+	{
+		while (*p != '\0' && *p != '/' && *p != PATH_SEPARATOR)
+			p++;
+		if (*p == '\0')
+			return NULL;
+		if (depth + 1 < Option.partitionDepth)
+			p++;
+	}
+	key = vStringNew ();
+	vStringNCatS (key, start, p - start);
+	return key;
+}
+
+static tagPartition *newTagPartition (const char *const key)
+{
+	tagPartition *p = xMalloc (1, tagPartition);
+
+	if (Option.partition == PARTITION_LANGUAGE)
+	{
+		vString *name = vStringNewInit (TagFile.top.name);
+
+		vStringPut (name, '.');
+		vStringCatS (name, key);
+		p->name = vStringDeleteUnwrap (name);
+	}
+	else
+		p->name = combinePathAndFile (key, baseFilename (TagFile.top.name));
+
+	if (doesFileExist (p->name) && ! isTagFile (p->name))
+		error (FATAL,
+			   "\"%s\" doesn't look like a tag file; I refuse to overwrite it.",
+			   p->name);
+	p->directory = absoluteDirname (p->name);
+	p->sorter = tagSorterNew ();
+	return p;
+}
+#endif
+
+/*  --partition: write the tags of FILENAME, tagged by the parser of
+ *  LANGUAGE, to the tag file of its partition. This is done before the
+ *  file is opened, so that its input field is relative to that file.
+ */
+extern void selectTagPartition (const char *const fileName, langType language)
+{
+#ifdef EXTERNAL_SORT
+	vString *key;
+	tagPartition *p;
+
+	if (TagFile.partitions == NULL)
+		return;
+
+	if (Option.partition == PARTITION_LANGUAGE)
+		key = vStringNewInit (getLanguageName (language));
+	else
+		key = makeDirectoryPartitionKey (fileName);
+
+	if (key == NULL)
+	{
+		switchTagPartition (&TagFile.top);
+		return;
+	}
+
+	p = hashTableGetItem (TagFile.partitions, vStringValue (key));
+	if (p)
+	{
+		vStringDelete (key);
+		switchTagPartition (p);
+		return;
+	}
+
+	p = newTagPartition (vStringValue (key));
+	hashTablePutItem (TagFile.partitions, vStringDeleteUnwrap (key), p);
+	verbose ("writing partition %s\n", p->name);
+	switchTagPartition (p);
+	if (isXtagEnabled (XTAG_PSEUDO_TAGS))
+		addCommonPseudoTags ();
+#endif
+}
+
+#ifdef EXTERNAL_SORT
+static void closeTagPartition (void *key CTAGS_ATTR_UNUSED, void *value,
+							   void *user_data CTAGS_ATTR_UNUSED)
+{
+	tagPartition *p = value;
+	MIO *mio = newTagFileOutput (p->name, "w");
+
+	if (mio == NULL)
+		error (FATAL | PERROR, "cannot open tag file \"%s\"", p->name);
+	tagSorterFinish (p->sorter, mio, Option.sorted != SO_UNSORTED);
+	p->sorter = NULL;
+	if (mio_flush (mio) != 0 || mio_free (mio) != 0)
+		error (FATAL | PERROR, "cannot close tag file \"%s\"", p->name);
+}
+#endif
+
+/*  Write the tag files of the partitions, each sorted by its sorter, and
+ *  leave the tag file to closeTagFile ().
+ */
+static void closeTagPartitions (void)
+{
+#ifdef EXTERNAL_SORT
+	if (TagFile.partitions == NULL)
+		return;
+
+	switchTagPartition (&TagFile.top);
+	verbose ("sorting %d partitions\n", hashTableCountItem (TagFile.partitions));
+	beginTraceSpan ("sort", NULL, NULL);
+	hashTableForeachItem (TagFile.partitions, closeTagPartition, NULL);
+	endTraceSpan ();
+	hashTableDelete (TagFile.partitions);
+	TagFile.partitions = NULL;
+	TagFile.partition = NULL;
+#endif
+}
+
 extern void openTagFile (void)
 {
 	setDefaultTagFileName ();
@@ -390,7 +1256,23 @@ extern void openTagFile (void)
 
 	/*  Open the tags file.
 	 */
-	if (TagsToStdout)
+	if (writerRewritesOutput ())
+	{
+		if (TagsToStdout)
+			TagFile.name = eStrdup ("/dev/stdout");
+		else
+		{
+			TagFile.name = eStrdup (Option.tagFileName);
+			if (! isTagFile (TagFile.name))
+				error (FATAL,
+					   "\"%s\" doesn't look like a tag file; I refuse to overwrite it.",
+					   TagFile.name);
+			if (Option.atomicOutput)
+				beginAtomicTagFile (false);
+		}
+		TagFile.mio = tempFile ("w+b", &TagFile.entriesName);
+	}
+	else if (TagsToStdout)
 	{
 		if (Option.sorted == SO_UNSORTED)
 		{
@@ -399,12 +1281,20 @@ extern void openTagFile (void)
 			TagFile.mio = mio_new_fp(stdout, NULL);
 			TagFile.name = eStrdup ("/dev/stdout");
 		}
+#ifdef EXTERNAL_SORT
+		else
+		{
+			openTagFileSorter ();
+			TagFile.name = eStrdup ("/dev/stdout");
+		}
+#else
 		else
 		{
 			/* Open a tempfile with read and write mode. Read mode is used when
 			 * write the result to stdout. */
 			TagFile.mio = tempFile ("w+", &TagFile.name);
 		}
+#endif
 
 		if (isXtagEnabled (XTAG_PSEUDO_TAGS))
 			addCommonPseudoTags ();
@@ -412,6 +1302,13 @@ extern void openTagFile (void)
 	else
 	{
 		bool fileExists;
+		bool update = Option.update;
+#ifdef EXTERNAL_SORT
+		/* Only --totals tells the number of tags in the file appended to. */
+		const bool countOldTags = (Option.printTotals != TOTALS_NO);
+#else
+		const bool countOldTags = true;  /* for internalSortTags () */
+#endif
 
 		TagFile.name = eStrdup (Option.tagFileName);
 		fileExists = doesFileExist (TagFile.name);
@@ -420,28 +1317,56 @@ extern void openTagFile (void)
 			  "\"%s\" doesn't look like a tag file; I refuse to overwrite it.",
 				  TagFile.name);
 
+		/* The tags of the files unchanged since the last run are kept. */
+		if (Option.manifest && openManifest (TagFile.name, fileExists))
+			update = true;
+
+		if (Option.atomicOutput)
+			beginAtomicTagFile ((Option.append || update) && fileExists);
+
 		if (Option.etags)
 		{
 			if (Option.append  &&  fileExists)
-				TagFile.mio = mio_new_file (TagFile.name, "a+b");
+				TagFile.mio = newTagFileOutput (TagFile.name, "a+b");
 			else
-				TagFile.mio = mio_new_file (TagFile.name, "w+b");
+				TagFile.mio = newTagFileOutput (TagFile.name, "w+b");
 		}
 		else
 		{
-			if (Option.append  &&  fileExists)
+			if ((Option.append || update)  &&  fileExists)
 			{
 				TagFile.mio = mio_new_file (TagFile.name, "r+");
 				if (TagFile.mio != NULL)
 				{
-					TagFile.numTags.prev = updatePseudoTags (TagFile.mio);
+					TagFile.numTags.prev = updatePseudoTags (TagFile.mio,
+															 ! update && countOldTags);
 					mio_free (TagFile.mio);
-					TagFile.mio = mio_new_file (TagFile.name, "a+");
+#ifdef EXTERNAL_SORT
+					if (update)
+					{
+						TagFile.base = mio_new_file (TagFile.name, "r");
+						if (TagFile.base == NULL)
+							error (FATAL | PERROR, "cannot open tag file");
+						openTagFileSorter ();
+					}
+					else if (Option.sorted != SO_UNSORTED)
+						openTagFileSorterWithFile (TagFile.name);
+					else
+#endif
+					TagFile.mio = newTagFileOutput (TagFile.name, "a+");
 				}
 			}
 			else
 			{
-				TagFile.mio = mio_new_file (TagFile.name, "w");
+#ifdef EXTERNAL_SORT
+				/* The lines of the partitions are kept apart by their
+				   sorters. */
+				if (Option.sorted != SO_UNSORTED
+					|| Option.partition != PARTITION_NONE)
+					openTagFileSorter ();
+				else
+#endif
+				TagFile.mio = newTagFileOutput (TagFile.name, "w");
 				if (TagFile.mio != NULL && isXtagEnabled (XTAG_PSEUDO_TAGS))
 					addCommonPseudoTags ();
 			}
@@ -450,6 +1375,14 @@ extern void openTagFile (void)
 			error (FATAL | PERROR, "cannot open tag file");
 	}
 
+	/* The sort drops the duplicate lines of a sorted tag file. */
+	if (Option.deduplicateTags && Option.sorted == SO_UNSORTED)
+	{
+		TagFile.seenLines.table = hashTableNew (1024, hashSeenLine, isSameSeenLine,
+												NULL, NULL);
+		TagFile.seenLines.line = mio_new_memory (NULL, 0, eRealloc, eFree);
+	}
+
 	if (TagFile.directory == NULL)
 	{
 		if (TagsToStdout)
@@ -457,6 +1390,9 @@ extern void openTagFile (void)
 		else
 			TagFile.directory = absoluteDirname (TagFile.name);
 	}
+
+	openTagOutputs ();
+	openTagPartitions ();
 }
 
 #ifdef USE_REPLACEMENT_TRUNCATE
@@ -551,10 +1487,10 @@ static void sortTagFile (void)
 		if (Option.sorted != SO_UNSORTED)
 		{
 			verbose ("sorting tag file\n");
-#ifdef EXTERNAL_SORT
-			externalSortTags (TagsToStdout, TagFile.mio);
-#else
+#ifndef EXTERNAL_SORT
+			beginTraceSpan ("sort", NULL, NULL);
 			internalSortTagFile ();
+			endTraceSpan ();
 #endif
 		}
 		else if (TagsToStdout)
@@ -606,13 +1542,58 @@ static void writeEtagsIncludes (MIO *const mio)
 	}
 }
 
+/*  Make the tag file from the entries written to the temporary file. */
+static void rewriteTagFile (void)
+{
+	const long size = mio_tell (TagFile.mio);
+	MIO *output;
+
+	if (TagsToStdout)
+		output = mio_new_fp (stdout, NULL);
+	else
+		output = newTagFileOutput (TagFile.name, "wb");
+	if (output == NULL)
+		error (FATAL | PERROR, "cannot open tag file");
+
+	mio_rewind (TagFile.mio);
+	writerRewriteOutput (TagFile.mio, size, output);
+	abort_if_ferror (output);
+	if (mio_free (output) != 0)
+		error (FATAL | PERROR, "cannot close tag file");
+
+	mio_free (TagFile.mio);
+	TagFile.mio = NULL;
+	remove (TagFile.entriesName);
+	eFree (TagFile.entriesName);
+	TagFile.entriesName = NULL;
+}
+
 extern void closeTagFile (const bool resize)
 {
 	long desiredSize, size;
+	char *compressed = NULL;
+
+	forgetTagsOfVanishedFiles ();
+	closeTagPartitions ();
+
+	if (TagFile.entriesName)
+	{
+		rewriteTagFile ();
+		goto out;
+	}
+
+#ifdef EXTERNAL_SORT
+	if (TagFile.sorter)
+	{
+		closeTagFileSorter ();
+		goto out;
+	}
+#endif
 
 	if (Option.etags)
 		writeEtagsIncludes (TagFile.mio);
-	mio_flush (TagFile.mio);
+	if (! isTagOutputFlushedByFilter ())
+		mio_flush (TagFile.mio);
 
 	if ((TagsToStdout && (Option.sorted == SO_UNSORTED)))
 	{
@@ -622,32 +1603,281 @@ extern void closeTagFile (const bool resize)
 	}
 
 	abort_if_ferror (TagFile.mio);
-	desiredSize = mio_tell (TagFile.mio);
-	mio_seek (TagFile.mio, 0L, SEEK_END);
-	size = mio_tell (TagFile.mio);
-	if (! TagsToStdout)
-		/* The tag file should be closed before resizing. */
-		if (mio_free (TagFile.mio) != 0)
-			error (FATAL | PERROR, "cannot close tag file");
+	desiredSize = mio_tell (TagFile.mio);
+	mio_seek (TagFile.mio, 0L, SEEK_END);
+	size = mio_tell (TagFile.mio);
+	if (! TagsToStdout)
+		/* The tag file should be closed before resizing. */
+		if (mio_free (TagFile.mio) != 0)
+			error (FATAL | PERROR, "cannot close tag file");
+
+	if (resize  &&  desiredSize < size)
+	{
+		DebugStatement (
+			debugPrintf (DEBUG_STATUS, "shrinking %s from %ld to %ld bytes\n",
+				TagFile.name, size, desiredSize); )
+		resizeTagFile (desiredSize);
+	}
+	sortTagFile ();
+	if (TagsToStdout)
+	{
+		if (mio_free (TagFile.mio) != 0)
+			error (FATAL | PERROR, "cannot close tag file");
+		remove (tagFileName ());  /* remove temporary file */
+	}
+
+ out:
+	closeTagOutputs ();
+
+	/* The indexes, written from the tag file, must not be older than the
+	   compressed one, which keeps the time it is written. */
+	if (Option.compress != COMPRESS_NONE && ! TagsToStdout)
+		compressed = compressTagFile (TagFile.name, Option.compressFrameSize);
+	/* The indexes and the manifest are named after the tag file. */
+	if (TagFile.publishedName)
+		publishTagFile ();
+	if (Option.nameIndex)
+		writeNameIndex (TagFile.name);
+	if (Option.foldIndex)
+		writeFoldIndex (TagFile.name);
+	if (Option.inputIndex)
+		writeInputIndex (TagFile.name);
+	if (Option.nameFilter)
+		writeNameFilter (TagFile.name);
+	if (Option.trigramIndex)
+		writeTrigramIndex (TagFile.name);
+	if (compressed)
+	{
+		if (rename (compressed, TagFile.name) != 0)
+			error (FATAL | PERROR, "cannot replace tag file \"%s\"", TagFile.name);
+		eFree (compressed);
+	}
+	closeManifest (TagFile.name);
+	if (TagFile.staleFiles)
+	{
+		hashTableDelete (TagFile.staleFiles);
+		TagFile.staleFiles = NULL;
+	}
+	if (TagFile.staleDirectories)
+	{
+		stringListDelete (TagFile.staleDirectories);
+		TagFile.staleDirectories = NULL;
+	}
+	forgetSeenLines ();
+	eFree (TagFile.name);
+	TagFile.name = NULL;
+}
+
+/*
+ *  Duplicate tag lines (--deduplicate-tags)
+ */
+
+static unsigned int hashSeenLine (const void *key)
+{
+	const uint64_t fingerprint = *(const uint64_t *) key;
+
+	return (unsigned int) (fingerprint ^ (fingerprint >> 32));
+}
+
+static bool isSameSeenLine (const void *a, const void *b)
+{
+	return *(const uint64_t *) a == *(const uint64_t *) b;
+}
+
+/*  The lines are dropped as they are written to the tag file itself, not
+ *  to a fragment, which is checked line by line when it is appended.
+ */
+static bool isDeduplicatingTags (void)
+{
+	return TagFile.seenLines.table != NULL && TagFile.fragmentDepth == 0;
+}
+
+static uint64_t *seenLineAt (struct sSeenLines *seen, size_t i)
+{
+	return seen->chunks [i / SEEN_LINES_CHUNK_SIZE] + i % SEEN_LINES_CHUNK_SIZE;
+}
+
+/*  Tell whether a line having the fingerprint of LINE, LENGTH bytes long
+ *  with its newline, was written, and remember it if not. The fingerprint
+ *  is its 64 bits FNV-1a hash, with which two different lines are taken
+ *  for the same one once in about 2^64 / N lines for N lines written.
+ */
+static bool isSeenLine (const char *line, size_t length)
+{
+	struct sSeenLines *const seen = &TagFile.seenLines;
+	uint64_t hash = UINT64_C(0xcbf29ce484222325);
+	uint64_t *fingerprint;
+	size_t i;
+
+	for (i = 0; i < length; i++)
+		hash = (hash ^ (unsigned char) line [i]) * UINT64_C(0x100000001b3);
+
+	if (seen->count == seen->chunkCount * SEEN_LINES_CHUNK_SIZE)
+	{
+		seen->chunks = xRealloc (seen->chunks, seen->chunkCount + 1, uint64_t *);
+		seen->chunks [seen->chunkCount++] = xMalloc (SEEN_LINES_CHUNK_SIZE, uint64_t);
+	}
+	fingerprint = seenLineAt (seen, seen->count);
+	*fingerprint = hash;
+	if (hashTableHasItem (seen->table, fingerprint))
+	{
+		seen->dropped++;
+		return true;
+	}
+	hashTablePutItem (seen->table, fingerprint, fingerprint);
+	seen->count++;
+	return false;
+}
+
+/*  Forget the lines written after the mark, which a parser rescanning
+ *  the input writes again. */
+static void forgetSeenLinesAfterMark (void)
+{
+	struct sSeenLines *const seen = &TagFile.seenLines;
+
+	while (seen->count > seen->mark)
+		hashTableDeleteItem (seen->table, seenLineAt (seen, --seen->count));
+}
+
+static void forgetSeenLines (void)
+{
+	struct sSeenLines *const seen = &TagFile.seenLines;
+	size_t i;
+
+	if (seen->table == NULL)
+		return;
+
+	verbose ("%lu duplicate tag lines dropped\n", seen->dropped);
+	hashTableDelete (seen->table);
+	for (i = 0; i < seen->chunkCount; i++)
+		eFree (seen->chunks [i]);
+	if (seen->chunks)
+		eFree (seen->chunks);
+	mio_free (seen->line);
+	memset (seen, 0, sizeof (*seen));
+}
+
+/*  Write TAG to the tag file unless the same line was written before.
+ *  Return false if it is dropped.
+ */
+static bool writeTagEntryOnce (const tagEntryInfo *const tag, int *length)
+{
+	MIO *const line = TagFile.seenLines.line;
+	const char *data;
+	long size;
+
+	mio_rewind (line);
+	*length = writerWriteTag (line, tag);
+	size = mio_tell (line);
+	data = (const char *) mio_memory_get_data (line, NULL);
+	if (isSeenLine (data, (size_t) size))
+		return false;
+	if (size > 0 && mio_write (TagFile.mio, data, 1, (size_t) size) != (size_t) size)
+		error (FATAL | PERROR, "cannot write tag file");
+	return true;
+}
+
+/*  Append the lines of OUTPUT which were not written before. Return the
+ *  number of the lines dropped.
+ */
+static unsigned long appendTagLinesOnce (const char *output, size_t size)
+{
+	const char *p = output;
+	const char *const end = output + size;
+	unsigned long dropped = 0;
+
+	while (p < end)
+	{
+		const char *const newline = memchr (p, '\n', end - p);
+		const char *const next = newline? newline + 1: end;
+
+		if (isSeenLine (p, next - p))
+			dropped++;
+		else if (mio_write (TagFile.mio, p, 1, next - p) != (size_t) (next - p))
+			error (FATAL | PERROR, "cannot write tag file");
+		p = next;
+	}
+	return dropped;
+}
+
+/*  Write tags to MIO instead of the tag file until closeTagFileFragment ()
+ *  is called: a worker process of --jobs does so for the files it is
+ *  given, the tag cache for the files it stores, and the tag index of
+ *  interactive mode, which needs no tag file opened. Fragments can nest.
+ */
+extern void openTagFileFragment (MIO *mio)
+{
+	struct sTagFileOutput *saved;
+
+	if (TagFile.vLine == NULL)
+		TagFile.vLine = vStringNew ();
+
+	if (TagFile.fragmentDepth == ARRAY_SIZE (TagFile.savedOutputs))
+		error (FATAL, "too deeply nested tag file fragments");
+	saved = TagFile.savedOutputs + TagFile.fragmentDepth++;
+	saved->mio = TagFile.mio;
+	saved->numTags = TagFile.numTags;
+	saved->max = TagFile.max;
+#ifdef EXTERNAL_SORT
+	saved->sorter = TagFile.sorter;
+#endif
+
+	TagFile.mio = mio;
+#ifdef EXTERNAL_SORT
+	/* The parent process sorts the fragments. */
+	TagFile.sorter = NULL;
+#endif
+	TagFile.numTags.added = 0;
+	TagFile.numTags.prev = 0;
+	TagFile.max.line = 0;
+	TagFile.max.tag = 0;
+}
+
+/*  The caller keeps the ownership of the stream given to
+ *  openTagFileFragment.
+ */
+extern void closeTagFileFragment (tagFileFragment *fragment)
+{
+	struct sTagFileOutput *saved;
+
+	Assert (TagFile.fragmentDepth > 0);
+	abort_if_ferror (TagFile.mio);
 
-	if (resize  &&  desiredSize < size)
-	{
-		DebugStatement (
-			debugPrintf (DEBUG_STATUS, "shrinking %s from %ld to %ld bytes\n",
-				TagFile.name, size, desiredSize); )
-		resizeTagFile (desiredSize);
-	}
-	sortTagFile ();
-	if (TagsToStdout)
-	{
-		if (mio_free (TagFile.mio) != 0)
-			error (FATAL | PERROR, "cannot close tag file");
-		remove (tagFileName ());  /* remove temporary file */
-	}
+	/* Like closeTagFile, the bytes after the current position are
+	   garbage left by a parser rescan. */
+	fragment->size = mio_tell (TagFile.mio);
+	fragment->numTags = TagFile.numTags.added;
+	fragment->maxLine = TagFile.max.line;
+	fragment->maxTag = TagFile.max.tag;
+
+	saved = TagFile.savedOutputs + --TagFile.fragmentDepth;
+	TagFile.mio = saved->mio;
+	TagFile.numTags = saved->numTags;
+	TagFile.max = saved->max;
+#ifdef EXTERNAL_SORT
+	TagFile.sorter = saved->sorter;
+#endif
+}
 
- out:
-	eFree (TagFile.name);
-	TagFile.name = NULL;
+extern void appendTagFileFragment (const char *output, const tagFileFragment *fragment)
+{
+	unsigned long dropped = 0;
+
+	beginTraceSpan ("write", NULL, NULL);
+#ifdef EXTERNAL_SORT
+	if (TagFile.sorter)
+		tagSorterAddLines (TagFile.sorter, output, (size_t) fragment->size);
+	else
+#endif
+	if (isDeduplicatingTags ())
+		dropped = appendTagLinesOnce (output, (size_t) fragment->size);
+	else if (fragment->size > 0
+		&& mio_write (TagFile.mio, output, 1, fragment->size) != (size_t) fragment->size)
+		error (FATAL | PERROR, "cannot write tag file");
+	endTraceSpan ();
+
+	TagFile.numTags.added += fragment->numTags - dropped;
+	rememberMaxLengths (fragment->maxTag, fragment->maxLine);
 }
 
 /*
@@ -702,14 +1932,6 @@ static int vstring_putc (char c, void *data)
 	return 1;
 }
 
-static int vstring_puts (const char* s, void *data)
-{
-	vString *str = data;
-	int len = vStringLength (str);
-	vStringCatS (str, s);
-	return vStringLength (str) - len;
-}
-
 static bool isPosSet(MIOPos pos)
 {
 	char * p = (char *)&pos;
@@ -722,7 +1944,7 @@ static bool isPosSet(MIOPos pos)
 }
 
 extern char *readLineFromBypassAnyway (vString *const vLine, const tagEntryInfo *const tag,
-				   long *const pSeekValue)
+				   MIOOffset *const pSeekValue)
 {
 	char * line;
 
@@ -751,48 +1973,152 @@ extern void truncateTagLineAfterTag (
 	}
 }
 
-static char* getFullQualifiedScopeNameFromCorkQueue (const tagEntryInfo * inner_scope)
+static void *corkArenaAlloc (unsigned int index, size_t size)
 {
+	corkArenaChunk *chunk = TagFile.arenaLast;
+	void *p;
 
-	int kindIndex = KIND_GHOST_INDEX;
-	langType lang;
-	const tagEntryInfo *scope = inner_scope;
-	stringList *queue = stringListNew ();
-	vString *v;
-	vString *n;
-	unsigned int c;
-	const char *sep;
+	if (chunk == NULL || chunk->size - chunk->used < size)
+	{
+		const size_t chunkSize = (size > CORK_ARENA_CHUNK_SIZE)? size: CORK_ARENA_CHUNK_SIZE;
+
+		chunk = eMalloc (sizeof (corkArenaChunk) + chunkSize);
+		chunk->next = NULL;
+		chunk->used = 0;
+		chunk->size = chunkSize;
+		chunk->lastIndex = index;
+		if (TagFile.arenaLast)
+			TagFile.arenaLast->next = chunk;
+		else
+			TagFile.arena = chunk;
+		TagFile.arenaLast = chunk;
+	}
+
+	p = (char *) (chunk + 1) + chunk->used;
+	chunk->used += size;
+	if (chunk->lastIndex < index)
+		chunk->lastIndex = index;
+	return p;
+}
+
+static const char *corkArenaStrdup (unsigned int index, const char *str)
+{
+	const size_t size = strlen (str) + 1;
+
+	return memcpy (corkArenaAlloc (index, size), str, size);
+}
 
-	while (scope)
+/*  Release the chunks holding only strings of entries before N.
+ */
+static void corkArenaRelease (unsigned int n)
+{
+	while (TagFile.arena && TagFile.arena->lastIndex < n)
 	{
-		if (!scope->placeholder)
-		{
-			if (kindIndex != KIND_GHOST_INDEX)
-			{
-				sep = scopeSeparatorFor (lang, kindIndex, scope->kindIndex);
-				v = vStringNewInit (sep);
-				stringListAdd (queue, v);
-			}
-			/* TODO: scope field of SCOPE can be used for optimization. */
-			v = vStringNewInit (scope->name);
-			stringListAdd (queue, v);
-			kindIndex = scope->kindIndex;
-			lang = scope->langType;
-		}
-		scope =  getEntryInCorkQueue (scope->extensionFields.scopeIndex);
+		corkArenaChunk *next = TagFile.arena->next;
+
+		eFree (TagFile.arena);
+		TagFile.arena = next;
+	}
+	if (TagFile.arena == NULL)
+		TagFile.arenaLast = NULL;
+}
+
+extern const char *copyStringToCorkEntry (int index, const char *str)
+{
+	Assert (TagFile.cork);
+	return corkArenaStrdup ((unsigned int) index, str);
+}
+
+static const char *internScopeName (hashTable *table, const char *name)
+{
+	char *interned = hashTableGetItem (table, name);
+
+	if (interned == NULL)
+	{
+		interned = eStrdup (name);
+		hashTablePutItem (table, interned, interned);
+		if (table == TagFile.scopeNames)
+			TagFile.scopeNameCount++;
+	}
+	return interned;
+}
+
+static const char *getFullQualifiedScopeNameOfEntry (unsigned int n);
+
+/*  Return the entry N, or the nearest of its scopes not being a
+ *  placeholder; NULL if there is none in the queue. LAST is set to the
+ *  last entry visited.
+ */
+static const tagEntryInfo *skipPlaceholders (unsigned int *n,
+											 const tagEntryInfo **last)
+{
+	tagEntryInfo *e;
+
+	while ((e = getEntryInCorkQueue (*n)) && e->placeholder)
+	{
+		*last = e;
+		*n = e->extensionFields.scopeIndex;
 	}
+	return e;
+}
+
+/*  Build the full qualified name of E, being the entry N, as the scope
+ *  name of the entries in it.
+ */
+static const char *buildFullQualifiedScopeName (const tagEntryInfo *const e)
+{
+	const tagEntryInfo *last = e;
+	unsigned int p = e->extensionFields.scopeIndex;
+	const tagEntryInfo *parent = skipPlaceholders (&p, &last);
+	vString *n = vStringNew ();
+	const char *r;
 
-	n = vStringNew ();
-	while ((c = stringListCount (queue)) > 0)
+	if (parent)
+	{
+		vStringCatS (n, getFullQualifiedScopeNameOfEntry (p));
+		vStringCatS (n, scopeSeparatorFor (e->langType, e->kindIndex,
+										   parent->kindIndex));
+	}
+	else if (p != CORK_NIL && last->extensionFields.scopeName)
 	{
-		v = stringListLast (queue);
-		vStringCat (n, v);
-		vStringDelete (v);
-		stringListRemoveLast (queue);
+		/* The parent is flushed; flushCorkQueue () kept its full
+		   qualified name in LAST. */
+		vStringCatS (n, last->extensionFields.scopeName);
+		vStringCatS (n, scopeSeparatorFor (e->langType, e->kindIndex,
+										   last->extensionFields.scopeKindIndex));
 	}
-	stringListDelete (queue);
+	vStringCatS (n, e->name);
+
+	r = internScopeName (TagFile.scopeNames, vStringValue (n));
+	vStringDelete (n);
+	return r;
+}
+
+/*  The full qualified name of the entry N, not being a placeholder, is
+ *  built once from that of its scope. So filling the scope names of the
+ *  entries does not walk up the scopes again and again.
+ */
+static const char *getFullQualifiedScopeNameOfEntry (unsigned int n)
+{
+	const char **memo = TagFile.corkQueue.qualifiedNames
+		+ (n - TagFile.corkQueue.flushed);
+
+	if (*memo == NULL)
+		*memo = buildFullQualifiedScopeName (getEntryInCorkQueue (n));
+	return *memo;
+}
+
+/*  The scope name of the entries whose scopeIndex is N.
+ */
+static const char *getFullQualifiedScopeNameFromCorkQueue (unsigned int n)
+{
+	const tagEntryInfo *last = NULL;
 
-	return vStringDeleteUnwrap (n);
+	if (skipPlaceholders (&n, &last))
+		return getFullQualifiedScopeNameOfEntry (n);
+	else if (last && n != CORK_NIL && last->extensionFields.scopeName)
+		return last->extensionFields.scopeName;	/* flushed */
+	return internScopeName (TagFile.scopeNames, "");
 }
 
 extern void getTagScopeInformation (tagEntryInfo *const tag,
@@ -809,15 +2135,16 @@ extern void getTagScopeInformation (tagEntryInfo *const tag,
 	    && TagFile.corkQueue.count > 0)
 	{
 		const tagEntryInfo * scope;
-		char *full_qualified_scope_name;
 
+		/* NULL if the scope is flushed from the queue before TAG is made */
 		scope = getEntryInCorkQueue (tag->extensionFields.scopeIndex);
-		full_qualified_scope_name = getFullQualifiedScopeNameFromCorkQueue(scope);
-		Assert (full_qualified_scope_name);
-
-		/* Make the information reusable to generate full qualified entry, and xformat output*/
-		tag->extensionFields.scopeKindIndex = scope->kindIndex;
-		tag->extensionFields.scopeName = full_qualified_scope_name;
+		if (scope)
+		{
+			/* Make the information reusable to generate full qualified entry, and xformat output*/
+			tag->extensionFields.scopeKindIndex = scope->kindIndex;
+			tag->extensionFields.scopeName
+				= getFullQualifiedScopeNameFromCorkQueue (tag->extensionFields.scopeIndex);
+		}
 	}
 
 	if (tag->extensionFields.scopeKindIndex != KIND_GHOST_INDEX  &&
@@ -835,30 +2162,15 @@ extern void getTagScopeInformation (tagEntryInfo *const tag,
 }
 
 
-static int   makePatternStringCommon (const tagEntryInfo *const tag,
-				      int (* putc_func) (char , void *),
-				      int (* puts_func) (const char* , void *),
-				      void *output)
+/*  Write the pattern of TAG to PATTERN. */
+static void buildPatternString (const tagEntryInfo *const tag, vString *const pattern)
 {
-	int length = 0;
-
 	char *line;
 	int searchChar;
 	const char *terminator;
 	bool  omitted;
 	size_t line_len;
 
-	bool making_cache = false;
-	int (* puts_o_func)(const char* , void *);
-	void * o_output;
-
-	static vString *cached_pattern;
-	static MIOPos   cached_location;
-	if (TagFile.patternCacheValid
-	    && (! tag->truncateLineAfterTag)
-	    && (memcmp (&tag->filePosition, &cached_location, sizeof(MIOPos)) == 0))
-		return puts_func (vStringValue (cached_pattern), output);
-
 	line = readLineFromBypass (TagFile.vLine, tag->filePosition, NULL);
 	if (line == NULL)
 		error (FATAL, "could not read tag line from %s at line %lu", getInputFileName (),tag->lineNumber);
@@ -869,40 +2181,49 @@ static int   makePatternStringCommon (const tagEntryInfo *const tag,
 	searchChar = Option.backward ? '?' : '/';
 	terminator = (bool) (line [line_len - 1] == '\n') ? "$": "";
 
-	if (!tag->truncateLineAfterTag)
-	{
-		making_cache = true;
-		cached_pattern = vStringNewOrClearWithAutoRelease (cached_pattern);
+	vStringPut (pattern, searchChar);
+	if ((tag->boundaryInfo & BOUNDARY_START) == 0)
+		vStringPut (pattern, '^');
+	appendInputLine (vstring_putc, line, pattern, &omitted);
+	vStringCatS (pattern, omitted? "": terminator);
+	vStringPut (pattern, searchChar);
+}
 
-		puts_o_func = puts_func;
-		o_output    = output;
-		putc_func   = vstring_putc;
-		puts_func   = vstring_puts;
-		output      = cached_pattern;
-	}
+/*  The tags at the same position share the pattern returned, which
+ *  stays valid until the pattern of a tag at another position is made,
+ *  so that the pattern of a line with several tags is built once. The
+ *  pattern of a tag whose line is truncated after it is made in BUFFER.
+ */
+extern const char *getPatternString (const tagEntryInfo *const tag, vString *const buffer)
+{
+	static vString *cached_pattern;
+	static MIOPos   cached_location;
 
-	length += putc_func(searchChar, output);
-	if ((tag->boundaryInfo & BOUNDARY_START) == 0)
-		length += putc_func('^', output);
-	length += appendInputLine (putc_func, line, output, &omitted);
-	length += puts_func (omitted? "": terminator, output);
-	length += putc_func (searchChar, output);
+	if (tag->truncateLineAfterTag)
+	{
+		vStringClear (buffer);
+		buildPatternString (tag, buffer);
+		return vStringValue (buffer);
+	}
 
-	if (making_cache)
+	if (! TagFile.patternCacheValid
+	    || memcmp (&tag->filePosition, &cached_location, sizeof(MIOPos)) != 0)
 	{
-		puts_o_func (vStringValue (cached_pattern), o_output);
+		cached_pattern = vStringNewOrClearWithAutoRelease (cached_pattern);
+		buildPatternString (tag, cached_pattern);
 		cached_location = tag->filePosition;
 		TagFile.patternCacheValid = true;
 	}
-
-	return length;
+	return vStringValue (cached_pattern);
 }
 
 extern char* makePatternString (const tagEntryInfo *const tag)
 {
-	vString* pattern = vStringNew ();
-	makePatternStringCommon (tag, vstring_putc, vstring_puts, pattern);
-	return vStringDeleteUnwrap (pattern);
+	vString *buffer = vStringNew ();
+	char *pattern = eStrdup (getPatternString (tag, buffer));
+
+	vStringDelete (buffer);
+	return pattern;
 }
 
 static tagField * tagFieldNew(fieldType ftype, const char *value, bool valueOwner)
@@ -951,6 +2272,30 @@ extern void attachParserField (tagEntryInfo *const tag, fieldType ftype, const c
 	attachParserFieldGeneric (tag, ftype, value, false);
 }
 
+/*  The parser fields of an entry in the cork queue, and their values, are
+ *  in the arena of the queue: the fields past the preallocated ones are
+ *  not allocated one by one, nor put in the trash box of the parser.
+ */
+static void attachParserFieldToSlot (tagEntryInfo *const slot, unsigned int index,
+									 fieldType ftype, const char *value)
+{
+	tagField *f;
+
+	if (slot->usedParserFields < PRE_ALLOCATED_PARSER_FIELDS)
+		f = slot->parserFields + slot->usedParserFields;
+	else
+	{
+		if (slot->parserFieldsDynamic == NULL)
+			slot->parserFieldsDynamic = ptrArrayNew (NULL);
+		f = corkArenaAlloc (index, sizeof (tagField));
+		ptrArrayAdd (slot->parserFieldsDynamic, f);
+	}
+	f->ftype = ftype;
+	f->value = value;
+	f->valueOwner = false;
+	slot->usedParserFields++;
+}
+
 extern void attachParserFieldToCorkEntry (int index,
 					 fieldType ftype,
 					 const char *value)
@@ -964,8 +2309,8 @@ extern void attachParserFieldToCorkEntry (int index,
 	tag = getEntryInCorkQueue(index);
 	Assert (tag != NULL);
 
-	v = eStrdup (value);
-	attachParserFieldGeneric (tag, ftype, v, true);
+	v = corkArenaStrdup ((unsigned int) index, value);
+	attachParserFieldToSlot (tag, (unsigned int) index, ftype, v);
 }
 
 extern const tagField* getParserField (const tagEntryInfo * tag, int index)
@@ -982,7 +2327,8 @@ extern const tagField* getParserField (const tagEntryInfo * tag, int index)
 	}
 }
 
-static void copyParserFields (const tagEntryInfo *const tag, tagEntryInfo* slot)
+static void copyParserFields (const tagEntryInfo *const tag, tagEntryInfo* slot,
+							  unsigned int index)
 {
 	unsigned int i;
 	const char* value;
@@ -994,62 +2340,59 @@ static void copyParserFields (const tagEntryInfo *const tag, tagEntryInfo* slot)
 
 		value = f->value;
 		if (value)
-			value = eStrdup (value);
+			value = corkArenaStrdup (index, value);
 
-		attachParserFieldGeneric (slot,
-								  f->ftype,
-								  value,
-								  true);
+		attachParserFieldToSlot (slot, index, f->ftype, value);
 	}
 
 }
 
-static void recordTagEntryInQueue (const tagEntryInfo *const tag, tagEntryInfo* slot)
+static void recordTagEntryInQueue (const tagEntryInfo *const tag, tagEntryInfo* slot,
+								  unsigned int index)
 {
 	*slot = *tag;
 
 	if (slot->pattern)
-		slot->pattern = eStrdup (slot->pattern);
+		slot->pattern = corkArenaStrdup (index, slot->pattern);
 
-	slot->inputFileName = eStrdup (slot->inputFileName);
-	slot->name = eStrdup (slot->name);
+	slot->inputFileName = corkArenaStrdup (index, slot->inputFileName);
+	slot->name = corkArenaStrdup (index, slot->name);
 	if (slot->extensionFields.access)
-		slot->extensionFields.access = eStrdup (slot->extensionFields.access);
+		slot->extensionFields.access = corkArenaStrdup (index, slot->extensionFields.access);
 	if (slot->extensionFields.fileScope)
-		slot->extensionFields.fileScope = eStrdup (slot->extensionFields.fileScope);
+		slot->extensionFields.fileScope = corkArenaStrdup (index, slot->extensionFields.fileScope);
 	if (slot->extensionFields.implementation)
-		slot->extensionFields.implementation = eStrdup (slot->extensionFields.implementation);
+		slot->extensionFields.implementation = corkArenaStrdup (index, slot->extensionFields.implementation);
 	if (slot->extensionFields.inheritance)
-		slot->extensionFields.inheritance = eStrdup (slot->extensionFields.inheritance);
+		slot->extensionFields.inheritance = corkArenaStrdup (index, slot->extensionFields.inheritance);
 	if (slot->extensionFields.scopeName)
-		slot->extensionFields.scopeName = eStrdup (slot->extensionFields.scopeName);
+		slot->extensionFields.scopeName = internScopeName (TagFile.scopeNames,
+														   slot->extensionFields.scopeName);
 	if (slot->extensionFields.signature)
-		slot->extensionFields.signature = eStrdup (slot->extensionFields.signature);
+		slot->extensionFields.signature = corkArenaStrdup (index, slot->extensionFields.signature);
 	if (slot->extensionFields.typeRef[0])
-		slot->extensionFields.typeRef[0] = eStrdup (slot->extensionFields.typeRef[0]);
+		slot->extensionFields.typeRef[0] = corkArenaStrdup (index, slot->extensionFields.typeRef[0]);
 	if (slot->extensionFields.typeRef[1])
-		slot->extensionFields.typeRef[1] = eStrdup (slot->extensionFields.typeRef[1]);
+		slot->extensionFields.typeRef[1] = corkArenaStrdup (index, slot->extensionFields.typeRef[1]);
 #ifdef HAVE_LIBXML
 	if (slot->extensionFields.xpath)
-		slot->extensionFields.xpath = eStrdup (slot->extensionFields.xpath);
+		slot->extensionFields.xpath = corkArenaStrdup (index, slot->extensionFields.xpath);
 #endif
 
 	if (slot->extraDynamic)
 	{
 		int n = countXtags () - XTAG_COUNT;
-		slot->extraDynamic = xCalloc ((n / 8) + 1, uint8_t);
+		slot->extraDynamic = corkArenaAlloc (index, (n / 8) + 1);
 		memcpy (slot->extraDynamic, tag->extraDynamic, (n / 8) + 1);
 	}
 
 	if (slot->sourceFileName)
-		slot->sourceFileName = eStrdup (slot->sourceFileName);
+		slot->sourceFileName = corkArenaStrdup (index, slot->sourceFileName);
 
 
 	slot->usedParserFields = 0;
 	slot->parserFieldsDynamic = NULL;
-	copyParserFields (tag, slot);
-	if (slot->parserFieldsDynamic)
-		PARSER_TRASH_BOX_TAKE_BACK(slot->parserFieldsDynamic);
+	copyParserFields (tag, slot, index);
 }
 
 static void clearParserFields (tagEntryInfo *const tag)
@@ -1079,38 +2422,7 @@ static void clearParserFields (tagEntryInfo *const tag)
 
 static void clearTagEntryInQueue (tagEntryInfo* slot)
 {
-	if (slot->pattern)
-		eFree ((char *)slot->pattern);
-	eFree ((char *)slot->inputFileName);
-	eFree ((char *)slot->name);
-
-	if (slot->extensionFields.access)
-		eFree ((char *)slot->extensionFields.access);
-	if (slot->extensionFields.fileScope)
-		eFree ((char *)slot->extensionFields.fileScope);
-	if (slot->extensionFields.implementation)
-		eFree ((char *)slot->extensionFields.implementation);
-	if (slot->extensionFields.inheritance)
-		eFree ((char *)slot->extensionFields.inheritance);
-	if (slot->extensionFields.scopeName)
-		eFree ((char *)slot->extensionFields.scopeName);
-	if (slot->extensionFields.signature)
-		eFree ((char *)slot->extensionFields.signature);
-	if (slot->extensionFields.typeRef[0])
-		eFree ((char *)slot->extensionFields.typeRef[0]);
-	if (slot->extensionFields.typeRef[1])
-		eFree ((char *)slot->extensionFields.typeRef[1]);
-#ifdef HAVE_LIBXML
-	if (slot->extensionFields.xpath)
-		eFree ((char *)slot->extensionFields.xpath);
-#endif
-
-	if (slot->extraDynamic)
-		eFree (slot->extraDynamic);
-
-	if (slot->sourceFileName)
-		eFree ((char *)slot->sourceFileName);
-
+	/* The strings are in the arena of the queue. */
 	clearParserFields (slot);
 }
 
@@ -1120,24 +2432,28 @@ static unsigned int queueTagEntry(const tagEntryInfo *const tag)
 	void *tmp;
 	tagEntryInfo * slot;
 
-	if (! (TagFile.corkQueue.count < TagFile.corkQueue.length))
+	if (! (TagFile.corkQueue.count - TagFile.corkQueue.flushed < TagFile.corkQueue.length))
 	{
 		if (!TagFile.corkQueue.length)
 			TagFile.corkQueue.length = 1;
 
 		tmp = eRealloc (TagFile.corkQueue.queue,
 				sizeof (*TagFile.corkQueue.queue) * TagFile.corkQueue.length * 2);
+		TagFile.corkQueue.queue = tmp;
+		TagFile.corkQueue.qualifiedNames
+			= xRealloc (TagFile.corkQueue.qualifiedNames,
+						TagFile.corkQueue.length * 2, const char *);
 
 		TagFile.corkQueue.length *= 2;
-		TagFile.corkQueue.queue = tmp;
 	}
 
 	i = TagFile.corkQueue.count;
 	TagFile.corkQueue.count++;
 
 
-	slot = TagFile.corkQueue.queue + i;
-	recordTagEntryInQueue (tag, slot);
+	slot = TagFile.corkQueue.queue + (i - TagFile.corkQueue.flushed);
+	recordTagEntryInQueue (tag, slot, i);
+	TagFile.corkQueue.qualifiedNames [i - TagFile.corkQueue.flushed] = NULL;
 
 	return i;
 }
@@ -1146,28 +2462,113 @@ static unsigned int queueTagEntry(const tagEntryInfo *const tag)
 extern void setupWriter (void)
 {
 	writerSetup (TagFile.mio);
+
+	if (TagFile.outputCount > 0 && TagFile.fragmentDepth == 0)
+	{
+		tagOutputSaved saved;
+		unsigned int i;
+
+		for (i = 0; i < TagFile.outputCount; i++)
+		{
+			enterTagOutput (TagFile.outputs + i, &saved);
+			writerSetup (TagFile.outputs [i].mio);
+			leaveTagOutput (&saved);
+		}
+	}
 }
 
 extern bool teardownWriter (const char *filename)
 {
-	return writerTeardown (TagFile.mio, filename);
+	bool resized = writerTeardown (TagFile.mio, filename);
+
+#ifdef EXTERNAL_SORT
+	if (TagFile.sorter)
+		flushTagFileSorter ();
+#endif
+
+	if (TagFile.outputCount > 0 && TagFile.fragmentDepth == 0)
+	{
+		tagOutputSaved saved;
+		unsigned int i;
+
+		for (i = 0; i < TagFile.outputCount; i++)
+		{
+			enterTagOutput (TagFile.outputs + i, &saved);
+			writerTeardown (TagFile.outputs [i].mio, filename);
+			leaveTagOutput (&saved);
+			flushTagOutput (TagFile.outputs + i);
+		}
+	}
+	return resized;
+}
+
+static bool isTagOfLanguageWritable (const langType lang, int kindIndex, int roleIndex)
+{
+	if (kindIndex == KIND_FILE_INDEX)
+	{
+		if (! getInputLanguageFileKind ()->enabled)
+			return false;
+	}
+	else if (! isLanguageKindEnabled (lang, kindIndex))
+		return false;
+	if (roleIndex != ROLE_INDEX_DEFINITION
+	    && ! isXtagEnabled (XTAG_REFERENCE_TAGS))
+		return false;
+	return true;
+}
+
+extern bool isInputTagWritable (int kindIndex, int roleIndex)
+{
+	langType lang = getInputLanguage ();
+
+	if (kindIndex != KIND_FILE_INDEX
+	    && roleIndex != ROLE_INDEX_DEFINITION
+	    && ! isLanguageRoleEnabled (lang, kindIndex, roleIndex))
+		return false;
+	return isTagOfLanguageWritable (lang, kindIndex, roleIndex);
+}
+
+/* With --generated-input=shallow, only the tags of top-level
+ * declarations, which have no scope, are written. */
+static bool isTagDroppedAsShallow (const tagEntryInfo *const tag)
+{
+	return (isInputFileShallow ()
+			&& (tag->extensionFields.scopeIndex != CORK_NIL
+				|| tag->extensionFields.scopeName != NULL));
+}
+
+/*  Write TAG, written to the tag file, to the other ones. */
+static void writeTagEntryToOutputs (const tagEntryInfo *const tag, bool fqTagCache)
+{
+	tagOutputSaved saved;
+	unsigned int i;
+
+	for (i = 0; i < TagFile.outputCount; i++)
+	{
+		tagOutput *const out = TagFile.outputs + i;
+
+		enterTagOutput (out, &saved);
+		if (fqTagCache)
+			writerBuildFqTagCache ((tagEntryInfo *const)tag);
+		writerWriteTag (out->mio, tag);
+		leaveTagOutput (&saved);
+		abort_if_ferror (out->mio);
+		out->numTags++;
+	}
 }
 
 static void writeTagEntry (const tagEntryInfo *const tag)
 {
+	bool fqTagCache = false;
 	int length = 0;
+	double start = 0.0;
 
 	if (tag->placeholder)
 		return;
-	if (tag->kindIndex == KIND_FILE_INDEX)
-	{
-		if (! getInputLanguageFileKind ()->enabled)
-			return;
-	}
-	else if (! isLanguageKindEnabled(tag->langType, tag->kindIndex))
+	if (! isTagOfLanguageWritable (tag->langType, tag->kindIndex,
+								   tag->extensionFields.roleIndex))
 		return;
-	if (tag->extensionFields.roleIndex != ROLE_INDEX_DEFINITION
-	    && ! isXtagEnabled (XTAG_REFERENCE_TAGS))
+	if (isTagDroppedAsShallow (tag))
 		return;
 
 	DebugStatement ( debugEntry (tag); )
@@ -1178,9 +2579,36 @@ static void writeTagEntry (const tagEntryInfo *const tag)
 	{
 		/* const is discarded to update the cache field of TAG. */
 		writerBuildFqTagCache ( (tagEntryInfo *const)tag);
+		fqTagCache = true;
+	}
+
+	if (Option.printTotals == TOTALS_KINDS)
+		start = getTotalsClock ();
+
+	beginTotalsPhase (PHASE_WRITING);
+	if (isDeduplicatingTags ())
+	{
+		const bool written = writeTagEntryOnce (tag, &length);
+
+		endTotalsPhase ();
+		if (! written)
+			return;
+	}
+	else
+	{
+		length = writerWriteTag (TagFile.mio, tag);
+		endTotalsPhase ();
 	}
 
-	length = writerWriteTag (TagFile.mio, tag);
+	if (Option.printTotals == TOTALS_KINDS)
+		addKindTotals (tag, (size_t) length, getTotalsClock () - start);
+
+	if (TagFile.outputCount > 0 && TagFile.fragmentDepth == 0)
+	{
+		beginTotalsPhase (PHASE_WRITING);
+		writeTagEntryToOutputs (tag, fqTagCache);
+		endTotalsPhase ();
+	}
 
 	++TagFile.numTags.added;
 	rememberMaxLengths (strlen (tag->name), (size_t) length);
@@ -1203,6 +2631,20 @@ extern bool writePseudoTag (const ptagDesc *desc,
 
 	abort_if_ferror (TagFile.mio);
 
+	if (TagFile.outputCount > 0 && TagFile.fragmentDepth == 0)
+	{
+		tagOutputSaved saved;
+		unsigned int i;
+
+		for (i = 0; i < TagFile.outputCount; i++)
+		{
+			enterTagOutput (TagFile.outputs + i, &saved);
+			writerWritePtag (TagFile.outputs [i].mio, desc, fileName,
+							 pattern, parserName);
+			leaveTagOutput (&saved);
+		}
+	}
+
 	++TagFile.numTags.added;
 	rememberMaxLengths (strlen (desc->name), (size_t) length);
 
@@ -1216,46 +2658,168 @@ extern void corkTagFile(void)
 	{
 		  TagFile.corkQueue.length = 1;
 		  TagFile.corkQueue.count = 1;
+		  TagFile.corkQueue.flushed = 0;
 		  TagFile.corkQueue.queue = eMalloc (sizeof (*TagFile.corkQueue.queue));
 		  memset (TagFile.corkQueue.queue, 0, sizeof (*TagFile.corkQueue.queue));
+		  TagFile.corkQueue.qualifiedNames = xCalloc (1, const char *);
+		  TagFile.scopeNames = hashTableNew (SCOPE_NAME_TABLE_SIZE,
+											 hashCstrhash, hashCstreq,
+											 eFree, NULL);
+		  TagFile.scopeNameCount = 0;
 	}
 }
 
-extern void uncorkTagFile(void)
+static void writeTagEntryInQueue (tagEntryInfo *const tag)
+{
+	writeTagEntry (tag);
+	if (doesInputLanguageRequestAutomaticFQTag ()
+	    && isXtagEnabled (XTAG_QUALIFIED_TAGS)
+	    && (tag->extensionFields.scopeKindIndex != KIND_GHOST_INDEX)
+	    && tag->extensionFields.scopeName
+	    && tag->extensionFields.scopeIndex)
+		makeQualifiedTagEntry (tag);
+}
+
+static void releaseCorkQueue (bool write)
 {
 	unsigned int i;
+	const unsigned int count = TagFile.corkQueue.count - TagFile.corkQueue.flushed;
 
 	TagFile.cork--;
 
 	if (TagFile.cork > 0)
 		return ;
 
-	for (i = 1; i < TagFile.corkQueue.count; i++)
-	{
-		tagEntryInfo *tag = TagFile.corkQueue.queue + i;
-		writeTagEntry (tag);
-		if (doesInputLanguageRequestAutomaticFQTag ()
-		    && isXtagEnabled (XTAG_QUALIFIED_TAGS)
-		    && (tag->extensionFields.scopeKindIndex != KIND_GHOST_INDEX)
-		    && tag->extensionFields.scopeName
-		    && tag->extensionFields.scopeIndex)
-			makeQualifiedTagEntry (tag);
-	}
-	for (i = 1; i < TagFile.corkQueue.count; i++)
+	beginTraceSpan (write? "uncork": "discard", NULL, NULL);
+	if (write)
+		for (i = 1; i < count; i++)
+			writeTagEntryInQueue (TagFile.corkQueue.queue + i);
+	for (i = 1; i < count; i++)
 		clearTagEntryInQueue (TagFile.corkQueue.queue + i);
 
 	memset (TagFile.corkQueue.queue, 0,
-		sizeof (*TagFile.corkQueue.queue) * TagFile.corkQueue.count);
+		sizeof (*TagFile.corkQueue.queue) * count);
 	TagFile.corkQueue.count = 0;
+	TagFile.corkQueue.flushed = 0;
+	corkArenaRelease (UINT_MAX);
 	eFree (TagFile.corkQueue.queue);
 	TagFile.corkQueue.queue = NULL;
+	eFree (TagFile.corkQueue.qualifiedNames);
+	TagFile.corkQueue.qualifiedNames = NULL;
 	TagFile.corkQueue.length = 0;
+	hashTableDelete (TagFile.scopeNames);
+	TagFile.scopeNames = NULL;
+	endTraceSpan ();
+}
+
+extern void uncorkTagFile(void)
+{
+	releaseCorkQueue (true);
+}
+
+/*  Like uncorkTagFile (), but forget the entries of the cork queue not
+ *  written yet instead of writing them: the parser failed, and the tag
+ *  file is to be truncated before the input is scanned again.
+ */
+extern void discardCorkedTags (void)
+{
+	releaseCorkQueue (false);
+}
+
+/*  Intern the scope names of the COUNT entries left in the cork queue
+ *  into a new table, and drop those of the flushed entries.
+ */
+static void renewScopeNames (unsigned int count)
+{
+	hashTable *table = hashTableNew (SCOPE_NAME_TABLE_SIZE,
+									 hashCstrhash, hashCstreq,
+									 eFree, NULL);
+	unsigned int i;
+
+	for (i = 1; i <= count; i++)
+	{
+		tagEntryInfo *tag = TagFile.corkQueue.queue + i;
+		const char **memo = TagFile.corkQueue.qualifiedNames + i;
+
+		if (tag->extensionFields.scopeName)
+			tag->extensionFields.scopeName
+				= internScopeName (table, tag->extensionFields.scopeName);
+		if (*memo)
+			*memo = internScopeName (table, *memo);
+	}
+
+	hashTableDelete (TagFile.scopeNames);
+	TagFile.scopeNames = table;
+	TagFile.scopeNameCount = hashTableCountItem (table);
+}
+
+/*  Write the entries of the cork queue before N, and forget them.
+ *  A parser calls this where no later entry will refer to them, e.g. at
+ *  the end of a top-level scope, so that the queue does not hold all the
+ *  tags of a large file until uncorkTagFile ().
+ *
+ *  The indices of the entries left do not change. The scope names of
+ *  those whose scope is flushed are filled before it is forgotten;
+ *  getEntryInCorkQueue () returns NULL for a flushed entry.
+ *
+ *  Nothing is done when the queue is corked more than once: the other
+ *  user may still refer to the entries.
+ */
+extern void flushCorkQueue (unsigned int n)
+{
+	const unsigned int flushed = TagFile.corkQueue.flushed;
+	unsigned int i, count;
+
+	if (TagFile.cork != 1)
+		return;
+	if (n > TagFile.corkQueue.count)
+		n = TagFile.corkQueue.count;
+	if (n <= flushed + 1)
+		return;
+
+	for (i = n; i < TagFile.corkQueue.count; i++)
+	{
+		tagEntryInfo *tag = TagFile.corkQueue.queue + (i - flushed);
+
+		if (tag->extensionFields.scopeIndex > CORK_NIL
+		    && (unsigned int) tag->extensionFields.scopeIndex < n)
+			getTagScopeInformation (tag, NULL, NULL);
+	}
+
+	/* The qualified tags made for the entries are written, not queued. */
+	TagFile.cork = 0;
+	for (i = flushed + 1; i < n; i++)
+		writeTagEntryInQueue (TagFile.corkQueue.queue + (i - flushed));
+	TagFile.cork = 1;
+	for (i = flushed + 1; i < n; i++)
+		clearTagEntryInQueue (TagFile.corkQueue.queue + (i - flushed));
+
+	/* In interactive mode, the client gets the tags of the scopes done
+	   with before the whole input is parsed. */
+	if (Option.interactive && TagsToStdout)
+		mio_flush (TagFile.mio);
+
+	/* The entries from N follow the nil entry. */
+	count = TagFile.corkQueue.count - n;
+	memmove (TagFile.corkQueue.queue + 1, TagFile.corkQueue.queue + (n - flushed),
+			 sizeof (*TagFile.corkQueue.queue) * count);
+	memset (TagFile.corkQueue.queue + 1 + count, 0,
+			sizeof (*TagFile.corkQueue.queue) * (n - flushed - 1));
+	memmove (TagFile.corkQueue.qualifiedNames + 1,
+			 TagFile.corkQueue.qualifiedNames + (n - flushed),
+			 sizeof (*TagFile.corkQueue.qualifiedNames) * count);
+	TagFile.corkQueue.flushed = n - 1;
+	corkArenaRelease (n);
+
+	if (TagFile.scopeNameCount >= SCOPE_NAME_TABLE_SIZE)
+		renewScopeNames (count);
 }
 
 extern tagEntryInfo *getEntryInCorkQueue   (unsigned int n)
 {
-	if ((CORK_NIL < n) && (n < TagFile.corkQueue.count))
-		return TagFile.corkQueue.queue + n;
+	if ((TagFile.corkQueue.flushed < n) && (CORK_NIL < n)
+		&& (n < TagFile.corkQueue.count))
+		return TagFile.corkQueue.queue + (n - TagFile.corkQueue.flushed);
 	else
 		return NULL;
 }
@@ -1274,24 +2838,27 @@ extern size_t        countEntryInCorkQueue (void)
 
 static void makeTagEntriesForSubwords (tagEntryInfo *const subtag)
 {
-	stringList *list;
+	const char *subword = subtag->name;
+	size_t length;
 
 	subtag->extensionFields.scopeIndex = CORK_NIL;
 	markTagExtraBit (subtag, XTAG_SUBWORD);
 
-	list = stringListNewBySplittingWordIntoSubwords(subtag->name);
-	for (unsigned int i = 0; i < stringListCount(list); i++)
+	/* The subwords are copied one after the other into one buffer: the
+	   entry is written, or queued with a copy of its name, before the
+	   next one. */
+	TagFile.subword = vStringNewOrClear (TagFile.subword);
+	while ((subword = nextSubword (subword, &length)) != NULL)
 	{
-		vString *subword = stringListItem (list, i);
-
-		subtag->name = vStringValue(subword);
+		vStringNCopyS (TagFile.subword, subword, length);
+		subtag->name = vStringValue (TagFile.subword);
 
 		if (TagFile.cork)
 			queueTagEntry (subtag);
 		else
 			writeTagEntry (subtag);
+		subword += length;
 	}
-	stringListDelete (list);
 }
 
 static char *trimPrefixedWhitespaces (const char *name)
@@ -1345,6 +2912,15 @@ extern int makeTagEntry (const tagEntryInfo *const tag_const)
 		goto out;
 	}
 
+	/* Without the cork queue nobody can refer to this entry later, so
+	 * an entry writeTagEntry () would drop is dropped here, before its
+	 * subwords are made. */
+	if (! TagFile.cork
+	    && (! isTagOfLanguageWritable (tag->langType, tag->kindIndex,
+									   tag->extensionFields.roleIndex)
+			|| isTagDroppedAsShallow (tag)))
+		goto out;
+
 	if (TagFile.cork)
 		r = queueTagEntry (tag);
 	else
@@ -1597,12 +3173,24 @@ extern void invalidatePatternCache(void)
 
 extern void tagFilePosition (MIOPos *p)
 {
+	unsigned int i;
+
 	mio_getpos (TagFile.mio, p);
+	if (isDeduplicatingTags ())
+		TagFile.seenLines.mark = TagFile.seenLines.count;
+	for (i = 0; i < TagFile.outputCount; i++)
+		TagFile.outputs [i].mark = mio_tell (TagFile.outputs [i].mio);
 }
 
 extern void setTagFilePosition (MIOPos *p)
 {
-	mio_setpos (TagFile.mio, p);
+	unsigned int i;
+
+	/* The lines written to a pipe stay there. */
+	if (mio_setpos (TagFile.mio, p) == 0 && isDeduplicatingTags ())
+		forgetSeenLinesAfterMark ();
+	for (i = 0; i < TagFile.outputCount; i++)
+		mio_seek (TagFile.outputs [i].mio, TagFile.outputs [i].mark, SEEK_SET);
 }
 
 extern const char* getTagFileDirectory (void)
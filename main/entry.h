@@ -36,12 +36,16 @@
 *   DATA DECLARATIONS
 */
 typedef struct sTagField {
-	fieldType  ftype;
 	const char* value;
+	fieldType  ftype;
 	bool valueOwner;			/* used only in parserFieldsDynamic */
 } tagField;
 
 /*  Information about the current tag candidate.
+ *
+ *  Every tag of a parser using the cork queue is kept in a copy of this
+ *  structure until the queue is flushed; the members are ordered so that
+ *  they pack without padding.
  */
 struct sTagEntryInfo {
 	unsigned int lineNumberEntry:1;  /* pattern or line number entry */
@@ -51,16 +55,16 @@ struct sTagEntryInfo {
 	unsigned int placeholder    :1;	 /* This is just a part of scope context.
 					    Put this entry to cork queue but
 					    don't print it to tags file. */
+	unsigned int boundaryInfo;    /* info about nested input stream */
 
 	unsigned long lineNumber;     /* line number of tag */
 	const char* pattern;	      /* pattern for locating input line
 				       * (may be NULL if not present) *//*  */
-	unsigned int boundaryInfo;    /* info about nested input stream */
 	MIOPos      filePosition;     /* file position of line containing tag */
 	langType langType;         /* language of input file */
+	int kindIndex;	      /* kind descriptor */
 	const char *inputFileName;   /* name of input file */
 	const char *name;             /* name of the tag */
-	int kindIndex;	      /* kind descriptor */
 	uint8_t extra[ ((XTAG_COUNT) / 8) + 1 ];
 	uint8_t *extraDynamic;		/* Dynamically allocated but freed by per parser TrashBox */
 
@@ -71,11 +75,11 @@ struct sTagEntryInfo {
 		const char* inheritance;
 
 		int         scopeKindIndex;
-		const char* scopeName;
 		int         scopeIndex;   /* cork queue entry for upper scope tag.
 					     This field is meaningful if the value
 					     is not CORK_NIL and scope[0]  and scope[1] are
 					     NULL. */
+		const char* scopeName;
 
 		const char* signature;
 
@@ -97,19 +101,31 @@ struct sTagEntryInfo {
 	   PRE_ALLOCATED_PARSER_FIELDS is defined and attached, parserFieldsDynamic
 	   is used. */
 	unsigned int usedParserFields;
+
+	/* The source* fields are used only when #line is found in input
+	   and --line-directive is given in ctags command line. */
+	langType sourceLangType;
+
 #define PRE_ALLOCATED_PARSER_FIELDS 5
 #define NO_PARSER_FIELD -1
 	tagField     parserFields [PRE_ALLOCATED_PARSER_FIELDS];
 	ptrArray *   parserFieldsDynamic;
 
-	/* Following source* fields are used only when #line is found
-	   in input and --line-directive is given in ctags command line. */
-	langType sourceLangType;
 	const char *sourceFileName;
 	unsigned long sourceLineNumberDifference;
 };
 
 
+/*  Summary of the tags a --jobs worker process wrote to its own
+ *  output for an input file; the parent appends the output to the tag
+ *  file with it.
+ */
+typedef struct sTagFileFragment {
+	long size;			/* bytes of valid output */
+	unsigned long numTags;
+	size_t maxLine, maxTag;
+} tagFileFragment;
+
 /*
 *   GLOBAL VARIABLES
 */
@@ -120,11 +136,30 @@ struct sTagEntryInfo {
 */
 extern void freeTagFileResources (void);
 extern const char *tagFileName (void);
+extern MIO *newTagFileOutput (const char *const name, const char *const mode);
 extern void openTagFile (void);
 extern void closeTagFile (const bool resize);
+extern void openTagFileFragment (MIO *mio);
+extern void closeTagFileFragment (tagFileFragment *fragment);
+extern void appendTagFileFragment (const char *output, const tagFileFragment *fragment);
+/* The input field of the tags of FILENAME, as the u-ctags and e-ctags
+   writers write it. */
+extern vString *makeInputField (const char *const fileName);
+extern void forgetTagsOfFile (const char *const fileName);
+/* Also those of the files under DIRNAME, which may be gone. */
+extern void forgetTagsUnderDirectory (const char *const dirName);
+#ifdef EXTERNAL_SORT
+extern void mergeTagFileShard (const char *const fileName);
+#endif
+extern void selectTagPartition (const char *const fileName, langType language);
 extern void  setupWriter (void);
 extern bool  teardownWriter (const char *inputFilename);
 extern int makeTagEntry (const tagEntryInfo *const tag);
+/* Whether a tag of KINDINDEX and ROLEINDEX in the current input
+ * language survives the kind, role and extra filters. A parser can ask
+ * this before building the signature, typeref and other fields of a
+ * tag that would be thrown away. */
+extern bool isInputTagWritable (int kindIndex, int roleIndex);
 extern void initTagEntry (tagEntryInfo *const e, const char *const name,
 			  int kindIndex);
 extern void initRefTagEntry (tagEntryInfo *const e, const char *const name,
@@ -154,11 +189,15 @@ extern void getTagScopeInformation (tagEntryInfo *const tag,
 
 /* Getting line associated with tag */
 extern char *readLineFromBypassAnyway (vString *const vLine, const tagEntryInfo *const tag,
-				   long *const pSeekValue);
+				   MIOOffset *const pSeekValue);
 
 /* Generating pattern associated tag, caller must do eFree for the returned value. */
 extern char* makePatternString (const tagEntryInfo *const tag);
 
+/* The same without a copy: valid until the pattern of a tag at another
+   position is made. BUFFER is used when the pattern cannot be shared. */
+extern const char *getPatternString (const tagEntryInfo *const tag, vString *const buffer);
+
 
 /* language is optional: can be NULL. */
 extern bool writePseudoTag (const ptagDesc *pdesc,
@@ -169,6 +208,8 @@ extern bool writePseudoTag (const ptagDesc *pdesc,
 #define CORK_NIL 0
 void          corkTagFile(void);
 void          uncorkTagFile(void);
+void          discardCorkedTags (void);
+void          flushCorkQueue (unsigned int n);
 tagEntryInfo *getEntryInCorkQueue   (unsigned int n);
 tagEntryInfo *getEntryOfNestingLevel (const NestingLevel *nl);
 size_t        countEntryInCorkQueue (void);
@@ -180,6 +221,9 @@ extern bool isTagExtraBitMarked (const tagEntryInfo *const tag, xtagType extra);
 
 extern void attachParserField (tagEntryInfo *const tag, fieldType ftype, const char* value);
 extern void attachParserFieldToCorkEntry (int index, fieldType ftype, const char* value);
+/* Return a copy of STR living as long as the entry INDEX of the cork
+   queue, for a string set to a field of the entry after it is made. */
+extern const char *copyStringToCorkEntry (int index, const char *str);
 extern const tagField* getParserField (const tagEntryInfo * tag, int index);
 
 #endif  /* CTAGS_MAIN_ENTRY_H */
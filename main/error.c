@@ -13,9 +13,13 @@
 
 #include "error.h"
 #include "options.h"
+#include "routines.h"
+#include "writer.h"
 
 #ifdef HAVE_JANSSON
+#include <stdlib.h>
 #include <jansson.h>
+#include "interactive.h"
 #endif
 
 #define selected(var,feature)	(((int)(var) & (int)(feature)) == (int)feature)
@@ -64,8 +68,16 @@ extern void error (const errorSelection selection,
 }
 
 #ifdef HAVE_JANSSON
+static MIO *jsonErrorOutput;
+
+extern void setJsonErrorOutput (MIO *mio)
+{
+	jsonErrorOutput = mio;
+}
+
+/* DATA is the "id" of the request being processed, or NULL. */
 bool jsonErrorPrinter (const errorSelection selection, const char *const format, va_list ap,
-					   void *data CTAGS_ATTR_UNUSED)
+					   void *data)
 {
 #define ERR_BUFFER_SIZE 4096
 	static char reason[ERR_BUFFER_SIZE];
@@ -76,6 +88,8 @@ bool jsonErrorPrinter (const errorSelection selection, const char *const format,
 	json_t *response = json_object ();
 	json_object_set_new (response, "_type", json_string ("error"));
 	json_object_set_new (response, "message", json_string (reason));
+	if (data)
+		json_object_set (response, "id", data);
 	if (selected (selection, WARNING))
 		json_object_set_new (response, "warning", json_true ());
 	if (selected (selection, FATAL))
@@ -85,8 +99,28 @@ bool jsonErrorPrinter (const errorSelection selection, const char *const format,
 		json_object_set_new (response, "errno", json_integer (errno));
 		json_object_set_new (response, "perror", json_string (strerror (errno)));
 	}
-	json_dumpf (response, stdout, JSON_PRESERVE_ORDER);
-	fprintf (stdout, "\n");
+	if (getTagWriterType () == WRITER_PROTOBUF)
+	{
+		char *buf = json_dumps (response, JSON_PRESERVE_ORDER);
+		MIO *mio = jsonErrorOutput? jsonErrorOutput: mio_new_fp (stdout, NULL);
+
+		writeProtobufJsonRecord (mio, buf);
+		if (mio != jsonErrorOutput)
+			mio_free (mio);
+		eFree (buf);
+	}
+	else if (jsonErrorOutput)
+	{
+		char *buf = json_dumps (response, JSON_PRESERVE_ORDER);
+		mio_puts (jsonErrorOutput, buf);
+		mio_putc (jsonErrorOutput, '\n');
+		eFree (buf);
+	}
+	else
+	{
+		json_dumpf (response, stdout, JSON_PRESERVE_ORDER);
+		fprintf (stdout, "\n");
+	}
 
 	json_decref (response);
 
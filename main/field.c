@@ -22,10 +22,12 @@
 #include "entry_private.h"
 #include "field.h"
 #include "kind.h"
+#include "main.h"
 #include "options.h"
 #include "read.h"
 #include "routines.h"
 #include "trashbox.h"
+#include "writer.h"
 
 
 typedef struct sFieldObject {
@@ -102,6 +104,7 @@ static fieldDefinition fieldDefinitionsFixed [] = {
 			  [WRITER_U_CTAGS] = renderFieldName,
 			  [WRITER_E_CTAGS] = renderFieldNameNoEscape,
 			  [WRITER_JSON]    = renderFieldNameNoEscape,
+			  [WRITER_PROTOBUF] = renderFieldNameNoEscape,
 			  ),
 	DEFINE_FIELD ('F', "input",    true,
 			   "input file",
@@ -109,6 +112,7 @@ static fieldDefinition fieldDefinitionsFixed [] = {
 			   [WRITER_U_CTAGS] = renderFieldInput,
 			   [WRITER_E_CTAGS] = renderFieldInputNoEscape,
 			   [WRITER_JSON]    = renderFieldInputNoEscape,
+			   [WRITER_PROTOBUF] = renderFieldInputNoEscape,
 		),
 	DEFINE_FIELD ('P', "pattern",  true,
 			   "pattern",
@@ -116,6 +120,8 @@ static fieldDefinition fieldDefinitionsFixed [] = {
 			   [WRITER_U_CTAGS] = renderFieldPatternCtags,
 			   [WRITER_XREF]    = renderFieldPatternCommon,
 			   [WRITER_JSON]    = renderFieldPatternCommon,
+			   [WRITER_BINARY]  = renderFieldPatternCommon,
+			   [WRITER_PROTOBUF] = renderFieldPatternCommon,
 		),
 };
 
@@ -173,7 +179,8 @@ static fieldDefinition fieldDefinitionsExuberant [] = {
 			   FIELDTYPE_STRING,
 			   [WRITER_U_CTAGS] = renderFieldScope,
 			   [WRITER_E_CTAGS] = renderFieldScopeNoEscape,
-			   [WRITER_JSON]    = renderFieldScopeNoEscape),
+			   [WRITER_JSON]    = renderFieldScopeNoEscape,
+			   [WRITER_PROTOBUF] = renderFieldScopeNoEscape),
 	DEFINE_FIELD_FULL ('t', "typeref",        true,
 			   "Type and name of a variable or typedef",
 			   isTyperefFieldAvailable,
@@ -204,7 +211,8 @@ static fieldDefinition fieldDefinitionsUniversal [] = {
 			      and is not for tags output. */
 			   [WRITER_U_CTAGS] = renderFieldScope,
 			   [WRITER_E_CTAGS] = renderFieldScopeNoEscape,
-			   [WRITER_JSON]    = renderFieldScopeNoEscape),
+			   [WRITER_JSON]    = renderFieldScopeNoEscape,
+			   [WRITER_PROTOBUF] = renderFieldScopeNoEscape),
 	DEFINE_FIELD_FULL ('E', "extras",   false,
 			   "Extra tag type information",
 			   isExtrasFieldAvailable,
@@ -231,6 +239,11 @@ static unsigned int       fieldObjectUsed = 0;
 static unsigned int       fieldObjectAllocated = 0;
 static fieldObject* fieldObjects = NULL;
 
+/* The enabled state of the fields, laid out flat for isFieldEnabled ()
+   which writers call for each field of each tag. It follows the one of
+   the definitions as enableField () and defineField () change it. */
+bool *FieldEnabledTable = NULL;
+
 extern void initFieldObjects (void)
 {
 	unsigned int i;
@@ -244,6 +257,8 @@ extern void initFieldObjects (void)
 	  + ARRAY_SIZE (fieldDefinitionsUniversal);
 	fieldObjects = xMalloc (fieldObjectAllocated, fieldObject);
 	DEFAULT_TRASH_BOX(&fieldObjects, eFreeIndirect);
+	FieldEnabledTable = xMalloc (fieldObjectAllocated, bool);
+	DEFAULT_TRASH_BOX(&FieldEnabledTable, eFreeIndirect);
 
 	fieldObjectUsed = 0;
 
@@ -297,6 +312,9 @@ extern void initFieldObjects (void)
 	fieldObjectUsed += ARRAY_SIZE (fieldDefinitionsUniversal);
 
 	Assert ( fieldObjectAllocated == fieldObjectUsed );
+
+	for (i = 0; i < fieldObjectUsed; i++)
+		FieldEnabledTable [i] = fieldObjects [i].def->enabled;
 }
 
 static fieldObject* getFieldObject(fieldType type)
@@ -374,11 +392,18 @@ static const char *renderAsIs (vString* b CTAGS_ATTR_UNUSED, const char *s)
 	return s;
 }
 
+/* S itself is returned if nothing in it is escaped. */
 static const char *renderEscapedString (const char *s,
 					const tagEntryInfo *const tag CTAGS_ATTR_UNUSED,
 					vString* b)
 {
-	vStringCatSWithEscaping (b, s);
+	const char *e = findCharToEscape (s);
+
+	if (*e == '\0')
+		return s;
+
+	vStringNCatSUnsafe (b, s, e - s);
+	vStringCatSWithEscaping (b, e);
 	return vStringValue (b);
 }
 
@@ -388,30 +413,22 @@ static const char *renderEscapedName (const char* s,
 {
 	const char* base = s;
 
-	for (; *s; s++)
-	{
-		int c = *s;
-		if ((c > 0x00 && c <= 0x1F) || c == 0x7F)
-		{
-			const kindDefinition *kdef = getTagKind (tag);
-			verbose ("Unexpected character (0 < *c && *c < 0x20) included in a tagEntryInfo: %s\n", base);
-			verbose ("File: %s, Line: %lu, Lang: %s, Kind: %c\n",
-				 tag->inputFileName, tag->lineNumber, getLanguageName(tag->langType), kdef->letter);
-			verbose ("Escape the character\n");
-			break;
-		}
-		else if (c == '\\')
-			break;
-		else
-			continue;
-	}
-
+	s = findCharToEscape (s);
 	if (*s == '\0')
 		return base;
 
-	vStringNCatS (b, base, s - base);
+	if (*s != '\\')
+	{
+		const kindDefinition *kdef = getTagKind (tag);
+		verbose ("Unexpected character (0 < *c && *c < 0x20) included in a tagEntryInfo: %s\n", base);
+		verbose ("File: %s, Line: %lu, Lang: %s, Kind: %c\n",
+			 tag->inputFileName, tag->lineNumber, getLanguageName(tag->langType), kdef->letter);
+		verbose ("Escape the character\n");
+	}
 
-	return renderEscapedString (s, tag, b);
+	vStringNCatSUnsafe (b, base, s - base);
+	vStringCatSWithEscaping (b, s);
+	return vStringValue (b);
 }
 
 static const char *renderFieldName (const tagEntryInfo *const tag, const char *value CTAGS_ATTR_UNUSED, vString* b,
@@ -503,6 +520,19 @@ static const char *renderFieldTyperef (const tagEntryInfo *const tag, const char
 }
 
 
+extern renderEscaped getFieldRenderer (writerType writer, fieldType type)
+{
+	fieldObject *fobj = fieldObjects + type;
+	renderEscaped rfn;
+
+	Assert (fobj->def->renderEscaped);
+
+	rfn = fobj->def->renderEscaped [writer];
+	if (rfn == NULL)
+		rfn = fobj->def->renderEscaped [WRITER_DEFAULT];
+	return rfn;
+}
+
 extern const char* renderFieldEscaped (writerType writer,
 				      fieldType type,
 				       const tagEntryInfo *tag,
@@ -535,6 +565,15 @@ extern const char* renderFieldEscaped (writerType writer,
 
 	if (!rejected)
 		rejected = &stub;
+
+	if (Option.printTotals == TOTALS_KINDS)
+	{
+		const double start = getTotalsClock ();
+		const char *s = rfn (tag, value, fobj->buffer, rejected);
+
+		addFieldTotals (type, s? strlen (s): 0, getTotalsClock () - start);
+		return s;
+	}
 	return rfn (tag, value, fobj->buffer, rejected);
 }
 
@@ -608,12 +647,22 @@ static const char *renderFieldLineNumber (const tagEntryInfo *const tag,
 					  bool *rejected CTAGS_ATTR_UNUSED)
 {
 	long ln = tag->lineNumber;
-	char buf[32] = {[0] = '\0'};
+	char buf[32];
+	char *p = buf + sizeof (buf);
+	unsigned long u;
 
 	if (Option.lineDirectives && (tag->sourceLineNumberDifference != 0))
 		ln += tag->sourceLineNumberDifference;
-	snprintf (buf, sizeof(buf), "%ld", ln);
-	vStringCatS (b, buf);
+
+	/* Without snprintf (), which costs more than the rest of the
+	   field for the xref writer. */
+	u = (ln < 0)? - (unsigned long) ln: (unsigned long) ln;
+	do
+		*--p = (char) ('0' + u % 10);
+	while ((u /= 10) > 0);
+	if (ln < 0)
+		*--p = '-';
+	vStringNCatS (b, p, buf + sizeof (buf) - p);
 	return vStringValue (b);
 }
 
@@ -694,19 +743,12 @@ static const char *renderFieldPatternCommon (const tagEntryInfo *const tag,
 				       vString* b,
 					   bool *rejected CTAGS_ATTR_UNUSED)
 {
-	if (tag->isFileEntry)
+	if (tag->isFileEntry || !Option.rereadInput)
 		return NULL;
 	else if (tag->pattern)
-		vStringCatS (b, tag->pattern);
+		return renderAsIs (b, tag->pattern);
 	else
-	{
-		char* tmp;
-
-		tmp = makePatternString (tag);
-		vStringCatS (b, tmp);
-		eFree (tmp);
-	}
-	return vStringValue (b);
+		return getPatternString (tag, b);
 }
 
 static const char *renderFieldPatternCtags (const tagEntryInfo *const tag,
@@ -878,12 +920,7 @@ static bool     isEndFieldAvailable       (const tagEntryInfo *const tag)
 	return (tag->extensionFields.endLine != 0)? true: false;
 }
 
-extern bool isFieldEnabled (fieldType type)
-{
-	return getFieldObject(type)->def->enabled;
-}
-
-static bool isFieldFixed (fieldType type)
+extern bool isFieldFixed (fieldType type)
 {
 	return getFieldObject(type)->fixed? true: false;
 }
@@ -892,7 +929,7 @@ extern bool enableField (fieldType type, bool state, bool warnIfFixedField)
 {
 	fieldDefinition *def = getFieldObject(type)->def;
 	bool old = def->enabled;
-	if (isFieldFixed (type))
+	if (isFieldFixed (type) && writerDoesTreatFieldAsFixed (type))
 	{
 		if ((!state) && warnIfFixedField)
 		{
@@ -912,6 +949,7 @@ extern bool enableField (fieldType type, bool state, bool warnIfFixedField)
 	else
 	{
 		getFieldObject(type)->def->enabled = state;
+		FieldEnabledTable [type] = state;
 
 		if (isCommonField (type))
 			verbose ("enable field \"%s\": %s\n",
@@ -951,6 +989,26 @@ extern int countFields (void)
 	return fieldObjectUsed;
 }
 
+extern bool *swapFieldEnabledTable (bool **table, unsigned int *count)
+{
+	bool *const current = FieldEnabledTable;
+
+	if (*count < fieldObjectUsed)
+	{
+		*table = xRealloc (*table, fieldObjectUsed, bool);
+		memcpy (*table + *count, current + *count,
+				(fieldObjectUsed - *count) * sizeof (bool));
+		*count = fieldObjectUsed;
+	}
+	FieldEnabledTable = *table;
+	return current;
+}
+
+extern void setFieldEnabledTable (bool *table)
+{
+	FieldEnabledTable = table;
+}
+
 extern fieldType nextSiblingField (fieldType type)
 {
 	fieldObject *fobj;
@@ -1002,9 +1060,11 @@ extern int defineField (fieldDefinition *def, langType language)
 	{
 		fieldObjectAllocated *= 2;
 		fieldObjects = xRealloc (fieldObjects, fieldObjectAllocated, fieldObject);
+		FieldEnabledTable = xRealloc (FieldEnabledTable, fieldObjectAllocated, bool);
 	}
 	fobj = fieldObjects + (fieldObjectUsed);
 	def->ftype = fieldObjectUsed++;
+	FieldEnabledTable [def->ftype] = def->enabled;
 
 	if (def->renderEscaped [WRITER_DEFAULT] == NULL)
 		def->renderEscaped [WRITER_DEFAULT] = defaultRenderer;
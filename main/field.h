@@ -14,6 +14,7 @@
 
 #include "general.h"
 #include "colprint.h"
+#include "inline.h"
 #include "writer.h"
 #include "types.h"
 
@@ -102,8 +103,28 @@ extern fieldType getFieldTypeForOption (char letter);
    internally, each parser is not initialized. `LANG_IGNORE' is a bit faster. */
 extern fieldType getFieldTypeForName (const char *name);
 extern fieldType getFieldTypeForNameAndLanguage (const char *fieldName, langType language);
-extern bool isFieldEnabled (fieldType type);
+
+/* The enabled state of each field, kept by enableField (); read it
+   through isFieldEnabled (). */
+extern bool *FieldEnabledTable;
+CTAGS_INLINE bool isFieldEnabled (fieldType type)
+{
+	return FieldEnabledTable [type];
+}
+
 extern bool enableField (fieldType type, bool state, bool warnIfFixedField);
+
+/* Make *TABLE, of *COUNT entries, the enabled state of the fields, and
+   return the table it replaces, to be given back to
+   setFieldEnabledTable (). *TABLE is grown with the state of the fields
+   defined since, taken from the table replaced. Each writer of --output
+   has its own table: a writer enables the fields it needs as it writes. */
+extern bool *swapFieldEnabledTable (bool **table, unsigned int *count);
+extern void setFieldEnabledTable (bool *table);
+/* Whether the field is one of the name, input, and pattern fields every
+   tag line has. Those are disabled only for a writer which does not
+   treat them as fixed (see writerDoesTreatFieldAsFixed ()). */
+extern bool isFieldFixed (fieldType type);
 extern bool isCommonField (fieldType type);
 extern int     getFieldOwner (fieldType type);
 extern const char* getFieldName (fieldType type);
@@ -118,6 +139,10 @@ extern bool doesFieldHaveValue (fieldType type, const tagEntryInfo *tag);
 extern const char* renderFieldEscaped (writerType writer, fieldType type, const tagEntryInfo *tag, int index,
 									   bool *rejected);
 
+/* The function rendering the field specified with TYPE for WRITER,
+   for calling it without looking it up for each tag. */
+extern renderEscaped getFieldRenderer (writerType writer, fieldType type);
+
 extern void initFieldObjects (void);
 extern int countFields (void);
 
@@ -20,91 +20,69 @@
 #include <string.h>
 #include <errno.h>
 
-typedef union uFmtSpec {
-	char *const_str;
-	struct {
-		fieldType ftype;
-		int width;
-	} field;
-} fmtSpec;
+/* A format string is compiled into an array of operations, each
+   having the renderer of its field looked up, and the line of a tag is
+   built in a buffer of the format before being written at once. */
+typedef enum eFmtOpType {
+	FMT_OP_LITERAL,
+	FMT_OP_COMMON_FIELD,
+	FMT_OP_PARSER_FIELD,
+} fmtOpType;
+
+typedef struct sFmtOp {
+	fmtOpType type;
+	size_t width;				/* 0 for no padding */
+	bool leftJustified;
+	union {
+		struct {
+			char *str;
+			size_t length;
+		} literal;
+		struct {
+			fieldType ftype;
+			renderEscaped render;
+		} common;
+		struct {
+			/* The field and its siblings, which a parser field of a tag
+			   may be, with their renderers. A parser initialized after
+			   the compilation adds siblings at the end of the chain. */
+			fieldType *ftypes;
+			renderEscaped *renders;
+			unsigned int count;
+			unsigned int size;
+		} parser;
+	} u;
+} fmtOp;
 
 struct sFmtElement {
-	union uFmtSpec spec;
-	int (* printer) (fmtSpec*, MIO* fp, const tagEntryInfo *);
-	struct sFmtElement *next;
+	fmtOp *ops;
+	unsigned int count;
+	unsigned int size;
+	vString *line;
+	vString *field;
 };
 
-static int printLiteral (fmtSpec* fspec, MIO* fp, const tagEntryInfo * tag CTAGS_ATTR_UNUSED)
+static fmtOp *newOp (fmtElement *fmt, fmtOpType type)
 {
-	return mio_puts (fp, fspec->const_str);
-}
+	fmtOp *op;
 
-static bool isParserFieldCompatibleWithFtype (const tagField *pfield, int baseFtype)
-{
-	do {
-		if (pfield->ftype == baseFtype)
-			return true;
-		baseFtype = nextSiblingField (baseFtype);
-	} while (baseFtype != FIELD_UNKNOWN);
-	return false;
-}
-
-static int printTagField (fmtSpec* fspec, MIO* fp, const tagEntryInfo * tag)
-{
-	int i;
-	int width = fspec->field.width;
-	int ftype;
-	const char* str = NULL;
-
-	ftype = fspec->field.ftype;
-
-	if (isCommonField (ftype))
-		/* TODO: Don't use WRITER_XREF directly */
-		str = renderFieldEscaped (WRITER_XREF, ftype, tag, NO_PARSER_FIELD, NULL);
-	else
+	if (fmt->count == fmt->size)
 	{
-		unsigned int findex;
-		const tagField *f;
-
-		for (findex = 0; findex < tag->usedParserFields; findex++)
-		{
-			f = getParserField(tag, findex);
-			if (isParserFieldCompatibleWithFtype (f, ftype))
-				break;
-		}
-
-		if (findex == tag->usedParserFields)
-			str = "";
-		else if (isFieldEnabled (f->ftype))
-			/* TODO: Don't use WRITER_XREF directly */
-			str = renderFieldEscaped (WRITER_XREF, tag->parserFields [findex].ftype,
-						  tag, findex, NULL);
+		fmt->size = fmt->size? fmt->size * 2: 8;
+		fmt->ops = xRealloc (fmt->ops, fmt->size, fmtOp);
 	}
-
-	if (str == NULL)
-		str = "";
-
-	if (width < 0)
-		i = mio_printf (fp, "%-*s", -1 * width, str);
-	else if (width > 0)
-		i = mio_printf (fp, "%*s", width, str);
-	else
-	{
-		mio_puts (fp, str);
-		i = strlen (str);
-	}
-	return i;
+	op = fmt->ops + fmt->count++;
+	memset (op, 0, sizeof (*op));
+	op->type = type;
+	return op;
 }
 
-static fmtElement** queueLiteral (fmtElement **last, char *literal)
+static void queueLiteral (fmtElement *fmt, char *literal)
 {
-	fmtElement *cur = xMalloc (1, fmtElement);
+	fmtOp *op = newOp (fmt, FMT_OP_LITERAL);
 
-	cur->spec.const_str = literal;
-	cur->printer = printLiteral;
-	cur->next = NULL;
-	*last = cur;
-	return &(cur->next);
+	op->u.literal.str = literal;
+	op->u.literal.length = strlen (literal);
 }
 
 /* `getLanguageComponentInFieldName' is used as part of the option parameter
@@ -163,11 +141,33 @@ static langType getLanguageComponentInFieldName (const char *fullName,
 	return language;
 }
 
-static fmtElement** queueTagField (fmtElement **last, long width, char field_letter,
+static void addSiblingField (fmtOp *op, fieldType ftype)
+{
+	if (op->u.parser.count == op->u.parser.size)
+	{
+		op->u.parser.size = op->u.parser.size? op->u.parser.size * 2: 4;
+		op->u.parser.ftypes = xRealloc (op->u.parser.ftypes, op->u.parser.size, fieldType);
+		op->u.parser.renders = xRealloc (op->u.parser.renders, op->u.parser.size, renderEscaped);
+	}
+	op->u.parser.ftypes [op->u.parser.count] = ftype;
+	/* TODO: Don't use WRITER_XREF directly */
+	op->u.parser.renders [op->u.parser.count] = getFieldRenderer (WRITER_XREF, ftype);
+	op->u.parser.count++;
+}
+
+static void updateSiblingFields (fmtOp *op)
+{
+	fieldType f = op->u.parser.ftypes [op->u.parser.count - 1];
+
+	while ((f = nextSiblingField (f)) != FIELD_UNKNOWN)
+		addSiblingField (op, f);
+}
+
+static void queueTagField (fmtElement *fmt, long width, char field_letter,
 				   const char *field_name)
 {
 	fieldType ftype;
-	fmtElement *cur;
+	fmtOp *op;
 	langType language;
 
 	if (field_letter == NUL_FIELD_LETTER)
@@ -199,11 +199,6 @@ static fmtElement** queueTagField (fmtElement **last, long width, char field_let
 		error (FATAL, "The field cannot be printed in format output: %c", field_letter);
 	}
 
-	cur = xMalloc (1, fmtElement);
-
-	cur->spec.field.width = width;
-	cur->spec.field.ftype = ftype;
-
 	enableField (ftype, true, false);
 	if (language == LANG_AUTO)
 	{
@@ -213,18 +208,29 @@ static fmtElement** queueTagField (fmtElement **last, long width, char field_let
 			enableField (ftype_next, true, false);
 	}
 
-	cur->printer = printTagField;
-	cur->next = NULL;
-	*last = cur;
-	return &(cur->next);
+	/* TODO: Don't use WRITER_XREF directly */
+	if (isCommonField (ftype))
+	{
+		op = newOp (fmt, FMT_OP_COMMON_FIELD);
+		op->u.common.ftype = ftype;
+		op->u.common.render = getFieldRenderer (WRITER_XREF, ftype);
+	}
+	else
+	{
+		op = newOp (fmt, FMT_OP_PARSER_FIELD);
+		addSiblingField (op, ftype);
+		updateSiblingFields (op);
+	}
+
+	op->leftJustified = (width < 0);
+	op->width = (size_t) (width < 0? -width: width);
 }
 
 extern fmtElement *fmtNew (const char*  fmtString)
 {
 	int i;
 	vString *literal = NULL;
-	fmtElement *code  = NULL;
-	fmtElement **last = &code;
+	fmtElement *fmt = xCalloc (1, fmtElement);
 	bool found_percent = false;
 	long column_width;
 	const char*  cursor;
@@ -250,7 +256,7 @@ extern fmtElement *fmtNew (const char*  fmtString)
 				{
 					char* l = vStringDeleteUnwrap (literal);
 					literal = NULL;
-					last = queueLiteral (last, l);
+					queueLiteral (fmt, l);
 				}
 				if (cursor [i] == '-')
 				{
@@ -294,13 +300,13 @@ extern fmtElement *fmtNew (const char*  fmtString)
 					for (; cursor[i] != '}'; i++)
 						vStringPut (field_name, cursor[i]);
 
-					last = queueTagField (last, column_width, NUL_FIELD_LETTER,
-							      vStringValue (field_name));
+					queueTagField (fmt, column_width, NUL_FIELD_LETTER,
+							       vStringValue (field_name));
 
 					vStringDelete (field_name);
 				}
 				else
-					last = queueTagField (last, column_width, cursor[i], NULL);
+					queueTagField (fmt, column_width, cursor[i], NULL);
 			}
 
 		}
@@ -321,38 +327,114 @@ extern fmtElement *fmtNew (const char*  fmtString)
 	{
 		char* l = vStringDeleteUnwrap (literal);
 		literal = NULL;
-		last = queueLiteral (last, l);
+		queueLiteral (fmt, l);
 	}
-	return code;
+
+	/* An empty format stands for the default one of the xref writer. */
+	if (fmt->count == 0)
+	{
+		eFree (fmt);
+		return NULL;
+	}
+	fmt->line = vStringNew ();
+	fmt->field = vStringNew ();
+	return fmt;
 }
 
-extern int fmtPrint   (fmtElement * fmtelts, MIO* fp, const tagEntryInfo *tag)
+static const char *renderTagField (fmtElement *fmt, fmtOp *op, const tagEntryInfo *tag)
 {
-	fmtElement *f = fmtelts;
-	int i = 0;
-	while (f)
+	bool rejected = false;
+	unsigned int findex, i;
+
+	vStringClear (fmt->field);
+	if (op->type == FMT_OP_COMMON_FIELD)
+		return op->u.common.render (tag, NULL, fmt->field, &rejected);
+
+	updateSiblingFields (op);
+	for (findex = 0; findex < tag->usedParserFields; findex++)
 	{
-		i += f->printer (&(f->spec), fp, tag);
-		f = f->next;
+		const tagField *f = getParserField (tag, findex);
+
+		for (i = 0; i < op->u.parser.count; i++)
+		{
+			if (f->ftype == op->u.parser.ftypes [i])
+			{
+				if (!isFieldEnabled (f->ftype))
+					return NULL;
+				return op->u.parser.renders [i] (tag, f->value, fmt->field, &rejected);
+			}
+		}
 	}
-	return i;
+	return NULL;
 }
 
-extern void fmtDelete  (fmtElement * fmtelts)
+/* The padding of a column is appended a block of blanks at a time. */
+static void padLine (vString *line, size_t count)
 {
-	fmtElement *f = fmtelts;
-	fmtElement *next;
+	static const char blanks [] = "                                ";
+	const size_t block = sizeof (blanks) - 1;
+
+	for (; count > block; count -= block)
+		vStringNCatS (line, blanks, block);
+	vStringNCatS (line, blanks, count);
+}
 
-	while (f)
+extern int fmtPrint   (fmtElement * fmt, MIO* fp, const tagEntryInfo *tag)
+{
+	unsigned int i;
+
+	vStringClear (fmt->line);
+	for (i = 0; i < fmt->count; i++)
+	{
+		fmtOp *op = fmt->ops + i;
+		const char *str;
+		size_t length;
+
+		if (op->type == FMT_OP_LITERAL)
+		{
+			vStringNCatS (fmt->line, op->u.literal.str, op->u.literal.length);
+			continue;
+		}
+
+		str = renderTagField (fmt, op, tag);
+		if (str == NULL)
+			str = "";
+		length = strlen (str);
+
+		if (op->leftJustified)
+			vStringNCatS (fmt->line, str, length);
+		if (length < op->width)
+			padLine (fmt->line, op->width - length);
+		if (!op->leftJustified)
+			vStringNCatS (fmt->line, str, length);
+	}
+
+	mio_write (fp, vStringValue (fmt->line), 1, vStringLength (fmt->line));
+	return (int) vStringLength (fmt->line);
+}
+
+extern void fmtDelete  (fmtElement * fmt)
+{
+	unsigned int i;
+
+	if (fmt == NULL)
+		return;
+
+	for (i = 0; i < fmt->count; i++)
 	{
-		next = f->next;
-		if (f->printer == printLiteral)
+		fmtOp *op = fmt->ops + i;
+
+		if (op->type == FMT_OP_LITERAL)
+			eFree (op->u.literal.str);
+		else if (op->type == FMT_OP_PARSER_FIELD)
 		{
-			eFree (f->spec.const_str);
-			f->spec.const_str = NULL;
+			eFree (op->u.parser.ftypes);
+			eFree (op->u.parser.renders);
 		}
-		f->next = NULL;
-		eFree (f);
-		f = next;
 	}
+	if (fmt->ops)
+		eFree (fmt->ops);
+	vStringDelete (fmt->line);
+	vStringDelete (fmt->field);
+	eFree (fmt);
 }
@@ -0,0 +1,270 @@
+/*
+*   Copyright (c) 2026, Universal Ctags Team
+*
+*   This source code is released for free distribution under the terms of the
+*   GNU General Public License version 2 or (at your option) any later version.
+*
+*   This module contains functions for tagging the files of a git tree
+*   (--git-tree) without a checkout. The tree is listed with "git ls-tree",
+*   and the contents of its blobs are read into memory from a single
+*   "git cat-file --batch" process, so that git deals with packfiles,
+*   loose objects, and alternates.
+*
+*   A blob id stands for the contents of a blob, so the tag cache
+*   (--cache-dir) is keyed by it: a blob whose tags are in the cache is
+*   not even read.
+*/
+
+/*
+*   INCLUDE FILES
+*/
+#include "general.h"  /* must always come first */
+
+#include <stdio.h>
+#include <string.h>
+#include <stdlib.h>
+
+#ifdef HAVE_WORKING_FORK
+# include <unistd.h>
+# include <errno.h>
+# ifdef HAVE_SYS_WAIT_H
+#  include <sys/wait.h>
+# endif
+#endif
+
+#include "cache.h"
+#include "debug.h"
+#include "entry.h"
+#include "gittree.h"
+#include "mio.h"
+#include "options.h"
+#include "routines.h"
+#include "vstring.h"
+
+#ifdef HAVE_WORKING_FORK
+/*
+*   DATA DECLARATIONS
+*/
+typedef struct sGitProcess {
+	const char *command;		/* for the diagnostics */
+	pid_t pid;
+	FILE *input;				/* to the process, or NULL */
+	FILE *output;				/* from the process */
+} gitProcess;
+
+typedef struct sGitBlob {
+	gitProcess *catFile;
+	const char *id;
+	const char *path;
+	size_t size;
+} gitBlob;
+
+/*
+*   FUNCTION DEFINITIONS
+*/
+
+static void startGit (gitProcess *git, char *const argv [], bool withInput)
+{
+	int inputFds [2] = { -1, -1 };
+	int outputFds [2];
+
+	git->command = argv [1];
+	if ((withInput && pipe (inputFds) < 0) || pipe (outputFds) < 0)
+		error (FATAL | PERROR, "cannot create a pipe for \"git %s\"", git->command);
+
+	/* The child must not write the buffered data of the parent again. */
+	fflush (NULL);
+	git->pid = fork ();
+	if (git->pid < 0)
+		error (FATAL | PERROR, "cannot run \"git %s\"", git->command);
+	else if (git->pid == 0)
+	{
+		if (withInput)
+		{
+			dup2 (inputFds [0], STDIN_FILENO);
+			close (inputFds [0]);
+			close (inputFds [1]);
+		}
+		dup2 (outputFds [1], STDOUT_FILENO);
+		close (outputFds [0]);
+		close (outputFds [1]);
+		execvp ("git", argv);
+		fprintf (stderr, "%s: cannot run git: %s\n",
+				 getExecutableName (), strerror (errno));
+		_exit (127);
+	}
+
+	git->input = NULL;
+	if (withInput)
+	{
+		close (inputFds [0]);
+		git->input = fdopen (inputFds [1], "w");
+	}
+	close (outputFds [1]);
+	git->output = fdopen (outputFds [0], "r");
+	if ((withInput && git->input == NULL) || git->output == NULL)
+		error (FATAL | PERROR, "cannot talk to \"git %s\"", git->command);
+}
+
+static void finishGit (gitProcess *git)
+{
+	int status;
+
+	if (git->input)
+		fclose (git->input);
+	fclose (git->output);
+	while (waitpid (git->pid, &status, 0) < 0)
+	{
+		if (errno != EINTR)
+			error (FATAL | PERROR, "cannot wait for \"git %s\"", git->command);
+	}
+	if (! WIFEXITED (status) || WEXITSTATUS (status) != 0)
+		error (FATAL, "\"git %s\" failed", git->command);
+}
+
+/*  The output of "git ls-tree -z", all of it: the tree is listed before
+ *  the first blob is requested, so that the two processes never wait
+ *  for each other.
+ */
+static vString *listGitTree (const char *const treeish)
+{
+	char *argv [] = {
+		"git", "ls-tree", "-r", "-z", "-l", "--full-tree",
+		(char *) treeish, "--", NULL,
+	};
+	gitProcess lsTree;
+	vString *list = vStringNew ();
+	char buffer [BUFSIZ];
+	size_t length;
+
+	startGit (&lsTree, argv, false);
+	while ((length = fread (buffer, 1, sizeof (buffer), lsTree.output)) > 0)
+		vStringNCatSUnsafe (list, buffer, length);
+	finishGit (&lsTree);
+	return list;
+}
+
+static MIO *readGitBlob (void *data)
+{
+	gitBlob *const blob = data;
+	FILE *const output = blob->catFile->output;
+	char header [256];
+	char type [16];
+	unsigned long size;
+	unsigned char *contents;
+
+	fprintf (blob->catFile->input, "%s\n", blob->id);
+	fflush (blob->catFile->input);
+
+	if (fgets (header, sizeof (header), output) == NULL)
+		error (FATAL, "\"git %s\" ended unexpectedly", blob->catFile->command);
+	/* "<id> missing" is followed by nothing. */
+	if (sscanf (header, "%*s %15s %lu", type, &size) != 2
+		|| strcmp (type, "blob") != 0)
+	{
+		error (WARNING, "cannot read the blob %s of \"%s\"", blob->id, blob->path);
+		return NULL;
+	}
+
+	contents = eMalloc (size + 1);
+	if (fread (contents, 1, size, output) != size || getc (output) != '\n')
+		error (FATAL, "\"git %s\" ended unexpectedly", blob->catFile->command);
+	return mio_new_memory (contents, size, eRealloc, eFree);
+}
+
+/*  An entry of "git ls-tree -l -z":
+ *      <mode> SP <type> SP <id> SP+ <size> TAB <path> NUL
+ */
+static bool createTagsForGitEntry (gitProcess *catFile, char *entry)
+{
+	char *const tab = strchr (entry, '\t');
+	char *fields [3];
+	char *p = entry;
+	unsigned long size;
+	gitBlob blob;
+	unsigned int i;
+
+	if (tab == NULL)
+		return false;
+	*tab = '\0';
+	for (i = 0; i < 3; i++)
+	{
+		fields [i] = p;
+		p = strchr (p, ' ');
+		if (p == NULL)
+			return false;
+		*p++ = '\0';
+		while (*p == ' ')
+			p++;
+	}
+	blob.path = tab + 1;
+
+	if (strcmp (fields [1], "blob") != 0)
+	{
+		verbose ("ignoring \"%s\" (%s)\n", blob.path, fields [1]);
+		return false;
+	}
+	if (strcmp (fields [0], "120000") == 0)
+	{
+		verbose ("ignoring \"%s\" (symbolic link)\n", blob.path);
+		return false;
+	}
+	if (isExcludedFile (blob.path))
+	{
+		verbose ("excluding \"%s\"\n", blob.path);
+		return false;
+	}
+
+	size = strtoul (p, NULL, 10);
+	blob.catFile = catFile;
+	blob.id = fields [2];
+	blob.size = size;
+
+	if (Option.update)
+		forgetTagsOfFile (blob.path);
+	return parseBlobWithTagCache (blob.path, blob.id, blob.size,
+								  strcmp (fields [0], "100755") == 0,
+								  readGitBlob, &blob);
+}
+
+extern bool createTagsForGitTree (const char *const treeish)
+{
+	char *argv [] = { "git", "cat-file", "--batch", NULL };
+	gitProcess catFile;
+	vString *list;
+	char *entry, *end;
+	bool resize = false;
+
+	if (Option.manifest)
+		error (FATAL, "--git-tree cannot be combined with --manifest; use --cache-dir");
+
+	list = listGitTree (treeish);
+	startGit (&catFile, argv, true);
+
+	entry = vStringValue (list);
+	end = entry + vStringLength (list);
+	while (entry < end)
+	{
+		char *const nul = memchr (entry, '\0', end - entry);
+		char *const next = nul? nul + 1: end;
+
+		/* The last entry is terminated by the terminator of LIST. */
+		if (createTagsForGitEntry (&catFile, entry))
+			resize = true;
+		entry = next;
+	}
+
+	finishGit (&catFile);
+	vStringDelete (list);
+	return resize;
+}
+
+#else
+
+extern bool createTagsForGitTree (const char *const treeish CTAGS_ATTR_UNUSED)
+{
+	error (FATAL, "--git-tree is not supported on this platform");
+	return false;
+}
+
+#endif
@@ -0,0 +1,26 @@
+/*
+*   Copyright (c) 2026, Universal Ctags Team
+*
+*   This source code is released for free distribution under the terms of the
+*   GNU General Public License version 2 or (at your option) any later version.
+*
+*   External interface to gittree.c
+*/
+#ifndef CTAGS_MAIN_GITTREE_H
+#define CTAGS_MAIN_GITTREE_H
+
+/*
+*   INCLUDE FILES
+*/
+#include "general.h"  /* must always come first */
+
+/*
+*   FUNCTION PROTOTYPES
+*/
+
+/* Generate the tags of the files in TREEISH, a tree or a commit of the
+   git repository of the current directory, as named to git, reading
+   their contents from the object store. */
+extern bool createTagsForGitTree (const char *const treeish);
+
+#endif	/* CTAGS_MAIN_GITTREE_H */
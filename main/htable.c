@@ -31,16 +31,43 @@
 #include <string.h>
 
 
+/* The table is open addressed with linear probing. A control byte per
+ * slot tells whether the slot is empty, was emptied by a deletion, or is
+ * in use; in the last case it keeps the high bits of the hash of the key,
+ * so that most of the slots having another key are skipped without
+ * calling equalfn. The low bits, which choose the first slot to probe,
+ * are the same for the keys colliding there, so they would tell nothing.
+ *
+ * The hash functions given to the table, like djb2, leave keys differing
+ * only in their last characters (e.g. NAME_1, NAME_2, ...) with
+ * neighbouring hashes; under linear probing they would fill runs of slots
+ * every lookup of another key crossing them has to walk. Their bits are
+ * mixed first.
+ *
+ * The table can have the same key more than once. Like the old chained
+ * table, hashTableGetItem and hashTableDeleteItem then find the item put
+ * last: the items having the same key are placed along the probe
+ * sequence from the newest to the oldest. */
+#define HENTRY_EMPTY   0x00
+#define HENTRY_DELETED 0x01
+#define HENTRY_FULL    0x80
+#define HENTRY_TAG(H)  (HENTRY_FULL | ((H) >> 25))
+
+#define HTABLE_MIN_SIZE 8
+
 typedef struct sHashEntry hentry;
 struct sHashEntry {
 	void *key;
 	void *value;
-	hentry *next;
+	unsigned int hash;
 };
 
 struct sHashTable {
-	hentry** table;
-	unsigned int size;
+	hentry* table;
+	unsigned char *ctrl;
+	unsigned int size;			/* always a power of 2 */
+	unsigned int count;			/* slots in use */
+	unsigned int used;			/* slots in use or emptied by a deletion */
 	hashTableHashFunc hashfn;
 	hashTableEqualFunc equalfn;
 	hashTableFreeFunc keyfreefn;
@@ -48,76 +75,106 @@ struct sHashTable {
 };
 
 
-static hentry* entry_new (void *key, void *value, hentry* next)
-{
-	hentry* entry = xMalloc (1, hentry);
-
-	entry->key = key;
-	entry->value = value;
-	entry->next = next;
-
-	return entry;
-}
-
-static hentry* entry_destroy (hentry* entry,
+static void  entry_destroy (hentry* entry,
 			      hashTableFreeFunc keyfreefn,
 			      hashTableFreeFunc valfreefn)
 {
-	hentry* tmp;
-
 	if (keyfreefn)
 		keyfreefn (entry->key);
 	if (valfreefn)
 		valfreefn (entry->value);
 	entry->key = NULL;
 	entry->value = NULL;
-	tmp = entry->next;
-	eFree (entry);
+}
+
+/* The finalizer of MurmurHash3 */
+static unsigned int  hash_mix (unsigned int h)
+{
+	h ^= h >> 16;
+	h *= 0x85ebca6bU;
+	h ^= h >> 13;
+	h *= 0xc2b2ae35U;
+	h ^= h >> 16;
+	return h;
+}
 
-	return tmp;
+static unsigned int  entry_hash (hashTable *htable, const void *const key)
+{
+	return hash_mix (htable->hashfn (key));
 }
 
-static void  entry_reclaim (hentry* entry,
-			    hashTableFreeFunc keyfreefn,
-			    hashTableFreeFunc valfreefn)
+static unsigned int  table_size (unsigned int size)
 {
-	while (entry)
-		entry = entry_destroy (entry, keyfreefn, valfreefn);
+	unsigned int s = HTABLE_MIN_SIZE;
+
+	while (s < size)
+		s <<= 1;
+	return s;
 }
 
-static void *entry_find (hentry* entry, const void* const key, hashTableEqualFunc equalfn)
+static void  table_alloc (hashTable *htable, unsigned int size)
 {
-	while (entry)
+	htable->size = size;
+	htable->table = xMalloc (size, hentry);
+	htable->ctrl = xCalloc (size, unsigned char);
+	htable->count = 0;
+	htable->used = 0;
+}
+
+/* Return the slot of the newest item having KEY, or -1. */
+static int   entry_find (hashTable *htable, const void* const key, unsigned int hash)
+{
+	const unsigned int mask = htable->size - 1;
+	const unsigned char tag = HENTRY_TAG (hash);
+	unsigned int i;
+
+	for (i = hash & mask; htable->ctrl[i] != HENTRY_EMPTY; i = (i + 1) & mask)
 	{
-		if (equalfn( key, entry->key))
-			return entry->value;
-		entry = entry->next;
+		if (htable->ctrl[i] == tag
+			&& htable->table[i].hash == hash
+			&& htable->equalfn (key, htable->table[i].key))
+			return (int) i;
 	}
-	return NULL;
+	return -1;
 }
 
-static bool		entry_delete (hentry **entry, void *key, hashTableEqualFunc equalfn,
-			      hashTableFreeFunc keyfreefn, hashTableFreeFunc valfreefn)
+/* Put ENTRY to the first free slot of its probe sequence, after any item
+ * having the same key. Used only while the table has no deleted slot. */
+static void  entry_append (hashTable *htable, const hentry *entry)
 {
-	while (*entry)
-	{
-		if (equalfn (key, (*entry)->key))
-		{
-			*entry = entry_destroy (*entry, keyfreefn, valfreefn);
-			return true;
-		}
+	const unsigned int mask = htable->size - 1;
+	unsigned int i;
 
-	}
-	return false;
+	for (i = entry->hash & mask; htable->ctrl[i] != HENTRY_EMPTY; i = (i + 1) & mask)
+		;
+	htable->table[i] = *entry;
+	htable->ctrl[i] = HENTRY_TAG (entry->hash);
+	htable->count++;
+	htable->used++;
 }
 
-static void  entry_foreach (hentry *entry, hashTableForeachFunc proc, void *user_data)
+static void  table_rehash (hashTable *htable, unsigned int size)
 {
-	while (entry)
+	hentry *table = htable->table;
+	unsigned char *ctrl = htable->ctrl;
+	const unsigned int oldSize = htable->size;
+	unsigned int start, n;
+
+	/* Start from an empty slot so that each run of slots in use, and so
+	 * the items having the same key, are visited in the probe order. */
+	for (start = 0; ctrl[start] != HENTRY_EMPTY; start++)
+		;
+
+	table_alloc (htable, size);
+	for (n = 0; n < oldSize; n++)
 	{
-		proc (entry->key, entry->value, user_data);
-		entry = entry->next;
+		const unsigned int i = (start + n) & (oldSize - 1);
+		if (ctrl[i] & HENTRY_FULL)
+			entry_append (htable, table + i);
 	}
+
+	eFree (ctrl);
+	eFree (table);
 }
 
 extern hashTable *hashTableNew    (unsigned int size,
@@ -129,8 +186,7 @@ extern hashTable *hashTableNew    (unsigned int size,
 	hashTable *htable;
 
 	htable = xMalloc (1, hashTable);
-	htable->size = size;
-	htable->table = xCalloc (size, hentry*);
+	table_alloc (htable, table_size (size));
 
 	htable->hashfn = hashfn;
 	htable->equalfn = equalfn;
@@ -147,6 +203,7 @@ extern void       hashTableDelete (hashTable *htable)
 
 	hashTableClear (htable);
 
+	eFree (htable->ctrl);
 	eFree (htable->table);
 	eFree (htable);
 }
@@ -159,37 +216,96 @@ extern void       hashTableClear (hashTable *htable)
 
 	for (i = 0; i < htable->size; i++)
 	{
-		hentry *entry;
-
-		entry = htable->table[i];
-		entry_reclaim (entry, htable->keyfreefn, htable->valfreefn);
-		htable->table[i] = NULL;
+		if (htable->ctrl[i] & HENTRY_FULL)
+			entry_destroy (htable->table + i, htable->keyfreefn, htable->valfreefn);
 	}
+	memset (htable->ctrl, HENTRY_EMPTY, htable->size);
+	htable->count = 0;
+	htable->used = 0;
 }
 
 extern void       hashTablePutItem    (hashTable *htable, void *key, void *value)
 {
+	unsigned int mask;
 	unsigned int i;
+	unsigned int slot;
+	unsigned char tag;
+	hentry entry;
+	bool haveSlot = false;
 
-	i = htable->hashfn (key) % htable->size;
-	htable->table[i] = entry_new(key, value, htable->table[i]);
+	/* Keep a quarter of the slots empty. */
+	if ((htable->used + 1) * 4 > htable->size * 3)
+	{
+		unsigned int size = htable->size;
+		while ((htable->count + 1) * 2 > size)
+			size <<= 1;
+		table_rehash (htable, size);
+	}
+
+	entry.key = key;
+	entry.value = value;
+	entry.hash = entry_hash (htable, key);
+	tag = HENTRY_TAG (entry.hash);
+	mask = htable->size - 1;
+
+	/* Each item having the same key moves to the slot of the next older
+	 * one, and the oldest to a free slot after them. */
+	for (slot = i = entry.hash & mask; htable->ctrl[i] != HENTRY_EMPTY; i = (i + 1) & mask)
+	{
+		if (htable->ctrl[i] == HENTRY_DELETED)
+		{
+			if (!haveSlot)
+			{
+				slot = i;
+				haveSlot = true;
+			}
+		}
+		else if (htable->ctrl[i] == tag
+				 && htable->table[i].hash == entry.hash
+				 && htable->equalfn (entry.key, htable->table[i].key))
+		{
+			hentry tmp = htable->table[i];
+			htable->table[i] = entry;
+			entry = tmp;
+			haveSlot = false;
+		}
+	}
+	if (!haveSlot)
+	{
+		slot = i;
+		htable->used++;
+	}
+
+	htable->table[slot] = entry;
+	htable->ctrl[slot] = tag;
+	htable->count++;
 }
 
 extern void*      hashTableGetItem   (hashTable *htable, const void * key)
 {
-	unsigned int i;
+	int i = entry_find (htable, key, entry_hash (htable, key));
 
-	i = htable->hashfn (key) % htable->size;
-	return entry_find(htable->table[i], key, htable->equalfn);
+	return (i < 0)? NULL: htable->table[i].value;
 }
 
 extern bool     hashTableDeleteItem (hashTable *htable, void *key)
 {
-	unsigned int i;
+	int i = entry_find (htable, key, entry_hash (htable, key));
+
+	if (i < 0)
+		return false;
 
-	i = htable->hashfn (key) % htable->size;
-	return entry_delete(&htable->table[i], key,
-			    htable->equalfn, htable->keyfreefn, htable->valfreefn);
+	entry_destroy (htable->table + i, htable->keyfreefn, htable->valfreefn);
+	htable->count--;
+	/* A slot before an empty one ends no probe sequence. */
+	if (htable->ctrl[(i + 1) & (htable->size - 1)] == HENTRY_EMPTY)
+	{
+		htable->ctrl[i] = HENTRY_EMPTY;
+		htable->used--;
+	}
+	else
+		htable->ctrl[i] = HENTRY_DELETED;
+	return true;
 }
 
 extern bool    hashTableHasItem    (hashTable *htable, const void *key)
@@ -202,20 +318,15 @@ extern void       hashTableForeachItem (hashTable *htable, hashTableForeachFunc
 	unsigned int i;
 
 	for (i = 0; i < htable->size; i++)
-		entry_foreach(htable->table[i], proc, user_data);
-}
-
-static void count (void *key CTAGS_ATTR_UNUSED, void *value CTAGS_ATTR_UNUSED, void *data)
-{
-	int *c = data;
-	++*c;
+	{
+		if (htable->ctrl[i] & HENTRY_FULL)
+			proc (htable->table[i].key, htable->table[i].value, user_data);
+	}
 }
 
 extern int        hashTableCountItem   (hashTable *htable)
 {
-	int c = 0;
-	hashTableForeachItem (htable, count, &c);
-	return c;
+	return (int) htable->count;
 }
 
 unsigned int hashPtrhash (const void * const x)
@@ -0,0 +1,391 @@
+/*
+*   Copyright (c) 2026, Universal Ctags Team
+*
+*   This source code is released for free distribution under the terms of the
+*   GNU General Public License version 2 or (at your option) any later version.
+*
+*   This module contains functions for the ignore files read while
+*   recursing into directories (--ignore-file). Their format is the one
+*   of .gitignore: one glob pattern per line, '#' starting a comment, '!'
+*   negating a pattern, and a trailing '/' matching only directories. A
+*   pattern having another '/' is matched against the path relative to
+*   the directory of the ignore file, where "**" matches any number of
+*   directories; other patterns are matched against the base name. The
+*   last pattern matching a path decides, and the ignore file of a
+*   directory takes precedence over the ones of its parents.
+*
+*   An ignored directory is not read at all.
+*/
+
+/*
+*   INCLUDE FILES
+*/
+#include "general.h"  /* must always come first */
+
+#include <string.h>
+
+#include "debug.h"
+#include "ignorefile.h"
+#include "options.h"
+#include "ptrarray.h"
+#include "routines.h"
+#include "strlist.h"
+
+/*
+*   DATA DECLARATIONS
+*/
+typedef struct sIgnoreRule {
+	char *pattern;				/* without '!', and the leading and trailing '/' */
+	size_t length;
+	bool negated;
+	bool directoryOnly;
+	bool anchored;				/* to the directory of the ignore file */
+} ignoreRule;
+
+typedef struct sIgnoreLevel {
+	char *dirName;
+	size_t dirLength;
+	ptrArray *rules;
+} ignoreLevel;
+
+/*
+*   DATA DEFINITIONS
+*/
+
+/* One item per directory entered, NULL if none of its ignore files exists. */
+static ptrArray *IgnoreLevels;
+
+/*
+*   FUNCTION DEFINITIONS
+*/
+
+static bool isSeparator (const int c)
+{
+	return c == '/' || c == OUTPUT_PATH_SEPARATOR;
+}
+
+static void deleteRule (void *data)
+{
+	ignoreRule *rule = data;
+
+	eFree (rule->pattern);
+	eFree (rule);
+}
+
+static void deleteLevel (ignoreLevel *level)
+{
+	eFree (level->dirName);
+	ptrArrayDelete (level->rules);
+	eFree (level);
+}
+
+static ignoreRule *newRule (const char *line)
+{
+	ignoreRule *rule;
+	size_t length;
+	bool negated = false;
+	bool directoryOnly = false;
+
+	if (line [0] == '#')
+		return NULL;
+	if (line [0] == '!')
+	{
+		negated = true;
+		line++;
+	}
+
+	length = strlen (line);
+	if (length > 0 && line [length - 1] == '/')
+	{
+		directoryOnly = true;
+		length--;
+	}
+
+	rule = xMalloc (1, ignoreRule);
+	rule->anchored = (memchr (line, '/', length) != NULL);
+	if (line [0] == '/')
+	{
+		line++;
+		length--;
+	}
+	rule->pattern = eStrndup (line, length);
+	rule->length = length;
+	rule->negated = negated;
+	rule->directoryOnly = directoryOnly;
+
+	if (length == 0)
+	{
+		deleteRule (rule);
+		rule = NULL;
+	}
+	return rule;
+}
+
+static void readIgnoreFile (ptrArray *rules, const char *const fileName)
+{
+	stringList *const lines = stringListNewFromFile (fileName);
+	unsigned int i;
+
+	if (lines == NULL)
+		return;
+
+	verbose ("reading ignore file \"%s\"\n", fileName);
+	for (i = 0; i < stringListCount (lines); i++)
+	{
+		ignoreRule *rule = newRule (vStringValue (stringListItem (lines, i)));
+		if (rule)
+			ptrArrayAdd (rules, rule);
+	}
+	stringListDelete (lines);
+}
+
+extern void enterIgnoreFileDirectory (const char *const dirName)
+{
+	ignoreLevel *level = NULL;
+	unsigned int i;
+
+	if (IgnoreLevels == NULL)
+		IgnoreLevels = ptrArrayNew (NULL);
+
+	for (i = 0; Option.ignoreFileNames && i < stringListCount (Option.ignoreFileNames); i++)
+	{
+		const char *const name = vStringValue (stringListItem (Option.ignoreFileNames, i));
+		char *const fileName = combinePathAndFile (dirName, name);
+
+		if (level == NULL)
+		{
+			level = xMalloc (1, ignoreLevel);
+			level->dirName = eStrdup (dirName);
+			level->dirLength = strlen (dirName);
+			level->rules = ptrArrayNew (deleteRule);
+		}
+		readIgnoreFile (level->rules, fileName);
+		eFree (fileName);
+	}
+
+	if (level && ptrArrayCount (level->rules) == 0)
+	{
+		deleteLevel (level);
+		level = NULL;
+	}
+	ptrArrayAdd (IgnoreLevels, level);
+}
+
+extern void leaveIgnoreFileDirectory (void)
+{
+	ignoreLevel *level;
+
+	Assert (IgnoreLevels && ptrArrayCount (IgnoreLevels) > 0);
+
+	level = ptrArrayLast (IgnoreLevels);
+	if (level)
+		deleteLevel (level);
+	ptrArrayRemoveLast (IgnoreLevels);
+
+	if (ptrArrayCount (IgnoreLevels) == 0)
+	{
+		ptrArrayDelete (IgnoreLevels);
+		IgnoreLevels = NULL;
+	}
+}
+
+/* Match the bracket expression at P against C, and set *END just after
+ * it. Return -1 if P starts no bracket expression. */
+static int matchBracket (const char *p, const char *const pe, const int c,
+						 const char **end)
+{
+	bool negated = false;
+	bool matched = false;
+	const char *q = p + 1;
+
+	if (q < pe && (*q == '!' || *q == '^'))
+	{
+		negated = true;
+		q++;
+	}
+	if (q < pe && *q == ']')
+	{
+		matched = (c == ']');
+		q++;
+	}
+	while (q < pe && *q != ']')
+	{
+		if (q + 2 < pe && q [1] == '-' && q [2] != ']')
+		{
+			matched = matched || (q [0] <= c && c <= q [2]);
+			q += 3;
+		}
+		else
+			matched = matched || (*q++ == c);
+	}
+	if (q == pe)
+		return -1;
+
+	*end = q + 1;
+	return matched != negated;
+}
+
+/* Match the glob [P, PE) against the path component [N, NE). */
+static bool matchComponent (const char *p, const char *const pe,
+							const char *n, const char *const ne)
+{
+	const char *end;
+	int r;
+
+	while (p < pe)
+	{
+		switch (*p)
+		{
+		case '*':
+			while (p < pe && *p == '*')
+				p++;
+			if (p == pe)
+				return true;
+			for (; n < ne; n++)
+				if (matchComponent (p, pe, n, ne))
+					return true;
+			return matchComponent (p, pe, n, ne);
+		case '?':
+			if (n == ne)
+				return false;
+			p++;
+			n++;
+			break;
+		case '[':
+			if (n == ne)
+				return false;
+			r = matchBracket (p, pe, (unsigned char) *n, &end);
+			if (r == 0)
+				return false;
+			else if (r > 0)
+			{
+				p = end;
+				n++;
+				break;
+			}
+			/* an unterminated '[' is an ordinary character */
+			if (*n != '[')
+				return false;
+			p++;
+			n++;
+			break;
+		case '\\':
+			if (p + 1 < pe)
+				p++;
+			/* Fall through */
+		default:
+			if (n == ne || *p != *n)
+				return false;
+			p++;
+			n++;
+			break;
+		}
+	}
+	return n == ne;
+}
+
+static const char *patternComponentEnd (const char *p, const char *const pe)
+{
+	const char *slash = memchr (p, '/', pe - p);
+	return slash? slash: pe;
+}
+
+static const char *pathComponentEnd (const char *n, const char *const ne)
+{
+	while (n < ne && !isSeparator (*n))
+		n++;
+	return n;
+}
+
+/* Match the glob [P, PE) against the path [N, NE), component by
+ * component; a "**" component matches any number of them. */
+static bool matchPath (const char *p, const char *const pe,
+					   const char *n, const char *const ne)
+{
+	for (;;)
+	{
+		const char *const pc = patternComponentEnd (p, pe);
+		const char *nc;
+
+		if (pc - p == 2 && p [0] == '*' && p [1] == '*')
+		{
+			if (pc == pe)
+				return true;
+			p = pc + 1;
+			for (;;)
+			{
+				if (matchPath (p, pe, n, ne))
+					return true;
+				n = pathComponentEnd (n, ne);
+				if (n == ne)
+					return false;
+				n++;
+			}
+		}
+
+		nc = pathComponentEnd (n, ne);
+		if (!matchComponent (p, pc, n, nc))
+			return false;
+		if (pc == pe)
+			return nc == ne;
+		if (nc == ne)
+			return false;
+		p = pc + 1;
+		n = nc + 1;
+	}
+}
+
+static bool matchRule (const ignoreRule *const rule, const char *const path,
+					   const char *const base, bool isDirectory)
+{
+	const char *const pe = rule->pattern + rule->length;
+	const char *const ne = path + strlen (path);
+
+	if (rule->directoryOnly && !isDirectory)
+		return false;
+	if (rule->anchored)
+		return matchPath (rule->pattern, pe, path, ne);
+	return matchComponent (rule->pattern, pe, base, ne);
+}
+
+/* Return PATH relative to the directory of LEVEL, or NULL. */
+static const char *relativePath (const ignoreLevel *const level, const char *const path)
+{
+	if (strncmp (path, level->dirName, level->dirLength) == 0)
+	{
+		if (level->dirLength > 0 && isSeparator (level->dirName [level->dirLength - 1]))
+			return path + level->dirLength;
+		if (isSeparator (path [level->dirLength]))
+			return path + level->dirLength + 1;
+	}
+	/* The entries of "." are visited without "./". */
+	if (strcmp (level->dirName, ".") == 0)
+		return path;
+	return NULL;
+}
+
+extern bool isIgnoredByIgnoreFiles (const char *const path, bool isDirectory)
+{
+	const char *const base = baseFilename (path);
+	unsigned int i, j;
+
+	if (IgnoreLevels == NULL)
+		return false;
+
+	for (i = ptrArrayCount (IgnoreLevels); i > 0; i--)
+	{
+		const ignoreLevel *const level = ptrArrayItem (IgnoreLevels, i - 1);
+		const char *rel;
+
+		if (level == NULL || (rel = relativePath (level, path)) == NULL)
+			continue;
+
+		for (j = ptrArrayCount (level->rules); j > 0; j--)
+		{
+			const ignoreRule *const rule = ptrArrayItem (level->rules, j - 1);
+			if (matchRule (rule, rel, base, isDirectory))
+				return !rule->negated;
+		}
+	}
+	return false;
+}
@@ -0,0 +1,31 @@
+/*
+*   Copyright (c) 2026, Universal Ctags Team
+*
+*   This source code is released for free distribution under the terms of the
+*   GNU General Public License version 2 or (at your option) any later version.
+*
+*   External interface to ignorefile.c
+*/
+#ifndef CTAGS_MAIN_IGNOREFILE_H
+#define CTAGS_MAIN_IGNOREFILE_H
+
+/*
+*   INCLUDE FILES
+*/
+#include "general.h"  /* must always come first */
+
+/*
+*   FUNCTION PROTOTYPES
+*/
+
+/* Read the ignore files named with --ignore-file in DIRNAME, whose
+   entries are about to be visited. Each call must be paired with a
+   call of leaveIgnoreFileDirectory. */
+extern void enterIgnoreFileDirectory (const char *const dirName);
+extern void leaveIgnoreFileDirectory (void);
+
+/* Tell whether the ignore files of the directories entered so far
+   ignore PATH, an entry of the innermost one. */
+extern bool isIgnoredByIgnoreFiles (const char *const path, bool isDirectory);
+
+#endif	/* CTAGS_MAIN_IGNOREFILE_H */
@@ -10,17 +10,21 @@
 #define CTAGS_MAIN_INTERACTIVE_H
 
 #include "general.h"
+#include "mio.h"
 #include "options.h"
 
 
 struct interactiveModeArgs
 {
 	bool sandbox;
+	bool framed;				/* the requests are protobuf messages */
 };
 
 void interactiveLoop (cookedArgs *args, void *user);
 bool jsonErrorPrinter (const errorSelection selection, const char *const format, va_list ap,
 					  void *data);
+/* Make jsonErrorPrinter write to MIO instead of stdout, if not NULL. */
+void setJsonErrorOutput (MIO *mio);
 int installSyscallFilter (void);
 
 #endif  /* CTAGS_MAIN_INTERACTIVE_H */
@@ -24,52 +24,52 @@
 *   DATA DECLARATIONS
 */
 typedef struct sHashEntry {
-	struct sHashEntry *next;
-	const char *string;
-	langType language;
+	const char *string;			/* NULL if the slot is empty */
+	unsigned int hash;
 	int value;
 } hashEntry;
 
+/* The keywords of a language, in an open addressed table kept at most
+ * half full; a look up usually compares one string at most. */
+typedef struct sKeywordSet {
+	hashEntry *entries;
+	unsigned int size;			/* 0, or a power of 2 */
+	unsigned int count;
+} keywordSet;
+
 /*
 *   DATA DEFINITIONS
 */
-static const unsigned int TableSize = 2039;  /* prime */
-static hashEntry **HashTable = NULL;
+static const unsigned int MinTableSize = 16;
+static keywordSet *KeywordTables = NULL;	/* indexed by language */
+static unsigned int KeywordTableCount = 0;
 
 /*
 *   FUNCTION DEFINITIONS
 */
 
-static hashEntry **getHashTable (void)
+static keywordSet *getKeywordSet (langType language)
 {
-	static bool allocated = false;
-
-	if (! allocated)
-	{
-		unsigned int i;
-
-		HashTable = xMalloc (TableSize, hashEntry*);
-
-		for (i = 0  ;  i < TableSize  ;  ++i)
-			HashTable [i] = NULL;
-
-		allocated = true;
-	}
-	return HashTable;
+	if (language < 0 || (unsigned int) language >= KeywordTableCount)
+		return NULL;
+	return KeywordTables + language;
 }
 
-static hashEntry *getHashTableEntry (unsigned long hashedValue)
+static keywordSet *prepareKeywordSet (langType language)
 {
-	hashEntry **const table = getHashTable ();
-	hashEntry *entry;
-
-	Assert (hashedValue < TableSize);
-	entry = table [hashedValue];
+	Assert (language >= 0);
 
-	return entry;
+	if ((unsigned int) language >= KeywordTableCount)
+	{
+		KeywordTables = xRealloc (KeywordTables, language + 1, keywordSet);
+		memset (KeywordTables + KeywordTableCount, 0,
+				(language + 1 - KeywordTableCount) * sizeof (keywordSet));
+		KeywordTableCount = language + 1;
+	}
+	return KeywordTables + language;
 }
 
-static unsigned int hashValue (const char *const string, langType language)
+static unsigned int hashValue (const char *const string)
 {
 	const signed char *p;
 	unsigned int h = 5381;
@@ -80,23 +80,37 @@ static unsigned int hashValue (const char *const string, langType language)
 	for (p = (const signed char *)string; *p != '\0'; p++)
 		h = (h << 5) + h + tolower (*p);
 
-	/* consider language as an extra "character" and add it to the hash */
-	h = (h << 5) + h + language;
-
 	return h;
 }
 
-static hashEntry *newEntry (
-		const char *const string, langType language, int value)
+static void putEntry (keywordSet *table, const hashEntry *const entry)
+{
+	const unsigned int mask = table->size - 1;
+	unsigned int i;
+
+	for (i = entry->hash & mask; table->entries [i].string != NULL; i = (i + 1) & mask)
+		;
+	table->entries [i] = *entry;
+	table->count++;
+}
+
+static void growKeywordSet (keywordSet *table)
 {
-	hashEntry *const entry = xMalloc (1, hashEntry);
+	hashEntry *const entries = table->entries;
+	const unsigned int size = table->size;
+	unsigned int i;
 
-	entry->next     = NULL;
-	entry->string   = string;
-	entry->language = language;
-	entry->value    = value;
+	table->size = size? size * 2: MinTableSize;
+	table->entries = xCalloc (table->size, hashEntry);
+	table->count = 0;
 
-	return entry;
+	for (i = 0; i < size; i++)
+	{
+		if (entries [i].string != NULL)
+			putEntry (table, entries + i);
+	}
+	if (entries)
+		eFree (entries);
 }
 
 /*  Note that it is assumed that a "value" of zero means an undefined keyword
@@ -106,54 +120,43 @@ static hashEntry *newEntry (
  */
 extern void addKeyword (const char *const string, langType language, int value)
 {
-	const unsigned int index = hashValue (string, language) % TableSize;
-	hashEntry *entry = getHashTableEntry (index);
-
-	if (entry == NULL)
-	{
-		hashEntry **const table = getHashTable ();
-		table [index] = newEntry (string, language, value);
-	}
-	else
-	{
-		hashEntry *prev = NULL;
-
-		while (entry != NULL)
-		{
-			if (language == entry->language  &&
-				strcmp (string, entry->string) == 0)
-			{
-				Assert (("Already in table" == NULL));
-			}
-			prev = entry;
-			entry = entry->next;
-		}
-		if (entry == NULL)
-		{
-			Assert (prev != NULL);
-			prev->next = newEntry (string, language, value);
-		}
-	}
+	keywordSet *const table = prepareKeywordSet (language);
+	hashEntry entry = {
+		.string = string,
+		.hash   = hashValue (string),
+		.value  = value,
+	};
+
+	Assert (lookupKeyword (string, language) == KEYWORD_NONE
+			|| ("Already in table" == NULL));
+
+	if ((table->count + 1) * 2 > table->size)
+		growKeywordSet (table);
+	putEntry (table, &entry);
 }
 
 static int lookupKeywordFull (const char *const string, bool caseSensitive, langType language)
 {
-	const unsigned int index = hashValue (string, language) % TableSize;
-	hashEntry *entry = getHashTableEntry (index);
-	int result = KEYWORD_NONE;
+	const keywordSet *const table = getKeywordSet (language);
+	unsigned int mask;
+	unsigned int hash;
+	unsigned int i;
 
-	while (entry != NULL)
+	if (table == NULL || table->count == 0)
+		return KEYWORD_NONE;
+
+	mask = table->size - 1;
+	hash = hashValue (string);
+	for (i = hash & mask; table->entries [i].string != NULL; i = (i + 1) & mask)
 	{
-		if (language == entry->language &&
+		const hashEntry *const entry = table->entries + i;
+
+		if (entry->hash == hash &&
 			((caseSensitive && strcmp (string, entry->string) == 0) ||
 			 (!caseSensitive && strcasecmp (string, entry->string) == 0)))
-		{
-			result = entry->value;
-			break;
-		}
-		entry = entry->next;
+			return entry->value;
 	}
-	return result;
+	return KEYWORD_NONE;
 }
 
 extern int lookupKeyword (const char *const string, langType language)
@@ -168,71 +171,52 @@ extern int lookupCaseKeyword (const char *const string, langType language)
 
 extern void freeKeywordTable (void)
 {
-	if (HashTable != NULL)
-	{
-		unsigned int i;
-
-		for (i = 0  ;  i < TableSize  ;  ++i)
-		{
-			hashEntry *entry = HashTable [i];
+	unsigned int i;
 
-			while (entry != NULL)
-			{
-				hashEntry *next = entry->next;
-				eFree (entry);
-				entry = next;
-			}
-		}
-		eFree (HashTable);
+	for (i = 0  ;  i < KeywordTableCount  ;  ++i)
+	{
+		if (KeywordTables [i].entries != NULL)
+			eFree (KeywordTables [i].entries);
 	}
+	if (KeywordTables != NULL)
+		eFree (KeywordTables);
+	KeywordTables = NULL;
+	KeywordTableCount = 0;
 }
 
 #ifdef DEBUG
 
-static void printEntry (const hashEntry *const entry)
-{
-	printf ("  %-15s %-7s\n", entry->string, getLanguageName (entry->language));
-}
-
-static unsigned int printBucket (const unsigned int i)
+static void printEntry (const hashEntry *const entry, langType language,
+						unsigned int distance)
 {
-	hashEntry **const table = getHashTable ();
-	hashEntry *entry = table [i];
-	unsigned int measure = 1;
-	bool first = true;
-
-	printf ("%2d:", i);
-	if (entry == NULL)
-		printf ("\n");
-	else while (entry != NULL)
-	{
-		if (! first)
-			printf ("    ");
-		else
-		{
-			printf (" ");
-			first = false;
-		}
-		printEntry (entry);
-		entry = entry->next;
-		measure = 2 * measure;
-	}
-	return measure - 1;
+	printf ("  %-15s %-7s %u\n", entry->string, getLanguageName (language),
+			distance);
 }
 
 extern void printKeywordTable (void)
 {
 	unsigned long emptyBucketCount = 0;
 	unsigned long measure = 0;
-	unsigned int i;
+	unsigned int i, j;
 
-	for (i = 0  ;  i < TableSize  ;  ++i)
+	for (i = 0  ;  i < KeywordTableCount  ;  ++i)
 	{
-		const unsigned int pass = printBucket (i);
+		const keywordSet *const table = KeywordTables + i;
 
-		measure += pass;
-		if (pass == 0)
-			++emptyBucketCount;
+		for (j = 0  ;  j < table->size  ;  ++j)
+		{
+			const hashEntry *const entry = table->entries + j;
+
+			if (entry->string == NULL)
+				++emptyBucketCount;
+			else
+			{
+				const unsigned int distance =
+					(j - entry->hash) & (table->size - 1);
+				printEntry (entry, i, distance);
+				measure += distance;
+			}
+		}
 	}
 
 	printf ("spread measure = %ld\n", measure);
@@ -243,15 +227,17 @@ extern void printKeywordTable (void)
 
 extern void dumpKeywordTable (FILE *fp)
 {
-	unsigned int i;
-	for (i = 0  ;  i < TableSize  ;  ++i)
+	unsigned int i, j;
+
+	for (i = 0  ;  i < KeywordTableCount  ;  ++i)
 	{
-		hashEntry **const table = getHashTable ();
-		hashEntry *entry = table [i];
-		while (entry != NULL)
+		const keywordSet *const table = KeywordTables + i;
+
+		for (j = 0  ;  j < table->size  ;  ++j)
 		{
-			fprintf(fp, "%s	%s\n", entry->string, getLanguageName (entry->language));
-			entry = entry->next;
+			const hashEntry *const entry = table->entries + j;
+			if (entry->string != NULL)
+				fprintf(fp, "%s	%s\n", entry->string, getLanguageName (i));
 		}
 	}
 }
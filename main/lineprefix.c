@@ -0,0 +1,160 @@
+/*
+*   Copyright (c) 2026, Universal Ctags Team
+*
+*   This source code is released for free distribution under the terms of the
+*   GNU General Public License version 2 or (at your option) any later version.
+*
+*   This module contains functions for the parsers of line oriented
+*   languages, which find their tags in the lines starting with some
+*   keywords. The keywords are indexed by their first character, so that
+*   a line is compared only with those it may start with, and the lines
+*   none of them can start are skipped.
+*/
+
+/*
+*   INCLUDE FILES
+*/
+#include "general.h"  /* must always come first */
+
+#include <ctype.h>
+#include <limits.h>
+#include <string.h>
+
+#include "debug.h"
+#include "lineprefix.h"
+#include "read.h"
+#include "routines.h"
+
+/*
+*   DATA DECLARATIONS
+*/
+struct sLinePrefixTable {
+	const linePrefix *prefixes;
+	unsigned int flags;
+	size_t *lengths;			/* of the keywords */
+	unsigned int *order;		/* of the prefixes, by their first characters */
+	unsigned int first [UCHAR_MAX + 2];	/* in order, for each first character */
+	inputCharClass firstChars;
+};
+
+/*
+*   FUNCTION DEFINITIONS
+*/
+
+static unsigned char firstCharOf (const linePrefixTable *table, const char *keyword)
+{
+	const unsigned char c = (unsigned char) keyword [0];
+
+	return (table->flags & LINE_PREFIX_IGNORE_CASE)? (unsigned char) tolower (c): c;
+}
+
+extern linePrefixTable *linePrefixTableNew (const linePrefix *prefixes, unsigned int count,
+											unsigned int flags)
+{
+	linePrefixTable *table = xCalloc (1, linePrefixTable);
+	unsigned int i, c;
+
+	table->prefixes = prefixes;
+	table->flags = flags;
+	table->lengths = xMalloc (count? count: 1, size_t);
+	table->order = xMalloc (count? count: 1, unsigned int);
+
+	/* Count the prefixes of each first character, then place them after
+	   those of the characters before it, keeping the order of the table. */
+	for (i = 0; i < count; i++)
+	{
+		Assert (prefixes [i].keyword [0] != '\0');
+		table->lengths [i] = strlen (prefixes [i].keyword);
+		table->first [firstCharOf (table, prefixes [i].keyword) + 1]++;
+	}
+	for (c = 1; c < ARRAY_SIZE (table->first); c++)
+		table->first [c] += table->first [c - 1];
+	{
+		unsigned int next [UCHAR_MAX + 1];
+
+		memcpy (next, table->first, sizeof (next));
+		for (i = 0; i < count; i++)
+			table->order [next [firstCharOf (table, prefixes [i].keyword)]++] = i;
+	}
+
+	initInputCharClass (&table->firstChars, "", false);
+	for (i = 0; i < count; i++)
+	{
+		const unsigned char f = (unsigned char) prefixes [i].keyword [0];
+
+		table->firstChars.members [f] = true;
+		if (flags & LINE_PREFIX_IGNORE_CASE)
+			table->firstChars.members [toupper (f)] = true;
+	}
+	return table;
+}
+
+extern void linePrefixTableDelete (linePrefixTable *table)
+{
+	eFree (table->order);
+	eFree (table->lengths);
+	eFree (table);
+}
+
+static bool matchKeyword (const linePrefixTable *table, const char *p,
+						  const char *keyword, size_t length)
+{
+	size_t i;
+
+	if (! (table->flags & LINE_PREFIX_IGNORE_CASE))
+		return strncmp (p, keyword, length) == 0;
+
+	for (i = 0; i < length; i++)
+		if (tolower ((unsigned char) p [i]) != keyword [i])
+			return false;
+	return true;
+}
+
+extern const linePrefix *matchLinePrefix (const linePrefixTable *table,
+										  const char *line, const char **rest)
+{
+	const char *p = line;
+	unsigned char c;
+	unsigned int i;
+
+	if (table->flags & LINE_PREFIX_SKIP_BLANKS)
+		while (isspace ((unsigned char) *p))
+			p++;
+
+	c = (unsigned char) *p;
+	if (table->flags & LINE_PREFIX_IGNORE_CASE)
+		c = (unsigned char) tolower (c);
+
+	for (i = table->first [c]; i < table->first [c + 1]; i++)
+	{
+		const unsigned int n = table->order [i];
+		const linePrefix *const prefix = table->prefixes + n;
+		const size_t length = table->lengths [n];
+
+		if (matchKeyword (table, p, prefix->keyword, length)
+			&& (! (prefix->flags & LINE_PREFIX_WORD)
+				|| isspace ((unsigned char) p [length])))
+		{
+			if (rest)
+				*rest = p + length;
+			return prefix;
+		}
+	}
+	return NULL;
+}
+
+extern void dispatchInputLinesWithPrefixes (const linePrefixTable *table, void *data)
+{
+	const bool skipBlanks = (table->flags & LINE_PREFIX_SKIP_BLANKS) != 0;
+	const unsigned char *line;
+
+	while ((line = readLineStartingInClassFromInputFile (&table->firstChars,
+														 skipBlanks)) != NULL)
+	{
+		const char *rest;
+		const linePrefix *const prefix = matchLinePrefix (table, (const char *) line, &rest);
+
+		if (prefix && prefix->handler)
+			prefix->handler (prefix, (const char *) line, rest, data);
+	}
+}
@@ -0,0 +1,63 @@
+/*
+*   Copyright (c) 2026, Universal Ctags Team
+*
+*   This source code is released for free distribution under the terms of the
+*   GNU General Public License version 2 or (at your option) any later version.
+*
+*   External interface to lineprefix.c
+*/
+#ifndef CTAGS_MAIN_LINEPREFIX_H
+#define CTAGS_MAIN_LINEPREFIX_H
+
+/*
+*   INCLUDE FILES
+*/
+#include "general.h"  /* must always come first */
+
+/*
+*   DATA DECLARATIONS
+*/
+typedef struct sLinePrefixTable linePrefixTable;
+typedef struct sLinePrefix linePrefix;
+
+/* LINE is the whole line, REST what follows the keyword in it. */
+typedef void (* linePrefixHandler) (const linePrefix *prefix,
+									const char *line, const char *rest,
+									void *data);
+
+enum eLinePrefixFlag {
+	LINE_PREFIX_WORD = 1 << 0,	/* the keyword is followed by a white space */
+};
+
+struct sLinePrefix {
+	const char *keyword;
+	linePrefixHandler handler;
+	int kind;					/* for the handler to use */
+	unsigned int flags;			/* eLinePrefixFlag */
+};
+
+enum eLinePrefixTableFlag {
+	LINE_PREFIX_SKIP_BLANKS = 1 << 0,	/* keywords may be indented */
+	LINE_PREFIX_IGNORE_CASE = 1 << 1,	/* keywords are given in lower case */
+};
+
+/*
+*   FUNCTION PROTOTYPES
+*/
+
+/* Of a line, the first of PREFIXES matching is taken. */
+extern linePrefixTable *linePrefixTableNew (const linePrefix *prefixes, unsigned int count,
+											unsigned int flags);
+extern void linePrefixTableDelete (linePrefixTable *table);
+
+/* Return the first prefix of TABLE LINE starts with, setting REST to
+   what follows its keyword, or NULL. */
+extern const linePrefix *matchLinePrefix (const linePrefixTable *table,
+										  const char *line, const char **rest);
+
+/* Read the rest of the input file, calling the handler of the prefix
+   each line starts with. The lines no keyword can start are skipped
+   without being copied when possible. */
+extern void dispatchInputLinesWithPrefixes (const linePrefixTable *table, void *data);
+
+#endif  /* CTAGS_MAIN_LINEPREFIX_H */
@@ -0,0 +1,271 @@
+/*
+*   Copyright (c) 2026, Universal Ctags Team
+*
+*   This source code is released for free distribution under the terms of the
+*   GNU General Public License version 2 or (at your option) any later version.
+*
+*   Defines a matcher finding a set of literal strings in a text in one
+*   pass (Aho-Corasick). The automaton is built as a dense table of
+*   transitions on the first scan after literals are added, so a scan
+*   costs one table lookup per byte of the text, whatever the number of
+*   literals.
+*/
+
+/*
+*   INCLUDE FILES
+*/
+#include "general.h"  /* must always come first */
+
+#include <string.h>
+
+#include "debug.h"
+#include "litmatch.h"
+#include "ptrarray.h"
+#include "routines.h"
+
+/*
+*   MACROS
+*/
+#define LIT_ROOT 0
+#define LIT_NONE ((unsigned int)-1)
+
+/*
+*   DATA DECLARATIONS
+*/
+typedef struct sLitEntry {
+	char *literal;
+	unsigned int id;
+} litEntry;
+
+typedef struct sLitOutput {
+	unsigned int id;
+	unsigned int next;		/* next output of the same state, or LIT_NONE */
+} litOutput;
+
+struct sLitMatcher {
+	ptrArray *literals;
+	bool dirty;
+
+	/* The automaton; delta [s * 256 + c] is the state after reading
+	   c in the state s. */
+	unsigned int stateCount;
+	unsigned int *delta;
+	unsigned int *outHead;	/* first output of a state, or LIT_NONE */
+	unsigned int *dict;		/* nearest state with outputs on the failure
+							   path, or LIT_ROOT */
+	litOutput *outputs;
+	unsigned int idCount;	/* number of distinct ids */
+};
+
+/*
+*   FUNCTION DEFINITIONS
+*/
+static void deleteLitEntry (void *data)
+{
+	litEntry *entry = data;
+
+	eFree (entry->literal);
+	eFree (entry);
+}
+
+extern litMatcher *litMatcherNew (void)
+{
+	litMatcher *matcher = xCalloc (1, litMatcher);
+
+	matcher->literals = ptrArrayNew (deleteLitEntry);
+	return matcher;
+}
+
+static void clearAutomaton (litMatcher *matcher)
+{
+	if (matcher->delta)
+		eFree (matcher->delta);
+	if (matcher->outHead)
+		eFree (matcher->outHead);
+	if (matcher->dict)
+		eFree (matcher->dict);
+	if (matcher->outputs)
+		eFree (matcher->outputs);
+	matcher->delta = NULL;
+	matcher->outHead = NULL;
+	matcher->dict = NULL;
+	matcher->outputs = NULL;
+	matcher->stateCount = 0;
+	matcher->idCount = 0;
+}
+
+extern void litMatcherDelete (litMatcher *matcher)
+{
+	clearAutomaton (matcher);
+	ptrArrayDelete (matcher->literals);
+	eFree (matcher);
+}
+
+extern void litMatcherAdd (litMatcher *matcher, const char *literal, unsigned int id)
+{
+	litEntry *entry = xMalloc (1, litEntry);
+
+	Assert (literal && literal [0] != '\0');
+	entry->literal = eStrdup (literal);
+	entry->id = id;
+	ptrArrayAdd (matcher->literals, entry);
+	matcher->dirty = true;
+}
+
+extern unsigned int litMatcherCount (const litMatcher *matcher)
+{
+	return ptrArrayCount (matcher->literals);
+}
+
+static void buildAutomaton (litMatcher *matcher)
+{
+	unsigned int count = ptrArrayCount (matcher->literals);
+	unsigned int maxStates = 1;
+	unsigned int maxId = 0;
+	unsigned int i, c;
+
+	clearAutomaton (matcher);
+
+	for (i = 0; i < count; i++)
+	{
+		litEntry *entry = ptrArrayItem (matcher->literals, i);
+		maxStates += strlen (entry->literal);
+		if (entry->id > maxId)
+			maxId = entry->id;
+	}
+
+	matcher->delta = xMalloc ((size_t) maxStates * 256, unsigned int);
+	matcher->outHead = xMalloc (maxStates, unsigned int);
+	matcher->dict = xMalloc (maxStates, unsigned int);
+	matcher->outputs = xMalloc (count > 0? count: 1, litOutput);
+
+	for (c = 0; c < 256; c++)
+		matcher->delta [c] = LIT_NONE;
+	matcher->outHead [LIT_ROOT] = LIT_NONE;
+	matcher->dict [LIT_ROOT] = LIT_ROOT;
+	matcher->stateCount = 1;
+
+	/* The trie of the literals. */
+	bool *seen = xCalloc (maxId + 1, bool);
+	for (i = 0; i < count; i++)
+	{
+		litEntry *entry = ptrArrayItem (matcher->literals, i);
+		unsigned int s = LIT_ROOT;
+
+		for (const unsigned char *p = (const unsigned char *) entry->literal; *p; p++)
+		{
+			unsigned int *t = matcher->delta + (size_t) s * 256 + *p;
+			if (*t == LIT_NONE)
+			{
+				unsigned int n = matcher->stateCount++;
+				for (c = 0; c < 256; c++)
+					matcher->delta [(size_t) n * 256 + c] = LIT_NONE;
+				matcher->outHead [n] = LIT_NONE;
+				matcher->dict [n] = LIT_ROOT;
+				*t = n;
+			}
+			s = *t;
+		}
+		matcher->outputs [i].id = entry->id;
+		matcher->outputs [i].next = matcher->outHead [s];
+		matcher->outHead [s] = i;
+
+		if (!seen [entry->id])
+		{
+			seen [entry->id] = true;
+			matcher->idCount++;
+		}
+	}
+	eFree (seen);
+
+	/* Failure links, breadth first, turning the trie into a complete
+	   transition table. The failure state of a state is always less
+	   deep, so its transitions are complete when they are copied. */
+	unsigned int *fail = xMalloc (matcher->stateCount, unsigned int);
+	unsigned int *queue = xMalloc (matcher->stateCount, unsigned int);
+	unsigned int head = 0, tail = 0;
+
+	for (c = 0; c < 256; c++)
+	{
+		unsigned int t = matcher->delta [c];
+		if (t == LIT_NONE)
+			matcher->delta [c] = LIT_ROOT;
+		else
+		{
+			fail [t] = LIT_ROOT;
+			queue [tail++] = t;
+		}
+	}
+
+	while (head < tail)
+	{
+		unsigned int r = queue [head++];
+		for (c = 0; c < 256; c++)
+		{
+			unsigned int *t = matcher->delta + (size_t) r * 256 + c;
+			unsigned int f = matcher->delta [(size_t) fail [r] * 256 + c];
+			if (*t == LIT_NONE)
+				*t = f;
+			else
+			{
+				fail [*t] = f;
+				matcher->dict [*t] = (matcher->outHead [f] != LIT_NONE)? f: matcher->dict [f];
+				queue [tail++] = *t;
+			}
+		}
+	}
+
+	eFree (queue);
+	eFree (fail);
+	matcher->dirty = false;
+}
+
+static unsigned int markOutputs (litMatcher *matcher, unsigned int s, bool *found)
+{
+	unsigned int marked = 0;
+
+	do
+	{
+		for (unsigned int o = matcher->outHead [s]; o != LIT_NONE;
+			 o = matcher->outputs [o].next)
+		{
+			if (!found [matcher->outputs [o].id])
+			{
+				found [matcher->outputs [o].id] = true;
+				marked++;
+			}
+		}
+		s = matcher->dict [s];
+	} while (s != LIT_ROOT);
+
+	return marked;
+}
+
+extern void litMatcherScan (litMatcher *matcher, const char *text, size_t length,
+							bool *found)
+{
+	if (matcher->dirty)
+		buildAutomaton (matcher);
+	if (matcher->idCount == 0)
+		return;
+
+	const unsigned char *p = (const unsigned char *) text;
+	const unsigned char *const end = p + length;
+	const unsigned int *delta = matcher->delta;
+	unsigned int s = LIT_ROOT;
+	unsigned int marked = 0;
+
+	for (; p < end; p++)
+	{
+		unsigned char c = *p;
+		if (c >= 'A' && c <= 'Z')
+			c += 'a' - 'A';
+		s = delta [(size_t) s * 256 + c];
+		if (matcher->outHead [s] != LIT_NONE || matcher->dict [s] != LIT_ROOT)
+		{
+			marked += markOutputs (matcher, s, found);
+			if (marked == matcher->idCount)
+				break;
+		}
+	}
+}
@@ -0,0 +1,44 @@
+/*
+*   Copyright (c) 2026, Universal Ctags Team
+*
+*   This source code is released for free distribution under the terms of the
+*   GNU General Public License version 2 or (at your option) any later version.
+*
+*   Defines a matcher finding a set of literal strings in a text in one
+*   pass (Aho-Corasick).
+*/
+#ifndef CTAGS_MAIN_LITMATCH_H
+#define CTAGS_MAIN_LITMATCH_H
+
+/*
+*   INCLUDE FILES
+*/
+#include "general.h"  /* must always come first */
+
+#include <stddef.h>
+
+/*
+*   DATA DECLARATIONS
+*/
+struct sLitMatcher;
+typedef struct sLitMatcher litMatcher;
+
+/*
+*   FUNCTION PROTOTYPES
+*/
+extern litMatcher *litMatcherNew (void);
+extern void litMatcherDelete (litMatcher *matcher);
+
+/* Add LITERAL, which must not be empty, found as ID. The literals are
+   compared with the text folded to lower case ASCII, so LITERAL must
+   be in lower case. Several literals may have the same ID. */
+extern void litMatcherAdd (litMatcher *matcher, const char *literal, unsigned int id);
+extern unsigned int litMatcherCount (const litMatcher *matcher);
+
+/* Set FOUND [ID] to true for each literal ID found in TEXT. FOUND must
+   have room for the largest ID given to litMatcherAdd, and is not
+   cleared. */
+extern void litMatcherScan (litMatcher *matcher, const char *text, size_t length,
+							bool *found);
+
+#endif /* CTAGS_MAIN_LITMATCH_H */
@@ -24,6 +24,7 @@
 # include <sys/types.h>  /* declare off_t (not known to regex.h on FreeBSD) */
 #endif
 #include <regex.h>
+#include <time.h>
 
 #include "debug.h"
 #include "colprint.h"
@@ -31,13 +32,21 @@
 #include "flags.h"
 #include "htable.h"
 #include "kind.h"
+#include "litmatch.h"
+#include "main.h"
 #include "options.h"
 #include "parse.h"
 #include "read.h"
 #include "routines.h"
 #include "ptrarray.h"
+#include "regexset.h"
 #include "trashbox.h"
 
+#ifdef HAVE_PCRE2
+#define PCRE2_CODE_UNIT_WIDTH 8
+#include <pcre2.h>
+#endif
+
 static bool regexAvailable = false;
 
 /*
@@ -47,6 +56,9 @@ static bool regexAvailable = false;
 /* Back-references \0 through \9 */
 #define BACK_REFERENCE_COUNT 10
 
+/* Not a flag of regcomp: the pattern is compiled with PCRE2. */
+#define REG_CTAGS_PCRE2 (1 << 24)
+
 /*
 *   DATA DECLARATIONS
 */
@@ -91,8 +103,34 @@ struct mTableActionSpec {
 	struct regexTable *continuation_table;
 };
 
+/* The counts after unmatch are only taken with --_profile-regex. */
+struct regexStatistics {
+	unsigned int match;
+	unsigned int unmatch;
+	unsigned long exec;			/* regexec calls, or lines screened */
+	unsigned long bytes;
+	double seconds;
+};
+
+/* A pattern, compiled for regexec or for PCRE2 when it is run first:
+   the patterns of the languages not used in a run are never compiled.
+   The patterns having the same source and flags share one, whatever
+   language or table they belong to. */
 typedef struct {
-	regex_t *pattern;
+	char *source;
+	int cflags;
+	int refcount;
+	bool broken;				/* it could not be compiled */
+	regex_t *posix;
+	regexProgram *program;		/* run in place of posix if not NULL */
+#ifdef HAVE_PCRE2
+	pcre2_code *pcre2;
+	pcre2_match_data *matchData;
+#endif
+} regexCode;
+
+typedef struct {
+	regexCode *pattern;
 	enum pType type;
 	bool exclusive;
 	bool accept_empty_name;
@@ -117,10 +155,15 @@ typedef struct {
 	ptrArray *fieldPatterns;
 
 	char *pattern_string;
-	struct {
-		unsigned int match;
-		unsigned int unmatch;
-	} statistics;
+	bool inRegexSet;			/* a single line pattern run in lcb->set */
+	char *literal;				/* in lower case; a line not having it cannot
+								   match a single line pattern */
+	bool *firstBytes;			/* the bytes a match of a multitable pattern
+								   can start with, or NULL for any */
+	bool singleByte;			/* the match is one of firstBytes, and the
+								   pattern has no group */
+	bool prepared;				/* screenPattern or findFirstBytes ran */
+	struct regexStatistics statistics;
 
 	int refcount;
 } regexPattern;
@@ -130,6 +173,14 @@ typedef struct {
 struct regexTable {
 	char *name;
 	ptrArray *patterns;
+
+	/* The patterns which may match at an offset where the input has the
+	   byte c: the indexes dispatch [dispatchStart [c]] to
+	   dispatch [dispatchStart [c + 1] - 1] of patterns, in order. Built
+	   when dispatchCount patterns were in the table. */
+	unsigned int *dispatch;
+	unsigned int dispatchStart [257];
+	unsigned int dispatchCount;
 };
 
 struct lregexControlBlock {
@@ -140,11 +191,29 @@ struct lregexControlBlock {
 	ptrArray *tstack;
 
 	langType owner;
+
+	/* Screening lines for the single line patterns which may match:
+	   those in the set are run all together, and the literals of the
+	   others are searched. The literal matcher is built when the first
+	   line is matched after a pattern is added. */
+	regexSet *set;
+	litMatcher *literals;
+	/* Indexed like patterns [REG_PARSER_SINGLE_LINE]; kept out of the
+	   patterns not to visit each of them for each line. */
+	bool *screened;
+	bool *candidates;
+	bool screenDirty;
+	bool screenBusy;
+	struct regexStatistics screenStatistics;
+	/* A pattern was added since the patterns were compiled. */
+	bool compileDirty;
 };
 
 /*
 *   DATA DEFINITIONS
 */
+/* The regexCodes in use, each as its own key */
+static hashTable *RegexCodes;
 
 /*
 *   FUNCTION DEFINITIONS
@@ -156,10 +225,42 @@ static void deleteTable (void *ptrn)
 	struct regexTable *t = ptrn;
 
 	ptrArrayDelete (t->patterns);
+	if (t->dispatch)
+		eFree (t->dispatch);
 	eFree (t->name);
 	eFree (t);
 }
 
+static void freeRegex (regexCode *code)
+{
+	if (--code->refcount > 0)
+		return;
+
+	hashTableDeleteItem (RegexCodes, code);
+	if (hashTableCountItem (RegexCodes) == 0)
+	{
+		hashTableDelete (RegexCodes);
+		RegexCodes = NULL;
+	}
+
+	eFree (code->source);
+	if (code->posix)
+	{
+		regfree (code->posix);
+		eFree (code->posix);
+	}
+	if (code->program)
+		regexProgramDelete (code->program);
+#ifdef HAVE_PCRE2
+	if (code->pcre2)
+	{
+		pcre2_match_data_free (code->matchData);
+		pcre2_code_free (code->pcre2);
+	}
+#endif
+	eFree (code);
+}
+
 static void deletePattern (void *ptrn)
 {
 	regexPattern *p = ptrn;
@@ -169,8 +270,7 @@ static void deletePattern (void *ptrn)
 	if (p->refcount > 0)
 		return;
 
-	regfree (p->pattern);
-	eFree (p->pattern);
+	freeRegex (p->pattern);
 	p->pattern = NULL;
 
 	if (p->type == PTRN_TAG)
@@ -186,6 +286,10 @@ static void deletePattern (void *ptrn)
 	}
 
 	eFree (p->pattern_string);
+	if (p->literal)
+		eFree (p->literal);
+	if (p->firstBytes)
+		eFree (p->firstBytes);
 	eFree (ptrn);
 }
 
@@ -194,6 +298,11 @@ static void clearPatternSet (struct lregexControlBlock *lcb)
 	ptrArrayClear (lcb->patterns [REG_PARSER_SINGLE_LINE]);
 	ptrArrayClear (lcb->patterns [REG_PARSER_MULTI_LINE]);
 	ptrArrayClear (lcb->tables);
+
+	if (lcb->set)
+		regexSetDelete (lcb->set);
+	lcb->set = regexSetNew ();
+	lcb->screenDirty = true;
 }
 
 extern struct lregexControlBlock* allocLregexControlBlock (parserDefinition *parser)
@@ -205,6 +314,7 @@ extern struct lregexControlBlock* allocLregexControlBlock (parserDefinition *par
 	lcb->tables = ptrArrayNew(deleteTable);
 	lcb->tstack = ptrArrayNew(NULL);
 	lcb->owner = parser->id;
+	lcb->set = regexSetNew ();
 
 	return lcb;
 }
@@ -224,6 +334,14 @@ extern void freeLregexControlBlock (struct lregexControlBlock* lcb)
 	ptrArrayDelete (lcb->tstack);
 	lcb->tstack = NULL;
 
+	regexSetDelete (lcb->set);
+	if (lcb->literals)
+		litMatcherDelete (lcb->literals);
+	if (lcb->screened)
+		eFree (lcb->screened);
+	if (lcb->candidates)
+		eFree (lcb->candidates);
+
 	eFree (lcb);
 }
 
@@ -444,7 +562,7 @@ static regexPattern * refPattern (regexPattern * ptrn)
 	return ptrn;
 }
 
-static regexPattern * newPattern (regex_t* const pattern,
+static regexPattern * newPattern (regexCode* const pattern,
 								  enum regexParserType regptype)
 {
 	regexPattern*ptrn = xCalloc(1, regexPattern);
@@ -465,7 +583,7 @@ static regexPattern * newPattern (regex_t* const pattern,
 
 static regexPattern* addCompiledTagCommon (struct lregexControlBlock *lcb,
 										   int table_index,
-										   regex_t* const pattern,
+										   regexCode* const pattern,
 										   enum regexParserType regptype)
 {
 	regexPattern *ptrn;
@@ -479,9 +597,14 @@ static regexPattern* addCompiledTagCommon (struct lregexControlBlock *lcb,
 		ptrArrayAdd (table->patterns, ptrn);
 	}
 	else
+	{
 		ptrArrayAdd (lcb->patterns[regptype], ptrn);
+		if (regptype == REG_PARSER_SINGLE_LINE)
+			lcb->screenDirty = true;
+	}
 
 	useRegexMethod(lcb->owner);
+	lcb->compileDirty = true;
 
 	return ptrn;
 }
@@ -756,7 +879,7 @@ static flagDefinition multitablePtrnFlagDef[] = {
 
 static regexPattern *addCompiledTagPattern (struct lregexControlBlock *lcb,
 											int table_index,
-											enum regexParserType regptype, regex_t* const pattern,
+											enum regexParserType regptype, regexCode* const pattern,
 					    const char* const name, char kindLetter, const char* kindName,
 					    char *const description, const char* flags,
 					    bool *disabled)
@@ -830,7 +953,7 @@ static regexPattern *addCompiledTagPattern (struct lregexControlBlock *lcb,
 	return ptrn;
 }
 
-static regexPattern *addCompiledCallbackPattern (struct lregexControlBlock *lcb, regex_t* const pattern,
+static regexPattern *addCompiledCallbackPattern (struct lregexControlBlock *lcb, regexCode* const pattern,
 					const regexCallback callback, const char* flags,
 					bool *disabled,
 					void *userData)
@@ -882,6 +1005,17 @@ static void regex_flag_icase_long (const char* s CTAGS_ATTR_UNUSED, const char*
 }
 
 
+static void regex_flag_pcre2_short (char c CTAGS_ATTR_UNUSED, void* data)
+{
+	int* cflags = data;
+	*cflags |= REG_CTAGS_PCRE2;
+}
+
+static void regex_flag_pcre2_long (const char* const s CTAGS_ATTR_UNUSED, const char* const unused CTAGS_ATTR_UNUSED, void* data)
+{
+	regex_flag_pcre2_short ('p', data);
+}
+
 static flagDefinition regexFlagDefs[] = {
 	{ 'b', "basic",  regex_flag_basic_short,  regex_flag_basic_long,
 	  NULL, "interpreted as a Posix basic regular expression."},
@@ -889,38 +1023,502 @@ static flagDefinition regexFlagDefs[] = {
 	  NULL, "interpreted as a Posix extended regular expression (default)"},
 	{ 'i', "icase",  regex_flag_icase_short,  regex_flag_icase_long,
 	  NULL, "applied in a case-insensitive manner"},
+	{ 'p', "pcre2",  regex_flag_pcre2_short,  regex_flag_pcre2_long,
+	  NULL, "interpreted as a Perl compatible regular expression (if built with PCRE2)"},
 };
 
-static regex_t* compileRegex (enum regexParserType regptype,
-							  const char* const regexp, const char* const flags)
+static int regexCompileFlags (enum regexParserType regptype, const char* const flags)
 {
 	int cflags = REG_EXTENDED | REG_NEWLINE;
 
 	if (regptype == REG_PARSER_MULTI_TABLE)
 		cflags &= ~REG_NEWLINE;
 
-	regex_t *result;
-	int errcode;
-
 	flagsEval (flags,
 		   regexFlagDefs,
 		   ARRAY_SIZE(regexFlagDefs),
 		   &cflags);
+	return cflags;
+}
+
+#ifdef HAVE_PCRE2
+static bool compilePcre2 (regexCode *code, const char* const regexp, int cflags)
+{
+	uint32_t options = 0;
+	int errcode;
+	PCRE2_SIZE erroffset;
+
+	if (!(cflags & REG_EXTENDED))
+		error (WARNING, "pcre2 %s: the basic flag is ignored", regexp);
+	if (cflags & REG_ICASE)
+		options |= PCRE2_CASELESS;
+	/* Like REG_NEWLINE for regcomp, ^ and $ match at the newlines of a
+	   multiline input, and . doesn't match a newline. */
+	if (cflags & REG_NEWLINE)
+		options |= PCRE2_MULTILINE;
+	else
+		options |= PCRE2_DOTALL;
+
+	code->pcre2 = pcre2_compile ((PCRE2_SPTR) regexp, PCRE2_ZERO_TERMINATED,
+								 options, &errcode, &erroffset, NULL);
+	if (code->pcre2 == NULL)
+	{
+		PCRE2_UCHAR errmsg[256];
+		pcre2_get_error_message (errcode, errmsg, sizeof (errmsg));
+		error (WARNING, "pcre2_compile %s: %s at offset %lu", regexp,
+			   (char *) errmsg, (unsigned long) erroffset);
+		return false;
+	}
+
+	/* Without JIT support pcre2_match interprets the pattern. */
+	pcre2_jit_compile (code->pcre2, PCRE2_JIT_COMPLETE);
+	code->matchData = pcre2_match_data_create (BACK_REFERENCE_COUNT, NULL);
+	return true;
+}
+#endif
+
+static unsigned int hashRegexCode (const void *const key)
+{
+	const regexCode *const code = key;
+
+	return hashCstrhash (code->source) ^ (unsigned int) code->cflags;
+}
+
+static bool equalRegexCodes (const void *a, const void *b)
+{
+	const regexCode *const x = a;
+	const regexCode *const y = b;
+
+	return x->cflags == y->cflags && strcmp (x->source, y->source) == 0;
+}
+
+static regexCode* newRegex (const char* const regexp, int cflags)
+{
+	regexCode key = { .source = (char *) regexp, .cflags = cflags };
+	regexCode *result;
+
+	if (RegexCodes == NULL)
+		RegexCodes = hashTableNew (64, hashRegexCode, equalRegexCodes,
+								   NULL, NULL);
+
+	result = hashTableGetItem (RegexCodes, &key);
+	if (result)
+	{
+		result->refcount++;
+		return result;
+	}
+
+	result = xCalloc (1, regexCode);
+	result->source = eStrdup (regexp);
+	result->cflags = cflags;
+	result->refcount = 1;
+	hashTablePutItem (RegexCodes, result, result);
+	return result;
+}
+
+/* Compile CODE if it is not yet. Return false if it cannot be. */
+static bool prepareRegex (regexCode *code)
+{
+	int cflags = code->cflags;
+	int errcode;
+
+	if (code->posix)
+		return true;
+#ifdef HAVE_PCRE2
+	if (code->pcre2)
+		return true;
+#endif
+	if (code->broken)
+		return false;
+
+	if (cflags & REG_CTAGS_PCRE2)
+	{
+#ifdef HAVE_PCRE2
+		if (compilePcre2 (code, code->source, cflags))
+			return true;
+		code->broken = true;
+		return false;
+#else
+		error (WARNING, "pcre2 %s: built without PCRE2, compiled with regcomp", code->source);
+		cflags &= ~REG_CTAGS_PCRE2;
+#endif
+	}
 
-	result = xMalloc (1, regex_t);
-	errcode = regcomp (result, regexp, cflags);
+	code->posix = xMalloc (1, regex_t);
+	errcode = regcomp (code->posix, code->source, cflags);
 	if (errcode != 0)
 	{
 		char errmsg[256];
-		regerror (errcode, result, errmsg, 256);
-		error (WARNING, "regcomp %s: %s", regexp, errmsg);
-		regfree (result);
-		eFree (result);
-		result = NULL;
+		regerror (errcode, code->posix, errmsg, 256);
+		error (WARNING, "regcomp %s: %s", code->source, errmsg);
+		regfree (code->posix);
+		eFree (code->posix);
+		code->posix = NULL;
+		code->broken = true;
+		return false;
+	}
+	code->program = regexProgramNew (code->source, cflags);
+	return true;
+}
+
+/* Like regexec with no eflags: return 0 if CODE matches the LENGTH
+   bytes of STRING, filling NMATCH elements of PMATCH. STRING may not be
+   terminated by NUL where regexec supports REG_STARTEND. */
+static int execRegex (regexCode *code, const char *string, size_t length,
+					  size_t nmatch, regmatch_t pmatch [])
+{
+#ifdef HAVE_PCRE2
+	if (code->pcre2)
+	{
+		int rc = pcre2_match (code->pcre2, (PCRE2_SPTR) string, length,
+							  0, 0, code->matchData, NULL);
+		/* 0 means the groups after the BACK_REFERENCE_COUNT - 1th are
+		   not recorded. */
+		if (rc < 0)
+			return REG_NOMATCH;
+
+		PCRE2_SIZE *ovector = pcre2_get_ovector_pointer (code->matchData);
+		uint32_t count = pcre2_get_ovector_count (code->matchData);
+		for (size_t i = 0; i < nmatch; i++)
+		{
+			if (i < count && ovector [2 * i] != PCRE2_UNSET)
+			{
+				pmatch [i].rm_so = ovector [2 * i];
+				pmatch [i].rm_eo = ovector [2 * i + 1];
+			}
+			else
+				pmatch [i].rm_so = pmatch [i].rm_eo = -1;
+		}
+		return 0;
+	}
+#endif
+	if (code->program)
+	{
+		int r = regexProgramExec (code->program, string, length, nmatch, pmatch);
+		if (r != REG_ESPACE)
+			return r;
+	}
+#ifdef REG_STARTEND
+	pmatch [0].rm_so = 0;
+	pmatch [0].rm_eo = length;
+	return regexec (code->posix, string, nmatch, pmatch, REG_STARTEND);
+#else
+	return regexec (code->posix, string, nmatch, pmatch, 0);
+#endif
+}
+
+static double profileClock (void)
+{
+#if defined (HAVE_CLOCK_GETTIME) && defined (CLOCK_MONOTONIC)
+	struct timespec ts;
+
+	clock_gettime (CLOCK_MONOTONIC, &ts);
+	return ts.tv_sec + ts.tv_nsec / 1e9;
+#else
+	return (double) clock () / CLOCKS_PER_SEC;
+#endif
+}
+
+/* Run execRegex for PTRN, profiling it with --_profile-regex. The bytes
+   counted are the LENGTH of a line for a single line pattern, those up
+   to the end of the match or of the input for a multiline pattern, and
+   those of the match for a multitable pattern, which is anchored. */
+static int execPattern (regexPattern *ptrn, const char *string, size_t length,
+						regmatch_t pmatch [])
+{
+	double start;
+	int r;
+
+	if (!prepareRegex (ptrn->pattern))
+		return REG_NOMATCH;
+
+	if (Option.profileRegex == REGEX_PROFILE_NONE)
+	{
+		beginTotalsPhase (PHASE_REGEX);
+		r = execRegex (ptrn->pattern, string, length,
+					   BACK_REFERENCE_COUNT, pmatch);
+		endTotalsPhase ();
+		return r;
+	}
+
+	start = profileClock ();
+	r = execRegex (ptrn->pattern, string, length, BACK_REFERENCE_COUNT, pmatch);
+	ptrn->statistics.seconds += profileClock () - start;
+	ptrn->statistics.exec++;
+	if (ptrn->regptype == REG_PARSER_SINGLE_LINE)
+		ptrn->statistics.bytes += length;
+	else if (r == 0)
+		ptrn->statistics.bytes += pmatch [0].rm_eo;
+	else if (ptrn->regptype == REG_PARSER_MULTI_LINE)
+		ptrn->statistics.bytes += length;
+	return r;
+}
+
+
+static const char *skipBracketExpression (const char *p)
+{
+	/* p points the character after '['. */
+	if (*p == '^')
+		p++;
+	if (*p == ']')
+		p++;
+	while (*p && *p != ']')
+	{
+		if (*p == '[' && (p [1] == ':' || p [1] == '=' || p [1] == '.'))
+		{
+			const char delim = p [1];
+			p += 2;
+			while (*p && !(*p == delim && p [1] == ']'))
+				p++;
+			if (*p)
+				p += 2;
+		}
+		else
+			p++;
+	}
+	return *p? p + 1: NULL;
+}
+
+static const char *skipGroup (const char *p)
+{
+	/* p points the character after '('. */
+	int depth = 1;
+
+	while (*p)
+	{
+		if (*p == '\\')
+		{
+			if (*++p == '\0')
+				return NULL;
+			p++;
+		}
+		else if (*p == '[')
+		{
+			p = skipBracketExpression (p + 1);
+			if (!p)
+				return NULL;
+		}
+		else if (*p == '(')
+		{
+			depth++;
+			p++;
+		}
+		else if (*p == ')')
+		{
+			p++;
+			if (--depth == 0)
+				return p;
+		}
+		else
+			p++;
+	}
+	return NULL;
+}
+
+static void keepLongerLiteral (vString *best, vString *run)
+{
+	if (vStringLength (run) > vStringLength (best))
+		vStringCopy (best, run);
+	vStringClear (run);
+}
+
+static void dropLastLiteralChar (vString *run)
+{
+	if ((unsigned char) vStringLast (run) < 0x80)
+		vStringChop (run);
+	else
+	{
+		/* The last character may be a multibyte one. */
+		while (vStringLength (run) > 0
+			   && (unsigned char) vStringLast (run) >= 0x80)
+			vStringChop (run);
+	}
+}
+
+/* Return the longest string every line matching an extended REGEXP
+ * contains, in lower case, or NULL if none is found. The parsing is
+ * conservative: groups, bracket expressions and anything not obviously
+ * a literal end a run of literal characters, and an alternation at the
+ * top level gives up.
+ */
+static char *extractRequiredLiteral (const char *const regexp, int cflags)
+{
+	char *result = NULL;
+
+	if (!(cflags & REG_EXTENDED))
+		return NULL;
+
+	vString *best = vStringNew ();
+	vString *run = vStringNew ();
+	bool lastIsLiteral = false;
+	const char *p = regexp;
+
+	while (*p)
+	{
+		const char c = *p;
+
+		if (c == '|' || c == ')')
+			goto out;
+		else if (c == '(' || c == '[')
+		{
+			keepLongerLiteral (best, run);
+			p = (c == '(')? skipGroup (p + 1): skipBracketExpression (p + 1);
+			if (!p)
+				goto out;
+			lastIsLiteral = false;
+			continue;
+		}
+		else if (c == '*' || c == '?' || c == '{')
+		{
+			/* The preceding atom is optional. */
+			if (lastIsLiteral)
+				dropLastLiteralChar (run);
+			keepLongerLiteral (best, run);
+			lastIsLiteral = false;
+			if (c == '{')
+			{
+				for (p++; *p && *p != '}'; p++)
+					if (!isdigit ((unsigned char) *p) && *p != ',')
+						goto out;
+				if (*p == '\0')
+					goto out;
+			}
+		}
+		else if (c == '+')
+		{
+			keepLongerLiteral (best, run);
+			lastIsLiteral = false;
+		}
+		else if (c == '.' || c == '^' || c == '$')
+		{
+			keepLongerLiteral (best, run);
+			lastIsLiteral = false;
+		}
+		else if (c == '\\')
+		{
+			const char e = *++p;
+			if (e == '\0')
+				goto out;
+			if (isalnum ((unsigned char) e) || strchr ("<>`'", e))
+			{
+				/* \w, \b, back references, ... */
+				keepLongerLiteral (best, run);
+				lastIsLiteral = false;
+			}
+			else
+			{
+				vStringPut (run, e);
+				lastIsLiteral = true;
+			}
+		}
+		else
+		{
+			if ((cflags & REG_ICASE) && (unsigned char) c >= 0x80)
+				goto out;
+			vStringPut (run, c);
+			lastIsLiteral = true;
+		}
+		p++;
+	}
+	keepLongerLiteral (best, run);
+
+	if (vStringLength (best) > 0)
+	{
+		vStringLower (best);
+		result = vStringDeleteUnwrap (best);
+		best = NULL;
 	}
+
+ out:
+	vStringDelete (run);
+	if (best)
+		vStringDelete (best);
 	return result;
 }
 
+static void screenPattern (struct lregexControlBlock *lcb, regexPattern *ptrn,
+						   unsigned int index)
+{
+	const char *const regex = ptrn->pattern->source;
+	const int cflags = ptrn->pattern->cflags;
+
+	ptrn->prepared = true;
+	/* Neither the set nor the literal extraction knows the syntax of
+	   PCRE2. */
+	if (cflags & REG_CTAGS_PCRE2)
+		return;
+	ptrn->inRegexSet = regexSetAdd (lcb->set, regex, cflags, index);
+	if (!ptrn->inRegexSet)
+		ptrn->literal = extractRequiredLiteral (regex, cflags);
+}
+
+/* A multitable pattern is matched at the start of the rest of the input:
+ * find the bytes a match can start with, so that it is not tried at an
+ * offset having another one.
+ */
+static void findFirstBytes (regexPattern *ptrn)
+{
+	const char *const regex = ptrn->pattern->source;
+	const int cflags = ptrn->pattern->cflags;
+	bool singleByte;
+
+	ptrn->prepared = true;
+	if (regex [0] != '^' || (cflags & REG_CTAGS_PCRE2))
+		return;
+
+	ptrn->firstBytes = xMalloc (256, bool);
+	if (!regexFirstBytes (regex, cflags, ptrn->firstBytes, &singleByte))
+	{
+		eFree (ptrn->firstBytes);
+		ptrn->firstBytes = NULL;
+		return;
+	}
+	/* A match is taken without regexec: make sure regcomp accepts the
+	   pattern. */
+	ptrn->singleByte = singleByte && !strchr (regex, '(')
+		&& prepareRegex (ptrn->pattern);
+}
+
+static void buildTableDispatch (struct regexTable *table)
+{
+	unsigned int count = ptrArrayCount (table->patterns);
+	unsigned int n = 0;
+
+	for (unsigned int i = 0; i < count; i++)
+	{
+		regexPattern *ptrn = ptrArrayItem (table->patterns, i);
+		if (!ptrn->prepared)
+			findFirstBytes (ptrn);
+	}
+
+	for (int c = 0; c < 256; c++)
+	{
+		table->dispatchStart [c] = n;
+		for (unsigned int i = 0; i < count; i++)
+		{
+			regexPattern *ptrn = ptrArrayItem (table->patterns, i);
+			if (!ptrn->firstBytes || ptrn->firstBytes [c])
+				n++;
+		}
+	}
+	table->dispatchStart [256] = n;
+
+	if (table->dispatch)
+		eFree (table->dispatch);
+	table->dispatch = xMalloc (n > 0? n: 1, unsigned int);
+
+	n = 0;
+	for (int c = 0; c < 256; c++)
+	{
+		for (unsigned int i = 0; i < count; i++)
+		{
+			regexPattern *ptrn = ptrArrayItem (table->patterns, i);
+			if (!ptrn->firstBytes || ptrn->firstBytes [c])
+				table->dispatch [n++] = i;
+		}
+	}
+	table->dispatchCount = count;
+}
 
 static void parseKinds (
 		const char* const kinds, char* const kind, char** const kindName,
@@ -992,7 +1590,7 @@ static vString* substitute (
 }
 
 static unsigned long getInputLineNumberInRegPType (enum regexParserType regptype,
-												   off_t offset)
+												   MIOOffset offset)
 {
 	return (regptype == REG_PARSER_MULTI_LINE || regptype == REG_PARSER_MULTI_TABLE)
 		? getInputLineNumberForFileOffset (offset)
@@ -1016,7 +1614,7 @@ static void matchTagPattern (struct lregexControlBlock *lcb,
 		const char* line,
 		const regexPattern* const patbuf,
 		const regmatch_t* const pmatch,
-			     off_t offset)
+			     MIOOffset offset)
 {
 	vString *const name = substitute (line,
 			patbuf->u.tag.name_pattern, BACK_REFERENCE_COUNT, pmatch);
@@ -1148,8 +1746,8 @@ static bool matchRegexPattern (struct lregexControlBlock *lcb,
 	if (patbuf->disabled && *(patbuf->disabled))
 		return false;
 
-	match = regexec (patbuf->pattern, vStringValue (line),
-			 BACK_REFERENCE_COUNT, pmatch, 0);
+	match = execPattern (patbuf, vStringValue (line), vStringLength (line),
+						 pmatch);
 	if (match == 0)
 	{
 		result = true;
@@ -1171,7 +1769,7 @@ static bool matchRegexPattern (struct lregexControlBlock *lcb,
 }
 
 static bool matchMultilineRegexPattern (struct lregexControlBlock *lcb,
-					const vString* const allLines,
+					const char *const allLines, size_t length,
 					regexPattern* patbuf)
 {
 	const char *start;
@@ -1184,15 +1782,14 @@ static bool matchMultilineRegexPattern (struct lregexControlBlock *lcb,
 	if (patbuf->disabled && *(patbuf->disabled))
 		return false;
 
-	start = vStringValue (allLines);
+	start = allLines;
 	for (current = start;
-	     match == 0 && current < start + vStringLength (allLines);
+	     match == 0 && current < start + length;
 	     current += (patbuf->mgroup.nextFromStart
 					 ? pmatch [patbuf->mgroup.forNextScanning].rm_so
 					 : pmatch [patbuf->mgroup.forNextScanning].rm_eo))
 	{
-		match = regexec (patbuf->pattern, current,
-				 BACK_REFERENCE_COUNT, pmatch, 0);
+		match = execPattern (patbuf, current, start + length - current, pmatch);
 		if (match == 0)
 		{
 			patbuf->statistics.match++;
@@ -1219,6 +1816,68 @@ static bool matchMultilineRegexPattern (struct lregexControlBlock *lcb,
 	return result;
 }
 
+static void prepareScreening (struct lregexControlBlock *lcb)
+{
+	ptrArray *patterns = lcb->patterns[REG_PARSER_SINGLE_LINE];
+	unsigned int count = ptrArrayCount (patterns);
+
+	if (lcb->screened)
+		eFree (lcb->screened);
+	lcb->screened = xMalloc (count > 0? count: 1, bool);
+	if (lcb->candidates)
+		eFree (lcb->candidates);
+	lcb->candidates = xMalloc (count > 0? count: 1, bool);
+
+	if (lcb->literals)
+		litMatcherDelete (lcb->literals);
+	lcb->literals = litMatcherNew ();
+	for (unsigned int i = 0; i < count; i++)
+	{
+		regexPattern* ptrn = ptrArrayItem(patterns, i);
+		if (!ptrn->prepared)
+			screenPattern (lcb, ptrn, i);
+		if (!ptrn->inRegexSet && ptrn->literal)
+			litMatcherAdd (lcb->literals, ptrn->literal, i);
+		lcb->screened [i] = (ptrn->inRegexSet || ptrn->literal);
+	}
+
+	lcb->screenDirty = false;
+}
+
+/* Tell which single line patterns may match LINE. A screened pattern
+ * (in the set, or having a literal) may match only if it is a candidate.
+ * Return NULL if the patterns must all be tried.
+ */
+static bool *screenLine (struct lregexControlBlock *lcb, const vString* const line)
+{
+	if (lcb->screenDirty || lcb->literals == NULL)
+		prepareScreening (lcb);
+
+	if (litMatcherCount (lcb->literals) == 0 && regexSetCount (lcb->set) == 0)
+		return NULL;
+
+	double start = (Option.profileRegex == REGEX_PROFILE_NONE)? 0.0: profileClock ();
+
+	beginTotalsPhase (PHASE_REGEX);
+	memset (lcb->candidates, 0,
+			sizeof (bool) * ptrArrayCount (lcb->patterns[REG_PARSER_SINGLE_LINE]));
+	if (regexSetCount (lcb->set) > 0)
+		regexSetMatch (lcb->set, vStringValue (line), vStringLength (line),
+					   lcb->candidates);
+	if (litMatcherCount (lcb->literals) > 0)
+		litMatcherScan (lcb->literals, vStringValue (line), vStringLength (line),
+						lcb->candidates);
+	endTotalsPhase ();
+
+	if (Option.profileRegex != REGEX_PROFILE_NONE)
+	{
+		lcb->screenStatistics.seconds += profileClock () - start;
+		lcb->screenStatistics.exec++;
+		lcb->screenStatistics.bytes += vStringLength (line);
+	}
+	return lcb->candidates;
+}
+
 /* PUBLIC INTERFACE */
 
 /* Match against all patterns for specified language. Returns true if at least
@@ -1228,8 +1887,20 @@ extern bool matchRegex (struct lregexControlBlock *lcb, const vString* const lin
 {
 	bool result = false;
 	unsigned int i;
+
+	/* A callback may come back here for the same lcb; the candidates
+	   are in use then, so the lines are not screened. */
+	bool *found = lcb->screenBusy? NULL: screenLine (lcb, line);
+	bool busy = lcb->screenBusy;
+	lcb->screenBusy = true;
+
 	for (i = 0  ;  i < ptrArrayCount(lcb->patterns[REG_PARSER_SINGLE_LINE])  ;  ++i)
 	{
+		/* regexec cannot match. The pattern is not looked at here, so
+		   its statistics don't count the line. */
+		if (found && !lcb->screenDirty && lcb->screened [i] && !found [i])
+			continue;
+
 		regexPattern* ptrn = ptrArrayItem(lcb->patterns[REG_PARSER_SINGLE_LINE], i);
 
 		if ((ptrn->xtagType != XTAG_UNKNOWN)
@@ -1243,11 +1914,40 @@ extern bool matchRegex (struct lregexControlBlock *lcb, const vString* const lin
 				break;
 		}
 	}
+
+	lcb->screenBusy = busy;
 	return result;
 }
 
+/* Compile the patterns of LCB which are not yet, reporting the invalid
+   ones in the order they were defined, whatever the input is. */
+static void compileRegexPatterns (struct lregexControlBlock *lcb)
+{
+	for (int t = REG_PARSER_SINGLE_LINE; t <= REG_PARSER_MULTI_LINE; t++)
+	{
+		for (unsigned int i = 0; i < ptrArrayCount (lcb->patterns [t]); i++)
+		{
+			regexPattern *ptrn = ptrArrayItem (lcb->patterns [t], i);
+			prepareRegex (ptrn->pattern);
+		}
+	}
+	for (unsigned int i = 0; i < ptrArrayCount (lcb->tables); i++)
+	{
+		struct regexTable *table = ptrArrayItem (lcb->tables, i);
+		for (unsigned int j = 0; j < ptrArrayCount (table->patterns); j++)
+		{
+			regexPattern *ptrn = ptrArrayItem (table->patterns, j);
+			prepareRegex (ptrn->pattern);
+		}
+	}
+	lcb->compileDirty = false;
+}
+
 extern void notifyRegexInputStart (struct lregexControlBlock *lcb)
 {
+	if (lcb->compileDirty)
+		compileRegexPatterns (lcb);
+
 	lcb->currentScope = CORK_NIL;
 
 	ptrArrayClear (lcb->tstack);
@@ -1343,9 +2043,9 @@ static regexPattern *addTagRegexInternal (struct lregexControlBlock *lcb,
 	if (!regexAvailable)
 		return NULL;
 
-	regex_t* const cp = compileRegex (regptype, regex, flags);
+	const int cflags = regexCompileFlags (regptype, flags);
+	regexCode* const cp = newRegex (regex, cflags);
 
-	if (cp != NULL)
 	{
 		char kind;
 		char* kindName;
@@ -1412,6 +2112,18 @@ extern void addTagMultiTableRegex(struct lregexControlBlock *lcb,
 	if (table_index < 0)
 		error (FATAL, "unknown table name: %s", table_name);
 
+	/* Like --_mtable-regex-<LANG>, match at the current offset only. */
+	if (regex [0] != '^')
+	{
+		vString *anchored = vStringNewInit ("^");
+
+		vStringCatS (anchored, regex);
+		addTagRegexInternal (lcb, table_index, REG_PARSER_MULTI_TABLE,
+							 vStringValue (anchored), name, kinds, flags, disabled);
+		vStringDelete (anchored);
+		return;
+	}
+
 	addTagRegexInternal (lcb, table_index, REG_PARSER_MULTI_TABLE, regex, name, kinds, flags,
 						 disabled);
 }
@@ -1429,13 +2141,11 @@ extern void addCallbackRegex (struct lregexControlBlock *lcb,
 		return;
 
 
-	regex_t* const cp = compileRegex (REG_PARSER_SINGLE_LINE, regex, flags);
-	if (cp != NULL)
-	{
-		regexPattern *rptr = addCompiledCallbackPattern (lcb, cp, callback, flags,
-														 disabled, userData);
-		rptr->pattern_string = escapeRegexPattern(regex);
-	}
+	const int cflags = regexCompileFlags (REG_PARSER_SINGLE_LINE, flags);
+	regexCode* const cp = newRegex (regex, cflags);
+	regexPattern *rptr = addCompiledCallbackPattern (lcb, cp, callback, flags,
+													 disabled, userData);
+	rptr->pattern_string = escapeRegexPattern(regex);
 }
 
 static void addTagRegexOption (struct lregexControlBlock *lcb,
@@ -1591,7 +2301,12 @@ extern bool regexNeedsMultilineBuffer (struct lregexControlBlock *lcb)
 		return false;
 }
 
-extern bool matchMultilineRegex (struct lregexControlBlock *lcb, const vString* const allLines)
+extern bool regexHasSingleLinePatterns (struct lregexControlBlock *lcb)
+{
+	return ptrArrayCount(lcb->patterns [REG_PARSER_SINGLE_LINE]) > 0;
+}
+
+extern bool matchMultilineRegex (struct lregexControlBlock *lcb, const char *const allLines, size_t length)
 {
 	bool result = false;
 
@@ -1605,7 +2320,7 @@ extern bool matchMultilineRegex (struct lregexControlBlock *lcb, const vString*
 			&& (!isXtagEnabled (ptrn->xtagType)))
 			continue;
 
-		result = matchMultilineRegexPattern (lcb, allLines, ptrn) || result;
+		result = matchMultilineRegexPattern (lcb, allLines, length, ptrn) || result;
 	}
 	return result;
 }
@@ -1678,43 +2393,63 @@ static void dumpTstack(FILE* fp, ptrArray *tstack)
 }
 
 static struct regexTable * matchMultitableRegexTable (struct lregexControlBlock *lcb,
-													  struct regexTable *table, const vString *const start, unsigned int *offset)
+													  struct regexTable *table, const char *const start, size_t length,
+													  size_t *offset)
 {
 	struct regexTable *next = NULL;
 	const char *current;
 	regmatch_t pmatch [BACK_REFERENCE_COUNT];
-	const char *cstart = vStringValue(start);
+	const char *cstart = start;
+	unsigned int first, last;
 
+	if (table->dispatch == NULL
+		|| table->dispatchCount != ptrArrayCount (table->patterns))
+		buildTableDispatch (table);
 
  restart:
 	current = cstart + *offset;
 
+	/* At the end of the input every pattern is tried: one may match the
+	   empty string. */
+	if (*offset < length)
+	{
+		first = table->dispatchStart [(unsigned char) *current];
+		last = table->dispatchStart [(unsigned char) *current + 1];
+	}
+	else
+	{
+		first = 0;
+		last = ptrArrayCount (table->patterns);
+	}
+
 #if 0
 	/* An empty regex // still matches empty input. */
-	if (*offset >= vStringLength(start))
+	if (*offset >= length)
 		goto out;
 #endif
 
-	for (unsigned int i = 0; i < ptrArrayCount(table->patterns); i++)
+	for (unsigned int j = first; j < last; j++)
 	{
+		unsigned int i = (*offset < length)? table->dispatch [j]: j;
 		regexPattern* ptrn = ptrArrayItem(table->patterns, i);
 
 		BEGIN_VERBOSE(vfp);
 		{
 			char s[3];
-			if (*current == '\n')
+			const char c = (*offset < length)? *current: '\0';
+			if (c == '\n')
 			{
 				s [0] = '\\';
 				s [1] = 'n';
 				s [2] = '\0';
 			}
-			else if (*current == '\t')
+			else if (c == '\t')
 			{
 				s [0] = '\\';
 				s [1] = 't';
 				s [2] = '\0';
 			}
-			else if (*current == '\\')
+			else if (c == '\\')
 			{
 				s [0] = '\\';
 				s [1] = '\\';
@@ -1722,7 +2457,7 @@ static struct regexTable * matchMultitableRegexTable (struct lregexControlBlock
 			}
 			else
 			{
-				s[0] = *current;
+				s[0] = c;
 				s[1] = '\0';
 			}
 
@@ -1741,8 +2476,16 @@ static struct regexTable * matchMultitableRegexTable (struct lregexControlBlock
 		if (ptrn->disabled && *(ptrn->disabled))
 			continue;
 
-		match = regexec (ptrn->pattern, current,
-						 BACK_REFERENCE_COUNT, pmatch, 0);
+		if (ptrn->singleByte && *offset < length)
+		{
+			/* Dispatched on the byte, the pattern matches it. */
+			pmatch [0].rm_so = 0;
+			pmatch [0].rm_eo = 1;
+			for (unsigned int k = 1; k < BACK_REFERENCE_COUNT; k++)
+				pmatch [k].rm_so = pmatch [k].rm_eo = -1;
+		}
+		else
+			match = execPattern (ptrn, current, length - *offset, pmatch);
 
 		if (match == 0)
 		{
@@ -1921,13 +2664,148 @@ extern void printMultitableStatistics (struct lregexControlBlock *lcb, FILE *vfp
 	}
 }
 
-extern bool matchMultitableRegex (struct lregexControlBlock *lcb, const vString* const allLines)
+struct regexProfileEntry {
+	const char *language;
+	const char *type;			/* "regex", "mline", a table name, or "screen" */
+	const char *pattern;
+	const struct regexStatistics *statistics;
+	unsigned int index;
+};
+
+static void addRegexProfileEntry (ptrArray *entries, const char *language,
+								  const char *type, const char *pattern,
+								  const struct regexStatistics *statistics)
+{
+	struct regexProfileEntry *e;
+
+	if (statistics->exec == 0 && statistics->match == 0)
+		return;
+
+	e = xMalloc (1, struct regexProfileEntry);
+	e->language = language;
+	e->type = type;
+	e->pattern = pattern;
+	e->statistics = statistics;
+	e->index = ptrArrayCount (entries);
+	ptrArrayAdd (entries, e);
+}
+
+extern void addRegexProfileEntries (struct lregexControlBlock *lcb, ptrArray *entries)
+{
+	const char *language = getLanguageName (lcb->owner);
+	static const char *const types [] = {
+		[REG_PARSER_SINGLE_LINE] = "regex",
+		[REG_PARSER_MULTI_LINE] = "mline",
+	};
+
+	addRegexProfileEntry (entries, language, "screen", "",
+						  &lcb->screenStatistics);
+	for (int t = REG_PARSER_SINGLE_LINE; t <= REG_PARSER_MULTI_LINE; t++)
+	{
+		for (unsigned int i = 0; i < ptrArrayCount (lcb->patterns [t]); i++)
+		{
+			regexPattern *ptrn = ptrArrayItem (lcb->patterns [t], i);
+			addRegexProfileEntry (entries, language, types [t],
+								  ptrn->pattern_string, &ptrn->statistics);
+		}
+	}
+
+	/* A pattern shared by tables with --_mtable-extend-<LANG> is listed
+	   in the first of them. */
+	ptrArray *seen = ptrArrayNew (NULL);
+	for (unsigned int i = 0; i < ptrArrayCount (lcb->tables); i++)
+	{
+		struct regexTable *table = ptrArrayItem (lcb->tables, i);
+		for (unsigned int j = 0; j < ptrArrayCount (table->patterns); j++)
+		{
+			regexPattern *ptrn = ptrArrayItem (table->patterns, j);
+			if (ptrArrayHas (seen, ptrn))
+				continue;
+			ptrArrayAdd (seen, ptrn);
+			addRegexProfileEntry (entries, language, table->name,
+								  ptrn->pattern_string, &ptrn->statistics);
+		}
+	}
+	ptrArrayDelete (seen);
+}
+
+static int compareRegexProfileEntries (const void *a, const void *b)
+{
+	const struct regexProfileEntry *ea = a;
+	const struct regexProfileEntry *eb = b;
+
+	if (ea->statistics->seconds != eb->statistics->seconds)
+		return (ea->statistics->seconds < eb->statistics->seconds)? 1: -1;
+	if (ea->statistics->exec != eb->statistics->exec)
+		return (ea->statistics->exec < eb->statistics->exec)? 1: -1;
+	return (ea->index < eb->index)? -1: 1;
+}
+
+static void printJsonString (FILE *fp, const char *s)
+{
+	fputc ('"', fp);
+	for (; *s; s++)
+	{
+		unsigned char c = (unsigned char) *s;
+		if (c == '"' || c == '\\')
+			fprintf (fp, "\\%c", c);
+		else if (c < 0x20)
+			fprintf (fp, "\\u%04x", c);
+		else
+			fputc (c, fp);
+	}
+	fputc ('"', fp);
+}
+
+extern void printRegexProfileEntries (ptrArray *entries, bool json, FILE *fp)
+{
+	ptrArraySort (entries, compareRegexProfileEntries);
+
+	if (json)
+		fputs ("[\n", fp);
+	else
+	{
+		fputs ("REGEX PROFILE\n", fp);
+		fputs ("==============================================\n", fp);
+		fprintf (fp, "%10s %10s %12s %10s  %-15s %-15s %s\n",
+				 "time(ms)", "regexec", "bytes", "matches",
+				 "language", "type", "pattern");
+	}
+
+	for (unsigned int i = 0; i < ptrArrayCount (entries); i++)
+	{
+		struct regexProfileEntry *e = ptrArrayItem (entries, i);
+		const struct regexStatistics *st = e->statistics;
+
+		if (json)
+		{
+			fputs ("  {\"language\": ", fp);
+			printJsonString (fp, e->language);
+			fputs (", \"type\": ", fp);
+			printJsonString (fp, e->type);
+			fputs (", \"pattern\": ", fp);
+			printJsonString (fp, e->pattern);
+			fprintf (fp, ", \"seconds\": %.6f, \"regexec\": %lu, \"bytes\": %lu, \"matches\": %u}%s\n",
+					 st->seconds, st->exec, st->bytes, st->match,
+					 (i + 1 < ptrArrayCount (entries))? ",": "");
+		}
+		else
+			fprintf (fp, "%10.3f %10lu %12lu %10u  %-15s %-15s %s\n",
+					 st->seconds * 1000, st->exec, st->bytes, st->match,
+					 e->language, e->type, e->pattern);
+	}
+
+	if (json)
+		fputs ("]\n", fp);
+}
+
+extern bool matchMultitableRegex (struct lregexControlBlock *lcb, const char *const allLines, size_t length)
 {
 	if (ptrArrayCount (lcb->tables) == 0)
 		return false;
 
 	struct regexTable *table = ptrArrayItem (lcb->tables, 0);
-	unsigned int offset = 0;
+	size_t offset = 0;
 
 	while (table)
 	{
@@ -1935,7 +2813,7 @@ extern bool matchMultitableRegex (struct lregexControlBlock *lcb, const vString*
 		BEGIN_VERBOSE(vfp);
 		{
 			vString *v = vStringNew ();
-			for (const char *c = vStringValue(allLines) + offset; *c && (*c != '\n'); c++)
+			for (const char *c = allLines + offset; c < allLines + length && (*c != '\n'); c++)
 				vStringPut(v, *c);
 
 			fprintf (vfp, "input : \"%s\" L%lu\n",
@@ -1944,7 +2822,7 @@ extern bool matchMultitableRegex (struct lregexControlBlock *lcb, const vString*
 			vStringDelete(v);
 		}
 		END_VERBOSE();
-		table = matchMultitableRegexTable(lcb, table, allLines, &offset);
+		table = matchMultitableRegexTable(lcb, table, allLines, length, &offset);
 	}
 
 	return true;
@@ -17,6 +17,8 @@
 #define CTAGS_MAIN_LREGEX_H
 #include "general.h"
 
+#include "ptrarray.h"
+
 typedef struct {
 	const char *const regex;
 	const char* const name;
@@ -71,8 +73,9 @@ extern void addCallbackRegex (struct lregexControlBlock *lcb,
 							  bool *disabled,
 							  void * userData);
 extern bool regexNeedsMultilineBuffer (struct lregexControlBlock *lcb);
-extern bool matchMultilineRegex (struct lregexControlBlock *lcb, const vString* const allLines);
-extern bool matchMultitableRegex (struct lregexControlBlock *lcb, const vString* const allLines);
+extern bool regexHasSingleLinePatterns (struct lregexControlBlock *lcb);
+extern bool matchMultilineRegex (struct lregexControlBlock *lcb, const char *const allLines, size_t length);
+extern bool matchMultitableRegex (struct lregexControlBlock *lcb, const char *const allLines, size_t length);
 
 extern void notifyRegexInputStart (struct lregexControlBlock *lcb);
 extern void notifyRegexInputEnd (struct lregexControlBlock *lcb);
@@ -82,4 +85,9 @@ extern void extendRegexTable (struct lregexControlBlock *lcb, const char *src, c
 
 extern void printMultitableStatistics (struct lregexControlBlock *lcb, FILE *vfp);
 
+/* --_profile-regex: add the patterns of LCB which ran to ENTRIES, then
+   print ENTRIES ranked by the time they took. */
+extern void addRegexProfileEntries (struct lregexControlBlock *lcb, ptrArray *entries);
+extern void printRegexProfileEntries (ptrArray *entries, bool json, FILE *fp);
+
 #endif	/* CTAGS_MAIN_LREGEX_H */
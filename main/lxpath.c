@@ -11,6 +11,8 @@
 #include "general.h"  /* must always come first */
 #include "debug.h"
 #include "entry.h"
+#include "field.h"
+#include "htable.h"
 #include "options.h"
 #include "parse.h"
 #include "read.h"
@@ -18,6 +20,7 @@
 #include "xtag.h"
 
 #ifdef HAVE_LIBXML
+#include <libxml/parser.h>
 #include <libxml/xpath.h>
 #include <libxml/tree.h>
 
@@ -28,7 +31,7 @@ static void simpleXpathMakeTag (xmlNode *node,
 {
 	tagEntryInfo tag;
 	xmlChar* str;
-	char *path;
+	char *path = NULL;
 
 	str = xmlNodeGetContent(node);
 	if (str == NULL)
@@ -47,8 +50,13 @@ static void simpleXpathMakeTag (xmlNode *node,
 	tag.lineNumber = xmlGetLineNo (node);
 	tag.filePosition = getInputFilePositionForLine (tag.lineNumber);
 
-	path = (char *)xmlGetNodePath (node);
-	tag.extensionFields.xpath = path;
+	/* xmlGetNodePath () counts the preceding siblings of each ancestor:
+	   don't pay for it on every tag of a large document. */
+	if (isFieldEnabled (FIELD_XPATH))
+	{
+		path = (char *)xmlGetNodePath (node);
+		tag.extensionFields.xpath = path;
+	}
 
 	if (spec->make)
 		spec->make (node, spec, &tag, userData);
@@ -61,15 +69,51 @@ out:
 	xmlFree (str);
 }
 
+/* The expressions compiled in this process, by their strings: the
+   entries of the tables of the parsers having the same expression, like
+   the "./@name" of most of the XSLT tables, share it. */
+static hashTable *CompiledXpaths;
+
+/* Stands for an expression which doesn't compile in CompiledXpaths. */
+static char XpathCompileFailure;
+
 extern void addTagXpath (const langType language CTAGS_ATTR_UNUSED, tagXpathTable *xpathTable)
 {
 	Assert (xpathTable->xpath);
-	Assert (!xpathTable->xpathCompiled);
 
-	verbose ("compile a xpath expression: %s\n", (xmlChar *)xpathTable->xpath);
-	xpathTable->xpathCompiled = xmlXPathCompile ((xmlChar *)xpathTable->xpath);
-	if (!xpathTable->xpathCompiled)
-		error (WARNING, "Failed to compile the Xpath expression: %s", xpathTable->xpath);
+	/* The expression is compiled when it is evaluated first. */
+	xpathTable->xpathCompiled = NULL;
+}
+
+static xmlXPathCompExpr *getCompiledXpath (const tagXpathTable *elt)
+{
+	void *compiled;
+
+	if (elt->xpathCompiled)
+		return elt->xpathCompiled;
+
+	if (CompiledXpaths == NULL)
+		CompiledXpaths = hashTableNew (64, hashCstrhash, hashCstreq, NULL, NULL);
+
+	compiled = hashTableGetItem (CompiledXpaths, elt->xpath);
+	if (compiled == NULL)
+	{
+		verbose ("compile a xpath expression: %s\n", elt->xpath);
+		compiled = xmlXPathCompile ((xmlChar *)elt->xpath);
+		if (compiled == NULL)
+		{
+			error (WARNING, "Failed to compile the Xpath expression: %s", elt->xpath);
+			compiled = &XpathCompileFailure;
+		}
+		hashTablePutItem (CompiledXpaths, (void *) elt->xpath, compiled);
+	}
+	if (compiled == &XpathCompileFailure)
+		return NULL;
+
+	/* The tables of the parsers are not const: their entries keep what
+	   they have found. */
+	((tagXpathTable *) elt)->xpathCompiled = compiled;
+	return compiled;
 }
 
 static void findXMLTagsCore (xmlXPathContext *ctx, xmlNode *root,
@@ -88,8 +132,9 @@ static void findXMLTagsCore (xmlXPathContext *ctx, xmlNode *root,
 		xmlXPathObject *object;
 		xmlNodeSet *set;
 		const tagXpathTable *elt = xpathTableTable->table + i;
+		xmlXPathCompExpr *compiled = getCompiledXpath (elt);
 
-		if (! elt->xpathCompiled)
+		if (! compiled)
 			continue;
 
 #if 0
@@ -103,7 +148,7 @@ static void findXMLTagsCore (xmlXPathContext *ctx, xmlNode *root,
 		ctx->node = root;
 #endif
 
-		object = xmlXPathCompiledEval (elt->xpathCompiled, ctx);
+		object = xmlXPathCompiledEval (compiled, ctx);
 		if (!object)
 			continue;
 
@@ -143,10 +188,16 @@ static xmlDocPtr makeXMLDoc (void)
 
 	data = getInputFileData (&size);
 	if (data)
-	{
-		xmlLineNumbersDefault (1);
-		doc = xmlParseMemory((const char*)data, size);
-	}
+		/* The text nodes made only of the indentation between elements
+		   are dropped, and the short ones are stored in their node: the
+		   tree of a large generated file is mostly made of them. Line
+		   numbers past 65535 are kept in the nodes, where
+		   xmlGetLineNo () finds them without walking the text nodes
+		   around. */
+		doc = xmlReadMemory ((const char*)data, size, getInputFileName (), NULL,
+							 XML_PARSE_NONET | XML_PARSE_NOBLANKS | XML_PARSE_COMPACT
+							 | XML_PARSE_BIG_LINES | XML_PARSE_HUGE
+							 | XML_PARSE_NOERROR | XML_PARSE_NOWARNING);
 
 	return doc;
 }
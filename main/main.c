@@ -44,6 +44,12 @@
 # endif
 #endif
 
+/*  To tell the peak of the memory in use for --totals=json.
+ */
+#if defined (HAVE_GETRUSAGE) && defined (HAVE_SYS_RESOURCE_H)
+# include <sys/resource.h>
+#endif
+
 /*  To provide directory searching for recursion feature.
  */
 
@@ -53,32 +59,81 @@
 # endif
 # include <dirent.h>  /* to declare opendir() */
 #endif
+#if defined (HAVE_OPENAT) && defined (HAVE_FDOPENDIR) && defined (HAVE_DIRFD)
+# define USE_DIRECTORY_FDS
+# include <fcntl.h>  /* to declare openat () */
+# include <unistd.h>  /* to declare close () */
+# ifndef O_DIRECTORY
+#  define O_DIRECTORY 0
+# endif
+# ifndef O_CLOEXEC
+#  define O_CLOEXEC 0
+# endif
+#endif
 #ifdef HAVE_DIRECT_H
 # include <direct.h>  /* to _getcwd() */
 #endif
 #ifdef HAVE_IO_H
 # include <io.h>  /* to declare _findfirst() */
 #endif
+#if defined (HAVE__FINDFIRST) && defined (_WIN32)
+# define USE_FIND_FIRST_FILE_EX
+# ifndef WIN32_LEAN_AND_MEAN
+#  define WIN32_LEAN_AND_MEAN
+# endif
+# include <windows.h>  /* to declare FindFirstFileExA() */
+/* Windows 7 or newer: older systems reject these, and are asked again
+   without them. */
+# ifndef FIND_FIRST_EX_LARGE_FETCH
+#  define FIND_FIRST_EX_LARGE_FETCH 2
+# endif
+# define FIND_EX_INFO_BASIC ((FINDEX_INFO_LEVELS) 1)	/* FindExInfoBasic */
+#endif
+
+/*  To provide parallel parsing with worker processes (--jobs).
+ */
+#ifdef HAVE_WORKING_FORK
+# include <unistd.h>
+# include <errno.h>
+# include <fcntl.h>
+# include <poll.h>
+# ifdef HAVE_SYS_WAIT_H
+#  include <sys/wait.h>
+# endif
+#endif
 
 
+#include "args.h"
+#include "cache.h"
 #include "ctags.h"
 #include "debug.h"
 #include "entry.h"
+#include "gittree.h"
 #include "error.h"
 #include "field.h"
+#include "ignorefile.h"
 #include "keyword.h"
 #include "main.h"
+#include "mio.h"
 #include "options.h"
+#include "ptag.h"
 #include "read.h"
 #include "routines.h"
+#include "tagbuffer.h"
+#include "tagindex.h"
 #include "trace.h"
+#include "traceevent.h"
 #include "trashbox.h"
 #include "writer.h"
+#include "xtag.h"
 
 #ifdef HAVE_JANSSON
 #include "interactive.h"
 #include <jansson.h>
 #include <errno.h>
+#ifdef HAVE_UNISTD_H
+#include <unistd.h>  /* to read () the requests */
+#endif
 #endif
 
 /*
@@ -86,17 +141,65 @@
 */
 #define plural(value)  (((unsigned long)(value) == 1L) ? "" : "s")
 
+/*  How many of the files found next are prefetched while one is parsed.
+ */
+#define PREFETCH_DEPTH 16
+
 /*
 *   DATA DEFINITIONS
 */
-static struct { long files, lines, bytes; } Totals = { 0, 0, 0 };
+static struct { long files, lines, bytes, rescans; } Totals = { 0, 0, 0, 0 };
+
+/*  The files parsed the most slowly, for --report-slow, the slowest
+ *  first. LastSlowFile is the one parsed last, which a worker reports.
+ */
+struct slowFile {
+	char *name;
+	langType language;
+	long size;
+	double seconds;
+};
+static struct slowFile *SlowFiles;
+static unsigned int SlowFileCount;
+static struct slowFile LastSlowFile = { NULL, LANG_IGNORE, 0, 0.0 };
 static mainLoopFunc mainLoop;
 static void *mainData;
 
+/*  Input files found for the worker processes of --jobs. NULL while
+ *  files are parsed as soon as they are found.
+ */
+static stringList *JobQueue;
+
+/*  The files found last, parsed in this process when PREFETCH_DEPTH more
+ *  are found: the system reads them while the ones before are parsed.
+ *  Not used with JobQueue, nor when each file is answered before the
+ *  next one is read.
+ */
+static struct {
+	bool enabled;
+	char *names [PREFETCH_DEPTH];
+	unsigned int first;
+	unsigned int count;
+} Prefetch;
+
+/*  The tag index of interactive mode while files are added to it: the
+ *  files found are parsed into the index instead of the tag file.
+ */
+static tagIndex *IndexBeingFilled;
+
 /*
 *   FUNCTION PROTOTYPES
 */
 static bool createTagsForEntry (const char *const entryName);
+static bool createTagsForStatus (const char *const entryName,
+								 const fileStatus *const status);
+static void queueJob (const char *const fileName);
+#if defined (HAVE_WORKING_FORK) && defined (HAVE_JANSSON)
+static bool runInteractiveJob (const char *name, const char *idText,
+							   const char *mapped, long offset,
+							   const char *content, long contentLength,
+							   double deadline, MIO *output);
+#endif
 
 /*
 *   FUNCTION DEFINITIONS
@@ -111,6 +214,63 @@ extern void addTotals (
 	Totals.bytes += bytes;
 }
 
+extern void getTotals (long *files, long *lines, long *bytes)
+{
+	*files = Totals.files;
+	*lines = Totals.lines;
+	*bytes = Totals.bytes;
+}
+
+/*  Count a pass of a parser over an input it has scanned already */
+extern void addRescan (void)
+{
+	Totals.rescans++;
+}
+
+extern void addSlowFile (const char *const fileName, const langType language,
+						 long size, double seconds)
+{
+	unsigned int i;
+
+	LastSlowFile.language = language;
+	LastSlowFile.size = size;
+	LastSlowFile.seconds = seconds;
+
+	if (SlowFiles == NULL)
+		SlowFiles = xMalloc (Option.reportSlow, struct slowFile);
+	else if (SlowFileCount == Option.reportSlow
+			 && SlowFiles [SlowFileCount - 1].seconds >= seconds)
+		return;
+
+	if (SlowFileCount == Option.reportSlow)
+		eFree (SlowFiles [--SlowFileCount].name);
+	for (i = SlowFileCount; i > 0 && SlowFiles [i - 1].seconds < seconds; i--)
+		SlowFiles [i] = SlowFiles [i - 1];
+	SlowFiles [i].name = eStrdup (fileName);
+	SlowFiles [i].language = language;
+	SlowFiles [i].size = size;
+	SlowFiles [i].seconds = seconds;
+	SlowFileCount++;
+}
+
+static void printSlowFiles (void)
+{
+	unsigned int i;
+
+	fprintf (stderr, "%u slowest file%s:\n", SlowFileCount, plural (SlowFileCount));
+	for (i = 0; i < SlowFileCount; i++)
+	{
+		fprintf (stderr, "%8.3f s  %-14s %10ld bytes  %s\n",
+				 SlowFiles [i].seconds, getLanguageName (SlowFiles [i].language),
+				 SlowFiles [i].size, SlowFiles [i].name);
+		eFree (SlowFiles [i].name);
+	}
+	if (SlowFiles)
+		eFree (SlowFiles);
+	SlowFiles = NULL;
+	SlowFileCount = 0;
+}
+
 extern bool isDestinationStdout (void)
 {
 	bool toStdout = false;
@@ -127,15 +287,86 @@ extern bool isDestinationStdout (void)
 }
 
 #if defined (HAVE_OPENDIR)
+/*  The type of an entry given by readdir () tells a regular file or a
+ *  directory from the other entries without lstat (), unless the status
+ *  is needed anyway: the manifest and the tag index record the mtimes
+ *  and sizes of the files. The rest of the status (e.g. whether a file
+ *  is executable, for guessing its parser) is read by eStat () when
+ *  asked for. Other entries are looked up from DIRFD, the directory
+ *  being read.
+ */
+static bool createTagsForDirectoryEntry (const char *const entryName,
+										 const struct dirent *const entry,
+										 int dirFd)
+{
+	fileStatus *status;
+	bool resize;
+
+#ifdef HAVE_STRUCT_DIRENT_D_TYPE
+	if ((entry->d_type == DT_REG || entry->d_type == DT_DIR)
+		&& ! Option.manifest && ! IndexBeingFilled)
+	{
+		fileStatus known;
+
+		memset (&known, 0, sizeof (known));
+		known.exists = true;
+		known.isDirectory = (entry->d_type == DT_DIR);
+		known.isNormalFile = (entry->d_type == DT_REG);
+		return createTagsForStatus (entryName, &known);
+	}
+#endif
+
+	status = eStatAt (dirFd, entry->d_name, entryName);
+	resize = createTagsForStatus (entryName, status);
+	eStatFree (status);
+	return resize;
+}
+
+/*  Where openat () is available, a directory met while recursing is
+ *  opened from the directory holding it, and its entries are looked up
+ *  and opened from it (see setInputDirectory ()), so the kernel does not
+ *  walk the whole path of each entry again. The paths are still made
+ *  for the output and the exclude patterns.
+ */
+static DIR *openDirectory (const char *const dirName)
+{
+#if defined (USE_DIRECTORY_FDS)
+	int parentFd, fd;
+	const char *const name = getInputDirectoryEntry (dirName, &parentFd);
+	DIR *dir;
+
+	if (name == NULL)
+		return opendir (dirName);
+
+	fd = openat (parentFd, name, O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+	if (fd < 0)
+		return NULL;
+	dir = fdopendir (fd);
+	if (dir == NULL)
+		close (fd);
+	return dir;
+#else
+	return opendir (dirName);
+#endif
+}
+
 static bool recurseUsingOpendir (const char *const dirName)
 {
 	bool resize = false;
-	DIR *const dir = opendir (dirName);
+	DIR *const dir = openDirectory (dirName);
 	if (dir == NULL)
 		error (WARNING | PERROR, "cannot recurse into directory \"%s\"", dirName);
 	else
 	{
 		struct dirent *entry;
+		int dirFd = -1;
+#if defined (USE_DIRECTORY_FDS)
+		const char *parentName;
+		const int parentFd = getInputDirectory (&parentName);
+
+		dirFd = dirfd (dir);
+		setInputDirectory (dirFd, dirName);
+#endif
 		while ((entry = readdir (dir)) != NULL)
 		{
 			if (strcmp (entry->d_name, ".") != 0  &&
@@ -150,11 +381,14 @@ static bool recurseUsingOpendir (const char *const dirName)
 					filePath = combinePathAndFile (dirName, entry->d_name);
 					free_p = true;
 				}
-				resize |= createTagsForEntry (filePath);
+				resize |= createTagsForDirectoryEntry (filePath, entry, dirFd);
 				if (free_p)
 					eFree (filePath);
 			}
 		}
+#if defined (USE_DIRECTORY_FDS)
+		setInputDirectory (parentFd, parentName);
+#endif
 		closedir (dir);
 	}
 	return resize;
@@ -183,7 +417,27 @@ static bool createTagsForWildcardUsingFindfirst (const char *const pattern)
 {
 	bool resize = false;
 	const size_t dirLength = baseFilename (pattern) - pattern;
-#if defined (HAVE__FINDFIRST)
+#if defined (USE_FIND_FIRST_FILE_EX)
+	/* Without the short names, and fetching the entries in large
+	   batches, a directory is read in fewer calls than with _findfirst(). */
+	WIN32_FIND_DATAA data;
+	HANDLE handle = FindFirstFileExA (pattern, FIND_EX_INFO_BASIC, &data,
+									  FindExSearchNameMatch, NULL,
+									  FIND_FIRST_EX_LARGE_FETCH);
+	if (handle == INVALID_HANDLE_VALUE
+		&& GetLastError () == ERROR_INVALID_PARAMETER)
+		handle = FindFirstFileExA (pattern, FindExInfoStandard, &data,
+								   FindExSearchNameMatch, NULL, 0);
+	if (handle != INVALID_HANDLE_VALUE)
+	{
+		do
+		{
+			const char *const entry = (const char *) data.cFileName;
+			resize |= createTagsForWildcardEntry (pattern, dirLength, entry);
+		} while (FindNextFileA (handle, &data));
+		FindClose (handle);
+	}
+#elif defined (HAVE__FINDFIRST)
 	struct _finddata_t fileInfo;
 	findfirst_t hFile = _findfirst (pattern, &fileInfo);
 	if (hFile != -1L)
@@ -202,16 +456,18 @@ static bool createTagsForWildcardUsingFindfirst (const char *const pattern)
 #endif
 
 
-static bool recurseIntoDirectory (const char *const dirName)
+/*  DIRNAME is known not to be a symbolic link unless MAYBELINK.
+ */
+static bool recurseIntoDirectory (const char *const dirName, bool maybeLink)
 {
 	static unsigned int recursionDepth = 0;
 
 	recursionDepth++;
 
 	bool resize = false;
-	if (isRecursiveLink (dirName))
+	if (maybeLink && isRecursiveLink (dirName))
 		verbose ("ignoring \"%s\" (recursive link)\n", dirName);
-	else if (! Option.recurse)
+	else if (! Option.recurse && ! IndexBeingFilled)	/* a watched directory is indexed anyway */
 		verbose ("ignoring \"%s\" (directory)\n", dirName);
 	else if(recursionDepth > Option.maxRecursionDepth)
 		verbose ("not descending in directory \"%s\" (depth %u > %u)\n",
@@ -219,6 +475,15 @@ static bool recurseIntoDirectory (const char *const dirName)
 	else
 	{
 		verbose ("RECURSING into directory \"%s\"\n", dirName);
+		/* The files found in it get their tags again, those gone and
+		   those in the directories gone lose them. With --manifest, the
+		   unchanged files keep theirs, and the manifest tells the gone
+		   ones. */
+		if (Option.update && ! Option.manifest && ! IndexBeingFilled)
+			forgetTagsUnderDirectory (dirName);
+		if (IndexBeingFilled)
+			tagIndexAddDirectory (IndexBeingFilled, dirName);
+		enterIgnoreFileDirectory (dirName);
 #if defined (HAVE_OPENDIR)
 		resize = recurseUsingOpendir (dirName);
 #elif defined (HAVE__FINDFIRST)
@@ -231,6 +496,7 @@ static bool recurseIntoDirectory (const char *const dirName)
 			vStringDelete (pattern);
 		}
 #endif
+		leaveIgnoreFileDirectory ();
 	}
 
 	recursionDepth--;
@@ -238,24 +504,89 @@ static bool recurseIntoDirectory (const char *const dirName)
 	return resize;
 }
 
-static bool createTagsForEntry (const char *const entryName)
+static bool parsePrefetchedFile (void)
+{
+	char *const name = Prefetch.names [Prefetch.first];
+	const bool resize = parseFile (name);
+
+	eFree (name);
+	Prefetch.first = (Prefetch.first + 1) % PREFETCH_DEPTH;
+	Prefetch.count--;
+	return resize;
+}
+
+/*  Parse the files prefetched, in the order they were found.
+ */
+static bool parsePrefetchedFiles (void)
+{
+	bool resize = false;
+
+	while (Prefetch.count > 0)
+		resize |= parsePrefetchedFile ();
+	return resize;
+}
+
+static bool prefetchFile (const char *const fileName)
+{
+	bool resize = false;
+
+	if (Prefetch.count == PREFETCH_DEPTH)
+		resize = parsePrefetchedFile ();
+	mio_prefetch_file (fileName);
+	Prefetch.names [(Prefetch.first + Prefetch.count++) % PREFETCH_DEPTH]
+		= eStrdup (fileName);
+	return resize;
+}
+
+static bool createTagsForStatus (const char *const entryName,
+								 const fileStatus *const status)
 {
 	bool resize = false;
-	fileStatus *status = eStat (entryName);
 
 	Assert (entryName != NULL);
 	if (isExcludedFile (entryName))
 		verbose ("excluding \"%s\"\n", entryName);
+	else if (isIgnoredByIgnoreFiles (entryName, status->isDirectory))
+		verbose ("ignoring \"%s\" (ignore file)\n", entryName);
 	else if (status->isSymbolicLink  &&  ! Option.followLinks)
 		verbose ("ignoring \"%s\" (symbolic link)\n", entryName);
 	else if (! status->exists)
-		error (WARNING | PERROR, "cannot open input file \"%s\"", entryName);
+	{
+		if (Option.update)
+		{
+			verbose ("removing tags of \"%s\" (deleted file or directory)\n", entryName);
+			forgetTagsOfFile (entryName);
+			forgetTagsUnderDirectory (entryName);
+		}
+		else
+			error (WARNING | PERROR, "cannot open input file \"%s\"", entryName);
+	}
 	else if (status->isDirectory)
-		resize = recurseIntoDirectory (entryName);
+		resize = recurseIntoDirectory (entryName, status->isSymbolicLink);
 	else if (! status->isNormalFile)
 		verbose ("ignoring \"%s\" (special file)\n", entryName);
+	else if (IndexBeingFilled)
+		tagIndexAddFile (IndexBeingFilled, entryName, status);
+	else if (Option.manifest && recordFileInManifest (entryName, status))
+		verbose ("skipping \"%s\" (unchanged)\n", entryName);
 	else
-		resize = parseFile (entryName);
+	{
+		if (Option.update || Option.manifest)
+			forgetTagsOfFile (entryName);
+		if (JobQueue)
+			queueJob (entryName);
+		else if (Prefetch.enabled)
+			resize = prefetchFile (entryName);
+		else
+			resize = parseFile (entryName);
+	}
+	return resize;
+}
+
+static bool createTagsForEntry (const char *const entryName)
+{
+	fileStatus *status = eStat (entryName);
+	bool resize = createTagsForStatus (entryName, status);
 
 	eStatFree (status);
 	return resize;
@@ -287,208 +618,2390 @@ static bool createTagsForWildcardArg (const char *const arg)
 
 #endif
 
-static bool createTagsForArgs (cookedArgs *const args)
+#ifdef HAVE_WORKING_FORK
+/*  How many files a worker may have been given without having finished
+ *  them. Keeping one in reserve lets the worker go on while the parent
+ *  is busy reading directories.
+ */
+#define WORKER_QUEUE_DEPTH 2
+
+struct jobRequest {
+	unsigned int index;			/* in JobQueue, or of the interactive job */
+	unsigned int length;		/* of the file name following the request */
+	unsigned int idLength;		/* of the "id" of an interactive request
+								   following the name */
+	unsigned int mappedLength;	/* of the name of the file mapped for the
+								   contents following the id, or 0 */
+	long offset;				/* of the contents in the mapped file */
+	long contentLength;			/* of the contents following the id, or in
+								   the mapped file, or -1 to read the file
+								   or the rest of the mapped file */
+	double deadline;			/* of an interactive request, or 0.0 */
+};
+
+/*  Followed by the output for the file, fragment.size bytes.
+ */
+struct jobReport {
+	unsigned int index;
+	long files, lines, bytes, rescans;
+	langType language;			/* of the file for --report-slow, or LANG_IGNORE */
+	long size;
+	double seconds;
+	bool timedOut;				/* past the deadline of the request */
+	tagFileFragment fragment;
+};
+
+typedef struct sWorker {
+	pid_t pid;
+	int requestFd;
+	int reportFd;
+	unsigned int pending;		/* files given but not reported yet */
+} worker;
+
+/*  The output for a file reported by a worker, waiting for the output
+ *  for the files before it.
+ */
+struct jobResult {
+	bool ready;
+	tagFileFragment fragment;
+	char *output;
+};
+
+/*  Directories are walked in the parent process. Each file found is
+ *  given to the least busy worker as soon as one can take it, so reading
+ *  directories overlaps with parsing, and a worker slowed down by a
+ *  large file does not hold the others.
+ */
+static struct sJobScheduler {
+	worker *workers;
+	unsigned int count;			/* of workers */
+	bool sandbox;				/* workers enter the sandbox of interactive mode */
+	unsigned int dispatched;	/* files of JobQueue given to workers */
+	unsigned int committed;		/* files whose output is in the tag file */
+	struct jobResult *results;	/* indexed like JobQueue */
+	unsigned int size;			/* of results */
+} Scheduler;
+
+/*  How far the workers may get ahead of the first file not committed
+ *  yet, in files per worker; this bounds the memory held by results.
+ *  Once the memory is tight (--memory-limit), a worker gets one file.
+ */
+#define COMMIT_WINDOW_PER_WORKER 64
+
+static bool readFully (int fd, void *buf, size_t size)
 {
-	bool resize = false;
+	char *p = buf;
+	size_t done = 0;
 
-	/*  Generate tags for each argument on the command line.
-	 */
-	while (! cArgOff (args))
+	while (done < size)
 	{
-		const char *const arg = cArgItem (args);
-
-#ifdef MANUAL_GLOBBING
-		resize |= createTagsForWildcardArg (arg);
-#else
-		resize |= createTagsForEntry (arg);
-#endif
-		cArgForth (args);
-		parseCmdlineOptions (args);
+		ssize_t n = read (fd, p + done, size - done);
+		if (n < 0 && errno == EINTR)
+			continue;
+		if (n < 0)
+			error (FATAL | PERROR, "cannot read from a pipe for a worker");
+		if (n == 0)
+		{
+			if (done == 0)
+				return false;
+			error (FATAL, "short read from a pipe for a worker");
+		}
+		done += n;
 	}
-	return resize;
+	return true;
 }
 
-/*  Read from an opened file a list of file names for which to generate tags.
- */
-static bool createTagsFromFileInput (FILE *const fp, const bool filter)
+static void writeFully (int fd, const void *buf, size_t size)
 {
-	bool resize = false;
-	if (fp != NULL)
+	const char *p = buf;
+	size_t done = 0;
+
+	while (done < size)
 	{
-		cookedArgs *args = cArgNewFromLineFile (fp);
-		parseCmdlineOptions (args);
-		while (! cArgOff (args))
-		{
-			resize |= createTagsForEntry (cArgItem (args));
-			if (filter)
-			{
-				if (Option.filterTerminator != NULL)
-					fputs (Option.filterTerminator, stdout);
-				fflush (stdout);
-			}
-			cArgForth (args);
-			parseCmdlineOptions (args);
-		}
-		cArgDelete (args);
+		ssize_t n = write (fd, p + done, size - done);
+		if (n < 0 && errno == EINTR)
+			continue;
+		if (n < 0)
+			error (FATAL | PERROR, "cannot write to a pipe for a worker");
+		done += n;
 	}
-	return resize;
 }
 
-/*  Read from a named file a list of file names for which to generate tags.
- */
-static bool createTagsFromListFile (const char *const fileName)
+static void runWorker (int requestFd, int reportFd)
 {
-	bool resize;
-	Assert (fileName != NULL);
-	if (strcmp (fileName, "-") == 0)
-		resize = createTagsFromFileInput (stdin, false);
-	else
+	struct jobRequest request;
+	struct jobReport report;
+	char *name = NULL;
+	char *id, *mapped, *content;
+	MIO *mio = mio_new_memory (NULL, 0, eRealloc, eFree);
+
+#ifdef HAVE_JANSSON
+	if (Scheduler.sandbox && installSyscallFilter ())
+		_exit (1);
+#endif
+
+	while (readFully (requestFd, &request, sizeof (request)))
 	{
-		FILE *const fp = fopen (fileName, "r");
-		if (fp == NULL)
-			error (FATAL | PERROR, "cannot open list file \"%s\"", fileName);
-		resize = createTagsFromFileInput (fp, false);
-		fclose (fp);
+		/* The contents of a mapped file are not sent. */
+		const size_t contentLength = (request.contentLength < 0
+									  || request.mappedLength > 0)? 0: request.contentLength;
+
+		/* The name, the id, the mapped file and the contents, each
+		   terminated with NUL */
+		name = xRealloc (name, request.length + request.idLength
+						 + request.mappedLength + contentLength + 4, char);
+		id = name + request.length + 1;
+		mapped = id + request.idLength + 1;
+		content = mapped + request.mappedLength + 1;
+		if (! readFully (requestFd, name, request.length)
+			|| ! readFully (requestFd, id, request.idLength)
+			|| ! readFully (requestFd, mapped, request.mappedLength)
+			|| ! readFully (requestFd, content, contentLength))
+			error (FATAL, "no file name in a request for a worker");
+		name [request.length] = '\0';
+		id [request.idLength] = '\0';
+		mapped [request.mappedLength] = '\0';
+		content [contentLength] = '\0';
+
+		/* The buffer of MIO is reused from file to file. */
+		mio_seek (mio, 0, SEEK_SET);
+		openTagFileFragment (mio);
+		Totals.files = Totals.lines = Totals.bytes = Totals.rescans = 0;
+		LastSlowFile.language = LANG_IGNORE;
+		report.timedOut = false;
+#ifdef HAVE_JANSSON
+		if (Option.interactive)
+			report.timedOut = runInteractiveJob (name, id, (*mapped)? mapped: NULL,
+												 request.offset, content,
+												 request.contentLength,
+												 request.deadline, mio);
+		else
+#endif
+		parseFile (name);
+		closeTagFileFragment (&report.fragment);
+
+		report.index = request.index;
+		report.files = Totals.files;
+		report.lines = Totals.lines;
+		report.bytes = Totals.bytes;
+		report.rescans = Totals.rescans;
+		report.language = LastSlowFile.language;
+		report.size = LastSlowFile.size;
+		report.seconds = LastSlowFile.seconds;
+		writeFully (reportFd, &report, sizeof (report));
+		writeFully (reportFd, mio_memory_get_data (mio, NULL),
+					report.fragment.size);
 	}
-	return resize;
+	mio_free (mio);
+	if (name)
+		eFree (name);
+	closeRemoteTagCache ();
+	flushTraceEvents ();
+
+	/* Skip atexit handlers and stdio buffers inherited from the parent. */
+	_exit (0);
 }
 
-#if defined (HAVE_CLOCK)
-# define CLOCK_AVAILABLE
-# ifndef CLOCKS_PER_SEC
-#  define CLOCKS_PER_SEC		1000000
-# endif
-#elif defined (HAVE_TIMES)
-# define CLOCK_AVAILABLE
-# define CLOCKS_PER_SEC	60
-static clock_t clock (void)
+static void startWorker (unsigned int i)
 {
-	struct tms buf;
+	worker *const w = Scheduler.workers + i;
+	int requestFds [2], reportFds [2];
 
-	times (&buf);
-	return (buf.tms_utime + buf.tms_stime);
+	if (pipe (requestFds) < 0 || pipe (reportFds) < 0)
+		error (FATAL | PERROR, "cannot create a pipe for a worker");
+
+	w->pid = fork ();
+	if (w->pid < 0)
+		error (FATAL | PERROR, "cannot fork a worker");
+	else if (w->pid == 0)
+	{
+		/* The requests of the other workers must see EOF when the
+		   parent closes them. */
+		for (unsigned int j = 0; j < i; j++)
+		{
+			close (Scheduler.workers [j].requestFd);
+			close (Scheduler.workers [j].reportFd);
+		}
+		close (requestFds [1]);
+		close (reportFds [0]);
+		startWorkerTraceEvents (i + 1);
+		runWorker (requestFds [0], reportFds [1]);
+	}
+	close (requestFds [0]);
+	close (reportFds [1]);
+	w->requestFd = requestFds [1];
+	w->reportFd = reportFds [0];
+	w->pending = 0;
 }
-#else
-# define clock()  (clock_t)0
-#endif
 
-static void printTotals (const clock_t *const timeStamps)
+static void startWorkers (void)
 {
-	const unsigned long totalTags = numTagsTotal();
-	const unsigned long addedTags = numTagsAdded();
+	unsigned int i;
 
-	fprintf (stderr, "%ld file%s, %ld line%s (%ld kB) scanned",
-			Totals.files, plural (Totals.files),
-			Totals.lines, plural (Totals.lines),
-			Totals.bytes/1024L);
-#ifdef CLOCK_AVAILABLE
-	{
-		const double interval = ((double) (timeStamps [1] - timeStamps [0])) /
-								CLOCKS_PER_SEC;
+	Scheduler.count = Option.jobs;
+	Scheduler.workers = xCalloc (Scheduler.count, worker);
+	Scheduler.dispatched = 0;
+	Scheduler.committed = 0;
 
-		fprintf (stderr, " in %.01f seconds", interval);
-		if (interval != (double) 0.0)
-			fprintf (stderr, " (%lu kB/s)",
-					(unsigned long) (Totals.bytes / interval) / 1024L);
-	}
-#endif
-	fputc ('\n', stderr);
+	verbose ("starting %u workers\n", Scheduler.count);
 
-	fprintf (stderr, "%lu tag%s added to tag file",
-			addedTags, plural(addedTags));
-	if (Option.append)
-		fprintf (stderr, " (now %lu tags)", totalTags);
-	fputc ('\n', stderr);
+	/* Children must not write the buffered data of the parent again. */
+	fflush (NULL);
+	flushTraceEvents ();
 
-	if (totalTags > 0  &&  Option.sorted != SO_UNSORTED)
+	for (i = 0; i < Scheduler.count; i++)
+		startWorker (i);
+}
+
+/*  Return the output following the report, which the caller frees.
+ */
+static char *readReport (unsigned int i, struct jobReport *report)
+{
+	worker *const w = Scheduler.workers + i;
+	char *output;
+
+	if (! readFully (w->reportFd, report, sizeof (*report)))
+		error (FATAL, "a worker process failed");
+	output = xMalloc (report->fragment.size + 1, char);
+	if (report->fragment.size > 0
+		&& ! readFully (w->reportFd, output, report->fragment.size))
+		error (FATAL, "a worker process failed");
+	w->pending--;
+	return output;
+}
+
+static void receiveReport (unsigned int i)
+{
+	struct jobReport report;
+	char *output = readReport (i, &report);
+	struct jobResult *r;
+
+	if (report.index >= Scheduler.size)
 	{
-		fprintf (stderr, "%lu tag%s sorted", totalTags, plural (totalTags));
-#ifdef CLOCK_AVAILABLE
-		fprintf (stderr, " in %.02f seconds",
-				((double) (timeStamps [2] - timeStamps [1])) / CLOCKS_PER_SEC);
-#endif
-		fputc ('\n', stderr);
+		unsigned int size = Scheduler.size? Scheduler.size: 64;
+		while (size <= report.index)
+			size *= 2;
+		Scheduler.results = xRealloc (Scheduler.results, size, struct jobResult);
+		memset (Scheduler.results + Scheduler.size, 0,
+				sizeof (struct jobResult) * (size - Scheduler.size));
+		Scheduler.size = size;
 	}
+	r = Scheduler.results + report.index;
+	r->fragment = report.fragment;
+	r->output = output;
+	r->ready = true;
+	addTotals (report.files, report.lines, report.bytes);
+	Totals.rescans += report.rescans;
+	if (report.language != LANG_IGNORE)
+		addSlowFile (vStringValue (stringListItem (JobQueue, report.index)),
+					 report.language, report.size, report.seconds);
+}
 
-#ifdef DEBUG
-	fprintf (stderr, "longest tag line = %lu\n",
-		 (unsigned long) maxTagsLine ());
-#endif
+/*  Append the output for the files reported so far to the tag file, in
+ *  the order of JobQueue; the result is the same as parsing the files
+ *  one by one.
+ */
+static void commitResults (void)
+{
+	while (Scheduler.committed < Scheduler.size
+		   && Scheduler.results [Scheduler.committed].ready)
+	{
+		struct jobResult *r = Scheduler.results + Scheduler.committed;
+
+		appendTagFileFragment (r->output, &r->fragment);
+		eFree (r->output);
+		r->output = NULL;
+		r->ready = false;
+		Scheduler.committed++;
+	}
 }
 
-static bool etagsInclude (void)
+/*  The lengths of NAME, ID, MAPPED and CONTENT are in REQUEST.
+ */
+static void sendJobRequest (unsigned int i, const struct jobRequest *request,
+							const char *name, const char *id,
+							const char *mapped, const char *content)
 {
-	return (bool)(Option.etags && Option.etagsInclude != NULL);
+	worker *const w = Scheduler.workers + i;
+
+	writeFully (w->requestFd, request, sizeof (*request));
+	writeFully (w->requestFd, name, request->length);
+	writeFully (w->requestFd, id, request->idLength);
+	if (request->mappedLength > 0)
+		writeFully (w->requestFd, mapped, request->mappedLength);
+	else if (request->contentLength > 0)
+		writeFully (w->requestFd, content, request->contentLength);
+	w->pending++;
 }
 
-extern void setMainLoop (mainLoopFunc func, void *data)
+static void sendRequest (unsigned int i)
 {
-	mainLoop = func;
-	mainData = data;
+	const vString *const name = stringListItem (JobQueue, Scheduler.dispatched);
+	struct jobRequest request;
+
+	request.index = Scheduler.dispatched;
+	request.length = vStringLength (name);
+	request.idLength = 0;
+	request.mappedLength = 0;
+	request.offset = 0;
+	request.contentLength = -1;
+	request.deadline = 0.0;
+	sendJobRequest (i, &request, vStringValue (name), NULL, NULL, NULL);
+	Scheduler.dispatched++;
 }
 
-static void runMainLoop (cookedArgs *args)
+/*  Return the worker given the fewest files.
+ */
+static unsigned int findIdlestWorker (void)
 {
-	(* mainLoop) (args, mainData);
+	unsigned int idlest = 0;
+
+	for (unsigned int i = 1; i < Scheduler.count; i++)
+		if (Scheduler.workers [i].pending < Scheduler.workers [idlest].pending)
+			idlest = i;
+	return idlest;
 }
 
-static void batchMakeTags (cookedArgs *args, void *user CTAGS_ATTR_UNUSED)
+/*  Collect the reports of the workers, then give queued files to the
+ *  workers which can take them. With WAIT, block until a report comes
+ *  if any file is being parsed.
+ */
+static void dispatchJobs (bool wait)
 {
-	clock_t timeStamps [3];
-	bool resize = false;
-	bool files = (bool)(! cArgOff (args) || Option.fileList != NULL
-							  || Option.filter);
+	struct pollfd *fds = xMalloc (Scheduler.count, struct pollfd);
+	unsigned int *owners = xMalloc (Scheduler.count, unsigned int);
+	unsigned int nfds = 0;
+	unsigned int i;
 
-	if (! files)
+	for (i = 0; i < Scheduler.count; i++)
 	{
-		if (filesRequired ())
-			error (FATAL, "No files specified. Try \"%s --help\".",
-				getExecutableName ());
+		if (Scheduler.workers [i].pending == 0)
+			continue;
+		fds [nfds].fd = Scheduler.workers [i].reportFd;
+		fds [nfds].events = POLLIN;
+		owners [nfds++] = i;
+	}
+
+	if (nfds > 0)
+	{
+		int r;
+		do
+			r = poll (fds, nfds, wait? -1: 0);
+		while (r < 0 && errno == EINTR);
+		if (r < 0)
+			error (FATAL | PERROR, "cannot poll workers");
+
+		for (i = 0; i < nfds; i++)
+		{
+			if (fds [i].revents & (POLLIN | POLLHUP | POLLERR))
+				receiveReport (owners [i]);
+		}
+	}
+	eFree (owners);
+	eFree (fds);
+	commitResults ();
+
+	while (Scheduler.dispatched < stringListCount (JobQueue)
+		   && (Scheduler.dispatched - Scheduler.committed
+			   < Scheduler.count * (isMemoryTight ()? 1: COMMIT_WINDOW_PER_WORKER)))
+	{
+		const unsigned int idlest = findIdlestWorker ();
+
+		if (Scheduler.workers [idlest].pending >= WORKER_QUEUE_DEPTH)
+			break;
+		sendRequest (idlest);
+	}
+}
+
+/*  Stop the workers, which have finished their files.
+ */
+static void stopWorkers (void)
+{
+	unsigned int i;
+
+	for (i = 0; i < Scheduler.count; i++)
+	{
+		worker *const w = Scheduler.workers + i;
+		int status;
+
+		close (w->requestFd);
+		if (waitpid (w->pid, &status, 0) < 0)
+			error (FATAL | PERROR, "cannot wait a worker");
+		close (w->reportFd);
+		if (! WIFEXITED (status) || WEXITSTATUS (status) != 0)
+			error (FATAL, "a worker process failed");
+	}
+
+	eFree (Scheduler.workers);
+	Scheduler.workers = NULL;
+	Scheduler.count = 0;
+}
+
+/*  Wait for all the queued files, and stop the workers.
+ */
+static void finishWorkers (void)
+{
+	const unsigned int count = stringListCount (JobQueue);
+
+	while (Scheduler.committed < count)
+		dispatchJobs (true);
+
+	stopWorkers ();
+	if (Scheduler.results)
+		eFree (Scheduler.results);
+	Scheduler.results = NULL;
+	Scheduler.size = 0;
+}
+#endif
+
+static void queueJob (const char *const fileName)
+{
+	stringListAdd (JobQueue, vStringNewInit (fileName));
+
+#ifdef HAVE_WORKING_FORK
+	/* A single file is parsed in this process; see runJobQueue. */
+	if (Scheduler.workers == NULL && stringListCount (JobQueue) > 1)
+		startWorkers ();
+	if (Scheduler.workers)
+		dispatchJobs (false);
+#endif
+}
+
+static bool runJobQueue (void)
+{
+	bool resize = parsePrefetchedFiles ();
+
+	if (JobQueue == NULL)
+		return resize;
+
+#ifdef HAVE_WORKING_FORK
+	if (Scheduler.workers)
+		finishWorkers ();
+	else
+#endif
+	if (stringListCount (JobQueue) > 0)
+		resize = parseFile (vStringValue (stringListItem (JobQueue, 0)));
+	stringListClear (JobQueue);
+	return resize;
+}
+
+static bool canUseJobQueue (void)
+{
+	if (Option.jobs < 2 || Option.filter || Option.interactive || Option.printLanguage)
+		return false;
+
+	/* Pseudo tags for parsers are emitted when a parser runs first time. */
+	if (isPtagEnabled (PTAG_KIND_DESCRIPTION) || isPtagEnabled (PTAG_KIND_SEPARATOR))
+	{
+		verbose ("--jobs is ignored: pseudo tags for parsers are enabled\n");
+		return false;
+	}
+
+	/* The patterns are profiled in the process running them. */
+	if (Option.profileRegex != REGEX_PROFILE_NONE)
+	{
+		verbose ("--jobs is ignored: --_profile-regex is given\n");
+		return false;
+	}
+
+	/* So are the languages and phases. */
+	if (Option.printTotals >= TOTALS_EXTRA)
+	{
+		verbose ("--jobs is ignored: --totals=%s is given\n",
+				 (Option.printTotals == TOTALS_JSON)? "json":
+				 (Option.printTotals == TOTALS_KINDS)? "kinds": "extra");
+		return false;
+	}
+
+	/* The workers send the lines of the tag file only. */
+	if (Option.outputs)
+	{
+		verbose ("--jobs is ignored: --output is given\n");
+		return false;
+	}
+
+	/* And the parent could not tell the tag file of a worker's lines. */
+	if (Option.partition != PARTITION_NONE)
+	{
+		verbose ("--jobs is ignored: --partition is given\n");
+		return false;
+	}
+
+#ifdef ALLOC_PROFILING
+	/* And the allocations. */
+	if (Option.printTotals)
+	{
+		verbose ("--jobs is ignored: allocations are counted for --totals\n");
+		return false;
+	}
+#endif
+	return true;
+}
+
+static bool createTagsForArgs (cookedArgs *const args)
+{
+	bool resize = false;
+
+	/*  Generate tags for each argument on the command line.
+	 */
+	while (! cArgOff (args))
+	{
+		const char *const arg = cArgItem (args);
+
+#ifdef MANUAL_GLOBBING
+		resize |= createTagsForWildcardArg (arg);
+#else
+		resize |= createTagsForEntry (arg);
+#endif
+		cArgForth (args);
+		/* Options given after a file name apply only to the following files. */
+		if (! cArgOff (args) && cArgIsOption (args))
+			resize |= runJobQueue ();
+		parseCmdlineOptions (args);
+	}
+	return resize;
+}
+
+#ifdef EXTERNAL_SORT
+/*  With --merge-shards, the arguments are tag files to merge.
+ */
+static void mergeShardsFromArgs (cookedArgs *const args)
+{
+	while (! cArgOff (args))
+	{
+		mergeTagFileShard (cArgItem (args));
+		cArgForth (args);
+		parseCmdlineOptions (args);
+	}
+}
+#endif
+
+/*  --filter: the output kept for --filter-batch.
+ */
+static struct sFilterBatch {
+	char *buffer;				/* of stdout */
+	double start;				/* when the output kept began, or -1 */
+	unsigned long count;		/* of the file names read */
+} FilterBatch = { .start = -1 };
+
+static void beginFilterBatch (void)
+{
+	if (Option.filterBatchSize == 0 || FilterBatch.buffer != NULL)
+		return;
+
+	/* stdio writes the output out when the buffer is full. */
+	FilterBatch.buffer = xMalloc (Option.filterBatchSize, char);
+	if (setvbuf (stdout, FilterBatch.buffer, _IOFBF, Option.filterBatchSize) != 0)
+		error (WARNING | PERROR, "cannot set the buffer of the standard output");
+}
+
+/*  Whether another file name can be read from FP without waiting: the
+ *  output may then wait for its tags. Output kept while the client waits
+ *  for it could never be flushed, so the answer is no when unsure.
+ *  A character is read without blocking, rather than polling the file
+ *  descriptor, to see the file names already in the buffer of FP too.
+ */
+static bool isFilterInputWaiting (FILE *const fp CTAGS_ATTR_UNUSED)
+{
+#ifdef HAVE_WORKING_FORK
+	const int fd = fileno (fp);
+	const int flags = fcntl (fd, F_GETFL);
+	int c;
+
+	if (flags < 0 || fcntl (fd, F_SETFL, flags | O_NONBLOCK) < 0)
+		return false;
+	c = getc (fp);
+	fcntl (fd, F_SETFL, flags);
+
+	if (c != EOF)
+	{
+		ungetc (c, fp);
+		return true;
+	}
+	if (feof (fp))
+		return true;
+	clearerr (fp);
+	return false;
+#else
+	return false;
+#endif
+}
+
+/*  Write the terminator of the tags of a file name read, and flush the
+ *  output unless --filter-batch lets it wait for the next file names.
+ */
+static void endFilterEntry (FILE *const fp)
+{
+	FilterBatch.count++;
+	if (Option.filterTerminator != NULL)
+	{
+		if (Option.filterTerminatorId)
+			fprintf (stdout, "%lu\t", FilterBatch.count);
+		fputs (Option.filterTerminator, stdout);
+	}
+
+	if (Option.filterBatchSize > 0)
+	{
+		const double now = getTotalsClock ();
+
+		if (FilterBatch.start < 0)
+			FilterBatch.start = now;
+		if ((now - FilterBatch.start) * 1000 < Option.filterBatchTime
+			&& isFilterInputWaiting (fp))
+			return;
+	}
+	fflush (stdout);
+	FilterBatch.start = -1;
+}
+
+/*  Read from an opened file a list of file names for which to generate tags.
+ */
+static bool createTagsFromFileInput (FILE *const fp, const bool filter)
+{
+	bool resize = false;
+	if (fp != NULL)
+	{
+		cookedArgs *args = cArgNewFromLineFile (fp);
+		parseCmdlineOptions (args);
+		if (filter)
+			beginFilterBatch ();
+		while (! cArgOff (args))
+		{
+			resize |= createTagsForEntry (cArgItem (args));
+			if (filter)
+				endFilterEntry (fp);
+			cArgForth (args);
+			if (! cArgOff (args) && cArgIsOption (args))
+				resize |= runJobQueue ();
+			parseCmdlineOptions (args);
+		}
+		cArgDelete (args);
+		if (filter)
+			fflush (stdout);
+	}
+	return resize;
+}
+
+/*  Read from an opened file a NUL-separated list of file names, as given
+ *  by "git ls-files -z" or "find -print0". The names are only file names:
+ *  there are no options to parse between them.
+ */
+static bool createTagsFromNulListInput (FILE *const fp)
+{
+	bool resize = false;
+	Arguments *const args = argNewFromNulFile (fp);
+
+	while (! argOff (args))
+	{
+		resize |= createTagsForEntry (argItem (args));
+		argForth (args);
+	}
+
+	argDelete (args);
+	return resize;
+}
+
+/*  Read from a named file a list of file names for which to generate tags.
+ */
+static bool createTagsFromListFile (const char *const fileName)
+{
+	bool resize;
+	Assert (fileName != NULL);
+	if (strcmp (fileName, "-") == 0)
+		resize = Option.nulSeparatedList
+			? createTagsFromNulListInput (stdin)
+			: createTagsFromFileInput (stdin, false);
+	else
+	{
+		FILE *const fp = fopen (fileName, Option.nulSeparatedList? "rb": "r");
+		if (fp == NULL)
+			error (FATAL | PERROR, "cannot open list file \"%s\"", fileName);
+		resize = Option.nulSeparatedList
+			? createTagsFromNulListInput (fp)
+			: createTagsFromFileInput (fp, false);
+		fclose (fp);
+	}
+	return resize;
+}
+
+#if defined (HAVE_CLOCK)
+# define CLOCK_AVAILABLE
+# ifndef CLOCKS_PER_SEC
+#  define CLOCKS_PER_SEC		1000000
+# endif
+#elif defined (HAVE_TIMES)
+# define CLOCK_AVAILABLE
+# define CLOCKS_PER_SEC	60
+static clock_t clock (void)
+{
+	struct tms buf;
+
+	times (&buf);
+	return (buf.tms_utime + buf.tms_stime);
+}
+#else
+# define clock()  (clock_t)0
+#endif
+
+/*  The statistics of --totals=kinds: the tags of a kind, the renderings
+ *  of a field, or the tags marked with an extra.
+ */
+struct volumeTotals {
+	unsigned long count;
+	unsigned long long bytes;	/* written, or rendered for a field */
+	double seconds;				/* spent writing or rendering them */
+};
+
+/*  The statistics of --totals=extra
+ */
+struct languageTotals {
+	long files, lines, bytes;
+	unsigned long tags;
+	double seconds, cpuSeconds;
+	struct volumeTotals *kinds;	/* --totals=kinds */
+	unsigned int kindCount;
+};
+static struct languageTotals *LanguageTotals;
+static unsigned int LanguageTotalsCount;
+
+static struct {
+	struct volumeTotals all;
+	struct volumeTotals *fields;
+	unsigned int fieldCount;
+	struct volumeTotals *xtags;
+	unsigned int xtagCount;
+} VolumeTotals;
+
+#define MAX_PHASE_DEPTH 8
+static double PhaseSeconds [COUNT_PHASES];
+static struct {
+	totalsPhase phase;
+	double start;
+	double nested;		/* spent in the phases run in this one */
+} PhaseStack [MAX_PHASE_DEPTH];
+static unsigned int PhaseDepth;
+
+static const char *const PhaseNames [COUNT_PHASES] = {
+	[PHASE_GUESSING] = "guessing",
+	[PHASE_READING]  = "reading",
+	[PHASE_PARSING]  = "parsing",
+	[PHASE_REGEX]    = "regex",
+	[PHASE_WRITING]  = "writing",
+	[PHASE_CLOSING]  = "closing",
+};
+
+/*  Wall clock time in seconds */
+extern double getTotalsClock (void)
+{
+#if defined (HAVE_CLOCK_GETTIME) && defined (CLOCK_MONOTONIC)
+	struct timespec ts;
+
+	clock_gettime (CLOCK_MONOTONIC, &ts);
+	return ts.tv_sec + ts.tv_nsec / 1e9;
+#else
+	return (double) clock () / CLOCKS_PER_SEC;
+#endif
+}
+
+/*  CPU time in seconds */
+extern double getTotalsCpuClock (void)
+{
+	return (double) clock () / CLOCKS_PER_SEC;
+}
+
+extern void beginTotalsPhase (totalsPhase phase)
+{
+	if (Option.printTotals < TOTALS_EXTRA)
+		return;
+
+	/* A phase deeper than that is counted in the one it is run in. */
+	if (PhaseDepth < MAX_PHASE_DEPTH)
+	{
+		PhaseStack [PhaseDepth].phase = phase;
+		PhaseStack [PhaseDepth].start = getTotalsClock ();
+		PhaseStack [PhaseDepth].nested = 0.0;
+	}
+	PhaseDepth++;
+}
+
+extern void endTotalsPhase (void)
+{
+	double elapsed;
+
+	if (Option.printTotals < TOTALS_EXTRA)
+		return;
+
+	Assert (PhaseDepth > 0);
+	PhaseDepth--;
+	if (PhaseDepth >= MAX_PHASE_DEPTH)
+		return;
+
+	elapsed = getTotalsClock () - PhaseStack [PhaseDepth].start;
+	PhaseSeconds [PhaseStack [PhaseDepth].phase] += elapsed - PhaseStack [PhaseDepth].nested;
+	if (PhaseDepth > 0)
+		PhaseStack [PhaseDepth - 1].nested += elapsed;
+}
+
+static struct languageTotals *getLanguageTotals (const langType language)
+{
+	Assert (language >= 0);
+	if ((unsigned int) language >= LanguageTotalsCount)
+	{
+		const unsigned int count = (unsigned int) language + 1;
+
+		LanguageTotals = xRealloc (LanguageTotals, count, struct languageTotals);
+		memset (LanguageTotals + LanguageTotalsCount, 0,
+				sizeof (struct languageTotals) * (count - LanguageTotalsCount));
+		LanguageTotalsCount = count;
+	}
+	return LanguageTotals + language;
+}
+
+/*  Make *TABLE of *COUNT entries have the entry N. */
+static struct volumeTotals *getVolumeTotals (struct volumeTotals **table,
+											 unsigned int *count, unsigned int n)
+{
+	if (n >= *count)
+	{
+		*table = xRealloc (*table, n + 1, struct volumeTotals);
+		memset (*table + *count, 0, sizeof (struct volumeTotals) * (n + 1 - *count));
+		*count = n + 1;
+	}
+	return *table + n;
+}
+
+static void addVolumeTotals (struct volumeTotals *t, size_t bytes, double seconds)
+{
+	t->count++;
+	t->bytes += bytes;
+	t->seconds += seconds;
+}
+
+/*  TAG was written in BYTES of the tag file, in SECONDS, its fields
+ *  rendered in. */
+extern void addKindTotals (const tagEntryInfo *const tag, size_t bytes, double seconds)
+{
+	struct languageTotals *l;
+	int i;
+
+	if (tag->langType < 0 || tag->kindIndex < 0)
+		return;
+
+	l = getLanguageTotals (tag->langType);
+	addVolumeTotals (getVolumeTotals (&l->kinds, &l->kindCount, tag->kindIndex),
+					 bytes, seconds);
+	addVolumeTotals (&VolumeTotals.all, bytes, seconds);
+
+	for (i = 0; i < countXtags (); i++)
+		if (isTagExtraBitMarked (tag, i))
+			addVolumeTotals (getVolumeTotals (&VolumeTotals.xtags,
+											  &VolumeTotals.xtagCount, i),
+							 bytes, seconds);
+}
+
+/*  A value of FIELD was rendered to BYTES in SECONDS. */
+extern void addFieldTotals (int field, size_t bytes, double seconds)
+{
+	addVolumeTotals (getVolumeTotals (&VolumeTotals.fields,
+									  &VolumeTotals.fieldCount, field),
+					 bytes, seconds);
+}
+
+extern void addLanguageTotals (const langType language,
+							   const long unsigned int lines, const long unsigned int bytes,
+							   const long unsigned int tags,
+							   double seconds, double cpuSeconds)
+{
+	struct languageTotals *t = getLanguageTotals (language);
+
+	t->files++;
+	t->lines += lines;
+	t->bytes += bytes;
+	t->tags += tags;
+	t->seconds += seconds;
+	t->cpuSeconds += cpuSeconds;
+}
+
+static int compareLanguageTotals (const void *a, const void *b)
+{
+	const struct languageTotals *ta = LanguageTotals + *(const unsigned int *) a;
+	const struct languageTotals *tb = LanguageTotals + *(const unsigned int *) b;
+
+	if (ta->seconds != tb->seconds)
+		return (ta->seconds < tb->seconds)? 1: -1;
+	return strcmp (getLanguageName (*(const unsigned int *) a),
+				   getLanguageName (*(const unsigned int *) b));
+}
+
+/*  The languages having parsed a file, the slowest first. Return their
+ *  count. */
+static unsigned int sortLanguageTotals (unsigned int **languages)
+{
+	unsigned int count = 0;
+	unsigned int i;
+
+	*languages = xMalloc (LanguageTotalsCount + 1, unsigned int);
+	for (i = 0; i < LanguageTotalsCount; i++)
+		if (LanguageTotals [i].files > 0)
+			(*languages) [count++] = i;
+	qsort (*languages, count, sizeof (unsigned int), compareLanguageTotals);
+	return count;
+}
+
+static void printExtraTotals (void)
+{
+	unsigned int *languages;
+	const unsigned int count = sortLanguageTotals (&languages);
+	unsigned int i;
+
+	fputs ("\nLANGUAGE TOTALS\n", stderr);
+	fputs ("==============================================\n", stderr);
+	fprintf (stderr, "%8s %10s %12s %10s %10s %10s  %s\n",
+			 "files", "lines", "bytes", "tags", "time(ms)", "cpu(ms)", "language");
+	for (i = 0; i < count; i++)
+	{
+		const struct languageTotals *t = LanguageTotals + languages [i];
+		fprintf (stderr, "%8ld %10ld %12ld %10lu %10.3f %10.3f  %s\n",
+				 t->files, t->lines, t->bytes, t->tags,
+				 t->seconds * 1000, t->cpuSeconds * 1000,
+				 getLanguageName (languages [i]));
+	}
+
+	fputs ("\nPHASE TOTALS\n", stderr);
+	fputs ("==============================================\n", stderr);
+	fprintf (stderr, "%10s  %s\n", "time(ms)", "phase");
+	for (i = 0; i < COUNT_PHASES; i++)
+		fprintf (stderr, "%10.3f  %s\n", PhaseSeconds [i] * 1000, PhaseNames [i]);
+
+	eFree (languages);
+}
+
+/*  A line of the tables of --totals=kinds */
+struct volumeLine {
+	const char *language;		/* RSV_NONE if common */
+	const char *name;
+	const struct volumeTotals *t;
+};
+
+static int compareVolumeLines (const void *a, const void *b)
+{
+	const struct volumeLine *la = a;
+	const struct volumeLine *lb = b;
+	int r;
+
+	if (la->t->bytes != lb->t->bytes)
+		return (la->t->bytes < lb->t->bytes)? 1: -1;
+	r = strcmp (la->language, lb->language);
+	return r? r: strcmp (la->name, lb->name);
+}
+
+/*  Print LINES, the largest first. With FACTOR, the tags without those
+ *  of a line are ALL divided by the factor printed. */
+static void printVolumeLines (const char *const title, const char *const countLabel,
+							  const char *const nameLabel,
+							  struct volumeLine *lines, unsigned int count, bool factor)
+{
+	const struct volumeTotals *all = &VolumeTotals.all;
+	unsigned int i;
+
+	qsort (lines, count, sizeof (struct volumeLine), compareVolumeLines);
+
+	fprintf (stderr, "\n%s\n", title);
+	fputs ("==============================================\n", stderr);
+	fprintf (stderr, "%10s %12s %7s %10s%s  %-12s %s\n",
+			 countLabel, "bytes", "%bytes", "time(ms)", factor? "   factor": "",
+			 "language", nameLabel);
+	for (i = 0; i < count; i++)
+	{
+		const struct volumeTotals *t = lines [i].t;
+
+		fprintf (stderr, "%10lu %12llu %7.2f %10.3f",
+				 t->count, t->bytes,
+				 all->bytes? t->bytes * 100.0 / all->bytes: 0.0,
+				 t->seconds * 1000);
+		if (factor && t->count < all->count)
+			fprintf (stderr, " %8.3f", (double) all->count / (all->count - t->count));
+		else if (factor)
+			fprintf (stderr, " %8s", "-");
+		fprintf (stderr, "  %-12s %s\n", lines [i].language, lines [i].name);
+	}
+}
+
+static void printKindTotals (void)
+{
+	unsigned int count, i, k;
+	struct volumeLine *lines;
+
+	count = 0;
+	for (i = 0; i < LanguageTotalsCount; i++)
+		count += LanguageTotals [i].kindCount;
+	if (count < VolumeTotals.fieldCount)
+		count = VolumeTotals.fieldCount;
+	if (count < VolumeTotals.xtagCount)
+		count = VolumeTotals.xtagCount;
+	lines = xMalloc (count + 1, struct volumeLine);
+
+	count = 0;
+	for (i = 0; i < LanguageTotalsCount; i++)
+		for (k = 0; k < LanguageTotals [i].kindCount; k++)
+			if (LanguageTotals [i].kinds [k].count > 0)
+			{
+				lines [count].language = getLanguageName (i);
+				lines [count].name = getLanguageKind (i, k)->name;
+				lines [count++].t = LanguageTotals [i].kinds + k;
+			}
+	printVolumeLines ("KIND TOTALS", "tags", "kind", lines, count, false);
+
+	count = 0;
+	for (i = 0; i < VolumeTotals.fieldCount; i++)
+		if (VolumeTotals.fields [i].count > 0)
+		{
+			lines [count].language = isCommonField (i)? RSV_NONE: getLanguageName (getFieldOwner (i));
+			lines [count].name = getFieldName (i)? getFieldName (i): RSV_NONE;
+			lines [count++].t = VolumeTotals.fields + i;
+		}
+	printVolumeLines ("FIELD TOTALS", "renders", "field", lines, count, false);
+
+	count = 0;
+	for (i = 0; i < VolumeTotals.xtagCount; i++)
+		if (VolumeTotals.xtags [i].count > 0)
+		{
+			lines [count].language = isCommonXtag (i)? RSV_NONE: getLanguageName (getXtagOwner (i));
+			lines [count].name = getXtagName (i);
+			lines [count++].t = VolumeTotals.xtags + i;
+		}
+	printVolumeLines ("EXTRA TOTALS", "tags", "extra", lines, count, true);
+
+	eFree (lines);
+}
+
+#ifdef ALLOC_PROFILING
+static int compareAllocPeaks (const void *a, const void *b)
+{
+	allocStats sa, sb;
+
+	getAllocStats (*(const int *) a, &sa);
+	getAllocStats (*(const int *) b, &sb);
+	if (sa.peak != sb.peak)
+		return (sa.peak < sb.peak)? 1: -1;
+	return *(const int *) a - *(const int *) b;
+}
+
+/*  The languages having allocated, the highest peak first, -1 for the
+ *  allocations out of parsing among them. Return their count. */
+static unsigned int sortAllocLanguages (int **languages)
+{
+	const unsigned int count = countParsers ();
+	unsigned int n = 0;
+	allocStats s;
+	int i;
+
+	*languages = xMalloc (count + 1, int);
+	for (i = -1; i < (int) count; i++)
+		if (getAllocStats (i, &s))
+			(*languages) [n++] = i;
+	qsort (*languages, n, sizeof (int), compareAllocPeaks);
+	return n;
+}
+
+static const char *getAllocLanguageName (int language)
+{
+	return (language < 0)? "(none)": getLanguageName (language);
+}
+
+static void printAllocTotals (void)
+{
+	int *languages;
+	const unsigned int count = sortAllocLanguages (&languages);
+	allocStats s;
+	unsigned int i;
+
+	fputs ("\nALLOCATION TOTALS\n", stderr);
+	fputs ("==============================================\n", stderr);
+	fprintf (stderr, "%10s %10s %10s %12s %10s %10s  %s\n",
+			 "allocs", "reallocs", "frees", "bytes(kB)", "live(kB)", "peak(kB)", "language");
+	for (i = 0; i <= count; i++)
+	{
+		if (i < count)
+			getAllocStats (languages [i], &s);
+		else
+			getAllocTotals (&s);
+		fprintf (stderr, "%10lu %10lu %10lu %12llu %10lu %10lu  %s\n",
+				 s.allocs, s.reallocs, s.frees, s.bytes / 1024,
+				 (unsigned long) (s.live / 1024), (unsigned long) (s.peak / 1024),
+				 (i < count)? getAllocLanguageName (languages [i]): "(all)");
+	}
+	eFree (languages);
+}
+
+static void printJsonAllocTotals (void)
+{
+	int *languages;
+	const unsigned int count = sortAllocLanguages (&languages);
+	allocStats s;
+	unsigned int i;
+
+	getAllocTotals (&s);
+	fprintf (stderr, " \"allocations\": {\"allocs\": %lu, \"reallocs\": %lu, \"frees\": %lu,"
+			 " \"bytes\": %llu, \"live\": %lu, \"peak\": %lu, \"languages\": [",
+			 s.allocs, s.reallocs, s.frees, s.bytes,
+			 (unsigned long) s.live, (unsigned long) s.peak);
+	for (i = 0; i < count; i++)
+	{
+		getAllocStats (languages [i], &s);
+		fprintf (stderr, "%s\n  {\"language\": %s%s%s, \"allocs\": %lu, \"reallocs\": %lu,"
+				 " \"frees\": %lu, \"bytes\": %llu, \"live\": %lu, \"peak\": %lu}",
+				 i? ",": "",
+				 (languages [i] < 0)? "": "\"",
+				 (languages [i] < 0)? "null": getLanguageName (languages [i]),
+				 (languages [i] < 0)? "": "\"",
+				 s.allocs, s.reallocs, s.frees, s.bytes,
+				 (unsigned long) s.live, (unsigned long) s.peak);
+	}
+	fputs ("]},\n", stderr);
+	eFree (languages);
+}
+#endif
+
+/* The peak of the resident memory of the process in kilobytes, or 0 if
+ * it is not known. */
+static unsigned long getMaxResidentKB (void)
+{
+#if defined (HAVE_GETRUSAGE) && defined (HAVE_SYS_RESOURCE_H)
+	struct rusage usage;
+
+	if (getrusage (RUSAGE_SELF, &usage) == 0)
+# ifdef __APPLE__
+		return (unsigned long) usage.ru_maxrss / 1024;	/* in bytes there */
+# else
+		return (unsigned long) usage.ru_maxrss;
+# endif
+#endif
+	return 0;
+}
+
+static void printJsonTotals (const clock_t *const timeStamps)
+{
+	unsigned int *languages;
+	const unsigned int count = sortLanguageTotals (&languages);
+	unsigned int i;
+
+	fprintf (stderr, "{\"files\": %ld, \"lines\": %ld, \"bytes\": %ld, \"rescans\": %ld,",
+			 Totals.files, Totals.lines, Totals.bytes, Totals.rescans);
+	fprintf (stderr, " \"tags\": %lu, \"totalTags\": %lu,",
+			 numTagsAdded (), numTagsTotal ());
+	fprintf (stderr, " \"cpuSeconds\": %.6f, \"sortCpuSeconds\": %.6f, \"maxResidentKB\": %lu,\n",
+			 ((double) (timeStamps [1] - timeStamps [0])) / CLOCKS_PER_SEC,
+			 ((double) (timeStamps [2] - timeStamps [1])) / CLOCKS_PER_SEC,
+			 getMaxResidentKB ());
+
+	fputs (" \"languages\": [", stderr);
+	for (i = 0; i < count; i++)
+	{
+		const struct languageTotals *t = LanguageTotals + languages [i];
+		fprintf (stderr, "%s\n  {\"language\": \"%s\", \"files\": %ld, \"lines\": %ld,"
+				 " \"bytes\": %ld, \"tags\": %lu, \"seconds\": %.6f, \"cpuSeconds\": %.6f}",
+				 i? ",": "", getLanguageName (languages [i]),
+				 t->files, t->lines, t->bytes, t->tags, t->seconds, t->cpuSeconds);
+	}
+	fputs ("],\n", stderr);
+
+#ifdef ALLOC_PROFILING
+	printJsonAllocTotals ();
+#endif
+	fputs (" \"phases\": {", stderr);
+	for (i = 0; i < COUNT_PHASES; i++)
+		fprintf (stderr, "%s\"%s\": %.6f", i? ", ": "", PhaseNames [i], PhaseSeconds [i]);
+	fputs ("}}\n", stderr);
+
+	eFree (languages);
+}
+
+static void printTotals (const clock_t *const timeStamps)
+{
+	const unsigned long totalTags = numTagsTotal();
+	const unsigned long addedTags = numTagsAdded();
+
+	if (Option.printTotals == TOTALS_JSON)
+	{
+		printJsonTotals (timeStamps);
+		return;
+	}
+
+	fprintf (stderr, "%ld file%s, %ld line%s (%ld kB) scanned",
+			Totals.files, plural (Totals.files),
+			Totals.lines, plural (Totals.lines),
+			Totals.bytes/1024L);
+#ifdef CLOCK_AVAILABLE
+	{
+		const double interval = ((double) (timeStamps [1] - timeStamps [0])) /
+								CLOCKS_PER_SEC;
+
+		fprintf (stderr, " in %.01f seconds", interval);
+		if (interval != (double) 0.0)
+			fprintf (stderr, " (%lu kB/s)",
+					(unsigned long) (Totals.bytes / interval) / 1024L);
+	}
+#endif
+	fputc ('\n', stderr);
+
+	if (Totals.rescans > 0)
+		fprintf (stderr, "%ld file rescan%s\n",
+				 Totals.rescans, plural (Totals.rescans));
+
+	fprintf (stderr, "%lu tag%s added to tag file",
+			addedTags, plural(addedTags));
+	if (Option.append || Option.update)
+		fprintf (stderr, " (now %lu tags)", totalTags);
+	fputc ('\n', stderr);
+
+	if (totalTags > 0  &&  Option.sorted != SO_UNSORTED)
+	{
+		fprintf (stderr, "%lu tag%s sorted", totalTags, plural (totalTags));
+#ifdef CLOCK_AVAILABLE
+		fprintf (stderr, " in %.02f seconds",
+				((double) (timeStamps [2] - timeStamps [1])) / CLOCKS_PER_SEC);
+#endif
+		fputc ('\n', stderr);
+	}
+
+#ifdef DEBUG
+	fprintf (stderr, "longest tag line = %lu\n",
+		 (unsigned long) maxTagsLine ());
+#endif
+
+	if (Option.printTotals >= TOTALS_EXTRA)
+		printExtraTotals ();
+	if (Option.printTotals == TOTALS_KINDS)
+		printKindTotals ();
+#ifdef ALLOC_PROFILING
+	printAllocTotals ();
+#endif
+}
+
+static bool etagsInclude (void)
+{
+	return (bool)(Option.etags && Option.etagsInclude != NULL);
+}
+
+extern void setMainLoop (mainLoopFunc func, void *data)
+{
+	mainLoop = func;
+	mainData = data;
+}
+
+static void runMainLoop (cookedArgs *args)
+{
+	(* mainLoop) (args, mainData);
+}
+
+static void batchMakeTags (cookedArgs *args, void *user CTAGS_ATTR_UNUSED)
+{
+	clock_t timeStamps [3];
+	bool resize = false;
+	bool files = (bool)(! cArgOff (args) || Option.fileList != NULL
+							  || Option.gitTree != NULL || Option.filter);
+
+	if (! files)
+	{
+		if (filesRequired ())
+			error (FATAL, "No files specified. Try \"%s --help\".",
+				getExecutableName ());
 		else if (! Option.recurse && ! etagsInclude ())
 			return;
 	}
 
-#define timeStamp(n) timeStamps[(n)]=(Option.printTotals ? clock():(clock_t)0)
-	if ((! Option.filter) && (! Option.printLanguage))
-		openTagFile ();
+#define timeStamp(n) timeStamps[(n)]=(Option.printTotals ? clock():(clock_t)0)
+	if (Option.traceEvents)
+		openTraceEvents (Option.traceEvents);
+	if ((! Option.filter) && (! Option.printLanguage))
+		openTagFile ();
+
+	timeStamp (0);
+
+	if (canUseJobQueue ())
+		JobQueue = stringListNew ();
+	else
+		Prefetch.enabled = ! (Option.filter || Option.interactive
+							  || Option.printLanguage);
+
+	if (Option.mergeShards)
+	{
+#ifdef EXTERNAL_SORT
+		verbose ("Merging shards\n");
+		mergeShardsFromArgs (args);
+#endif
+	}
+	else if (! cArgOff (args))
+	{
+		verbose ("Reading command line arguments\n");
+		resize = createTagsForArgs (args);
+	}
+	if (Option.fileList != NULL)
+	{
+		verbose ("Reading list file\n");
+		resize = (bool) (createTagsFromListFile (Option.fileList) || resize);
+	}
+	if (Option.filter)
+	{
+		verbose ("Reading filter input\n");
+		resize = (bool) (createTagsFromFileInput (stdin, true) || resize);
+	}
+	if (! files  &&  Option.recurse)
+		resize = recurseIntoDirectory (".", true);
+
+	resize = (bool) (parsePrefetchedFiles () || resize);
+	Prefetch.enabled = false;
+	if (JobQueue)
+	{
+		resize = (bool) (runJobQueue () || resize);
+		stringListDelete (JobQueue);
+		JobQueue = NULL;
+	}
+	/* Not queued: the workers would have to read the blobs again. */
+	if (Option.gitTree != NULL)
+	{
+		verbose ("Reading git tree %s\n", Option.gitTree);
+		resize = (bool) (createTagsForGitTree (Option.gitTree) || resize);
+	}
+
+	timeStamp (1);
+
+	beginTotalsPhase (PHASE_CLOSING);
+	beginTraceSpan ("close", NULL, NULL);
+	if ((! Option.filter) && (!Option.printLanguage))
+		closeTagFile (resize);
+	endTraceSpan ();
+	endTotalsPhase ();
+	closeTraceEvents ();
+
+	timeStamp (2);
+
+	if (Option.printTotals)
+		printTotals (timeStamps);
+	if (Option.reportSlow > 0)
+		printSlowFiles ();
+#undef timeStamp
+}
+
+#ifdef HAVE_JANSSON
+static void addEntryToIndex (tagIndex *index, const char *const path)
+{
+	tagIndex *const saved = IndexBeingFilled;
+
+	IndexBeingFilled = index;
+	createTagsForEntry (path);
+	IndexBeingFilled = saved;
+}
+
+static void printTagLine (const char *line, size_t length, void *data CTAGS_ATTR_UNUSED)
+{
+	json_t *response = json_pack ("{ss ss#}", "_type", "tag-line",
+								  "line", line, (int) length);
+
+	json_dumpf (response, stdout, JSON_PRESERVE_ORDER);
+	fputc ('\n', stdout);
+	json_decref (response);
+}
+
+/*  Requests are read with read (2) rather than stdio, so that poll (2)
+ *  can wait for them together with the reports of the workers.
+ */
+static struct sRequestReader {
+	char *buffer;
+	size_t start;				/* of the data not consumed yet */
+	size_t length;				/* of the data in buffer */
+	size_t size;				/* of buffer */
+	bool eof;
+} Requests;
+
+#define REQUEST_BUFFER_KEPT_SIZE (64 * 1024)
+
+/*  A generate-tags or generate-tags-batch request parsed in this process
+ *  stops past its "deadline_ms", or when a cancel request with its "id"
+ *  as "target" comes. The cancel request comes while the input is read,
+ *  so the requests following the one being parsed are looked at now and
+ *  then; the cancel request itself is answered in its turn.
+ */
+#define CANCEL_POLL_INTERVAL 0.005	/* in seconds */
+
+static struct sRequestWatch {
+	json_t *id;					/* of the request to cancel, or NULL */
+	double deadline;			/* a clock of getTotalsClock (), or 0.0 */
+	double nextPoll;
+	size_t scanned;				/* of the data after Requests.start */
+	bool cancelled;
+	bool timedOut;
+} Watch;
+
+#ifdef HAVE_WORKING_FORK
+static void waitForRequests (void);
+#endif
+
+static void fillRequestBuffer (void)
+{
+	ssize_t n;
+
+	if (Requests.start > 0)
+	{
+		memmove (Requests.buffer, Requests.buffer + Requests.start,
+				 Requests.length - Requests.start);
+		Requests.length -= Requests.start;
+		Requests.start = 0;
+	}
+	/* The buffer grows while requests come faster than they are
+	   processed. Once they are caught up with, it is given back not to
+	   keep the peak for the life of the process. */
+	if (Requests.size > REQUEST_BUFFER_KEPT_SIZE
+		&& Requests.length < Requests.size / 4)
+	{
+		while (Requests.size > REQUEST_BUFFER_KEPT_SIZE
+			   && Requests.length < Requests.size / 4)
+			Requests.size /= 2;
+		Requests.buffer = xRealloc (Requests.buffer, Requests.size, char);
+	}
+	if (Requests.size - Requests.length < 4096)
+	{
+		Requests.size = Requests.size? Requests.size * 2: 8192;
+		Requests.buffer = xRealloc (Requests.buffer, Requests.size, char);
+	}
+
+#ifdef HAVE_WORKING_FORK
+	waitForRequests ();
+#endif
+	do
+		n = read (0, Requests.buffer + Requests.length,
+				  Requests.size - Requests.length);
+	while (n < 0 && errno == EINTR);
+
+	if (n < 0)
+		error (WARNING | PERROR, "cannot read requests");
+	if (n <= 0)
+		Requests.eof = true;
+	else
+		Requests.length += n;
+}
+
+/* Read a request line of any length. */
+static bool readRequestLine (vString *line)
+{
+	while (true)
+	{
+		const char *start = Requests.buffer + Requests.start;
+		const size_t available = Requests.length - Requests.start;
+		const char *nl = available? memchr (start, '\n', available): NULL;
+
+		if (nl || (Requests.eof && available > 0))
+		{
+			const size_t length = nl? (size_t) (nl - start) + 1: available;
+
+			vStringNCopyS (line, start, length);
+			Requests.start += length;
+			return true;
+		}
+		if (Requests.eof)
+			return false;
+		fillRequestBuffer ();
+	}
+}
+
+/* Read SIZE bytes following a request into DATA, or skip them if DATA
+   is NULL. Return the number of bytes read. */
+static size_t readRequestData (void *data, size_t size)
+{
+	size_t done = 0;
+
+	while (done < size)
+	{
+		const size_t available = Requests.length - Requests.start;
+		size_t n;
+
+		if (available == 0)
+		{
+			if (Requests.eof)
+				break;
+			fillRequestBuffer ();
+			continue;
+		}
+		n = (available < size - done)? available: size - done;
+		if (data)
+			memcpy ((char *) data + done, Requests.buffer + Requests.start, n);
+		Requests.start += n;
+		Watch.scanned = (Watch.scanned > n)? Watch.scanned - n: 0;
+		done += n;
+	}
+	return done;
+}
+
+/*  With --_interactive=framed, a request is a Request message preceded
+ *  with its size as a varint, like the records of the protobuf output:
+ *
+ *  message Request {
+ *    string command = 1;
+ *    bytes filename = 2;
+ *    int64 size = 3;          // of the contents following the request
+ *    int64 id = 4;
+ *    int64 target = 5;        // of a cancel request
+ *    int64 deadline_ms = 6;
+ *    string json = 15;        // an object of the other members
+ *  }
+ *
+ *  It is made into the object of the members it has, so that it is
+ *  handled like a request line, without parsing any JSON text for the
+ *  usual ones.
+ */
+#define REQUEST_FRAME_JSON 15
+
+static bool FramedRequests;
+
+static const struct requestFrameMember {
+	const char *name;
+	bool isString;
+} RequestFrameMembers [] = {
+	[1] = { "command",     true  },
+	[2] = { "filename",    true  },
+	[3] = { "size",        false },
+	[4] = { "id",          false },
+	[5] = { "target",      false },
+	[6] = { "deadline_ms", false },
+};
+
+/* Read a request frame into *DATA, of *LENGTH bytes. Return false at the
+   end of the requests. */
+static bool readRequestFrame (unsigned char **data, size_t *length)
+{
+	static unsigned char *buffer;
+	static size_t size;
+	unsigned char prefix [10];
+	uint64_t n;
+	size_t count, offset;
+
+	for (count = 0; count < sizeof (prefix); count++)
+	{
+		if (readRequestData (prefix + count, 1) == 0)
+			break;
+		if (! (prefix [count] & 0x80))
+		{
+			count++;
+			break;
+		}
+	}
+	if (count == 0)
+		return false;
+
+	offset = 0;
+	if (! readProtobufVarint (prefix, count, &offset, &n) || n > SIZE_MAX - 1)
+	{
+		error (WARNING, "broken request frame");
+		Requests.eof = true;
+		Requests.start = Requests.length;
+		return false;
+	}
+	if (size < n + 1)
+	{
+		size = n + 1;
+		buffer = xRealloc (buffer, size, unsigned char);
+	}
+	*length = readRequestData (buffer, (size_t) n);
+	*data = buffer;
+	return true;
+}
+
+/* The request object of the LENGTH bytes of a frame at DATA, or NULL if
+   they are broken. */
+static json_t *makeRequestFromFrame (const unsigned char *data, size_t length)
+{
+	json_t *members = json_object ();
+	json_t *request = NULL;
+	size_t offset = 0;
+
+	while (offset < length)
+	{
+		unsigned int field;
+		uint64_t n;
+		const unsigned char *bytes;
+		json_t *value;
+
+		if (! readProtobufField (data, length, &offset, &field, &n, &bytes))
+			goto broken;
+
+		if (field == REQUEST_FRAME_JSON)
+		{
+			if (bytes == NULL || request)
+				goto broken;
+			request = json_loadb ((const char *) bytes, (size_t) n, 0, NULL);
+			if (! json_is_object (request))
+				goto broken;
+			continue;
+		}
+		/* The unknown fields are skipped, as protobuf readers do. */
+		if (field >= ARRAY_SIZE (RequestFrameMembers)
+			|| RequestFrameMembers [field].name == NULL)
+			continue;
+
+		if (RequestFrameMembers [field].isString != (bytes != NULL))
+			goto broken;
+		if (bytes)
+			value = json_stringn ((const char *) bytes, (size_t) n);
+		else
+			value = json_integer ((json_int_t) (int64_t) n);
+		if (value == NULL)
+			goto broken;
+		json_object_set_new (members, RequestFrameMembers [field].name, value);
+	}
+
+	if (request == NULL)
+		request = json_object ();
+	json_object_update (request, members);
+	json_decref (members);
+	return request;
+
+ broken:
+	json_decref (request);
+	json_decref (members);
+	return NULL;
+}
+
+/* The deadline of REQUEST, or 0.0 if it has none. */
+static double getRequestDeadline (json_t *request)
+{
+	json_int_t ms;
+
+	if (json_unpack (request, "{sI}", "deadline_ms", &ms) == -1 || ms <= 0)
+		return 0.0;
+	return getTotalsClock () + ms / 1000.0;
+}
+
+#ifdef HAVE_WORKING_FORK
+/* REQUEST is released. */
+static bool isCancelRequestFor (json_t *request, json_t *id)
+{
+	json_t *command;
+	bool cancel;
+
+	if (! request)
+		return false;
+	command = json_object_get (request, "command");
+	cancel = (json_is_string (command)
+			  && strcmp (json_string_value (command), "cancel") == 0
+			  && json_equal (json_object_get (request, "target"), id));
+	json_decref (request);
+	return cancel;
+}
+
+/* Look at the request frames read since the last call, skipping the
+   contents following them. */
+static bool findCancelRequestFrame (void)
+{
+	while (Watch.scanned < Requests.length - Requests.start)
+	{
+		const unsigned char *const start = (unsigned char *) Requests.buffer
+			+ Requests.start + Watch.scanned;
+		const size_t available = Requests.length - Requests.start - Watch.scanned;
+		size_t offset = 0;
+		uint64_t length;
+		json_t *request;
+		json_int_t size;
+
+		if (! readProtobufVarint (start, available, &offset, &length)
+			|| length > available - offset)
+			return false;
+		Watch.scanned += offset + (size_t) length;
+		request = makeRequestFromFrame (start + offset, (size_t) length);
+		if (request
+			&& json_unpack (request, "{sI}", "size", &size) == 0 && size > 0
+			&& ! json_object_get (request, "content")
+			&& ! json_object_get (request, "mapped"))
+			Watch.scanned += (size_t) size;
+		if (isCancelRequestFor (request, Watch.id))
+			return true;
+	}
+	return false;
+}
+
+/* Look at the request lines read since the last call. */
+static bool findCancelRequest (void)
+{
+	if (FramedRequests)
+		return findCancelRequestFrame ();
+
+	while (true)
+	{
+		const char *start = Requests.buffer + Requests.start + Watch.scanned;
+		const size_t available = Requests.length - Requests.start - Watch.scanned;
+		const char *nl = available? memchr (start, '\n', available): NULL;
+
+		if (nl == NULL)
+			return false;
+		Watch.scanned += (nl - start) + 1;
+		if (*start == '{'
+			&& isCancelRequestFor (json_loadb (start, nl - start,
+											   JSON_DISABLE_EOF_CHECK, NULL),
+								   Watch.id))
+			return true;
+	}
+}
+#endif
+
+static bool isWatchedRequestStopped (void)
+{
+	const double now = getTotalsClock ();
+
+	if (Watch.deadline > 0.0 && now > Watch.deadline)
+		Watch.timedOut = true;
+#ifdef HAVE_WORKING_FORK
+	else if (Watch.id && now >= Watch.nextPoll)
+	{
+		struct pollfd fd = { .fd = 0, .events = POLLIN };
+
+		Watch.nextPoll = now + CANCEL_POLL_INTERVAL;
+		if (! Requests.eof && poll (&fd, 1, 0) > 0)
+			fillRequestBuffer ();
+		Watch.cancelled = findCancelRequest ();
+	}
+#endif
+	return Watch.timedOut || Watch.cancelled;
+}
+
+/* ID is NULL if the request cannot be cancelled. */
+static void watchRequest (json_t *id, double deadline)
+{
+	Watch.id = id;
+	Watch.deadline = deadline;
+	Watch.nextPoll = 0.0;
+	Watch.scanned = 0;
+	Watch.cancelled = false;
+	Watch.timedOut = false;
+	if (id || deadline > 0.0)
+		setInputFileInterruptCheck (isWatchedRequestStopped);
+}
+
+static void unwatchRequest (void)
+{
+	Watch.id = NULL;
+	setInputFileInterruptCheck (NULL);
+}
+
+static bool isWatchedRequestCut (void)
+{
+	return Watch.cancelled || Watch.timedOut;
+}
+
+/* Tell in RESPONSE why the request stopped, if it did. */
+static json_t *addStopToResponse (json_t *response, bool cancelled, bool timedOut)
+{
+	if (cancelled)
+		json_object_set_new (response, "cancelled", json_true ());
+	else if (timedOut)
+		json_object_set_new (response, "timed_out", json_true ());
+	return response;
+}
+
+/* ID is the "id" of the request, echoed so that a client sending
+   requests without waiting for the responses can match them. */
+static json_t *makeCompletedResponse (const char *command, json_t *id)
+{
+	json_t *response = json_pack ("{ss ss}", "_type", "completed",
+								  "command", command);
+
+	if (id)
+		json_object_set (response, "id", id);
+	return response;
+}
+
+static void printResponse (json_t *response)
+{
+	if (getTagWriterType () == WRITER_PROTOBUF)
+	{
+		char *text = json_dumps (response, JSON_PRESERVE_ORDER);
+		MIO *mio = mio_new_fp (stdout, NULL);
+
+		writeProtobufJsonRecord (mio, text);
+		mio_free (mio);
+		eFree (text);
+	}
+	else
+	{
+		json_dumpf (response, stdout, JSON_PRESERVE_ORDER);
+		fputc ('\n', stdout);
+	}
+	fflush (stdout);
+	json_decref (response);
+}
+
+/* The contents of a generate-tags request are given as "content", or as
+   "size" bytes read after it, or as "size" bytes from "offset" in the
+   "mapped" file, or read from the file if none is. */
+static bool unpackGenerateTagsRequest (json_t *request, bool sandbox,
+									   const char **filename,
+									   const char **content,
+									   const char **mapped,
+									   json_int_t *offset,
+									   json_int_t *size)
+{
+	*size = -1;
+	*offset = 0;
+	*content = NULL;
+	*mapped = NULL;
 
-	timeStamp (0);
+	if (json_unpack (request, "{ss}", "filename", filename) == -1)
+	{
+		error (FATAL, "invalid generate-tags request");
+		return false;
+	}
+
+	json_unpack (request, "{sI}", "size", size);
+	json_unpack (request, "{ss}", "content", content);
+	json_unpack (request, "{ss}", "mapped", mapped);
+	json_unpack (request, "{sI}", "offset", offset);
 
-	if (! cArgOff (args))
+	if (*mapped && (*offset < 0 || *size < -1))
 	{
-		verbose ("Reading command line arguments\n");
-		resize = createTagsForArgs (args);
+		error (FATAL, "invalid range of a mapped file in a generate-tags request");
+		return false;
 	}
-	if (Option.fileList != NULL)
+	if (*content == NULL && (*size == -1 || *mapped) && sandbox)
 	{
-		verbose ("Reading list file\n");
-		resize = (bool) (createTagsFromListFile (Option.fileList) || resize);
+		error (FATAL,
+			   "invalid request in sandbox submode: reading file contents from a file is limited");
+		return false;
 	}
-	if (Option.filter)
+	return true;
+}
+
+/* Parse the SIZE bytes from OFFSET in MAPPED as the contents of FILENAME.
+   The range is mapped rather than copied where mmap is available. */
+static void parseMappedContents (const char *filename, const char *mapped,
+								 long offset, long size)
+{
+	MIO *mio = mio_new_mapped_range (mapped, offset,
+									 size < 0? (size_t) -1: (size_t) size);
+
+	if (mio == NULL)
 	{
-		verbose ("Reading filter input\n");
-		resize = (bool) (createTagsFromFileInput (stdin, true) || resize);
+		error (WARNING | PERROR, "cannot map the contents of \"%s\" from \"%s\"",
+			   filename, mapped);
+		return;
 	}
-	if (! files  &&  Option.recurse)
-		resize = recurseIntoDirectory (".");
+	parseFileWithMio (filename, mio);
+	mio_free (mio);
+}
 
-	timeStamp (1);
+/* Generate the tags of the file or the contents REQUEST specifies. */
+static bool generateTagsForRequest (json_t *request, bool sandbox)
+{
+	json_int_t size, offset;
+	const char *filename;
+	const char *content;
+	const char *mapped;
+
+	if (! unpackGenerateTagsRequest (request, sandbox, &filename, &content,
+									 &mapped, &offset, &size))
+		return false;
+
+	if (content)
+	{							/* contents in the request */
+		MIO *mio = mio_new_memory ((unsigned char *) content, strlen (content),
+								   NULL, NULL);
+		parseFileWithMio (filename, mio);
+		mio_free (mio);
+	}
+	else if (mapped)
+	{							/* contents in shared memory */
+		parseMappedContents (filename, mapped, (long) offset, (long) size);
+	}
+	else if (size == -1)
+	{							/* read from disk */
+		createTagsForEntry (filename);
+	}
+	else
+	{							/* read nbytes from stream */
+		unsigned char *data = eMalloc (size);
+		size = readRequestData (data, size);
+		MIO *mio = mio_new_memory (data, size, eRealloc, eFree);
+		parseFileWithMio (filename, mio);
+		mio_free (mio);
+	}
+	return true;
+}
 
-	if ((! Option.filter) && (!Option.printLanguage))
-		closeTagFile (resize);
+static void printTagBufferLine (const char *line, size_t length,
+								void *data CTAGS_ATTR_UNUSED)
+{
+	fwrite (line, 1, length, stdout);
+	fputc ('\n', stdout);
+}
 
-	timeStamp (2);
+struct tagBufferChanges {
+	json_int_t added, removed;
+};
 
-	if (Option.printTotals)
-		printTotals (timeStamps);
-#undef timeStamp
+static void printAddedTagBufferLine (const char *line, size_t length, void *data)
+{
+	struct tagBufferChanges *changes = data;
+
+	changes->added++;
+	printTagBufferLine (line, length, NULL);
 }
 
-#ifdef HAVE_JANSSON
+/* LINE of a json tag is printed as a "removed-tag" object. */
+static void printRemovedTagBufferLine (const char *line, size_t length,
+									   void *data)
+{
+	struct tagBufferChanges *changes = data;
+	json_t *tag = json_loadb (line, length, 0, NULL);
+
+	changes->removed++;
+	if (! json_is_object (tag))
+	{
+		json_decref (tag);
+		return;
+	}
+	json_object_set_new (tag, "_type", json_string ("removed-tag"));
+	json_dumpf (tag, stdout, JSON_PRESERVE_ORDER);
+	fputc ('\n', stdout);
+	json_decref (tag);
+}
+
+/* Generate the tags of the contents given in REQUEST like
+   generateTagsForRequest (), keeping the contents in BUFFERS for
+   edit-buffer requests. */
+static bool generateTagsForRetainedRequest (tagBufferSet **buffers,
+											json_t *request, bool sandbox)
+{
+	json_int_t size, offset;
+	const char *filename;
+	const char *content;
+	const char *mapped;
+
+	if (! unpackGenerateTagsRequest (request, sandbox, &filename, &content,
+									 &mapped, &offset, &size))
+		return false;
+	if (mapped || (content == NULL && size == -1))
+	{
+		error (FATAL, "invalid generate-tags request: only contents in the request can be retained");
+		return false;
+	}
+
+	if (*buffers == NULL)
+		*buffers = tagBufferSetNew ();
+	if (content)
+		tagBufferPut (*buffers, filename, content, strlen (content),
+					  printTagBufferLine, NULL);
+	else
+	{
+		char *data = eMalloc (size);
+		size = readRequestData (data, size);
+		tagBufferPut (*buffers, filename, data, size, printTagBufferLine, NULL);
+		eFree (data);
+	}
+	return true;
+}
+
+/* Apply the edit REQUEST gives to the buffer kept in BUFFERS, and print
+   the tags changed by it. */
+static bool editTagBuffer (tagBufferSet *buffers, json_t *request,
+						   struct tagBufferChanges *changes)
+{
+	const char *filename;
+	const char *content = NULL;
+	json_int_t offset, length = 0, size = -1;
+	char *data = NULL;
+	bool edited;
+
+	if (json_unpack (request, "{ss sI}", "filename", &filename,
+					 "offset", &offset) == -1)
+	{
+		error (FATAL, "invalid edit-buffer request");
+		return false;
+	}
+	json_unpack (request, "{sI}", "length", &length);
+	json_unpack (request, "{ss}", "content", &content);
+	json_unpack (request, "{sI}", "size", &size);
+	if (content == NULL && size != -1)
+	{
+		data = eMalloc (size);
+		size = readRequestData (data, size);
+		content = data;
+	}
+	else if (content)
+		size = strlen (content);
+
+	if (content == NULL || offset < 0 || length < 0)
+	{
+		error (FATAL, "invalid edit-buffer request");
+		edited = false;
+	}
+	else if (! (buffers
+			  && tagBufferEdit (buffers, filename, (size_t) offset,
+								(size_t) length, content, (size_t) size,
+								printRemovedTagBufferLine,
+								printAddedTagBufferLine, changes)))
+	{
+		error (FATAL, "no buffer of \"%s\" holding the edited range", filename);
+		edited = false;
+	}
+	else
+		edited = true;
+	if (data)
+		eFree (data);
+	return edited;
+}
+
+/* Skip the contents sent for the files of a batch from the failed one,
+   whose contents have not been read. */
+static void skipBatchContents (json_t *files, size_t i)
+{
+	for (; i < json_array_size (files); i++)
+	{
+		json_t *file = json_array_get (files, i);
+		json_int_t size = -1;
+		const char *content, *mapped;
+
+		if (json_unpack (file, "{ss}", "content", &content) == -1
+			&& json_unpack (file, "{ss}", "mapped", &mapped) == -1
+			&& json_unpack (file, "{sI}", "size", &size) != -1)
+			readRequestData (NULL, size);
+	}
+}
+
+static void generateTagsBatch (json_t *files, json_t *id, bool sandbox)
+{
+	json_t *response;
+	size_t i;
+
+	/* The tag file is opened once for all the files, and the tags of
+	   each file are sent as soon as it is parsed. The files after the
+	   one cut by a cancel request or the deadline are not parsed. */
+	openTagFile ();
+	for (i = 0; i < json_array_size (files); i++)
+	{
+		json_t *file = json_array_get (files, i);
+		json_t *fileId = json_object_get (file, "id");
+
+		setErrorPrinter (jsonErrorPrinter, fileId? fileId: id);
+		if (! json_is_object (file)
+			|| ! generateTagsForRequest (file, sandbox))
+		{
+			skipBatchContents (files, i);
+			break;
+		}
+		printResponse (addStopToResponse (makeCompletedResponse ("generate-tags", fileId),
+										  Watch.cancelled, Watch.timedOut));
+		if (isWatchedRequestCut ())
+		{
+			skipBatchContents (files, ++i);
+			break;
+		}
+	}
+	closeTagFile (false);
+	setErrorPrinter (jsonErrorPrinter, id);
+
+	if (i == json_array_size (files) || isWatchedRequestCut ())
+	{
+		response = makeCompletedResponse ("generate-tags-batch", id);
+		json_object_set_new (response, "files", json_integer (i));
+		printResponse (addStopToResponse (response,
+										  Watch.cancelled, Watch.timedOut));
+	}
+}
+
+#ifdef HAVE_WORKING_FORK
+/*  With --jobs, the files of generate-tags requests are parsed by worker
+ *  processes, each with its own parser state, while the next requests
+ *  are read. The responses are sent as the workers finish, so they may
+ *  not be in the order of the requests; the ids tell them apart.
+ */
+struct interactiveBatch {
+	json_t *id;
+	unsigned int files;			/* given to workers */
+	unsigned int pending;		/* given but not reported yet */
+	bool complete;				/* all the files are given */
+	bool failed;
+};
+
+struct interactiveJob {
+	bool busy;
+	json_t *id;
+	struct interactiveBatch *batch;	/* NULL if not for a file of a batch */
+};
+
+static struct interactiveJob *InteractiveJobs;	/* WORKER_QUEUE_DEPTH per worker */
+static unsigned int InteractiveJobsBusy;
+
+static void finishBatch (struct interactiveBatch *batch)
+{
+	if (! batch->complete || batch->pending > 0)
+		return;
+
+	if (! batch->failed)
+	{
+		json_t *response = makeCompletedResponse ("generate-tags-batch", batch->id);
+		json_object_set_new (response, "files", json_integer (batch->files));
+		printResponse (response);
+	}
+	if (batch->id)
+		json_decref (batch->id);
+	eFree (batch);
+}
+
+static void deliverReport (unsigned int i)
+{
+	struct jobReport report;
+	char *output = readReport (i, &report);
+	struct interactiveJob *job = InteractiveJobs + report.index;
+
+	openTagFile ();
+	appendTagFileFragment (output, &report.fragment);
+	closeTagFile (false);
+	eFree (output);
+	printResponse (addStopToResponse (makeCompletedResponse ("generate-tags", job->id),
+									  false, report.timedOut));
+
+	if (job->id)
+		json_decref (job->id);
+	job->busy = false;
+	InteractiveJobsBusy--;
+	if (job->batch)
+	{
+		job->batch->pending--;
+		finishBatch (job->batch);
+	}
+}
+
+/*  Deliver the reports of the workers coming until one can take a file,
+ *  or, with REQUESTS, until a request comes. Return whether one came.
+ */
+static bool pollInteractiveWorkers (bool requests)
+{
+	struct pollfd *fds = xMalloc (Scheduler.count + 1, struct pollfd);
+	unsigned int *owners = xMalloc (Scheduler.count + 1, unsigned int);
+	unsigned int nfds = 0;
+	unsigned int i;
+	bool readable = false;
+	int r;
+
+	if (requests)
+	{
+		fds [nfds].fd = 0;
+		fds [nfds].events = POLLIN;
+		owners [nfds++] = Scheduler.count;
+	}
+	for (i = 0; i < Scheduler.count; i++)
+	{
+		if (Scheduler.workers [i].pending == 0)
+			continue;
+		fds [nfds].fd = Scheduler.workers [i].reportFd;
+		fds [nfds].events = POLLIN;
+		owners [nfds++] = i;
+	}
+
+	do
+		r = poll (fds, nfds, -1);
+	while (r < 0 && errno == EINTR);
+	if (r < 0)
+		error (FATAL | PERROR, "cannot poll workers");
+
+	for (i = 0; i < nfds; i++)
+	{
+		if (! (fds [i].revents & (POLLIN | POLLHUP | POLLERR)))
+			continue;
+		if (owners [i] == Scheduler.count)
+			readable = true;
+		else
+			deliverReport (owners [i]);
+	}
+	eFree (owners);
+	eFree (fds);
+	return readable;
+}
+
+static void waitForRequests (void)
+{
+	if (Scheduler.workers == NULL)
+		return;
+
+	while (InteractiveJobsBusy > 0)
+		if (pollInteractiveWorkers (true))
+			return;
+}
+
+/*  Give the file or the contents REQUEST specifies to a worker.
+ */
+static bool dispatchGenerateTags (json_t *request, json_t *id,
+								  struct interactiveBatch *batch,
+								  double deadline, bool sandbox)
+{
+	json_int_t size, offset;
+	const char *filename;
+	const char *content;
+	const char *mapped;
+	char *data = NULL;
+	char *idText = NULL;
+	struct jobRequest jobRequest;
+	struct interactiveJob *job;
+	unsigned int i;
+
+	if (! unpackGenerateTagsRequest (request, sandbox, &filename, &content,
+									 &mapped, &offset, &size))
+		return false;
+
+	jobRequest.contentLength = -1;
+	jobRequest.mappedLength = 0;
+	jobRequest.offset = 0;
+	jobRequest.deadline = deadline;
+	if (content)
+		jobRequest.contentLength = strlen (content);
+	else if (mapped)
+	{
+		/* The worker maps the file by itself. */
+		jobRequest.mappedLength = strlen (mapped);
+		jobRequest.offset = (long) offset;
+		jobRequest.contentLength = (long) size;
+	}
+	else if (size != -1)
+	{
+		data = eMalloc (size);
+		jobRequest.contentLength = readRequestData (data, size);
+		content = data;
+	}
+
+	while (Scheduler.workers [findIdlestWorker ()].pending >= WORKER_QUEUE_DEPTH)
+		pollInteractiveWorkers (false);
+
+	for (i = 0; InteractiveJobs [i].busy; i++)
+		;
+	job = InteractiveJobs + i;
+	job->busy = true;
+	job->id = id;
+	if (id)
+	{
+		json_incref (id);
+		idText = json_dumps (id, JSON_ENCODE_ANY);
+	}
+	job->batch = batch;
+	if (batch)
+	{
+		batch->files++;
+		batch->pending++;
+	}
+	InteractiveJobsBusy++;
+
+	jobRequest.index = i;
+	jobRequest.length = strlen (filename);
+	jobRequest.idLength = idText? strlen (idText): 0;
+	sendJobRequest (findIdlestWorker (), &jobRequest, filename, idText,
+					mapped, content);
+
+	if (idText)
+		eFree (idText);
+	if (data)
+		eFree (data);
+	return true;
+}
+
+static void dispatchGenerateTagsBatch (json_t *files, json_t *id,
+									   double deadline, bool sandbox)
+{
+	struct interactiveBatch *batch = xCalloc (1, struct interactiveBatch);
+	size_t i;
+
+	batch->id = id;
+	if (id)
+		json_incref (id);
+
+	for (i = 0; i < json_array_size (files); i++)
+	{
+		json_t *file = json_array_get (files, i);
+		json_t *fileId = json_object_get (file, "id");
+
+		setErrorPrinter (jsonErrorPrinter, fileId? fileId: id);
+		if (! json_is_object (file)
+			|| ! dispatchGenerateTags (file, fileId, batch, deadline, sandbox))
+		{
+			skipBatchContents (files, i);
+			batch->failed = true;
+			break;
+		}
+	}
+	setErrorPrinter (jsonErrorPrinter, id);
+
+	batch->complete = true;
+	finishBatch (batch);
+}
+
+/*  Run in a worker process. A cancel request does not reach it, but the
+ *  DEADLINE does. Return whether the input is cut by it.
+ */
+static bool runInteractiveJob (const char *name, const char *idText,
+							   const char *mapped, long offset,
+							   const char *content, long contentLength,
+							   double deadline, MIO *output)
+{
+	json_t *id = NULL;
+	bool timedOut;
+
+	if (*idText)
+		id = json_loads (idText, JSON_DECODE_ANY, NULL);
+
+	/* The errors are sent with the tags. */
+	setJsonErrorOutput (output);
+	setErrorPrinter (jsonErrorPrinter, id);
+	watchRequest (NULL, deadline);
+	if (mapped)
+		parseMappedContents (name, mapped, offset, contentLength);
+	else if (contentLength < 0)
+		createTagsForEntry (name);
+	else
+	{
+		MIO *mio = mio_new_memory ((unsigned char *) content, contentLength,
+								   NULL, NULL);
+		parseFileWithMio (name, mio);
+		mio_free (mio);
+	}
+	timedOut = Watch.timedOut;
+	unwatchRequest ();
+	setErrorPrinter (jsonErrorPrinter, NULL);
+	setJsonErrorOutput (NULL);
+
+	if (id)
+		json_decref (id);
+	return timedOut;
+}
+
+static void startInteractiveWorkers (bool sandbox)
+{
+	Scheduler.sandbox = sandbox;
+	startWorkers ();
+	InteractiveJobs = xCalloc (Scheduler.count * WORKER_QUEUE_DEPTH,
+							   struct interactiveJob);
+	InteractiveJobsBusy = 0;
+}
+
+static void finishInteractiveWorkers (bool sandbox)
+{
+	while (InteractiveJobsBusy > 0)
+		pollInteractiveWorkers (false);
+
+	/* The sandbox allows neither close (2) nor waitpid (2). The workers
+	   exit when the pipes are closed with this process. */
+	if (! sandbox)
+		stopWorkers ();
+	eFree (InteractiveJobs);
+	InteractiveJobs = NULL;
+}
+#endif
+
 void interactiveLoop (cookedArgs *args CTAGS_ATTR_UNUSED, void *user)
 {
 	struct interactiveModeArgs *iargs = user;
 
+#ifdef HAVE_WORKING_FORK
+	/* The workers enter the sandbox by themselves. */
+	if (Option.jobs > 1)
+		startInteractiveWorkers (iargs->sandbox);
+#endif
+
 	if (iargs->sandbox) {
 		/* As of jansson 2.6, the object hashing is seeded off
 		   of /dev/urandom, so trigger the hash seeding
@@ -506,24 +3019,48 @@ void interactiveLoop (cookedArgs *args CTAGS_ATTR_UNUSED, void *user)
 		}
 	}
 
-	char buffer[1024];
+	vString *buffer = vStringNew ();
+	unsigned char *frame = NULL;
+	size_t frameLength = 0;
 	json_t *request;
+	tagIndex *index = NULL;	/* of the watched files */
+	tagBufferSet *buffers = NULL;	/* retained by generate-tags requests */
 
-	fputs ("{\"_type\": \"program\", \"name\": \"" PROGRAM_NAME "\", \"version\": \"" PROGRAM_VERSION "\"}\n", stdout);
-	fflush (stdout);
+	printResponse (json_pack ("{ss ss ss}", "_type", "program",
+							  "name", PROGRAM_NAME, "version", PROGRAM_VERSION));
 
-	while (fgets (buffer, sizeof(buffer), stdin))
+	FramedRequests = iargs->framed;
+	while (FramedRequests
+		   ? readRequestFrame (&frame, &frameLength)
+		   : readRequestLine (buffer))
 	{
-		if (buffer[0] == '\n')
-			continue;
-
-		request = json_loads (buffer, JSON_DISABLE_EOF_CHECK, NULL);
-		if (! request)
+		if (FramedRequests)
 		{
-			error (FATAL, "invalid json");
-			goto next;
+			request = makeRequestFromFrame (frame, frameLength);
+			if (! request)
+			{
+				error (FATAL, "invalid request frame");
+				goto next;
+			}
+		}
+		else
+		{
+			if (vStringChar (buffer, 0) == '\n')
+				continue;
+
+			request = json_loads (vStringValue (buffer), JSON_DISABLE_EOF_CHECK, NULL);
+			if (! request)
+			{
+				error (FATAL, "invalid json");
+				goto next;
+			}
 		}
 
+		initRequestTrashBox ();
+
+		json_t *id = json_object_get (request, "id");
+		setErrorPrinter (jsonErrorPrinter, id);
+
 		json_t *command = json_object_get (request, "command");
 		if (! command)
 		{
@@ -531,42 +3068,182 @@ void interactiveLoop (cookedArgs *args CTAGS_ATTR_UNUSED, void *user)
 			goto next;
 		}
 
+		/* The changes since the last request are applied first. */
+		if (index)
+			tagIndexRefresh (index);
+
 		if (!strcmp ("generate-tags", json_string_value (command)))
 		{
-			json_int_t size = -1;
+			bool generated;
+			int retain = 0;
+
+			json_unpack (request, "{sb}", "retain", &retain);
+			/* The retained tags are compared as lines. */
+			if (retain && getTagWriterType () == WRITER_PROTOBUF)
+			{
+				error (FATAL, "invalid generate-tags request: tags cannot be retained in the output format");
+				goto next;
+			}
+
+#ifdef HAVE_WORKING_FORK
+			/* The retained buffers are parsed in this process. */
+			if (Scheduler.workers && ! retain)
+			{
+				dispatchGenerateTags (request, id, NULL,
+									  getRequestDeadline (request), iargs->sandbox);
+				goto next;
+			}
+#endif
+			watchRequest (id, getRequestDeadline (request));
+			if (retain)
+				generated = generateTagsForRetainedRequest (&buffers, request,
+															iargs->sandbox);
+			else
+			{
+				openTagFile ();
+				generated = generateTagsForRequest (request, iargs->sandbox);
+				closeTagFile (false);
+			}
+			unwatchRequest ();
+			if (generated)
+				printResponse (addStopToResponse (makeCompletedResponse ("generate-tags", id),
+												  Watch.cancelled, Watch.timedOut));
+		}
+		else if (!strcmp ("generate-tags-batch", json_string_value (command)))
+		{
+			json_t *files = json_object_get (request, "files");
+
+			if (! json_is_array (files))
+			{
+				error (FATAL, "invalid generate-tags-batch request");
+				goto next;
+			}
+
+#ifdef HAVE_WORKING_FORK
+			if (Scheduler.workers)
+				dispatchGenerateTagsBatch (files, id, getRequestDeadline (request),
+										   iargs->sandbox);
+			else
+#endif
+			{
+				watchRequest (id, getRequestDeadline (request));
+				generateTagsBatch (files, id, iargs->sandbox);
+				unwatchRequest ();
+			}
+		}
+		else if (!strcmp ("edit-buffer", json_string_value (command)))
+		{
+			struct tagBufferChanges changes = { 0, 0 };
+			bool edited;
+
+			watchRequest (id, getRequestDeadline (request));
+			edited = editTagBuffer (buffers, request, &changes);
+			unwatchRequest ();
+			if (edited)
+			{
+				json_t *response = makeCompletedResponse ("edit-buffer", id);
+				json_object_set_new (response, "added", json_integer (changes.added));
+				json_object_set_new (response, "removed", json_integer (changes.removed));
+				printResponse (addStopToResponse (response,
+												  Watch.cancelled, Watch.timedOut));
+			}
+		}
+		else if (!strcmp ("close-buffer", json_string_value (command)))
+		{
 			const char *filename;
 
 			if (json_unpack (request, "{ss}", "filename", &filename) == -1)
 			{
-				error (FATAL, "invalid generate-tags request");
+				error (FATAL, "invalid close-buffer request");
+				goto next;
+			}
+			if (! buffers || ! tagBufferRemove (buffers, filename))
+			{
+				error (FATAL, "no buffer of \"%s\"", filename);
+				goto next;
+			}
+			printResponse (makeCompletedResponse ("close-buffer", id));
+		}
+		else if (!strcmp ("cancel", json_string_value (command)))
+		{
+			/* The request to cancel, if it was still parsed, is
+			   already answered. */
+			printResponse (makeCompletedResponse ("cancel", id));
+		}
+		else if (!strcmp ("watch", json_string_value (command)))
+		{
+			const char *path;
+
+			if (json_unpack (request, "{ss}", "path", &path) == -1)
+			{
+				error (FATAL, "invalid watch request");
+				goto next;
+			}
+			if (iargs->sandbox)
+			{
+				error (FATAL,
+					   "invalid request in sandbox submode: watching files is limited");
+				goto next;
+			}
+			/* The tags of the index are sent as lines. */
+			if (getTagWriterType () == WRITER_PROTOBUF)
+			{
+				error (FATAL, "invalid watch request: files cannot be watched in the output format");
 				goto next;
 			}
 
-			json_unpack (request, "{sI}", "size", &size);
+			if (index == NULL)
+				index = tagIndexNew (addEntryToIndex);
+			addEntryToIndex (index, path);
+			json_t *response = makeCompletedResponse ("watch", id);
+			json_object_set_new (response, "files",
+								 json_integer (tagIndexCountFiles (index)));
+			printResponse (response);
+		}
+		else if (!strcmp ("find-tags", json_string_value (command)))
+		{
+			const char *name;
+			unsigned long count = 0;
 
-			openTagFile ();
-			if (size == -1)
-			{					/* read from disk */
-				if (iargs->sandbox) {
-					error (FATAL,
-						   "invalid request in sandbox submode: reading file contents from a file is limited");
-					goto next;
-				}
+			if (json_unpack (request, "{ss}", "name", &name) == -1)
+			{
+				error (FATAL, "invalid find-tags request");
+				goto next;
+			}
+
+			if (index)
+				count = tagIndexFind (index, name, printTagLine, NULL);
+			json_t *response = makeCompletedResponse ("find-tags", id);
+			json_object_set_new (response, "count", json_integer (count));
+			printResponse (response);
+		}
+		else if (!strcmp ("write-tags", json_string_value (command)))
+		{
+			const char *filename;
+			MIO *mio;
 
-				createTagsForEntry (filename);
+			if (json_unpack (request, "{ss}", "filename", &filename) == -1)
+			{
+				error (FATAL, "invalid write-tags request");
+				goto next;
 			}
-			else
-			{					/* read nbytes from stream */
-				unsigned char *data = eMalloc (size);
-				size = fread (data, 1, size, stdin);
-				MIO *mio = mio_new_memory (data, size, eRealloc, eFree);
-				parseFileWithMio (filename, mio);
-				mio_free (mio);
+			if (iargs->sandbox)
+			{
+				error (FATAL,
+					   "invalid request in sandbox submode: writing a file is limited");
+				goto next;
 			}
 
-			closeTagFile (false);
-			fputs ("{\"_type\": \"completed\", \"command\": \"generate-tags\"}\n", stdout);
-			fflush(stdout);
+			mio = mio_new_file (filename, "w");
+			if (mio == NULL)
+			{
+				error (FATAL | PERROR, "cannot open \"%s\"", filename);
+				goto next;
+			}
+			if (index)
+				tagIndexWrite (index, mio);
+			mio_free (mio);
+			printResponse (makeCompletedResponse ("write-tags", id));
 		}
 		else
 		{
@@ -575,8 +3252,23 @@ void interactiveLoop (cookedArgs *args CTAGS_ATTR_UNUSED, void *user)
 		}
 
 	next:
+		finiRequestTrashBox ();
+		setErrorPrinter (jsonErrorPrinter, NULL);
 		json_decref (request);
 	}
+
+	vStringDelete (buffer);
+	if (Requests.buffer)
+		eFree (Requests.buffer);
+#ifdef HAVE_WORKING_FORK
+	if (Scheduler.workers)
+		finishInteractiveWorkers (iargs->sandbox);
+#endif
+
+	if (index)
+		tagIndexDelete (index);
+	if (buffers)
+		tagBufferSetDelete (buffers);
 }
 #endif
 
@@ -680,6 +3372,9 @@ extern int main (int argc CTAGS_ATTR_UNUSED, char **argv)
 	}
 	END_VERBOSE();
 
+	if (Option.profileRegex != REGEX_PROFILE_NONE)
+		printRegexProfile (Option.profileRegex == REGEX_PROFILE_JSON, stderr);
+
 	/*  Clean up.
 	 */
 	cArgDelete (args);
@@ -687,6 +3382,8 @@ extern int main (int argc CTAGS_ATTR_UNUSED, char **argv)
 	freeRoutineResources ();
 	freeInputFileResources ();
 	freeTagFileResources ();
+	freeDuplicateInputs ();
+	closeRemoteTagCache ();
 	freeOptionResources ();
 	freeParserResources ();
 	freeRegexResources ();
@@ -695,6 +3392,7 @@ extern int main (int argc CTAGS_ATTR_UNUSED, char **argv)
 #endif
 
 	finiDefaultTrashBox();
+	freeVStringResources ();
 
 	if (Option.printLanguage)
 		return (Option.printLanguage == true)? 0: 1;
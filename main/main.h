@@ -16,10 +16,42 @@
 
 #include <stdio.h>
 
+#include "types.h"
+
+/*
+*   DATA DECLARATIONS
+*/
+
+/* The phases timed with --totals=extra. The time of a phase doesn't
+   include the time of the phases run in it. */
+typedef enum eTotalsPhase {
+	PHASE_GUESSING,		/* choosing the parser of an input file */
+	PHASE_READING,		/* opening and loading an input file */
+	PHASE_PARSING,
+	PHASE_REGEX,		/* running regex patterns */
+	PHASE_WRITING,		/* writing tags, also out of the cork queue */
+	PHASE_CLOSING,		/* sorting and closing the tag file */
+	COUNT_PHASES
+} totalsPhase;
+
 /*
 *   FUNCTION PROTOTYPES
 */
 extern void addTotals (const unsigned int files, const long unsigned int lines, const long unsigned int bytes);
+extern void getTotals (long *files, long *lines, long *bytes);
+extern void addRescan (void);
+extern void beginTotalsPhase (totalsPhase phase);
+extern void endTotalsPhase (void);
+extern void addLanguageTotals (const langType language,
+							   const long unsigned int lines, const long unsigned int bytes,
+							   const long unsigned int tags,
+							   double seconds, double cpuSeconds);
+extern void addKindTotals (const tagEntryInfo *const tag, size_t bytes, double seconds);
+extern void addFieldTotals (int field, size_t bytes, double seconds);
+extern double getTotalsClock (void);
+extern double getTotalsCpuClock (void);
+extern void addSlowFile (const char *const fileName, const langType language,
+						 long size, double seconds);
 extern bool isDestinationStdout (void);
 extern int main (int argc, char **argv);
 
@@ -23,12 +23,88 @@
 #include <string.h>
 #include <iconv.h>
 #include <errno.h>
+#include <limits.h>
 #include "options.h"
 #include "mbcs.h"
 #include "routines.h"
 
 static iconv_t iconv_fd = (iconv_t) -1;
 
+/* The descriptor is kept open from one input file to the next one, as
+ * long as the encodings do not change. */
+static bool converting;
+static char *openedInputEncoding;
+static char *openedOutputEncoding;
+
+/* The ASCII characters the conversion leaves as they are: a string made
+ * only of them needs not be converted at all. Shift_JIS, for example,
+ * turns '\\' into a yen sign. */
+static bool transparentChars [0x80];
+
+/* Reused for the result of each conversion */
+static char *convertBuffer;
+static size_t convertBufferSize;
+
+static void prepareConvertBuffer (size_t size)
+{
+	if (size > convertBufferSize)
+	{
+		convertBufferSize = size;
+		convertBuffer = xRealloc (convertBuffer, convertBufferSize, char);
+	}
+}
+
+static bool isTransparent (const char *s, size_t length)
+{
+	size_t i;
+
+	for (i = 0; i < length; i++)
+	{
+		const unsigned char c = (unsigned char) s [i];
+		if (c >= 0x80 || !transparentChars [c])
+			return false;
+	}
+	return true;
+}
+
+static void findTransparentChars (void)
+{
+	unsigned int c;
+
+	prepareConvertBuffer (MB_LEN_MAX);
+	for (c = 0; c < 0x80; c++)
+	{
+		char in = (char) c;
+		char *src = &in, *dest = convertBuffer;
+		size_t src_len = 1, dest_len = MB_LEN_MAX;
+
+		transparentChars [c] = (c != '\0'
+								&& iconv (iconv_fd, &src, &src_len, &dest, &dest_len) != (size_t) -1
+								&& dest == convertBuffer + 1
+								&& convertBuffer [0] == in);
+		iconv (iconv_fd, NULL, NULL, NULL, NULL);
+	}
+}
+
+static void freeConverter (void)
+{
+	if (iconv_fd != (iconv_t) -1)
+	{
+		iconv_close(iconv_fd);
+		iconv_fd = (iconv_t) -1;
+	}
+	if (openedInputEncoding)
+	{
+		eFree (openedInputEncoding);
+		openedInputEncoding = NULL;
+	}
+	if (openedOutputEncoding)
+	{
+		eFree (openedOutputEncoding);
+		openedOutputEncoding = NULL;
+	}
+}
+
 extern bool openConverter (char* inputEncoding, char* outputEncoding)
 {
 	if (!inputEncoding || !outputEncoding)
@@ -42,6 +118,17 @@ extern bool openConverter (char* inputEncoding, char* outputEncoding)
 		}
 		return false;
 	}
+
+	if (iconv_fd != (iconv_t) -1
+		&& strcmp (inputEncoding, openedInputEncoding) == 0
+		&& strcmp (outputEncoding, openedOutputEncoding) == 0)
+	{
+		iconv (iconv_fd, NULL, NULL, NULL, NULL);
+		converting = true;
+		return true;
+	}
+
+	freeConverter ();
 	iconv_fd = iconv_open(outputEncoding, inputEncoding);
 	if (iconv_fd == (iconv_t) -1)
 	{
@@ -49,27 +136,33 @@ extern bool openConverter (char* inputEncoding, char* outputEncoding)
 					"failed opening encoding from '%s' to '%s'", inputEncoding, outputEncoding);
 		return false;
 	}
+	openedInputEncoding = eStrdup (inputEncoding);
+	openedOutputEncoding = eStrdup (outputEncoding);
+	findTransparentChars ();
+	converting = true;
 	return true;
 }
 
 extern bool isConverting ()
 {
-	return iconv_fd != (iconv_t) -1;
+	return converting;
 }
 
 extern bool convertString (vString *const string)
 {
 	size_t dest_len, src_len;
-	char *dest, *dest_ptr, *src;
-	if (iconv_fd == (iconv_t) -1)
+	char *dest_ptr, *src;
+	if (!converting)
 		return false;
 	src_len = vStringLength (string);
+	src = vStringValue (string);
+	if (isTransparent (src, src_len))
+		return true;
+
 	/* Should be longest length of bytes. so maybe utf8. */
 	dest_len = src_len * 4;
-	dest_ptr = dest = xCalloc (dest_len, char);
-	if (!dest)
-		return false;
-	src = vStringValue (string);
+	prepareConvertBuffer (dest_len + 1);
+	dest_ptr = convertBuffer;
 retry:
 	if (iconv (iconv_fd, &src, &src_len, &dest_ptr, &dest_len) == (size_t) -1)
 	{
@@ -82,18 +175,14 @@ retry:
 			verbose ("  Encoding: %s\n", strerror(errno));
 			goto retry;
 		}
-		eFree (dest);
+		iconv (iconv_fd, NULL, NULL, NULL, NULL);
 		return false;
 	}
 
-	dest_len = dest_ptr - dest;
+	dest_len = dest_ptr - convertBuffer;
 
 	vStringClear (string);
-	if (vStringSize (string) < dest_len + 1)
-		vStringResize (string, dest_len + 1);
-	memcpy (vStringValue (string), dest, dest_len + 1);
-	vStringLength (string) = dest_len;
-	eFree (dest);
+	vStringNCatSUnsafe (string, convertBuffer, dest_len);
 
 	iconv (iconv_fd, NULL, NULL, NULL, NULL);
 
@@ -102,10 +191,17 @@ retry:
 
 extern void closeConverter ()
 {
-	if (iconv_fd != (iconv_t) -1)
+	converting = false;
+}
+
+extern void freeConverterResources (void)
+{
+	freeConverter ();
+	if (convertBuffer)
 	{
-		iconv_close(iconv_fd);
-		iconv_fd = (iconv_t) -1;
+		eFree (convertBuffer);
+		convertBuffer = NULL;
+		convertBufferSize = 0;
 	}
 }
 
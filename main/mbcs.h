@@ -18,5 +18,6 @@ extern bool isConverting (void);
 extern bool openConverter (char*, char*);
 extern bool convertString (vString *const);
 extern void closeConverter (void);
+extern void freeConverterResources (void);
 
 #endif /* HAVE_ICONV */
@@ -0,0 +1,464 @@
+/*
+*   Copyright (c) 2026, Universal Ctags Team
+*
+*   This source code is released for free distribution under the terms of the
+*   GNU General Public License version 2 or (at your option) any later version.
+*
+*   This module contains the benchmarks of the core primitives run with
+*   --_bench-primitives: vString, the hash table, MIO reading from memory
+*   and from a file, keyword lookup and readLineRaw. Each one is run with
+*   as many operations as fill MIN_BENCH_SECONDS, and the best of
+*   BENCH_ROUNDS rounds is reported in nanoseconds per operation, so
+*   that a change to one of them can be measured rather than guessed.
+*/
+
+/*
+*   INCLUDE FILES
+*/
+#include "general.h"  /* must always come first */
+
+#include <stdio.h>
+#include <string.h>
+
+#include "debug.h"
+#include "htable.h"
+#include "keyword.h"
+#include "main.h"
+#include "microbench.h"
+#include "mio.h"
+#include "options.h"
+#include "parse.h"
+#include "read.h"
+#include "routines.h"
+#include "vstring.h"
+
+/*
+*   MACROS
+*/
+#define MIN_BENCH_SECONDS 0.025
+#define BENCH_ROUNDS 3
+
+#define INPUT_SIZE (64 * 1024)
+#define HASH_KEY_COUNT 1024
+
+/*
+*   DATA DECLARATIONS
+*/
+typedef struct sMicroBench {
+	const char *name;
+	const char *unit;		/* what an operation is */
+	bool (* prepare) (void);	/* false to skip the benchmark */
+	void (* run) (unsigned long operations);
+	void (* finish) (void);
+} microBench;
+
+/*
+*   DATA DEFINITIONS
+*/
+
+/* Read by the benchmarks so that the compiler keeps what they compute. */
+static volatile unsigned long BenchSink;
+
+static vString *BenchString;
+
+static hashTable *BenchTable;
+static char *BenchKeys [HASH_KEY_COUNT * 2];	/* the second half is not in the table */
+
+static unsigned char *BenchInput;	/* lines of C like code */
+static MIO *BenchMio;
+static char *BenchFileName;
+
+static langType BenchLanguage;
+static const char *const BenchWords [] = {
+	/* keywords of C++ */
+	"int", "struct", "return", "const", "static", "unsigned", "if", "while",
+	"template", "namespace",
+	/* and identifiers, which are looked up as often */
+	"value", "vStringPut", "i", "buffer", "CTAGS_MAIN_H", "operator_",
+	"length", "x", "makeTagEntry", "result",
+};
+
+/*
+*   FUNCTION DEFINITIONS
+*/
+
+/* vString */
+
+static bool prepareString (void)
+{
+	BenchString = vStringNew ();
+	return true;
+}
+
+static void finishString (void)
+{
+	vStringDelete (BenchString);
+	BenchString = NULL;
+}
+
+static void runStringPut (unsigned long operations)
+{
+	unsigned long i;
+
+	for (i = 0; i < operations; i++)
+	{
+		if ((i & 63) == 0)
+			vStringClear (BenchString);
+		vStringPut (BenchString, 'a' + (int) (i & 15));
+	}
+	BenchSink = vStringLength (BenchString);
+}
+
+static void runStringCatS (unsigned long operations)
+{
+	unsigned long i;
+
+	for (i = 0; i < operations; i++)
+	{
+		if ((i & 7) == 0)
+			vStringClear (BenchString);
+		vStringCatS (BenchString, "identifier");
+	}
+	BenchSink = vStringLength (BenchString);
+}
+
+static void runStringNewDelete (unsigned long operations)
+{
+	unsigned long i;
+
+	for (i = 0; i < operations; i++)
+	{
+		vString *s = vStringNewInit ("identifier");
+		BenchSink = vStringLength (s);
+		vStringDelete (s);
+	}
+}
+
+/* A path and a signature with nothing to escape, and a pattern with
+   a backslash, like the values of the fields of most tags */
+static void runStringEscape (unsigned long operations)
+{
+	static const char *const values [] = {
+		"main/parse.c",
+		"(const char * const fileName,vString * b)",
+		"/^#define CTAGS_MAIN_H \\$/",
+	};
+	unsigned long i;
+
+	for (i = 0; i < operations; i++)
+	{
+		vStringClear (BenchString);
+		vStringCatSWithEscaping (BenchString, values [i % ARRAY_SIZE (values)]);
+	}
+	BenchSink = vStringLength (BenchString);
+}
+
+/* hashTable */
+
+static bool prepareTable (void)
+{
+	unsigned int i;
+	char key [32];
+
+	BenchTable = hashTableNew (HASH_KEY_COUNT / 4, hashCstrhash, hashCstreq,
+							   NULL, NULL);
+	for (i = 0; i < HASH_KEY_COUNT * 2; i++)
+	{
+		snprintf (key, sizeof key, "%s_%u", (i & 1)? "field": "func", i);
+		BenchKeys [i] = eStrdup (key);
+		if (i < HASH_KEY_COUNT)
+			hashTablePutItem (BenchTable, BenchKeys [i], BenchKeys [i]);
+	}
+	return true;
+}
+
+static void finishTable (void)
+{
+	unsigned int i;
+
+	hashTableDelete (BenchTable);
+	BenchTable = NULL;
+	for (i = 0; i < HASH_KEY_COUNT * 2; i++)
+	{
+		eFree (BenchKeys [i]);
+		BenchKeys [i] = NULL;
+	}
+}
+
+/* Half hits and half misses */
+static void runTableGet (unsigned long operations)
+{
+	unsigned long i;
+	unsigned long found = 0;
+
+	for (i = 0; i < operations; i++)
+		if (hashTableGetItem (BenchTable, BenchKeys [(i * 7) % (HASH_KEY_COUNT * 2)]))
+			found++;
+	BenchSink = found;
+}
+
+static void runTablePutDelete (unsigned long operations)
+{
+	unsigned long i;
+
+	for (i = 0; i < operations; i++)
+	{
+		char *key = BenchKeys [HASH_KEY_COUNT + (i % HASH_KEY_COUNT)];
+
+		hashTablePutItem (BenchTable, key, key);
+		hashTableDeleteItem (BenchTable, key);
+	}
+	BenchSink = hashTableCountItem (BenchTable);
+}
+
+/* MIO and readLineRaw */
+
+static void makeInput (void)
+{
+	static const char *const lines [] = {
+		"static int countTags (const tagEntryInfo *const tag, void *data)\n",
+		"{\n",
+		"\tunsigned int *count = data;\n",
+		"\n",
+		"\tif (tag->kindIndex == KIND_GHOST_INDEX)\n",
+		"\t\treturn 0;\t/* not counted */\n",
+		"\t(*count)++;\n",
+		"\treturn 1;\n",
+		"}\n",
+	};
+	size_t length = 0;
+	unsigned int i = 0;
+
+	BenchInput = xMalloc (INPUT_SIZE, unsigned char);
+	while (true)
+	{
+		const size_t n = strlen (lines [i]);
+
+		if (length + n > INPUT_SIZE)
+		{
+			memset (BenchInput + length, '\n', INPUT_SIZE - length);
+			break;
+		}
+		memcpy (BenchInput + length, lines [i], n);
+		length += n;
+		i = (i + 1) % ARRAY_SIZE (lines);
+	}
+}
+
+static bool prepareMemoryMio (void)
+{
+	makeInput ();
+	BenchMio = mio_new_memory (BenchInput, INPUT_SIZE, NULL, NULL);
+	BenchString = vStringNew ();
+	return true;
+}
+
+static bool prepareFileMio (void)
+{
+	makeInput ();
+	BenchMio = tempFile ("w+b", &BenchFileName);
+	if (mio_write (BenchMio, BenchInput, 1, INPUT_SIZE) != INPUT_SIZE)
+		error (FATAL | PERROR, "cannot write to temporary file");
+	mio_rewind (BenchMio);
+	BenchString = vStringNew ();
+	return true;
+}
+
+static void finishMio (void)
+{
+	mio_free (BenchMio);
+	BenchMio = NULL;
+	if (BenchFileName)
+	{
+		remove (BenchFileName);
+		eFree (BenchFileName);
+		BenchFileName = NULL;
+	}
+	eFree (BenchInput);
+	BenchInput = NULL;
+	vStringDelete (BenchString);
+	BenchString = NULL;
+}
+
+static void runMioGetc (unsigned long operations)
+{
+	unsigned long i;
+	unsigned long sum = 0;
+
+	for (i = 0; i < operations; i++)
+	{
+		int c = mio_getc (BenchMio);
+
+		if (c == EOF)
+		{
+			mio_rewind (BenchMio);
+			c = mio_getc (BenchMio);
+		}
+		sum += c;
+	}
+	BenchSink = sum;
+}
+
+static void runMioGets (unsigned long operations)
+{
+	unsigned long i;
+	unsigned long sum = 0;
+	char line [256];
+
+	for (i = 0; i < operations; i++)
+	{
+		if (mio_gets (BenchMio, line, sizeof line) == NULL)
+		{
+			mio_rewind (BenchMio);
+			mio_gets (BenchMio, line, sizeof line);
+		}
+		sum += (unsigned char) line [0];
+	}
+	BenchSink = sum;
+}
+
+static void runReadLine (unsigned long operations)
+{
+	unsigned long i;
+	unsigned long sum = 0;
+
+	for (i = 0; i < operations; i++)
+	{
+		if (readLineRaw (BenchString, BenchMio) == NULL)
+		{
+			mio_rewind (BenchMio);
+			readLineRaw (BenchString, BenchMio);
+		}
+		sum += vStringLength (BenchString);
+	}
+	BenchSink = sum;
+}
+
+/* keyword */
+
+static bool prepareKeyword (void)
+{
+	BenchLanguage = getNamedLanguage ("C++", 0);
+	if (BenchLanguage == LANG_IGNORE)
+		return false;
+	initializeParser (BenchLanguage);
+	return true;
+}
+
+static void runKeywordLookup (unsigned long operations)
+{
+	unsigned long i;
+	unsigned long keywords = 0;
+
+	for (i = 0; i < operations; i++)
+		if (lookupKeyword (BenchWords [i % ARRAY_SIZE (BenchWords)],
+						   BenchLanguage) != KEYWORD_NONE)
+			keywords++;
+	BenchSink = keywords;
+}
+
+static microBench MicroBenches [] = {
+	{ "vstring.put",        "char",   prepareString,    runStringPut,       finishString },
+	{ "vstring.cats",       "string", prepareString,    runStringCatS,      finishString },
+	{ "vstring.new-delete", "string", NULL,             runStringNewDelete, NULL },
+	{ "vstring.escape",     "string", prepareString,    runStringEscape,    finishString },
+	{ "htable.get",         "lookup", prepareTable,     runTableGet,        finishTable },
+	{ "htable.put-delete",  "key",    prepareTable,     runTablePutDelete,  finishTable },
+	{ "mio.getc.memory",    "char",   prepareMemoryMio, runMioGetc,         finishMio },
+	{ "mio.getc.file",      "char",   prepareFileMio,   runMioGetc,         finishMio },
+	{ "mio.gets.memory",    "line",   prepareMemoryMio, runMioGets,         finishMio },
+	{ "mio.gets.file",      "line",   prepareFileMio,   runMioGets,         finishMio },
+	{ "keyword.lookup",     "word",   prepareKeyword,   runKeywordLookup,   NULL },
+	{ "readline.memory",    "line",   prepareMemoryMio, runReadLine,        finishMio },
+	{ "readline.file",      "line",   prepareFileMio,   runReadLine,        finishMio },
+};
+
+static bool isSelected (const char *name, const char *names)
+{
+	const char *p = names;
+
+	if (names == NULL || names [0] == '\0')
+		return true;
+
+	while (*p)
+	{
+		const char *end = strchr (p, ',');
+		const size_t length = end? (size_t) (end - p): strlen (p);
+
+		if (length > 0 && strncmp (name, p, length) == 0
+			&& (name [length] == '\0' || name [length] == '.'))
+			return true;
+		if (end == NULL)
+			break;
+		p = end + 1;
+	}
+	return false;
+}
+
+/* The nanoseconds an operation of BENCH takes; the operations of a round
+   are doubled until the round lasts MIN_BENCH_SECONDS. */
+static double measure (const microBench *bench, unsigned long *operations)
+{
+	unsigned long n = 1;
+	double best = 0.0;
+	double seconds;
+	int round;
+
+	while (true)
+	{
+		const double start = getTotalsClock ();
+		bench->run (n);
+		seconds = getTotalsClock () - start;
+		if (seconds >= MIN_BENCH_SECONDS || n >= (1UL << 30))
+			break;
+		n *= 2;
+	}
+	best = seconds;
+
+	for (round = 1; round < BENCH_ROUNDS; round++)
+	{
+		const double start = getTotalsClock ();
+		bench->run (n);
+		seconds = getTotalsClock () - start;
+		if (seconds < best)
+			best = seconds;
+	}
+
+	*operations = n;
+	return best * 1e9 / n;
+}
+
+extern void runMicroBenchmarks (const char *names, FILE *fp)
+{
+	unsigned int i;
+	unsigned int count = 0;
+
+	for (i = 0; i < ARRAY_SIZE (MicroBenches); i++)
+		if (isSelected (MicroBenches [i].name, names))
+			count++;
+	if (count == 0)
+		error (FATAL, "No benchmark named \"%s\"", names);
+
+	fprintf (fp, "%-20s %12s %-8s %12s\n", "#BENCHMARK", "NS/OP", "OP", "OPERATIONS");
+	for (i = 0; i < ARRAY_SIZE (MicroBenches); i++)
+	{
+		const microBench *bench = MicroBenches + i;
+		unsigned long operations;
+		double ns;
+
+		if (! isSelected (bench->name, names))
+			continue;
+		if (bench->prepare && ! bench->prepare ())
+		{
+			verbose ("skipping %s\n", bench->name);
+			continue;
+		}
+		ns = measure (bench, &operations);
+		if (bench->finish)
+			bench->finish ();
+
+		fprintf (fp, "%-20s %12.2f %-8s %12lu\n", bench->name, ns,
+				 bench->unit, operations);
+		fflush (fp);
+	}
+}
@@ -0,0 +1,28 @@
+/*
+*   Copyright (c) 2026, Universal Ctags Team
+*
+*   This source code is released for free distribution under the terms of the
+*   GNU General Public License version 2 or (at your option) any later version.
+*
+*   External interface to microbench.c
+*/
+#ifndef CTAGS_MAIN_MICROBENCH_H
+#define CTAGS_MAIN_MICROBENCH_H
+
+/*
+*   INCLUDE FILES
+*/
+#include "general.h"  /* must always come first */
+
+#include <stdio.h>
+
+/*
+*   FUNCTION PROTOTYPES
+*/
+
+/* Run the benchmarks of the core primitives whose names start with one
+   of the comma separated NAMES (all of them if NAMES is NULL or empty),
+   and print the time an operation takes to FP (--_bench-primitives). */
+extern void runMicroBenchmarks (const char *names, FILE *fp);
+
+#endif	/* CTAGS_MAIN_MICROBENCH_H */
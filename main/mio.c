@@ -43,6 +43,24 @@
 #include <stdlib.h>
 #include <limits.h>
 
+#if defined (HAVE_MMAP) && defined (HAVE_SYS_MMAN_H)
+# define MIO_USE_MMAP
+# include <sys/types.h>
+# include <sys/stat.h>
+# include <sys/mman.h>
+# include <fcntl.h>
+# include <unistd.h>
+#elif defined (_WIN32)
+# define MIO_USE_WIN32_MAPPING
+# ifndef WIN32_LEAN_AND_MEAN
+#  define WIN32_LEAN_AND_MEAN
+# endif
+# include <windows.h>
+# include <io.h>  /* to declare _close () */
+#elif defined (HAVE_UNISTD_H)
+# include <unistd.h>  /* to declare close () */
+#endif
+
 #ifdef QUALIFIER
 #define xMalloc(n,Type)    (Type *)eMalloc((size_t)(n) * sizeof (Type))
 #define xCalloc(n,Type)    (Type *)eCalloc((size_t)(n), sizeof (Type))
@@ -154,6 +172,7 @@ struct _MIO {
 		struct {
 			FILE *fp;
 			MIOFCloseFunc close_func;
+			char *buffer;	/* given to setvbuf() by mio_set_buffer() */
 		} file;
 		struct {
 			unsigned char *buf;
@@ -163,6 +182,10 @@ struct _MIO {
 			size_t allocated_size;
 			MIOReallocFunc realloc_func;
 			MIODestroyNotify free_func;
+			bool mapped;	/* buf is mmap()ed (or mapped with MapViewOfFile()),
+							   and must be unmapped */
+			size_t map_offset;	/* from the start of the mapping to buf */
+			MIO *base;	/* stream buf is borrowed from, see mio_new_mio() */
 			bool error;
 			bool eof;
 		} mem;
@@ -170,6 +193,39 @@ struct _MIO {
 	MIOUserData udata;
 };
 
+/* fseek() and ftell() take a long, 32 bit wide on Windows: the 64 bit
+ * variants are used where they exist. */
+static int file_seek (FILE *fp, MIOOffset offset, int whence)
+{
+#if defined (_WIN32)
+	return _fseeki64 (fp, offset, whence);
+#elif defined (HAVE_FSEEKO)
+	return fseeko (fp, (off_t) offset, whence);
+#else
+	if (offset > LONG_MAX || offset < LONG_MIN)
+	{
+#ifdef EOVERFLOW
+		errno = EOVERFLOW;
+#else
+		errno = EINVAL;
+#endif
+		return -1;
+	}
+	return fseek (fp, (long) offset, whence);
+#endif
+}
+
+static MIOOffset file_tell (FILE *fp)
+{
+#if defined (_WIN32)
+	return _ftelli64 (fp);
+#elif defined (HAVE_FSEEKO)
+	return ftello (fp);
+#else
+	return ftell (fp);
+#endif
+}
+
 
 /**
  * mio_new_file_full:
@@ -221,6 +277,7 @@ MIO *mio_new_file_full (const char *filename,
 			mio->type = MIO_TYPE_FILE;
 			mio->impl.file.fp = fp;
 			mio->impl.file.close_func = close_func;
+			mio->impl.file.buffer = NULL;
 			mio->refcount = 1;
 			mio->udata.d = NULL;
 			mio->udata.f = NULL;
@@ -282,6 +339,7 @@ MIO *mio_new_fp (FILE *fp, MIOFCloseFunc close_func)
 		mio->type = MIO_TYPE_FILE;
 		mio->impl.file.fp = fp;
 		mio->impl.file.close_func = close_func;
+		mio->impl.file.buffer = NULL;
 		mio->refcount = 1;
 		mio->udata.d = NULL;
 		mio->udata.f = NULL;
@@ -344,6 +402,9 @@ MIO *mio_new_memory (unsigned char *data,
 		mio->impl.mem.allocated_size = size;
 		mio->impl.mem.realloc_func = realloc_func;
 		mio->impl.mem.free_func = free_func;
+		mio->impl.mem.mapped = false;
+		mio->impl.mem.map_offset = 0;
+		mio->impl.mem.base = NULL;
 		mio->impl.mem.eof = false;
 		mio->impl.mem.error = false;
 		mio->refcount = 1;
@@ -368,16 +429,20 @@ MIO *mio_new_memory (unsigned char *data,
  * If @size(!= 0) is larger than the length from @start to the end of
  * @base, %NULL is return.
  *
+ * If @base is a memory stream, the data is not copied: the new mio
+ * reads the memory of @base, and holds a reference to @base until it is
+ * freed. It must not be written then.
+ *
  * The function doesn't move the file position of @base.
  *
  * Free-function: mio_free()
  *
  */
 
-MIO *mio_new_mio (MIO *base, long start, size_t size)
+MIO *mio_new_mio (MIO *base, MIOOffset start, size_t size)
 {
 	unsigned char *data;
-	long original_pos;
+	MIOOffset original_pos;
 	MIO *submio;
 	size_t r;
 
@@ -385,18 +450,30 @@ MIO *mio_new_mio (MIO *base, long start, size_t size)
 
 	if (size == 0)
 	{
-		long end;
+		MIOOffset end;
 
 		if (mio_seek (base, 0, SEEK_END) != 0)
 			return NULL;
 		end = mio_tell (base);
 		Assert (end >= start);
-		size = end - start;
+		size = (size_t) (end - start);
 	}
 
 	if (mio_seek (base, start, SEEK_SET) != 0)
 		return NULL;
 
+	if (base->type == MIO_TYPE_MEMORY)
+	{
+		mio_seek (base, original_pos, SEEK_SET);
+		if (size > base->impl.mem.size - (size_t) start)
+			return NULL;
+
+		submio = mio_new_memory (base->impl.mem.buf + start, size, NULL, NULL);
+		if (submio)
+			submio->impl.mem.base = mio_ref (base);
+		return submio;
+	}
+
 	data = xMalloc (size, unsigned char);
 	r= mio_read (base, data, 1, size);
 	mio_seek (base, original_pos, SEEK_SET);
@@ -415,6 +492,332 @@ cleanup:
 	return NULL;
 }
 
+/*
+ * read_file_range:
+ * @filename: Filename to read
+ * @offset: Where the range starts in the file
+ * @length: Length of the range, or (size_t) -1 for the rest of the file
+ *
+ * Reads a range of the content of @filename into a new in-memory #MIO
+ * object. Unlike mmap(), this works with pipes and special files, whose
+ * size cannot be known in advance, as long as @offset is 0.
+ *
+ * Returns: A new #MIO on success, or %NULL on failure.
+ */
+static MIO *read_file_range (const char *filename, MIOOffset offset, size_t length)
+{
+	FILE *fp;
+	unsigned char *data = NULL;
+	size_t allocated = 0;
+	size_t size = 0;
+	MIO *mio;
+
+	fp = fopen (filename, "rb");
+	if (! fp)
+		return NULL;
+	if (offset > 0 && file_seek (fp, offset, SEEK_SET) != 0)
+	{
+		fclose (fp);
+		return NULL;
+	}
+
+	while (size < length)
+	{
+		size_t r;
+
+		if (size == allocated)
+		{
+			allocated = allocated? allocated * 2: 64 * 1024;
+			if (allocated > length)
+				allocated = length;
+			data = eRealloc (data, allocated);
+		}
+		r = fread (data + size, 1, allocated - size, fp);
+		size += r;
+		if (r == 0)
+			break;
+	}
+	if (length != (size_t) -1 && size < length)
+	{
+		fclose (fp);
+		eFree (data);
+		return NULL;
+	}
+
+	if (ferror (fp))
+	{
+		fclose (fp);
+		eFree (data);
+		return NULL;
+	}
+	fclose (fp);
+
+	mio = mio_new_memory (data, size, eRealloc, eFree);
+	if (! mio)
+		eFree (data);
+	return mio;
+}
+
+#ifdef MIO_USE_MMAP
+/*
+ * map_file_range:
+ * @fd: File descriptor of a regular file, open for reading
+ * @offset: Where the range starts in the file
+ * @length: Length of the range, not 0
+ *
+ * Maps a range of a file into a new in-memory #MIO object. mmap() wants
+ * an offset aligned on pages, so the mapping may start before @offset.
+ *
+ * Returns: A new #MIO on success, or %NULL on failure.
+ */
+static MIO *map_file_range (int fd, MIOOffset offset, size_t length)
+{
+	const long page = sysconf (_SC_PAGESIZE);
+	const size_t skip = page > 0? (size_t) (offset % page): 0;
+	unsigned char *data;
+	MIO *mio;
+
+	/* Private and writable so that a stray write only touches the copy */
+	data = mmap (NULL, length + skip, PROT_READ | PROT_WRITE,
+				 MAP_PRIVATE, fd, (off_t) (offset - skip));
+	if (data == MAP_FAILED)
+		return NULL;
+#ifdef HAVE_MADVISE
+	madvise (data, length + skip, MADV_SEQUENTIAL);
+#endif
+
+	mio = mio_new_memory (data + skip, length, NULL, NULL);
+	if (! mio)
+	{
+		munmap (data, length + skip);
+		return NULL;
+	}
+	mio->impl.mem.mapped = true;
+	mio->impl.mem.map_offset = skip;
+	return mio;
+}
+#endif
+
+/**
+ * mio_new_mapped_file:
+ * @filename: Filename to open
+ *
+ * Creates a new in-memory #MIO object holding the content of @filename.
+ * A regular file is mapped with mmap(), or MapViewOfFile() on Windows,
+ * so that its content is not copied; other files (pipes, special files,
+ * or files on platforms without either) are read entirely into memory.
+ *
+ * The stream is meant for reading: it cannot be grown, and writing to it
+ * does not change the file.
+ *
+ * Free-function: mio_free()
+ *
+ * Returns: A new #MIO on success, or %NULL on failure.
+ */
+MIO *mio_new_mapped_file (const char *filename)
+{
+	return mio_new_mapped_range (filename, 0, (size_t) -1);
+}
+
+/**
+ * mio_new_mapped_range:
+ * @filename: Filename to open
+ * @offset: Where the range starts in the file
+ * @length: Length of the range, or (size_t) -1 for the rest of the file
+ *
+ * Like mio_new_mapped_file(), but only for a range of the content of
+ * @filename. This lets a process hand a buffer over to another one
+ * through a shared memory segment, or a memfd opened by its /proc path,
+ * without copying it through a pipe.
+ *
+ * A range going past the end of the file is an error.
+ *
+ * Free-function: mio_free()
+ *
+ * Returns: A new #MIO on success, or %NULL on failure.
+ */
+#ifdef MIO_USE_MMAP
+/* Map the range of @filename opened as @fd, which is closed. */
+static MIO *map_fd_range (int fd, const char *filename, MIOOffset offset, size_t length)
+{
+	struct stat st;
+	MIO *mio;
+
+	/* Some special files (e.g. under /proc) are regular, but report 0
+	   as their size. */
+	if (fstat (fd, &st) != 0 || ! S_ISREG (st.st_mode)
+		|| (st.st_size == 0 && length == (size_t) -1)
+		|| (unsigned long long) st.st_size > (size_t) -1)
+	{
+		close (fd);
+		return read_file_range (filename, offset, length);
+	}
+
+	if (offset > st.st_size
+		|| (length != (size_t) -1
+			&& length > (size_t) (st.st_size - offset)))
+	{
+		close (fd);
+		errno = EINVAL;
+		return NULL;
+	}
+	if (length == (size_t) -1)
+		length = (size_t) (st.st_size - offset);
+	if (length == 0)
+	{
+		close (fd);
+		return read_file_range (filename, offset, 0);
+	}
+
+	mio = map_file_range (fd, offset, length);
+	close (fd);
+	if (! mio)
+		return read_file_range (filename, offset, length);
+	return mio;
+}
+#endif
+
+#ifdef MIO_USE_WIN32_MAPPING
+/* Like map_fd_range(), with CreateFileMapping() instead of mmap(). */
+static MIO *map_win32_range (const char *filename, MIOOffset offset, size_t length)
+{
+	HANDLE file, mapping;
+	LARGE_INTEGER size;
+	SYSTEM_INFO info;
+	size_t skip;
+	unsigned char *data;
+	MIO *mio;
+
+	file = CreateFileA (filename, GENERIC_READ,
+						FILE_SHARE_READ | FILE_SHARE_WRITE | FILE_SHARE_DELETE,
+						NULL, OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, NULL);
+	if (file == INVALID_HANDLE_VALUE)
+		return NULL;
+	if (GetFileType (file) != FILE_TYPE_DISK
+		|| ! GetFileSizeEx (file, &size)
+		|| (size.QuadPart == 0 && length == (size_t) -1)
+		|| (unsigned long long) size.QuadPart > (size_t) -1)
+	{
+		CloseHandle (file);
+		return read_file_range (filename, offset, length);
+	}
+
+	if (offset > size.QuadPart
+		|| (length != (size_t) -1
+			&& length > (size_t) (size.QuadPart - offset)))
+	{
+		CloseHandle (file);
+		errno = EINVAL;
+		return NULL;
+	}
+	if (length == (size_t) -1)
+		length = (size_t) (size.QuadPart - offset);
+	if (length == 0)
+	{
+		CloseHandle (file);
+		return read_file_range (filename, offset, 0);
+	}
+
+	/* A view starts on a multiple of the allocation granularity. The
+	   view stays valid after the handles are closed. */
+	GetSystemInfo (&info);
+	skip = (size_t) (offset % info.dwAllocationGranularity);
+	mapping = CreateFileMappingA (file, NULL, PAGE_WRITECOPY, 0, 0, NULL);
+	CloseHandle (file);
+	if (mapping == NULL)
+		return read_file_range (filename, offset, length);
+	/* Copy on write so that a stray write only touches the copy */
+	data = MapViewOfFile (mapping, FILE_MAP_COPY,
+						  (DWORD) ((unsigned long long) (offset - skip) >> 32),
+						  (DWORD) ((offset - skip) & 0xffffffff),
+						  length + skip);
+	CloseHandle (mapping);
+	if (data == NULL)
+		return read_file_range (filename, offset, length);
+
+	mio = mio_new_memory (data + skip, length, NULL, NULL);
+	if (! mio)
+	{
+		UnmapViewOfFile (data);
+		return NULL;
+	}
+	mio->impl.mem.mapped = true;
+	mio->impl.mem.map_offset = skip;
+	return mio;
+}
+#endif
+
+MIO *mio_new_mapped_range (const char *filename, MIOOffset offset, size_t length)
+{
+#ifdef MIO_USE_MMAP
+	int fd;
+
+	if (offset < 0)
+		return NULL;
+
+	fd = open (filename, O_RDONLY);
+	if (fd < 0)
+		return NULL;
+	return map_fd_range (fd, filename, offset, length);
+#elif defined (MIO_USE_WIN32_MAPPING)
+	if (offset < 0)
+		return NULL;
+	return map_win32_range (filename, offset, length);
+#else
+	return read_file_range (filename, offset, length);
+#endif
+}
+
+/**
+ * mio_new_mapped_fd:
+ * @fd: Descriptor of the file opened for reading
+ * @filename: Filename of the file
+ *
+ * Like mio_new_mapped_file(), for a file already opened as @fd, e.g. with
+ * openat() relative to the directory being read. @fd is closed; @filename
+ * is opened again only if the file cannot be mapped.
+ *
+ * Free-function: mio_free()
+ *
+ * Returns: A new #MIO on success, or %NULL on failure.
+ */
+MIO *mio_new_mapped_fd (int fd, const char *filename)
+{
+#ifdef MIO_USE_MMAP
+	return map_fd_range (fd, filename, 0, (size_t) -1);
+#elif defined (MIO_USE_WIN32_MAPPING)
+	_close (fd);
+	return map_win32_range (filename, 0, (size_t) -1);
+#else
+# ifdef HAVE_UNISTD_H
+	close (fd);
+# endif
+	return read_file_range (filename, 0, (size_t) -1);
+#endif
+}
+
+/**
+ * mio_prefetch_file:
+ * @filename: Filename to prefetch
+ *
+ * Tells the system @filename is going to be read soon, so that its content
+ * can be brought into memory while the caller does something else. This
+ * does nothing where posix_fadvise() is not available, and errors are
+ * ignored: the file is only opened again later.
+ */
+void mio_prefetch_file (const char *filename)
+{
+#if defined (MIO_USE_MMAP) && defined (HAVE_POSIX_FADVISE)
+	/* O_NONBLOCK not to wait for a writer if this is a FIFO */
+	int fd = open (filename, O_RDONLY | O_NONBLOCK);
+
+	if (fd < 0)
+		return;
+	posix_fadvise (fd, 0, 0, POSIX_FADV_WILLNEED);
+	close (fd);
+#endif
+}
+
 /**
  * mio_ref:
  * @mio: A #MIO object
@@ -481,6 +884,51 @@ unsigned char *mio_memory_get_data (MIO *mio, size_t *size)
 	return ptr;
 }
 
+/**
+ * mio_memory_peek:
+ * @mio: A #MIO object
+ * @available: (out): Return location for the number of bytes available
+ *
+ * Gets a pointer to the data of a #MIO memory stream at the current
+ * position, so that callers can scan it in bulk instead of calling
+ * mio_getc() for each byte. The position is not changed; use mio_seek()
+ * to move past the bytes consumed.
+ *
+ * Returns: The data at the current position, or %NULL if the stream is not
+ *          a memory stream or has a character pushed back with mio_ungetc().
+ */
+const unsigned char *mio_memory_peek (MIO *mio, size_t *available)
+{
+	if (mio->type != MIO_TYPE_MEMORY || mio->impl.mem.ungetch != EOF)
+		return NULL;
+
+	*available = mio->impl.mem.size - mio->impl.mem.pos;
+	return mio->impl.mem.buf + mio->impl.mem.pos;
+}
+
+/**
+ * mio_memory_peek_at:
+ * @mio: A #MIO object
+ * @pos: A position got with mio_getpos() on @mio
+ * @available: (out): Return location for the number of bytes available
+ *
+ * Like mio_memory_peek(), but gets a pointer to the data at @pos instead
+ * of the current position, which is left untouched, as is a character
+ * pushed back with mio_ungetc().
+ *
+ * Returns: The data at @pos, or %NULL if the stream is not a memory
+ *          stream or @pos is out of it.
+ */
+const unsigned char *mio_memory_peek_at (MIO *mio, const MIOPos *pos, size_t *available)
+{
+	if (mio->type != MIO_TYPE_MEMORY || pos->type != MIO_TYPE_MEMORY
+		|| pos->impl.mem > mio->impl.mem.size)
+		return NULL;
+
+	*available = mio->impl.mem.size - pos->impl.mem;
+	return mio->impl.mem.buf + pos->impl.mem;
+}
+
 /**
  * mio_free:
  * @mio: A #MIO object
@@ -506,19 +954,33 @@ int mio_free (MIO *mio)
 		{
 			if (mio->impl.file.close_func)
 				rv = mio->impl.file.close_func (mio->impl.file.fp);
+			if (mio->impl.file.buffer)
+				eFree (mio->impl.file.buffer);
+			mio->impl.file.buffer = NULL;
 			mio->impl.file.close_func = NULL;
 			mio->impl.file.fp = NULL;
 		}
 		else if (mio->type == MIO_TYPE_MEMORY)
 		{
-			if (mio->impl.mem.free_func)
+			if (mio->impl.mem.base)
+				rv = mio_free (mio->impl.mem.base);
+			else if (mio->impl.mem.free_func && mio->impl.mem.buf)
 				mio->impl.mem.free_func (mio->impl.mem.buf);
+#ifdef MIO_USE_MMAP
+			else if (mio->impl.mem.mapped)
+				munmap (mio->impl.mem.buf - mio->impl.mem.map_offset,
+						mio->impl.mem.allocated_size + mio->impl.mem.map_offset);
+#elif defined (MIO_USE_WIN32_MAPPING)
+			else if (mio->impl.mem.mapped)
+				UnmapViewOfFile (mio->impl.mem.buf - mio->impl.mem.map_offset);
+#endif
 			mio->impl.mem.buf = NULL;
 			mio->impl.mem.pos = 0;
 			mio->impl.mem.size = 0;
 			mio->impl.mem.allocated_size = 0;
 			mio->impl.mem.realloc_func = NULL;
 			mio->impl.mem.free_func = NULL;
+			mio->impl.mem.base = NULL;
 			mio->impl.mem.eof = false;
 			mio->impl.mem.error = false;
 		}
@@ -822,7 +1284,7 @@ int mio_vprintf (MIO *mio, const char *format, va_list ap)
 		old_size = mio->impl.mem.size;
 		va_copy (ap_copy, ap);
 		/* compute the size we will need into the buffer */
-		n = vsnprintf (&dummy, 1, format, ap_copy);
+		n = vsnprintf (&dummy, 1, format, ap_copy) + 1;
 		va_end (ap_copy);
 		if (mem_try_ensure_space (mio, n))
 		{
@@ -1106,10 +1568,10 @@ int mio_error (MIO *mio)
  * Returns: 0 on success, -1 otherwise, in which case errno should be set to
  *          indicate the error.
  */
-int mio_seek (MIO *mio, long offset, int whence)
+int mio_seek (MIO *mio, MIOOffset offset, int whence)
 {
 	if (mio->type == MIO_TYPE_FILE)
-		return fseek (mio->impl.file.fp, offset, whence);
+		return file_seek (mio->impl.file.fp, offset, whence);
 	else if (mio->type == MIO_TYPE_MEMORY)
 	{
 		/* FIXME: should we support seeking out of bounds like lseek() seems to do? */
@@ -1118,7 +1580,7 @@ int mio_seek (MIO *mio, long offset, int whence)
 		switch (whence)
 		{
 			case SEEK_SET:
-				if (offset < 0 || (size_t)offset > mio->impl.mem.size)
+				if (offset < 0 || (uint64_t)offset > mio->impl.mem.size)
 					errno = EINVAL;
 				else
 				{
@@ -1128,8 +1590,8 @@ int mio_seek (MIO *mio, long offset, int whence)
 				break;
 
 			case SEEK_CUR:
-				if ((offset < 0 && (size_t)-offset > mio->impl.mem.pos) ||
-					mio->impl.mem.pos + (size_t)offset > mio->impl.mem.size)
+				if ((offset < 0 && (uint64_t)-offset > mio->impl.mem.pos) ||
+					(offset > 0 && (uint64_t)offset > mio->impl.mem.size - mio->impl.mem.pos))
 				{
 					errno = EINVAL;
 				}
@@ -1141,7 +1603,7 @@ int mio_seek (MIO *mio, long offset, int whence)
 				break;
 
 			case SEEK_END:
-				if (offset > 0 || (size_t)-offset > mio->impl.mem.size)
+				if (offset > 0 || (uint64_t)-offset > mio->impl.mem.size)
 					errno = EINVAL;
 				else
 				{
@@ -1179,25 +1641,12 @@ int mio_seek (MIO *mio, long offset, int whence)
  * Returns: The current offset from the start of the stream, or -1 or error, in
  *          which case errno is set to indicate the error.
  */
-long mio_tell (MIO *mio)
+MIOOffset mio_tell (MIO *mio)
 {
 	if (mio->type == MIO_TYPE_FILE)
-		return ftell (mio->impl.file.fp);
+		return file_tell (mio->impl.file.fp);
 	else if (mio->type == MIO_TYPE_MEMORY)
-	{
-		long rv = -1;
-
-		if (mio->impl.mem.pos > LONG_MAX)
-		{
-#ifdef EOVERFLOW
-			errno = EOVERFLOW;
-#endif
-		}
-		else
-			rv = (long)mio->impl.mem.pos;
-
-		return rv;
-	}
+		return (MIOOffset)mio->impl.mem.pos;
 	else
 	{
 		AssertNotReached ();
@@ -1277,6 +1726,62 @@ int mio_getpos (MIO *mio, MIOPos *pos)
 	return rv;
 }
 
+/**
+ * mio_getpos_at_offset:
+ * @mio: A #MIO stream
+ * @offset: An offset in @mio, as returned by mio_tell()
+ * @pos: (out): A #MIOPos object to fill-in
+ *
+ * Stores in @pos the position mio_getpos() would store if the stream were at
+ * @offset, without moving the stream. On a memory stream it only stores
+ * @offset; on a file stream it seeks to @offset and back.
+ *
+ * Returns: 0 on success, -1 otherwise, in which case errno is set to indicate
+ *          the error.
+ */
+int mio_getpos_at_offset (MIO *mio, MIOOffset offset, MIOPos *pos)
+{
+	int rv = -1;
+
+	/* The bytes of @pos not used by its type are cleared, so that the
+	 * positions made for the same offset compare equal with memcmp(). */
+	memset (pos, 0, sizeof (*pos));
+	pos->type = mio->type;
+	if (mio->type == MIO_TYPE_FILE)
+	{
+		fpos_t original;
+
+		if (fgetpos (mio->impl.file.fp, &original) == 0)
+		{
+			if (file_seek (mio->impl.file.fp, offset, SEEK_SET) == 0)
+				rv = fgetpos (mio->impl.file.fp, &pos->impl.file);
+			if (fsetpos (mio->impl.file.fp, &original) != 0)
+				rv = -1;
+		}
+	}
+	else if (mio->type == MIO_TYPE_MEMORY)
+	{
+		if (offset < 0 || (uint64_t) offset > mio->impl.mem.size)
+			errno = EINVAL;
+		else
+		{
+			pos->impl.mem = (size_t) offset;
+			rv = 0;
+		}
+	}
+	else
+		AssertNotReached();
+
+#ifdef MIO_DEBUG
+	if (rv != -1)
+	{
+		pos->tag = mio;
+	}
+#endif /* MIO_DEBUG */
+
+	return rv;
+}
+
 /**
  * mio_setpos:
  * @mio: A #MIO object
@@ -1348,6 +1853,36 @@ int mio_flush (MIO *mio)
 }
 
 
+/**
+ * mio_set_buffer:
+ * @mio: A #MIO object of the type %MIO_TYPE_FILE
+ * @size: Size of the buffer in bytes
+ *
+ * Gives the #FILE object of @mio a fully buffered user-space buffer of
+ * @size bytes, so that writing many short strings results in few large
+ * writes. It must be called before any other operation on @mio, and only
+ * when @mio closes its #FILE object: the buffer is freed with @mio.
+ *
+ * Returns: 0 on success, -1 otherwise.
+ */
+int mio_set_buffer (MIO *mio, size_t size)
+{
+	char *buffer;
+
+	if (mio->type != MIO_TYPE_FILE || mio->impl.file.close_func == NULL
+		|| mio->impl.file.buffer != NULL || size == 0)
+		return -1;
+
+	buffer = eMalloc (size);
+	if (setvbuf (mio->impl.file.fp, buffer, _IOFBF, size) != 0)
+	{
+		eFree (buffer);
+		return -1;
+	}
+	mio->impl.file.buffer = buffer;
+	return 0;
+}
+
 /**
  * mio_attach_user_data:
  * @mio: A #MIO object
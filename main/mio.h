@@ -29,6 +29,7 @@
 
 #include <stdio.h>
 #include <stdarg.h>
+#include <stdint.h>
 
 
 /**
@@ -43,6 +44,14 @@ enum _MIOType {
 	MIO_TYPE_MEMORY
 };
 
+/**
+ * MIOOffset:
+ *
+ * An offset in a #MIO stream. It is 64 bit wide even where long is 32 bit
+ * wide, like on Windows, so that files over 2 GB can be read.
+ */
+typedef int64_t MIOOffset;
+
 typedef enum _MIOType   MIOType;
 typedef struct _MIO     MIO;
 typedef struct _MIOPos  MIOPos;
@@ -123,12 +132,18 @@ MIO *mio_new_memory (unsigned char *data,
 					 MIOReallocFunc realloc_func,
 					 MIODestroyNotify free_func);
 
-MIO *mio_new_mio    (MIO *base, long start, size_t size);
+MIO *mio_new_mapped_file (const char *filename);
+MIO *mio_new_mapped_range (const char *filename, MIOOffset offset, size_t length);
+MIO *mio_new_mapped_fd (int fd, const char *filename);
+void mio_prefetch_file (const char *filename);
+MIO *mio_new_mio    (MIO *base, MIOOffset start, size_t size);
 MIO *mio_ref        (MIO *mio);
 
 int mio_free (MIO *mio);
 FILE *mio_file_get_fp (MIO *mio);
 unsigned char *mio_memory_get_data (MIO *mio, size_t *size);
+const unsigned char *mio_memory_peek (MIO *mio, size_t *available);
+const unsigned char *mio_memory_peek_at (MIO *mio, const MIOPos *pos, size_t *available);
 size_t mio_read (MIO *mio,
 				 void *ptr,
 				 size_t size,
@@ -149,12 +164,14 @@ int mio_printf (MIO *mio, const char *format, ...) CTAGS_ATTR_PRINTF (2, 3);
 void mio_clearerr (MIO *mio);
 int mio_eof (MIO *mio);
 int mio_error (MIO *mio);
-int mio_seek (MIO *mio, long offset, int whence);
-long mio_tell (MIO *mio);
+int mio_seek (MIO *mio, MIOOffset offset, int whence);
+MIOOffset mio_tell (MIO *mio);
 void mio_rewind (MIO *mio);
 int mio_getpos (MIO *mio, MIOPos *pos);
+int mio_getpos_at_offset (MIO *mio, MIOOffset offset, MIOPos *pos);
 int mio_setpos (MIO *mio, MIOPos *pos);
 int mio_flush (MIO *mio);
+int mio_set_buffer (MIO *mio, size_t size);
 
 void  mio_attach_user_data (MIO *mio, void *user_data, MIODestroyNotify user_data_free_func);
 void *mio_get_user_data (MIO *mio);
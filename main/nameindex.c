@@ -0,0 +1,779 @@
+/*
+*   Copyright (c) 2026, Universal Ctags Team
+*
+*   This source code is released for free distribution under the terms of the
+*   GNU General Public License version 2 or (at your option) any later version.
+*
+*   This module contains functions for the name index (--name-index):
+*   a file written next to a sorted tag file, TAGFILE.idx, with which
+*   readtags finds the first line of a name without bisecting the lines
+*   of the tag file, and counts the lines of a name prefix without
+*   reading them. All the numbers are little-endian.
+*
+*   offset  size  content
+*   0       8     "CTAGSNDX"
+*   8       4     version (1)
+*   12      4     sort method of the tag file (1: sorted, 2: foldcase)
+*   16      8     size of the tag file
+*   24      4     number of entries, N
+*   28      4     number of lines of the tag file, L
+*   32      32*N  entries
+*
+*   An entry stands for a run of lines having the same name, in the
+*   order of the tag file, so the entries are sorted like the names:
+*
+*   0       16    the first 16 bytes of the name, padded with NUL
+*   16      8     offset of the first line of the run in the tag file
+*   24      4     number of lines before the run
+*   28      4     length of the name
+*
+*   The lines are the ones after the pseudo tags at the top of the tag
+*   file and having a name, as readtags counts them.
+*
+*   The fold index (--fold-index), TAGFILE.fidx, lets readtags search a
+*   tag file sorted with --sort=yes ignoring case. It has the same layout
+*   with "CTAGSFDX" as magic, but its entries are sorted like the names
+*   with their letters folded to upper case, as with --sort=foldcase, and
+*   in the order of the tag file for the same folded name. The number at
+*   24 in an entry is then the number of lines of the run.
+*
+*   The input index (--input-index), TAGFILE.iidx, lists the lines of
+*   each input file, with which readtags finds the tags of a file without
+*   reading the others. Its header is the same, with "CTAGSINX" as magic,
+*   and the numbers of inputs, I, and of runs, R, at 24 and 28. A run is
+*   made of the lines having the same input one after the other in the
+*   tag file. The inputs, sorted like their names, come first:
+*
+*   0       8     offset of the name in the index, not terminated
+*   8       4     length of the name
+*   12      4     number of runs before the ones of the input
+*
+*   Then the runs, of all the inputs one after the others, each in the
+*   order of the tag file, and the names:
+*
+*   0       8     offset of the first line of the run in the tag file
+*   8       4     number of lines of the run
+*   12      4     zero
+*
+*   The name filter (--name-filter), TAGFILE.bflt, is a Bloom filter of
+*   the names, with which readtags tells that a name is not in the tag
+*   file without reading it. Its header is the same, with "CTAGSBLM" as
+*   magic, and the number of hashes of a name, K, and the base 2
+*   logarithm of the number of bits of the filter, B, at 24 and 28. The
+*   2^B bits follow it, the bit n being the bit n % 8 of the byte n / 8.
+*
+*   A name, with its letters folded to upper case, has two hashes of 32
+*   bits: h1, its FNV-1a hash, and h2, its djb2 hash with the lowest bit
+*   set. The bits (h1 + i * h2) mod 2^B for i from 0 to K - 1 are set
+*   for each name of the tag file, so that a name one of whose bits is
+*   not set is not in it, whether the case is ignored or not.
+*
+*   The trigram index (--trigram-index), TAGFILE.tidx, lists the runs of
+*   lines having the same name whose name contains each sequence of three
+*   bytes, with which readtags finds the names containing a string without
+*   reading all the lines. Its header is the same, with "CTAGSTRI" as
+*   magic, and the numbers of trigrams, T, and of runs, R, at 24 and 28.
+*   The letters of the names are folded to upper case for the trigrams, so
+*   that readtags uses it whether the case is ignored or not, and checks
+*   the names of the runs found. The trigrams, sorted, come first:
+*
+*   0       3     the trigram
+*   3       1     zero
+*   4       4     number of runs whose name contains it
+*   8       8     offset of its list of runs in the index
+*
+*   Then the runs, in the order of the tag file:
+*
+*   0       8     offset of the first line of the run in the tag file
+*   8       4     number of lines of the run
+*   12      4     length of the name
+*
+*   Then the lists of runs, each run of a list given by its difference
+*   with the one before it in the list (with the run 0 for the first), as
+*   a number of 7 bits per byte, lowest first, the highest bit being set
+*   in all the bytes but the last one. A list ends where the next begins.
+*/
+
+/*
+*   INCLUDE FILES
+*/
+#include "general.h"  /* must always come first */
+
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "debug.h"
+#include "mio.h"
+#include "nameindex.h"
+#include "options.h"
+#include "routines.h"
+#include "vstring.h"
+
+/*
+*   MACROS
+*/
+#define NAME_INDEX_VERSION 1
+#define NAME_INDEX_HEADER_SIZE 32
+#define NAME_INDEX_ENTRY_SIZE 32
+#define NAME_INDEX_KEY_SIZE 16
+#define INPUT_INDEX_ENTRY_SIZE 16
+#define NAME_FILTER_HASHES 7
+#define NAME_FILTER_BITS_PER_NAME 10
+#define NAME_FILTER_MAX_LOG2 31
+#define TRIGRAM_INDEX_ENTRY_SIZE 16
+
+/*
+*   DATA DECLARATIONS
+*/
+typedef struct {
+	uint64_t offset;
+	uint32_t lines;
+	uint32_t length;
+} nameRun;
+
+/* A run of lines of the same input, for the input index */
+typedef struct {
+	uint64_t offset;
+	uint32_t lines;
+	uint32_t inputLength;
+	uint64_t input;
+} inputRun;
+
+/*
+*   DATA DEFINITIONS
+*/
+
+/* The tag file whose runs are sorted for the fold or the input index */
+static const unsigned char *FoldedTagFile;
+
+/*
+*   FUNCTION DEFINITIONS
+*/
+
+static void putNumber (unsigned char *bytes, uint64_t n, unsigned int size)
+{
+	unsigned int i;
+
+	for (i = 0; i < size; i++)
+	{
+		bytes [i] = (unsigned char) (n & 0xFF);
+		n >>= 8;
+	}
+}
+
+/* The name of the tag at LINE, as readtags takes it. */
+static size_t nameLength (const unsigned char *const line, size_t length)
+{
+	const unsigned char *end = memchr (line, '\t', length);
+
+	if (end == NULL)
+		end = memchr (line, '\r', length);
+	return end? (size_t) (end - line): length;
+}
+
+static void writeEntry (MIO *output, const unsigned char *const name, size_t length,
+						uint64_t offset, uint32_t ordinal)
+{
+	unsigned char bytes [NAME_INDEX_ENTRY_SIZE];
+
+	memset (bytes, 0, NAME_INDEX_KEY_SIZE);
+	memcpy (bytes, name, length < NAME_INDEX_KEY_SIZE? length: NAME_INDEX_KEY_SIZE);
+	putNumber (bytes + 16, offset, 8);
+	putNumber (bytes + 24, ordinal, 4);
+	putNumber (bytes + 28, length, 4);
+	mio_write (output, bytes, 1, sizeof bytes);
+}
+
+static void writeHeader (MIO *output, const char *const magic,
+						 uint64_t size, uint32_t count, uint32_t lines)
+{
+	unsigned char bytes [NAME_INDEX_HEADER_SIZE];
+
+	memcpy (bytes, magic, 8);
+	putNumber (bytes + 8, NAME_INDEX_VERSION, 4);
+	putNumber (bytes + 12, Option.sorted, 4);
+	putNumber (bytes + 16, size, 8);
+	putNumber (bytes + 24, count, 4);
+	putNumber (bytes + 28, lines, 4);
+	mio_write (output, bytes, 1, sizeof bytes);
+}
+
+/* A byte of a name as readtags compares it ignoring case, in the C locale */
+static int foldChar (unsigned char c)
+{
+	const int i = (int) (char) c;
+	return (i >= 'a' && i <= 'z')? i - 'a' + 'A': i;
+}
+
+static int compareFoldedRuns (const void *a, const void *b)
+{
+	const nameRun *const ra = a;
+	const nameRun *const rb = b;
+	const unsigned char *const na = FoldedTagFile + ra->offset;
+	const unsigned char *const nb = FoldedTagFile + rb->offset;
+	uint32_t i;
+
+	for (i = 0; i < ra->length || i < rb->length; i++)
+	{
+		const int ca = (i < ra->length)? foldChar (na [i]): 0;
+		const int cb = (i < rb->length)? foldChar (nb [i]): 0;
+		if (ca != cb)
+			return ca - cb;
+	}
+	if (ra->offset != rb->offset)
+		return (ra->offset < rb->offset)? -1: 1;
+	return 0;
+}
+
+/* Write the runs of the fold index, sorted by folded name. */
+static void writeFoldedRuns (MIO *output, const unsigned char *const data,
+							 nameRun *runs, uint32_t count)
+{
+	uint32_t i;
+
+	FoldedTagFile = data;
+	qsort (runs, count, sizeof (nameRun), compareFoldedRuns);
+	FoldedTagFile = NULL;
+	for (i = 0; i < count; i++)
+		writeEntry (output, data + runs [i].offset, runs [i].length,
+					runs [i].offset, runs [i].lines);
+}
+
+/* Write the entries of the tag file at DATA, in the order of the tag
+ * file, or sorted for the fold index if RUNS is not NULL, in which case
+ * the runs are collected in it. With no OUTPUT, the runs are only
+ * collected, in the order of the tag file. Return false if it has too
+ * many lines for the index. */
+static bool writeEntries (MIO *output, const unsigned char *const data, size_t size,
+						  uint32_t *count, uint32_t *lines, nameRun **runs)
+{
+	const unsigned char *p = data;
+	const unsigned char *const end = data + size;
+	const unsigned char *runName = NULL;
+	size_t runLength = 0;
+	size_t runSize = 0;
+	bool pseudo = true;
+
+	*count = 0;
+	*lines = 0;
+	while (p < end)
+	{
+		const unsigned char *newline = memchr (p, '\n', end - p);
+		const unsigned char *const next = newline? newline + 1: end;
+		size_t length = (newline? newline: end) - p;
+		size_t n;
+
+		while (length > 0 && p [length - 1] == '\r')
+			length--;
+		n = nameLength (p, length);
+
+		if (pseudo && length >= 2 && p [0] == '!' && p [1] == '_')
+			n = 0;
+		else
+			pseudo = false;
+
+		if (n > 0)
+		{
+			if (runName == NULL || n != runLength || memcmp (p, runName, n) != 0)
+			{
+				if (*count == UINT32_MAX)
+					return false;
+				if (runs == NULL)
+					writeEntry (output, p, n, (uint64_t) (p - data), *lines);
+				else
+				{
+					if (*count == runSize)
+					{
+						runSize = runSize? runSize * 2: 1024;
+						*runs = xRealloc (*runs, runSize, nameRun);
+					}
+					(*runs) [*count].offset = (uint64_t) (p - data);
+					(*runs) [*count].lines = 0;
+					(*runs) [*count].length = (uint32_t) n;
+				}
+				++*count;
+				runName = p;
+				runLength = n;
+			}
+			if (*lines == UINT32_MAX)
+				return false;
+			++*lines;
+			if (runs != NULL)
+				(*runs) [*count - 1].lines++;
+		}
+		p = next;
+	}
+	if (runs != NULL && output != NULL)
+		writeFoldedRuns (output, data, *runs, *count);
+	return true;
+}
+
+static void writeIndex (const char *const tagFile, const char *const magic,
+						const char *const suffix, bool fold)
+{
+	vString *const name = vStringNewInit (tagFile);
+	MIO *input, *output;
+	const unsigned char *data;
+	size_t size = 0;
+	uint32_t count, lines;
+	nameRun *runs = NULL;
+
+	vStringCatS (name, suffix);
+	input = mio_new_mapped_file (tagFile);
+	if (input == NULL)
+		error (FATAL | PERROR, "cannot open tag file \"%s\"", tagFile);
+	data = mio_memory_get_data (input, &size);
+
+	output = mio_new_file (vStringValue (name), "wb");
+	if (output == NULL)
+		error (FATAL | PERROR, "cannot open name index \"%s\"", vStringValue (name));
+
+	verbose ("writing name index \"%s\"\n", vStringValue (name));
+	writeHeader (output, magic, 0, 0, 0);
+	if (writeEntries (output, data, size, &count, &lines, fold? &runs: NULL))
+	{
+		mio_seek (output, 0L, SEEK_SET);
+		writeHeader (output, magic, size, count, lines);
+	}
+	else
+		error (WARNING, "too many tags for the name index \"%s\"; readtags ignores it",
+			   vStringValue (name));
+
+	if (mio_error (output) || mio_free (output) != 0)
+		error (FATAL | PERROR, "cannot write name index \"%s\"", vStringValue (name));
+	if (runs)
+		eFree (runs);
+	mio_free (input);
+	vStringDelete (name);
+}
+
+static int compareInputRuns (const void *a, const void *b)
+{
+	const inputRun *const ra = a;
+	const inputRun *const rb = b;
+	const uint32_t length = (ra->inputLength < rb->inputLength)
+		? ra->inputLength: rb->inputLength;
+	const int result = memcmp (FoldedTagFile + ra->input,
+							   FoldedTagFile + rb->input, length);
+
+	if (result != 0)
+		return result;
+	if (ra->inputLength != rb->inputLength)
+		return (ra->inputLength < rb->inputLength)? -1: 1;
+	if (ra->offset != rb->offset)
+		return (ra->offset < rb->offset)? -1: 1;
+	return 0;
+}
+
+/* Collect the runs of lines of the same input in the tag file at DATA.
+ * Return false if it has too many lines for the index. */
+static bool collectInputRuns (const unsigned char *const data, size_t size,
+							  inputRun **runs, uint32_t *count)
+{
+	const unsigned char *p = data;
+	const unsigned char *const end = data + size;
+	size_t runSize = 0;
+	bool pseudo = true;
+
+	*count = 0;
+	while (p < end)
+	{
+		const unsigned char *newline = memchr (p, '\n', end - p);
+		const unsigned char *const next = newline? newline + 1: end;
+		size_t length = (newline? newline: end) - p;
+		const unsigned char *input, *inputEnd;
+		size_t n;
+
+		while (length > 0 && p [length - 1] == '\r')
+			length--;
+		n = nameLength (p, length);
+
+		if (pseudo && length >= 2 && p [0] == '!' && p [1] == '_')
+			n = 0;
+		else
+			pseudo = false;
+
+		if (n > 0)
+		{
+			input = (n < length)? p + n + 1: p + length;
+			inputEnd = memchr (input, '\t', p + length - input);
+			if (inputEnd == NULL)
+				inputEnd = p + length;
+
+			if (*count > 0
+				&& (*runs) [*count - 1].inputLength == (uint32_t) (inputEnd - input)
+				&& memcmp (data + (*runs) [*count - 1].input, input, inputEnd - input) == 0)
+			{
+				if ((*runs) [*count - 1].lines == UINT32_MAX)
+					return false;
+				(*runs) [*count - 1].lines++;
+			}
+			else
+			{
+				if (*count == UINT32_MAX)
+					return false;
+				if (*count == runSize)
+				{
+					runSize = runSize? runSize * 2: 1024;
+					*runs = xRealloc (*runs, runSize, inputRun);
+				}
+				(*runs) [*count].offset = (uint64_t) (p - data);
+				(*runs) [*count].lines = 1;
+				(*runs) [*count].inputLength = (uint32_t) (inputEnd - input);
+				(*runs) [*count].input = (uint64_t) (input - data);
+				++*count;
+			}
+		}
+		p = next;
+	}
+	return true;
+}
+
+static bool isSameInput (const unsigned char *const data,
+						 const inputRun *const a, const inputRun *const b)
+{
+	return a->inputLength == b->inputLength
+		&& memcmp (data + a->input, data + b->input, a->inputLength) == 0;
+}
+
+/* Write the inputs, the runs and the names of the input index, the runs
+ * being sorted by input. */
+static void writeInputEntries (MIO *output, const unsigned char *const data,
+							   inputRun *runs, uint32_t count, uint32_t *inputs)
+{
+	unsigned char bytes [INPUT_INDEX_ENTRY_SIZE];
+	uint64_t nameOffset;
+	uint32_t i;
+
+	FoldedTagFile = data;
+	qsort (runs, count, sizeof (inputRun), compareInputRuns);
+	FoldedTagFile = NULL;
+
+	*inputs = 0;
+	for (i = 0; i < count; i++)
+		if (i == 0 || ! isSameInput (data, runs + i - 1, runs + i))
+			++*inputs;
+
+	nameOffset = NAME_INDEX_HEADER_SIZE
+		+ (uint64_t) INPUT_INDEX_ENTRY_SIZE * ((uint64_t) *inputs + count);
+	for (i = 0; i < count; i++)
+	{
+		if (i > 0 && isSameInput (data, runs + i - 1, runs + i))
+			continue;
+		putNumber (bytes, nameOffset, 8);
+		putNumber (bytes + 8, runs [i].inputLength, 4);
+		putNumber (bytes + 12, i, 4);
+		mio_write (output, bytes, 1, sizeof bytes);
+		nameOffset += runs [i].inputLength;
+	}
+
+	memset (bytes, 0, sizeof bytes);
+	for (i = 0; i < count; i++)
+	{
+		putNumber (bytes, runs [i].offset, 8);
+		putNumber (bytes + 8, runs [i].lines, 4);
+		mio_write (output, bytes, 1, sizeof bytes);
+	}
+
+	for (i = 0; i < count; i++)
+		if (i == 0 || ! isSameInput (data, runs + i - 1, runs + i))
+			mio_write (output, data + runs [i].input, 1, runs [i].inputLength);
+}
+
+extern void writeInputIndex (const char *const tagFile)
+{
+	vString *const name = vStringNewInit (tagFile);
+	MIO *input, *output;
+	const unsigned char *data;
+	size_t size = 0;
+	uint32_t count, inputs;
+	inputRun *runs = NULL;
+
+	vStringCatS (name, INPUT_INDEX_SUFFIX);
+	input = mio_new_mapped_file (tagFile);
+	if (input == NULL)
+		error (FATAL | PERROR, "cannot open tag file \"%s\"", tagFile);
+	data = mio_memory_get_data (input, &size);
+
+	output = mio_new_file (vStringValue (name), "wb");
+	if (output == NULL)
+		error (FATAL | PERROR, "cannot open input index \"%s\"", vStringValue (name));
+
+	verbose ("writing input index \"%s\"\n", vStringValue (name));
+	writeHeader (output, INPUT_INDEX_MAGIC, 0, 0, 0);
+	if (collectInputRuns (data, size, &runs, &count))
+	{
+		writeInputEntries (output, data, runs, count, &inputs);
+		mio_seek (output, 0L, SEEK_SET);
+		writeHeader (output, INPUT_INDEX_MAGIC, size, inputs, count);
+	}
+	else
+		error (WARNING, "too many tags for the input index \"%s\"; readtags ignores it",
+			   vStringValue (name));
+
+	if (mio_error (output) || mio_free (output) != 0)
+		error (FATAL | PERROR, "cannot write input index \"%s\"", vStringValue (name));
+	if (runs)
+		eFree (runs);
+	mio_free (input);
+	vStringDelete (name);
+}
+
+static void addFilterName (unsigned char *const bits, uint32_t mask,
+						   const unsigned char *const name, size_t length)
+{
+	uint32_t h1 = 2166136261U;
+	uint32_t h2 = 5381;
+	size_t i;
+
+	for (i = 0; i < length; i++)
+	{
+		const unsigned char c = (unsigned char) foldChar (name [i]);
+
+		h1 = (h1 ^ c) * 16777619U;
+		h2 = h2 * 33 + c;
+	}
+	h2 |= 1;
+
+	for (i = 0; i < NAME_FILTER_HASHES; i++)
+	{
+		const uint32_t bit = (h1 + (uint32_t) i * h2) & mask;
+
+		bits [bit / 8] |= (unsigned char) (1U << (bit % 8));
+	}
+}
+
+/* Set the bits of the names of the tag file at DATA in the filter. */
+static void fillNameFilter (unsigned char *const bits, uint32_t mask,
+							const unsigned char *const data, size_t size)
+{
+	const unsigned char *p = data;
+	const unsigned char *const end = data + size;
+	bool pseudo = true;
+
+	while (p < end)
+	{
+		const unsigned char *newline = memchr (p, '\n', end - p);
+		const unsigned char *const next = newline? newline + 1: end;
+		size_t length = (newline? newline: end) - p;
+		size_t n;
+
+		while (length > 0 && p [length - 1] == '\r')
+			length--;
+		n = nameLength (p, length);
+
+		if (pseudo && length >= 2 && p [0] == '!' && p [1] == '_')
+			n = 0;
+		else
+			pseudo = false;
+
+		if (n > 0)
+			addFilterName (bits, mask, p, n);
+		p = next;
+	}
+}
+
+extern void writeNameFilter (const char *const tagFile)
+{
+	vString *const name = vStringNewInit (tagFile);
+	MIO *input, *output;
+	const unsigned char *data, *p, *end;
+	size_t size = 0;
+	uint64_t lines = 1;
+	uint32_t log2 = 6;
+	unsigned char *bits;
+
+	vStringCatS (name, NAME_FILTER_SUFFIX);
+	input = mio_new_mapped_file (tagFile);
+	if (input == NULL)
+		error (FATAL | PERROR, "cannot open tag file \"%s\"", tagFile);
+	data = mio_memory_get_data (input, &size);
+
+	output = mio_new_file (vStringValue (name), "wb");
+	if (output == NULL)
+		error (FATAL | PERROR, "cannot open name filter \"%s\"", vStringValue (name));
+
+	/* The lines, pseudo tags included, are a little more than the names. */
+	for (p = data, end = data + size; p < end && (p = memchr (p, '\n', end - p)); p++)
+		lines++;
+	while (log2 < NAME_FILTER_MAX_LOG2
+		   && ((uint64_t) 1 << log2) < lines * NAME_FILTER_BITS_PER_NAME)
+		log2++;
+
+	verbose ("writing name filter \"%s\"\n", vStringValue (name));
+	bits = xCalloc ((size_t) 1 << (log2 - 3), unsigned char);
+	fillNameFilter (bits, (uint32_t) (((uint64_t) 1 << log2) - 1), data, size);
+	writeHeader (output, NAME_FILTER_MAGIC, size, NAME_FILTER_HASHES, log2);
+	mio_write (output, bits, 1, (size_t) 1 << (log2 - 3));
+
+	if (mio_error (output) || mio_free (output) != 0)
+		error (FATAL | PERROR, "cannot write name filter \"%s\"", vStringValue (name));
+	eFree (bits);
+	mio_free (input);
+	vStringDelete (name);
+}
+
+static int compareTrigramRuns (const void *a, const void *b)
+{
+	const uint64_t ka = *(const uint64_t *) a;
+	const uint64_t kb = *(const uint64_t *) b;
+
+	return (ka < kb)? -1: (ka > kb)? 1: 0;
+}
+
+/* The trigrams of the names of RUNS, each with the run in its lowest 32
+ * bits, sorted and without duplicates. */
+static uint64_t *collectTrigrams (const unsigned char *const data,
+								  const nameRun *const runs, uint32_t count,
+								  size_t *trigrams)
+{
+	uint64_t *keys = NULL;
+	size_t keySize = 0, n = 0, i, j;
+	uint32_t r;
+
+	for (r = 0; r < count; r++)
+	{
+		const unsigned char *const name = data + runs [r].offset;
+		uint32_t k;
+
+		for (k = 0; k + 3 <= runs [r].length; k++)
+		{
+			const uint64_t trigram = ((uint64_t) (unsigned char) foldChar (name [k]) << 16)
+				| ((uint64_t) (unsigned char) foldChar (name [k + 1]) << 8)
+				| (uint64_t) (unsigned char) foldChar (name [k + 2]);
+
+			if (n == keySize)
+			{
+				keySize = keySize? keySize * 2: 1024;
+				keys = xRealloc (keys, keySize, uint64_t);
+			}
+			keys [n++] = (trigram << 32) | r;
+		}
+	}
+	if (n > 0)
+		qsort (keys, n, sizeof (uint64_t), compareTrigramRuns);
+	for (i = j = 0; i < n; i++)
+		if (j == 0 || keys [i] != keys [j - 1])
+			keys [j++] = keys [i];
+	*trigrams = j;
+	return keys;
+}
+
+static void putPostingNumber (vString *postings, uint32_t n)
+{
+	while (n >= 0x80)
+	{
+		vStringPut (postings, (int) ((n & 0x7F) | 0x80));
+		n >>= 7;
+	}
+	vStringPut (postings, (int) n);
+}
+
+/* Write the trigrams, the runs and the lists of the runs of each trigram
+ * of the trigram index, from the sorted KEYS. Return the number of the
+ * trigrams. */
+static uint32_t writeTrigramEntries (MIO *output, const nameRun *const runs, uint32_t count,
+									 const uint64_t *const keys, size_t n)
+{
+	vString *const postings = vStringNew ();
+	size_t i, first;
+	uint32_t trigrams = 0, r;
+	uint64_t base;
+
+	for (i = 0; i < n; i++)
+		if (i == 0 || (keys [i] >> 32) != (keys [i - 1] >> 32))
+			trigrams++;
+	base = NAME_INDEX_HEADER_SIZE
+		+ (uint64_t) TRIGRAM_INDEX_ENTRY_SIZE * ((uint64_t) trigrams + count);
+
+	for (first = 0; first < n; first = i)
+	{
+		const uint64_t trigram = keys [first] >> 32;
+		unsigned char bytes [TRIGRAM_INDEX_ENTRY_SIZE];
+		uint32_t previous = 0;
+
+		memset (bytes, 0, sizeof bytes);
+		bytes [0] = (unsigned char) (trigram >> 16);
+		bytes [1] = (unsigned char) (trigram >> 8);
+		bytes [2] = (unsigned char) trigram;
+		putNumber (bytes + 8, base + vStringLength (postings), 8);
+		for (i = first; i < n && (keys [i] >> 32) == trigram; i++)
+		{
+			const uint32_t run = (uint32_t) keys [i];
+
+			putPostingNumber (postings, run - previous);
+			previous = run;
+		}
+		putNumber (bytes + 4, i - first, 4);
+		mio_write (output, bytes, 1, sizeof bytes);
+	}
+
+	for (r = 0; r < count; r++)
+	{
+		unsigned char bytes [TRIGRAM_INDEX_ENTRY_SIZE];
+
+		putNumber (bytes, runs [r].offset, 8);
+		putNumber (bytes + 8, runs [r].lines, 4);
+		putNumber (bytes + 12, runs [r].length, 4);
+		mio_write (output, bytes, 1, sizeof bytes);
+	}
+
+	mio_write (output, vStringValue (postings), 1, vStringLength (postings));
+	vStringDelete (postings);
+	return trigrams;
+}
+
+extern void writeTrigramIndex (const char *const tagFile)
+{
+	vString *const name = vStringNewInit (tagFile);
+	MIO *input, *output;
+	const unsigned char *data;
+	size_t size = 0;
+	uint32_t count, lines;
+	nameRun *runs = NULL;
+
+	vStringCatS (name, TRIGRAM_INDEX_SUFFIX);
+	input = mio_new_mapped_file (tagFile);
+	if (input == NULL)
+		error (FATAL | PERROR, "cannot open tag file \"%s\"", tagFile);
+	data = mio_memory_get_data (input, &size);
+
+	output = mio_new_file (vStringValue (name), "wb");
+	if (output == NULL)
+		error (FATAL | PERROR, "cannot open trigram index \"%s\"", vStringValue (name));
+
+	verbose ("writing trigram index \"%s\"\n", vStringValue (name));
+	writeHeader (output, TRIGRAM_INDEX_MAGIC, 0, 0, 0);
+	if (writeEntries (NULL, data, size, &count, &lines, &runs))
+	{
+		size_t n;
+		uint64_t *const keys = collectTrigrams (data, runs, count, &n);
+		const uint32_t trigrams = writeTrigramEntries (output, runs, count, keys, n);
+
+		if (keys)
+			eFree (keys);
+		mio_seek (output, 0L, SEEK_SET);
+		writeHeader (output, TRIGRAM_INDEX_MAGIC, size, trigrams, count);
+	}
+	else
+		error (WARNING, "too many tags for the trigram index \"%s\"; readtags ignores it",
+			   vStringValue (name));
+
+	if (mio_error (output) || mio_free (output) != 0)
+		error (FATAL | PERROR, "cannot write trigram index \"%s\"", vStringValue (name));
+	if (runs)
+		eFree (runs);
+	mio_free (input);
+	vStringDelete (name);
+}
+
+extern void writeNameIndex (const char *const tagFile)
+{
+	writeIndex (tagFile, NAME_INDEX_MAGIC, NAME_INDEX_SUFFIX, false);
+}
+
+extern void writeFoldIndex (const char *const tagFile)
+{
+	writeIndex (tagFile, FOLD_INDEX_MAGIC, FOLD_INDEX_SUFFIX, true);
+}
@@ -0,0 +1,55 @@
+/*
+*   Copyright (c) 2026, Universal Ctags Team
+*
+*   This source code is released for free distribution under the terms of the
+*   GNU General Public License version 2 or (at your option) any later version.
+*
+*   External interface to nameindex.c
+*/
+#ifndef CTAGS_MAIN_NAMEINDEX_H
+#define CTAGS_MAIN_NAMEINDEX_H
+
+/*
+*   INCLUDE FILES
+*/
+#include "general.h"  /* must always come first */
+
+/*
+*   MACROS
+*/
+#define NAME_INDEX_MAGIC "CTAGSNDX"
+#define NAME_INDEX_SUFFIX ".idx"
+#define FOLD_INDEX_MAGIC "CTAGSFDX"
+#define FOLD_INDEX_SUFFIX ".fidx"
+#define INPUT_INDEX_MAGIC "CTAGSINX"
+#define INPUT_INDEX_SUFFIX ".iidx"
+#define NAME_FILTER_MAGIC "CTAGSBLM"
+#define NAME_FILTER_SUFFIX ".bflt"
+#define TRIGRAM_INDEX_MAGIC "CTAGSTRI"
+#define TRIGRAM_INDEX_SUFFIX ".tidx"
+
+/*
+*   FUNCTION PROTOTYPES
+*/
+
+/* Write TAGFILE.idx, the name index of TAGFILE, which is sorted
+   according to --sort (--name-index). */
+extern void writeNameIndex (const char *const tagFile);
+
+/* Write TAGFILE.fidx, the name index of TAGFILE sorted ignoring case,
+   which is sorted with --sort=yes (--fold-index). */
+extern void writeFoldIndex (const char *const tagFile);
+
+/* Write TAGFILE.iidx, the index of the lines of TAGFILE by input file
+   (--input-index). */
+extern void writeInputIndex (const char *const tagFile);
+
+/* Write TAGFILE.bflt, a Bloom filter of the tag names of TAGFILE
+   (--name-filter). */
+extern void writeNameFilter (const char *const tagFile);
+
+/* Write TAGFILE.tidx, the lists of the names of TAGFILE containing each
+   trigram (--trigram-index). */
+extern void writeTrigramIndex (const char *const tagFile);
+
+#endif	/* CTAGS_MAIN_NAMEINDEX_H */
@@ -47,6 +47,12 @@ extern void nestingLevelsFree(NestingLevels *nls)
 	eFree(nls);
 }
 
+/* Pop all the levels, keeping the memory for them. */
+extern void nestingLevelsClear(NestingLevels *nls)
+{
+	nls->n = 0;
+}
+
 extern NestingLevel * nestingLevelsPush(NestingLevels *nls, int corkIndex)
 {
 	NestingLevel *nl = NULL;
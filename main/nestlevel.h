@@ -42,6 +42,7 @@ struct NestingLevels
 */
 extern NestingLevels *nestingLevelsNew(size_t userDataSize);
 extern void nestingLevelsFree(NestingLevels *nls);
+extern void nestingLevelsClear(NestingLevels *nls);
 extern NestingLevel *nestingLevelsPush(NestingLevels *nls, int corkIndex);
 extern NestingLevel * nestingLevelsTruncate(NestingLevels *nls, int depth, int corkIndex);
 extern void nestingLevelsPop(NestingLevels *nls);
@@ -22,7 +22,7 @@
 
 struct sObjPool {
 	ptrArray *array;
-	unsigned int size;
+	unsigned int size;			/* kept by objPoolTrim */
 	objPoolCreateFunc createFunc;
 	objPoolDeleteFunc deleteFunc;
 	objPoolClearFunc clearFunc;
@@ -75,8 +75,15 @@ extern void objPoolPut (objPool *pool, void *obj)
 	if (obj == NULL)
 		return;
 
-	if (ptrArrayCount (pool->array) < pool->size)
-		ptrArrayAdd (pool->array, obj);
-	else
+	ptrArrayAdd (pool->array, obj);
+}
+
+extern void objPoolTrim (objPool *pool)
+{
+	while (ptrArrayCount (pool->array) > pool->size)
+	{
+		void *obj = ptrArrayLast (pool->array);
+		ptrArrayRemoveLast (pool->array);
 		pool->deleteFunc (obj);
+	}
 }
@@ -30,11 +30,17 @@ typedef struct sObjPool objPool;
 /*
 *   FUNCTION PROTOTYPES
 */
+/* The pool keeps every object put back, so that it grows up to the
+ * largest number of objects in use at once and no longer allocates
+ * after that. objPoolTrim releases the idle objects beyond SIZE at once,
+ * e.g. when a large input file is done with. Each worker process has
+ * pools of its own, so no locking is needed. */
 extern objPool *objPoolNew (unsigned int size,
 	objPoolCreateFunc createFunc, objPoolDeleteFunc deleteFunc, objPoolClearFunc clearFunc,
 	void *createArg);
 extern void objPoolDelete (objPool *pool);
 extern void *objPoolGet (objPool *pool);
 extern void objPoolPut (objPool *pool, void *obj);
+extern void objPoolTrim (objPool *pool);
 
 #endif  /* CTAGS_MAIN_OBJPOOL_H */
@@ -23,8 +23,10 @@
 #include "ctags.h"
 #include "debug.h"
 #include "field.h"
+#include "htable.h"
 #include "keyword.h"
 #include "main.h"
+#include "microbench.h"
 #define OPTION_WRITE
 #include "options.h"
 #include "parse.h"
@@ -67,7 +69,7 @@
 # define RECURSE_SUPPORTED
 #endif
 
-#define isCompoundOption(c)  (bool) (strchr ("fohiILpdDb", (c)) != NULL)
+#define isCompoundOption(c)  (bool) (strchr ("fohiIjLpdDb", (c)) != NULL)
 
 #define ENTER(STAGE) do {												\
 		Assert (Stage <= OptionLoadingStage##STAGE);					\
@@ -117,10 +119,23 @@ typedef const struct sBooleanOption {
 static bool NonOptionEncountered = false;
 static stringList *OptionFiles;
 
+/* All the options processed so far, from any source, except those which
+   cannot change the tags of a file; see getOptionHistory (). */
+static vString *OptionHistory;
+
 typedef stringList searchPathList;
 static searchPathList *OptlibPathList;
 
 static stringList* Excluded;
+
+/* Excluded taken apart for isExcludedFile: the names having no wildcard,
+   the patterns "*SUFFIX" whose SUFFIX has none, and the other patterns,
+   still matched with fnmatch. Rebuilt after Excluded changes. */
+static hashTable* ExcludedNames;
+static hashTable* ExcludedSuffixes;
+static size_t ExcludedSuffixMaxLength;
+static stringList* ExcludedPatterns;	/* doesn't own its items */
+static bool ExcludedIndexDirty = true;
 static bool FilesRequired = true;
 static bool SkipConfiguration;
 
@@ -145,9 +160,13 @@ optionValues Option = {
 	.xref = false,
 	.customXfmt = NULL,
 	.fileList = NULL,
+	.nulSeparatedList = false,
+	.gitTree = NULL,
 	.tagFileName = NULL,
+	.outputs = NULL,
 	.headerExt = NULL,
 	.etagsInclude = NULL,
+	.ignoreFileNames = NULL,
 	.tagFileFormat = DEFAULT_FILE_FORMAT,
 #ifdef HAVE_ICONV
 	.inputEncoding= NULL,
@@ -157,17 +176,49 @@ optionValues Option = {
 	.followLinks = true,
 	.filter = false,
 	.filterTerminator = NULL,
+	.filterTerminatorId = false,
+	.filterBatchSize = 0,
+	.filterBatchTime = 100,
 	.tagRelative = false,
-	.printTotals = false,
+	.printTotals = TOTALS_NO,
 	.lineDirectives = false,
 	.printLanguage =false,
 	.guessLanguageEagerly = false,
+	.guessCache = false,
 	.quiet = false,
 	.fatalWarnings = false,
 	.patternLengthLimit = 96,
 	.putFieldPrefix = false,
 	.maxRecursionDepth = 0xffffffff,
+	.jobs = 1,
+	.cacheDir = NULL,
+	.cacheRemote = NULL,
+	.update = false,
+	.deduplicateInputs = false,
+	.deduplicateTags = false,
+	.atomicOutput = false,
+	.manifest = false,
+	.mergeShards = false,
+	.nameIndex = false,
+	.foldIndex = false,
+	.inputIndex = false,
+	.nameFilter = false,
+	.trigramIndex = false,
+	.outputBufferSize = 1024 * 1024,
+	.compress = COMPRESS_NONE,
+	.compressFrameSize = 1024 * 1024,
+	.reportSlow = 0,
+	.fileTimeLimit = 0,
+	.memoryLimit = 0,
+	.generatedInput = GENERATED_INPUT_TAG,
+	.partition = PARTITION_NONE,
+	.partitionDepth = 1,
+	.generatedInputSize = 0,
+	.traceEvents = NULL,
+	.rereadInput = true,
+	.selectorWindow = 64 * 1024,
 	.interactive = false,
+	.profileRegex = REGEX_PROFILE_NONE,
 #ifdef DEBUG
 	.debugLevel = 0,
 	.breakLine = 0,
@@ -214,6 +265,8 @@ static optionDescription LongOptionDescription [] = {
  {1,"  -I <list|@file>"},
  {1,"       A list of tokens to be specially handled is read from either the"},
  {1,"       command line or the specified file."},
+ {1,"  -j <N>"},
+ {1,"       Equivalent to --jobs=N."},
  {1,"  -L <file>"},
  {1,"       A list of input file names is read from the specified file."},
  {1,"       If specified as \"-\", then standard input is read."},
@@ -228,11 +281,35 @@ static optionDescription LongOptionDescription [] = {
  {0,"  -u   Equivalent to --sort=no."},
  {1,"  -V   Equivalent to --verbose."},
  {1,"  -x   Print a tabular cross reference file to standard output."},
+ {1,"  -z   Equivalent to --nul-separated-list."},
  {1,"  --alias-<LANG>=[+|-]aliasPattern"},
  {1,"      Add a pattern detecting a name, can be used as an alternative name"},
  {1,"      for LANG."},
  {1,"  --append=[yes|no]"},
  {1,"       Should tags should be appended to existing tag file [no]?"},
+ {1,"  --atomic-output=[yes|no]"},
+ {1,"       Write the tag file next to it and rename it into place when complete [no]."},
+ {1,"  --cache-dir=dir"},
+ {1,"      Reuse the tags of unchanged input files stored in 'dir'."},
+ {1,"  --cache-remote=command"},
+#ifdef HAVE_WORKING_FORK
+ {1,"       Fetch the tags missing from --cache-dir, and store new ones, through"},
+ {1,"       the helper 'command' of a shared cache."},
+#else
+ {1,"       Not supported on this platform."},
+#endif
+ {1,"  --compress=none|gzip"},
+#ifdef HAVE_ZLIB
+ {1,"       Write the tag file compressed in frames readtags can search [none]."},
+#else
+ {1,"       Not supported: built without zlib."},
+#endif
+ {1,"  --compress-frame-size=N"},
+ {1,"       Compress the tag file in frames of N bytes or more [1048576]."},
+ {1,"  --deduplicate-inputs=[yes|no]"},
+ {1,"       Parse the files with the same contents and base name once [no]."},
+ {1,"  --deduplicate-tags=[yes|no]"},
+ {1,"       Drop the tag lines written before when the tags are not sorted [no]."},
  {1,"  --etags-include=file"},
  {1,"      Include reference to 'file' in Emacs-style tag file (requires -e)."},
  {1,"  --exclude=pattern"},
@@ -258,18 +335,41 @@ static optionDescription LongOptionDescription [] = {
  {1,"  --file-scope=[yes|no]"},
  {1,"       Should tags scoped only for a single file (e.g. \"static\" tags)"},
  {1,"       be included in the output [yes]?"},
+ {1,"  --file-time-limit=MS"},
+ {1,"       Stop parsing a file MS milliseconds after starting it. 0 for no limit. [0]"},
  {1,"  --filter=[yes|no]"},
  {1,"       Behave as a filter, reading file names from standard input and"},
  {1,"       writing tags to standard output [no]."},
+ {1,"  --filter-batch=N[:MS]"},
+ {1,"       Flush the output of --filter when N bytes are kept, MS milliseconds"},
+ {1,"       passed, or no file name is waiting, instead of after each file. [0:100]"},
  {1,"  --filter-terminator=string"},
  {1,"       Specify string to print to stdout following the tags for each file"},
  {1,"       parsed when --filter is enabled."},
+ {1,"  --filter-terminator-id=[yes|no]"},
+ {1,"       Put the number of the file name read and a tab before the terminator [no]."},
+ {1,"  --fold-index=[yes|no]"},
+ {1,"       Write an index of the tag names ignoring case for readtags to <tagfile>.fidx [no]."},
  {0,"  --format=level"},
 #if DEFAULT_FILE_FORMAT == 1
  {0,"       Force output of specified tag file format [1]."},
 #else
  {0,"       Force output of specified tag file format [2]."},
 #endif
+ {1,"  --generated-input=tag|shallow|skip"},
+ {1,"       Tag generated input files fully, only their top-level declarations,"},
+ {1,"       or not at all [tag]."},
+ {1,"  --generated-input-size=N"},
+ {1,"       Also take input files larger than N bytes for generated. 0 for no limit. [0]"},
+ {1,"  --git-tree=tree-ish"},
+#ifdef HAVE_WORKING_FORK
+ {1,"       Tag the files of the git tree or commit, read from the repository."},
+#else
+ {1,"       Not supported on this platform."},
+#endif
+ {1,"  --guess-cache=[yes|no]"},
+ {1,"       Reuse the language chosen from the contents of an input file for the"},
+ {1,"       files of its directory having its extension or interpreter [no]."},
  {1,"  --guess-language-eagerly"},
  {1,"       Guess the language of input file more eagerly"},
  {1,"       (but taking longer time for guessing):"},
@@ -280,11 +380,22 @@ static optionDescription LongOptionDescription [] = {
  {1,"       Print this option summary."},
  {1,"  --if0=[yes|no]"},
  {1,"       Should code within #if 0 conditional branches be parsed [no]?"},
+ {1,"  --ignore-file=name"},
+ {1,"       Skip the paths listed in files called 'name', read in each directory"},
+ {1,"       while recursing, as .gitignore does."},
 #ifdef HAVE_ICONV
  {1,"  --input-encoding=encoding"},
  {1,"      Specify encoding of all input files."},
  {1,"  --input-encoding-<LANG>=encoding"},
  {1,"      Specify encoding of the LANG input files."},
+#endif
+ {1,"  --input-index=[yes|no]"},
+ {1,"       Write an index of the tags of each input file for readtags to <tagfile>.iidx [no]."},
+ {1,"  --jobs=N"},
+#ifdef HAVE_WORKING_FORK
+ {1,"       Parse input files with N worker processes [1]."},
+#else
+ {1,"       Not supported on this platform."},
 #endif
  {1,"  --kinddef-<LANG>=letter,name,desc"},
  {1,"       Define new kind for <LANG>."},
@@ -350,6 +461,8 @@ static optionDescription LongOptionDescription [] = {
  {1,"       --list-{aliases,extras,features,fields,kind-full,langdef-flags,params," },
  {1,"       pseudo-tags,regex-flags,roles,subparsers} support this option."},
  {1,"       Suitable for scripting. Specify before --list-* option."},
+ {1,"  --manifest=[yes|no]"},
+ {1,"       Skip the files unchanged since the tag file was written [no]."},
  {1,"  --map-<LANG>=[+|-]extension|pattern"},
  {1,"       Set, add(+) or remove(-) the map for <LANG>."},
  {1,"       Unlike --langmap, this doesn't take a list; only one file name pattern"},
@@ -361,27 +474,43 @@ static optionDescription LongOptionDescription [] = {
 #else
  {1,"       Not supported on this platform."},
 #endif
+ {1,"  --memory-limit=MB"},
+ {1,"       Keep the memory in use under MB megabytes: the sort runs, the"},
+ {1,"       duplicate cache and the --jobs window are cut down near it, and"},
+ {1,"       ctags stops past it [0: no limit]."},
+ {1,"  --merge-shards=[yes|no]"},
+ {1,"       Merge the tag files given as arguments into the tag file [no]."},
  {1,"  --mline-regex-<LANG>=/line_pattern/name_pattern/[flags]"},
  {1,"       Define multiline regular expression for locating tags in specific language."},
+ {1,"  --name-filter=[yes|no]"},
+ {1,"       Write a Bloom filter of the tag names for readtags to <tagfile>.bflt [no]."},
+ {1,"  --name-index=[yes|no]"},
+ {1,"       Write an index of the tag names for readtags to <tagfile>.idx [no]."},
+ {1,"  --nul-separated-list=[yes|no]"},
+ {1,"       The names in the file of -L are separated with NUL characters, and"},
+ {1,"       are all file names [no]."},
  {1,"  --options=path"},
  {1,"       Specify file(or directory) from which command line options should be read."},
  {1,"  --options-maybe=path"},
  {1,"       Do the same as --options but this doesn't make an error for non-existing file."},
  {1,"  --optlib-dir=[+]DIR"},
  {1,"      Add or set DIR to optlib search path."},
+ {1,"  --output=<format>:<file>"},
+ {1,"      Also write the tags to <file> in <format>, from the same parse."},
+ {1,"  --output-buffer-size=N"},
+ {1,"      Write the tag file through a buffer of N bytes. 0 for the default of libc. [1048576]"},
 #ifdef HAVE_ICONV
  {1,"  --output-encoding=encoding"},
  {1,"      The encoding to write the tag file in. Defaults to UTF-8 if --input-encoding"},
  {1,"      is specified, otherwise no conversion is performed."},
 #endif
- {0,"  --output-format=u-ctags|e-ctags|etags|xref"
-#ifdef HAVE_JANSSON
-  "|json"
-#endif
- },
+ {0,"  --output-format=u-ctags|e-ctags|etags|xref|json|binary|protobuf"},
  {0,"      Specify the output format. [u-ctags]"},
  {1,"  --param-<LANG>:name=argument"},
  {1,"       Set <LANG> specific parameter. Available parameters can be listed with --list-params."},
+ {1,"  --partition=no|language|directory[:N]"},
+ {1,"       Write the tags of each language, or of the files under each directory N"},
+ {1,"       levels deep, to a tag file of their own. [no]"},
  {0,"  --pattern-length-limit=N"},
  {0,"      Cutoff patterns of tag entries after N characters. Disable by setting to 0. [96]"},
  {0,"  --print-language"},
@@ -404,14 +533,31 @@ static optionDescription LongOptionDescription [] = {
 #endif
  {1,"  --regex-<LANG>=/line_pattern/name_pattern/[flags]"},
  {1,"       Define regular expression for locating tags in specific language."},
+ {1,"  --report-slow=N"},
+ {1,"       Print the N files parsed the most slowly to stderr at the end. [0]"},
+ {1,"  --reread-input=[yes|no]"},
+ {1,"       Read the tagged lines of input files again to make patterns [yes]."},
+ {1,"       With no, tags are located by line numbers, and patterns are not written."},
+ {1,"  --selector-window=N"},
+ {1,"       Read the first N bytes of an input file to tell languages sharing"},
+ {1,"       an extension apart. 0 for the whole file. [65536]"},
  {0,"  --sort=[yes|no|foldcase]"},
  {0,"       Should tags be sorted (optionally ignoring case) [yes]?"},
  {0,"  --tag-relative=[yes|no|always|never]"},
  {0,"       Should paths be relative to location of tag file [no; yes when -e]?"},
  {0,"       always: be relative even if input files are passed in with absolute paths" },
  {0,"       never:  be absolute even if input files are passed in with relative paths" },
- {1,"  --totals=[yes|no]"},
+ {1,"  --totals=[yes|no|extra|json|kinds]"},
  {1,"       Print statistics about input and tag files [no]."},
+ {1,"       extra: also by language and by phase; json: all of them as JSON"},
+ {1,"       kinds: extra, and the bytes of the tags by kind, field and extra"},
+ {1,"  --trace-events=file"},
+ {1,"       Write the spans of reading, guessing, parsing, writing and sorting to file"},
+ {1,"       as Chrome trace events, for chrome://tracing or Perfetto."},
+ {1,"  --trigram-index=[yes|no]"},
+ {1,"       Write an index of the trigrams of the tag names for readtags to <tagfile>.tidx [no]."},
+ {1,"  --update=[yes|no]"},
+ {1,"       Replace the tags of the given (changed or deleted) files in the tag file [no]."},
  {1,"  --verbose=[yes|no]"},
  {1,"       Enable verbose messages describing actions on each input file."},
  {1,"  --version"},
@@ -423,10 +569,17 @@ static optionDescription LongOptionDescription [] = {
  {1,"       Specify before --list-* option."},
  {1,"  --_anonhash=fname"},
  {1,"       Used in u-ctags test harness"},
+ {1,"  --_bench-primitives=[name,...]"},
+ {1,"       Print the nanoseconds an operation of the core primitives, like vString,"},
+ {1,"       the hash table, MIO and keyword lookup, takes, and exit. [all]"},
+ {1,"  --_dump-binary-index=file"},
+ {1,"       Print the tags of a tag file written with --output-format=binary."},
  {1,"  --_dump-keywords"},
  {1,"       Dump keywords of initialized parser(s)."},
  {1,"  --_dump-options"},
  {1,"       Dump options."},
+ {1,"  --_dump-protobuf-stream=file"},
+ {1,"       Print the records of a tag file written with --output-format=protobuf."},
  {1,"  --_echo=msg"},
  {1,"       Echo MSG to standard error. Useful to debug the chain"},
  {1,"       of loading option files."},
@@ -442,13 +595,16 @@ static optionDescription LongOptionDescription [] = {
 #ifdef HAVE_JANSSON
  {0,"  --_interactive"
 #ifdef HAVE_SECCOMP
-  "=[default|sandbox]"
+  "=[default|sandbox][,framed]"
+#else
+  "=[default][,framed]"
 #endif
  },
  {0,"       Enter interactive mode (json over stdio)."},
 #ifdef HAVE_SECCOMP
  {0,"       Enter file I/O limited interactive mode if sandbox is specified. [default]"},
 #endif
+ {0,"       Read length-delimited protobuf requests if framed is specified."},
 #endif
  {1,"  --_list-mtable-regex-flags"},
  {1,"       Output list of flags which can be used in a multitable regex parser definition."},
@@ -456,6 +612,9 @@ static optionDescription LongOptionDescription [] = {
  {1,"       Copy patterns of a regex table to another regex table."},
  {1,"  --_mtable-regex-<LANG>=table/line_pattern/name_pattern/[flags]"},
  {1,"       Define multitable regular expression for locating tags in specific language."},
+ {1,"  --_profile-regex=[text|json]"},
+ {1,"       Print the time regexec takes, the bytes it scans and the matches of"},
+ {1,"       each regex pattern to standard error at exit. [text]"},
  {1,"  --_tabledef-<LANG>=name"},
  {1,"       Define new regex table for <LANG>."},
  {1,"  --_xformat=field_format"},
@@ -496,7 +655,7 @@ static struct Feature {
 	{"regex", "can use regular expression based pattern matching"},
 
 #ifndef EXTERNAL_SORT
-	{"internal-sort", "uses internal sort routine instead of invoking sort command"},
+	{"internal-sort", "uses simple internal sort routine instead of external merge sort"},
 #endif
 #ifdef CUSTOM_CONFIGURATION_FILE
 	{"custom-conf", "read \"" CUSTOM_CONFIGURATION_FILE "\" as config file"},
@@ -516,8 +675,8 @@ static struct Feature {
 #ifdef HAVE_LIBXML
 	{"xpath", "linked with library for parsing xml input"},
 #endif
-#ifdef HAVE_JANSSON
 	{"json", "supports json format output"},
+#ifdef HAVE_JANSSON
 	{"interactive", "accepts source code from stdin"},
 #endif
 #ifdef HAVE_SECCOMP
@@ -526,12 +685,27 @@ static struct Feature {
 #ifdef HAVE_LIBYAML
 	{"yaml", "linked with library for parsing yaml input"},
 #endif
+#ifdef HAVE_PCRE2
+	{"pcre2", "has pcre2 regex engine"},
+#endif
 #ifdef CASE_INSENSITIVE_FILENAMES
 	{"case-insensitive-filenames", "TO BE WRITTEN"},
 #endif
+#ifdef HAVE_WORKING_FORK
+	{"jobs", "can parse input files in parallel worker processes"},
+#endif
 #ifdef ENABLE_GCOV
 	{"gcov", "linked with code for coverage analysis"},
 #endif
+#ifdef ALLOC_PROFILING
+	{"alloc-profiling", "counts the memory allocations of each parser for --totals"},
+#endif
+#ifdef HAVE_ZLIB
+	{"gzip", "reads gzip compressed input files"},
+#endif
+#ifdef HAVE_ZSTD
+	{"zstd", "reads zstd compressed input files"},
+#endif
 #ifdef HAVE_ASPELL
 	{"aspell", "linked with code for spell checking (internal use)"},
 #endif
@@ -708,6 +882,201 @@ extern void checkOptions (void)
 		notice = "append mode is not compatible with";
 		if (isDestinationStdout ())
 			error (FATAL, "%s tags to stdout", notice);
+		if (getTagWriterType () == WRITER_BINARY
+			|| getTagWriterType () == WRITER_PROTOBUF)
+			error (FATAL, "%s the output format", notice);
+	}
+	/* --sort given after --output-format=binary or protobuf */
+	if (getTagWriterType () == WRITER_BINARY
+		|| getTagWriterType () == WRITER_PROTOBUF)
+		Option.sorted = SO_UNSORTED;
+	if (Option.update || Option.manifest)
+	{
+		notice = Option.update
+			? "update mode is not compatible with"
+			: "manifest is not compatible with";
+#ifndef EXTERNAL_SORT
+		error (FATAL, "%s the internal sort", notice);
+#endif
+		if (isDestinationStdout ())
+			error (FATAL, "%s tags to stdout", notice);
+		if (getTagWriterType () != WRITER_U_CTAGS
+			&& getTagWriterType () != WRITER_E_CTAGS)
+			error (FATAL, "%s the output format", notice);
+	}
+	if (Option.nameIndex)
+	{
+		notice = "name index is not compatible with";
+		if (isDestinationStdout ())
+			error (FATAL, "%s tags to stdout", notice);
+		if (getTagWriterType () != WRITER_U_CTAGS
+			&& getTagWriterType () != WRITER_E_CTAGS)
+			error (FATAL, "%s the output format", notice);
+		if (Option.sorted == SO_UNSORTED)
+			error (FATAL, "%s unsorted tags", notice);
+	}
+	if (Option.foldIndex)
+	{
+		notice = "fold index is not compatible with";
+		if (isDestinationStdout ())
+			error (FATAL, "%s tags to stdout", notice);
+		if (getTagWriterType () != WRITER_U_CTAGS
+			&& getTagWriterType () != WRITER_E_CTAGS)
+			error (FATAL, "%s the output format", notice);
+		if (Option.sorted != SO_SORTED)
+			error (FATAL, "%s tags not sorted with --sort=yes", notice);
+	}
+	if (Option.inputIndex)
+	{
+		notice = "input index is not compatible with";
+		if (isDestinationStdout ())
+			error (FATAL, "%s tags to stdout", notice);
+		if (getTagWriterType () != WRITER_U_CTAGS
+			&& getTagWriterType () != WRITER_E_CTAGS)
+			error (FATAL, "%s the output format", notice);
+	}
+	if (Option.deduplicateTags
+		&& (getTagWriterType () == WRITER_ETAGS
+			|| getTagWriterType () == WRITER_BINARY
+			|| getTagWriterType () == WRITER_PROTOBUF))
+		error (FATAL, "tag deduplication is not compatible with the output format");
+	if (Option.nameFilter)
+	{
+		notice = "name filter is not compatible with";
+		if (isDestinationStdout ())
+			error (FATAL, "%s tags to stdout", notice);
+		if (getTagWriterType () != WRITER_U_CTAGS
+			&& getTagWriterType () != WRITER_E_CTAGS)
+			error (FATAL, "%s the output format", notice);
+	}
+	if (Option.trigramIndex)
+	{
+		notice = "trigram index is not compatible with";
+		if (isDestinationStdout ())
+			error (FATAL, "%s tags to stdout", notice);
+		if (getTagWriterType () != WRITER_U_CTAGS
+			&& getTagWriterType () != WRITER_E_CTAGS)
+			error (FATAL, "%s the output format", notice);
+	}
+	if (Option.compress != COMPRESS_NONE)
+	{
+		notice = "--compress is not compatible with";
+		if (isDestinationStdout ())
+			error (FATAL, "%s tags to stdout", notice);
+		if (Option.append)
+			error (FATAL, "%s append mode", notice);
+		if (Option.update)
+			error (FATAL, "%s update mode", notice);
+		if (Option.manifest)
+			error (FATAL, "%s the manifest", notice);
+	}
+	if (Option.mergeShards)
+	{
+		notice = "--merge-shards is not compatible with";
+#ifndef EXTERNAL_SORT
+		error (FATAL, "%s the internal sort", notice);
+#endif
+		if (getTagWriterType () != WRITER_U_CTAGS
+			&& getTagWriterType () != WRITER_E_CTAGS)
+			error (FATAL, "%s the output format", notice);
+		if (Option.sorted == SO_UNSORTED)
+			error (FATAL, "%s unsorted tags", notice);
+		if (Option.append)
+			error (FATAL, "%s append mode", notice);
+		if (Option.update)
+			error (FATAL, "%s update mode", notice);
+		if (Option.manifest)
+			error (FATAL, "%s the manifest", notice);
+		if (Option.filter)
+			error (FATAL, "%s filter mode", notice);
+		if (Option.fileList != NULL || Option.gitTree != NULL || Option.recurse)
+			error (FATAL, "%s input files", notice);
+	}
+	if (Option.outputs)
+	{
+		unsigned int i, j;
+
+		notice = "--output is not compatible with";
+#ifndef EXTERNAL_SORT
+		error (FATAL, "%s the internal sort", notice);
+#endif
+		if (Option.append)
+			error (FATAL, "%s append mode", notice);
+		if (Option.update)
+			error (FATAL, "%s update mode", notice);
+		if (Option.manifest)
+			error (FATAL, "%s the manifest", notice);
+		if (Option.mergeShards)
+			error (FATAL, "%s --merge-shards", notice);
+		if (Option.filter)
+			error (FATAL, "%s filter mode", notice);
+		if (Option.interactive)
+			error (FATAL, "%s interactive mode", notice);
+		for (i = 0; i < stringListCount (Option.outputs); i++)
+		{
+			const char *const spec = vStringValue (stringListItem (Option.outputs, i));
+			const writerType wtype = getNamedTagWriterType (spec, strchr (spec, ':') - spec);
+
+			/* A writer keeps the state of the input file it writes. */
+			if (wtype == getTagWriterType ())
+				error (FATAL, "%s the output format of the tag file: %s", notice, spec);
+			for (j = 0; j < i; j++)
+			{
+				const char *const other = vStringValue (stringListItem (Option.outputs, j));
+
+				if (getNamedTagWriterType (other, strchr (other, ':') - other) == wtype)
+					error (FATAL, "%s another with the same output format: %s", notice, spec);
+			}
+			if (!Option.rereadInput
+				&& (wtype == WRITER_ETAGS
+					|| (wtype == WRITER_XREF && Option.customXfmt == NULL)))
+				error (FATAL, "--reread-input=no is not compatible with the output format: %s", spec);
+		}
+	}
+	if (Option.partition != PARTITION_NONE)
+	{
+		notice = "--partition is not compatible with";
+#ifndef EXTERNAL_SORT
+		error (FATAL, "%s the internal sort", notice);
+#endif
+		if (isDestinationStdout ())
+			error (FATAL, "%s tags to stdout", notice);
+		if (getTagWriterType () != WRITER_U_CTAGS
+			&& getTagWriterType () != WRITER_E_CTAGS)
+			error (FATAL, "%s the output format", notice);
+		if (Option.append)
+			error (FATAL, "%s append mode", notice);
+		if (Option.update)
+			error (FATAL, "%s update mode", notice);
+		if (Option.manifest)
+			error (FATAL, "%s the manifest", notice);
+		if (Option.mergeShards)
+			error (FATAL, "%s --merge-shards", notice);
+		if (Option.filter)
+			error (FATAL, "%s filter mode", notice);
+		if (Option.outputs)
+			error (FATAL, "%s --output", notice);
+		if (Option.compress != COMPRESS_NONE)
+			error (FATAL, "%s --compress", notice);
+		if (Option.nameIndex || Option.foldIndex || Option.inputIndex
+			|| Option.nameFilter || Option.trigramIndex)
+			error (FATAL, "%s the indexes of the tag file", notice);
+		/* They are written once, to the tag file of the first input
+		   file a parser tags. */
+		if (isPtagEnabled (PTAG_KIND_DESCRIPTION) || isPtagEnabled (PTAG_KIND_SEPARATOR))
+			error (FATAL, "%s pseudo tags for parsers", notice);
+	}
+	if (!Option.rereadInput)
+	{
+		notice = "--reread-input=no is not compatible with";
+		if (getTagWriterType () == WRITER_ETAGS
+			|| getTagWriterType () == WRITER_BINARY
+			|| (getTagWriterType () == WRITER_XREF && Option.customXfmt == NULL))
+			error (FATAL, "%s the output format", notice);
+		if (isFieldEnabled (FIELD_COMPACT_INPUT_LINE))
+			error (FATAL, "%s the \"%s\" field",
+				   notice, getFieldName (FIELD_COMPACT_INPUT_LINE));
+		Option.locate = EX_LINENUM;
 	}
 	if (Option.filter)
 	{
@@ -715,10 +1084,13 @@ extern void checkOptions (void)
 		if (Option.printTotals)
 		{
 			error (WARNING, "%s disables totals", notice);
-			Option.printTotals = false;
+			Option.printTotals = TOTALS_NO;
 		}
 		if (Option.tagFileName != NULL)
 			error (WARNING, "%s ignores output tag file name", notice);
+		if (getTagWriterType () == WRITER_BINARY
+			|| getTagWriterType () == WRITER_PROTOBUF)
+			error (FATAL, "%s is not compatible with the output format", notice);
 	}
 }
 
@@ -787,14 +1159,26 @@ static void setXrefMode (void)
 	setTagWriter (WRITER_XREF);
 }
 
-#ifdef HAVE_JANSSON
 static void setJsonMode (void)
 {
 	enablePtag (PTAG_JSON_OUTPUT_VERSION, true);
 	enablePtag (PTAG_OUTPUT_MODE, false);
 	setTagWriter (WRITER_JSON);
 }
-#endif
+
+/* The binary index has its own sorted name index. */
+static void setBinaryMode (void)
+{
+	Option.sorted = SO_UNSORTED;
+	setTagWriter (WRITER_BINARY);
+}
+
+/* A stream of records cannot be sorted either. */
+static void setProtobufMode (void)
+{
+	Option.sorted = SO_UNSORTED;
+	setTagWriter (WRITER_PROTOBUF);
+}
 
 /*
  *  Cooked argument parsing
@@ -1088,10 +1472,78 @@ static void processEtagsInclude (
 	}
 }
 
+static void freeExcludedIndex (void)
+{
+	if (ExcludedNames)
+		hashTableDelete (ExcludedNames);
+	if (ExcludedSuffixes)
+		hashTableDelete (ExcludedSuffixes);
+	if (ExcludedPatterns)
+		ptrArrayDelete (ExcludedPatterns);
+	ExcludedNames = NULL;
+	ExcludedSuffixes = NULL;
+	ExcludedPatterns = NULL;
+	ExcludedSuffixMaxLength = 0;
+	ExcludedIndexDirty = true;
+}
+
+static hashTable* newExcludedSet (void)
+{
+#ifdef CASE_INSENSITIVE_FILENAMES
+	return hashTableNew (127, hashCstrcasehash, hashCstrcaseeq, eFree, NULL);
+#else
+	return hashTableNew (127, hashCstrhash, hashCstreq, eFree, NULL);
+#endif
+}
+
+static void addToExcludedSet (hashTable *set, const char *const string)
+{
+	char *key;
+
+	if (hashTableHasItem (set, string))
+		return;
+	key = eStrdup (string);
+	hashTablePutItem (set, key, key);
+}
+
+static void prepareExcludedIndex (void)
+{
+	unsigned int i;
+
+	if (! ExcludedIndexDirty)
+		return;
+
+	freeExcludedIndex ();
+	ExcludedNames = newExcludedSet ();
+	ExcludedSuffixes = newExcludedSet ();
+	ExcludedPatterns = ptrArrayNew (NULL);
+
+	for (i = 0; i < stringListCount (Excluded); i++)
+	{
+		vString *const item = stringListItem (Excluded, i);
+		const char *const pattern = vStringValue (item);
+
+		if (isFileNamePatternLiteral (pattern))
+			addToExcludedSet (ExcludedNames, pattern);
+		else if (pattern [0] == '*' && pattern [1] != '\0'
+				 && isFileNamePatternLiteral (pattern + 1))
+		{
+			addToExcludedSet (ExcludedSuffixes, pattern + 1);
+			if (vStringLength (item) - 1 > ExcludedSuffixMaxLength)
+				ExcludedSuffixMaxLength = vStringLength (item) - 1;
+		}
+		else
+			ptrArrayAdd (ExcludedPatterns, item);
+	}
+	ExcludedIndexDirty = false;
+}
+
 static void processExcludeOption (
 		const char *const option CTAGS_ATTR_UNUSED, const char *const parameter)
 {
 	const char *const fileName = parameter + 1;
+
+	ExcludedIndexDirty = true;
 	if (parameter [0] == '\0')
 		freeList (&Excluded);
 	else if (parameter [0] == '@')
@@ -1115,19 +1567,47 @@ static void processExcludeOption (
 	}
 }
 
+static bool isExcludedName (const char* const name)
+{
+	const size_t length = strlen (name);
+	size_t l;
+
+	if (hashTableHasItem (ExcludedNames, name))
+		return true;
+	for (l = 1; l <= ExcludedSuffixMaxLength && l <= length; l++)
+		if (hashTableHasItem (ExcludedSuffixes, name + length - l))
+			return true;
+	return stringListFileMatched (ExcludedPatterns, name);
+}
+
 extern bool isExcludedFile (const char* const name)
 {
 	const char* base = baseFilename (name);
 	bool result = false;
 	if (Excluded != NULL)
 	{
-		result = stringListFileMatched (Excluded, base);
+		prepareExcludedIndex ();
+		result = isExcludedName (base);
 		if (! result  &&  name != base)
-			result = stringListFileMatched (Excluded, name);
+			result = isExcludedName (name);
 	}
 	return result;
 }
 
+static void processIgnoreFileOption (
+		const char *const option CTAGS_ATTR_UNUSED, const char *const parameter)
+{
+	if (parameter [0] == '\0')
+		freeList (&Option.ignoreFileNames);
+	else
+	{
+		if (Option.ignoreFileNames == NULL)
+			Option.ignoreFileNames = stringListNew ();
+		stringListAdd (Option.ignoreFileNames, vStringNewInit (parameter));
+		verbose ("    adding ignore file name: %s\n", parameter);
+	}
+}
+
 static void processExcmdOption (
 		const char *const option, const char *const parameter)
 {
@@ -1235,8 +1715,11 @@ static void resetFieldsOption (langType lang, bool mode)
 {
 	int i;
 
+	/* The fixed fields are left out: the JSON writer, which allows
+	   disabling them, used to have them with any --fields. */
 	for (i = 0; i < countFields (); ++i)
-		if ((lang == LANG_AUTO) || (lang == getFieldOwner (i)))
+		if (((lang == LANG_AUTO) || (lang == getFieldOwner (i)))
+			&& ! isFieldFixed (i))
 			enableField (i, mode, false);
 }
 
@@ -1317,6 +1800,24 @@ static void processFieldsOption (
 	}
 }
 
+static void processFilterBatchOption (
+		const char *const option, const char *const parameter)
+{
+	const char *colon;
+	char *size;
+
+	if (parameter == NULL || parameter[0] == '\0')
+		error (FATAL, "A parameter is needed after \"%s\" option", option);
+
+	colon = strchr (parameter, ':');
+	size = colon? eStrndup (parameter, colon - parameter): eStrdup (parameter);
+	if (!strToUInt (size, 0, &Option.filterBatchSize))
+		error (FATAL, "-%s: Invalid batch size \"%s\"", option, parameter);
+	eFree (size);
+	if (colon && !strToUInt (colon + 1, 0, &Option.filterBatchTime))
+		error (FATAL, "-%s: Invalid batch time \"%s\"", option, parameter);
+}
+
 static void processFilterTerminatorOption (
 		const char *const option CTAGS_ATTR_UNUSED, const char *const parameter)
 {
@@ -1497,26 +1998,32 @@ static void processInteractiveOption (
 		const char *const parameter)
 {
 	static struct interactiveModeArgs args;
+	const char *p = parameter? parameter: "";
 
+	Option.interactive = INTERACTIVE_DEFAULT;
+	args.sandbox = false;
+	args.framed = false;
 
-	if (parameter && (strcmp (parameter, "sandbox") == 0))
-	{
-		Option.interactive = INTERACTIVE_SANDBOX;
-		args.sandbox = true;
-	}
-	else if (parameter && (strcmp (parameter, "default") == 0))
-	{
-		Option.interactive = INTERACTIVE_DEFAULT;
-		args.sandbox = false;
-	}
-	else if ((!parameter) || *parameter == '\0')
+	/* The submodes are given as a comma separated list. */
+	while (*p != '\0')
 	{
-		Option.interactive = INTERACTIVE_DEFAULT;
-		args.sandbox = false;
+		const char *const comma = strchr (p, ',');
+		const size_t length = comma? (size_t) (comma - p): strlen (p);
+
+		if (length == strlen ("sandbox") && strncmp (p, "sandbox", length) == 0)
+		{
+			Option.interactive = INTERACTIVE_SANDBOX;
+			args.sandbox = true;
+		}
+		else if (length == strlen ("framed") && strncmp (p, "framed", length) == 0)
+			args.framed = true;
+		else if (! (length == strlen ("default") && strncmp (p, "default", length) == 0))
+			error (FATAL, "Unknown option argument \"%s\" for --%s option",
+				   parameter, option);
+		p += length;
+		if (*p == ',')
+			p++;
 	}
-	else
-		error (FATAL, "Unknown option argument \"%s\" for --%s option",
-			   parameter, option);
 
 #ifndef HAVE_SECCOMP
 	if (args.sandbox)
@@ -1531,13 +2038,46 @@ static void processInteractiveOption (
 	Option.sorted = SO_UNSORTED;
 	setMainLoop (interactiveLoop, &args);
 	setErrorPrinter (jsonErrorPrinter, NULL);
-	setTagWriter (WRITER_JSON);
-	enablePtag (PTAG_JSON_OUTPUT_VERSION, true);
+	/* With --output-format=protobuf, the responses are records of the
+	   stream of tags. Framed requests are answered so. */
+	if (args.framed)
+		setProtobufMode ();
+	else if (getTagWriterType () != WRITER_PROTOBUF)
+	{
+		setTagWriter (WRITER_JSON);
+		enablePtag (PTAG_JSON_OUTPUT_VERSION, true);
+	}
 
 	json_set_alloc_funcs (eMalloc, eFree);
 }
 #endif
 
+static void processTotalsOption (const char *const option,
+								 const char *const parameter)
+{
+	if (parameter != NULL && strcmp (parameter, "extra") == 0)
+		Option.printTotals = TOTALS_EXTRA;
+	else if (parameter != NULL && strcmp (parameter, "json") == 0)
+		Option.printTotals = TOTALS_JSON;
+	else if (parameter != NULL && strcmp (parameter, "kinds") == 0)
+		Option.printTotals = TOTALS_KINDS;
+	else
+		Option.printTotals = getBooleanOption (option, parameter)? TOTALS_YES: TOTALS_NO;
+}
+
+static void processProfileRegexOption (const char *const option,
+									   const char *const parameter)
+{
+	if (parameter == NULL || parameter [0] == '\0'
+		|| strcmp (parameter, "text") == 0)
+		Option.profileRegex = REGEX_PROFILE_TEXT;
+	else if (strcmp (parameter, "json") == 0)
+		Option.profileRegex = REGEX_PROFILE_JSON;
+	else
+		error (FATAL, "Unknown option argument \"%s\" for --%s option",
+			   parameter, option);
+}
+
 static void processIf0Option (const char *const option,
 							  const char *const parameter)
 {
@@ -2240,14 +2780,45 @@ static void processOutputFormat (const char *const option CTAGS_ATTR_UNUSED,
 		setEtagsMode ();
 	else if (strcmp (parameter, "xref") == 0)
 		setXrefMode ();
-#ifdef HAVE_JANSSON
 	else if (strcmp (parameter, "json") == 0)
 		setJsonMode ();
-#endif
+	else if (strcmp (parameter, "binary") == 0)
+		setBinaryMode ();
+	else if (strcmp (parameter, "protobuf") == 0)
+		setProtobufMode ();
 	else
 		error (FATAL, "unknown output format name supplied for \"%s=%s\"", option, parameter);
 }
 
+/*  --output=FORMAT:FILE adds a tag file written from the same tags as
+ *  the one of -o. An empty parameter forgets those given before.
+ */
+static void processOutputOption (const char *const option,
+				 const char *const parameter)
+{
+	const char *const colon = strchr (parameter, ':');
+	writerType wtype;
+
+	if (parameter [0] == '\0')
+	{
+		freeList (&Option.outputs);
+		return;
+	}
+	if (colon == NULL || colon [1] == '\0')
+		error (FATAL, "no file name supplied for \"%s=%s\"", option, parameter);
+
+	wtype = getNamedTagWriterType (parameter, colon - parameter);
+	if (wtype == WRITER_COUNT)
+		error (FATAL, "unknown output format name supplied for \"%s=%s\"", option, parameter);
+	/* They write the tag file from entries kept until its end. */
+	if (wtype == WRITER_BINARY || wtype == WRITER_PROTOBUF)
+		error (FATAL, "unsupported output format for \"%s=%s\"", option, parameter);
+
+	if (Option.outputs == NULL)
+		Option.outputs = stringListNew ();
+	stringListAdd (Option.outputs, vStringNewInit (parameter));
+}
+
 static void processPseudoTags (const char *const option CTAGS_ATTR_UNUSED,
 			       const char *const parameter)
 {
@@ -2428,6 +2999,28 @@ static void processAnonHashOption (const char *const option CTAGS_ATTR_UNUSED, c
 	exit (0);
 }
 
+static void processDumpBinaryIndexOption (const char *const option, const char *const parameter)
+{
+	if (parameter == NULL || parameter[0] == '\0')
+		error (FATAL, "A file name is needed for \"%s\" option", option);
+	dumpBinaryIndex (parameter, stdout);
+	exit (0);
+}
+
+static void processDumpProtobufStreamOption (const char *const option, const char *const parameter)
+{
+	if (parameter == NULL || parameter[0] == '\0')
+		error (FATAL, "A file name is needed for \"%s\" option", option);
+	dumpProtobufStream (parameter, stdout);
+	exit (0);
+}
+
+static void processBenchPrimitivesOption (const char *const option CTAGS_ATTR_UNUSED, const char *const parameter)
+{
+	runMicroBenchmarks (parameter, stdout);
+	exit (0);
+}
+
 static void processDumpKeywordsOption (const char *const option CTAGS_ATTR_UNUSED, const char *const parameter CTAGS_ATTR_UNUSED)
 {
 	dumpKeywordTable (stdout);
@@ -2528,6 +3121,182 @@ static void processMaxRecursionDepthOption (const char *const option, const char
 	Option.maxRecursionDepth = atol(parameter);
 }
 
+static void processJobsOption (const char *const option, const char *const parameter)
+{
+	if (parameter == NULL || parameter[0] == '\0')
+		error (FATAL, "A parameter is needed after \"%s\" option", option);
+
+	if (!strToUInt (parameter, 0, &Option.jobs) || Option.jobs < 1)
+		error (FATAL, "%s%s: Invalid number of jobs",
+			   option [1] == '\0'? "-": "--", option);
+
+#ifndef HAVE_WORKING_FORK
+	if (Option.jobs > 1)
+		error (WARNING, "-%s option not supported on this host", option);
+#endif
+}
+
+static void processCacheDirOption (const char *const option, const char *const parameter)
+{
+	freeString (&Option.cacheDir);
+	if (parameter == NULL || parameter[0] == '\0')
+		verbose ("-%s: tag cache disabled\n", option);
+	else
+		Option.cacheDir = stringCopy (parameter);
+}
+
+static void processCacheRemoteOption (const char *const option, const char *const parameter)
+{
+	freeString (&Option.cacheRemote);
+	if (parameter == NULL || parameter[0] == '\0')
+		verbose ("-%s: remote tag cache disabled\n", option);
+	else
+	{
+#ifndef HAVE_WORKING_FORK
+		error (WARNING, "--%s is not supported on this platform", option);
+#endif
+		Option.cacheRemote = stringCopy (parameter);
+	}
+}
+
+static void processGitTreeOption (const char *const option, const char *const parameter)
+{
+	if (parameter == NULL || parameter[0] == '\0')
+		error (FATAL, "A parameter is needed after \"%s\" option", option);
+	if (parameter[0] == '-')
+		error (FATAL, "-%s: Invalid tree \"%s\"", option, parameter);
+
+	freeString (&Option.gitTree);
+	Option.gitTree = stringCopy (parameter);
+}
+
+static void processOutputBufferSize (const char *const option, const char *const parameter)
+{
+	if (parameter == NULL || parameter[0] == '\0')
+		error (FATAL, "A parameter is needed after \"%s\" option", option);
+
+	if (!strToUInt (parameter, 0, &Option.outputBufferSize))
+		error (FATAL, "-%s: Invalid buffer size", option);
+}
+
+static void processCompressOption (const char *const option, const char *const parameter)
+{
+	if (parameter == NULL || parameter[0] == '\0' || strcmp (parameter, "none") == 0)
+		Option.compress = COMPRESS_NONE;
+	else if (strcmp (parameter, "gzip") == 0)
+	{
+#ifndef HAVE_ZLIB
+		error (FATAL, "-%s: gzip is not supported: built without zlib", option);
+#endif
+		Option.compress = COMPRESS_GZIP;
+	}
+	else
+		error (FATAL, "-%s: Invalid compression \"%s\"", option, parameter);
+}
+
+static void processCompressFrameSizeOption (const char *const option, const char *const parameter)
+{
+	if (parameter == NULL || parameter[0] == '\0')
+		error (FATAL, "A parameter is needed after \"%s\" option", option);
+
+	if (!strToUInt (parameter, 0, &Option.compressFrameSize)
+		|| Option.compressFrameSize == 0)
+		error (FATAL, "-%s: Invalid frame size", option);
+}
+
+static void processReportSlowOption (const char *const option, const char *const parameter)
+{
+	if (parameter == NULL || parameter[0] == '\0')
+		error (FATAL, "A parameter is needed after \"%s\" option", option);
+
+	if (!strToUInt (parameter, 0, &Option.reportSlow))
+		error (FATAL, "-%s: Invalid number of files", option);
+}
+
+static void processSelectorWindowOption (const char *const option, const char *const parameter)
+{
+	if (parameter == NULL || parameter[0] == '\0')
+		error (FATAL, "A parameter is needed after \"%s\" option", option);
+
+	if (!strToUInt (parameter, 0, &Option.selectorWindow))
+		error (FATAL, "-%s: Invalid size", option);
+}
+
+static void processFileTimeLimitOption (const char *const option, const char *const parameter)
+{
+	if (parameter == NULL || parameter[0] == '\0')
+		error (FATAL, "A parameter is needed after \"%s\" option", option);
+
+	if (!strToUInt (parameter, 0, &Option.fileTimeLimit))
+		error (FATAL, "-%s: Invalid time limit", option);
+}
+
+static void processMemoryLimitOption (const char *const option, const char *const parameter)
+{
+	if (parameter == NULL || parameter[0] == '\0')
+		error (FATAL, "A parameter is needed after \"%s\" option", option);
+
+	if (!strToUInt (parameter, 0, &Option.memoryLimit))
+		error (FATAL, "-%s: Invalid memory limit", option);
+	if (!setMemoryLimit ((size_t) Option.memoryLimit << 20))
+		error (WARNING, "--%s is not supported on this platform", option);
+}
+
+static void processGeneratedInputOption (const char *const option, const char *const parameter)
+{
+	if (parameter == NULL || parameter[0] == '\0' || strcmp (parameter, "tag") == 0)
+		Option.generatedInput = GENERATED_INPUT_TAG;
+	else if (strcmp (parameter, "shallow") == 0)
+		Option.generatedInput = GENERATED_INPUT_SHALLOW;
+	else if (strcmp (parameter, "skip") == 0)
+		Option.generatedInput = GENERATED_INPUT_SKIP;
+	else
+		error (FATAL, "-%s: Invalid handling of generated input \"%s\"", option, parameter);
+}
+
+static void processGeneratedInputSizeOption (const char *const option, const char *const parameter)
+{
+	if (parameter == NULL || parameter[0] == '\0')
+		error (FATAL, "A parameter is needed after \"%s\" option", option);
+
+	if (!strToUInt (parameter, 0, &Option.generatedInputSize))
+		error (FATAL, "-%s: Invalid size", option);
+}
+
+static void processPartitionOption (const char *const option, const char *const parameter)
+{
+	static const char directory [] = "directory";
+	const size_t length = strlen (directory);
+
+	if (parameter == NULL || parameter[0] == '\0' || strcmp (parameter, "no") == 0)
+		Option.partition = PARTITION_NONE;
+	else if (strcmp (parameter, "language") == 0)
+		Option.partition = PARTITION_LANGUAGE;
+	else if (strncmp (parameter, directory, length) == 0
+			 && (parameter [length] == '\0' || parameter [length] == ':'))
+	{
+		Option.partition = PARTITION_DIRECTORY;
+		Option.partitionDepth = 1;
+		if (parameter [length] == ':'
+			&& (!strToUInt (parameter + length + 1, 0, &Option.partitionDepth)
+				|| Option.partitionDepth == 0))
+			error (FATAL, "-%s: Invalid depth of directories \"%s\"", option, parameter);
+		/* As a run in the directory would name the files in the tags. */
+		Option.tagRelative = TREL_YES;
+	}
+	else
+		error (FATAL, "-%s: Invalid partition \"%s\"", option, parameter);
+}
+
+static void processTraceEventsOption (const char *const option, const char *const parameter)
+{
+	if (parameter == NULL || parameter[0] == '\0')
+		error (FATAL, "A parameter is needed after \"%s\" option", option);
+
+	freeString (&Option.traceEvents);
+	Option.traceEvents = eStrdup (parameter);
+}
+
 static void processPatternLengthLimit(const char *const option, const char *const parameter)
 {
 	if (parameter == NULL || parameter[0] == '\0')
@@ -2555,20 +3324,31 @@ static bool* redirectToXtag(booleanOption *const option)
 static void processDumpOptionsOption (const char *const option, const char *const parameter);
 
 static parametricOption ParametricOptions [] = {
+	{ "cache-dir",              processCacheDirOption,          true,   STAGE_ANY },
+	{ "cache-remote",           processCacheRemoteOption,       true,   STAGE_ANY },
+	{ "compress",               processCompressOption,          true,   STAGE_ANY },
+	{ "compress-frame-size",    processCompressFrameSizeOption, true,   STAGE_ANY },
 	{ "etags-include",          processEtagsInclude,            false,  STAGE_ANY },
 	{ "exclude",                processExcludeOption,           false,  STAGE_ANY },
 	{ "excmd",                  processExcmdOption,             false,  STAGE_ANY },
 	{ "extra",                  processExtraTagsOption,         false,  STAGE_ANY },
 	{ "extras",                 processExtraTagsOption,         false,  STAGE_ANY },
 	{ "fields",                 processFieldsOption,            false,  STAGE_ANY },
+	{ "filter-batch",           processFilterBatchOption,       true,   STAGE_ANY },
 	{ "filter-terminator",      processFilterTerminatorOption,  true,   STAGE_ANY },
 	{ "format",                 processFormatOption,            true,   STAGE_ANY },
 	{ "help",                   processHelpOption,              true,   STAGE_ANY },
+	{ "file-time-limit",        processFileTimeLimitOption,     true,   STAGE_ANY },
+	{ "generated-input",        processGeneratedInputOption,    true,   STAGE_ANY },
+	{ "generated-input-size",   processGeneratedInputSizeOption, true,  STAGE_ANY },
+	{ "git-tree",               processGitTreeOption,           true,   STAGE_ANY },
 	{ "if0",                    processIf0Option,               false,  STAGE_ANY },
+	{ "ignore-file",            processIgnoreFileOption,        false,  STAGE_ANY },
 #ifdef HAVE_ICONV
 	{ "input-encoding",         processInputEncodingOption,     false,  STAGE_ANY },
 	{ "output-encoding",        processOutputEncodingOption,    false,  STAGE_ANY },
 #endif
+	{ "jobs",                   processJobsOption,              true,   STAGE_ANY },
 	{ "lang",                   processLanguageForceOption,     false,  STAGE_ANY },
 	{ "language",               processLanguageForceOption,     false,  STAGE_ANY },
 	{ "language-force",         processLanguageForceOption,     false,  STAGE_ANY },
@@ -2594,18 +3374,29 @@ static parametricOption ParametricOptions [] = {
 	{ "list-roles",             processListRolesOptions,        true,   STAGE_ANY },
 	{ "list-subparsers",        processListSubparsersOptions,   true,   STAGE_ANY },
 	{ "maxdepth",               processMaxRecursionDepthOption, true,   STAGE_ANY },
+	{ "memory-limit",           processMemoryLimitOption,       true,   STAGE_ANY },
 	{ "optlib-dir",             processOptlibDir,               false,  STAGE_ANY },
 	{ "options",                processOptionFile,              false,  STAGE_ANY },
 	{ "options-maybe",          processOptionFileMaybe,         false,  STAGE_ANY },
+	{ "output",                 processOutputOption,            true,   STAGE_ANY },
+	{ "output-buffer-size",     processOutputBufferSize,        true,   STAGE_ANY },
 	{ "output-format",          processOutputFormat,            true,   STAGE_ANY },
+	{ "partition",              processPartitionOption,         true,   STAGE_ANY },
 	{ "pattern-length-limit",   processPatternLengthLimit,      true,   STAGE_ANY },
 	{ "pseudo-tags",            processPseudoTags,              false,  STAGE_ANY },
+	{ "report-slow",            processReportSlowOption,        true,   STAGE_ANY },
+	{ "selector-window",        processSelectorWindowOption,    true,   STAGE_ANY },
 	{ "sort",                   processSortOption,              true,   STAGE_ANY },
 	{ "tag-relative",           processTagRelative,             true,   STAGE_ANY },
+	{ "totals",                 processTotalsOption,            true,   STAGE_ANY },
+	{ "trace-events",           processTraceEventsOption,       true,   STAGE_ANY },
 	{ "version",                processVersionOption,           true,   STAGE_ANY },
 	{ "_anonhash",              processAnonHashOption,          false,  STAGE_ANY },
+	{ "_bench-primitives",      processBenchPrimitivesOption,   false,  STAGE_ANY },
+	{ "_dump-binary-index",     processDumpBinaryIndexOption,   true,   STAGE_ANY },
 	{ "_dump-keywords",         processDumpKeywordsOption,      false,  STAGE_ANY },
 	{ "_dump-options",          processDumpOptionsOption,       false,  STAGE_ANY },
+	{ "_dump-protobuf-stream",  processDumpProtobufStreamOption, true,  STAGE_ANY },
 	{ "_echo",                  processEchoOption,              false,  STAGE_ANY },
 	{ "_force-initializing",    processForceInitOption,         false, STAGE_ANY },
 	{ "_force-quit",            processForceQuitOption,         false,  STAGE_ANY },
@@ -2613,17 +3404,30 @@ static parametricOption ParametricOptions [] = {
 	{ "_interactive",           processInteractiveOption,       true,   STAGE_ANY },
 #endif
 	{ "_list-mtable-regex-flags", processListMultitableRegexFlagsOptions, true, STAGE_ANY },
+	{ "_profile-regex",         processProfileRegexOption,      true,   STAGE_ANY },
 	{ "_xformat",               processXformatOption,           false,  STAGE_ANY },
 };
 
 static booleanOption BooleanOptions [] = {
 	{ "append",         &Option.append,                 true,  STAGE_ANY },
+	{ "atomic-output",  &Option.atomicOutput,           true,  STAGE_ANY },
+	{ "deduplicate-inputs", &Option.deduplicateInputs, true, STAGE_ANY },
+	{ "deduplicate-tags", &Option.deduplicateTags,     true, STAGE_ANY },
 	{ "file-scope",     ((bool *)XTAG_FILE_SCOPE),   false, STAGE_ANY, redirectToXtag },
 	{ "file-tags",      ((bool *)XTAG_FILE_NAMES),   false, STAGE_ANY, redirectToXtag },
 	{ "filter",         &Option.filter,                 true,  STAGE_ANY },
+	{ "filter-terminator-id", &Option.filterTerminatorId, true, STAGE_ANY },
+	{ "fold-index",     &Option.foldIndex,              true,  STAGE_ANY },
+	{ "guess-cache",    &Option.guessCache,             false, STAGE_ANY },
 	{ "guess-language-eagerly", &Option.guessLanguageEagerly, false, STAGE_ANY },
+	{ "input-index",    &Option.inputIndex,             true,  STAGE_ANY },
 	{ "line-directives",&Option.lineDirectives,         false, STAGE_ANY },
 	{ "links",          &Option.followLinks,            false, STAGE_ANY },
+	{ "manifest",       &Option.manifest,               true,  STAGE_ANY },
+	{ "merge-shards",   &Option.mergeShards,            true,  STAGE_ANY },
+	{ "name-filter",    &Option.nameFilter,             true,  STAGE_ANY },
+	{ "name-index",     &Option.nameIndex,              true,  STAGE_ANY },
+	{ "nul-separated-list", &Option.nulSeparatedList,   false, STAGE_ANY },
 	{ "machinable",     &localOption.machinable,             true,  STAGE_ANY },
 	{ "put-field-prefix", &Option.putFieldPrefix,       false, STAGE_ANY },
 	{ "print-language", &Option.printLanguage,          true,  STAGE_ANY },
@@ -2631,7 +3435,9 @@ static booleanOption BooleanOptions [] = {
 #ifdef RECURSE_SUPPORTED
 	{ "recurse",        &Option.recurse,                false, STAGE_ANY },
 #endif
-	{ "totals",         &Option.printTotals,            true,  STAGE_ANY },
+	{ "reread-input",   &Option.rereadInput,            true,  STAGE_ANY },
+	{ "trigram-index",  &Option.trigramIndex,           true,  STAGE_ANY },
+	{ "update",         &Option.update,                 true,  STAGE_ANY },
 	{ "verbose",        &Option.verbose,                false, STAGE_ANY },
 	{ "with-list-header", &localOption.withListHeader,       true,  STAGE_ANY },
 	{ "_fatal-warnings",&Option.fatalWarnings,          false, STAGE_ANY },
@@ -2647,31 +3453,73 @@ static void checkOptionOrder (const char* const option, bool longOption)
 		error (FATAL, "-%s%s option may not follow a file name", longOption? "-": "", option);
 }
 
+/* ParametricOptions and BooleanOptions indexed by name, made on the
+   first look up. An option file of optlib parsers has thousands of
+   lines, each of which used to be compared with every entry of both
+   tables. */
+static hashTable *ParametricOptionIndex;
+static hashTable *BooleanOptionIndex;
+
+static hashTable *newOptionIndex (unsigned int size)
+{
+	return hashTableNew (size, hashCstrhash, hashCstreq, NULL, NULL);
+}
+
+static parametricOption *findParametricOption (const char *const option)
+{
+	if (! ParametricOptionIndex)
+	{
+		ParametricOptionIndex = newOptionIndex (ARRAY_SIZE (ParametricOptions));
+		/* The first entry having a name wins: put it last. */
+		for (unsigned int i = ARRAY_SIZE (ParametricOptions); i > 0; i--)
+			hashTablePutItem (ParametricOptionIndex,
+							  (void *) ParametricOptions [i - 1].name,
+							  (void *) &ParametricOptions [i - 1]);
+	}
+	return hashTableGetItem (ParametricOptionIndex, option);
+}
+
+static booleanOption *findBooleanOption (const char *const option)
+{
+	if (! BooleanOptionIndex)
+	{
+		BooleanOptionIndex = newOptionIndex (ARRAY_SIZE (BooleanOptions));
+		for (unsigned int i = ARRAY_SIZE (BooleanOptions); i > 0; i--)
+			hashTablePutItem (BooleanOptionIndex,
+							  (void *) BooleanOptions [i - 1].name,
+							  (void *) &BooleanOptions [i - 1]);
+	}
+	return hashTableGetItem (BooleanOptionIndex, option);
+}
+
+static void freeOptionIndex (void)
+{
+	if (ParametricOptionIndex)
+		hashTableDelete (ParametricOptionIndex);
+	if (BooleanOptionIndex)
+		hashTableDelete (BooleanOptionIndex);
+	ParametricOptionIndex = NULL;
+	BooleanOptionIndex = NULL;
+}
+
 static bool processParametricOption (
 		const char *const option, const char *const parameter)
 {
-	const int count = sizeof (ParametricOptions) / sizeof (parametricOption);
-	bool found = false;
-	int i;
+	parametricOption* const entry = findParametricOption (option);
 
-	for (i = 0  ;  i < count  &&  ! found  ;  ++i)
+	if (entry == NULL)
+		return false;
+
+	if (!(entry->acceptableStages & (1UL << Stage)))
+		error (WARNING, "Cannot use --%s option in %s",
+			   option, StageDescription[Stage]);
+	else
 	{
-		parametricOption* const entry = &ParametricOptions [i];
-		if (strcmp (option, entry->name) == 0)
-		{
-			found = true;
-			if (!(entry->acceptableStages & (1UL << Stage)))
-			{
-				error (WARNING, "Cannot use --%s option in %s",
-				       option, StageDescription[Stage]);
-				break;
-			}
-			if (entry->initOnly)
-				checkOptionOrder (option, true);
-			(entry->handler) (option, parameter);
-		}
+		if (entry->initOnly)
+			checkOptionOrder (option, true);
+		(entry->handler) (option, parameter);
 	}
-	return found;
+	return true;
 }
 
 static bool getBooleanOption (
@@ -2683,33 +3531,26 @@ static bool getBooleanOption (
 static bool processBooleanOption (
 		const char *const option, const char *const parameter)
 {
-	const int count = sizeof (BooleanOptions) / sizeof (booleanOption);
-	bool found = false;
-	int i;
+	booleanOption* const entry = findBooleanOption (option);
+	bool *slot;
+
+	if (entry == NULL)
+		return false;
 
-	for (i = 0  ;  i < count  &&  ! found  ;  ++i)
+	if (!(entry->acceptableStages & (1UL << Stage)))
+		error (WARNING, "Cannot use --%s option in %s",
+			   option, StageDescription[Stage]);
+	else
 	{
-		booleanOption* const entry = &BooleanOptions [i];
-		bool *slot;
-		if (strcmp (option, entry->name) == 0)
-		{
-			found = true;
-			if (!(entry->acceptableStages & (1UL << Stage)))
-			{
-				error (WARNING, "Cannot use --%s option in %s",
-				       option, StageDescription[Stage]);
-				break;
-			}
-			if (entry->initOnly)
-				checkOptionOrder (option, true);
-			if (entry->redirect)
-				slot = entry->redirect (entry);
-			else
-				slot = entry->pValue;
-			*slot = getBooleanOption (option, parameter);
-		}
+		if (entry->initOnly)
+			checkOptionOrder (option, true);
+		if (entry->redirect)
+			slot = entry->redirect (entry);
+		else
+			slot = entry->pValue;
+		*slot = getBooleanOption (option, parameter);
 	}
-	return found;
+	return true;
 }
 
 static void enableLanguageField (langType language, const char *field, bool mode)
@@ -3128,6 +3969,10 @@ static void processShortOption (
 		case 'I':
 			processIgnoreOption (parameter, *option);
 			break;
+		case 'j':
+			checkOptionOrder (option, false);
+			processJobsOption (option, parameter);
+			break;
 		case 'L':
 			if (Option.fileList != NULL)
 			{
@@ -3165,17 +4010,71 @@ static void processShortOption (
 			checkOptionOrder (option, false);
 			setXrefMode ();
 			break;
+		case 'z':
+			Option.nulSeparatedList = true;
+			break;
 		default:
 			error (FATAL, "Unknown option: -%s", option);
 			break;
 	}
 }
 
+/*  Options which only change how or where ctags works, not the tags made
+ *  for an input file. The tag file name (-f, -o) changes the input field
+ *  only through --tag-relative, and the tag cache is keyed by that field
+ *  itself, so that runs writing different tag files share the entries.
+ */
+static bool isNonTaggingOption (bool longOption, const char *const option)
+{
+	static const char *const longOptions [] = {
+		"atomic-output", "cache-dir", "cache-remote", "compress", "compress-frame-size", "deduplicate-inputs", "deduplicate-tags", "fold-index", "git-tree", "input-index", "jobs", "manifest", "memory-limit", "name-filter", "name-index", "nul-separated-list",
+		"output-buffer-size", "quiet", "recurse", "report-slow", "trace-events", "trigram-index", "update",
+		"verbose",
+	};
+	unsigned int i;
+
+	if (! longOption)
+		return (strchr ("fjLoRVz", *option) != NULL);
+
+	for (i = 0; i < ARRAY_SIZE (longOptions); i++)
+		if (strcmp (option, longOptions [i]) == 0)
+			return true;
+	return false;
+}
+
+static void recordOption (bool longOption, const char *const option,
+						  const char *const parameter)
+{
+	if (isNonTaggingOption (longOption, option))
+		return;
+
+	if (OptionHistory == NULL)
+		OptionHistory = vStringNew ();
+	vStringCatS (OptionHistory, longOption? "--": "-");
+	vStringCatS (OptionHistory, option);
+	if (parameter)
+	{
+		vStringPut (OptionHistory, '=');
+		vStringCatS (OptionHistory, parameter);
+	}
+	vStringPut (OptionHistory, '\n');
+}
+
+/*  Return the options processed so far, one per line. The tag cache and
+ *  the manifest use it to tell whether stored tags were made with the
+ *  current options.
+ */
+extern const char *getOptionHistory (void)
+{
+	return OptionHistory? vStringValue (OptionHistory): "";
+}
+
 static void parseOption (cookedArgs* const args)
 {
 	Assert (! cArgOff (args));
 	if (args->isOption)
 	{
+		recordOption (args->longOption, args->item, args->parameter);
 		if (args->longOption)
 			processLongOption (args->item, args->parameter);
 		else
@@ -3587,11 +4486,22 @@ extern void freeOptionResources (void)
 {
 	freeString (&Option.tagFileName);
 	freeString (&Option.fileList);
+	freeString (&Option.gitTree);
 	freeString (&Option.filterTerminator);
+	freeString (&Option.cacheDir);
+	freeString (&Option.cacheRemote);
+	freeString (&Option.traceEvents);
+
+	vStringDelete (OptionHistory);
+	OptionHistory = NULL;
 
 	freeList (&Excluded);
+	freeExcludedIndex ();
+	freeOptionIndex ();
 	freeList (&Option.headerExt);
 	freeList (&Option.etagsInclude);
+	freeList (&Option.ignoreFileNames);
+	freeList (&Option.outputs);
 
 	freeSearchPathList (&OptlibPathList);
 
@@ -59,6 +59,11 @@ typedef enum sortType {
 	SO_FOLDSORTED
 } sortType;
 
+typedef enum eCompression {
+	COMPRESS_NONE,
+	COMPRESS_GZIP,
+} compressionType;
+
 typedef enum eTagRelative {
 	TREL_NO,
 	TREL_YES,
@@ -79,9 +84,13 @@ typedef struct sOptionValues {
 	bool xref;           /* -x  generate xref output instead */
 	fmtElement *customXfmt;	/* compiled code for --xformat=XFMT */
 	char *fileList;         /* -L  name of file containing names of files */
+	bool nulSeparatedList;  /* -z, --nul-separated-list  names of -L end with NUL */
+	char *gitTree;          /* --git-tree  tree of the git repository to tag */
 	char *tagFileName;      /* -o  name of tags file */
+	stringList* outputs;    /* --output  FORMAT:FILE of the other tag files */
 	stringList* headerExt;  /* -h  header extensions */
 	stringList* etagsInclude;/* --etags-include  list of TAGS files to include*/
+	stringList* ignoreFileNames;/* --ignore-file  names of ignore files read in directories */
 	unsigned int tagFileFormat;/* --format  tag file format (level) */
 #ifdef HAVE_ICONV
 	char *inputEncoding;	/* --input-encoding	convert text into --output-encoding */
@@ -91,19 +100,61 @@ typedef struct sOptionValues {
 	bool followLinks;    /* --link  follow symbolic links? */
 	bool filter;         /* --filter  behave as filter: files in, tags out */
 	char* filterTerminator; /* --filter-terminator  string to output */
+	bool filterTerminatorId;	/* --filter-terminator-id  number the terminators */
+	unsigned int filterBatchSize;	/* --filter-batch=N  bytes of output kept */
+	unsigned int filterBatchTime;	/* --filter-batch=N:MS  milliseconds output kept */
 	tagRelative tagRelative;    /* --tag-relative file paths relative to tag file */
-	bool printTotals;    /* --totals  print cumulative statistics */
+	enum totalsMode { TOTALS_NO = 0,
+					  TOTALS_YES,
+					  TOTALS_EXTRA,
+					  TOTALS_JSON,
+					  TOTALS_KINDS, } printTotals; /* --totals  print cumulative statistics */
 	bool lineDirectives; /* --linedirectives  process #line directives */
 	bool printLanguage;  /* --print-language */
 	bool guessLanguageEagerly; /* --guess-language-eagerly|-G */
+	bool guessCache;	/* --guess-cache  reuse selections within a directory */
 	bool quiet;		      /* --quiet */
 	bool fatalWarnings;	/* --_fatal-warnings */
 	unsigned int patternLengthLimit; /* --pattern-length-limit=N */
 	bool putFieldPrefix;		 /* --put-field-prefix */
 	unsigned int maxRecursionDepth; /* --maxdepth=<max-recursion-depth> */
+	unsigned int jobs;		/* -j, --jobs=N  number of worker processes */
+	char *cacheDir;			/* --cache-dir=DIR  tag cache directory */
+	char *cacheRemote;		/* --cache-remote=COMMAND  helper of a shared tag cache */
+	bool update;			/* --update  replace the tags of the given files */
+	bool deduplicateInputs;	/* --deduplicate-inputs  parse the same contents once */
+	bool deduplicateTags;	/* --deduplicate-tags  drop the duplicate lines of unsorted tags */
+	bool atomicOutput;		/* --atomic-output  rename the tag file written into place */
+	bool manifest;			/* --manifest  skip files unchanged since the last run */
+	bool mergeShards;		/* --merge-shards  merge the tag files given as arguments */
+	bool nameIndex;			/* --name-index  write TAGFILE.idx for readtags */
+	bool foldIndex;			/* --fold-index  write TAGFILE.fidx for readtags */
+	bool inputIndex;		/* --input-index  write TAGFILE.iidx for readtags */
+	bool nameFilter;		/* --name-filter  write TAGFILE.bflt for readtags */
+	bool trigramIndex;		/* --trigram-index  write TAGFILE.tidx for readtags */
+	unsigned int outputBufferSize;	/* --output-buffer-size=N  buffer of the tag file */
+	compressionType compress;	/* --compress  write the tag file compressed in frames */
+	unsigned int compressFrameSize;	/* --compress-frame-size=N  bytes of a frame */
+	unsigned int reportSlow;	/* --report-slow=N  print the N slowest files */
+	unsigned int fileTimeLimit;	/* --file-time-limit=MS  time budget of a file */
+	unsigned int memoryLimit;	/* --memory-limit=MB  of the memory in use */
+	enum generatedInputMode { GENERATED_INPUT_TAG = 0,
+							  GENERATED_INPUT_SHALLOW,
+							  GENERATED_INPUT_SKIP, } generatedInput; /* --generated-input */
+	unsigned int generatedInputSize;	/* --generated-input-size=N  bytes making a file generated */
+	enum partitionMode { PARTITION_NONE = 0,
+						 PARTITION_LANGUAGE,
+						 PARTITION_DIRECTORY, } partition; /* --partition  tag files of parts of the input */
+	unsigned int partitionDepth;	/* --partition=directory:N  directories making a part */
+	char *traceEvents;		/* --trace-events=FILE  write spans as Chrome trace events */
+	bool rereadInput;		/* --reread-input  read tagged lines again for patterns */
+	unsigned int selectorWindow;	/* --selector-window=N  bytes read to tell languages apart */
 	enum interactiveMode { INTERACTIVE_NONE = 0,
 						   INTERACTIVE_DEFAULT,
 						   INTERACTIVE_SANDBOX, } interactive; /* --interactive */
+	enum regexProfile { REGEX_PROFILE_NONE = 0,
+						REGEX_PROFILE_TEXT,
+						REGEX_PROFILE_JSON, } profileRegex; /* --_profile-regex */
 #ifdef DEBUG
 	long debugLevel;        /* -d  debugging output */
 	unsigned long breakLine;/* -b  input line at which to call lineBreak() */
@@ -160,6 +211,7 @@ extern void previewFirstOption (cookedArgs* const cargs);
 extern void readOptionConfiguration (void);
 extern void initOptions (void);
 extern void freeOptionResources (void);
+extern const char *getOptionHistory (void);
 
 extern langType getLanguageComponentInOption (const char *const option,
 					      const char *const prefix);
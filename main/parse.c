@@ -13,9 +13,12 @@
 */
 #include "general.h"  /* must always come first */
 
+#include <stdint.h>
 #include <string.h>
 
 #include "ctags.h"
+#include "cache.h"
+#include "compressed.h"
 #include "debug.h"
 #include "entry.h"
 #include "flags.h"
@@ -32,6 +35,7 @@
 #include "routines.h"
 #include "subparser.h"
 #include "trace.h"
+#include "traceevent.h"
 #include "trashbox.h"
 #include "vstring.h"
 #ifdef HAVE_ICONV
@@ -73,6 +77,9 @@ typedef struct sParserObject {
 									  (a subparser requests run this parser.) */
 	unsigned int pseudoTagPrinted:1;   /* pseudo tags about this parser
 										  is emitted or not. */
+	unsigned int mapsPending:1;	   /* currentPatterns and currentExtensions
+									  are still those of def, not made yet. */
+	unsigned int aliasesPending:1; /* the same for currentAliases */
 
 	unsigned int anonymousIdentiferId; /* managed by anon* functions */
 
@@ -112,7 +119,25 @@ static parserDefinitionFunc* BuiltInParsers[] = {
 };
 static parserObject* LanguageTable = NULL;
 static unsigned int LanguageCount = 0;
+static unsigned int LanguageTableSize = 0;	/* allocated slots */
 static hashTable* LanguageHTable = NULL;
+
+/* Reverse indexes of the language maps and aliases, rebuilt on the
+   first look up after one of them changes. Each maps an extension, or
+   a pattern or alias having no wildcard, to the parsers having it, in
+   the order of LanguageTable. Parsers having a pattern or an alias with
+   a wildcard are listed aside; they still need fnmatch. */
+static hashTable* ExtensionIndex = NULL;
+static hashTable* PatternIndex = NULL;
+/* With --guess-cache, the language a selector chose in a directory,
+   keyed by the directory and the extension or the interpreter the
+   candidates were nominated for. */
+static hashTable* SelectionMemo = NULL;
+static hashTable* AliasIndex = NULL;
+static ptrArray* WildcardPatternParsers = NULL;
+static ptrArray* WildcardAliasParsers = NULL;
+static bool LanguageMapIndexDirty = true;
+
 static kindDefinition defaultFileKind = {
 	.enabled     = false,
 	.letter      = KIND_FILE_DEFAULT,
@@ -299,27 +324,246 @@ extern kindDefinition* getLanguageKindForLetter (const langType language, char k
 extern langType getNamedLanguage (const char *const name, size_t len)
 {
 	langType result = LANG_IGNORE;
-	unsigned int i;
+	parserDefinition *def;
 	Assert (name != NULL);
 
 	if (len == 0)
+		def = (parserDefinition *)hashTableGetItem (LanguageHTable, name);
+	else
 	{
-		parserDefinition *def = (parserDefinition *)hashTableGetItem (LanguageHTable, name);
-		if (def)
-			result = def->id;
+		char *key = eStrndup (name, len);
+		def = (parserDefinition *)hashTableGetItem (LanguageHTable, key);
+		eFree (key);
 	}
-	else
-		for (i = 0  ;  i < LanguageCount  &&  result == LANG_IGNORE  ;  ++i)
+	if (def)
+		result = def->id;
+	return result;
+}
+
+static void invalidateLanguageMapIndex (void)
+{
+	LanguageMapIndexDirty = true;
+	if (SelectionMemo)
+		hashTableClear (SelectionMemo);
+}
+
+/* The language maps and aliases of a parser are taken from its
+   definition only when something needs them as lists: an option
+   changing or listing them, or a file being found with one of them.
+   Until then the reverse indexes are made from the definition. */
+static void prepareLanguageMap (parserObject *parser)
+{
+	if (!parser->mapsPending)
+		return;
+
+	parser->currentPatterns = (parser->def->patterns == NULL)
+		? stringListNew ()
+		: stringListNewFromArgv (parser->def->patterns);
+	parser->currentExtensions = (parser->def->extensions == NULL)
+		? stringListNew ()
+		: stringListNewFromArgv (parser->def->extensions);
+	parser->mapsPending = 0;
+}
+
+static void prepareLanguageAliases (parserObject *parser)
+{
+	if (!parser->aliasesPending)
+		return;
+
+	parser->currentAliases = (parser->def->aliases == NULL)
+		? stringListNew ()
+		: stringListNewFromArgv (parser->def->aliases);
+	parser->aliasesPending = 0;
+}
+
+static bool argvHasItem (const char *const *const argv, const char *const item)
+{
+	for (unsigned int i = 0; argv && argv [i]; i++)
+	{
+#ifdef CASE_INSENSITIVE_FILENAMES
+		if (strcasecmp (argv [i], item) == 0)
+#else
+		if (strcmp (argv [i], item) == 0)
+#endif
+			return true;
+	}
+	return false;
+}
+
+static bool argvHasWildcard (const char *const *const argv)
+{
+	for (unsigned int i = 0; argv && argv [i]; i++)
+		if (!isFileNamePatternLiteral (argv [i]))
+			return true;
+	return false;
+}
+
+static void deleteIndexedParsers (void *data)
+{
+	ptrArrayDelete (data);
+}
+
+static hashTable *newLanguageMapIndex (void)
+{
+#ifdef CASE_INSENSITIVE_FILENAMES
+	return hashTableNew (257, hashCstrcasehash, hashCstrcaseeq,
+						 eFree, deleteIndexedParsers);
+#else
+	return hashTableNew (257, hashCstrhash, hashCstreq,
+						 eFree, deleteIndexedParsers);
+#endif
+}
+
+static void freeLanguageMapIndex (void)
+{
+	if (ExtensionIndex)
+		hashTableDelete (ExtensionIndex);
+	if (PatternIndex)
+		hashTableDelete (PatternIndex);
+	if (AliasIndex)
+		hashTableDelete (AliasIndex);
+	if (WildcardPatternParsers)
+		ptrArrayDelete (WildcardPatternParsers);
+	if (WildcardAliasParsers)
+		ptrArrayDelete (WildcardAliasParsers);
+
+	if (SelectionMemo)
+		hashTableDelete (SelectionMemo);
+
+	ExtensionIndex = NULL;
+	PatternIndex = NULL;
+	AliasIndex = NULL;
+	WildcardPatternParsers = NULL;
+	WildcardAliasParsers = NULL;
+	SelectionMemo = NULL;
+	LanguageMapIndexDirty = true;
+}
+
+static void indexParser (hashTable *index, const char *key, parserDefinition *def)
+{
+	ptrArray *parsers = hashTableGetItem (index, key);
+
+	if (parsers == NULL)
+	{
+		parsers = ptrArrayNew (NULL);
+		hashTablePutItem (index, eStrdup (key), parsers);
+	}
+	/* A parser can have the same key twice. */
+	if (ptrArrayCount (parsers) == 0 || ptrArrayLast (parsers) != def)
+		ptrArrayAdd (parsers, def);
+}
+
+static void indexParserList (hashTable *index, ptrArray *wildcardParsers,
+							 stringList *list, parserDefinition *def)
+{
+	bool wildcard = false;
+
+	if (list == NULL)
+		return;
+
+	for (unsigned int i = 0; i < stringListCount (list); i++)
+	{
+		const char *key = vStringValue (stringListItem (list, i));
+		if (wildcardParsers && !isFileNamePatternLiteral (key))
+			wildcard = true;
+		else
+			indexParser (index, key, def);
+	}
+	if (wildcard)
+		ptrArrayAdd (wildcardParsers, def);
+}
+
+static void indexParserArgv (hashTable *index, const char *const *const argv,
+							 parserDefinition *def)
+{
+	for (unsigned int i = 0; argv && argv [i]; i++)
+		indexParser (index, argv [i], def);
+}
+
+static void prepareLanguageMapIndex (void)
+{
+	if (!LanguageMapIndexDirty)
+		return;
+
+	freeLanguageMapIndex ();
+	ExtensionIndex = newLanguageMapIndex ();
+	PatternIndex = newLanguageMapIndex ();
+	AliasIndex = newLanguageMapIndex ();
+	WildcardPatternParsers = ptrArrayNew (NULL);
+	WildcardAliasParsers = ptrArrayNew (NULL);
+
+	for (unsigned int i = 0; i < LanguageCount; i++)
+	{
+		parserObject *parser = LanguageTable + i;
+
+		/* A wildcard is matched with fnmatch against the list. */
+		if (parser->mapsPending && argvHasWildcard (parser->def->patterns))
+			prepareLanguageMap (parser);
+		if (parser->aliasesPending && argvHasWildcard (parser->def->aliases))
+			prepareLanguageAliases (parser);
+
+		if (parser->mapsPending)
 		{
-			const parserDefinition* const lang = LanguageTable [i].def;
-			Assert (lang->name);
-			vString* vstr = vStringNewInit (name);
-			vStringTruncate (vstr, len);
+			indexParserArgv (ExtensionIndex, parser->def->extensions, parser->def);
+			indexParserArgv (PatternIndex, parser->def->patterns, parser->def);
+		}
+		else
+		{
+			indexParserList (ExtensionIndex, NULL,
+							 parser->currentExtensions, parser->def);
+			indexParserList (PatternIndex, WildcardPatternParsers,
+							 parser->currentPatterns, parser->def);
+		}
+		if (parser->aliasesPending)
+			indexParserArgv (AliasIndex, parser->def->aliases, parser->def);
+		else
+			indexParserList (AliasIndex, WildcardAliasParsers,
+							 parser->currentAliases, parser->def);
+	}
+	LanguageMapIndexDirty = false;
+}
+
+/* Return the first enabled parser in PARSERS from START_INDEX, or
+   LANG_IGNORE. */
+static langType getFirstIndexedLanguage (ptrArray *parsers, langType start_index)
+{
+	if (parsers == NULL)
+		return LANG_IGNORE;
+
+	for (unsigned int i = 0; i < ptrArrayCount (parsers); i++)
+	{
+		parserDefinition *def = ptrArrayItem (parsers, i);
+		if (def->id >= start_index && def->enabled)
+			return def->id;
+	}
+	return LANG_IGNORE;
+}
+
+/* Return the first enabled parser from START_INDEX either in PARSERS or
+   in WILDCARD_PARSERS having a pattern, or an alias if ALIAS is true,
+   matching FILENAME. */
+static langType getFirstMatchedLanguage (ptrArray *parsers, ptrArray *wildcardParsers,
+										 bool alias, const char *const fileName,
+										 langType start_index)
+{
+	langType result = getFirstIndexedLanguage (parsers, start_index);
 
-			if (strcasecmp (vStringValue (vstr), lang->name) == 0)
-				result = i;
-			vStringDelete (vstr);
+	for (unsigned int i = 0; i < ptrArrayCount (wildcardParsers); i++)
+	{
+		parserDefinition *def = ptrArrayItem (wildcardParsers, i);
+		parserObject *parser = LanguageTable + def->id;
+		stringList *list = alias? parser->currentAliases: parser->currentPatterns;
+
+		if (result != LANG_IGNORE && def->id >= result)
+			break;
+		if (def->id < start_index || !def->enabled)
+			continue;
+		if (stringListFileMatched (list, fileName))
+		{
+			result = def->id;
+			break;
 		}
+	}
 	return result;
 }
 
@@ -327,7 +571,8 @@ static langType getNameOrAliasesLanguageAndSpec (const char *const key, langType
 						 const char **const spec, enum specType *specType)
 {
 	langType result = LANG_IGNORE;
-	unsigned int i;
+	langType named = LANG_IGNORE;
+	parserDefinition *def;
 
 
 	if (start_index == LANG_AUTO)
@@ -335,30 +580,30 @@ static langType getNameOrAliasesLanguageAndSpec (const char *const key, langType
 	else if (start_index == LANG_IGNORE || start_index >= (int) LanguageCount)
 		return result;
 
-	for (i = start_index  ;  i < LanguageCount  &&  result == LANG_IGNORE  ;  ++i)
-	{
-		const parserObject* const parser = LanguageTable + i;
-		stringList* const aliases = parser->currentAliases;
-		vString* tmp;
+	prepareLanguageMapIndex ();
 
-		/* isLanguageEnabled is not used here.
-		   It calls initializeParser which takes
-		   cost. */
-		if (! parser->def->enabled)
-			continue;
+	/* isLanguageEnabled is not used here.
+	   It calls initializeParser which takes
+	   cost. */
+	def = hashTableGetItem (LanguageHTable, key);
+	if (def && def->id >= start_index && def->enabled)
+		named = def->id;
 
-		if (parser->def->name != NULL && strcasecmp (key, parser->def->name) == 0)
-		{
-			result = i;
-			*spec = parser->def->name;
-			*specType = SPEC_NAME;
-		}
-		else if (aliases != NULL  &&  (tmp = stringListFileFinds (aliases, key)))
-		{
-			result = i;
-			*spec = vStringValue(tmp);
-			*specType = SPEC_ALIAS;
-		}
+	result = getFirstMatchedLanguage (hashTableGetItem (AliasIndex, key),
+									  WildcardAliasParsers, true,
+									  key, start_index);
+	if (named != LANG_IGNORE && (result == LANG_IGNORE || named <= result))
+	{
+		result = named;
+		*spec = LanguageTable [result].def->name;
+		*specType = SPEC_NAME;
+	}
+	else if (result != LANG_IGNORE)
+	{
+		prepareLanguageAliases (LanguageTable + result);
+		*spec = vStringValue (stringListFileFinds (LanguageTable [result].currentAliases,
+												   key));
+		*specType = SPEC_ALIAS;
 	}
 	return result;
 }
@@ -378,7 +623,7 @@ static langType getPatternLanguageAndSpec (const char *const baseName, langType
 					   const char **const spec, enum specType *specType)
 {
 	langType result = LANG_IGNORE;
-	unsigned int i;
+	const char *extension;
 
 	if (start_index == LANG_AUTO)
 	        start_index = 0;
@@ -386,49 +631,33 @@ static langType getPatternLanguageAndSpec (const char *const baseName, langType
 		return result;
 
 	*spec = NULL;
-	for (i = start_index  ;  i < LanguageCount  &&  result == LANG_IGNORE  ;  ++i)
+	prepareLanguageMapIndex ();
+
+	/* isLanguageEnabled is not used here.
+	   It calls initializeParser which takes
+	   cost. */
+	result = getFirstMatchedLanguage (hashTableGetItem (PatternIndex, baseName),
+									  WildcardPatternParsers, false,
+									  baseName, start_index);
+	if (result != LANG_IGNORE)
 	{
-		parserObject *parser = LanguageTable + i;
-		stringList* const ptrns = parser->currentPatterns;
-		vString* tmp;
-
-		/* isLanguageEnabled is not used here.
-		   It calls initializeParser which takes
-		   cost. */
-		if (! parser->def->enabled)
-			continue;
-
-		if (ptrns != NULL && (tmp = stringListFileFinds (ptrns, baseName)))
-		{
-			result = i;
-			*spec = vStringValue(tmp);
-			*specType = SPEC_PATTERN;
-			goto found;
-		}
+		prepareLanguageMap (LanguageTable + result);
+		*spec = vStringValue (stringListFileFinds (LanguageTable [result].currentPatterns,
+												   baseName));
+		*specType = SPEC_PATTERN;
+		return result;
 	}
 
-	for (i = start_index  ;  i < LanguageCount  &&  result == LANG_IGNORE  ;  ++i)
+	extension = fileExtension (baseName);
+	result = getFirstIndexedLanguage (hashTableGetItem (ExtensionIndex, extension),
+									  start_index);
+	if (result != LANG_IGNORE)
 	{
-		parserObject *parser = LanguageTable + i;
-		stringList* const exts = parser->currentExtensions;
-		vString* tmp;
-
-		/* isLanguageEnabled is not used here.
-		   It calls initializeParser which takes
-		   cost. */
-		if (! parser->def->enabled)
-			continue;
-
-		if (exts != NULL && (tmp = stringListExtensionFinds (exts,
-								     fileExtension (baseName))))
-		{
-			result = i;
-			*spec = vStringValue(tmp);
-			*specType = SPEC_EXTENSION;
-			goto found;
-		}
+		prepareLanguageMap (LanguageTable + result);
+		*spec = vStringValue (stringListExtensionFinds (LanguageTable [result].currentExtensions,
+														extension));
+		*specType = SPEC_EXTENSION;
 	}
-found:
 	return result;
 }
 
@@ -695,6 +924,26 @@ static vString* determineVimFileType (const char *const modeline)
 	return filetype;
 }
 
+/* Move INPUT to the start of its last N lines if its contents are in
+ * memory. Otherwise leave INPUT as is, to be read from there. */
+static void seekToLastLines (MIO* input, unsigned int n)
+{
+	size_t size;
+	const unsigned char* const data = mio_memory_get_data (input, &size);
+	size_t i;
+
+	if (data == NULL || size == 0)
+		return;
+
+	i = size;
+	if (data[i - 1] == '\n')
+		i--;	/* the end of the last line */
+	for ( ;  i > 0  ;  i--)
+		if (data[i - 1] == '\n' && --n == 0)
+			break;
+	mio_seek (input, (long) i, SEEK_SET);
+}
+
 static vString* extractVimFileType(MIO* input)
 {
 	/* http://vimdoc.sourceforge.net/htmldoc/options.html#modeline
@@ -711,31 +960,34 @@ static vString* extractVimFileType(MIO* input)
 	vString* filetype = NULL;
 #define RING_SIZE 5
 	vString* ring[RING_SIZE];
-	int i, j;
+	vString* line;
+	unsigned int i, n;
 	unsigned int k;
 	const char* const prefix[] = {
 		"vim:", "vi:", "ex:"
 	};
 
+	seekToLastLines (input, RING_SIZE);
+
 	for (i = 0; i < RING_SIZE; i++)
 		ring[i] = vStringNew ();
+	line = vStringNew ();
 
-	i = 0;
-	while ((readLineRaw (ring[i++], input)) != NULL)
-		if (i == RING_SIZE)
-			i = 0;
+	/* ring[n % RING_SIZE] is the oldest of the last lines. */
+	for (n = 0; readLineRaw (line, input) != NULL; n++)
+	{
+		vString *tmp = ring[n % RING_SIZE];
+		ring[n % RING_SIZE] = line;
+		line = tmp;
+	}
 
-	j = i;
-	do
+	for (i = 1; i <= RING_SIZE && i <= n && !filetype; i++)
 	{
+		const char* const modeline = vStringValue (ring[(n - i) % RING_SIZE]);
 		const char* p;
 
-		j--;
-		if (j < 0)
-			j = RING_SIZE - 1;
-
 		for (k = 0; k < ARRAY_SIZE(prefix); k++)
-			if ((p = strstr (vStringValue (ring[j]), prefix[k])) != NULL)
+			if ((p = strstr (modeline, prefix[k])) != NULL)
 			{
 				p += strlen(prefix[k]);
 				for ( ;  isspace ((int) *p)  ;  ++p)
@@ -743,9 +995,10 @@ static vString* extractVimFileType(MIO* input)
 				filetype = determineVimFileType(p);
 				break;
 			}
-	} while (((i == RING_SIZE)? (j != RING_SIZE - 1): (j != i)) && (!filetype));
+	}
 
-	for (i = RING_SIZE - 1; i >= 0; i--)
+	vStringDelete (line);
+	for (i = 0; i < RING_SIZE; i++)
 		vStringDelete (ring[i]);
 #undef RING_SIZE
 
@@ -1031,6 +1284,39 @@ static bool doesCandidatesRequireMemoryStream(const parserCandidate *candidates,
 	return false;
 }
 
+/* The key of the selection among CANDIDATES for FILENAME in SelectionMemo,
+   or NULL if it is not memoized: the candidates must have been nominated
+   for the extension of FILENAME, or for the interpreter or mode SPEC. A
+   file whose whole name matches a pattern is always tasted. */
+static char *makeSelectionMemoKey (const char *const fileName, const char *const spec,
+								   const parserCandidate *candidates, unsigned int n_candidates)
+{
+	const char *const baseName = baseFilename (fileName);
+	const char *key;
+	vString *memoKey;
+	unsigned int i;
+
+	if (!Option.guessCache)
+		return NULL;
+
+	for (i = 0; i < n_candidates; i++)
+		if (candidates[i].specType != candidates[0].specType)
+			return NULL;
+	if (candidates[0].specType == SPEC_EXTENSION)
+		key = fileExtension (baseName);
+	else if (candidates[0].specType == SPEC_NAME)
+		key = spec;
+	else
+		return NULL;
+
+	memoKey = vStringNew ();
+	vStringNCatS (memoKey, fileName, baseName - fileName);
+	vStringPut (memoKey, '\n');
+	vStringPut (memoKey, (candidates[0].specType == SPEC_EXTENSION)? '.': '!');
+	vStringCatS (memoKey, key);
+	return vStringDeleteUnwrap (memoKey);
+}
+
 static langType getSpecLanguageCommon (const char *const spec, struct getLangCtx *glc,
 				       unsigned int nominate (const char *const, parserCandidate**),
 				       langType *fallback)
@@ -1059,16 +1345,41 @@ static langType getSpecLanguageCommon (const char *const spec, struct getLangCtx
 		selectLanguage selector = commonSelector(candidates, n_candidates);
 		bool memStreamRequired = doesCandidatesRequireMemoryStream (candidates,
 									       n_candidates);
+		char *memoKey = selector
+			? makeSelectionMemoKey (glc->fileName, spec, candidates, n_candidates)
+			: NULL;
+
+		if (memoKey && SelectionMemo && hashTableHasItem (SelectionMemo, memoKey))
+		{
+			language = (langType) (intptr_t) hashTableGetItem (SelectionMemo, memoKey);
+			verbose ("	selection memoized for the directory: %s\n",
+					 getLanguageName (language));
+			eFree (memoKey);
+			if (fallback)
+				*fallback = candidates[0].lang;
+			eFree (candidates);
+			return language;
+		}
 
 		GLC_FOPEN_IF_NECESSARY(glc, fopen_error, memStreamRequired);
 		if (selector) {
 			verbose ("	selector: %p\n", selector);
 			language = pickLanguageBySelection(selector, glc->input, candidates, n_candidates);
+			if (memoKey && language != LANG_IGNORE)
+			{
+				if (SelectionMemo == NULL)
+					SelectionMemo = hashTableNew (257, hashCstrhash, hashCstreq,
+												  eFree, NULL);
+				hashTablePutItem (SelectionMemo, memoKey, (void *) (intptr_t) language);
+				memoKey = NULL;
+			}
 		} else {
 			verbose ("	selector: NONE\n");
 		fopen_error:
 			language = LANG_IGNORE;
 		}
+		if (memoKey)
+			eFree (memoKey);
 
 		Assert(language != LANG_AUTO);
 
@@ -1139,6 +1450,7 @@ struct GetLanguageRequest {
 	enum { GLR_OPEN, GLR_DISCARD, GLR_REUSE, } type;
 	const char *const fileName;
 	MIO *mio;
+	bool executable;			/* for GLR_REUSE */
 };
 
 static langType
@@ -1183,6 +1495,7 @@ getFileLanguageForRequestInternal (struct GetLanguageRequest *req)
     };
     const char* const baseName = baseFilename (fileName);
     char *templateBaseName = NULL;
+    char *compressedBaseName = NULL;
     fileStatus *fstatus = NULL;
 
     for (i = 0; i < N_HINTS; i++)
@@ -1196,6 +1509,17 @@ getFileLanguageForRequestInternal (struct GetLanguageRequest *req)
     if (language != LANG_IGNORE || glc.err)
         goto cleanup;
 
+    /* getMio () decompresses the contents of a.c.gz. */
+    compressedBaseName = baseFilenameSansCompressionSuffixNew (fileName);
+    if (compressedBaseName)
+    {
+        verbose ("	pattern sans compression suffix: %s\n", compressedBaseName);
+        language = getPatternLanguage (compressedBaseName, &glc,
+                                       fallback + HINT_FILENAME);
+        if (language != LANG_IGNORE || glc.err)
+            goto cleanup;
+    }
+
     {
         const char* const tExt = ".in";
         templateBaseName = baseFilenameSansExtensionNew (fileName, tExt);
@@ -1212,9 +1536,10 @@ getFileLanguageForRequestInternal (struct GetLanguageRequest *req)
     }
 
 	/* If the input is already opened, we don't have to verify the existence. */
-    if (glc.input || ((fstatus = eStat (fileName)) && fstatus->exists))
+    if (glc.input || ((fstatus = eStatInputFile (fileName)) && fstatus->exists))
     {
-	    if ((fstatus && fstatus->isExecutable) || Option.guessLanguageEagerly)
+	    if ((fstatus? fstatus->isExecutable: req->executable)
+			|| Option.guessLanguageEagerly)
 	    {
 		    GLC_FOPEN_IF_NECESSARY (&glc, cleanup, false);
 		    language = tasteLanguage(&glc, eager_tasters, 1,
@@ -1242,6 +1567,8 @@ getFileLanguageForRequestInternal (struct GetLanguageRequest *req)
 	    eStatFree (fstatus);
     if (templateBaseName)
         eFree (templateBaseName);
+    if (compressedBaseName)
+        eFree (compressedBaseName);
 
     for (i = 0;
 	 language == LANG_IGNORE && i < N_HINTS;
@@ -1302,8 +1629,10 @@ static void printLanguageMap (const langType language, FILE *fp)
 	bool first = true;
 	unsigned int i;
 	parserObject *parser = LanguageTable + language;
-	stringList* map = parser->currentPatterns;
+	stringList* map;
 	Assert (0 <= language  &&  language < (int) LanguageCount);
+	prepareLanguageMap (parser);
+	map = parser->currentPatterns;
 	for (i = 0  ;  map != NULL  &&  i < stringListCount (map)  ;  ++i)
 	{
 		fprintf (fp, "%s(%s)", (first ? "" : " "),
@@ -1324,25 +1653,15 @@ extern void installLanguageMapDefault (const langType language)
 	parserObject* parser;
 	Assert (0 <= language  &&  language < (int) LanguageCount);
 	parser = LanguageTable + language;
+	invalidateLanguageMapIndex ();
 	if (parser->currentPatterns != NULL)
 		stringListDelete (parser->currentPatterns);
 	if (parser->currentExtensions != NULL)
 		stringListDelete (parser->currentExtensions);
+	parser->currentPatterns = NULL;
+	parser->currentExtensions = NULL;
+	parser->mapsPending = 1;
 
-	if (parser->def->patterns == NULL)
-		parser->currentPatterns = stringListNew ();
-	else
-	{
-		parser->currentPatterns =
-			stringListNewFromArgv (parser->def->patterns);
-	}
-	if (parser->def->extensions == NULL)
-		parser->currentExtensions = stringListNew ();
-	else
-	{
-		parser->currentExtensions =
-			stringListNewFromArgv (parser->def->extensions);
-	}
 	BEGIN_VERBOSE(vfp);
 	{
 	printLanguageMap (language, vfp);
@@ -1366,17 +1685,14 @@ extern void installLanguageAliasesDefault (const langType language)
 	parserObject* parser;
 	Assert (0 <= language  &&  language < (int) LanguageCount);
 	parser = LanguageTable + language;
+	invalidateLanguageMapIndex ();
 	if (parser->currentAliases != NULL)
 		stringListDelete (parser->currentAliases);
+	parser->currentAliases = NULL;
+	parser->aliasesPending = 1;
 
-	if (parser->def->aliases == NULL)
-		parser->currentAliases = stringListNew ();
-	else
-	{
-		parser->currentAliases =
-			stringListNewFromArgv (parser->def->aliases);
-	}
 	BEGIN_VERBOSE(vfp);
+	prepareLanguageAliases (parser);
 	if (parser->currentAliases != NULL)
 		for (unsigned int i = 0  ;  i < stringListCount (parser->currentAliases)  ;  ++i)
 			fprintf (vfp, " %s", vStringValue (
@@ -1397,9 +1713,21 @@ extern void installLanguageAliasesDefaults (void)
 
 extern void clearLanguageMap (const langType language)
 {
+	parserObject* parser;
 	Assert (0 <= language  &&  language < (int) LanguageCount);
-	stringListClear ((LanguageTable + language)->currentPatterns);
-	stringListClear ((LanguageTable + language)->currentExtensions);
+	parser = LanguageTable + language;
+	invalidateLanguageMapIndex ();
+	if (parser->mapsPending)
+	{
+		parser->currentPatterns = stringListNew ();
+		parser->currentExtensions = stringListNew ();
+		parser->mapsPending = 0;
+	}
+	else
+	{
+		stringListClear (parser->currentPatterns);
+		stringListClear (parser->currentExtensions);
+	}
 }
 
 extern void clearLanguageAliases (const langType language)
@@ -1407,17 +1735,30 @@ extern void clearLanguageAliases (const langType language)
 	Assert (0 <= language  &&  language < (int) LanguageCount);
 
 	parserObject* parser = (LanguageTable + language);
-	if (parser->currentAliases)
+	invalidateLanguageMapIndex ();
+	if (parser->aliasesPending)
+	{
+		parser->currentAliases = stringListNew ();
+		parser->aliasesPending = 0;
+	}
+	else if (parser->currentAliases)
 		stringListClear (parser->currentAliases);
 }
 
 static bool removeLanguagePatternMap1(const langType language, const char *const pattern)
 {
 	bool result = false;
-	stringList* const ptrn = (LanguageTable + language)->currentPatterns;
+	parserObject* parser = LanguageTable + language;
+	stringList* ptrn;
+
+	if (parser->mapsPending && !argvHasItem (parser->def->patterns, pattern))
+		return false;
+	prepareLanguageMap (parser);
+	ptrn = parser->currentPatterns;
 
 	if (ptrn != NULL && stringListDeleteItemExtension (ptrn, pattern))
 	{
+		invalidateLanguageMapIndex ();
 		verbose (" (removed from %s)", getLanguageName (language));
 		result = true;
 	}
@@ -1448,16 +1789,25 @@ extern void addLanguagePatternMap (const langType language, const char* ptrn,
 	parser = LanguageTable + language;
 	if (exclusiveInAllLanguages)
 		removeLanguagePatternMap (LANG_AUTO, ptrn);
+	prepareLanguageMap (parser);
 	stringListAdd (parser->currentPatterns, str);
+	invalidateLanguageMapIndex ();
 }
 
 static bool removeLanguageExtensionMap1 (const langType language, const char *const extension)
 {
 	bool result = false;
-	stringList* const exts = (LanguageTable + language)->currentExtensions;
+	parserObject* parser = LanguageTable + language;
+	stringList* exts;
+
+	if (parser->mapsPending && !argvHasItem (parser->def->extensions, extension))
+		return false;
+	prepareLanguageMap (parser);
+	exts = parser->currentExtensions;
 
 	if (exts != NULL  &&  stringListDeleteItemExtension (exts, extension))
 	{
+		invalidateLanguageMapIndex ();
 		verbose (" (removed from %s)", getLanguageName (language));
 		result = true;
 	}
@@ -1487,7 +1837,9 @@ extern void addLanguageExtensionMap (
 	Assert (0 <= language  &&  language < (int) LanguageCount);
 	if (exclusiveInAllLanguages)
 		removeLanguageExtensionMap (LANG_AUTO, extension);
+	prepareLanguageMap (LanguageTable + language);
 	stringListAdd ((LanguageTable + language)->currentExtensions, str);
+	invalidateLanguageMapIndex ();
 }
 
 extern void addLanguageAlias (const langType language, const char* alias)
@@ -1496,9 +1848,11 @@ extern void addLanguageAlias (const langType language, const char* alias)
 	parserObject* parser;
 	Assert (0 <= language  &&  language < (int) LanguageCount);
 	parser = LanguageTable + language;
+	prepareLanguageAliases (parser);
 	if (parser->currentAliases == NULL)
 		parser->currentAliases = stringListNew ();
 	stringListAdd (parser->currentAliases, str);
+	invalidateLanguageMapIndex ();
 }
 
 extern void enableLanguage (const langType language, const bool state)
@@ -1635,6 +1989,15 @@ static void linkDependenciesAtInitializeParsing (parserDefinition *const parser)
 }
 
 /* Used in both builtin and optlib parsers. */
+/* Most parsers have no regex at all: the control block is made when
+   one is added or the parser runs. */
+static struct lregexControlBlock *getLregexControlBlock (parserObject *parser)
+{
+	if (parser->lregexControlBlock == NULL)
+		parser->lregexControlBlock = allocLregexControlBlock (parser->def);
+	return parser->lregexControlBlock;
+}
+
 static void initializeParsingCommon (parserDefinition *def, bool is_builtin)
 {
 	parserObject *parser;
@@ -1647,6 +2010,7 @@ static void initializeParsingCommon (parserDefinition *def, bool is_builtin)
 	def->id = LanguageCount++;
 	parser = LanguageTable + def->id;
 	parser->def = def;
+	invalidateLanguageMapIndex ();
 
 	hashTablePutItem (LanguageHTable, def->name, def);
 
@@ -1654,7 +2018,6 @@ static void initializeParsingCommon (parserDefinition *def, bool is_builtin)
 
 	parser->kindControlBlock  = allocKindControlBlock (def);
 	parser->slaveControlBlock = allocSlaveControlBlock (def);
-	parser->lregexControlBlock = allocLregexControlBlock (def);
 }
 
 extern void initializeParsing (void)
@@ -1665,6 +2028,7 @@ extern void initializeParsing (void)
 	builtInCount = ARRAY_SIZE (BuiltInParsers);
 	LanguageTable = xMalloc (builtInCount, parserObject);
 	memset(LanguageTable, 0, builtInCount * sizeof (parserObject));
+	LanguageTableSize = builtInCount;
 
 	LanguageHTable = hashTableNew (127,
 								   hashCstrcasehash,
@@ -1713,7 +2077,9 @@ extern void freeParserResources (void)
 		if (parser->def->finalize)
 			(parser->def->finalize)((langType)i, (bool)parser->initialized);
 
-		freeLregexControlBlock (parser->lregexControlBlock);
+		if (parser->lregexControlBlock)
+			freeLregexControlBlock (parser->lregexControlBlock);
+		parser->lregexControlBlock = NULL;
 		freeKindControlBlock (parser->kindControlBlock);
 		parser->kindControlBlock = NULL;
 
@@ -1730,10 +2096,12 @@ extern void freeParserResources (void)
 		eFree (parser->def);
 		parser->def = NULL;
 	}
+	freeLanguageMapIndex ();
 	if (LanguageTable != NULL)
 		eFree (LanguageTable);
 	LanguageTable = NULL;
 	LanguageCount = 0;
+	LanguageTableSize = 0;
 }
 
 static void doNothing (void)
@@ -1896,7 +2264,12 @@ extern void processLanguageDefineOption (
 		else
 			name = eStrdup (parameter);
 
-		LanguageTable = xRealloc (LanguageTable, LanguageCount + 1, parserObject);
+		/* Grown by half: optlib files may define hundreds of languages. */
+		if (LanguageCount == LanguageTableSize)
+		{
+			LanguageTableSize += LanguageTableSize / 2 + 1;
+			LanguageTable = xRealloc (LanguageTable, LanguageTableSize, parserObject);
+		}
 		memset (LanguageTable + LanguageCount, 0, sizeof(parserObject));
 
 		struct preLangDefFlagData data = {
@@ -2368,7 +2741,7 @@ static void processLangAliasOption (const langType language,
 				    const char *const parameter)
 {
 	const char* alias;
-	const parserObject * parser;
+	parserObject * parser;
 
 	Assert (0 <= language  &&  language < (int) LanguageCount);
 	parser = LanguageTable + language;
@@ -2391,11 +2764,13 @@ static void processLangAliasOption (const langType language,
 	}
 	else if (parameter[0] == '-')
 	{
+		prepareLanguageAliases (parser);
 		if (parser->currentAliases)
 		{
 			alias = parameter + 1;
 			if (stringListDeleteItemExtension (parser->currentAliases, alias))
 			{
+				invalidateLanguageMapIndex ();
 				verbose ("remove an alias %s from %s\n", alias, parser->def->name);
 			}
 		}
@@ -2454,10 +2829,11 @@ extern bool processAliasOption (
 
 static void printMaps (const langType language, langmapType type)
 {
-	const parserObject* parser;
+	parserObject* parser;
 	unsigned int i;
 
 	parser = LanguageTable + language;
+	prepareLanguageMap (parser);
 	printf ("%-8s", parser->def->name);
 	if (parser->currentPatterns != NULL && (type & LMAP_PATTERN))
 		for (i = 0  ;  i < stringListCount (parser->currentPatterns)  ;  ++i)
@@ -2487,12 +2863,14 @@ static struct colprintTable *mapColprintTableNew (langmapType type)
 
 static void mapColprintAddLanguage (struct colprintTable * table,
 									langmapType type,
-									const parserObject* parser)
+									parserObject* parser)
 {
 	struct colprintLine * line;
 	unsigned int count;
 	unsigned int i;
 
+	prepareLanguageMap (parser);
+
 	if ((type & LMAP_PATTERN) && (0 < (count = stringListCount (parser->currentPatterns))))
 	{
 		for (i = 0; i < count; i++)
@@ -2543,7 +2921,7 @@ extern void printLanguageMaps (const langType language, langmapType type,
 
 			if (type & LMAP_TABLE_OUTPUT)
 			{
-				const parserObject* parser = LanguageTable + i;
+				parserObject* parser = LanguageTable + i;
 
 				mapColprintAddLanguage (table, type, parser);
 			}
@@ -2557,7 +2935,7 @@ extern void printLanguageMaps (const langType language, langmapType type,
 
 		if (type & LMAP_TABLE_OUTPUT)
 		{
-			const parserObject* parser = LanguageTable + language;
+			parserObject* parser = LanguageTable + language;
 
 			mapColprintAddLanguage (table, type, parser);
 		}
@@ -2580,10 +2958,12 @@ static struct colprintTable *aliasColprintTableNew (void)
 }
 
 static void aliasColprintAddLanguage (struct colprintTable * table,
-									  const parserObject* parser)
+									  parserObject* parser)
 {
 	unsigned int count;
 
+	prepareLanguageAliases (parser);
+
 	if (parser->currentAliases && (0 < (count = stringListCount (parser->currentAliases))))
 	{
 		for (unsigned int i = 0; i < count; i++)
@@ -2606,7 +2986,7 @@ extern void printLanguageAliases (const langType language,
 	   for the parser selection. */
 
 	struct colprintTable * table = aliasColprintTableNew();
-	const parserObject* parser;
+	parserObject* parser;
 
 	if (language == LANG_AUTO)
 	{
@@ -2795,6 +3175,9 @@ static rescanReason createTagsForFile (const langType language,
 
 	Assert (lang->parser || lang->parser2);
 
+	if (lang->reset != NULL)
+		lang->reset (language);
+
 	notifyLanguageRegexInputStart (language);
 	notifyInputStart ();
 
@@ -2811,12 +3194,12 @@ static rescanReason createTagsForFile (const langType language,
 
 extern void notifyLanguageRegexInputStart (langType language)
 {
-	notifyRegexInputStart((LanguageTable + language)->lregexControlBlock);
+	notifyRegexInputStart (getLregexControlBlock (LanguageTable + language));
 }
 
 extern void notifyLanguageRegexInputEnd (langType language)
 {
-	notifyRegexInputEnd((LanguageTable + language)->lregexControlBlock);
+	notifyRegexInputEnd (getLregexControlBlock (LanguageTable + language));
 }
 
 static bool doesParserUseCork (parserDefinition *parser)
@@ -2899,9 +3282,20 @@ static bool createTagsWithFallback1 (const langType language,
 		  createTagsForFile (language, ++passCount) )
 		!= RESCAN_NONE)
 	{
+		verbose ("rescanning %s with %s parser (%s)\n",
+				 getInputFileName (), getLanguageName (language),
+				 (whyRescan == RESCAN_FAILED)? "failed": "append");
+		addRescan ();
+
 		if (useCork)
 		{
-			uncorkTagFile();
+			/*  The tags of a failed pass would be written only to be
+			 *  truncated below.
+			 */
+			if (whyRescan == RESCAN_FAILED)
+				discardCorkedTags();
+			else
+				uncorkTagFile();
 			corkTagFile();
 		}
 
@@ -2967,17 +3361,167 @@ extern bool runParserInNarrowedInputStream (const langType language,
 
 }
 
+/*
+ * Generated input files
+ *
+ * A file is taken for generated when a marker of generated code appears
+ * near its top, when its lines are as long as those of minified code,
+ * when its bytes look like those of encoded data, or when it is larger
+ * than --generated-input-size. Only the first GENERATED_SAMPLE_SIZE bytes
+ * are looked at.
+ */
+#define GENERATED_SAMPLE_SIZE	(64 * 1024)
+#define GENERATED_MARKER_AREA	4096
+#define GENERATED_LINE_LENGTH	512
+/* In bits per byte: source code stays below 5.7, base64 is at 6. */
+#define GENERATED_ENTROPY		5.9
+
+static const char *const GeneratedMarkers [] = {
+	"@generated",
+	"DO NOT EDIT",
+	"Do not edit",
+	"do not edit",
+	NULL
+};
+
+static bool hasGeneratedMarker (const unsigned char *data, size_t size)
+{
+	const char *const *m;
+	size_t i;
+
+	if (size > GENERATED_MARKER_AREA)
+		size = GENERATED_MARKER_AREA;
+	for (m = GeneratedMarkers; *m; m++)
+	{
+		const size_t length = strlen (*m);
+
+		for (i = 0; i + length <= size; i++)
+		{
+			if (data [i] == (unsigned char) (*m) [0]
+				&& memcmp (data + i, *m, length) == 0)
+				return true;
+		}
+	}
+	return false;
+}
+
+/* log2 (N) for N > 0, without libm: the integer part from the shifts,
+   the fraction from repeated squaring of the mantissa. */
+static double binaryLog (unsigned long n)
+{
+	double x = (double) n;
+	double result = 0.0;
+	double bit = 1.0;
+	int i;
+
+	while (x >= 2.0)
+	{
+		x /= 2.0;
+		result += 1.0;
+	}
+	for (i = 0; i < 20; i++)
+	{
+		x *= x;
+		bit /= 2.0;
+		if (x >= 2.0)
+		{
+			x /= 2.0;
+			result += bit;
+		}
+	}
+	return result;
+}
+
+/* Shannon entropy of the bytes, in bits per byte */
+static double byteEntropy (const unsigned char *data, size_t size)
+{
+	unsigned long counts [256] = { 0 };
+	double sum = 0.0;
+	size_t i;
+
+	for (i = 0; i < size; i++)
+		counts [data [i]]++;
+	for (i = 0; i < ARRAY_SIZE (counts); i++)
+	{
+		if (counts [i])
+			sum += counts [i] * binaryLog (counts [i]);
+	}
+	return binaryLog (size) - sum / size;
+}
+
+static bool isGeneratedInput (const char *const fileName)
+{
+	size_t size = 0;
+	size_t sample;
+	size_t lines = 0;
+	const unsigned char *const data = getInputFileData (&size);
+	const unsigned char *p, *end;
+
+	if (data == NULL || size == 0)
+		return false;
+
+	if (Option.generatedInputSize > 0 && size > Option.generatedInputSize)
+	{
+		verbose ("%s: generated input: larger than %u bytes\n",
+				 fileName, Option.generatedInputSize);
+		return true;
+	}
+
+	if (hasGeneratedMarker (data, size))
+	{
+		verbose ("%s: generated input: marked as generated\n", fileName);
+		return true;
+	}
+
+	sample = (size > GENERATED_SAMPLE_SIZE)? GENERATED_SAMPLE_SIZE: size;
+	for (p = data, end = data + sample;
+		 (p = memchr (p, '\n', end - p)) != NULL; p++)
+		lines++;
+	if (data [sample - 1] != '\n')
+		lines++;	/* the last line, cut or not terminated */
+	if (sample / lines > GENERATED_LINE_LENGTH)
+	{
+		verbose ("%s: generated input: lines of %lu bytes on average\n",
+				 fileName, (unsigned long) (sample / lines));
+		return true;
+	}
+
+	if (byteEntropy (data, sample) > GENERATED_ENTROPY)
+	{
+		verbose ("%s: generated input: looks like encoded data\n", fileName);
+		return true;
+	}
+
+	return false;
+}
+
 static bool createTagsWithFallback (
 	const char *const fileName, const langType language,
 	MIO *mio)
 {
 	langType exclusive_subparser = LANG_IGNORE;
 	bool tagFileResized = false;
+	const bool timed = (Option.reportSlow > 0 || Option.fileTimeLimit > 0);
+	const double start = timed? getTotalsClock (): 0.0;
+	size_t size = 0;
 
 	Assert (0 <= language  &&  language < (int) LanguageCount);
 
 	if (!openInputFile (fileName, language, mio))
 		return false;
+	if (Option.generatedInput != GENERATED_INPUT_TAG
+		&& isGeneratedInput (fileName))
+	{
+		if (Option.generatedInput == GENERATED_INPUT_SKIP)
+		{
+			verbose ("ignoring %s (generated input)\n", fileName);
+			closeInputFile ();
+			return false;
+		}
+		setInputFileShallow (true);
+	}
+	if (Option.fileTimeLimit > 0)
+		setInputFileDeadline (start + Option.fileTimeLimit / 1000.0);
 
 	tagFileResized = createTagsWithFallback1 (language,
 											  &exclusive_subparser);
@@ -2988,7 +3532,19 @@ static bool createTagsWithFallback (
 				  : exclusive_subparser);
 	makeFileTag (fileName);
 	popLanguage ();
+	getInputFileData (&size);
 	closeInputFile ();
+	setInputFileShallow (false);
+
+	if (Option.fileTimeLimit > 0)
+	{
+		setInputFileDeadline (0.0);
+		if (isInputFileTimedOut () && ! isInputFileInterrupted ())
+			error (WARNING, "%s: parsing stopped after %u ms (--file-time-limit); the rest of the file is not tagged",
+				   fileName, Option.fileTimeLimit);
+	}
+	if (Option.reportSlow > 0)
+		addSlowFile (fileName, language, (long) size, getTotalsClock () - start);
 
 	return tagFileResized;
 }
@@ -3061,6 +3617,7 @@ extern void freeEncodingResources (void)
 		eFree (Option.inputEncoding);
 	if (Option.outputEncoding)
 		eFree (Option.outputEncoding);
+	freeConverterResources ();
 }
 #endif
 
@@ -3112,12 +3669,25 @@ extern bool doesParserRequireMemoryStream (const langType language)
 extern bool parseFile (const char *const fileName)
 {
 	TRACE_ENTER_TEXT("Parsing file %s",fileName);
-	bool bRet = parseFileWithMio (fileName, NULL);
+	bool bRet;
+
+	if (canDeduplicateInputs ())
+		bRet = parseFileDeduplicated (fileName);
+	else if (canUseTagCache ())
+		bRet = parseFileWithTagCache (fileName);
+	else
+		bRet = parseFileWithMio (fileName, NULL);
 	TRACE_LEAVE();
 	return bRet;
 }
 
 extern bool parseFileWithMio (const char *const fileName, MIO *mio)
+{
+	return parseFileWithMioAsExecutable (fileName, mio, false);
+}
+
+extern bool parseFileWithMioAsExecutable (const char *const fileName, MIO *mio,
+										  bool executable)
 {
 	bool tagFileResized = false;
 	langType language;
@@ -3125,9 +3695,14 @@ extern bool parseFileWithMio (const char *const fileName, MIO *mio)
 		.type = mio? GLR_REUSE: GLR_OPEN,
 		.fileName = fileName,
 		.mio = mio,
+		.executable = executable,
 	};
 
+	beginTotalsPhase (PHASE_GUESSING);
+	beginTraceSpan ("guess", fileName, NULL);
 	language = getFileLanguageForRequest (&req);
+	endTraceSpan ();
+	endTotalsPhase ();
 	Assert (language != LANG_AUTO);
 
 	if (Option.printLanguage)
@@ -3141,8 +3716,19 @@ extern bool parseFileWithMio (const char *const fileName, MIO *mio)
 			 fileName);
 	else
 	{
+		const bool extra = (Option.printTotals >= TOTALS_EXTRA);
+		const double start = extra? getTotalsClock (): 0.0;
+		const double cpuStart = extra? getTotalsCpuClock (): 0.0;
+		const unsigned long tags = numTagsAdded ();
+		long files, lines, bytes;
+
 		Assert(isLanguageEnabled (language));
 
+		if (extra)
+			getTotals (&files, &lines, &bytes);
+		beginTotalsPhase (PHASE_PARSING);
+		beginTraceSpan ("parse", fileName, getLanguageName (language));
+
 		if (Option.filter && ! Option.interactive)
 			openTagFile ();
 
@@ -3153,6 +3739,7 @@ extern bool parseFileWithMio (const char *const fileName, MIO *mio)
 					EncodingMap[language] : Option.inputEncoding, Option.outputEncoding);
 #endif
 
+		selectTagPartition (fileName, language);
 		setupWriter ();
 
 		setupAnon ();
@@ -3171,6 +3758,19 @@ extern bool parseFileWithMio (const char *const fileName, MIO *mio)
 			closeTagFile (tagFileResized);
 		addTotals (1, 0L, 0L);
 
+		endTraceSpan ();
+		endTotalsPhase ();
+		if (extra)
+		{
+			long files1, lines1, bytes1;
+
+			getTotals (&files1, &lines1, &bytes1);
+			addLanguageTotals (language, lines1 - lines, bytes1 - bytes,
+							   numTagsAdded () - tags,
+							   getTotalsClock () - start,
+							   getTotalsCpuClock () - cpuStart);
+		}
+
 #ifdef HAVE_ICONV
 		closeConverter ();
 #endif
@@ -3186,31 +3786,31 @@ extern bool parseFileWithMio (const char *const fileName, MIO *mio)
 }
 
 static void matchLanguageMultilineRegexCommon (const langType language,
-											   bool (* func) (struct lregexControlBlock *, const vString* const),
-											   const vString* const allLines)
+											   bool (* func) (struct lregexControlBlock *, const char *const, size_t),
+											   const char *const allLines, size_t length)
 {
 	subparser *tmp;
 
-	func ((LanguageTable + language)->lregexControlBlock, allLines);
+	func (getLregexControlBlock (LanguageTable + language), allLines, length);
 	foreachSubparser(tmp, true)
 	{
 		langType t = getSubparserLanguage (tmp);
 		enterSubparser (tmp);
-		matchLanguageMultilineRegexCommon (t, func, allLines);
+		matchLanguageMultilineRegexCommon (t, func, allLines, length);
 		leaveSubparser ();
 	}
 }
 
 extern void matchLanguageMultilineRegex (const langType language,
-										 const vString* const allLines)
+										 const char *const allLines, size_t length)
 {
-	matchLanguageMultilineRegexCommon(language, matchMultilineRegex, allLines);
+	matchLanguageMultilineRegexCommon(language, matchMultilineRegex, allLines, length);
 }
 
 extern void matchLanguageMultitableRegex (const langType language,
-										  const vString* const allLines)
+										  const char *const allLines, size_t length)
 {
-	matchLanguageMultilineRegexCommon(language, matchMultitableRegex, allLines);
+	matchLanguageMultilineRegexCommon(language, matchMultitableRegex, allLines, length);
 }
 
 extern void processLanguageMultitableExtendingOption (langType language, const char *const parameter)
@@ -3232,7 +3832,7 @@ extern void processLanguageMultitableExtendingOption (langType language, const c
 		error (FATAL, "the name of dist table is empty in table extending: %s", parameter);
 
 	dist = eStrndup(parameter, tmp  - parameter);
-	extendRegexTable(((LanguageTable + language)->lregexControlBlock), src, dist);
+	extendRegexTable(getLregexControlBlock (LanguageTable + language), src, dist);
 	eFree (dist);
 }
 
@@ -3241,7 +3841,7 @@ static bool lregexQueryParserAndSubparesrs (const langType language, bool (* pre
 	bool r;
 	subparser *tmp;
 
-	r = predicate ((LanguageTable + language)->lregexControlBlock);
+	r = predicate (getLregexControlBlock (LanguageTable + language));
 	if (!r)
 	{
 		foreachSubparser(tmp, true)
@@ -3264,11 +3864,17 @@ extern bool hasLanguageMultilineRegexPatterns (const langType language)
 	return lregexQueryParserAndSubparesrs (language, regexNeedsMultilineBuffer);
 }
 
+/* Whether matchLanguageRegex () has single line patterns to match */
+extern bool hasLanguageRegexPatterns (const langType language)
+{
+	return lregexQueryParserAndSubparesrs (language, regexHasSingleLinePatterns);
+}
+
 
 extern void addLanguageCallbackRegex (const langType language, const char *const regex, const char *const flags,
 									  const regexCallback callback, bool *disabled, void *userData)
 {
-	addCallbackRegex ((LanguageTable +language)->lregexControlBlock, regex, flags, callback, disabled, userData);
+	addCallbackRegex (getLregexControlBlock (LanguageTable + language), regex, flags, callback, disabled, userData);
 }
 
 extern bool hasLanguageScopeActionInRegex (const langType language)
@@ -3286,7 +3892,7 @@ extern void matchLanguageRegex (const langType language, const vString* const li
 {
 	subparser *tmp;
 
-	matchRegex ((LanguageTable + language)->lregexControlBlock, line);
+	matchRegex (getLregexControlBlock (LanguageTable + language), line);
 	foreachSubparser(tmp, true)
 	{
 		langType t = getSubparserLanguage (tmp);
@@ -3300,7 +3906,7 @@ extern bool processLanguageRegexOption (langType language,
 										enum regexParserType regptype,
 										const char *const parameter)
 {
-	processTagRegexOption ((LanguageTable +language)->lregexControlBlock,
+	processTagRegexOption (getLregexControlBlock (LanguageTable + language),
 						   regptype, parameter);
 
 	return true;
@@ -3317,7 +3923,7 @@ extern bool processTabledefOption (const char *const option, const char *const p
 	if (parameter == NULL || parameter[0] == '\0')
 		error (FATAL, "A parameter is needed after \"%s\" option", option);
 
-	addRegexTable((LanguageTable +language)->lregexControlBlock, parameter);
+	addRegexTable(getLregexControlBlock (LanguageTable + language), parameter);
 	return true;
 }
 
@@ -3355,14 +3961,14 @@ static void installTagRegexTable (const langType language)
 	    for (i = 0; i < lang->tagRegexCount; ++i)
 		{
 			if (lang->tagRegexTable [i].mline)
-				addTagMultiLineRegex (parser->lregexControlBlock,
+				addTagMultiLineRegex (getLregexControlBlock (parser),
 									  lang->tagRegexTable [i].regex,
 									  lang->tagRegexTable [i].name,
 									  lang->tagRegexTable [i].kinds,
 									  lang->tagRegexTable [i].flags,
 									  (lang->tagRegexTable [i].disabled));
 			else
-				addTagRegex (parser->lregexControlBlock,
+				addTagRegex (getLregexControlBlock (parser),
 							 lang->tagRegexTable [i].regex,
 							 lang->tagRegexTable [i].name,
 							 lang->tagRegexTable [i].kinds,
@@ -3666,16 +4272,15 @@ extern subparser *getNextSubparser(subparser *last,
 	else
 		r = last->next;
 
-	if (r == NULL)
-		return r;
-
-	t = getSubparserLanguage(r);
-	if (isLanguageEnabled (t) &&
-		(includingNoneCraftedParser
-		 || ((((LanguageTable + t)->def->method) && METHOD_NOT_CRAFTED) == 0)))
-		return r;
-	else
-		return getNextSubparser (r, includingNoneCraftedParser);
+	for (; r != NULL; r = r->next)
+	{
+		t = getSubparserLanguage(r);
+		if (isLanguageEnabled (t) &&
+			(includingNoneCraftedParser
+			 || ((((LanguageTable + t)->def->method) && METHOD_NOT_CRAFTED) == 0)))
+			return r;
+	}
+	return NULL;
 }
 
 extern slaveParser *getNextSlaveParser(slaveParser *last)
@@ -3818,14 +4423,25 @@ extern void printLangdefFlags (bool withListHeader, bool machinable, FILE *fp)
 extern void printLanguageMultitableStatistics (langType language, FILE *vfp)
 {
 	parserObject* const parser = LanguageTable + language;
-	printMultitableStatistics (parser->lregexControlBlock,
+	printMultitableStatistics (getLregexControlBlock (parser),
 							   vfp);
 }
 
+extern void printRegexProfile (bool json, FILE *fp)
+{
+	ptrArray *entries = ptrArrayNew (eFree);
+
+	for (unsigned int i = 0; i < LanguageCount; i++)
+		if (LanguageTable [i].lregexControlBlock)
+			addRegexProfileEntries (LanguageTable [i].lregexControlBlock, entries);
+	printRegexProfileEntries (entries, json, fp);
+	ptrArrayDelete (entries);
+}
+
 extern void addLanguageRegexTable (const langType language, const char *name)
 {
 	parserObject* const parser = LanguageTable + language;
-	addRegexTable (parser->lregexControlBlock, name);
+	addRegexTable (getLregexControlBlock (parser), name);
 }
 
 extern void addLanguageTagMultiTableRegex(const langType language,
@@ -3835,7 +4451,7 @@ extern void addLanguageTagMultiTableRegex(const langType language,
 										  bool *disabled)
 {
 	parserObject* const parser = LanguageTable + language;
-	addTagMultiTableRegex (parser->lregexControlBlock, table_name, regex,
+	addTagMultiTableRegex (getLregexControlBlock (parser), table_name, regex,
 						   name, kinds, flags, disabled);
 }
 
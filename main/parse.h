@@ -56,6 +56,12 @@ typedef void (*parserInitialize) (langType language);
    is called. */
 typedef void (*parserFinalize) (langType language, bool initialized);
 
+/* Per language resetter is called before each input file is parsed,
+   and before each pass of a rescan, after the initializer. A parser
+   keeping its working structures from a file to the next clears them
+   here, and releases them in its finalizer. */
+typedef void (*parserReset) (langType language);
+
 typedef enum {
 	METHOD_NOT_CRAFTED    = 1 << 0,
 	METHOD_REGEX          = 1 << 1,
@@ -77,6 +83,7 @@ struct sParserDefinition {
 	const char *const *aliases;    /* list of default aliases (alternative names) */
 	parserInitialize initialize;   /* initialization routine, if needed */
 	parserFinalize finalize;       /* finalize routine, if needed */
+	parserReset reset;             /* reset routine, if needed */
 	simpleParser parser;           /* simple parser (common case) */
 	rescanParser parser2;          /* rescanning parser (unusual case) */
 	selectLanguage* selectLanguage; /* may be used to resolve conflicts */
@@ -201,6 +208,11 @@ extern void printLangdefFlags (bool withListHeader, bool machinable, FILE *fp);
 extern bool doesParserRequireMemoryStream (const langType language);
 extern bool parseFile (const char *const fileName);
 extern bool parseFileWithMio (const char *const fileName, MIO *mio);
+/* Like parseFileWithMio (), telling whether MIO is the contents of an
+   executable file, whose interpreter line is looked at to guess the
+   language. parseFileWithMio () doesn't for a given MIO. */
+extern bool parseFileWithMioAsExecutable (const char *const fileName, MIO *mio,
+										  bool executable);
 extern bool runParserInNarrowedInputStream (const langType language,
 					       unsigned long startLine, long startCharOffset,
 					       unsigned long endLine, long endCharOffset,
@@ -230,8 +242,10 @@ extern bool hasLanguageScopeActionInRegex (const langType language);
 
 /* Multiline Regex Interface */
 extern bool hasLanguageMultilineRegexPatterns (const langType language);
-extern void matchLanguageMultilineRegex (const langType language, const vString* const allLines);
-extern void matchLanguageMultitableRegex (const langType language, const vString* const allLines);
+extern bool hasLanguageRegexPatterns (const langType language);
+/* ALLLINES may not be terminated by NUL. */
+extern void matchLanguageMultilineRegex (const langType language, const char *const allLines, size_t length);
+extern void matchLanguageMultitableRegex (const langType language, const char *const allLines, size_t length);
 
 extern void addLanguageRegexTable (const langType language, const char *name);
 extern void processLanguageMultitableExtendingOption (langType language, const char *const parameter);
@@ -253,4 +267,5 @@ extern void anonGenerate (vString *buffer, const char *prefix, int kind);
 extern void anonHashString (const char *filename, char buf[9]);
 
 extern void printLanguageMultitableStatistics (langType language, FILE *vfp);
+extern void printRegexProfile (bool json, FILE *fp);
 #endif  /* CTAGS_MAIN_PARSE_H */
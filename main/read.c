@@ -16,14 +16,20 @@
 #include <string.h>
 #include <ctype.h>
 #include <stdlib.h>
+#include <limits.h>
+#ifdef HAVE_FCNTL_H
+# include <fcntl.h>  /* to declare openat () */
+#endif
 
 #define FILE_WRITE
 #include "read.h"
+#include "compressed.h"
 #include "debug.h"
 #include "entry.h"
 #include "main.h"
 #include "routines.h"
 #include "options.h"
+#include "traceevent.h"
 #include "trashbox.h"
 #ifdef HAVE_ICONV
 # include "mbcs.h"
@@ -31,6 +37,7 @@
 
 #include <ctype.h>
 #include <stddef.h>
+#include <stdint.h>
 #ifdef HAVE_SYS_TYPES_H
 # include <sys/types.h>  /* declare off_t (not known to regex.h on FreeBSD) */
 #endif
@@ -67,17 +74,32 @@ typedef struct sInputFileInfo {
 	inputLangInfo langInfo;
 } inputFileInfo;
 
+/* The MIOPos of a line is made from its offset when it is asked for,
+   with getInputFilePosition () or getInputFilePositionForLine (): most
+   lines have no tag. */
 typedef struct sComputPos {
-	MIOPos  pos;
-	long    offset;
-	bool open;
-	int crAdjustment;
+	MIOOffset offset;
 } compoundPos;
 
+/* The lines of the map are in blocks of LINE_MAP_BLOCK_LINES lines: a
+   line keeps the 32 bit delta of its offset from the first line of its
+   block, and a block the offset and the count of CR before its first
+   line, and which of its lines add one to that count. A block has the
+   offsets of its lines in wideOffsets instead if a delta does not fit. */
+#define LINE_MAP_BLOCK_LINES 64
+
+typedef struct sLineMapBlock {
+	MIOOffset offset;
+	int crAdjustment;
+	uint64_t crLines;	/* bit N: line N of the block adds a CR */
+	MIOOffset *wideOffsets;
+} lineMapBlock;
+
 typedef struct sInputLineFposMap {
-	compoundPos *pos;
-	unsigned int count;
-	unsigned int size;
+	lineMapBlock *blocks;
+	uint32_t *deltas;
+	unsigned int count;		/* of lines */
+	unsigned int size;		/* of deltas */
 } inputLineFposMap;
 
 typedef struct sNestedInputStreamInfo {
@@ -115,7 +137,22 @@ typedef struct sInputFile {
 	stringList  * sourceTagPathHolder;
 	inputLineFposMap lineFposMap;
 	vString *allLines;
+	/* When allLinesMio is mio, the lines read for the multiline regex
+	   parsers are not copied to allLines: they are the content of mio
+	   from allLinesOffset to its end. */
+	MIO *allLinesMio;
+	MIOOffset allLinesOffset;
+	/* The offsets of the lines of mio, made by readLineFromBypassSlow ()
+	   at its first call for mio. */
+	MIOOffset *lineOffsets;
+	unsigned long lineOffsetCount;
+	bool lineOffsetsMade;
 	int thinDepth;
+	/* What iFileGetLine () does with a line besides reading it, decided
+	   for lineHooksLanguage at the first line read in that language;
+	   LANG_AUTO until then. */
+	langType lineHooksLanguage;
+	unsigned int lineHooks;
 } inputFile;
 
 
@@ -128,6 +165,7 @@ static void     langStackPush (langStack *langStack, langType type);
 static langType langStackPop  (langStack *langStack);
 static void     langStackClear(langStack *langStack);
 
+static MIOOffset getLineFposMapOffset (const inputLineFposMap *lineFposMap, unsigned int line);
 
 /*
 *   DATA DEFINITIONS
@@ -136,10 +174,88 @@ static inputFile File;  /* static read through functions */
 static inputFile BackupFile;	/* File is copied here when a nested parser is pushed */
 static compoundPos StartOfLine;  /* holds deferred position of start of line */
 
+/* For --file-time-limit: the clock at which reading the input file
+   stops, or 0 for no limit. The clock is looked at once a line, and
+   every DEADLINE_CHECK_INTERVAL characters of a line. */
+#define DEADLINE_CHECK_INTERVAL 4096
+static double InputDeadline;
+static bool InputTimedOut;
+static bool (*InputInterruptCheck) (void);
+static bool InputInterrupted;
+static unsigned long CharsBeforeDeadlineCheck = ULONG_MAX;
+
+/* For --generated-input=shallow */
+static bool InputShallow;
+
 /*
 *   FUNCTION DEFINITIONS
 */
 
+extern void setInputFileDeadline (double deadline)
+{
+	InputDeadline = deadline;
+	if (deadline > 0.0)
+		InputTimedOut = false;
+	CharsBeforeDeadlineCheck = (deadline > 0.0 || InputInterruptCheck)
+		? DEADLINE_CHECK_INTERVAL: ULONG_MAX;
+}
+
+extern bool isInputFileTimedOut (void)
+{
+	return InputTimedOut;
+}
+
+extern void setInputFileInterruptCheck (bool (*check) (void))
+{
+	InputInterruptCheck = check;
+	InputTimedOut = false;
+	InputInterrupted = false;
+	CharsBeforeDeadlineCheck = (InputDeadline > 0.0 || check)
+		? DEADLINE_CHECK_INTERVAL: ULONG_MAX;
+}
+
+extern bool isInputFileInterrupted (void)
+{
+	return InputInterrupted;
+}
+
+extern void setInputFileShallow (bool shallow)
+{
+	InputShallow = shallow;
+}
+
+extern bool isInputFileShallow (void)
+{
+	return InputShallow;
+}
+
+static bool checkInputDeadline (void)
+{
+	if (InputDeadline > 0.0 || InputInterruptCheck)
+	{
+		CharsBeforeDeadlineCheck = DEADLINE_CHECK_INTERVAL;
+		if (InputTimedOut)
+			;
+		else if (InputDeadline > 0.0 && getTotalsClock () > InputDeadline)
+			InputTimedOut = true;
+		else if (InputInterruptCheck && InputInterruptCheck ())
+			InputTimedOut = InputInterrupted = true;
+	}
+	else
+		CharsBeforeDeadlineCheck = ULONG_MAX;
+	return InputTimedOut;
+}
+
+#ifdef ALLOC_PROFILING
+/* Like getInputLanguage (), but -1 when no input file is open. */
+static int getAllocLanguage (void)
+{
+	if (File.mio == NULL || File.input.langInfo.stack.count == 0)
+		return -1;
+	return langStackTop (&File.input.langInfo.stack);
+}
+#endif
+
 extern unsigned long getInputLineNumber (void)
 {
 	return File.input.lineNumber;
@@ -161,13 +277,24 @@ extern const char *getInputFileName (void)
 
 extern MIOPos getInputFilePosition (void)
 {
-	return File.filePosition.pos;
+	MIOPos pos;
+
+	mio_getpos_at_offset (File.mio, File.filePosition.offset, &pos);
+	return pos;
 }
 
 extern MIOPos getInputFilePositionForLine (unsigned int line)
 {
-	return File.lineFposMap.pos[(((File.lineFposMap.count > (line - 1)) \
-				      && (line > 0))? (line - 1): 0)].pos;
+	/* The lines of the map are those of the outermost stream. */
+	MIO *mio = BackupFile.mio? BackupFile.mio: File.mio;
+	MIOOffset offset = 0;
+	MIOPos pos;
+
+	if (File.lineFposMap.count > 0)
+		offset = getLineFposMapOffset (&File.lineFposMap,
+									   ((File.lineFposMap.count > (line - 1)) && (line > 0))? (line - 1): 0);
+	mio_getpos_at_offset (mio, offset, &pos);
+	return pos;
 }
 
 extern langType getInputLanguage (void)
@@ -270,16 +397,40 @@ extern const unsigned char *getInputFileData (size_t *size)
 	return mio_memory_get_data (File.mio, size);
 }
 
+static void freeLineOffsets (inputFile *f)
+{
+	if (f->lineOffsets)
+		eFree (f->lineOffsets);
+	f->lineOffsets = NULL;
+	f->lineOffsetCount = 0;
+	f->lineOffsetsMade = false;
+}
+
 /*
  * inputLineFposMap related functions
  */
+static void clearLineFposMap (inputLineFposMap *lineFposMap)
+{
+	unsigned int i;
+
+	for (i = 0; i * LINE_MAP_BLOCK_LINES < lineFposMap->count; i++)
+		if (lineFposMap->blocks [i].wideOffsets)
+		{
+			eFree (lineFposMap->blocks [i].wideOffsets);
+			lineFposMap->blocks [i].wideOffsets = NULL;
+		}
+	lineFposMap->count = 0;
+}
+
 static void freeLineFposMap (inputLineFposMap *lineFposMap)
 {
-	if (lineFposMap->pos)
+	if (lineFposMap->blocks)
 	{
-		eFree (lineFposMap->pos);
-		lineFposMap->pos = NULL;
-		lineFposMap->count = 0;
+		clearLineFposMap (lineFposMap);
+		eFree (lineFposMap->blocks);
+		lineFposMap->blocks = NULL;
+		eFree (lineFposMap->deltas);
+		lineFposMap->deltas = NULL;
 		lineFposMap->size = 0;
 	}
 }
@@ -287,7 +438,9 @@ static void freeLineFposMap (inputLineFposMap *lineFposMap)
 static void allocLineFposMap (inputLineFposMap *lineFposMap)
 {
 #define INITIAL_lineFposMap_LEN 256
-	lineFposMap->pos = xCalloc (INITIAL_lineFposMap_LEN, compoundPos);
+	lineFposMap->deltas = xMalloc (INITIAL_lineFposMap_LEN, uint32_t);
+	lineFposMap->blocks = xCalloc (INITIAL_lineFposMap_LEN / LINE_MAP_BLOCK_LINES,
+								   lineMapBlock);
 	lineFposMap->size = INITIAL_lineFposMap_LEN;
 	lineFposMap->count = 0;
 }
@@ -295,55 +448,112 @@ static void allocLineFposMap (inputLineFposMap *lineFposMap)
 static void appendLineFposMap (inputLineFposMap *lineFposMap, compoundPos *pos,
 							   bool crAdjustment)
 {
-	int lastCrAdjustment = 0;
+	const unsigned int n = lineFposMap->count % LINE_MAP_BLOCK_LINES;
+	lineMapBlock *block;
 
 	if (lineFposMap->size == lineFposMap->count)
 	{
+		const unsigned int blockCount = lineFposMap->size / LINE_MAP_BLOCK_LINES;
+
 		lineFposMap->size *= 2;
-		lineFposMap->pos = xRealloc (lineFposMap->pos,
-					     lineFposMap->size,
-					     compoundPos);
+		lineFposMap->deltas = xRealloc (lineFposMap->deltas,
+						lineFposMap->size, uint32_t);
+		lineFposMap->blocks = xRealloc (lineFposMap->blocks,
+						blockCount * 2, lineMapBlock);
+		memset (lineFposMap->blocks + blockCount, 0,
+				blockCount * sizeof (lineMapBlock));
 	}
 
-	if (lineFposMap->count != 0)
+	block = lineFposMap->blocks + lineFposMap->count / LINE_MAP_BLOCK_LINES;
+	if (n == 0)
 	{
-		lineFposMap->pos [lineFposMap->count - 1].open = false;
-		lastCrAdjustment = lineFposMap->pos [lineFposMap->count - 1].crAdjustment;
+		const lineMapBlock *previous = (lineFposMap->count == 0)? NULL: block - 1;
+		int cr = 0;
+
+		if (previous)
+		{
+			uint64_t bits;
+
+			cr = previous->crAdjustment;
+			for (bits = previous->crLines; bits; bits &= bits - 1)
+				cr++;
+		}
+		block->offset = pos->offset;
+		block->crAdjustment = cr;
+		block->crLines = 0;
 	}
 
-	lineFposMap->pos [lineFposMap->count] = *pos;
-	lineFposMap->pos [lineFposMap->count].open = true;
-	lineFposMap->pos [lineFposMap->count].crAdjustment
-		= lastCrAdjustment + ((crAdjustment)? 1: 0);
+	if (crAdjustment)
+		block->crLines |= ((uint64_t) 1) << n;
+
+	if (block->wideOffsets == NULL
+		&& (uint64_t) (pos->offset - block->offset) > UINT32_MAX)
+	{
+		unsigned int i;
+
+		block->wideOffsets = xMalloc (LINE_MAP_BLOCK_LINES, MIOOffset);
+		for (i = 0; i < n; i++)
+			block->wideOffsets [i] = block->offset
+				+ lineFposMap->deltas [lineFposMap->count - n + i];
+	}
+	if (block->wideOffsets)
+		block->wideOffsets [n] = pos->offset;
+	lineFposMap->deltas [lineFposMap->count] = (uint32_t) (pos->offset - block->offset);
 	lineFposMap->count++;
 }
 
-static int compoundPosForOffset (const void* oft, const void *p)
+static MIOOffset getLineFposMapOffset (const inputLineFposMap *lineFposMap, unsigned int line)
 {
-	long offset = *(long *)oft;
-	const compoundPos *pos = p;
-	const compoundPos *next = (compoundPos *)(((char *)pos) + sizeof (compoundPos));
+	const lineMapBlock *block = lineFposMap->blocks + line / LINE_MAP_BLOCK_LINES;
 
-	if (offset < (pos->offset - pos->crAdjustment))
-		return -1;
-	else if (((pos->offset - pos->crAdjustment) <= offset)
-		 && (pos->open
-		     || (offset < (next->offset - next->crAdjustment))))
-		return 0;
-	else
-		return 1;
+	if (block->wideOffsets)
+		return block->wideOffsets [line % LINE_MAP_BLOCK_LINES];
+	return block->offset + lineFposMap->deltas [line];
 }
 
-extern unsigned long getInputLineNumberForFileOffset(long offset)
+extern unsigned long getInputLineNumberForFileOffset(MIOOffset offset)
 {
-	compoundPos *p;
+	const inputLineFposMap *map = &File.lineFposMap;
+	const unsigned int blockCount = (map->count + LINE_MAP_BLOCK_LINES - 1) / LINE_MAP_BLOCK_LINES;
+	const lineMapBlock *block;
+	unsigned int low = 0, high = blockCount;
+	unsigned int line, end;
+	int cr;
 
-	p = bsearch (&offset, File.lineFposMap.pos, File.lineFposMap.count, sizeof (compoundPos),
-		     compoundPosForOffset);
-	if (p == NULL)
+	/* The offsets of the lines are compared without the CRs before them,
+	   the count of CRs of a line including its own one. The line is the
+	   last one starting at or before offset. */
+
+	/* The first block whose first line starts after offset */
+	while (low < high)
+	{
+		const unsigned int mid = low + (high - low) / 2;
+		const lineMapBlock *first = map->blocks + mid;
+		const int firstCr = first->crAdjustment + (int) (first->crLines & 1);
+
+		if (offset < first->offset - firstCr)
+			high = mid;
+		else
+			low = mid + 1;
+	}
+	if (low == 0)
 		return 1;	/* TODO: 0? */
-	else
-		return 1 + (p - File.lineFposMap.pos);
+
+	block = map->blocks + (low - 1);
+	line = (low - 1) * LINE_MAP_BLOCK_LINES;
+	end = line + LINE_MAP_BLOCK_LINES;
+	if (end > map->count)
+		end = map->count;
+	cr = block->crAdjustment + (int) (block->crLines & 1);
+	for (; line + 1 < end; line++)
+	{
+		const int nextCr = cr + (int) ((block->crLines >> ((line + 1) % LINE_MAP_BLOCK_LINES)) & 1);
+
+		if (offset < getLineFposMapOffset (map, line + 1) - nextCr)
+			break;
+		cr = nextCr;
+	}
+	return 1 + line;
 }
 
 /*
@@ -367,6 +577,21 @@ static void setOwnerDirectoryOfInputFile (const char *const fileName)
 	}
 }
 
+/*  The name of FILENAME as written in the input field of its tags. */
+extern vString *makeInputTagPath (const char *const fileName)
+{
+	if (Option.tagRelative == TREL_ALWAYS)
+		return vStringNewOwn (relativeFilename (fileName,
+												getTagFileDirectory ()));
+	else if (Option.tagRelative == TREL_NEVER)
+		return vStringNewOwn (absoluteFilename (fileName));
+	else if (Option.tagRelative == TREL_NO || isAbsolutePath (fileName))
+		return vStringNewInit (fileName);
+	else
+		return vStringNewOwn (relativeFilename (fileName,
+												getTagFileDirectory ()));
+}
+
 static void setInputFileParametersCommon (inputFileInfo *finfo, vString *const fileName,
 					  const langType language,
 					  void (* setLang) (inputLangInfo *, langType),
@@ -384,21 +609,7 @@ static void setInputFileParametersCommon (inputFileInfo *finfo, vString *const f
 			vStringDelete (finfo->tagPath);
 	}
 
-	if (0)
-		;
-	else if (  Option.tagRelative == TREL_ALWAYS )
-		finfo->tagPath =
-			vStringNewOwn (relativeFilename (vStringValue (fileName),
-							 getTagFileDirectory ()));
-	else if ( Option.tagRelative == TREL_NEVER )
-		finfo->tagPath =
-			vStringNewOwn (absoluteFilename (vStringValue (fileName)));
-	else if ( Option.tagRelative == TREL_NO || isAbsolutePath (vStringValue (fileName)) )
-		finfo->tagPath = vStringNewCopy (fileName);
-	else
-		finfo->tagPath =
-			vStringNewOwn (relativeFilename (vStringValue (fileName),
-							 getTagFileDirectory ()));
+	finfo->tagPath = makeInputTagPath (vStringValue (fileName));
 
 	finfo->isHeader = isIncludeFile (vStringValue (fileName));
 
@@ -577,43 +788,75 @@ static bool parseLineDirective (char *s)
 /*
  *   Input file I/O operations
  */
-#ifdef DEBUG
-#define MAX_IN_MEMORY_FILE_SIZE 0
-#else
-#define MAX_IN_MEMORY_FILE_SIZE (1024*1024)
-#endif
 
-extern MIO *getMio (const char *const fileName, const char *const openMode,
-		    bool memStreamRequired)
+/*  The directory read by the recursion, opened as FD, so that its
+ *  entries are looked up from it rather than through their whole paths.
+ */
+static struct sInputDirectory {
+	int fd;
+	const char *name;
+} InputDirectory = { -1, NULL };
+
+extern void setInputDirectory (int fd, const char *const dirName)
 {
-	FILE *src;
-	fileStatus *st;
-	unsigned long size;
-	unsigned char *data;
+	InputDirectory.fd = fd;
+	InputDirectory.name = dirName;
+}
 
-	st = eStat (fileName);
-	size = st->size;
-	eStatFree (st);
-	if ((!memStreamRequired)
-	    && (size > MAX_IN_MEMORY_FILE_SIZE || size == 0))
-		return mio_new_file (fileName, openMode);
+extern int getInputDirectory (const char **dirName)
+{
+	*dirName = InputDirectory.name;
+	return InputDirectory.fd;
+}
 
-	src = fopen (fileName, openMode);
-	if (!src)
+extern const char *getInputDirectoryEntry (const char *const fileName, int *fd)
+{
+	if (InputDirectory.fd < 0)
 		return NULL;
+	*fd = InputDirectory.fd;
+	return entryNameInDirectory (fileName, InputDirectory.name);
+}
+
+extern fileStatus *eStatInputFile (const char *const fileName)
+{
+	int dirFd;
+	const char *const name = getInputDirectoryEntry (fileName, &dirFd);
+
+	return name? eStatAt (dirFd, name, fileName): eStat (fileName);
+}
+
+static MIO *mapInputFile (const char *const fileName)
+{
+#ifdef HAVE_OPENAT
+	int dirFd;
+	const char *const name = getInputDirectoryEntry (fileName, &dirFd);
 
-	data = eMalloc (size);
-	if (fread (data, 1, size, src) != size)
+	if (name)
 	{
-		eFree (data);
-		fclose (src);
-		if (memStreamRequired)
-			return NULL;
-		else
-			return mio_new_file (fileName, openMode);
+		int fd = openat (dirFd, name, O_RDONLY);
+		return (fd < 0)? NULL: mio_new_mapped_fd (fd, fileName);
 	}
-	fclose (src);
-	return mio_new_memory (data, size, eRealloc, eFree);
+#endif
+	return mio_new_mapped_file (fileName);
+}
+
+/*  Input files are read through in-memory streams: regular files are
+ *  mapped, others are read entirely (see mio_new_mapped_file ()), and
+ *  compressed files are decompressed (see decompressInput ()).
+ *  OPENMODE and MEMSTREAMREQUIRED are kept for the callers: the stream
+ *  returned is always a memory stream.
+ */
+extern MIO *getMio (const char *const fileName, const char *const openMode CTAGS_ATTR_UNUSED,
+		    bool memStreamRequired CTAGS_ATTR_UNUSED)
+{
+	MIO *mio;
+
+	beginTotalsPhase (PHASE_READING);
+	beginTraceSpan ("read", fileName, NULL);
+	mio = decompressInput (mapInputFile (fileName), fileName);
+	endTraceSpan ();
+	endTotalsPhase ();
+	return mio;
 }
 
 /* Return true if utf8 BOM is found */
@@ -656,6 +899,10 @@ extern bool openInputFile (const char *const fileName, const langType language,
 	bool opened = false;
 	bool memStreamRequired;
 
+#ifdef ALLOC_PROFILING
+	setAllocLanguageFunc (getAllocLanguage);
+#endif
+
 	/*	If another file was already open, then close it.
 	 */
 	if (File.mio != NULL)
@@ -663,6 +910,7 @@ extern bool openInputFile (const char *const fileName, const langType language,
 		mio_free (File.mio);  /* close any open input file */
 		File.mio = NULL;
 	}
+	File.allLinesMio = NULL;
 
 	/* File position is used as key for checking the availability of
 	   pattern cache in entry.h. If an input file is changed, the
@@ -699,8 +947,6 @@ extern bool openInputFile (const char *const fileName, const langType language,
 		File.bomFound = checkUTF8BOM (File.mio, true);
 
 		setOwnerDirectoryOfInputFile (fileName);
-		mio_getpos (File.mio, &StartOfLine.pos);
-		mio_getpos (File.mio, &File.filePosition.pos);
 		File.filePosition.offset = StartOfLine.offset = mio_tell (File.mio);
 		File.currentLine  = NULL;
 
@@ -716,6 +962,7 @@ extern bool openInputFile (const char *const fileName, const langType language,
 		allocLineFposMap (&File.lineFposMap);
 
 		File.thinDepth = 0;
+		File.lineHooksLanguage = LANG_AUTO;
 		verbose ("OPENING%s %s as %s language %sfile [%s%s]\n",
 				 (File.bomFound? "(skipping utf-8 bom)": ""),
 				 fileName,
@@ -732,8 +979,6 @@ extern void resetInputFile (const langType language)
 	Assert (File.mio);
 
 	rewindInputFile  (&File);
-	mio_getpos (File.mio, &StartOfLine.pos);
-	mio_getpos (File.mio, &File.filePosition.pos);
 	File.filePosition.offset = StartOfLine.offset = mio_tell (File.mio);
 	File.currentLine  = NULL;
 
@@ -742,8 +987,14 @@ extern void resetInputFile (const langType language)
 
 	resetLangOnStack (& (File.input.langInfo), language);
 	File.input.lineNumber = File.input.lineNumberOrigin;
+	File.lineHooksLanguage = LANG_AUTO;
 	setLangToType (& (File.source.langInfo), language);
 	File.source.lineNumber = File.source.lineNumberOrigin;
+
+	/* The lines are read again from the first one. A nested stream
+	   shares the map of the stream it is in, and adds no line to it. */
+	if (BackupFile.mio == NULL)
+		clearLineFposMap (&File.lineFposMap);
 }
 
 extern void closeInputFile (void)
@@ -757,12 +1008,14 @@ extern void closeInputFile (void)
 		 */
 		if (Option.printTotals)
 		{
-			fileStatus *status = eStat (vStringValue (File.input.name));
+			fileStatus *status = eStatInputFile (vStringValue (File.input.name));
 			addTotals (0, File.input.lineNumber - 1L, status->size);
 		}
 		mio_free (File.mio);
 		File.mio = NULL;
+		File.allLinesMio = NULL;
 		freeLineFposMap (&File.lineFposMap);
+		freeLineOffsets (&File);
 	}
 }
 
@@ -803,12 +1056,78 @@ typedef enum eEolType {
 	eol_cr_nl,
 } eolType;
 
+/*  Copy the line at START, of at most AVAILABLE bytes, into VLINE with its
+ *  line break turned into a canonical form, as readLine () does. Return
+ *  false for what only readLine () handles: the end of the stream, and
+ *  lines with nul bytes, which mio_gets () callers see truncated and
+ *  joined with the next line.
+ */
+static bool copyLineFromMemory (vString *const vLine, const unsigned char *const start,
+								size_t available, eolType *r)
+{
+	const unsigned char *nl;
+	size_t length;
+
+	if (available == 0)
+		return false;
+
+	nl = memchr (start, '\n', available);
+	length = nl? (size_t) (nl - start) + 1: available;
+	if (memchr (start, '\0', length) != NULL)
+		return false;
+
+	if (length + 1 > vStringSize (vLine))
+		vStringResize (vLine, length + 1);
+	memcpy (vStringValue (vLine), start, length);
+	vStringValue (vLine) [length] = '\0';
+	vStringLength (vLine) = length;
+
+	if (nl == NULL)
+		*r = eol_eof;
+	else if (length > 1 && vStringItem (vLine, length - 2) == '\r')
+	{
+		vStringItem (vLine, length - 2) = '\n';
+		vStringChop (vLine);
+		*r = eol_cr_nl;
+	}
+	else
+		*r = eol_nl;
+	return true;
+}
+
+/*  Fast path of readLine () for memory streams: find the end of the line
+ *  with memchr () and copy the line at once. Return false to let
+ *  readLine () handle the cases this doesn't: the end of the stream, a
+ *  pushed back character, and lines with nul bytes.
+ */
+static bool readLineFromMemory (vString *const vLine, MIO *const mio, eolType *r)
+{
+	const unsigned char *start;
+	size_t available;
+	size_t length;
+
+	start = mio_memory_peek (mio, &available);
+	if (start == NULL || ! copyLineFromMemory (vLine, start, available, r))
+		return false;
+
+	length = (size_t) ((*r == eol_cr_nl)? vStringLength (vLine) + 1: vStringLength (vLine));
+	mio_seek (mio, (MIOOffset) length, SEEK_CUR);
+
+	/* Like mio_gets (), set the end-of-stream indicator */
+	if (*r == eol_eof)
+		mio_getc (mio);
+	return true;
+}
+
 static eolType readLine (vString *const vLine, MIO *const mio)
 {
 	char *str;
 	size_t size;
 	eolType r = eol_nl;
 
+	if (readLineFromMemory (vLine, mio, &r))
+		return r;
+
 	vStringClear (vLine);
 
 	str = vStringValue (vLine);
@@ -852,16 +1171,125 @@ static eolType readLine (vString *const vLine, MIO *const mio)
 	return r;
 }
 
+/* Tell whether the lines to be read from the current position are the
+   content of the memory stream as is: readLine turns CR-LF into LF, and
+   a NUL character ends a line read with mio_gets. */
+static bool areLinesInMemory (void)
+{
+#ifdef REG_STARTEND
+	size_t size;
+	const unsigned char *data = mio_memory_get_data (File.mio, &size);
+	MIOOffset offset = mio_tell (File.mio);
+
+	if (data == NULL || offset < 0 || (size_t) offset > size)
+		return false;
+
+	const unsigned char *p = data + offset;
+	const unsigned char *const end = data + size;
+
+	if (memchr (p, '\0', end - p))
+		return false;
+	while ((p = memchr (p, '\r', end - p)) != NULL)
+	{
+		if (++p < end && *p == '\n')
+			return false;
+	}
+	return true;
+#else
+	/* regexec needs an input terminated by NUL. */
+	return false;
+#endif
+}
+
+static void matchMultilineRegexOnAllLines (void)
+{
+	const char *input;
+	size_t length;
+
+	if (File.allLinesMio == File.mio)
+	{
+		size_t size;
+
+		input = (const char *) mio_memory_get_data (File.mio, &size)
+			+ File.allLinesOffset;
+		length = size - File.allLinesOffset;
+	}
+	else
+	{
+		input = vStringValue (File.allLines);
+		length = vStringLength (File.allLines);
+	}
+
+	matchLanguageMultilineRegex (getInputLanguage (), input, length);
+	matchLanguageMultitableRegex (getInputLanguage (), input, length);
+
+	if (File.allLinesMio == File.mio)
+		File.allLinesMio = NULL;
+	else
+	{
+		vStringDelete (File.allLines);
+		File.allLines = NULL;
+	}
+}
+
+enum eLineHook {
+	LINE_HOOK_DIRECTIVES = 1 << 0,	/* --line-directives */
+	LINE_HOOK_REGEX      = 1 << 1,	/* matchLanguageRegex () */
+	LINE_HOOK_MULTILINE  = 1 << 2,	/* File.allLines for the multiline regex */
+};
+
+static unsigned int getLineHooks (void)
+{
+	const langType language = getInputLanguage ();
+
+	if (File.lineHooksLanguage != language)
+	{
+		File.lineHooks = 0;
+		if (Option.lineDirectives)
+			File.lineHooks |= LINE_HOOK_DIRECTIVES;
+		if (hasLanguageRegexPatterns (language))
+			File.lineHooks |= LINE_HOOK_REGEX;
+		if (hasLanguageMultilineRegexPatterns (language))
+			File.lineHooks |= LINE_HOOK_MULTILINE;
+		File.lineHooksLanguage = language;
+	}
+	return File.lineHooks;
+}
+
 static vString *iFileGetLine (void)
 {
 	eolType eol;
-	bool use_multiline = hasLanguageMultilineRegexPatterns (getInputLanguage ());
+	const unsigned int hooks = getLineHooks ();
+	const bool use_multiline = (hooks & LINE_HOOK_MULTILINE);
 
 	if (File.line == NULL)
 		File.line = vStringNew ();
 
-	if (use_multiline && File.allLines == NULL)
-		File.allLines = vStringNew ();
+	/* The rest of the file is not read, nor given to the multiline
+	   regex parsers. */
+	if (checkInputDeadline ())
+	{
+		if (File.allLinesMio == File.mio)
+			File.allLinesMio = NULL;
+		else if (File.allLines)
+		{
+			vStringDelete (File.allLines);
+			File.allLines = NULL;
+		}
+		vStringClear (File.line);
+		return NULL;
+	}
+
+	if (use_multiline && File.allLines == NULL && File.allLinesMio != File.mio)
+	{
+		if (areLinesInMemory ())
+		{
+			File.allLinesMio = File.mio;
+			File.allLinesOffset = mio_tell (File.mio);
+		}
+		else
+			File.allLines = vStringNew ();
+	}
 
 	eol = readLine (File.line, File.mio);
 
@@ -870,14 +1298,14 @@ static vString *iFileGetLine (void)
 		/* Use StartOfLine from previous iFileGetLine() call */
 		fileNewline (eol == eol_cr_nl);
 		/* Store StartOfLine for the next iFileGetLine() call */
-		mio_getpos (File.mio, &StartOfLine.pos);
 		StartOfLine.offset = mio_tell (File.mio);
 
-		if (Option.lineDirectives && vStringChar (File.line, 0) == '#')
+		if ((hooks & LINE_HOOK_DIRECTIVES) && vStringChar (File.line, 0) == '#')
 			parseLineDirective (vStringValue (File.line) + 1);
-		matchLanguageRegex (getInputLanguage (), File.line);
+		if (hooks & LINE_HOOK_REGEX)
+			matchLanguageRegex (getInputLanguage (), File.line);
 
-		if (use_multiline)
+		if (use_multiline && File.allLines)
 			vStringCat (File.allLines, File.line);
 
 		return File.line;
@@ -885,12 +1313,7 @@ static vString *iFileGetLine (void)
 	else
 	{
 		if (use_multiline)
-		{
-			matchLanguageMultilineRegex (getInputLanguage (), File.allLines);
-			matchLanguageMultitableRegex (getInputLanguage (), File.allLines);
-			vStringDelete (File.allLines);
-			File.allLines = NULL;
-		}
+			matchMultilineRegexOnAllLines ();
 		return NULL;
 	}
 }
@@ -917,6 +1340,12 @@ extern int getcFromInputFile (void)
 			c = *File.currentLine++;
 			if (c == '\0')
 				File.currentLine = NULL;
+			else if (--CharsBeforeDeadlineCheck == 0 && checkInputDeadline ())
+			{
+				/* iFileGetLine () returns NULL from now on. */
+				File.currentLine = NULL;
+				c = '\0';
+			}
 		}
 		else
 		{
@@ -956,6 +1385,79 @@ extern int skipToCharacterInInputFile (int c)
 	return d;
 }
 
+/*  Make KLASS hold the characters of CHARS, or with COMPLEMENT, all the
+ *  characters but those of CHARS. The nul character is never a member.
+ */
+extern void initInputCharClass (inputCharClass *klass, const char *chars, bool complement)
+{
+	unsigned int c;
+
+	for (c = 0; c < ARRAY_SIZE (klass->members); c++)
+		klass->members [c] = complement;
+	for (; *chars != '\0'; chars++)
+		klass->members [(unsigned char) *chars] = !complement;
+	klass->members [0] = false;
+}
+
+/*  Scan the current line directly instead of calling getcFromInputFile ()
+ *  for each character. Characters pushed back with ungetcToInputFile ()
+ *  are read first; at the end of a line, the next line is read just like
+ *  getcFromInputFile () would.
+ */
+extern size_t readInputCharsInClass (const inputCharClass *klass, vString *const vstr)
+{
+	size_t count = 0;
+
+	for (;;)
+	{
+		const unsigned char *start;
+		const unsigned char *p;
+
+		if (File.ungetchIdx > 0)
+		{
+			const int c = File.ungetchBuf[File.ungetchIdx - 1];
+
+			if (c < 0 || c > 0xff || !klass->members [c])
+				break;
+			File.ungetchIdx--;
+			if (vstr)
+				vStringPut (vstr, c);
+			count++;
+			continue;
+		}
+
+		if (File.currentLine == NULL)
+		{
+			vString* const line = iFileGetLine ();
+			if (line == NULL)
+				break;
+			File.currentLine = (unsigned char*) vStringValue (line);
+		}
+
+		start = p = File.currentLine;
+		while (klass->members [*p])
+			p++;
+		if (vstr)
+			vStringNCatSUnsafe (vstr, (const char *) start, p - start);
+		count += p - start;
+		DebugStatement ( for (; start < p; start++) debugPutc (DEBUG_READ, *start); )
+
+		if (*p == '\0')
+			File.currentLine = NULL;
+		else
+		{
+			File.currentLine = (unsigned char*) p;
+			break;
+		}
+	}
+	return count;
+}
+
+extern size_t skipInputCharsInClass (const inputCharClass *klass)
+{
+	return readInputCharsInClass (klass, NULL);
+}
+
 /*  An alternative interface to getcFromInputFile (). Do not mix use of readLineFromInputFile()
  *  and getcFromInputFile() for the same file. The returned string does not contain
  *  the terminating newline. A NULL return value means that all lines in the
@@ -974,6 +1476,136 @@ extern const unsigned char *readLineFromInputFile (void)
 	return result;
 }
 
+/*  Skip the lines for which WANTED returns false, as readLineFromInputFile ()
+ *  would read them, but only looking at them for their line breaks in the
+ *  memory of the input stream, without copying them. This is done only
+ *  when nothing else wants to see each line; the lines left for the
+ *  caller to read may not be wanted either.
+ */
+static void skipUnwantedLinesInMemory (inputLineWantedFn wanted, void *data)
+{
+	const unsigned char *start;
+	size_t available;
+
+	if (getLineHooks () == 0 && ! checkInputDeadline ()
+		&& (start = mio_memory_peek (File.mio, &available)) != NULL)
+	{
+		const unsigned char *p = start;
+		const unsigned char *const end = start + available;
+
+		while (p < end)
+		{
+			const unsigned char *nl = memchr (p, '\n', end - p);
+			const unsigned char *const next = nl? nl + 1: end;
+
+			/* Lines with nul bytes are for readLine () to split */
+			if (memchr (p, '\0', next - p) != NULL)
+				break;
+			if (wanted (p, next - p, data))
+				break;
+
+			fileNewline (nl && nl > p && nl [-1] == '\r');
+			StartOfLine.offset += (MIOOffset) (next - p);
+			p = next;
+		}
+		mio_seek (File.mio, (MIOOffset) (p - start), SEEK_CUR);
+	}
+}
+
+static bool isLineWithPrefix (const unsigned char *line, size_t length, void *data)
+{
+	const char *const prefix = data;
+	const size_t prefixLength = strlen (prefix);
+
+	/* The prefix cannot hold a line break */
+	return length >= prefixLength && memcmp (line, prefix, prefixLength) == 0;
+}
+
+/*  Read lines with readLineFromInputFile () until one starting with
+ *  PREFIX, and return that line, or NULL at the end of file. The lines
+ *  before it are only looked at for their line breaks. When nothing else
+ *  wants to see each line, this is done directly in the memory of the
+ *  input stream, without copying the lines.
+ */
+extern const unsigned char *readLineWithPrefixFromInputFile (const char *const prefix)
+{
+	const size_t prefixLength = strlen (prefix);
+	const unsigned char *line;
+
+	skipUnwantedLinesInMemory (isLineWithPrefix, (void *) prefix);
+	while ((line = readLineFromInputFile ()) != NULL
+		   && strncmp ((const char *) line, prefix, prefixLength) != 0)
+		;
+	return line;
+}
+
+/* The white spaces but the line break */
+static bool isBlankInLine (int c)
+{
+	return c == ' ' || c == '\t' || c == '\r' || c == '\f' || c == '\v';
+}
+
+static bool isLineStartingInClass (const unsigned char *line, size_t length, void *data)
+{
+	const inputCharClass *const klass = data;
+	const unsigned char *const end = line + length;
+
+	while (line < end && isBlankInLine (*line))
+		line++;
+	return line < end && klass->members [*line];
+}
+
+static bool isLineStartingInClassAtColumn0 (const unsigned char *line, size_t length, void *data)
+{
+	const inputCharClass *const klass = data;
+
+	return length > 0 && klass->members [*line];
+}
+
+/*  Read lines with readLineFromInputFile () until one starting with a
+ *  character in KLASS, after the blanks at its start if SKIP_BLANKS, and
+ *  return that line, or NULL at the end of file. Like
+ *  readLineWithPrefixFromInputFile (), the lines before it are skipped in
+ *  memory when possible.
+ */
+extern const unsigned char *readLineStartingInClassFromInputFile (const inputCharClass *klass,
+																  bool skipBlanks)
+{
+	const unsigned char *line;
+
+	skipUnwantedLinesInMemory (skipBlanks? isLineStartingInClass: isLineStartingInClassAtColumn0,
+							   (void *) klass);
+	while ((line = readLineFromInputFile ()) != NULL)
+	{
+		const unsigned char *p = line;
+
+		if (skipBlanks)
+			while (isBlankInLine (*p))
+				p++;
+		if (klass->members [*p])
+			break;
+	}
+	return line;
+}
+
+/*  Read lines with readLineFromInputFile () until one WANTED returns true
+ *  for, and return that line, or NULL at the end of file. WANTED is called
+ *  once for each line, in order; the LINE it is given is not terminated,
+ *  and its LENGTH may count the line break. Like
+ *  readLineWithPrefixFromInputFile (), the lines before the one wanted
+ *  are skipped in memory when possible.
+ */
+extern const unsigned char *readWantedLineFromInputFile (inputLineWantedFn wanted, void *data)
+{
+	const unsigned char *line;
+
+	skipUnwantedLinesInMemory (wanted, data);
+	while ((line = readLineFromInputFile ()) != NULL
+		   && ! wanted (line, strlen ((const char *) line), data))
+		;
+	return line;
+}
+
 /*
  *   Raw file line reading with automatic buffer sizing
  */
@@ -997,10 +1629,26 @@ extern char *readLineRaw (vString *const vLine, MIO *const mio)
  *  "location".
  */
 extern char *readLineFromBypass (
-		vString *const vLine, MIOPos location, long *const pSeekValue)
+		vString *const vLine, MIOPos location, MIOOffset *const pSeekValue)
 {
 	MIOPos orignalPosition;
 	char *result;
+	const unsigned char *start;
+	size_t available;
+	eolType r;
+
+	/* Slice the line out of a memory stream without moving in it. */
+	start = mio_memory_peek_at (File.mio, &location, &available);
+	if (start != NULL && copyLineFromMemory (vLine, start, available, &r))
+	{
+		if (pSeekValue != NULL)
+			*pSeekValue = (MIOOffset) (start - mio_memory_get_data (File.mio, NULL));
+#ifdef HAVE_ICONV
+		if (isConverting ())
+			convertString (vLine);
+#endif
+		return vStringLength (vLine) > 0 ? vStringValue (vLine) : NULL;
+	}
 
 	mio_getpos (File.mio, &orignalPosition);
 	mio_setpos (File.mio, &location);
@@ -1015,6 +1663,84 @@ extern char *readLineFromBypass (
 	return result;
 }
 
+/* Record the offset of each line of the memory stream of the input file,
+   as readLineRaw () reads the lines from the start. The lines are not
+   recorded when readLineRaw () splits them differently: when they have
+   NUL characters. */
+static void makeLineOffsets (void)
+{
+	size_t size;
+	const unsigned char *data;
+	const unsigned char *p, *end;
+	unsigned long allocated;
+	MIOPos originalPosition;
+	MIOOffset start;
+
+	File.lineOffsetsMade = true;
+	data = mio_memory_get_data (File.mio, &size);
+	if (data == NULL)
+		return;
+
+	mio_getpos (File.mio, &originalPosition);
+	rewindInputFile (&File);
+	start = mio_tell (File.mio);
+	mio_setpos (File.mio, &originalPosition);
+	if (start < 0 || (size_t) start > size)
+		return;
+
+	p = data + start;
+	end = data + size;
+	if (memchr (p, '\0', end - p) != NULL)
+		return;
+
+	allocated = 256;
+	File.lineOffsets = xMalloc (allocated, MIOOffset);
+	while (p < end)
+	{
+		const unsigned char *nl = memchr (p, '\n', end - p);
+
+		if (File.lineOffsetCount == allocated)
+		{
+			allocated *= 2;
+			File.lineOffsets = xRealloc (File.lineOffsets, allocated, MIOOffset);
+		}
+		File.lineOffsets [File.lineOffsetCount++] = (MIOOffset) (p - data);
+		if (nl == NULL)
+			break;
+		p = nl + 1;
+	}
+}
+
+/* Copy the line LINENUMBER of the input file into VLINE, and return its
+   offset, or -1 if it has no offsets recorded. */
+static MIOOffset readLineAtLineNumber (vString *const vLine, unsigned long lineNumber, char **line)
+{
+	const unsigned char *data;
+	size_t size;
+	MIOOffset offset;
+	eolType r;
+
+	if (!File.lineOffsetsMade)
+		makeLineOffsets ();
+	if (File.lineOffsets == NULL)
+		return -1;
+
+	*line = NULL;
+	if (lineNumber == 0 || lineNumber > File.lineOffsetCount)
+		return 0;
+
+	data = mio_memory_get_data (File.mio, &size);
+	offset = File.lineOffsets [lineNumber - 1];
+	if (!copyLineFromMemory (vLine, data + offset, size - offset, &r))
+		return -1;
+#ifdef HAVE_ICONV
+	if (isConverting ())
+		convertString (vLine);
+#endif
+	*line = vStringLength (vLine) > 0 ? vStringValue (vLine) : NULL;
+	return offset;
+}
+
 /* If a xcmd parser is used, ctags cannot know the location for a tag.
  * In the other hand, etags output and cross reference output require the
  * line after the location.
@@ -1025,7 +1751,7 @@ extern char *readLineFromBypass (
 extern char *readLineFromBypassSlow (vString *const vLine,
 				 unsigned long lineNumber,
 				 const char *pattern,
-				 long *const pSeekValue)
+				 MIOOffset *const pSeekValue)
 {
 	char *result = NULL;
 
@@ -1033,7 +1759,7 @@ extern char *readLineFromBypassSlow (vString *const vLine,
 	MIOPos originalPosition;
 	char *line;
 	size_t len;
-	long pos;
+	MIOOffset pos;
 
 	regex_t patbuf;
 	char lastc;
@@ -1068,15 +1794,19 @@ extern char *readLineFromBypassSlow (vString *const vLine,
 		unsigned long n;
 
 		mio_getpos (File.mio, &originalPosition);
-		rewindInputFile (&File);
-		line = NULL;
-		pos = 0;
-		for (n = 0; n < lineNumber; n++)
+		pos = readLineAtLineNumber (vLine, lineNumber, &line);
+		if (pos < 0)
 		{
-			pos = mio_tell (File.mio);
-			line = readLineRaw (vLine, File.mio);
-			if (line == NULL)
-				break;
+			rewindInputFile (&File);
+			line = NULL;
+			pos = 0;
+			for (n = 0; n < lineNumber; n++)
+			{
+				pos = mio_tell (File.mio);
+				line = readLineRaw (vLine, File.mio);
+				if (line == NULL)
+					break;
+			}
 		}
 		if (line == NULL)
 			goto out;
@@ -1120,7 +1850,7 @@ extern void   pushNarrowedInputStream (
 				       unsigned long endLine, long endCharOffset,
 				       unsigned long sourceLineOffset)
 {
-	long p, q;
+	MIOOffset p, q;
 	MIOPos original;
 	MIOPos tmp;
 	MIO *subio;
@@ -1158,6 +1888,9 @@ extern void   pushNarrowedInputStream (
 	BackupFile = File;
 
 	File.mio = subio;
+	File.lineOffsets = NULL;
+	File.lineOffsetCount = 0;
+	File.lineOffsetsMade = false;
 	File.bomFound = false;
 	File.nestedInputStreamInfo.startLine = startLine;
 	File.nestedInputStreamInfo.startCharOffset = startCharOffset;
@@ -1203,6 +1936,7 @@ extern void   popNarrowedInputStream  (void)
 		return;
 	}
 	mio_free (File.mio);
+	freeLineOffsets (&File);
 	File = BackupFile;
 	memset (&BackupFile, 0, sizeof (BackupFile));
 }
@@ -48,6 +48,13 @@ enum eCharacters {
 	CHAR_SYMBOL   = ('C' + 0xff)
 };
 
+/* A set of bytes, for reading spans of the input with
+   skipInputCharsInClass () and readInputCharsInClass ().
+   members['\0'] must stay false. */
+typedef struct sInputCharClass {
+	bool members [256];
+} inputCharClass;
+
 
 /*
 *   FUNCTION PROTOTYPES
@@ -88,13 +95,55 @@ extern MIO *getMio (const char *const fileName, const char *const openMode,
 				    bool memStreamRequired);
 extern void resetInputFile (const langType language);
 
+/* The recursion reads DIRNAME, opened as FD, or no directory if FD is -1:
+   getMio () opens its entries relative to FD. */
+extern void setInputDirectory (int fd, const char *const dirName);
+extern int getInputDirectory (const char **dirName);
+/* Return the name of FILENAME in the directory given to setInputDirectory (),
+   opened as *FD, or NULL if FILENAME is not one of its entries. */
+extern const char *getInputDirectoryEntry (const char *const fileName, int *fd);
+/* eStat () for an input file, from the directory given to setInputDirectory ()
+   if FILENAME is one of its entries. */
+extern fileStatus *eStatInputFile (const char *const fileName);
+
 extern void closeInputFile (void);
 extern void *getInputFileUserData(void);
+
+/* For --file-time-limit: past DEADLINE, a clock of getTotalsClock (),
+   the input file reads as if it ended. 0 means no deadline.
+   isInputFileTimedOut () tells whether the last file given a deadline
+   was cut, until a new deadline is set. */
+extern void setInputFileDeadline (double deadline);
+extern bool isInputFileTimedOut (void);
+/* For interactive mode: CHECK is called now and then while input files
+   are read, and the file being read reads as if it ended once CHECK
+   returns true. isInputFileTimedOut () is true then too, and
+   isInputFileInterrupted () tells the cut from a deadline. Each call,
+   with NULL to remove CHECK, forgets a cut. */
+extern void setInputFileInterruptCheck (bool (*check) (void));
+extern bool isInputFileInterrupted (void);
+/* For --generated-input=shallow: only the top-level declarations of the
+   input file are tagged. Parsers may skip what could only make tags with
+   a scope. */
+extern void setInputFileShallow (bool shallow);
+extern bool isInputFileShallow (void);
 extern int getcFromInputFile (void);
 extern int getNthPrevCFromInputFile (unsigned int nth, int def);
 extern int skipToCharacterInInputFile (int c);
 extern void ungetcToInputFile (int c);
 extern const unsigned char *readLineFromInputFile (void);
+extern const unsigned char *readLineWithPrefixFromInputFile (const char *const prefix);
+extern const unsigned char *readLineStartingInClassFromInputFile (const inputCharClass *klass,
+																  bool skipBlanks);
+typedef bool (* inputLineWantedFn) (const unsigned char *line, size_t length, void *data);
+extern const unsigned char *readWantedLineFromInputFile (inputLineWantedFn wanted, void *data);
+
+/* Bulk alternatives to getcFromInputFile (): consume the characters in
+   KLASS that follow, and return how many were consumed. The first
+   character not in KLASS is left to be read. */
+extern void initInputCharClass (inputCharClass *klass, const char *chars, bool complement);
+extern size_t skipInputCharsInClass (const inputCharClass *klass);
+extern size_t readInputCharsInClass (const inputCharClass *klass, vString *const vstr);
 
 enum nestedInputBoundaryFlag {
 	BOUNDARY_START = 1UL << 0,
@@ -103,6 +152,7 @@ enum nestedInputBoundaryFlag {
 extern unsigned int getNestedInputBoundaryInfo (unsigned long lineNumber);
 
 extern const char *getSourceFileTagPath (void);
+extern vString *makeInputTagPath (const char *const fileName);
 extern langType getSourceLanguage (void);
 extern unsigned long getSourceLineNumber (void);
 
@@ -110,9 +160,9 @@ extern unsigned long getSourceLineNumber (void);
 extern char *readLineRaw (vString *const vLine, MIO *const mio);
 
 /* Bypass: reading from fp in inputFile WITHOUT updating fields in input fields */
-extern char *readLineFromBypass (vString *const vLine, MIOPos location, long *const pSeekValue);
+extern char *readLineFromBypass (vString *const vLine, MIOPos location, MIOOffset *const pSeekValue);
 extern char *readLineFromBypassSlow (vString *const vLine, unsigned long lineNumber,
-				     const char *pattern, long *const pSeekValue);
+				     const char *pattern, MIOOffset *const pSeekValue);
 
 extern void   pushNarrowedInputStream (
 				       unsigned long startLine, long startCharOffset,
@@ -123,7 +173,7 @@ extern void   popNarrowedInputStream  (void);
 extern void     pushLanguage(const langType language);
 extern langType popLanguage (void);
 
-extern unsigned long getInputLineNumberForFileOffset(long offset);
+extern unsigned long getInputLineNumberForFileOffset(MIOOffset offset);
 
 #define THIN_STREAM_SPEC 0, 0, 0, 0, 0
 extern bool isThinStreamSpec(unsigned long startLine, long startCharOffset,
@@ -0,0 +1,1337 @@
+/*
+*   Copyright (c) 2026, Universal Ctags Team
+*
+*   This source code is released for free distribution under the terms of the
+*   GNU General Public License version 2 or (at your option) any later version.
+*
+*   Defines a set of regular expressions telling, in one pass over a
+*   line, which of them match it.
+*
+*   The extended regular expressions added to a set are parsed and put
+*   together in one Thompson NFA. A line is run through the DFA of the
+*   NFA, whose states are made lazily, the first time they are reached,
+*   and kept in a bounded cache; so the cost of a line mostly depends on
+*   its length, not on the number of regular expressions. Only whether
+*   a regular expression matches is computed: the caller runs regexec on
+*   the ones matching for their submatches.
+*
+*   A regular expression simple enough to be matched without choices,
+*   like most of those of optlib parsers, can also be made a program
+*   running in place of regexec, submatches included.
+*
+*   The constructs found in the patterns of optlib parsers are
+*   supported the way the regex of GNU libc runs them in the C locale;
+*   a regular expression using another one, like a back reference or a
+*   word boundary, is refused.
+*/
+
+/*
+*   INCLUDE FILES
+*/
+#include "general.h"  /* must always come first */
+
+#include <ctype.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#ifdef HAVE_SYS_TYPES_H
+# include <sys/types.h>  /* declare off_t (not known to regex.h on FreeBSD) */
+#endif
+#include <regex.h>
+
+#include "htable.h"
+#include "regexset.h"
+#include "routines.h"
+
+/*
+*   MACROS
+*/
+#define NFA_NONE ((unsigned int)-1)
+#define MAX_NFA_NODES 65536
+#define MAX_REPEAT 255			/* larger intervals are left to regexec */
+
+#define MAX_DFA_STATES 2048
+#define DFA_STATE_TABLE_SIZE 1021
+#define DFA_UNKNOWN -1
+/* If the cache is flushed again before this many bytes per state are
+   scanned, the set is given up. */
+#define MIN_BYTES_PER_STATE 16
+
+/* A program gives up after scanning this many times the bytes of a
+   text, trying one offset after another. */
+#define PROGRAM_SCAN_FACTOR 8
+
+/*
+*   DATA DECLARATIONS
+*/
+typedef struct sCharSet {
+	uint32_t bits [256 / 32];
+} charSet;
+
+enum nfaOp {
+	NFA_CHAR,					/* a byte in the set ARG, then OUT */
+	NFA_SPLIT,					/* OUT or OUT1 */
+	NFA_BOL,					/* at the start of a line, then OUT */
+	NFA_EOL,					/* at the end of a line, then OUT */
+	NFA_MATCH,					/* the regular expression ARG matches */
+};
+
+typedef struct sNfaNode {
+	enum nfaOp op;
+	unsigned int out, out1;
+	unsigned int arg;
+} nfaNode;
+
+enum astOp {
+	AST_SET,
+	AST_EMPTY,
+	AST_BOL,
+	AST_EOL,
+	AST_CAT,
+	AST_ALT,
+	AST_REPEAT,
+	AST_GROUP,					/* the subexpression MIN, made of LEFT */
+};
+
+typedef struct sAstNode {
+	enum astOp op;
+	unsigned int left, right;
+	int min, max;				/* max is -1 if unbounded */
+	unsigned int set;
+} astNode;
+
+typedef struct sDfaState {
+	/* The NFA nodes the state is made of, sorted: the NFA_CHAR and
+	   NFA_MATCH nodes, and the NFA_EOL nodes waiting for the end of
+	   the line. */
+	unsigned int *nodes;
+	unsigned int count;
+	bool atLineStart;
+	int index;
+
+	/* The regular expressions matching when the state is reached, and
+	   those matching only if the line ends there. */
+	unsigned int *accepts;
+	unsigned int acceptCount;
+	unsigned int *eolAccepts;
+	unsigned int eolAcceptCount;
+
+	int next [256];
+} dfaState;
+
+struct sRegexSet {
+	nfaNode *nfa;
+	unsigned int nfaCount, nfaSize;
+	charSet *sets;
+	unsigned int setCount, setSize;
+
+	/* The first NFA node and the id of each regular expression. */
+	unsigned int *starts;
+	unsigned int *ids;
+	unsigned int count, size;
+
+	dfaState **states;
+	unsigned int stateCount;
+	hashTable *stateTable;
+	int initial;
+	unsigned long scanned;		/* bytes scanned since the cache was flushed */
+	bool givenUp;
+
+	/* Scratch areas for making states. */
+	unsigned int *stamps;
+	unsigned int generation;
+	unsigned int *stack;
+	unsigned int *closure;
+	unsigned int *seeds;
+	unsigned int scratchSize;
+};
+
+struct regexParser {
+	regexSet *set;
+	const char *start;
+	const char *p;
+	int cflags;
+	astNode *ast;
+	unsigned int astCount, astSize;
+	unsigned int groupCount;
+	bool failed;
+};
+
+/*
+*   FUNCTION DEFINITIONS
+*/
+
+/* Character sets */
+
+static void charSetAdd (charSet *cs, unsigned char c)
+{
+	cs->bits [c >> 5] |= (uint32_t)1 << (c & 31);
+}
+
+static bool charSetHas (const charSet *cs, unsigned char c)
+{
+	return (cs->bits [c >> 5] >> (c & 31)) & 1;
+}
+
+static void charSetFoldCase (charSet *cs)
+{
+	for (int c = 'a'; c <= 'z'; c++)
+	{
+		if (charSetHas (cs, c) || charSetHas (cs, toupper (c)))
+		{
+			charSetAdd (cs, c);
+			charSetAdd (cs, toupper (c));
+		}
+	}
+}
+
+static void charSetInvert (charSet *cs, bool newline)
+{
+	for (unsigned int i = 0; i < ARRAY_SIZE (cs->bits); i++)
+		cs->bits [i] = ~cs->bits [i];
+	if (!newline)
+		cs->bits ['\n' >> 5] &= ~((uint32_t)1 << ('\n' & 31));
+}
+
+static unsigned int newCharSet (regexSet *set)
+{
+	if (set->setCount == set->setSize)
+	{
+		set->setSize = set->setSize? set->setSize * 2: 16;
+		set->sets = xRealloc (set->sets, set->setSize, charSet);
+	}
+	memset (set->sets + set->setCount, 0, sizeof (charSet));
+	return set->setCount++;
+}
+
+/* Parsing regular expressions */
+
+static unsigned int newAstNode (struct regexParser *ps, enum astOp op)
+{
+	if (ps->astCount == ps->astSize)
+	{
+		ps->astSize = ps->astSize? ps->astSize * 2: 32;
+		ps->ast = xRealloc (ps->ast, ps->astSize, astNode);
+	}
+	memset (ps->ast + ps->astCount, 0, sizeof (astNode));
+	ps->ast [ps->astCount].op = op;
+	return ps->astCount++;
+}
+
+static unsigned int newSetNode (struct regexParser *ps, unsigned int *set)
+{
+	unsigned int n = newAstNode (ps, AST_SET);
+
+	*set = newCharSet (ps->set);
+	ps->ast [n].set = *set;
+	return n;
+}
+
+static unsigned int failParsing (struct regexParser *ps)
+{
+	ps->failed = true;
+	return 0;
+}
+
+static bool addCharClass (charSet *cs, const char *name, size_t len)
+{
+	static const struct {
+		const char *name;
+		int (* is) (int);
+	} classes [] = {
+		{ "alpha",  isalpha  }, { "upper",  isupper  }, { "lower",  islower  },
+		{ "digit",  isdigit  }, { "xdigit", isxdigit }, { "alnum",  isalnum  },
+		{ "space",  isspace  }, { "blank",  isblank  }, { "punct",  ispunct  },
+		{ "print",  isprint  }, { "graph",  isgraph  }, { "cntrl",  iscntrl  },
+	};
+
+	for (unsigned int i = 0; i < ARRAY_SIZE (classes); i++)
+	{
+		if (strlen (classes [i].name) == len
+			&& strncmp (classes [i].name, name, len) == 0)
+		{
+			for (int c = 0; c < 256; c++)
+				if (classes [i].is (c))
+					charSetAdd (cs, c);
+			return true;
+		}
+	}
+	return false;
+}
+
+static unsigned int parseBracket (struct regexParser *ps)
+{
+	unsigned int set;
+	unsigned int n = newSetNode (ps, &set);
+	bool negate = false;
+	bool first = true;
+
+	/* ps->p points the character after '['. */
+	if (*ps->p == '^')
+	{
+		negate = true;
+		ps->p++;
+	}
+
+	while (true)
+	{
+		charSet *cs = ps->set->sets + set;
+		unsigned char c = *ps->p;
+
+		if (c == '\0')
+			return failParsing (ps);
+		if (c == ']' && !first)
+		{
+			ps->p++;
+			break;
+		}
+		first = false;
+
+		if (c == '[' && ps->p [1] == ':')
+		{
+			const char *name = ps->p + 2;
+			const char *end = strstr (name, ":]");
+			if (!end || !addCharClass (cs, name, end - name))
+				return failParsing (ps);
+			ps->p = end + 2;
+		}
+		else if (c == '[' && (ps->p [1] == '=' || ps->p [1] == '.'))
+			return failParsing (ps);
+		else if (ps->p [1] == '-' && ps->p [2] != ']' && ps->p [2] != '\0')
+		{
+			unsigned char hi = ps->p [2];
+			if (hi == '[' || hi < c)
+				return failParsing (ps);
+			for (unsigned int i = c; i <= hi; i++)
+				charSetAdd (cs, i);
+			ps->p += 3;
+		}
+		else
+		{
+			charSetAdd (cs, c);
+			ps->p++;
+		}
+	}
+
+	if (ps->cflags & REG_ICASE)
+		charSetFoldCase (ps->set->sets + set);
+	if (negate)
+		charSetInvert (ps->set->sets + set, !(ps->cflags & REG_NEWLINE));
+	return n;
+}
+
+static unsigned int parseAlternation (struct regexParser *ps);
+
+static unsigned int parseAtom (struct regexParser *ps)
+{
+	unsigned int n, set, inner;
+	unsigned char c = *ps->p;
+
+	switch (c)
+	{
+	case '(':
+		ps->p++;
+		n = newAstNode (ps, AST_GROUP);
+		ps->ast [n].min = ++ps->groupCount;
+		if (*ps->p == ')')
+			inner = newAstNode (ps, AST_EMPTY);
+		else
+			inner = parseAlternation (ps);
+		if (ps->failed || *ps->p != ')')
+			return failParsing (ps);
+		ps->p++;
+		/* Not assigned directly: parseAlternation may move ps->ast. */
+		ps->ast [n].left = inner;
+		return n;
+	case '.':
+		ps->p++;
+		n = newSetNode (ps, &set);
+		charSetInvert (ps->set->sets + set, !(ps->cflags & REG_NEWLINE));
+		/* GNU regex doesn't match a NUL with a period. */
+		ps->set->sets [set].bits [0] &= ~(uint32_t)1;
+		return n;
+	case '^':
+	case '$':
+		/* Only the anchors at the edges of a regular expression are run
+		   like GNU regex does: the result of regexec for one in the
+		   middle, like x^, may change after other lines are matched. */
+		if ((c == '^')? (ps->p != ps->start): (ps->p [1] != '\0'))
+			return failParsing (ps);
+		ps->p++;
+		return newAstNode (ps, (c == '^')? AST_BOL: AST_EOL);
+	case '[':
+		ps->p++;
+		return parseBracket (ps);
+	case '\\':
+		c = ps->p [1];
+		if (c == '\0')
+			return failParsing (ps);
+		ps->p += 2;
+		if (c == 'w' || c == 'W' || c == 's' || c == 'S')
+		{
+			n = newSetNode (ps, &set);
+			for (int i = 0; i < 256; i++)
+				if ((c == 'w' || c == 'W')? (isalnum (i) || i == '_'): isspace (i))
+					charSetAdd (ps->set->sets + set, i);
+			if (c == 'W' || c == 'S')
+				charSetInvert (ps->set->sets + set, true);
+			return n;
+		}
+		else if (isalnum (c) || strchr ("<>`'", c))
+			return failParsing (ps);	/* back references, anchors, ... */
+		break;
+	case '*': case '+': case '?': case '{':
+	case '|': case ')': case '\0':
+		return failParsing (ps);
+	default:
+		ps->p++;
+		break;
+	}
+
+	n = newSetNode (ps, &set);
+	charSetAdd (ps->set->sets + set, c);
+	if (ps->cflags & REG_ICASE)
+		charSetFoldCase (ps->set->sets + set);
+	return n;
+}
+
+static bool parseInterval (struct regexParser *ps, int *min, int *max)
+{
+	/* ps->p points the character after '{'. */
+	char *end;
+
+	if (!isdigit ((unsigned char) *ps->p))
+		return false;
+	*min = (int) strtol (ps->p, &end, 10);
+	ps->p = end;
+	if (*ps->p == ',')
+	{
+		ps->p++;
+		if (isdigit ((unsigned char) *ps->p))
+		{
+			*max = (int) strtol (ps->p, &end, 10);
+			ps->p = end;
+		}
+		else
+			*max = -1;
+	}
+	else
+		*max = *min;
+
+	if (*ps->p != '}')
+		return false;
+	ps->p++;
+	return (*min <= MAX_REPEAT && *max <= MAX_REPEAT
+			&& (*max < 0 || *min <= *max));
+}
+
+static unsigned int parseRepetition (struct regexParser *ps)
+{
+	unsigned int a = parseAtom (ps);
+
+	while (!ps->failed)
+	{
+		int min, max;
+
+		switch (*ps->p)
+		{
+		case '*':
+			min = 0; max = -1; ps->p++;
+			break;
+		case '+':
+			min = 1; max = -1; ps->p++;
+			break;
+		case '?':
+			min = 0; max = 1; ps->p++;
+			break;
+		case '{':
+			ps->p++;
+			if (!parseInterval (ps, &min, &max))
+				return failParsing (ps);
+			break;
+		default:
+			return a;
+		}
+
+		unsigned int n = newAstNode (ps, AST_REPEAT);
+		ps->ast [n].left = a;
+		ps->ast [n].min = min;
+		ps->ast [n].max = max;
+		a = n;
+	}
+	return a;
+}
+
+static unsigned int parseConcatenation (struct regexParser *ps)
+{
+	unsigned int l;
+
+	if (*ps->p == '\0' || *ps->p == '|' || *ps->p == ')')
+		return failParsing (ps);	/* an empty branch */
+
+	l = parseRepetition (ps);
+	while (!ps->failed && *ps->p != '\0' && *ps->p != '|' && *ps->p != ')')
+	{
+		unsigned int r = parseRepetition (ps);
+		unsigned int n = newAstNode (ps, AST_CAT);
+		ps->ast [n].left = l;
+		ps->ast [n].right = r;
+		l = n;
+	}
+	return l;
+}
+
+static unsigned int parseAlternation (struct regexParser *ps)
+{
+	unsigned int l = parseConcatenation (ps);
+
+	while (!ps->failed && *ps->p == '|')
+	{
+		ps->p++;
+		unsigned int r = parseConcatenation (ps);
+		unsigned int n = newAstNode (ps, AST_ALT);
+		ps->ast [n].left = l;
+		ps->ast [n].right = r;
+		l = n;
+	}
+	return l;
+}
+
+/* Building the NFA */
+
+static unsigned int newNfaNode (struct regexParser *ps, enum nfaOp op,
+								unsigned int out, unsigned int arg)
+{
+	regexSet *set = ps->set;
+
+	if (set->nfaCount >= MAX_NFA_NODES)
+	{
+		ps->failed = true;
+		return NFA_NONE;
+	}
+
+	if (set->nfaCount == set->nfaSize)
+	{
+		set->nfaSize = set->nfaSize? set->nfaSize * 2: 64;
+		set->nfa = xRealloc (set->nfa, set->nfaSize, nfaNode);
+	}
+	set->nfa [set->nfaCount].op = op;
+	set->nfa [set->nfaCount].out = out;
+	set->nfa [set->nfaCount].out1 = NFA_NONE;
+	set->nfa [set->nfaCount].arg = arg;
+	return set->nfaCount++;
+}
+
+/* Return the first node of the nodes matching the AST node A, which
+   end at NEXT. */
+static unsigned int compileAst (struct regexParser *ps, unsigned int a, unsigned int next)
+{
+	const astNode node = ps->ast [a];
+	unsigned int entry, s;
+
+	if (ps->failed)
+		return NFA_NONE;
+
+	switch (node.op)
+	{
+	case AST_SET:
+		return newNfaNode (ps, NFA_CHAR, next, node.set);
+	case AST_EMPTY:
+		return next;
+	case AST_BOL:
+		return newNfaNode (ps, NFA_BOL, next, 0);
+	case AST_EOL:
+		return newNfaNode (ps, NFA_EOL, next, 0);
+	case AST_CAT:
+		return compileAst (ps, node.left, compileAst (ps, node.right, next));
+	case AST_GROUP:
+		return compileAst (ps, node.left, next);
+	case AST_ALT:
+		s = newNfaNode (ps, NFA_SPLIT, compileAst (ps, node.left, next), 0);
+		entry = compileAst (ps, node.right, next);
+		if (ps->failed)
+			return NFA_NONE;
+		/* Not assigned directly: compileAst may move set->nfa. */
+		ps->set->nfa [s].out1 = entry;
+		return s;
+	case AST_REPEAT:
+		if (node.max < 0)
+		{
+			/* A loop, after MIN copies. */
+			entry = newNfaNode (ps, NFA_SPLIT, NFA_NONE, 0);
+			if (ps->failed)
+				return NFA_NONE;
+			ps->set->nfa [entry].out1 = next;
+			s = compileAst (ps, node.left, entry);
+			if (ps->failed)
+				return NFA_NONE;
+			ps->set->nfa [entry].out = s;
+		}
+		else
+		{
+			/* MAX - MIN optional copies, nested, after MIN copies. */
+			entry = next;
+			for (int i = node.min; i < node.max; i++)
+			{
+				s = newNfaNode (ps, NFA_SPLIT, compileAst (ps, node.left, entry), 0);
+				if (ps->failed)
+					return NFA_NONE;
+				ps->set->nfa [s].out1 = next;
+				entry = s;
+			}
+		}
+		for (int i = 0; i < node.min; i++)
+			entry = compileAst (ps, node.left, entry);
+		return entry;
+	}
+	return NFA_NONE;
+}
+
+/* The lazy DFA */
+
+static void deleteDfaState (dfaState *state)
+{
+	eFree (state->nodes);
+	if (state->accepts)
+		eFree (state->accepts);
+	if (state->eolAccepts)
+		eFree (state->eolAccepts);
+	eFree (state);
+}
+
+static void flushDfaStates (regexSet *set)
+{
+	hashTableClear (set->stateTable);
+	for (unsigned int i = 0; i < set->stateCount; i++)
+		deleteDfaState (set->states [i]);
+	set->stateCount = 0;
+	set->initial = DFA_UNKNOWN;
+	set->scanned = 0;
+}
+
+static unsigned int hashDfaState (const void *const key)
+{
+	const dfaState *state = key;
+	unsigned int h = 2166136261U ^ state->atLineStart;
+
+	for (unsigned int i = 0; i < state->count; i++)
+		h = (h ^ state->nodes [i]) * 16777619U;
+	return h;
+}
+
+static bool equalDfaState (const void *a, const void *b)
+{
+	const dfaState *x = a;
+	const dfaState *y = b;
+
+	return (x->count == y->count
+			&& x->atLineStart == y->atLineStart
+			&& memcmp (x->nodes, y->nodes, sizeof (unsigned int) * x->count) == 0);
+}
+
+static void prepareScratch (regexSet *set)
+{
+	unsigned int size = set->nfaCount + set->count;
+
+	if (size <= set->scratchSize)
+		return;
+
+	set->stamps = xRealloc (set->stamps, size, unsigned int);
+	memset (set->stamps, 0, sizeof (unsigned int) * size);
+	set->generation = 0;
+	set->stack = xRealloc (set->stack, size, unsigned int);
+	set->closure = xRealloc (set->closure, size, unsigned int);
+	set->seeds = xRealloc (set->seeds, size, unsigned int);
+	set->scratchSize = size;
+}
+
+static int compareNode (const void *a, const void *b)
+{
+	unsigned int x = *(const unsigned int *) a;
+	unsigned int y = *(const unsigned int *) b;
+
+	return (x > y) - (x < y);
+}
+
+/* Put in set->closure the nodes the nodes SEEDS lead to without reading
+   a byte, and return their count. */
+static unsigned int computeClosure (regexSet *set, const unsigned int *seeds, unsigned int count,
+									bool atLineStart, bool atLineEnd)
+{
+	unsigned int sp = 0, n = 0;
+
+	if (++set->generation == 0)
+	{
+		memset (set->stamps, 0, sizeof (unsigned int) * set->scratchSize);
+		set->generation = 1;
+	}
+
+	for (unsigned int i = 0; i < count; i++)
+	{
+		if (set->stamps [seeds [i]] != set->generation)
+		{
+			set->stamps [seeds [i]] = set->generation;
+			set->stack [sp++] = seeds [i];
+		}
+	}
+
+	while (sp > 0)
+	{
+		unsigned int s = set->stack [--sp];
+		const nfaNode *node = set->nfa + s;
+		unsigned int follow [2] = { NFA_NONE, NFA_NONE };
+
+		switch (node->op)
+		{
+		case NFA_CHAR:
+		case NFA_MATCH:
+			set->closure [n++] = s;
+			break;
+		case NFA_SPLIT:
+			follow [0] = node->out;
+			follow [1] = node->out1;
+			break;
+		case NFA_BOL:
+			if (atLineStart)
+				follow [0] = node->out;
+			break;
+		case NFA_EOL:
+			if (atLineEnd)
+				follow [0] = node->out;
+			else
+				set->closure [n++] = s;
+			break;
+		}
+
+		for (int i = 0; i < 2; i++)
+		{
+			if (follow [i] != NFA_NONE && set->stamps [follow [i]] != set->generation)
+			{
+				set->stamps [follow [i]] = set->generation;
+				set->stack [sp++] = follow [i];
+			}
+		}
+	}
+
+	qsort (set->closure, n, sizeof (unsigned int), compareNode);
+	return n;
+}
+
+static unsigned int *collectAccepts (regexSet *set, const unsigned int *nodes, unsigned int count,
+									 unsigned int *acceptCount)
+{
+	unsigned int *accepts = NULL;
+	unsigned int n = 0;
+
+	for (unsigned int i = 0; i < count; i++)
+	{
+		if (set->nfa [nodes [i]].op == NFA_MATCH)
+		{
+			if (!accepts)
+				accepts = xMalloc (count, unsigned int);
+			accepts [n++] = set->nfa [nodes [i]].arg;
+		}
+	}
+	*acceptCount = n;
+	return accepts;
+}
+
+/* Return the state made of the COUNT nodes of set->closure, making it
+   if it is not known yet. *FLUSHED tells whether the cache is flushed
+   to make room for it. DFA_UNKNOWN is returned if the set is given up. */
+static int findDfaState (regexSet *set, unsigned int count, bool atLineStart, bool *flushed)
+{
+	dfaState key = {
+		.nodes = set->closure,
+		.count = count,
+		.atLineStart = atLineStart,
+	};
+	dfaState *state;
+
+	/* Most of the sets are never scanned: many parsers have no regex
+	   at all, and the others may not run. */
+	if (!set->stateTable)
+	{
+		set->states = xMalloc (MAX_DFA_STATES, dfaState *);
+		set->stateTable = hashTableNew (DFA_STATE_TABLE_SIZE, hashDfaState, equalDfaState,
+										NULL, NULL);
+	}
+
+	state = hashTableGetItem (set->stateTable, &key);
+	*flushed = false;
+	if (state)
+		return state->index;
+
+	if (set->stateCount == MAX_DFA_STATES)
+	{
+		if (set->scanned < (unsigned long) MAX_DFA_STATES * MIN_BYTES_PER_STATE)
+		{
+			/* Too many states for the input: thrashing. */
+			set->givenUp = true;
+			return DFA_UNKNOWN;
+		}
+		flushDfaStates (set);
+		*flushed = true;
+	}
+
+	state = xMalloc (1, dfaState);
+	state->nodes = xMalloc (count > 0? count: 1, unsigned int);
+	memcpy (state->nodes, set->closure, sizeof (unsigned int) * count);
+	state->count = count;
+	state->atLineStart = atLineStart;
+	state->index = set->stateCount;
+	for (unsigned int c = 0; c < 256; c++)
+		state->next [c] = DFA_UNKNOWN;
+
+	state->accepts = collectAccepts (set, state->nodes, count, &state->acceptCount);
+	state->eolAccepts = NULL;
+	state->eolAcceptCount = 0;
+	for (unsigned int i = 0; i < count; i++)
+	{
+		if (set->nfa [state->nodes [i]].op == NFA_EOL)
+		{
+			unsigned int n = computeClosure (set, state->nodes, count, atLineStart, true);
+			state->eolAccepts = collectAccepts (set, set->closure, n, &state->eolAcceptCount);
+			break;
+		}
+	}
+
+	set->states [set->stateCount++] = state;
+	hashTablePutItem (set->stateTable, state, state);
+	return state->index;
+}
+
+static int findInitialState (regexSet *set)
+{
+	bool flushed;
+	unsigned int n = computeClosure (set, set->starts, set->count, true, false);
+
+	return findDfaState (set, n, true, &flushed);
+}
+
+/* Return the state reached from the state S reading the byte C. */
+static int stepDfaState (regexSet *set, int s, unsigned char c, bool *flushed)
+{
+	const dfaState *state = set->states [s];
+	const unsigned int *nodes = state->nodes;
+	unsigned int count = state->count;
+	unsigned int n = 0;
+
+	if (c == '\n')
+	{
+		/* The NFA_EOL nodes are passed before the newline. */
+		count = computeClosure (set, nodes, count, state->atLineStart, true);
+		nodes = set->closure;
+	}
+
+	for (unsigned int i = 0; i < count; i++)
+	{
+		const nfaNode *node = set->nfa + nodes [i];
+		if (node->op == NFA_CHAR && charSetHas (set->sets + node->arg, c))
+			set->seeds [n++] = node->out;
+	}
+
+	/* A match may start at any position. */
+	memcpy (set->seeds + n, set->starts, sizeof (unsigned int) * set->count);
+	n += set->count;
+
+	n = computeClosure (set, set->seeds, n, c == '\n', false);
+	return findDfaState (set, n, c == '\n', flushed);
+}
+
+/* Regular expression sets */
+
+extern regexSet *regexSetNew (void)
+{
+	regexSet *set = xCalloc (1, regexSet);
+
+	set->initial = DFA_UNKNOWN;
+	return set;
+}
+
+extern void regexSetDelete (regexSet *set)
+{
+	flushDfaStates (set);
+	if (set->stateTable)
+	{
+		hashTableDelete (set->stateTable);
+		eFree (set->states);
+	}
+
+	if (set->nfa)
+		eFree (set->nfa);
+	if (set->sets)
+		eFree (set->sets);
+	if (set->starts)
+		eFree (set->starts);
+	if (set->ids)
+		eFree (set->ids);
+
+	if (set->stamps)
+		eFree (set->stamps);
+	if (set->stack)
+		eFree (set->stack);
+	if (set->closure)
+		eFree (set->closure);
+	if (set->seeds)
+		eFree (set->seeds);
+
+	eFree (set);
+}
+
+extern bool regexSetAdd (regexSet *set, const char *regexp, int cflags, unsigned int id)
+{
+	struct regexParser ps = {
+		.set = set,
+		.start = regexp,
+		.p = regexp,
+		.cflags = cflags,
+	};
+	unsigned int nfaCount = set->nfaCount;
+	unsigned int setCount = set->setCount;
+	unsigned int root, match, start = NFA_NONE;
+
+	/* Only what single line patterns are compiled with is supported. */
+	if ((cflags & (REG_EXTENDED | REG_NEWLINE)) != (REG_EXTENDED | REG_NEWLINE))
+		return false;
+
+	root = parseAlternation (&ps);
+	if (!ps.failed && *ps.p != '\0')
+		ps.failed = true;		/* an unmatched ')' */
+
+	if (!ps.failed)
+	{
+		match = newNfaNode (&ps, NFA_MATCH, NFA_NONE, id);
+		start = compileAst (&ps, root, match);
+	}
+
+	if (ps.ast)
+		eFree (ps.ast);
+
+	if (ps.failed)
+	{
+		set->nfaCount = nfaCount;
+		set->setCount = setCount;
+		return false;
+	}
+
+	if (set->count == set->size)
+	{
+		set->size = set->size? set->size * 2: 16;
+		set->starts = xRealloc (set->starts, set->size, unsigned int);
+		set->ids = xRealloc (set->ids, set->size, unsigned int);
+	}
+	set->starts [set->count] = start;
+	set->ids [set->count] = id;
+	set->count++;
+
+	flushDfaStates (set);
+	set->givenUp = false;
+	prepareScratch (set);
+	return true;
+}
+
+/* Add to FIRST the bytes a string matched by the node A can start with.
+   Return true if A can match the empty string. */
+static bool addFirstBytes (struct regexParser *ps, unsigned int a, charSet *first)
+{
+	const astNode *node = ps->ast + a;
+	bool left, right;
+
+	switch (node->op)
+	{
+	case AST_SET:
+		for (unsigned int i = 0; i < ARRAY_SIZE (first->bits); i++)
+			first->bits [i] |= ps->set->sets [node->set].bits [i];
+		return false;
+	case AST_EMPTY:
+	case AST_BOL:
+	case AST_EOL:
+		return true;
+	case AST_CAT:
+		return addFirstBytes (ps, node->left, first)
+			&& addFirstBytes (ps, node->right, first);
+	case AST_ALT:
+		left = addFirstBytes (ps, node->left, first);
+		right = addFirstBytes (ps, node->right, first);
+		return left || right;
+	case AST_REPEAT:
+		return addFirstBytes (ps, node->left, first) || node->min == 0;
+	case AST_GROUP:
+		return addFirstBytes (ps, node->left, first);
+	}
+	return true;
+}
+
+extern bool regexFirstBytes (const char *regexp, int cflags, bool first [256],
+							 bool *singleByte)
+{
+	regexSet scratch;			/* only holds the character sets */
+	struct regexParser ps = {
+		.set = &scratch,
+		.start = regexp,
+		.p = regexp,
+		.cflags = cflags,
+	};
+	charSet cs;
+	unsigned int root;
+	bool nullable = true;
+
+	if (!(cflags & REG_EXTENDED))
+		return false;
+
+	memset (&scratch, 0, sizeof (scratch));
+	root = parseAlternation (&ps);
+	if (!ps.failed && *ps.p == '\0')
+	{
+		const astNode *node = ps.ast + root;
+
+		memset (&cs, 0, sizeof (cs));
+		nullable = addFirstBytes (&ps, root, &cs);
+		*singleByte = (node->op == AST_SET
+					   || (node->op == AST_CAT
+						   && ps.ast [node->left].op == AST_BOL
+						   && ps.ast [node->right].op == AST_SET));
+	}
+
+	if (ps.ast)
+		eFree (ps.ast);
+	if (scratch.sets)
+		eFree (scratch.sets);
+
+	if (ps.failed || nullable)
+		return false;
+
+	for (int c = 0; c < 256; c++)
+		first [c] = charSetHas (&cs, c);
+	return true;
+}
+
+extern unsigned int regexSetCount (const regexSet *set)
+{
+	return set->count;
+}
+
+static unsigned int markMatched (const unsigned int *ids, unsigned int count, bool *matched)
+{
+	unsigned int marked = 0;
+
+	for (unsigned int i = 0; i < count; i++)
+	{
+		if (!matched [ids [i]])
+		{
+			matched [ids [i]] = true;
+			marked++;
+		}
+	}
+	return marked;
+}
+
+extern void regexSetMatch (regexSet *set, const char *text, size_t length,
+						   bool *matched)
+{
+	const unsigned char *p = (const unsigned char *) text;
+	const unsigned char *const end = p + length;
+	const unsigned char *counted = p;
+	unsigned int marked = 0;
+	const dfaState *state;
+	bool flushed;
+
+	if (set->count == 0)
+		return;
+
+	if (!set->givenUp && set->initial == DFA_UNKNOWN)
+		set->initial = findInitialState (set);
+	if (set->givenUp)
+	{
+		markMatched (set->ids, set->count, matched);
+		return;
+	}
+
+	state = set->states [set->initial];
+	if (state->acceptCount)
+		marked += markMatched (state->accepts, state->acceptCount, matched);
+
+	for (; p < end && *p != '\0' && marked < set->count; p++)
+	{
+		int t = state->next [*p];
+
+		if (*p == '\n' && state->eolAcceptCount)
+			marked += markMatched (state->eolAccepts, state->eolAcceptCount, matched);
+
+		if (t == DFA_UNKNOWN)
+		{
+			set->scanned += p - counted;
+			counted = p;
+			t = stepDfaState (set, state->index, *p, &flushed);
+			if (t == DFA_UNKNOWN)
+			{
+				markMatched (set->ids, set->count, matched);
+				return;
+			}
+			if (!flushed)
+				set->states [state->index]->next [*p] = t;
+		}
+		state = set->states [t];
+		if (state->acceptCount)
+			marked += markMatched (state->accepts, state->acceptCount, matched);
+	}
+	set->scanned += p - counted;
+
+	if (state->eolAcceptCount)
+		markMatched (state->eolAccepts, state->eolAcceptCount, matched);
+}
+
+/* Simple programs */
+
+/* A byte in SET repeated from MIN to MAX times, MAX being -1 if
+   unbounded. */
+typedef struct sProgramStep {
+	charSet set;
+	int min, max;
+} programStep;
+
+struct sRegexProgram {
+	programStep *steps;
+	unsigned int count, size;
+	bool atLineStart;			/* anchored with ^ */
+	bool atLineEnd;				/* anchored with $ */
+	bool newline;				/* compiled with REG_NEWLINE */
+
+	/* The subexpression N starts before the step groupStart [N - 1]
+	   and ends before the step groupEnd [N - 1]. */
+	unsigned int *groupStart, *groupEnd;
+	unsigned int groupCount;
+};
+
+static bool addProgramStep (struct regexParser *ps, regexProgram *prog,
+							unsigned int a, int min, int max)
+{
+	if (ps->ast [a].op != AST_SET)
+		return false;			/* a repeated subexpression */
+
+	if (prog->count == prog->size)
+	{
+		prog->size = prog->size? prog->size * 2: 8;
+		prog->steps = xRealloc (prog->steps, prog->size, programStep);
+	}
+	prog->steps [prog->count].set = ps->set->sets [ps->ast [a].set];
+	prog->steps [prog->count].min = min;
+	prog->steps [prog->count].max = max;
+	prog->count++;
+	return true;
+}
+
+/* Append to PROG the steps of the AST node A. Return false if A is not
+   a sequence of repeated sets, with subexpressions around some of them. */
+static bool compileProgram (struct regexParser *ps, regexProgram *prog, unsigned int a)
+{
+	const astNode node = ps->ast [a];
+
+	switch (node.op)
+	{
+	case AST_SET:
+		return addProgramStep (ps, prog, a, 1, 1);
+	case AST_REPEAT:
+		return addProgramStep (ps, prog, node.left, node.min, node.max);
+	case AST_BOL:
+		prog->atLineStart = true;
+		return true;
+	case AST_EOL:
+		prog->atLineEnd = true;
+		return true;
+	case AST_CAT:
+		return compileProgram (ps, prog, node.left)
+			&& compileProgram (ps, prog, node.right);
+	case AST_GROUP:
+		prog->groupStart [node.min - 1] = prog->count;
+		if (!compileProgram (ps, prog, node.left))
+			return false;
+		prog->groupEnd [node.min - 1] = prog->count;
+		return true;
+	case AST_EMPTY:
+	case AST_ALT:
+		return false;
+	}
+	return false;
+}
+
+/* Whether running each step of PROG greedily finds the only match
+   starting at an offset: it does if a step repeated a variable number
+   of times is the last one, or is followed by one taking at least a
+   byte, none of which the former can take. POSIX leftmost longest
+   matching has then nothing to choose, even for the submatches. */
+static bool isProgramDeterministic (const regexProgram *prog)
+{
+	for (unsigned int i = 0; i + 1 < prog->count; i++)
+	{
+		const programStep *step = prog->steps + i;
+		const programStep *next = step + 1;
+
+		if (step->min == step->max)
+			continue;
+		if (next->min == 0)
+			return false;
+		for (unsigned int j = 0; j < ARRAY_SIZE (step->set.bits); j++)
+			if (step->set.bits [j] & next->set.bits [j])
+				return false;
+	}
+
+	/* With REG_NEWLINE, $ can also match before a newline the last
+	   step could take. */
+	if (prog->count && prog->atLineEnd && prog->newline)
+	{
+		const programStep *last = prog->steps + prog->count - 1;
+		if (last->min != last->max && charSetHas (&last->set, '\n'))
+			return false;
+	}
+	return true;
+}
+
+extern regexProgram *regexProgramNew (const char *regexp, int cflags)
+{
+	regexSet scratch;			/* only holds the character sets */
+	struct regexParser ps = {
+		.set = &scratch,
+		.start = regexp,
+		.p = regexp,
+		.cflags = cflags,
+	};
+	regexProgram *prog = NULL;
+	unsigned int root;
+
+	if (!(cflags & REG_EXTENDED))
+		return NULL;
+
+	memset (&scratch, 0, sizeof (scratch));
+	root = parseAlternation (&ps);
+	if (!ps.failed && *ps.p == '\0')
+	{
+		prog = xCalloc (1, regexProgram);
+		prog->newline = (cflags & REG_NEWLINE) != 0;
+		prog->groupCount = ps.groupCount;
+		if (ps.groupCount)
+		{
+			prog->groupStart = xCalloc (ps.groupCount, unsigned int);
+			prog->groupEnd = xCalloc (ps.groupCount, unsigned int);
+		}
+		if (!compileProgram (&ps, prog, root)
+			|| !isProgramDeterministic (prog))
+		{
+			regexProgramDelete (prog);
+			prog = NULL;
+		}
+	}
+
+	if (ps.ast)
+		eFree (ps.ast);
+	if (scratch.sets)
+		eFree (scratch.sets);
+	return prog;
+}
+
+extern void regexProgramDelete (regexProgram *prog)
+{
+	if (prog->steps)
+		eFree (prog->steps);
+	if (prog->groupStart)
+		eFree (prog->groupStart);
+	if (prog->groupEnd)
+		eFree (prog->groupEnd);
+	eFree (prog);
+}
+
+/* Run PROG from START in TEXT, setting OFFSETS [I] to where the step I
+   begins, and OFFSETS [COUNT] to where the match ends. Add the bytes
+   scanned to SCANNED. */
+static bool runProgram (const regexProgram *prog, const unsigned char *text,
+						size_t length, size_t start, size_t *offsets,
+						size_t *scanned)
+{
+	size_t p = start;
+	bool found = false;
+
+	for (unsigned int i = 0; i < prog->count; i++)
+	{
+		const programStep *step = prog->steps + i;
+		size_t end = length;
+
+		if (step->max >= 0 && (size_t) step->max < length - p)
+			end = p + step->max;
+
+		offsets [i] = p;
+		while (p < end && charSetHas (&step->set, text [p]))
+			p++;
+		if (p - offsets [i] < (size_t) step->min)
+			goto out;
+	}
+	offsets [prog->count] = p;
+
+	found = (!prog->atLineEnd || p == length
+			 || (prog->newline && text [p] == '\n'));
+ out:
+	*scanned += p - start + 1;
+	return found;
+}
+
+extern int regexProgramExec (const regexProgram *prog, const char *text, size_t length,
+							 size_t nmatch, regmatch_t pmatch [])
+{
+	const unsigned char *t = (const unsigned char *) text;
+	const charSet *first = (prog->count && prog->steps [0].min > 0)
+		? &prog->steps [0].set: NULL;
+	size_t offsetsBuffer [16];
+	size_t *offsets = offsetsBuffer;
+	size_t scanned = 0;
+	int r = REG_NOMATCH;
+	size_t start;
+
+	if (prog->count >= ARRAY_SIZE (offsetsBuffer))
+		offsets = xMalloc (prog->count + 1, size_t);
+
+	for (start = 0; start <= length; start++)
+	{
+		if (prog->atLineStart && start > 0
+			&& !(prog->newline && t [start - 1] == '\n'))
+		{
+			if (!prog->newline)
+				break;
+			continue;
+		}
+		if (first && (start == length || !charSetHas (first, t [start])))
+			continue;
+		if (runProgram (prog, t, length, start, offsets, &scanned))
+		{
+			r = 0;
+			break;
+		}
+		if (scanned > PROGRAM_SCAN_FACTOR * (length + 1))
+		{
+			r = REG_ESPACE;
+			break;
+		}
+	}
+
+	if (r == 0)
+	{
+		for (size_t i = 0; i < nmatch; i++)
+		{
+			if (i == 0)
+			{
+				pmatch [i].rm_so = start;
+				pmatch [i].rm_eo = offsets [prog->count];
+			}
+			else if (i <= prog->groupCount)
+			{
+				pmatch [i].rm_so = offsets [prog->groupStart [i - 1]];
+				pmatch [i].rm_eo = offsets [prog->groupEnd [i - 1]];
+			}
+			else
+				pmatch [i].rm_so = pmatch [i].rm_eo = -1;
+		}
+	}
+
+	if (offsets != offsetsBuffer)
+		eFree (offsets);
+	return r;
+}
@@ -0,0 +1,79 @@
+/*
+*   Copyright (c) 2026, Universal Ctags Team
+*
+*   This source code is released for free distribution under the terms of the
+*   GNU General Public License version 2 or (at your option) any later version.
+*
+*   Defines a set of regular expressions telling, in one pass over a
+*   line, which of them match it.
+*/
+#ifndef CTAGS_MAIN_REGEXSET_H
+#define CTAGS_MAIN_REGEXSET_H
+
+/*
+*   INCLUDE FILES
+*/
+#include "general.h"  /* must always come first */
+
+#include <stddef.h>
+#ifdef HAVE_SYS_TYPES_H
+# include <sys/types.h>  /* declare off_t (not known to regex.h on FreeBSD) */
+#endif
+#include <regex.h>
+
+/*
+*   DATA DECLARATIONS
+*/
+struct sRegexSet;
+typedef struct sRegexSet regexSet;
+
+struct sRegexProgram;
+typedef struct sRegexProgram regexProgram;
+
+/*
+*   FUNCTION PROTOTYPES
+*/
+extern regexSet *regexSetNew (void);
+extern void regexSetDelete (regexSet *set);
+
+/* Add the regular expression REGEXP, compiled by regcomp with CFLAGS,
+   found as ID. Return false if REGEXP uses a construct the set cannot
+   run, like a back reference or a word boundary; REGEXP is not added
+   then. */
+extern bool regexSetAdd (regexSet *set, const char *regexp, int cflags, unsigned int id);
+extern unsigned int regexSetCount (const regexSet *set);
+
+/* Set MATCHED [ID] to true for each regular expression ID regexec
+   would match in TEXT, which ends at LENGTH or at the first NUL
+   character. MATCHED must have room for the largest ID given to
+   regexSetAdd, and is not cleared. All the IDs may be set when the
+   set gives up running too many states. */
+extern void regexSetMatch (regexSet *set, const char *text, size_t length,
+						   bool *matched);
+
+/* Set FIRST [C] to true if a match of the extended REGEXP, compiled by
+   regcomp with CFLAGS, at the start of a string can begin with the byte
+   C, and to false otherwise. SINGLEBYTE tells whether the match of
+   REGEXP is always one of those bytes, and nothing more. Return false,
+   leaving FIRST and SINGLEBYTE as is, if REGEXP can match the empty
+   string or uses a construct the set cannot run. */
+extern bool regexFirstBytes (const char *regexp, int cflags, bool first [256],
+							 bool *singleByte);
+
+/* Compile the extended REGEXP, compiled by regcomp with CFLAGS, into a
+   program running it without backtracking: REGEXP must be a sequence
+   of bytes of sets, each repeated or not, with subexpressions around
+   some of them, and be anchored or not. Return NULL if REGEXP is not
+   that simple, or if a step repeated a variable number of times may
+   leave the next one a choice. */
+extern regexProgram *regexProgramNew (const char *regexp, int cflags);
+extern void regexProgramDelete (regexProgram *prog);
+
+/* Like regexec with REG_STARTEND, run PROG on the LENGTH bytes of TEXT,
+   filling NMATCH elements of PMATCH. Return REG_ESPACE if it gives up,
+   having scanned too many bytes for the length of TEXT: regexec must be
+   run then. */
+extern int regexProgramExec (const regexProgram *prog, const char *text, size_t length,
+							 size_t nmatch, regmatch_t pmatch []);
+
+#endif /* CTAGS_MAIN_REGEXSET_H */
@@ -0,0 +1 @@
+#define CTAGS_REPOINFO "430d78c"
@@ -17,6 +17,7 @@
 #endif
 #include <ctype.h>
 #include <string.h>
+#include <stddef.h>  /* to declare ptrdiff_t */
 #include <stdio.h>  /* to declare tempnam(), and SEEK_SET (hopefully) */
 
 #ifdef HAVE_FCNTL_H
@@ -26,6 +27,10 @@
 # include <unistd.h>  /* to declare mkstemp () */
 #endif
 
+#ifdef ALLOC_PROFILING
+# include <stdint.h>  /* to declare uintptr_t */
+#endif
+
 #ifdef HAVE_LIMITS_H
 # include <limits.h>  /* to declare MB_LEN_MAX */
 #endif
@@ -56,6 +61,10 @@
 #ifdef HAVE_IO_H
 # include <io.h>  /* to declare open() */
 #endif
+#ifdef HAVE_MALLOC_USABLE_SIZE
+# include <malloc.h>  /* to declare malloc_usable_size () */
+#endif
+
 #include "debug.h"
 #include "routines.h"
 #ifdef HAVE_ICONV
@@ -205,27 +214,297 @@ extern const char *getExecutablePath (void)
 	return ExecutableProgram;
 }
 
+/*
+ *  Allocation profiling
+ *
+ *  In a build configured with --enable-alloc-profiling, the blocks of
+ *  eMalloc () and the others are recorded in a hash table with their
+ *  sizes and the language parsing when they were made, as
+ *  setAllocLanguageFunc () tells it. A block freed with free () instead
+ *  of eFree () is forgotten when its address is given out again. The
+ *  table is made with malloc () and is not counted.
+ */
+#ifdef ALLOC_PROFILING
+typedef struct sAllocRecord {
+	const void *ptr;			/* NULL for an empty slot */
+	size_t size;
+	int language;
+} allocRecord;
+
+#define ALLOC_RECORD_DELETED ((const void *) &AllocRecords)
+
+static allocRecord *AllocRecords;
+static size_t AllocRecordSize;		/* a power of 2 */
+static size_t AllocRecordUsed;		/* including the deleted ones */
+
+/* Indexed by language + 1; the first one is for out of parsing. */
+static allocStats *AllocStatsTable;
+static int AllocStatsCount;
+static allocStats AllocTotals;
+
+static int (* AllocLanguageFunc) (void);
+static bool AllocFuncRunning;
+
+extern void setAllocLanguageFunc (int (* func) (void))
+{
+	AllocLanguageFunc = func;
+}
+
+static int getAllocLanguage (void)
+{
+	int language = -1;
+
+	if (AllocLanguageFunc && ! AllocFuncRunning)
+	{
+		AllocFuncRunning = true;
+		language = AllocLanguageFunc ();
+		AllocFuncRunning = false;
+	}
+	return language;
+}
+
+static allocStats *getAllocStatsOf (int language)
+{
+	if (language + 1 >= AllocStatsCount)
+	{
+		const int count = language + 2 + 16;
+		AllocStatsTable = realloc (AllocStatsTable, count * sizeof (allocStats));
+		if (AllocStatsTable == NULL)
+			error (FATAL, "out of memory");
+		memset (AllocStatsTable + AllocStatsCount, 0,
+				(count - AllocStatsCount) * sizeof (allocStats));
+		AllocStatsCount = count;
+	}
+	return AllocStatsTable + language + 1;
+}
+
+static size_t hashAllocPtr (const void *ptr)
+{
+	return (size_t) (((uintptr_t) ptr >> 4) * 0x9E3779B1u) & (AllocRecordSize - 1);
+}
+
+static allocRecord *findAllocRecord (const void *ptr)
+{
+	size_t i;
+
+	if (AllocRecordSize == 0)
+		return NULL;
+	for (i = hashAllocPtr (ptr); AllocRecords [i].ptr; i = (i + 1) & (AllocRecordSize - 1))
+		if (AllocRecords [i].ptr == ptr)
+			return AllocRecords + i;
+	return NULL;
+}
+
+static void forgetAlloc (allocRecord *r, bool freed)
+{
+	allocStats *s = getAllocStatsOf (r->language);
+
+	s->live -= r->size;
+	AllocTotals.live -= r->size;
+	if (freed)
+	{
+		s->frees++;
+		AllocTotals.frees++;
+	}
+	r->ptr = ALLOC_RECORD_DELETED;
+}
+
+static void growAllocRecords (void)
+{
+	allocRecord *old = AllocRecords;
+	const size_t oldSize = AllocRecordSize;
+	size_t i;
+
+	AllocRecordSize = oldSize? oldSize * 2: 4096;
+	AllocRecords = calloc (AllocRecordSize, sizeof (allocRecord));
+	if (AllocRecords == NULL)
+		error (FATAL, "out of memory");
+	AllocRecordUsed = 0;
+	for (i = 0; i < oldSize; i++)
+		if (old [i].ptr && old [i].ptr != ALLOC_RECORD_DELETED)
+		{
+			size_t j = hashAllocPtr (old [i].ptr);
+			while (AllocRecords [j].ptr)
+				j = (j + 1) & (AllocRecordSize - 1);
+			AllocRecords [j] = old [i];
+			AllocRecordUsed++;
+		}
+	free (old);
+}
+
+/* LANGUAGE is asked for before the block is made: when a realloc () moves
+   the language stack itself, asking for it after would read freed memory. */
+static void recordAlloc (int language, const void *ptr, size_t size, bool resized)
+{
+	allocStats *s;
+	allocRecord *r = findAllocRecord (ptr);
+	size_t i;
+
+	if (r)
+		forgetAlloc (r, false);	/* freed by free () */
+
+	if ((AllocRecordUsed + 1) * 2 > AllocRecordSize)
+		growAllocRecords ();
+	for (i = hashAllocPtr (ptr); AllocRecords [i].ptr
+			 && AllocRecords [i].ptr != ALLOC_RECORD_DELETED;
+		 i = (i + 1) & (AllocRecordSize - 1))
+		;
+	if (AllocRecords [i].ptr == NULL)
+		AllocRecordUsed++;
+	AllocRecords [i].ptr = ptr;
+	AllocRecords [i].size = size;
+	AllocRecords [i].language = language;
+
+	s = getAllocStatsOf (language);
+	if (resized)
+	{
+		s->reallocs++;
+		AllocTotals.reallocs++;
+	}
+	else
+	{
+		s->allocs++;
+		AllocTotals.allocs++;
+	}
+	s->bytes += size;
+	s->live += size;
+	if (s->live > s->peak)
+		s->peak = s->live;
+	AllocTotals.bytes += size;
+	AllocTotals.live += size;
+	if (AllocTotals.live > AllocTotals.peak)
+		AllocTotals.peak = AllocTotals.live;
+}
+
+static void recordFree (const void *ptr, bool freed)
+{
+	allocRecord *r = findAllocRecord (ptr);
+
+	if (r)
+		forgetAlloc (r, freed);
+}
+
+extern bool getAllocStats (int language, allocStats *stats)
+{
+	if (language + 1 >= AllocStatsCount)
+		return false;
+	*stats = AllocStatsTable [language + 1];
+	return (stats->allocs > 0 || stats->reallocs > 0 || stats->frees > 0);
+}
+
+extern void getAllocTotals (allocStats *stats)
+{
+	*stats = AllocTotals;
+}
+#else
+# define getAllocLanguage() (-1)
+# define recordAlloc(language, ptr, size, resized) ((void) (language))
+# define recordFree(ptr, freed) do {} while (0)
+#endif
+
+/*
+ *  For --memory-limit. The blocks allocated before the limit is set are
+ *  not counted, but are when they are freed, so the count is a little
+ *  low rather than high. The memory tightens at 3/4 of the limit.
+ */
+#ifdef HAVE_MALLOC_USABLE_SIZE
+static size_t MemoryLimit;
+static size_t MemoryTight;
+static ptrdiff_t MemoryInUse;
+
+static void exceedMemoryLimit (void)
+{
+	const size_t limit = MemoryLimit;
+
+	/* error () may allocate. */
+	MemoryLimit = 0;
+	error (FATAL, "more than %lu MB of memory in use (--memory-limit)",
+		   (unsigned long) (limit >> 20));
+	/* error (FATAL, ...) only prints the message in interactive mode. */
+	exit (1);
+}
+
+static void countAlloc (const void *ptr)
+{
+	if (MemoryLimit > 0)
+	{
+		MemoryInUse += malloc_usable_size ((void *) ptr);
+		if (MemoryInUse > (ptrdiff_t) MemoryLimit)
+			exceedMemoryLimit ();
+	}
+}
+
+static void countFree (const void *ptr)
+{
+	if (MemoryLimit > 0)
+		MemoryInUse -= malloc_usable_size ((void *) ptr);
+}
+
+extern bool setMemoryLimit (size_t limit)
+{
+	MemoryLimit = limit;
+	MemoryTight = limit / 4 * 3;
+	MemoryInUse = 0;
+	return true;
+}
+
+extern bool isMemoryTight (void)
+{
+	return isMemoryTightAfter (0);
+}
+
+extern bool isMemoryTightAfter (size_t size)
+{
+	return MemoryLimit > 0
+		&& MemoryInUse + (ptrdiff_t) size > (ptrdiff_t) MemoryTight;
+}
+#else
+# define countAlloc(ptr) do {} while (0)
+# define countFree(ptr) do {} while (0)
+
+extern bool setMemoryLimit (size_t limit)
+{
+	return limit == 0;
+}
+
+extern bool isMemoryTight (void)
+{
+	return false;
+}
+
+extern bool isMemoryTightAfter (size_t size)
+{
+	return false;
+}
+#endif
+
 /*
  *  Memory allocation functions
  */
 
 extern void *eMalloc (const size_t size)
 {
+	const int language = getAllocLanguage ();
 	void *buffer = malloc (size);
 
 	if (buffer == NULL)
 		error (FATAL, "out of memory");
 
+	recordAlloc (language, buffer, size, false);
+	countAlloc (buffer);
 	return buffer;
 }
 
 extern void *eCalloc (const size_t count, const size_t size)
 {
+	const int language = getAllocLanguage ();
 	void *buffer = calloc (count, size);
 
 	if (buffer == NULL)
 		error (FATAL, "out of memory");
 
+	recordAlloc (language, buffer, count * size, false);
+	countAlloc (buffer);
 	return buffer;
 }
 
@@ -236,9 +515,15 @@ extern void *eRealloc (void *const ptr, const size_t size)
 		buffer = eMalloc (size);
 	else
 	{
+		const int language = getAllocLanguage ();
+
+		recordFree (ptr, false);
+		countFree (ptr);
 		buffer = realloc (ptr, size);
 		if (buffer == NULL)
 			error (FATAL, "out of memory");
+		recordAlloc (language, buffer, size, true);
+		countAlloc (buffer);
 	}
 	return buffer;
 }
@@ -246,6 +531,8 @@ extern void *eRealloc (void *const ptr, const size_t size)
 extern void eFree (void *const ptr)
 {
 	Assert (ptr != NULL);
+	recordFree (ptr, true);
+	countFree (ptr);
 	free (ptr);
 }
 
@@ -440,21 +727,42 @@ extern void setCurrentDirectory (void) /* TODO */
 	canonicalizePath (CurrentDirectory);
 }
 
-/* For caching of stat() calls */
-extern fileStatus *eStat (const char *const fileName)
+/*  Look up NAME in the directory DIRFD, or FILENAME if DIRFD is negative,
+ *  and keep the status as the one of FILENAME.
+ */
+static fileStatus *eStat1 (int dirFd CTAGS_ATTR_UNUSED,
+						   const char *const name CTAGS_ATTR_UNUSED,
+						   const char *const fileName)
 {
 	struct stat status;
 	static fileStatus file;
 	if (file.name == NULL  ||  strcmp (fileName, file.name) != 0)
 	{
+		int r;
+
 		eStatFree (&file);
+		/* Nothing is left of the status of the last file. */
+		memset (&file, 0, sizeof (file));
 		file.name = eStrdup (fileName);
-		if (lstat (file.name, &status) != 0)
+#ifdef HAVE_FSTATAT
+		if (dirFd >= 0)
+			r = fstatat (dirFd, name, &status, AT_SYMLINK_NOFOLLOW);
+		else
+#endif
+		r = lstat (file.name, &status);
+		if (r != 0)
 			file.exists = false;
 		else
 		{
 			file.isSymbolicLink = (bool) S_ISLNK (status.st_mode);
-			if (file.isSymbolicLink  &&  stat (file.name, &status) != 0)
+#ifdef HAVE_FSTATAT
+			if (file.isSymbolicLink  &&  dirFd >= 0)
+				r = fstatat (dirFd, name, &status, 0);
+			else
+#endif
+			if (file.isSymbolicLink)
+				r = stat (file.name, &status);
+			if (r != 0)
 				file.exists = false;
 			else
 			{
@@ -466,12 +774,26 @@ extern fileStatus *eStat (const char *const fileName)
 				file.isSetuid = (bool) ((status.st_mode & S_ISUID) != 0);
 				file.isSetgid = (bool) ((status.st_mode & S_ISGID) != 0);
 				file.size = status.st_size;
+				file.mtime = (unsigned long) status.st_mtime;
+				file.inode = (unsigned long) status.st_ino;
 			}
 		}
 	}
 	return &file;
 }
 
+/* For caching of stat() calls */
+extern fileStatus *eStat (const char *const fileName)
+{
+	return eStat1 (-1, NULL, fileName);
+}
+
+extern fileStatus *eStatAt (int dirFd, const char *const name,
+							const char *const fileName)
+{
+	return eStat1 (dirFd, name, fileName);
+}
+
 extern void eStatFree (fileStatus *status)
 {
 	if (status->name != NULL)
@@ -493,6 +815,35 @@ extern bool doesExecutableExist (const char *const fileName)
 	return status->exists && status->isExecutable;
 }
 
+/*  Return the part of FILENAME naming an entry of the directory DIRNAME,
+ *  as combinePathAndFile () makes it, or NULL if FILENAME is not such an
+ *  entry. The entries of "." are named without a directory.
+ */
+extern const char *entryNameInDirectory (const char *const fileName,
+										 const char *const dirName)
+{
+	const size_t length = strlen (dirName);
+	const char *name, *p;
+
+	if (strcmp (dirName, ".") == 0)
+		name = fileName;
+	else if (strncmp (fileName, dirName, length) != 0 || length == 0)
+		return NULL;
+	else if (isPathSeparator (dirName [length - 1]))
+		name = fileName + length;
+	else if (isPathSeparator (fileName [length]))
+		name = fileName + length + 1;
+	else
+		return NULL;
+
+	if (*name == '\0')
+		return NULL;
+	for (p = name; *p != '\0'; p++)
+		if (isPathSeparator (*p))
+			return NULL;
+	return name;
+}
+
 extern bool isRecursiveLink (const char* const dirName)
 {
 	bool result = false;
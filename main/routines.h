@@ -85,6 +85,10 @@ typedef struct {
 
 		/* Size of file (pointed to) */
 	unsigned long size;
+
+		/* Modification time and serial number of file (pointed to) */
+	unsigned long mtime;
+	unsigned long inode;
 } fileStatus;
 
 /*
@@ -107,6 +111,31 @@ extern void *eRealloc (void *const ptr, const size_t size);
 extern void eFree (void *const ptr);
 extern void eFreeIndirect(void **ptr);
 
+/* For --memory-limit: the blocks of the functions above are counted from
+   now on, and ctags stops when they take more than LIMIT bytes; 0 sets
+   no limit. Return false if the sizes of the blocks cannot be known. */
+extern bool setMemoryLimit (size_t limit);
+/* Whether the blocks take most of the limit: the users of large buffers
+   then give memory back, or keep less of it, to stay under the limit. */
+extern bool isMemoryTight (void);
+/* Whether they would, with SIZE bytes more allocated. */
+extern bool isMemoryTightAfter (size_t size);
+
+#ifdef ALLOC_PROFILING
+/* The blocks of the functions above, made while parsing a language, or
+   out of parsing for the language -1 */
+typedef struct sAllocStats {
+	unsigned long allocs, reallocs, frees;
+	unsigned long long bytes;	/* asked for, including each realloc */
+	size_t live, peak;			/* not freed yet, and its maximum */
+} allocStats;
+
+/* FUNC returns the language parsing now, or -1. */
+extern void setAllocLanguageFunc (int (* func) (void));
+extern bool getAllocStats (int language, allocStats *stats);
+extern void getAllocTotals (allocStats *stats);
+#endif
+
 /* String manipulation functions */
 extern int struppercmp (const char *s1, const char *s2);
 extern int strnuppercmp (const char *s1, const char *s2, size_t n);
@@ -128,9 +157,15 @@ extern bool strToLong(const char *const string, int base, long *value);
 /* File system functions */
 extern void setCurrentDirectory (void);
 extern fileStatus *eStat (const char *const fileName);
+/* Like eStat (), but FILENAME is looked up as NAME in the directory opened
+   as DIRFD, where fstatat () is available. */
+extern fileStatus *eStatAt (int dirFd, const char *const name,
+							const char *const fileName);
 extern void eStatFree (fileStatus *status);
 extern bool doesFileExist (const char *const fileName);
 extern bool doesExecutableExist (const char *const fileName);
+extern const char *entryNameInDirectory (const char *const fileName,
+										 const char *const dirName);
 extern bool isRecursiveLink (const char* const dirName);
 extern bool isSameFile (const char *const name1, const char *const name2);
 extern const char *baseFilename (const char *const filePath);
@@ -46,6 +46,10 @@ int installSyscallFilter (void)
 	// main/parse.c:2764 : tagFilePosition (&tagfpos);
 	seccomp_rule_add (ctx, SCMP_ACT_ALLOW, SCMP_SYS (lseek), 0);
 
+	// Waiting for the requests and the workers of --jobs together.
+	seccomp_rule_add (ctx, SCMP_ACT_ALLOW, SCMP_SYS (poll), 0);
+	seccomp_rule_add (ctx, SCMP_ACT_ALLOW, SCMP_SYS (ppoll), 0);
+
 	verbose ("Entering sandbox\n");
 	int err = seccomp_load (ctx);
 	if (err < 0)
@@ -37,20 +37,104 @@ static const char *TR_DOSBATCH = "DosBatch";
 #define startsWith(line,prefix) \
   (strncmp(line, prefix, strlen(prefix)) == 0? true: false)
 
+#define TASTED_LINE_SIZE 0x800
+
+/* The bytes of INPUT the selectors read: the first --selector-window=N
+   ones of the stream, in memory, which is not moved. Return NULL if the
+   stream is not a memory stream. */
+static const unsigned char *getTastedBytes (MIO *input, size_t *size, bool *whole)
+{
+    const unsigned char *data = mio_memory_peek (input, size);
+
+    if (data == NULL)
+	return NULL;
+    *whole = true;
+    if (Option.selectorWindow > 0 && *size > Option.selectorWindow)
+    {
+	*size = Option.selectorWindow;
+	*whole = false;
+    }
+    return data;
+}
+
 static const char *selectByLines (MIO *input,
 				  const char* (* lineTaster) (const char *, void *),
 				  const char* defaultLang,
 				  void *userData)
 {
-    char line[0x800];
-    while (mio_gets(input, line, sizeof(line))) {
-	const char *lang = lineTaster (line, userData);
+    char line[TASTED_LINE_SIZE];
+    const unsigned char *p, *end;
+    size_t size;
+    bool whole;
+
+    p = getTastedBytes (input, &size, &whole);
+    if (p == NULL)
+    {
+	size_t read = 0;
+
+	while ((Option.selectorWindow == 0 || read < Option.selectorWindow)
+	       && mio_gets(input, line, sizeof(line))) {
+	    const char *lang = lineTaster (line, userData);
+	    if (lang)
+		return lang;
+	    read += strlen (line);
+	}
+	return defaultLang;
+    }
+
+    /* Like mio_gets () would, a line longer than the buffer is tasted
+       as several lines. A line cut by the end of the window is not
+       tasted. */
+    for (end = p + size; p < end; )
+    {
+	const unsigned char *nl = memchr (p, '\n', end - p);
+	size_t length = nl? (size_t) (nl + 1 - p): (size_t) (end - p);
+	const char *lang;
+
+	if (nl == NULL && !whole)
+	    break;
+	if (length > sizeof(line) - 1)
+	    length = sizeof(line) - 1;
+	memcpy (line, p, length);
+	line [length] = '\0';
+	p += length;
+
+	lang = lineTaster (line, userData);
 	if (lang)
 	    return lang;
     }
     return defaultLang;
 }
 
+/* Set FOUND to whether NEEDLE appears in the bytes of INPUT the
+   selectors read, searched without cutting them into lines. Return
+   false if INPUT is not a memory stream. */
+static bool findInTastedBytes (MIO *input, const char *needle, bool *found)
+{
+    const size_t length = strlen (needle);
+    const unsigned char *p, *end;
+    size_t size;
+    bool whole;
+
+    p = getTastedBytes (input, &size, &whole);
+    if (p == NULL)
+	return false;
+
+    *found = false;
+    for (end = p + size; (size_t) (end - p) >= length; p++)
+    {
+	p = memchr (p, needle [0], end - p - length + 1);
+	if (p == NULL)
+	    break;
+	if (memcmp (p, needle, length) == 0)
+	{
+	    *found = true;
+	    break;
+	}
+    }
+    return true;
+}
+
 /* Returns "Perl" or "Perl6" or NULL if it does not taste like anything */
 static const char *
 tastePerlLine (const char *line, void *data CTAGS_ATTR_UNUSED)
@@ -233,6 +317,7 @@ selectByArrowOfR (MIO *input,
 
     static langType R   = LANG_IGNORE;
     static langType Asm = LANG_IGNORE;
+    bool found;
 
     if (R == LANG_IGNORE)
 	    R = getNamedLanguage (TR_R, 0);
@@ -248,6 +333,9 @@ selectByArrowOfR (MIO *input,
     else if (! isLanguageEnabled (Asm))
 	    return TR_R;
 
+    if (findInTastedBytes (input, "<-", &found))
+	    return found? TR_R: NULL;
+
     return selectByLines (input, tasteR, NULL,
 			  NULL);
 }
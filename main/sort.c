@@ -23,6 +23,7 @@
 #endif
 #include <string.h>
 #include <stdio.h>
+#include <ctype.h>
 
 #include "debug.h"
 #include "entry.h"
@@ -47,114 +48,525 @@ extern void catFile (MIO *mio)
 	}
 }
 
+extern void failedSort (MIO *const mio, const char* msg)
+{
+	const char* const cannotSort = "cannot sort tag file";
+	if (mio != NULL)
+		mio_free (mio);
+	if (msg == NULL)
+		error (FATAL | PERROR, "%s", cannotSort);
+	else
+		error (FATAL, "%s: %s", msg, cannotSort);
+}
+
 #ifdef EXTERNAL_SORT
 
-#ifdef NON_CONST_PUTENV_PROTOTYPE
-# define PE_CONST
-#else
-# define PE_CONST const
+/*
+ *  These functions provide an external merge sort: the tag lines are
+ *  given to a tagSorter while the tag file is written, and kept in runs
+ *  fitting in SORT_MEMORY_BUDGET bytes; each run is sorted in memory,
+ *  and all the runs but the last one are spilled to temporary files.
+ *  The runs are then merged through a heap into the tag file.
+ *
+ *  The result is the same as "LC_ALL=C sort -u" (with -f for
+ *  --sort=foldcase), the sort utility this code replaces: lines are
+ *  compared as unsigned bytes, and of lines comparing equal only the
+ *  first one in the input is kept.
+ */
+#ifndef SORT_MEMORY_BUDGET
+# define SORT_MEMORY_BUDGET (128 * 1024 * 1024)
 #endif
 
-/*
-   Output file name should not be evaluated in system(3) function.
-   The name must be used as is. Quotations are required to block the
-   evaluation.
+/*  The size of the runs spilled once the memory is tight (--memory-limit). */
+#ifndef SORT_TIGHT_RUN
+# define SORT_TIGHT_RUN (4 * 1024 * 1024)
+#endif
 
-   Normal single-quotes are used to quote a cstring:
-   a => 'a'
-   " => '"'
+typedef int (* lineCompareFunc) (const char *, const char *);
 
-   If a single-quote is included in the cstring, use double quotes for quoting it.
-   ' => ''"'"''
-*/
-static void appendCstringWithQuotes (vString *dest, const char* cstr)
+/*  A sorted run being merged. A run is either spilled to a temporary
+ *  file, read from a sorted file given by tagSorterMergeFile () (without
+ *  NAME), or still in memory (only the last one).
+ */
+typedef struct sSortRun {
+	MIO *mio;
+	char *name;
+	vString *line;
+	tagSorterLineFilter keep;
+	void *keepData;
+
+	char **lines;
+	size_t count;
+
+	size_t next;
+	const char *current;
+} sortRun;
+
+struct sTagSorter {
+	lineCompareFunc compare;
+	unsigned char keys [256];	/* radix of each byte, for sortLines () */
+
+	char *arena;				/* lines of the run being read */
+	size_t arenaUsed;
+	size_t arenaSize;
+	size_t *offsets;			/* of the lines in arena */
+	size_t count;
+	size_t size;				/* of offsets */
+
+	sortRun *runs;
+	unsigned int runCount;
+};
+
+static int compareLines (const char *s1, const char *s2)
 {
-#ifdef WIN32
-	vStringCatS (dest, cstr);
-#else
-	vStringPut (dest, '\'');
-	for (const char *o = cstr; *o; o++)
+	return strcmp (s1, s2);
+}
+
+static int compareLinesFolded (const char *s1, const char *s2)
+{
+	const unsigned char *p1 = (const unsigned char *) s1;
+	const unsigned char *p2 = (const unsigned char *) s2;
+	int result;
+
+	while ((result = toupper (*p1) - toupper (*p2)) == 0 && *p1 != '\0')
 	{
-		if (*o == '\'')
-			vStringCatS (dest, "'\"'\"'");
-		else
-			vStringPut (dest, *o);
+		p1++;
+		p2++;
 	}
-	vStringPut (dest, '\'');
-#endif
+	return result;
 }
 
-extern void externalSortTags (const bool toStdout, MIO *tagFile)
+/*  Stable MSD radix sort, so that the first of equal lines stays first.
+ *  Lines are distributed by their byte at DEPTH (mapped through KEYS,
+ *  which folds the case for --sort=foldcase); the lines ending at DEPTH
+ *  are equal and stay in input order. Buckets are kept on an explicit
+ *  stack since lines sharing a long prefix would recurse deeply.
+ */
+#define SORT_INSERTION_THRESHOLD 32
+
+typedef struct sSortBucket {
+	size_t start;
+	size_t count;
+	size_t depth;
+} sortBucket;
+
+static int compareLinesFrom (const unsigned char *keys,
+							 const char *s1, const char *s2, size_t depth)
 {
-	const char *const sortNormalCommand = "sort -u";
-	const char *const sortFoldedCommand = "sort -u -f";
-	const char *sortCommand =
-		Option.sorted == SO_FOLDSORTED ? sortFoldedCommand : sortNormalCommand;
-# ifndef HAVE_SETENV
-	PE_CONST char *const sortOrder1 = "LC_COLLATE=C";
-	PE_CONST char *const sortOrder2 = "LC_ALL=C";
-# endif
-	vString *cmd = vStringNew ();
-	int ret = -1;
-
-	if (cmd != NULL)
+	const unsigned char *p1 = (const unsigned char *) s1 + depth;
+	const unsigned char *p2 = (const unsigned char *) s2 + depth;
+	int result;
+
+	while ((result = keys [*p1] - keys [*p2]) == 0 && *p1 != '\0')
 	{
-		/*  Ensure ASCII value sort order.
-		 */
-#if defined (HAVE_SETENV) || defined (HAVE_PUTENV)
-# ifdef HAVE_SETENV
-		setenv ("LC_COLLATE", "C", 1);
-		setenv ("LC_ALL", "C", 1);
-# else
-		putenv (sortOrder1);
-		putenv (sortOrder2);
-# endif
-		vStringCatS (cmd, sortCommand);
-		if (! toStdout)
+		p1++;
+		p2++;
+	}
+	return result;
+}
+
+static void insertionSortLines (const unsigned char *keys,
+								char **lines, size_t count, size_t depth)
+{
+	size_t i, j;
+
+	for (i = 1; i < count; i++)
+	{
+		char *line = lines [i];
+
+		for (j = i; j > 0 && compareLinesFrom (keys, line, lines [j - 1], depth) < 0; j--)
+			lines [j] = lines [j - 1];
+		lines [j] = line;
+	}
+}
+
+static void sortLines (const unsigned char *keys, char **lines, char **work, size_t count)
+{
+	unsigned char *cache = xMalloc (count + 1, unsigned char);
+	sortBucket *stack;
+	size_t stackSize = 64;
+	size_t n = 0;
+
+	stack = xMalloc (stackSize, sortBucket);
+	stack [n].start = 0;
+	stack [n].count = count;
+	stack [n].depth = 0;
+	n++;
+
+	while (n > 0)
+	{
+		sortBucket b = stack [--n];
+		char **l = lines + b.start;
+		size_t counts [256];
+		size_t i, pos;
+		unsigned int c;
+
+		if (b.count < SORT_INSERTION_THRESHOLD)
 		{
-			vStringCatS (cmd, " -o ");
-			appendCstringWithQuotes (cmd, tagFileName ());
-			vStringPut (cmd, ' ');
-			appendCstringWithQuotes (cmd, tagFileName ());
+			insertionSortLines (keys, l, b.count, b.depth);
+			continue;
 		}
-#else
-		vStringCatS (cmd, sortOrder1);
-		vStringPut (cmd, ' ');
-		vStringCatS (cmd, sortOrder2);
-		vStringPut (cmd, ' ');
-		vStringCatS (cmd, sortCommand);
-		if (! toStdout)
+
+		memset (counts, 0, sizeof (counts));
+		for (i = 0; i < b.count; i++)
 		{
-			vStringCats (cmd, " -o ");
-			appendCstringWithQuotes (cmd, tagFileName ());
-			vStringPut (cmd, ' ');
-			appendCstringWithQuotes (cmd, tagFileName ());
+			cache [i] = keys [(unsigned char) l [i][b.depth]];
+			counts [cache [i]]++;
 		}
-#endif
-		verbose ("system (\"%s\")\n", vStringValue (cmd));
-		if (toStdout)
+
+		/* A common prefix: nothing to move */
+		if (counts [cache [0]] == b.count)
+		{
+			if (cache [0] != 0)
+			{
+				b.depth++;
+				stack [n++] = b;
+			}
+			continue;
+		}
+
+		/* Line ends are keyed 0 by every key map; they sort first */
+		for (c = 0, pos = 0; c < 256; c++)
+		{
+			size_t k = counts [c];
+
+			counts [c] = pos;
+			if (c > 0 && k > 1)
+			{
+				if (n == stackSize)
+				{
+					stackSize *= 2;
+					stack = xRealloc (stack, stackSize, sortBucket);
+				}
+				stack [n].start = b.start + pos;
+				stack [n].count = k;
+				stack [n].depth = b.depth + 1;
+				n++;
+			}
+			pos += k;
+		}
+
+		memcpy (work, l, b.count * sizeof (*l));
+		for (i = 0; i < b.count; i++)
+			l [counts [cache [i]]++] = work [i];
+	}
+	eFree (stack);
+	eFree (cache);
+}
+
+/*  Read a line without its newline into VLINE; return false at the end
+ *  of MIO.
+ */
+static bool readSortLine (MIO *mio, vString *vLine)
+{
+	char buf [4096];
+
+	vStringClear (vLine);
+	while (mio_gets (mio, buf, sizeof (buf)) != NULL)
+	{
+		size_t len = strlen (buf);
+
+		if (len > 0 && buf [len - 1] == '\n')
 		{
-			const int fdstdin = 0;
-			int fdsave;
-
-			fdsave = dup (fdstdin);
-			if (fdsave < 0)
-				error (FATAL | PERROR, "cannot save stdin fd");
-			if (dup2 (fileno (mio_file_get_fp (tagFile)), fdstdin) < 0)
-				error (FATAL | PERROR, "cannot redirect stdin");
-			if (lseek (fdstdin, 0, SEEK_SET) != 0)
-				error (FATAL | PERROR, "cannot rewind tag file");
-			ret = system (vStringValue (cmd));
-			if (dup2 (fdsave, fdstdin) < 0)
-				error (FATAL | PERROR, "cannot restore stdin fd");
-			close (fdsave);
+			vStringNCatS (vLine, buf, len - 1);
+			return true;
+		}
+		vStringNCatS (vLine, buf, len);
+	}
+	if (mio_error (mio))
+		failedSort (NULL, NULL);
+	return vStringLength (vLine) > 0;
+}
+
+static char **sortArena (tagSorter *sorter)
+{
+	char **lines = xMalloc (sorter->count + 1, char *);
+	char **work = xMalloc (sorter->count + 1, char *);
+	size_t i;
+
+	for (i = 0; i < sorter->count; i++)
+		lines [i] = sorter->arena + sorter->offsets [i];
+	sortLines (sorter->keys, lines, work, sorter->count);
+	eFree (work);
+	return lines;
+}
+
+static sortRun *newSortRun (tagSorter *sorter)
+{
+	sortRun *run;
+
+	sorter->runs = xRealloc (sorter->runs, sorter->runCount + 1, sortRun);
+	run = sorter->runs + sorter->runCount++;
+	memset (run, 0, sizeof (*run));
+	return run;
+}
+
+static void spillRun (tagSorter *sorter)
+{
+	char **lines = sortArena (sorter);
+	sortRun *run = newSortRun (sorter);
+	size_t i;
+
+	run->mio = tempFile ("w+", &run->name);
+	verbose ("sort: spilling %lu lines to %s\n",
+			 (unsigned long) sorter->count, run->name);
+	for (i = 0; i < sorter->count; i++)
+	{
+		if (i > 0 && sorter->compare (lines [i], lines [i - 1]) == 0)
+			continue;
+		if (mio_puts (run->mio, lines [i]) == EOF
+			|| mio_putc (run->mio, '\n') == EOF)
+			failedSort (NULL, NULL);
+	}
+	eFree (lines);
+	if (mio_flush (run->mio) != 0)
+		failedSort (NULL, NULL);
+
+	sorter->arenaUsed = 0;
+	sorter->count = 0;
+
+	/* The run grew the arena; let it grow again from the start. */
+	if (isMemoryTight ())
+	{
+		eFree (sorter->arena);
+		sorter->arena = NULL;
+		sorter->arenaSize = 0;
+		eFree (sorter->offsets);
+		sorter->offsets = NULL;
+		sorter->size = 0;
+	}
+}
+
+static void addLine (tagSorter *sorter, const char *line, size_t length)
+{
+	const size_t len = length + 1;
+
+	/* A blank line is kept like any other, so that one of them is
+	   written, as sort -u would. */
+	/* Doubling the arena may be what takes the memory past the limit. */
+	if (sorter->count > 0
+		&& (sorter->arenaUsed + len > SORT_MEMORY_BUDGET
+			|| (sorter->arenaUsed >= SORT_TIGHT_RUN
+				&& (isMemoryTight ()
+					|| (sorter->arenaUsed + len > sorter->arenaSize
+						&& isMemoryTightAfter (sorter->arenaSize))))))
+		spillRun (sorter);
+
+	if (sorter->arenaUsed + len > sorter->arenaSize)
+	{
+		size_t size = sorter->arenaSize? sorter->arenaSize: 64 * 1024;
+		while (size < sorter->arenaUsed + len)
+			size *= 2;
+		sorter->arena = xRealloc (sorter->arena, size, char);
+		sorter->arenaSize = size;
+	}
+	if (sorter->count == sorter->size)
+	{
+		sorter->size = sorter->size? sorter->size * 2: 1024;
+		sorter->offsets = xRealloc (sorter->offsets, sorter->size, size_t);
+	}
+	memcpy (sorter->arena + sorter->arenaUsed, line, length);
+	sorter->arena [sorter->arenaUsed + length] = '\0';
+	sorter->offsets [sorter->count++] = sorter->arenaUsed;
+	sorter->arenaUsed += len;
+}
+
+static void advanceRun (sortRun *run)
+{
+	if (run->mio)
+		do
+			run->current = readSortLine (run->mio, run->line)? vStringValue (run->line): NULL;
+		while (run->current && run->keep && ! run->keep (run->current, run->keepData));
+	else
+		run->current = (run->next < run->count)? run->lines [run->next++]: NULL;
+}
+
+/*  Order of the heap: the current line, then the position of the run in
+ *  the input. */
+static bool runLess (const tagSorter *sorter, unsigned int a, unsigned int b)
+{
+	int r = sorter->compare (sorter->runs [a].current, sorter->runs [b].current);
+	return (r < 0 || (r == 0 && a < b));
+}
+
+static void siftDown (const tagSorter *sorter, unsigned int *heap, unsigned int n, unsigned int i)
+{
+	for (;;)
+	{
+		unsigned int least = i;
+		unsigned int l = 2 * i + 1;
+		unsigned int r = l + 1;
+		unsigned int tmp;
+
+		if (l < n && runLess (sorter, heap [l], heap [least]))
+			least = l;
+		if (r < n && runLess (sorter, heap [r], heap [least]))
+			least = r;
+		if (least == i)
+			break;
+		tmp = heap [i];
+		heap [i] = heap [least];
+		heap [least] = tmp;
+		i = least;
+	}
+}
+
+static unsigned long mergeRuns (tagSorter *sorter, MIO *out)
+{
+	unsigned int *heap = xMalloc (sorter->runCount, unsigned int);
+	unsigned int n = 0;
+	unsigned int i;
+	vString *prev = vStringNew ();
+	bool first = true;
+	unsigned long written = 0;
+
+	for (i = 0; i < sorter->runCount; i++)
+	{
+		advanceRun (sorter->runs + i);
+		if (sorter->runs [i].current)
+			heap [n++] = i;
+	}
+	for (i = n / 2; i > 0; i--)
+		siftDown (sorter, heap, n, i - 1);
+
+	while (n > 0)
+	{
+		sortRun *run = sorter->runs + heap [0];
+
+		if (first || sorter->compare (run->current, vStringValue (prev)) != 0)
+		{
+			if (mio_puts (out, run->current) == EOF
+				|| mio_putc (out, '\n') == EOF)
+				failedSort (out, NULL);
+			vStringCopyS (prev, run->current);
+			first = false;
+			written++;
+		}
+
+		advanceRun (run);
+		if (run->current == NULL)
+			heap [0] = heap [--n];
+		siftDown (sorter, heap, n, 0);
+	}
+
+	vStringDelete (prev);
+	eFree (heap);
+	return written;
+}
+
+extern tagSorter *tagSorterNew (void)
+{
+	tagSorter *sorter = xCalloc (1, tagSorter);
+	const bool fold = (Option.sorted == SO_FOLDSORTED);
+	unsigned int c;
+
+	sorter->compare = fold? compareLinesFolded: compareLines;
+	for (c = 0; c < 256; c++)
+		sorter->keys [c] = (unsigned char) (fold? toupper (c): c);
+	return sorter;
+}
+
+extern void tagSorterAddLines (tagSorter *sorter, const char *lines, size_t length)
+{
+	const char *const end = lines + length;
+
+	while (lines < end)
+	{
+		const char *nl = memchr (lines, '\n', end - lines);
+		const char *next = nl? nl + 1: end;
+
+		addLine (sorter, lines, (nl? nl: end) - lines);
+		lines = next;
+	}
+}
+
+extern void tagSorterAddFile (tagSorter *sorter, MIO *mio,
+							  tagSorterLineFilter keep, void *data)
+{
+	vString *vLine = vStringNew ();
+
+	while (readSortLine (mio, vLine))
+	{
+		if (keep == NULL || keep (vStringValue (vLine), data))
+			addLine (sorter, vStringValue (vLine), vStringLength (vLine));
+	}
+	vStringDelete (vLine);
+}
+
+extern void tagSorterMergeFile (tagSorter *sorter, MIO *mio,
+								tagSorterLineFilter keep, void *data)
+{
+	sortRun *run = newSortRun (sorter);
+
+	run->mio = mio;
+	run->keep = keep;
+	run->keepData = data;
+}
+
+static unsigned long writeLinesUnsorted (tagSorter *sorter, MIO *out)
+{
+	size_t i;
+
+	for (i = 0; i < sorter->count; i++)
+	{
+		if (mio_puts (out, sorter->arena + sorter->offsets [i]) == EOF
+			|| mio_putc (out, '\n') == EOF)
+			failedSort (out, NULL);
+	}
+	return (unsigned long) sorter->count;
+}
+
+extern unsigned long tagSorterFinish (tagSorter *sorter, MIO *out, bool sort)
+{
+	sortRun *run;
+	unsigned int i;
+	unsigned long written = 0;
+
+	if (out == NULL)
+		;
+	else if (! sort && sorter->runCount == 0)
+		written = writeLinesUnsorted (sorter, out);
+	else
+	{
+		/* The last run is merged from memory. */
+		run = newSortRun (sorter);
+		run->lines = sortArena (sorter);
+		run->count = sorter->count;
+		for (i = 0; i + 1 < sorter->runCount; i++)
+		{
+			sorter->runs [i].line = vStringNew ();
+			mio_seek (sorter->runs [i].mio, 0, SEEK_SET);
+		}
+		written = mergeRuns (sorter, out);
+	}
+
+	PrintStatus (("sort memory: %lu bytes, %u runs\n",
+				  (unsigned long) sorter->arenaSize, sorter->runCount));
+	for (i = 0; i < sorter->runCount; i++)
+	{
+		run = sorter->runs + i;
+		if (run->mio)
+		{
+			mio_free (run->mio);
+			if (run->name)
+			{
+				remove (run->name);
+				eFree (run->name);
+			}
+			if (run->line)
+				vStringDelete (run->line);
 		}
 		else
-			ret = system (vStringValue (cmd));
-		vStringDelete (cmd);
+			eFree (run->lines);
 	}
-	if (ret != 0)
-		error (FATAL | PERROR, "cannot sort tag file");
+	if (sorter->runs)
+		eFree (sorter->runs);
+	if (sorter->arena)
+		eFree (sorter->arena);
+	if (sorter->offsets)
+		eFree (sorter->offsets);
+	eFree (sorter);
+	return written;
 }
 
 #else
@@ -165,17 +577,6 @@ extern void externalSortTags (const bool toStdout, MIO *tagFile)
  *  so have lots of memory if you have large tag files.
  */
 
-extern void failedSort (MIO *const mio, const char* msg)
-{
-	const char* const cannotSort = "cannot sort tag file";
-	if (mio != NULL)
-		mio_free (mio);
-	if (msg == NULL)
-		error (FATAL | PERROR, "%s", cannotSort);
-	else
-		error (FATAL, "%s: %s", msg, cannotSort);
-}
-
 static int compareTagsFolded(const void *const one, const void *const two)
 {
 	const char *const line1 = *(const char* const*) one;
@@ -204,7 +605,7 @@ static void writeSortedTags (
 		mio = mio_new_fp (stdout, NULL);
 	else
 	{
-		mio = mio_new_file (tagFileName (), "w");
+		mio = newTagFileOutput (tagFileName (), "w");
 		if (mio == NULL)
 			failedSort (mio, NULL);
 	}
@@ -24,7 +24,21 @@
 extern void catFile (MIO *mio);
 
 #ifdef EXTERNAL_SORT
-extern void externalSortTags (const bool toStdout, MIO *tagFile);
+typedef struct sTagSorter tagSorter;
+typedef bool (* tagSorterLineFilter) (const char *line, void *data);
+
+extern tagSorter *tagSorterNew (void);
+extern void tagSorterAddLines (tagSorter *sorter, const char *lines, size_t length);
+/* Add the lines of MIO accepted by KEEP (all of them if KEEP is NULL). */
+extern void tagSorterAddFile (tagSorter *sorter, MIO *mio,
+							  tagSorterLineFilter keep, void *data);
+/* Like tagSorterAddFile (), but the lines of MIO, which must be sorted
+   already, are read while merging. SORTER takes MIO. */
+extern void tagSorterMergeFile (tagSorter *sorter, MIO *mio,
+								tagSorterLineFilter keep, void *data);
+/* Write the lines to OUT (if not NULL), sorted if SORT, and delete SORTER.
+   Return the number of lines written. */
+extern unsigned long tagSorterFinish (tagSorter *sorter, MIO *out, bool sort);
 #else
 extern void internalSortTags (const bool toStdout,
 			      MIO *mio,
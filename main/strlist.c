@@ -231,6 +231,12 @@ static bool fileNameMatched (
 #endif
 }
 
+extern bool isFileNamePatternLiteral (const char* const pattern)
+{
+	/* fnmatch matches a pattern having none of these only to itself. */
+	return strpbrk (pattern, "*?[\\") == NULL;
+}
+
 extern bool stringListFileMatched (
 			const stringList* const current, const char* const fileName)
 {
@@ -264,57 +270,59 @@ extern void stringListReverse (const stringList *const current)
 	ptrArrayReverse (current);
 }
 
-extern stringList *stringListNewBySplittingWordIntoSubwords (const char* originalWord)
+extern const char *nextSubword (const char *cursor, size_t *length)
 {
-	stringList *list = stringListNew ();
+	const char *start, *end;
 
-	vString *subword = vStringNew();
-	for (const char *cursor = originalWord; *cursor != '\0'; cursor++)
+	/* The characters which are not letters or digits separate subwords. */
+	while (*cursor != '\0' && !islower ((unsigned char) *cursor)
+		   && !isupper ((unsigned char) *cursor) && !isdigit ((unsigned char) *cursor))
+		cursor++;
+	if (*cursor == '\0')
+		return NULL;
+
+	start = cursor;
+	for (end = start; ; end++)
 	{
-		if (islower(*cursor))
+		if (islower ((unsigned char) *end))
 		{
-			if (vStringLength (subword) > 1 &&
-				isupper(vStringLast(subword)) &&
-				isupper(vStringItem(subword, vStringLength (subword) - 2)))
+			/* ABC + d => AB, Cd */
+			if (end - start > 1 && isupper ((unsigned char) end [-1])
+				&& isupper ((unsigned char) end [-2]))
 			{
-				/* ABC + d => AB, Cd */
-				char last = vStringLast(subword);
-				vStringTruncate (subword, vStringLength (subword) - 1);
-				stringListAdd (list, subword);
-				subword = vStringNew();
-				vStringPut(subword, last);
+				end--;
+				break;
 			}
 			/* A + b => Ab,
 			   a + b => ab */
-			vStringPut(subword, *cursor);
 		}
-		else if (isupper(*cursor))
+		else if (isupper ((unsigned char) *end))
 		{
 			/* a + B => a, B */
-			if (vStringLength (subword) > 0 && islower(vStringLast(subword)))
-			{
-				stringListAdd (list, subword);
-				subword = vStringNew();
-			}
+			if (end > start && islower ((unsigned char) end [-1]))
+				break;
 			/* A + B => AB */
-			vStringPut(subword, *cursor);
-		}
-		else if (isdigit(*cursor))
-			vStringPut(subword, *cursor);
-		else
-		{
-			if (vStringLength(subword) > 0)
-			{
-				stringListAdd (list, subword);
-				subword = vStringNew();
-			}
 		}
+		else if (!isdigit ((unsigned char) *end))
+			break;
 	}
+	*length = end - start;
+	return start;
+}
 
-	if (vStringLength(subword) > 0)
-		stringListAdd (list, subword);
-	else
-		vStringDelete(subword);
+extern stringList *stringListNewBySplittingWordIntoSubwords (const char* originalWord)
+{
+	stringList *list = stringListNew ();
+	const char *subword = originalWord;
+	size_t length;
 
+	while ((subword = nextSubword (subword, &length)) != NULL)
+	{
+		vString *const item = vStringNew ();
+
+		vStringNCatS (item, subword, length);
+		stringListAdd (list, item);
+		subword += length;
+	}
 	return list;
 }
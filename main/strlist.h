@@ -46,11 +46,16 @@ extern bool stringListHasTest (const stringList *const current,
 extern bool stringListDeleteItemExtension (stringList* const current, const char* const extension);
 extern bool stringListExtensionMatched (const stringList* const list, const char* const extension);
 extern vString* stringListExtensionFinds (const stringList* const list, const char* const extension);
+extern bool isFileNamePatternLiteral (const char* const pattern);
 extern bool stringListFileMatched (const stringList* const list, const char* const str);
 extern vString* stringListFileFinds (const stringList* const list, const char* const str);
 extern void stringListPrint (const stringList *const current, FILE *fp);
 extern void stringListReverse (const stringList *const current);
 
+/* Find the subword of a word starting at CURSOR or after it, and store
+ * its length at LENGTH. The next one is found from the end of it. Return
+ * NULL if there is no more subword. */
+extern const char *nextSubword (const char *cursor, size_t *length);
 extern stringList *stringListNewBySplittingWordIntoSubwords (const char* originalWord);
 
 #endif  /* CTAGS_MAIN_STRLIST_H */
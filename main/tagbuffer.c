@@ -0,0 +1,256 @@
+/*
+*   Copyright (c) 2026, Universal Ctags Team
+*
+*   This source code is released for free distribution under the terms of the
+*   GNU General Public License version 2 or (at your option) any later version.
+*
+*   This module contains functions for the edited buffers of interactive
+*   mode: the contents of a buffer and its tag lines are kept, so that a
+*   client can send an edit instead of the whole buffer, and get only the
+*   tag lines which differ from those of the last parse.
+*
+*   The buffer is parsed again from its start: the state of a parser at a
+*   point in the file, like the macros defined before it, cannot be
+*   restored. What is saved is copying the buffer through stdin and
+*   sending the tags not changed by the edit.
+*/
+
+/*
+*   INCLUDE FILES
+*/
+#include "general.h"  /* must always come first */
+
+#include <string.h>
+#include <stdlib.h>
+
+#include "debug.h"
+#include "entry.h"
+#include "htable.h"
+#include "mio.h"
+#include "parse.h"
+#include "routines.h"
+#include "tagbuffer.h"
+
+/*
+*   DATA DECLARATIONS
+*/
+typedef struct sTagBuffer {
+	char *contents;
+	size_t size;				/* of contents */
+	MIO *output;				/* tag lines of the last parse */
+	size_t outputSize;
+} tagBuffer;
+
+struct sTagBufferSet {
+	hashTable *buffers;			/* name -> tagBuffer */
+};
+
+typedef struct sTagLine {
+	const char *line;
+	size_t length;
+	bool matched;				/* with a line of the other parse */
+} tagLine;
+
+/*
+*   FUNCTION DEFINITIONS
+*/
+
+static void deleteTagBuffer (void *data)
+{
+	tagBuffer *buffer = data;
+
+	if (buffer->contents)
+		eFree (buffer->contents);
+	if (buffer->output)
+		mio_free (buffer->output);
+	eFree (buffer);
+}
+
+extern tagBufferSet *tagBufferSetNew (void)
+{
+	tagBufferSet *set = xMalloc (1, tagBufferSet);
+
+	set->buffers = hashTableNew (127, hashCstrhash, hashCstreq,
+								 eFree, deleteTagBuffer);
+	return set;
+}
+
+extern void tagBufferSetDelete (tagBufferSet *set)
+{
+	hashTableDelete (set->buffers);
+	eFree (set);
+}
+
+/* Parse the buffer of FILENAME, keeping its tag lines. */
+static void parseTagBuffer (const char *const fileName, tagBuffer *buffer)
+{
+	MIO *input = mio_new_memory ((unsigned char *) buffer->contents,
+								 buffer->size, NULL, NULL);
+	tagFileFragment fragment;
+
+	buffer->output = mio_new_memory (NULL, 0, eRealloc, eFree);
+	openTagFileFragment (buffer->output);
+	parseFileWithMio (fileName, input);
+	closeTagFileFragment (&fragment);
+	mio_free (input);
+	buffer->outputSize = (size_t) fragment.size;
+}
+
+/* Split the tag lines of BUFFER; COUNT is set to their number. */
+static tagLine *splitTagLines (tagBuffer *buffer, size_t *count)
+{
+	const char *p = (const char *) mio_memory_get_data (buffer->output, NULL);
+	const char *const end = p + buffer->outputSize;
+	size_t n = 0, size = 64;
+	tagLine *lines = xMalloc (size, tagLine);
+
+	while (p < end)
+	{
+		const char *nl = memchr (p, '\n', end - p);
+		const char *next = nl? nl + 1: end;
+
+		if (n == size)
+		{
+			size *= 2;
+			lines = xRealloc (lines, size, tagLine);
+		}
+		lines [n].line = p;
+		lines [n].length = (nl? nl: end) - p;
+		lines [n].matched = false;
+		n++;
+		p = next;
+	}
+	*count = n;
+	return lines;
+}
+
+static int compareTagLineTexts (const tagLine *x, const tagLine *y)
+{
+	const size_t length = (x->length < y->length)? x->length: y->length;
+	const int r = memcmp (x->line, y->line, length);
+
+	if (r != 0 || x->length == y->length)
+		return r;
+	return (x->length < y->length)? -1: 1;
+}
+
+static int compareTagLines (const void *a, const void *b)
+{
+	const tagLine *const x = *(const tagLine *const *) a;
+	const tagLine *const y = *(const tagLine *const *) b;
+	const int r = compareTagLineTexts (x, y);
+
+	if (r != 0)
+		return r;
+	/* The same lines are matched in the order of the file. */
+	return (x < y)? -1: (x > y);
+}
+
+static tagLine **sortTagLines (tagLine *lines, size_t count)
+{
+	tagLine **sorted = xMalloc (count? count: 1, tagLine *);
+	size_t i;
+
+	for (i = 0; i < count; i++)
+		sorted [i] = lines + i;
+	qsort (sorted, count, sizeof (*sorted), compareTagLines);
+	return sorted;
+}
+
+/* Mark the lines found in both OLD_LINES and NEW_LINES. */
+static void matchTagLines (tagLine *oldLines, size_t oldCount,
+						   tagLine *newLines, size_t newCount)
+{
+	tagLine **oldSorted = sortTagLines (oldLines, oldCount);
+	tagLine **newSorted = sortTagLines (newLines, newCount);
+	size_t i = 0, j = 0;
+
+	while (i < oldCount && j < newCount)
+	{
+		const int r = compareTagLineTexts (oldSorted [i], newSorted [j]);
+
+		if (r < 0)
+			i++;
+		else if (r > 0)
+			j++;
+		else
+		{
+			oldSorted [i++]->matched = true;
+			newSorted [j++]->matched = true;
+		}
+	}
+	eFree (newSorted);
+	eFree (oldSorted);
+}
+
+extern void tagBufferPut (tagBufferSet *set, const char *const fileName,
+						  const char *contents, size_t size,
+						  tagBufferLineFunc fn, void *data)
+{
+	tagBuffer *buffer = xCalloc (1, tagBuffer);
+	tagLine *lines;
+	size_t count, i;
+
+	buffer->contents = xMalloc (size? size: 1, char);
+	memcpy (buffer->contents, contents, size);
+	buffer->size = size;
+	parseTagBuffer (fileName, buffer);
+
+	/* The buffer kept before is replaced. */
+	hashTableDeleteItem (set->buffers, (void *) fileName);
+	hashTablePutItem (set->buffers, eStrdup (fileName), buffer);
+
+	lines = splitTagLines (buffer, &count);
+	for (i = 0; i < count; i++)
+		fn (lines [i].line, lines [i].length, data);
+	eFree (lines);
+}
+
+extern bool tagBufferEdit (tagBufferSet *set, const char *const fileName,
+						   size_t offset, size_t length,
+						   const char *text, size_t size,
+						   tagBufferLineFunc removed, tagBufferLineFunc added,
+						   void *data)
+{
+	tagBuffer *buffer = hashTableGetItem (set->buffers, fileName);
+	MIO *oldOutput;
+	tagLine *oldLines, *newLines;
+	size_t oldCount, newCount, i;
+	size_t newSize;
+
+	if (buffer == NULL || offset > buffer->size
+		|| length > buffer->size - offset)
+		return false;
+
+	newSize = buffer->size - length + size;
+	if (size > length)
+		buffer->contents = xRealloc (buffer->contents, newSize, char);
+	memmove (buffer->contents + offset + size,
+			 buffer->contents + offset + length,
+			 buffer->size - offset - length);
+	memcpy (buffer->contents + offset, text, size);
+	buffer->size = newSize;
+
+	oldOutput = buffer->output;
+	oldLines = splitTagLines (buffer, &oldCount);
+	parseTagBuffer (fileName, buffer);
+	newLines = splitTagLines (buffer, &newCount);
+
+	matchTagLines (oldLines, oldCount, newLines, newCount);
+	for (i = 0; i < oldCount; i++)
+		if (! oldLines [i].matched)
+			removed (oldLines [i].line, oldLines [i].length, data);
+	for (i = 0; i < newCount; i++)
+		if (! newLines [i].matched)
+			added (newLines [i].line, newLines [i].length, data);
+
+	eFree (newLines);
+	eFree (oldLines);
+	mio_free (oldOutput);
+	return true;
+}
+
+extern bool tagBufferRemove (tagBufferSet *set, const char *const fileName)
+{
+	return hashTableDeleteItem (set->buffers, (void *) fileName);
+}
@@ -0,0 +1,53 @@
+/*
+*   Copyright (c) 2026, Universal Ctags Team
+*
+*   This source code is released for free distribution under the terms of the
+*   GNU General Public License version 2 or (at your option) any later version.
+*
+*   External interface to tagbuffer.c
+*/
+#ifndef CTAGS_MAIN_TAGBUFFER_H
+#define CTAGS_MAIN_TAGBUFFER_H
+
+/*
+*   INCLUDE FILES
+*/
+#include "general.h"  /* must always come first */
+
+#include <stddef.h>
+
+/*
+*   DATA DECLARATIONS
+*/
+typedef struct sTagBufferSet tagBufferSet;
+
+/* LINE is a tag line without its newline. */
+typedef void (* tagBufferLineFunc) (const char *line, size_t length, void *data);
+
+/*
+*   FUNCTION PROTOTYPES
+*/
+extern tagBufferSet *tagBufferSetNew (void);
+extern void tagBufferSetDelete (tagBufferSet *set);
+
+/* Keep SIZE bytes of CONTENTS as the buffer of FILENAME, replacing the
+   one kept, and parse it. FN is called for each tag line. */
+extern void tagBufferPut (tagBufferSet *set, const char *const fileName,
+						  const char *contents, size_t size,
+						  tagBufferLineFunc fn, void *data);
+
+/* Replace LENGTH bytes at OFFSET in the buffer of FILENAME with SIZE
+   bytes of TEXT, and parse it again. REMOVED is called for each tag
+   line of the last parse not made any more, then ADDED for each new one.
+   Return false, with the buffer left as it is, if there is no buffer of
+   FILENAME or the range is not in it. */
+extern bool tagBufferEdit (tagBufferSet *set, const char *const fileName,
+						   size_t offset, size_t length,
+						   const char *text, size_t size,
+						   tagBufferLineFunc removed, tagBufferLineFunc added,
+						   void *data);
+
+/* Forget the buffer of FILENAME. Return whether there was one. */
+extern bool tagBufferRemove (tagBufferSet *set, const char *const fileName);
+
+#endif  /* CTAGS_MAIN_TAGBUFFER_H */
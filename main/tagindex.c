@@ -0,0 +1,408 @@
+/*
+*   Copyright (c) 2026, Universal Ctags Team
+*
+*   This source code is released for free distribution under the terms of the
+*   GNU General Public License version 2 or (at your option) any later version.
+*
+*   This module contains functions for the tag index of interactive mode:
+*   the tags of watched files are kept in memory, in the u-ctags format,
+*   and updated when the files change, so that a long running ctags can
+*   answer queries without parsing the files again.
+*
+*   Changes are noticed with inotify where it is available. Elsewhere the
+*   indexed files are stat'ed on each refresh, and new files in watched
+*   directories are not noticed.
+*/
+
+/*
+*   INCLUDE FILES
+*/
+#include "general.h"  /* must always come first */
+
+#include <string.h>
+#include <errno.h>
+#ifdef HAVE_UNISTD_H
+# include <unistd.h>
+#endif
+#if defined (HAVE_SYS_INOTIFY_H) && defined (HAVE_INOTIFY_INIT1)
+# include <sys/inotify.h>
+# define TAG_INDEX_USE_INOTIFY
+#endif
+
+#include "debug.h"
+#include "entry.h"
+#include "htable.h"
+#include "options.h"
+#include "parse.h"
+#include "ptrarray.h"
+#include "routines.h"
+#include "sort.h"
+#include "tagindex.h"
+#include "vstring.h"
+#include "writer.h"
+
+/*
+*   DATA DECLARATIONS
+*/
+typedef struct sIndexedFile {
+	MIO *output;				/* tag lines */
+	size_t size;				/* of output */
+	unsigned long numTags;
+	unsigned long mtime, fileSize;
+	bool changed;				/* since the last refresh */
+} indexedFile;
+
+struct sTagIndex {
+	hashTable *files;			/* name -> indexedFile */
+	tagIndexScanFunc scan;
+#ifdef TAG_INDEX_USE_INOTIFY
+	int fd;
+	hashTable *directories;		/* watch descriptor -> directory name */
+#endif
+};
+
+/*
+*   FUNCTION DEFINITIONS
+*/
+
+static void deleteIndexedFile (void *data)
+{
+	indexedFile *file = data;
+
+	if (file->output)
+		mio_free (file->output);
+	eFree (file);
+}
+
+extern tagIndex *tagIndexNew (tagIndexScanFunc scan)
+{
+	tagIndex *index = xMalloc (1, tagIndex);
+
+	index->files = hashTableNew (1021, hashCstrhash, hashCstreq,
+								 eFree, deleteIndexedFile);
+	index->scan = scan;
+#ifdef TAG_INDEX_USE_INOTIFY
+	index->fd = inotify_init1 (IN_NONBLOCK | IN_CLOEXEC);
+	if (index->fd < 0)
+		error (WARNING | PERROR, "cannot watch files; changes are found by stat'ing them");
+	index->directories = hashTableNew (127, hashInthash, hashInteq,
+									   eFree, eFree);
+#endif
+	return index;
+}
+
+extern void tagIndexDelete (tagIndex *index)
+{
+	hashTableDelete (index->files);
+#ifdef TAG_INDEX_USE_INOTIFY
+	if (index->fd >= 0)
+		close (index->fd);
+	hashTableDelete (index->directories);
+#endif
+	eFree (index);
+}
+
+extern void tagIndexAddFile (tagIndex *index, const char *const fileName,
+							 const fileStatus *const status)
+{
+	indexedFile *file = hashTableGetItem (index->files, fileName);
+	const writerType writer = getTagWriterType ();
+	tagFileFragment fragment;
+
+	if (file == NULL)
+	{
+		file = xCalloc (1, indexedFile);
+		hashTablePutItem (index->files, eStrdup (fileName), file);
+	}
+	else if (file->output)
+		mio_free (file->output);
+
+	file->mtime = status->mtime;
+	file->fileSize = status->size;
+	file->changed = false;
+	file->output = mio_new_memory (NULL, 0, eRealloc, eFree);
+
+	/* The index keeps the tags in one format, whatever the writer of
+	   the interactive mode is. */
+	setTagWriter (WRITER_U_CTAGS);
+	openTagFileFragment (file->output);
+	parseFile (fileName);
+	closeTagFileFragment (&fragment);
+	setTagWriter (writer);
+
+	file->size = (size_t) fragment.size;
+	file->numTags = fragment.numTags;
+}
+
+extern void tagIndexAddDirectory (tagIndex *index CTAGS_ATTR_UNUSED,
+								  const char *const dirName CTAGS_ATTR_UNUSED)
+{
+#ifdef TAG_INDEX_USE_INOTIFY
+	int wd;
+	int *key;
+
+	if (index->fd < 0)
+		return;
+
+	wd = inotify_add_watch (index->fd, dirName,
+							IN_CLOSE_WRITE | IN_CREATE | IN_DELETE
+							| IN_MOVED_FROM | IN_MOVED_TO | IN_ONLYDIR);
+	if (wd < 0)
+	{
+		error (WARNING | PERROR, "cannot watch directory \"%s\"", dirName);
+		return;
+	}
+
+	/* A directory watched again keeps its descriptor. */
+	if (hashTableHasItem (index->directories, &wd))
+		hashTableDeleteItem (index->directories, &wd);
+	key = xMalloc (1, int);
+	*key = wd;
+	hashTablePutItem (index->directories, key, eStrdup (dirName));
+#endif
+}
+
+static bool isWatchingFiles (tagIndex *index CTAGS_ATTR_UNUSED)
+{
+#ifdef TAG_INDEX_USE_INOTIFY
+	return index->fd >= 0;
+#else
+	return false;
+#endif
+}
+
+#ifdef TAG_INDEX_USE_INOTIFY
+struct changedPrefix {
+	const char *prefix;
+	size_t length;
+};
+
+static void markFileWithPrefix (void *key, void *value, void *user_data)
+{
+	const struct changedPrefix *p = user_data;
+	indexedFile *file = value;
+
+	if (strncmp (key, p->prefix, p->length) == 0)
+		file->changed = true;
+}
+
+static void handleEvent (tagIndex *index, const struct inotify_event *event,
+						 ptrArray *appeared)
+{
+	const char *dirName;
+	vString *path;
+	indexedFile *file;
+
+	if (event->mask & IN_Q_OVERFLOW)
+	{
+		struct changedPrefix all = { "", 0 };
+
+		verbose ("tag index: too many changes; checking all files\n");
+		hashTableForeachItem (index->files, markFileWithPrefix, &all);
+		return;
+	}
+	if (event->mask & IN_IGNORED)
+	{
+		hashTableDeleteItem (index->directories, (void *) &event->wd);
+		return;
+	}
+
+	dirName = hashTableGetItem (index->directories, &event->wd);
+	if (dirName == NULL || event->len == 0)
+		return;
+
+	path = vStringNewInit (dirName);
+	vStringPut (path, OUTPUT_PATH_SEPARATOR);
+	vStringCatS (path, event->name);
+
+	file = hashTableGetItem (index->files, vStringValue (path));
+	if (file)
+		file->changed = true;
+	else if (event->mask & (IN_DELETE | IN_MOVED_FROM))
+	{
+		if (event->mask & IN_ISDIR)
+		{
+			/* The files in a directory moved away are not reported. */
+			struct changedPrefix p;
+
+			vStringPut (path, OUTPUT_PATH_SEPARATOR);
+			p.prefix = vStringValue (path);
+			p.length = vStringLength (path);
+			hashTableForeachItem (index->files, markFileWithPrefix, &p);
+		}
+	}
+	else
+	{
+		ptrArrayAdd (appeared, path);
+		return;
+	}
+	vStringDelete (path);
+}
+
+static void readEvents (tagIndex *index, ptrArray *appeared)
+{
+	union {
+		struct inotify_event event;	/* for the alignment */
+		char bytes [4096];
+	} buffer;
+	ssize_t length;
+
+	if (index->fd < 0)
+		return;
+
+	while ((length = read (index->fd, buffer.bytes, sizeof (buffer))) > 0)
+	{
+		const char *p = buffer.bytes;
+
+		while (p < buffer.bytes + length)
+		{
+			const struct inotify_event *event = (const struct inotify_event *) p;
+
+			handleEvent (index, event, appeared);
+			p += sizeof (struct inotify_event) + event->len;
+		}
+	}
+	if (length < 0 && errno != EAGAIN)
+		error (WARNING | PERROR, "cannot read file change events");
+}
+#endif
+
+struct candidates {
+	tagIndex *index;
+	ptrArray *names;
+};
+
+static void collectCandidate (void *key, void *value, void *user_data)
+{
+	indexedFile *file = value;
+	struct candidates *candidates = user_data;
+
+	/* Only the files reported to be changed, unless inotify is not
+	   usable. */
+	if (file->changed || ! isWatchingFiles (candidates->index))
+		ptrArrayAdd (candidates->names, vStringNewInit (key));
+}
+
+extern unsigned int tagIndexRefresh (tagIndex *index)
+{
+	struct candidates candidates;
+	ptrArray *appeared = ptrArrayNew ((ptrArrayDeleteFunc) vStringDelete);
+	unsigned int updated = 0;
+	unsigned int i;
+
+	candidates.index = index;
+	candidates.names = ptrArrayNew ((ptrArrayDeleteFunc) vStringDelete);
+#ifdef TAG_INDEX_USE_INOTIFY
+	readEvents (index, appeared);
+#endif
+	hashTableForeachItem (index->files, collectCandidate, &candidates);
+
+	for (i = 0; i < ptrArrayCount (candidates.names); i++)
+	{
+		const char *name = vStringValue ((vString *) ptrArrayItem (candidates.names, i));
+		indexedFile *file = hashTableGetItem (index->files, name);
+		fileStatus *status = eStat (name);
+
+		if (! status->exists || ! status->isNormalFile)
+		{
+			verbose ("tag index: removing \"%s\"\n", name);
+			hashTableDeleteItem (index->files, (void *) name);
+			updated++;
+		}
+		else if (file->changed
+				 || file->mtime != status->mtime || file->fileSize != status->size)
+		{
+			fileStatus copy = *status;
+
+			verbose ("tag index: updating \"%s\"\n", name);
+			tagIndexAddFile (index, name, &copy);
+			updated++;
+		}
+		eStatFree (status);
+	}
+
+	for (i = 0; i < ptrArrayCount (appeared); i++)
+	{
+		const char *path = vStringValue ((vString *) ptrArrayItem (appeared, i));
+		const unsigned int before = tagIndexCountFiles (index);
+
+		index->scan (index, path);
+		updated += tagIndexCountFiles (index) - before;
+	}
+
+	ptrArrayDelete (appeared);
+	ptrArrayDelete (candidates.names);
+	return updated;
+}
+
+extern unsigned int tagIndexCountFiles (tagIndex *index)
+{
+	return (unsigned int) hashTableCountItem (index->files);
+}
+
+struct findData {
+	const char *name;
+	size_t length;
+	tagIndexLineFunc fn;
+	void *data;
+	unsigned long found;
+};
+
+static void findInFile (void *key CTAGS_ATTR_UNUSED, void *value, void *user_data)
+{
+	indexedFile *file = value;
+	struct findData *find = user_data;
+	const char *line = (const char *) mio_memory_get_data (file->output, NULL);
+	const char *const end = line + file->size;
+
+	while (line < end)
+	{
+		const char *nl = memchr (line, '\n', end - line);
+		const char *next = nl? nl + 1: end;
+
+		if ((size_t) (next - line) > find->length
+			&& line [find->length] == '\t'
+			&& strncmp (line, find->name, find->length) == 0)
+		{
+			find->fn (line, (nl? nl: end) - line, find->data);
+			find->found++;
+		}
+		line = next;
+	}
+}
+
+extern unsigned long tagIndexFind (tagIndex *index, const char *const name,
+								   tagIndexLineFunc fn, void *data)
+{
+	struct findData find = { name, strlen (name), fn, data, 0 };
+
+	hashTableForeachItem (index->files, findInFile, &find);
+	return find.found;
+}
+
+static void writeFile (void *key CTAGS_ATTR_UNUSED, void *value, void *user_data)
+{
+	indexedFile *file = value;
+	const char *output = (const char *) mio_memory_get_data (file->output, NULL);
+
+#ifdef EXTERNAL_SORT
+	tagSorterAddLines (user_data, output, file->size);
+#else
+	if (file->size > 0)
+		mio_write (user_data, output, 1, file->size);
+#endif
+}
+
+extern void tagIndexWrite (tagIndex *index, MIO *mio)
+{
+#ifdef EXTERNAL_SORT
+	/* Sorted even though interactive mode implies --sort=no: the file
+	   is for the tools reading tag files. */
+	tagSorter *sorter = tagSorterNew ();
+
+	hashTableForeachItem (index->files, writeFile, sorter);
+	tagSorterFinish (sorter, mio, true);
+#else
+	hashTableForeachItem (index->files, writeFile, mio);
+#endif
+}
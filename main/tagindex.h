@@ -0,0 +1,54 @@
+/*
+*   Copyright (c) 2026, Universal Ctags Team
+*
+*   This source code is released for free distribution under the terms of the
+*   GNU General Public License version 2 or (at your option) any later version.
+*
+*   External interface to tagindex.c
+*/
+#ifndef CTAGS_MAIN_TAGINDEX_H
+#define CTAGS_MAIN_TAGINDEX_H
+
+/*
+*   INCLUDE FILES
+*/
+#include "general.h"  /* must always come first */
+
+#include "mio.h"
+#include "routines.h"
+
+/*
+*   DATA DECLARATIONS
+*/
+typedef struct sTagIndex tagIndex;
+
+/* Called for a file or directory which appeared in a watched directory. */
+typedef void (* tagIndexScanFunc) (tagIndex *index, const char *const path);
+typedef void (* tagIndexLineFunc) (const char *line, size_t length, void *data);
+
+/*
+*   FUNCTION PROTOTYPES
+*/
+extern tagIndex *tagIndexNew (tagIndexScanFunc scan);
+extern void tagIndexDelete (tagIndex *index);
+
+/* Parse FILENAME into the index, replacing its tags if it is indexed. */
+extern void tagIndexAddFile (tagIndex *index, const char *const fileName,
+							 const fileStatus *const status);
+/* Watch the directory for files created in it. */
+extern void tagIndexAddDirectory (tagIndex *index, const char *const dirName);
+
+/* Parse again the files changed since the last call, and drop the tags
+   of the removed files. Return the number of files updated. */
+extern unsigned int tagIndexRefresh (tagIndex *index);
+
+extern unsigned int tagIndexCountFiles (tagIndex *index);
+/* Call FN for each tag line of a tag named NAME. Return the number of
+   lines. */
+extern unsigned long tagIndexFind (tagIndex *index, const char *const name,
+								   tagIndexLineFunc fn, void *data);
+/* Write all the tag lines to MIO, sorted where the external sort is
+   available. */
+extern void tagIndexWrite (tagIndex *index, MIO *mio);
+
+#endif  /* CTAGS_MAIN_TAGINDEX_H */
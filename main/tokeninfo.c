@@ -86,6 +86,8 @@ void  flashTokenBacklog (struct tokenInfoClass *klass)
 {
 	if (klass->backlog)
 		ptrArrayClear (klass->backlog);
+	if (klass->pool)
+		objPoolTrim (klass->pool);
 }
 
 void tokenDestroy (tokenInfo *token)
@@ -193,6 +195,7 @@ bool tokenSkipOverPairFull (tokenInfo *token, void *data)
 		return false;
 
 	int depth = 1;
+	token->klass->skipping = true;
 	do {
 		tokenReadFull (token, data);
 		if (token->type == start)
@@ -200,6 +203,7 @@ bool tokenSkipOverPairFull (tokenInfo *token, void *data)
 		else if (token->type == end)
 			depth--;
 	} while ((!tokenIsEOF(token)) && (depth > 0));
+	token->klass->skipping = false;
 
 	return (depth == 0)? true: false;
 }
@@ -56,6 +56,11 @@ struct tokenInfoClass {
 	void (*copy)   (tokenInfo *dest, tokenInfo *src, void *data);
 	objPool *pool;
 	ptrArray *backlog;
+
+	/* Set while tokenSkipOverPair () reads tokens, of which only the
+	   types matter: the read method may leave the string and the
+	   file position of the token alone then. */
+	bool skipping;
 };
 
 void *newToken       (struct tokenInfoClass *klass);
@@ -63,6 +68,8 @@ void *newTokenFull   (struct tokenInfoClass *klass, void *data);
 void *newTokenByCopying (tokenInfo *src);
 void *newTokenByCopyingFull (tokenInfo *src, void *data);
 
+/* Call at the end of each input file: the pool, which grows with the
+   tokens in use at once, goes back to nPreAlloc tokens. */
 void  flashTokenBacklog (struct tokenInfoClass *klass);
 void  tokenDestroy    (tokenInfo *token);
 
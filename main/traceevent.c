@@ -0,0 +1,235 @@
+/*
+*   Copyright (c) 2026, Universal Ctags Team
+*
+*   This source code is released for free distribution under the terms of the
+*   GNU General Public License version 2 or (at your option) any later version.
+*
+*   This module contains functions for --trace-events: the spans of the
+*   work done for the input files, like reading, guessing, parsing and
+*   sorting, written to a file as complete events ("ph": "X") of the
+*   trace event format of Chrome, which chrome://tracing and Perfetto
+*   show.
+*
+*   The file is a JSON array, an event a line. The main process and each
+*   worker process of --jobs append their events to it in chunks ending
+*   at a line, written with a single unbuffered write to the file opened
+*   for appending, so that they do not mix. Each process is a track
+*   named "main" or "worker N" of a single trace process.
+*/
+
+/*
+*   INCLUDE FILES
+*/
+#include "general.h"  /* must always come first */
+
+#include <stdio.h>
+#include <string.h>
+#ifdef HAVE_UNISTD_H
+# include <unistd.h>  /* to declare getpid () */
+#endif
+
+#include "main.h"
+#include "routines.h"
+#include "traceevent.h"
+#include "vstring.h"
+
+/*
+*   MACROS
+*/
+#define MAX_SPAN_DEPTH 8
+#define TRACE_CHUNK_SIZE (64 * 1024)
+
+#ifndef HAVE_UNISTD_H
+# define getpid() 0
+#endif
+
+/*
+*   DATA DEFINITIONS
+*/
+static FILE *TraceFile;
+static vString *TraceBuffer;
+static double TraceStart;
+static long TracePid;		/* of the main process */
+static long TraceTid;		/* of this process */
+
+static struct {
+	const char *name;
+	char *file;
+	char *language;
+	double start;
+} SpanStack [MAX_SPAN_DEPTH];
+static unsigned int SpanDepth;	/* may exceed MAX_SPAN_DEPTH */
+
+/*
+*   FUNCTION DEFINITIONS
+*/
+
+static void catJsonString (vString *buffer, const char *s)
+{
+	vStringPut (buffer, '"');
+	for (; *s; s++)
+	{
+		const unsigned char c = (unsigned char) *s;
+
+		if (c == '"' || c == '\\')
+		{
+			vStringPut (buffer, '\\');
+			vStringPut (buffer, c);
+		}
+		else if (c < 0x20)
+		{
+			char escaped [8];
+			snprintf (escaped, sizeof escaped, "\\u%04x", c);
+			vStringCatS (buffer, escaped);
+		}
+		else
+			vStringPut (buffer, c);
+	}
+	vStringPut (buffer, '"');
+}
+
+extern void flushTraceEvents (void)
+{
+	if (TraceFile == NULL || vStringLength (TraceBuffer) == 0)
+		return;
+
+	if (fwrite (vStringValue (TraceBuffer), 1, vStringLength (TraceBuffer), TraceFile)
+		!= vStringLength (TraceBuffer))
+		error (WARNING | PERROR, "cannot write trace events");
+	vStringClear (TraceBuffer);
+}
+
+static void catThreadName (const char *name, bool last)
+{
+	char header [96];
+
+	snprintf (header, sizeof header,
+			  "{\"name\": \"thread_name\", \"ph\": \"M\", \"pid\": %ld, \"tid\": %ld, \"args\": {\"name\": ",
+			  TracePid, TraceTid);
+	vStringCatS (TraceBuffer, header);
+	catJsonString (TraceBuffer, name);
+	vStringCatS (TraceBuffer, last? "}}\n": "}},\n");
+}
+
+extern void openTraceEvents (const char *const file)
+{
+	FILE *fp = fopen (file, "w");
+	char header [96];
+
+	if (fp == NULL)
+		error (FATAL | PERROR, "cannot open trace event file \"%s\"", file);
+	fputs ("[\n", fp);
+	fclose (fp);
+
+	/* Each chunk is written with a single write at the end of the file,
+	   whichever process writes it. */
+	TraceFile = fopen (file, "a");
+	if (TraceFile == NULL)
+		error (FATAL | PERROR, "cannot open trace event file \"%s\"", file);
+	setvbuf (TraceFile, NULL, _IONBF, 0);
+
+	TraceBuffer = vStringNew ();
+	TraceStart = getTotalsClock ();
+	TracePid = TraceTid = (long) getpid ();
+	SpanDepth = 0;
+
+	snprintf (header, sizeof header,
+			  "{\"name\": \"process_name\", \"ph\": \"M\", \"pid\": %ld, \"args\": {\"name\": \"ctags\"}},\n",
+			  TracePid);
+	vStringCatS (TraceBuffer, header);
+}
+
+extern void closeTraceEvents (void)
+{
+	if (TraceFile == NULL)
+		return;
+
+	while (SpanDepth > 0)
+		endTraceSpan ();
+	/* The last event, without a comma */
+	catThreadName ("main", true);
+	vStringCatS (TraceBuffer, "]\n");
+	flushTraceEvents ();
+
+	if (fclose (TraceFile) != 0)
+		error (WARNING | PERROR, "cannot close trace event file");
+	TraceFile = NULL;
+	vStringDelete (TraceBuffer);
+	TraceBuffer = NULL;
+}
+
+extern void startWorkerTraceEvents (unsigned int worker)
+{
+	char name [32];
+
+	if (TraceFile == NULL)
+		return;
+
+	/* The main process writes what it had buffered. */
+	vStringClear (TraceBuffer);
+	SpanDepth = 0;
+	TraceTid = (long) getpid ();
+
+	snprintf (name, sizeof name, "worker %u", worker);
+	catThreadName (name, false);
+}
+
+extern void beginTraceSpan (const char *name, const char *file, const char *language)
+{
+	if (TraceFile == NULL)
+		return;
+
+	if (SpanDepth < MAX_SPAN_DEPTH)
+	{
+		SpanStack [SpanDepth].name = name;
+		SpanStack [SpanDepth].file = file? eStrdup (file): NULL;
+		SpanStack [SpanDepth].language = language? eStrdup (language): NULL;
+		SpanStack [SpanDepth].start = getTotalsClock ();
+	}
+	SpanDepth++;
+}
+
+extern void endTraceSpan (void)
+{
+	const double end = getTotalsClock ();
+	char times [160];
+
+	if (TraceFile == NULL || SpanDepth == 0)
+		return;
+
+	if (--SpanDepth >= MAX_SPAN_DEPTH)
+		return;
+
+	vStringCatS (TraceBuffer, "{\"name\": ");
+	catJsonString (TraceBuffer, SpanStack [SpanDepth].name);
+	snprintf (times, sizeof times,
+			  ", \"cat\": \"ctags\", \"ph\": \"X\", \"ts\": %.3f, \"dur\": %.3f, \"pid\": %ld, \"tid\": %ld",
+			  (SpanStack [SpanDepth].start - TraceStart) * 1e6,
+			  (end - SpanStack [SpanDepth].start) * 1e6,
+			  TracePid, TraceTid);
+	vStringCatS (TraceBuffer, times);
+
+	if (SpanStack [SpanDepth].file || SpanStack [SpanDepth].language)
+	{
+		vStringCatS (TraceBuffer, ", \"args\": {");
+		if (SpanStack [SpanDepth].file)
+		{
+			vStringCatS (TraceBuffer, "\"file\": ");
+			catJsonString (TraceBuffer, SpanStack [SpanDepth].file);
+			eFree (SpanStack [SpanDepth].file);
+		}
+		if (SpanStack [SpanDepth].language)
+		{
+			if (SpanStack [SpanDepth].file)
+				vStringCatS (TraceBuffer, ", ");
+			vStringCatS (TraceBuffer, "\"language\": ");
+			catJsonString (TraceBuffer, SpanStack [SpanDepth].language);
+			eFree (SpanStack [SpanDepth].language);
+		}
+		vStringPut (TraceBuffer, '}');
+	}
+	vStringCatS (TraceBuffer, "},\n");
+
+	if (vStringLength (TraceBuffer) >= TRACE_CHUNK_SIZE)
+		flushTraceEvents ();
+}
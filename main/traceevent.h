@@ -0,0 +1,37 @@
+/*
+*   Copyright (c) 2026, Universal Ctags Team
+*
+*   This source code is released for free distribution under the terms of the
+*   GNU General Public License version 2 or (at your option) any later version.
+*
+*   External interface to traceevent.c
+*/
+#ifndef CTAGS_MAIN_TRACEEVENT_H
+#define CTAGS_MAIN_TRACEEVENT_H
+
+/*
+*   INCLUDE FILES
+*/
+#include "general.h"  /* must always come first */
+
+/*
+*   FUNCTION PROTOTYPES
+*/
+
+/* Start writing the spans to FILE in the trace event format of Chrome
+   (--trace-events). */
+extern void openTraceEvents (const char *const file);
+extern void closeTraceEvents (void);
+
+/* Called in a worker process of --jobs after fork; its spans are written
+   on a track of their own. */
+extern void startWorkerTraceEvents (unsigned int worker);
+extern void flushTraceEvents (void);
+
+/* A span is written when it ends; spans nest. FILE and LANGUAGE, given
+   as the arguments of the span, may be NULL. Nothing is done unless
+   --trace-events is given. */
+extern void beginTraceSpan (const char *name, const char *file, const char *language);
+extern void endTraceSpan (void);
+
+#endif	/* CTAGS_MAIN_TRACEEVENT_H */
@@ -27,6 +27,7 @@ struct sTrashBox {
 
 static TrashBox* defaultTrashBox;
 static TrashBox* parserTrashBox;
+static TrashBox* requestTrashBox;
 
 static Trash* trashPut (Trash* trash, void* item,
 			TrashDestroyItemProc destrctor);
@@ -198,6 +199,31 @@ extern TrashBoxDestroyItemProc parserTrashBoxTakeBack  (void* item)
 	return trashBoxTakeBack(parserTrashBox, item);
 }
 
+extern void initRequestTrashBox (void)
+{
+	Assert (requestTrashBox == NULL);
+	requestTrashBox = trashBoxNew ();
+}
+
+extern void finiRequestTrashBox  (void)
+{
+	if (requestTrashBox == NULL)
+		return;
+	trashBoxDelete (requestTrashBox);
+	requestTrashBox = NULL;
+}
+
+extern void* requestTrashBoxPut  (void* item, TrashBoxDestroyItemProc destroy)
+{
+	/* NULL stands for the default trash box. */
+	return trashBoxPut(requestTrashBox, item, destroy);
+}
+
+extern TrashBoxDestroyItemProc requestTrashBoxTakeBack  (void* item)
+{
+	return trashBoxTakeBack(requestTrashBox, item);
+}
+
 #ifdef TRASH_TEST
 #include <stdio.h>
 
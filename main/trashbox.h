@@ -30,6 +30,11 @@ extern void      trashBoxMakeEmpty (TrashBox* trash_box);
 #define PARSER_TRASH_BOX(PTR,PROC) parserTrashBoxPut(PTR,(TrashBoxDestroyItemProc)PROC)
 #define PARSER_TRASH_BOX_TAKE_BACK(PTR) parserTrashBoxTakeBack(PTR)
 
+/* Emptied when an interactive request is completed. Out of interactive
+   mode, the items go to the default trash box. */
+#define REQUEST_TRASH_BOX(PTR,PROC) requestTrashBoxPut(PTR,(TrashBoxDestroyItemProc)PROC)
+#define REQUEST_TRASH_BOX_TAKE_BACK(PTR) requestTrashBoxTakeBack(PTR)
+
 extern void initDefaultTrashBox (void);
 extern void finiDefaultTrashBox  (void);
 
@@ -38,4 +43,9 @@ extern void finiParserTrashBox  (void);
 extern void* parserTrashBoxPut  (void* item, TrashBoxDestroyItemProc destroy);
 extern TrashBoxDestroyItemProc parserTrashBoxTakeBack  (void* item);
 
+extern void initRequestTrashBox (void);
+extern void finiRequestTrashBox  (void);
+extern void* requestTrashBoxPut  (void* item, TrashBoxDestroyItemProc destroy);
+extern TrashBoxDestroyItemProc requestTrashBoxTakeBack  (void* item);
+
 #endif /* CTAGS_MAIN_TRASH_H */
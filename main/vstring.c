@@ -24,7 +24,14 @@
 /*
 *   DATA DEFINITIONS
 */
-static const size_t vStringInitialSize = 32;
+static const size_t vStringInitialSize = VSTRING_INLINE_SIZE;
+
+/* Deleted vStrings kept for reuse by vStringNew, with their buffer if it
+ * is not larger than vStringPoolMaxBufferSize. */
+#define VSTRING_POOL_SIZE 64
+static const size_t vStringPoolMaxBufferSize = 256;
+static vString *VStringPool [VSTRING_POOL_SIZE];
+static unsigned int VStringPoolCount;
 
 /*
 *   FUNCTION DEFINITIONS
@@ -43,11 +50,23 @@ extern void vStringResize (vString *const string, const size_t newSize)
 
 	if (size > string->size)
 	{
+		if (string->buffer == string->inlineBuffer)
+		{
+			string->buffer = xMalloc (size, char);
+			memcpy (string->buffer, string->inlineBuffer, string->size);
+		}
+		else
+			string->buffer = xRealloc (string->buffer, size, char);
 		string->size = size;
-		string->buffer = xRealloc (string->buffer, size, char);
 	}
 }
 
+static void vStringFreeBuffer (vString *const string)
+{
+	if (string->buffer != NULL && string->buffer != string->inlineBuffer)
+		eFree (string->buffer);
+}
+
 extern void vStringTruncate (vString *const string, const size_t length)
 {
 	Assert (length <= string->length);
@@ -59,27 +78,55 @@ extern void vStringTruncate (vString *const string, const size_t length)
 
 extern void vStringDelete (vString *const string)
 {
-	if (string != NULL)
+	if (string == NULL)
+		return;
+
+	if (VStringPoolCount < VSTRING_POOL_SIZE)
 	{
-		if (string->buffer != NULL)
-			eFree (string->buffer);
+		if (string->size > vStringPoolMaxBufferSize)
+		{
+			vStringFreeBuffer (string);
+			string->size   = vStringInitialSize;
+			string->buffer = string->inlineBuffer;
+		}
+		VStringPool [VStringPoolCount++] = string;
+	}
+	else
+	{
+		vStringFreeBuffer (string);
 		eFree (string);
 	}
 }
 
 extern vString *vStringNew (void)
 {
-	vString *const string = xMalloc (1, vString);
+	vString *string;
 
-	string->length = 0;
-	string->size   = vStringInitialSize;
-	string->buffer = xMalloc (string->size, char);
+	if (VStringPoolCount > 0)
+		string = VStringPool [--VStringPoolCount];
+	else
+	{
+		string = xMalloc (1, vString);
+		string->size   = vStringInitialSize;
+		string->buffer = string->inlineBuffer;
+	}
 
-	vStringClear (string);
+	string->length = 0;
+	string->buffer [0] = '\0';
 
 	return string;
 }
 
+extern void freeVStringResources (void)
+{
+	while (VStringPoolCount > 0)
+	{
+		vString *const string = VStringPool [--VStringPoolCount];
+		vStringFreeBuffer (string);
+		eFree (string);
+	}
+}
+
 extern vString *vStringNewCopy (const vString *const string)
 {
 	vString *vs = vStringNew ();
@@ -117,12 +164,24 @@ extern void vStringNCat (
 extern void vStringNCatS (
 		vString *const string, const char *const s, const size_t length)
 {
-	size_t len = strlen (s);
+	/* Don't run strlen over S: it may be a whole input file. */
+	const char *const nul = memchr (s, '\0', length);
+	size_t len = nul ? (size_t) (nul - s) : length;
 
-	len = len < length ? len : length;
 	stringCat (string, s, len);
 }
 
+extern void vStringNCatSUnsafe (
+		vString *const string, const char *const s, const size_t length)
+{
+	if (string->length + length + 1 > string->size)
+		vStringResize (string, string->length + length + 1);
+
+	memcpy (string->buffer + string->length, s, length);
+	string->length += length;
+	string->buffer [string->length] = '\0';
+}
+
 extern void vStringCat (vString *const string, const vString *const s)
 {
 	size_t len = vStringLength (s);
@@ -258,7 +317,13 @@ extern char    *vStringDeleteUnwrap       (vString *const string)
 
 	if (string != NULL)
 	{
-		buffer = string->buffer;
+		if (string->buffer == string->inlineBuffer)
+		{
+			buffer = xMalloc (string->size, char);
+			memcpy (buffer, string->inlineBuffer, string->size);
+		}
+		else
+			buffer = string->buffer;
 		string->buffer = NULL;
 
 		string->size = 0;
@@ -280,42 +345,66 @@ static char valueToXDigit (int v)
 		return '0' + v;
 }
 
+/* The control characters (incl. \t) and '\\' */
+static const unsigned char CharsToEscape [256] = {
+	[0x01] = 1, [0x02] = 1, [0x03] = 1, [0x04] = 1, [0x05] = 1, [0x06] = 1,
+	[0x07] = 1, [0x08] = 1, [0x09] = 1, [0x0A] = 1, [0x0B] = 1, [0x0C] = 1,
+	[0x0D] = 1, [0x0E] = 1, [0x0F] = 1, [0x10] = 1, [0x11] = 1, [0x12] = 1,
+	[0x13] = 1, [0x14] = 1, [0x15] = 1, [0x16] = 1, [0x17] = 1, [0x18] = 1,
+	[0x19] = 1, [0x1A] = 1, [0x1B] = 1, [0x1C] = 1, [0x1D] = 1, [0x1E] = 1,
+	[0x1F] = 1, [0x7F] = 1, ['\\'] = 1,
+	[0x00] = 1,					/* to stop at the end */
+};
+
+extern const char *findCharToEscape (const char *s)
+{
+	const unsigned char *p = (const unsigned char *) s;
+
+	while (! CharsToEscape [*p])
+		p++;
+	return (const char *) p;
+}
+
+/* The runs of characters not escaped are copied at once. */
 extern void vStringCatSWithEscaping (vString* b, const char *s)
 {
-	for(; *s; s++)
+	for (;;)
 	{
-		int c = *s;
+		const char *const e = findCharToEscape (s);
+		int c;
+
+		if (e > s)
+			vStringNCatSUnsafe (b, s, e - s);
+		if (*e == '\0')
+			break;
 
-		/* escape control characters (incl. \t) */
-		if ((c > 0x00 && c <= 0x1F) || c == 0x7F || c == '\\')
+		c = *e;
+		s = e + 1;
+		vStringPut (b, '\\');
+		switch (c)
 		{
-			vStringPut (b, '\\');
-
-			switch (c)
-			{
-				/* use a short form for known escapes */
-			case '\a':
-				c = 'a'; break;
-			case '\b':
-				c = 'b'; break;
-			case '\t':
-				c = 't'; break;
-			case '\n':
-				c = 'n'; break;
-			case '\v':
-				c = 'v'; break;
-			case '\f':
-				c = 'f'; break;
-			case '\r':
-				c = 'r'; break;
-			case '\\':
-				c = '\\'; break;
-			default:
-				vStringPut (b, 'x');
-				vStringPut (b, valueToXDigit ((c & 0xF0) >> 4));
-				vStringPut (b, valueToXDigit (c & 0x0F));
-				continue;
-			}
+			/* use a short form for known escapes */
+		case '\a':
+			c = 'a'; break;
+		case '\b':
+			c = 'b'; break;
+		case '\t':
+			c = 't'; break;
+		case '\n':
+			c = 'n'; break;
+		case '\v':
+			c = 'v'; break;
+		case '\f':
+			c = 'f'; break;
+		case '\r':
+			c = 'r'; break;
+		case '\\':
+			c = '\\'; break;
+		default:
+			vStringPut (b, 'x');
+			vStringPut (b, valueToXDigit ((c & 0xF0) >> 4));
+			vStringPut (b, valueToXDigit (c & 0x0F));
+			continue;
 		}
 		vStringPut (b, c);
 	}
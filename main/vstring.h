@@ -47,10 +47,16 @@
 *   DATA DECLARATIONS
 */
 
+/* Short strings are stored in inlineBuffer, so that creating one
+ * allocates nothing but the vString itself. BUFFER points to
+ * inlineBuffer until the string grows beyond it. */
+#define VSTRING_INLINE_SIZE 32
+
 typedef struct sVString {
 	size_t  length;  /* size of buffer used */
 	size_t  size;    /* allocated size of buffer */
 	char   *buffer;  /* location of buffer */
+	char    inlineBuffer [VSTRING_INLINE_SIZE];
 } vString;
 
 /*
@@ -67,6 +73,8 @@ extern void vStringCat (vString *const string, const vString *const s);
 extern void vStringCatS (vString *const string, const char *const s);
 extern void vStringNCat (vString *const string, const vString *const s, const size_t length);
 extern void vStringNCatS (vString *const string, const char *const s, const size_t length);
+/* S needs not be nul-terminated; LENGTH bytes are appended. */
+extern void vStringNCatSUnsafe (vString *const string, const char *const s, const size_t length);
 extern vString *vStringNewCopy (const vString *const string);
 extern vString *vStringNewInit (const char *const s);
 extern void vStringCopy (vString *const string, const vString *const s);
@@ -80,10 +88,15 @@ extern void vStringTruncate (vString *const string, const size_t length);
 extern vString *vStringNewOrClear (vString *const string);
 extern vString *vStringNewOrClearWithAutoRelease (vString *const string);
 
+extern void freeVStringResources (void);
+
 extern vString *vStringNewOwn (char *s);
 extern char    *vStringDeleteUnwrap (vString *const string);
 
 extern void vStringCatSWithEscaping (vString* b, const char *s);
+/* Return the first character of S vStringCatSWithEscaping () escapes,
+   or the NUL terminating S. */
+extern const char *findCharToEscape (const char *s);
 extern void vStringCatSWithEscapingAsPattern (vString *output, const char* input);
 
 /*
@@ -0,0 +1,457 @@
+/*
+*   Copyright (c) 2026, Universal Ctags Team
+*
+*   This source code is released for free distribution under the terms of the
+*   GNU General Public License version 2 or (at your option) any later version.
+*
+*   This module contains functions for the binary output format
+*   (--output-format=binary): a tag index which can be mapped in memory
+*   and searched without parsing. All the numbers are little-endian.
+*
+*   offset  size  content
+*   0       8     "CTAGSIDX"
+*   8       4     version (1)
+*   12      4     number of tags, N
+*   16      4     number of columns, C (8)
+*   20      4     number of strings, S
+*   24      8     offset of the columns
+*   32      8     offset of the name index
+*   40      8     offset of the string offsets
+*   48      8     offset of the string data
+*   56      8     size of the string data
+*
+*   The columns are C arrays of N 4-byte numbers, one number per tag: the
+*   string ids of its name, input file, pattern, kind, language, scope
+*   kind, and scope, then its line number. The name index holds the N
+*   tag numbers sorted by the names of the tags as strcmp () does, then
+*   by tag number. The string offsets are S 8-byte offsets into the
+*   string data, where each string is terminated with NUL. The strings
+*   are deduplicated; string 0 is "", which also stands for a field the
+*   tag does not have. Each section starts at an offset aligned to 8.
+*
+*   The entries are written as they come to a temporary file, one NUL
+*   terminated string per field, and the index is made from them when
+*   the tag file is closed, so the fragments of --jobs and --cache-dir
+*   are handled like the ones of the other formats.
+*/
+
+/*
+*   INCLUDE FILES
+*/
+#include "general.h"  /* must always come first */
+
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "debug.h"
+#include "entry_private.h"
+#include "field.h"
+#include "htable.h"
+#include "mio.h"
+#include "parse.h"
+#include "ptrarray.h"
+#include "routines.h"
+#include "vstring.h"
+#include "writer.h"
+
+/*
+*   MACROS
+*/
+#define BINARY_FILE  "tags.bin"
+
+#define BINARY_INDEX_VERSION 1
+#define BINARY_INDEX_HEADER_SIZE 64
+#define BINARY_READ_BUFFER_SIZE (64 * 1024)
+
+/*
+*   DATA DECLARATIONS
+*/
+enum eBinaryIndexColumn {
+	COLUMN_NAME,
+	COLUMN_INPUT,
+	COLUMN_PATTERN,
+	COLUMN_KIND,
+	COLUMN_LANGUAGE,
+	COLUMN_SCOPE_KIND,
+	COLUMN_SCOPE,
+	COLUMN_LINE,
+	COLUMN_COUNT,
+};
+
+typedef struct sBinaryIndex {
+	hashTable *ids;				/* string -> id + 1 */
+	ptrArray *strings;			/* owned by ids */
+	uint64_t dataSize;
+	uint32_t *columns [COLUMN_COUNT];
+	uint32_t count;				/* of tags */
+	uint32_t length;			/* of each column */
+} binaryIndex;
+
+static int writeBinaryEntry (tagWriter *writer CTAGS_ATTR_UNUSED,
+							 MIO * mio, const tagEntryInfo *const tag);
+static void buildBinaryFqTagCache (tagWriter *writer CTAGS_ATTR_UNUSED,
+								   tagEntryInfo *const tag);
+static void rewriteBinaryOutput (tagWriter *writer CTAGS_ATTR_UNUSED,
+								 MIO *entries, long size, MIO *output);
+
+tagWriter binaryWriter = {
+	.writeEntry = writeBinaryEntry,
+	.writePtagEntry = NULL,
+	.preWriteEntry = NULL,
+	.postWriteEntry = NULL,
+	.buildFqTagCache = buildBinaryFqTagCache,
+	.rewriteOutput = rewriteBinaryOutput,
+	.defaultFileName = BINARY_FILE,
+};
+
+/*
+*   FUNCTION DEFINITIONS
+*/
+
+static int writeField (MIO *mio, const char *const value)
+{
+	const size_t length = value? strlen (value): 0;
+
+	if (length > 0)
+		mio_write (mio, value, 1, length);
+	mio_putc (mio, '\0');
+	return length + 1;
+}
+
+static int writeBinaryEntry (tagWriter *writer,
+							 MIO * mio, const tagEntryInfo *const tag)
+{
+	const char *scopeKind = NULL;
+	const char *scope = NULL;
+	char line [24];
+	int length = 0;
+
+	getTagScopeInformation ((tagEntryInfo *const) tag, &scopeKind, &scope);
+	snprintf (line, sizeof (line), "%lu", tag->lineNumber);
+
+	length += writeField (mio, tag->name);
+	length += writeField (mio, tag->sourceFileName);
+	length += writeField (mio, renderFieldEscaped (writer->type, FIELD_PATTERN, tag,
+												   NO_PARSER_FIELD, NULL));
+	length += writeField (mio, getTagKindName (tag));
+	length += writeField (mio, getLanguageName (tag->langType));
+	length += writeField (mio, scopeKind);
+	length += writeField (mio, scope);
+	length += writeField (mio, line);
+
+	return length;
+}
+
+static void buildBinaryFqTagCache (tagWriter *writer CTAGS_ATTR_UNUSED,
+								   tagEntryInfo *const tag)
+{
+	getTagScopeInformation (tag, NULL, NULL);
+}
+
+static uint32_t internString (binaryIndex *index, const char *const str)
+{
+	uintptr_t id = (uintptr_t) hashTableGetItem (index->ids, str);
+	char *key;
+
+	if (id > 0)
+		return (uint32_t) (id - 1);
+
+	id = ptrArrayCount (index->strings);
+	if (id == UINT32_MAX)
+		error (FATAL, "too many strings for a binary tag index");
+	key = eStrdup (str);
+	hashTablePutItem (index->ids, key, (void *) (id + 1));
+	ptrArrayAdd (index->strings, key);
+	index->dataSize += strlen (str) + 1;
+	return (uint32_t) id;
+}
+
+static void addTag (binaryIndex *index, vString *const *fields)
+{
+	unsigned int i;
+	unsigned long line;
+
+	if (index->count == index->length)
+	{
+		if (index->length > UINT32_MAX / 2)
+			error (FATAL, "too many tags for a binary tag index");
+		index->length = index->length? index->length * 2: 1024;
+		for (i = 0; i < COLUMN_COUNT; i++)
+			index->columns [i] = xRealloc (index->columns [i], index->length, uint32_t);
+	}
+
+	for (i = 0; i < COLUMN_LINE; i++)
+		index->columns [i][index->count] = internString (index, vStringValue (fields [i]));
+	if (! strToULong (vStringValue (fields [COLUMN_LINE]), 10, &line) || line > UINT32_MAX)
+		line = 0;
+	index->columns [COLUMN_LINE][index->count] = (uint32_t) line;
+	index->count++;
+}
+
+static void readEntries (binaryIndex *index, MIO *entries, long size)
+{
+	vString *fields [COLUMN_COUNT];
+	char *buffer = xMalloc (BINARY_READ_BUFFER_SIZE, char);
+	unsigned int field = 0;
+	unsigned int i;
+
+	for (i = 0; i < COLUMN_COUNT; i++)
+		fields [i] = vStringNew ();
+
+	while (size > 0)
+	{
+		const size_t length = (size < BINARY_READ_BUFFER_SIZE)
+			? (size_t) size: BINARY_READ_BUFFER_SIZE;
+		const char *p = buffer;
+		const char *const end = buffer + length;
+
+		if (mio_read (entries, buffer, 1, length) != length)
+			error (FATAL | PERROR, "cannot read the entries of the binary tag index");
+		size -= length;
+
+		while (p < end)
+		{
+			const char *const nul = memchr (p, '\0', end - p);
+
+			if (nul == NULL)
+			{
+				vStringNCatS (fields [field], p, end - p);
+				break;
+			}
+			vStringNCatS (fields [field], p, nul - p);
+			p = nul + 1;
+			if (++field == COLUMN_COUNT)
+			{
+				addTag (index, fields);
+				for (i = 0; i < COLUMN_COUNT; i++)
+					vStringClear (fields [i]);
+				field = 0;
+			}
+		}
+	}
+	Assert (field == 0);
+
+	for (i = 0; i < COLUMN_COUNT; i++)
+		vStringDelete (fields [i]);
+	eFree (buffer);
+}
+
+static const binaryIndex *SortedIndex;
+
+static int compareTagNames (const void *a, const void *b)
+{
+	const uint32_t ta = *(const uint32_t *) a;
+	const uint32_t tb = *(const uint32_t *) b;
+	const uint32_t *const names = SortedIndex->columns [COLUMN_NAME];
+	int r;
+
+	r = strcmp (ptrArrayItem (SortedIndex->strings, names [ta]),
+				ptrArrayItem (SortedIndex->strings, names [tb]));
+	if (r == 0)
+		r = (ta < tb)? -1: (ta > tb);
+	return r;
+}
+
+static void writeNumber (MIO *output, uint64_t n, unsigned int size)
+{
+	unsigned char bytes [8];
+	unsigned int i;
+
+	for (i = 0; i < size; i++)
+	{
+		bytes [i] = (unsigned char) (n & 0xFF);
+		n >>= 8;
+	}
+	mio_write (output, bytes, 1, size);
+}
+
+/* Write N 4-byte numbers, converting them in place. */
+static void writeNumbers (MIO *output, uint32_t *numbers, uint32_t n)
+{
+	uint32_t i;
+
+	for (i = 0; i < n; i++)
+	{
+		const uint32_t v = numbers [i];
+		unsigned char *const bytes = (unsigned char *) (numbers + i);
+
+		bytes [0] = (unsigned char) (v & 0xFF);
+		bytes [1] = (unsigned char) ((v >> 8) & 0xFF);
+		bytes [2] = (unsigned char) ((v >> 16) & 0xFF);
+		bytes [3] = (unsigned char) ((v >> 24) & 0xFF);
+	}
+	if (n > 0)
+		mio_write (output, numbers, 4, n);
+}
+
+static void writePadding (MIO *output, uint64_t offset)
+{
+	for (; offset % 8; offset++)
+		mio_putc (output, '\0');
+}
+
+static uint64_t align8 (uint64_t offset)
+{
+	return (offset + 7) & ~(uint64_t) 7;
+}
+
+static void writeIndex (binaryIndex *index, MIO *output)
+{
+	const uint32_t stringCount = ptrArrayCount (index->strings);
+	const uint64_t columnsOffset = BINARY_INDEX_HEADER_SIZE;
+	const uint64_t nameIndexOffset = columnsOffset
+		+ (uint64_t) COLUMN_COUNT * index->count * 4;
+	const uint64_t stringOffsetsOffset = align8 (nameIndexOffset
+												 + (uint64_t) index->count * 4);
+	const uint64_t stringDataOffset = stringOffsetsOffset
+		+ (uint64_t) stringCount * 8;
+	uint32_t *order = xMalloc (index->count? index->count: 1, uint32_t);
+	uint64_t offset;
+	uint32_t i, j;
+
+	for (i = 0; i < index->count; i++)
+		order [i] = i;
+	SortedIndex = index;
+	qsort (order, index->count, sizeof (*order), compareTagNames);
+	SortedIndex = NULL;
+
+	mio_write (output, BINARY_INDEX_MAGIC, 1, strlen (BINARY_INDEX_MAGIC));
+	writeNumber (output, BINARY_INDEX_VERSION, 4);
+	writeNumber (output, index->count, 4);
+	writeNumber (output, COLUMN_COUNT, 4);
+	writeNumber (output, stringCount, 4);
+	writeNumber (output, columnsOffset, 8);
+	writeNumber (output, nameIndexOffset, 8);
+	writeNumber (output, stringOffsetsOffset, 8);
+	writeNumber (output, stringDataOffset, 8);
+	writeNumber (output, index->dataSize, 8);
+
+	for (j = 0; j < COLUMN_COUNT; j++)
+		writeNumbers (output, index->columns [j], index->count);
+	writeNumbers (output, order, index->count);
+	writePadding (output, nameIndexOffset + (uint64_t) index->count * 4);
+
+	offset = 0;
+	for (i = 0; i < stringCount; i++)
+	{
+		writeNumber (output, offset, 8);
+		offset += strlen (ptrArrayItem (index->strings, i)) + 1;
+	}
+	for (i = 0; i < stringCount; i++)
+	{
+		const char *const str = ptrArrayItem (index->strings, i);
+		mio_write (output, str, 1, strlen (str) + 1);
+	}
+
+	eFree (order);
+}
+
+static void rewriteBinaryOutput (tagWriter *writer CTAGS_ATTR_UNUSED,
+								 MIO *entries, long size, MIO *output)
+{
+	binaryIndex index;
+	unsigned int i;
+
+	memset (&index, 0, sizeof (index));
+	index.ids = hashTableNew (65521, hashCstrhash, hashCstreq, eFree, NULL);
+	index.strings = ptrArrayNew (NULL);
+
+	internString (&index, "");
+	readEntries (&index, entries, size);
+	writeIndex (&index, output);
+
+	for (i = 0; i < COLUMN_COUNT; i++)
+		if (index.columns [i])
+			eFree (index.columns [i]);
+	ptrArrayDelete (index.strings);
+	hashTableDelete (index.ids);
+}
+
+/*
+ *  Reading the index back, for --_dump-binary-index
+ */
+
+static uint64_t readNumber (const unsigned char *const p, unsigned int size)
+{
+	uint64_t n = 0;
+	unsigned int i;
+
+	for (i = size; i > 0; i--)
+		n = (n << 8) | p [i - 1];
+	return n;
+}
+
+extern void dumpBinaryIndex (const char *const fileName, FILE *fp)
+{
+	MIO *mio = mio_new_file (fileName, "rb");
+	unsigned char *data;
+	unsigned long fileSize;
+	uint64_t count, columnCount, stringCount;
+	uint64_t columns, nameIndex, stringOffsets, stringData, dataSize;
+	uint64_t i;
+
+	if (mio == NULL)
+		error (FATAL | PERROR, "cannot open \"%s\"", fileName);
+	mio_seek (mio, 0, SEEK_END);
+	fileSize = mio_tell (mio);
+	mio_rewind (mio);
+	data = xMalloc (fileSize + 1, unsigned char);
+	if (mio_read (mio, data, 1, fileSize) != fileSize)
+		error (FATAL | PERROR, "cannot read \"%s\"", fileName);
+	mio_free (mio);
+
+	if (fileSize < BINARY_INDEX_HEADER_SIZE
+		|| memcmp (data, BINARY_INDEX_MAGIC, strlen (BINARY_INDEX_MAGIC)) != 0
+		|| readNumber (data + 8, 4) != BINARY_INDEX_VERSION)
+		error (FATAL, "\"%s\" is not a binary tag index", fileName);
+
+	count = readNumber (data + 12, 4);
+	columnCount = readNumber (data + 16, 4);
+	stringCount = readNumber (data + 20, 4);
+	columns = readNumber (data + 24, 8);
+	nameIndex = readNumber (data + 32, 8);
+	stringOffsets = readNumber (data + 40, 8);
+	stringData = readNumber (data + 48, 8);
+	dataSize = readNumber (data + 56, 8);
+
+	if (columnCount < COLUMN_COUNT
+		|| columns + columnCount * count * 4 > fileSize
+		|| nameIndex + count * 4 > fileSize
+		|| stringOffsets + stringCount * 8 > fileSize
+		|| stringData + dataSize > fileSize
+		|| (dataSize > 0 && data [stringData + dataSize - 1] != '\0'))
+		error (FATAL, "\"%s\" is a broken binary tag index", fileName);
+
+	for (i = 0; i < count; i++)
+	{
+		const uint64_t tag = readNumber (data + nameIndex + i * 4, 4);
+		const char *values [COLUMN_COUNT];
+		unsigned int j;
+
+		if (tag >= count)
+			error (FATAL, "\"%s\" is a broken binary tag index", fileName);
+		for (j = 0; j < COLUMN_LINE; j++)
+		{
+			const uint64_t id = readNumber (data + columns + (j * count + tag) * 4, 4);
+			const uint64_t offset = (id < stringCount)
+				? readNumber (data + stringOffsets + id * 8, 8): dataSize;
+
+			if (offset >= dataSize)
+				error (FATAL, "\"%s\" is a broken binary tag index", fileName);
+			values [j] = (const char *) data + stringData + offset;
+		}
+
+		fprintf (fp, "%s\t%s\t%s\tline:%lu\tkind:%s\tlanguage:%s",
+				 values [COLUMN_NAME], values [COLUMN_INPUT],
+				 values [COLUMN_PATTERN],
+				 (unsigned long) readNumber (data + columns
+											 + (COLUMN_LINE * count + tag) * 4, 4),
+				 values [COLUMN_KIND], values [COLUMN_LANGUAGE]);
+		if (values [COLUMN_SCOPE][0] != '\0')
+			fprintf (fp, "\t%s:%s", values [COLUMN_SCOPE_KIND], values [COLUMN_SCOPE]);
+		fputc ('\n', fp);
+	}
+
+	eFree (data);
+}
@@ -14,6 +14,7 @@
 #include "options.h"
 #include "read.h"
 #include "ptag.h"
+#include "vstring.h"
 #include "writer.h"
 
 
@@ -79,25 +80,48 @@ static const char* escapeFieldValue (tagWriter *writer, const tagEntryInfo * tag
 	return renderFieldEscaped (writer->type, ftype, tag, NO_PARSER_FIELD, reject);
 }
 
-static int renderExtensionFieldMaybe (tagWriter *writer, int xftype, const tagEntryInfo *const tag, char sep[2], MIO *mio)
+/* A line is built in a buffer and written at once. A rejected line is
+   then just not written. */
+static void catField (vString *b, const char *s)
+{
+	if (s)
+		vStringCatS (b, s);
+}
+
+static void catUnsignedLong (vString *b, unsigned long n)
+{
+	char buf [24];
+	char *p = buf + sizeof (buf);
+
+	do
+	{
+		*--p = '0' + (n % 10);
+		n /= 10;
+	} while (n > 0);
+	vStringNCatS (b, p, buf + sizeof (buf) - p);
+}
+
+static void catSeparator (vString *b, char sep[2])
+{
+	catField (b, sep);
+	sep[0] = '\0';
+	vStringPut (b, '\t');
+}
+
+static void renderExtensionFieldMaybe (tagWriter *writer, int xftype, const tagEntryInfo *const tag, char sep[2], vString *b)
 {
 	if (isFieldEnabled (xftype) && doesFieldHaveValue (xftype, tag))
 	{
-		int len;
-		len = mio_printf (mio, "%s\t%s:%s", sep,
-				  getFieldName (xftype),
-				  escapeFieldValue (writer, tag, xftype));
-		sep[0] = '\0';
-		return len;
+		catSeparator (b, sep);
+		catField (b, getFieldName (xftype));
+		vStringPut (b, ':');
+		catField (b, escapeFieldValue (writer, tag, xftype));
 	}
-	else
-		return 0;
 }
 
-static int addParserFields (tagWriter *writer, MIO * mio, const tagEntryInfo *const tag)
+static void addParserFields (tagWriter *writer, vString *b, const tagEntryInfo *const tag)
 {
 	unsigned int i;
-	int length = 0;
 	bool *reject = NULL;
 
 	if (writer->private)
@@ -112,42 +136,24 @@ static int addParserFields (tagWriter *writer, MIO * mio, const tagEntryInfo *co
 		if (! isFieldEnabled (f->ftype))
 			continue;
 
-		length += mio_printf(mio, "\t%s:%s",
-							 getFieldName (f->ftype),
-							 renderFieldEscaped (writer->type,
-												 f->ftype, tag, i, reject));
+		vStringPut (b, '\t');
+		catField (b, getFieldName (f->ftype));
+		vStringPut (b, ':');
+		catField (b, renderFieldEscaped (writer->type, f->ftype, tag, i, reject));
 	}
-	return length;
 }
 
-static int writeLineNumberEntry (tagWriter *writer, MIO * mio, const tagEntryInfo *const tag)
+static void writeLineNumberEntry (tagWriter *writer, vString *b, const tagEntryInfo *const tag)
 {
 	if (Option.lineDirectives)
-		return mio_printf (mio, "%s", escapeFieldValue (writer, tag, FIELD_LINE_NUMBER));
+		catField (b, escapeFieldValue (writer, tag, FIELD_LINE_NUMBER));
 	else
-		return mio_printf (mio, "%lu", tag->lineNumber);
+		catUnsignedLong (b, tag->lineNumber);
 }
 
-static int addExtensionFields (tagWriter *writer, MIO *mio, const tagEntryInfo *const tag)
+static void addExtensionFields (tagWriter *writer, vString *b, const tagEntryInfo *const tag)
 {
-	bool isKindKeyEnabled = isFieldEnabled (FIELD_KIND_KEY);
-	bool isScopeEnabled = isFieldEnabled   (FIELD_SCOPE_KEY);
-
-	const char* const kindKey = isKindKeyEnabled
-		?getFieldName (FIELD_KIND_KEY)
-		:"";
-	const char* const kindFmt = isKindKeyEnabled
-		?"%s\t%s:%s"
-		:"%s\t%s%s";
-	const char* const scopeKey = isScopeEnabled
-		?getFieldName (FIELD_SCOPE_KEY)
-		:"";
-	const char* const scopeFmt = isScopeEnabled
-		?"%s\t%s:%s:%s"
-		:"%s\t%s%s:%s";
-
 	char sep [] = {';', '"', '\0'};
-	int length = 0;
 
 	const char *str = NULL;;
 	kindDefinition *kdef = getLanguageKind(tag->langType, tag->kindIndex);
@@ -168,19 +174,24 @@ static int addExtensionFields (tagWriter *writer, MIO *mio, const tagEntryInfo *
 
 	if (str)
 	{
-		length += mio_printf (mio, kindFmt, sep, kindKey, str);
-		sep [0] = '\0';
+		catSeparator (b, sep);
+		if (isFieldEnabled (FIELD_KIND_KEY))
+		{
+			catField (b, getFieldName (FIELD_KIND_KEY));
+			vStringPut (b, ':');
+		}
+		catField (b, str);
 	}
 
 	if (isFieldEnabled (FIELD_LINE_NUMBER) &&  doesFieldHaveValue (FIELD_LINE_NUMBER, tag))
 	{
-		length += mio_printf (mio, "%s\t%s:%ld", sep,
-				   getFieldName (FIELD_LINE_NUMBER),
-				   tag->lineNumber);
-		sep [0] = '\0';
+		catSeparator (b, sep);
+		catField (b, getFieldName (FIELD_LINE_NUMBER));
+		vStringPut (b, ':');
+		catUnsignedLong (b, tag->lineNumber);
 	}
 
-	length += renderExtensionFieldMaybe (writer, FIELD_LANGUAGE, tag, sep, mio);
+	renderExtensionFieldMaybe (writer, FIELD_LANGUAGE, tag, sep, b);
 
 	if (isFieldEnabled (FIELD_SCOPE))
 	{
@@ -190,81 +201,85 @@ static int addExtensionFields (tagWriter *writer, MIO *mio, const tagEntryInfo *
 		v = escapeFieldValue (writer, tag, FIELD_SCOPE);
 		if (k && v)
 		{
-			length += mio_printf (mio, scopeFmt, sep, scopeKey, k, v);
-			sep [0] = '\0';
+			catSeparator (b, sep);
+			if (isFieldEnabled (FIELD_SCOPE_KEY))
+			{
+				catField (b, getFieldName (FIELD_SCOPE_KEY));
+				vStringPut (b, ':');
+			}
+			catField (b, k);
+			vStringPut (b, ':');
+			catField (b, v);
 		}
 	}
 
 	if (isFieldEnabled (FIELD_TYPE_REF) && doesFieldHaveValue (FIELD_TYPE_REF, tag))
 	{
-		length += mio_printf (mio, "%s\t%s:%s:%s", sep,
-				      getFieldName (FIELD_TYPE_REF),
-				      tag->extensionFields.typeRef [0],
-				      escapeFieldValue (writer, tag, FIELD_TYPE_REF));
-		sep [0] = '\0';
+		catSeparator (b, sep);
+		catField (b, getFieldName (FIELD_TYPE_REF));
+		vStringPut (b, ':');
+		catField (b, tag->extensionFields.typeRef [0]);
+		vStringPut (b, ':');
+		catField (b, escapeFieldValue (writer, tag, FIELD_TYPE_REF));
 	}
 
 	if (isFieldEnabled (FIELD_FILE_SCOPE) &&  doesFieldHaveValue (FIELD_FILE_SCOPE, tag))
 	{
-		length += mio_printf (mio, "%s\t%s:", sep,
-				      getFieldName (FIELD_FILE_SCOPE));
-		sep [0] = '\0';
+		catSeparator (b, sep);
+		catField (b, getFieldName (FIELD_FILE_SCOPE));
+		vStringPut (b, ':');
 	}
 
-	length += renderExtensionFieldMaybe (writer, FIELD_INHERITANCE, tag, sep, mio);
-	length += renderExtensionFieldMaybe (writer, FIELD_ACCESS, tag, sep, mio);
-	length += renderExtensionFieldMaybe (writer, FIELD_IMPLEMENTATION, tag, sep, mio);
-	length += renderExtensionFieldMaybe (writer, FIELD_SIGNATURE, tag, sep, mio);
-	length += renderExtensionFieldMaybe (writer, FIELD_ROLE, tag, sep, mio);
-	length += renderExtensionFieldMaybe (writer, FIELD_EXTRAS, tag, sep, mio);
-	length += renderExtensionFieldMaybe (writer, FIELD_XPATH, tag, sep, mio);
-	length += renderExtensionFieldMaybe (writer, FIELD_END_LINE, tag, sep, mio);
-
-	return length;
+	renderExtensionFieldMaybe (writer, FIELD_INHERITANCE, tag, sep, b);
+	renderExtensionFieldMaybe (writer, FIELD_ACCESS, tag, sep, b);
+	renderExtensionFieldMaybe (writer, FIELD_IMPLEMENTATION, tag, sep, b);
+	renderExtensionFieldMaybe (writer, FIELD_SIGNATURE, tag, sep, b);
+	renderExtensionFieldMaybe (writer, FIELD_ROLE, tag, sep, b);
+	renderExtensionFieldMaybe (writer, FIELD_EXTRAS, tag, sep, b);
+	renderExtensionFieldMaybe (writer, FIELD_XPATH, tag, sep, b);
+	renderExtensionFieldMaybe (writer, FIELD_END_LINE, tag, sep, b);
 }
 
 static int writeCtagsEntry (tagWriter *writer,
 							MIO * mio, const tagEntryInfo *const tag)
 {
-	long origin = 0;
+	static vString *line;
 
+	line = vStringNewOrClearWithAutoRelease (line);
 	if (writer->private)
 	{
 		struct rejection *rej = writer->private;
 
-		origin = mio_tell (mio);
 		rej->rejectedInThisRendering = false;
-
 	}
 
-	int length = mio_printf (mio, "%s\t%s\t",
-			      escapeFieldValue (writer, tag, FIELD_NAME),
-			      escapeFieldValue (writer, tag, FIELD_INPUT_FILE));
+	catField (line, escapeFieldValue (writer, tag, FIELD_NAME));
+	vStringPut (line, '\t');
+	catField (line, escapeFieldValue (writer, tag, FIELD_INPUT_FILE));
+	vStringPut (line, '\t');
 
 	if (tag->lineNumberEntry)
-		length += writeLineNumberEntry (writer, mio, tag);
+		writeLineNumberEntry (writer, line, tag);
 	else
-		length += mio_puts(mio, escapeFieldValue(writer, tag, FIELD_PATTERN));
+		catField (line, escapeFieldValue(writer, tag, FIELD_PATTERN));
 
 	if (includeExtensionFlags ())
 	{
-		length += addExtensionFields (writer, mio, tag);
-		length += addParserFields (writer, mio, tag);
+		addExtensionFields (writer, line, tag);
+		addParserFields (writer, line, tag);
 	}
 
-	length += mio_printf (mio, "\n");
+	vStringPut (line, '\n');
 
 	if (writer->private
 		&& ((struct rejection *)(writer->private))->rejectedInThisRendering)
 	{
-		mio_seek (mio, origin, SEEK_SET);
-
-		/* Truncation is needed. */
 		((struct rejection *)(writer->private))->rejectedInThisInput = true;
-
-		length = 0;
+		return 0;
 	}
-	return length;
+
+	mio_write (mio, vStringValue (line), 1, vStringLength (line));
+	return (int) vStringLength (line);
 }
 
 static int writeCtagsPtagEntry (tagWriter *writer CTAGS_ATTR_UNUSED,
@@ -35,8 +35,10 @@ tagWriter etagsWriter = {
 	.defaultFileName = ETAGS_FILE,
 };
 
+/* The tags of a file are written to a memory stream, kept from a file to
+   the next, and copied at once to the tag file after the header giving
+   their size. */
 struct sEtags {
-	char *name;
 	MIO *mio;
 	size_t byteCount;
 	vString *vLine;
@@ -46,9 +48,12 @@ struct sEtags {
 
 static void *beginEtagsFile (tagWriter *writer CTAGS_ATTR_UNUSED, MIO *mio CTAGS_ATTR_UNUSED)
 {
-	static struct sEtags etags = { NULL, NULL, 0, NULL };
+	static struct sEtags etags = { NULL, 0, NULL };
 
-	etags.mio = tempFile ("w+b", &etags.name);
+	if (etags.mio == NULL)
+		etags.mio = mio_new_memory (NULL, 0, eRealloc, eFree);
+	else
+		mio_rewind (etags.mio);
 	etags.byteCount = 0;
 	etags.vLine = vStringNew ();
 	return &etags;
@@ -57,27 +62,20 @@ static void *beginEtagsFile (tagWriter *writer CTAGS_ATTR_UNUSED, MIO *mio CTAGS
 static bool endEtagsFile (tagWriter *writer,
 						  MIO *mainfp, const char *filename)
 {
-	const char *line;
 	struct sEtags *etags = writer->private;
+	const unsigned char *data;
+	long size;
 
 	mio_printf (mainfp, "\f\n%s,%ld\n", filename, (long) etags->byteCount);
 	abort_if_ferror (mainfp);
 
-	if (etags->mio != NULL)
-	{
-		mio_rewind (etags->mio);
-
-		while ((line = readLineRaw (etags->vLine, etags->mio)) != NULL)
-			mio_puts (mainfp, line);
-
-		vStringDelete (etags->vLine);
-		mio_free (etags->mio);
-		remove (etags->name);
-		eFree (etags->name);
-		etags->vLine = NULL;
-		etags->mio = NULL;
-		etags->name = NULL;
-	}
+	data = mio_memory_get_data (etags->mio, NULL);
+	size = mio_tell (etags->mio);
+	if (size > 0)
+		mio_write (mainfp, data, 1, (size_t) size);
+
+	vStringDelete (etags->vLine);
+	etags->vLine = NULL;
 	return false;
 }
 
@@ -95,7 +93,7 @@ static int writeEtagsEntry (tagWriter *writer,
 	else
 	{
 		size_t len;
-		long seekValue;
+		MIOOffset seekValue;
 		char *const line =
 				readLineFromBypassAnyway (etags->vLine, tag, &seekValue);
 		if (line == NULL)
@@ -111,8 +109,8 @@ static int writeEtagsEntry (tagWriter *writer,
 		if (Option.patternLengthLimit < len)
 			line [Option.patternLengthLimit - 1] = '\0';
 
-		length = mio_printf (mio, "%s\177%s\001%lu,%ld\n", line,
-				tag->name, tag->lineNumber, seekValue);
+		length = mio_printf (mio, "%s\177%s\001%lu,%lld\n", line,
+				tag->name, tag->lineNumber, (long long) seekValue);
 	}
 	etags->byteCount += length;
 
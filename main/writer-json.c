@@ -17,15 +17,23 @@
 #include "ptag.h"
 #include "writer.h"
 
-
+#include <stdio.h>
 #include <string.h>
 
-#ifdef HAVE_JANSSON
-#include <jansson.h>
 
-#ifndef json_boolean /* compat with jansson < 2.4 */
-#define json_boolean(val)      ((val) ? json_true() : json_false())
-#endif
+/*
+*   DATA DECLARATIONS
+*/
+
+/* An object being written to MIO, one member after another.
+   The layout is the one of jansson's json_dumps () with
+   JSON_PRESERVE_ORDER, which this writer used before: members
+   separated with ", ", and keys followed by ": ". */
+typedef struct sJsonObject {
+	MIO *mio;
+	int length;
+	bool empty;
+} jsonObject;
 
 
 static int writeJsonEntry  (tagWriter *writer CTAGS_ATTR_UNUSED,
@@ -37,6 +45,7 @@ static int writeJsonPtagEntry (tagWriter *writer CTAGS_ATTR_UNUSED,
 				const char *const pattern,
 				const char *const parserName);
 static void buildJsonFqTagCache (tagWriter *writer, tagEntryInfo *const tag);
+static bool treatJsonFieldAsFixed (int fieldType);
 
 tagWriter jsonWriter = {
 	.writeEntry = writeJsonEntry,
@@ -44,11 +53,186 @@ tagWriter jsonWriter = {
 	.preWriteEntry = NULL,
 	.postWriteEntry = NULL,
 	.buildFqTagCache = buildJsonFqTagCache,
+	.treatFieldAsFixed = treatJsonFieldAsFixed,
 	.defaultFileName = NULL,
 };
 
+/*
+*   FUNCTION DEFINITIONS
+*/
+
+/* Return the length of the well-formed UTF-8 sequence at S,
+   or 0 if there is none. */
+static int utf8SequenceLength (const unsigned char *const s)
+{
+	unsigned int c = s [0];
+	int length, i;
+
+	if (c < 0x80)
+		return 1;
+	else if (c < 0xC2)
+		return 0;
+	else if (c < 0xE0)
+	{
+		length = 2;
+		c &= 0x1F;
+	}
+	else if (c < 0xF0)
+	{
+		length = 3;
+		c &= 0x0F;
+	}
+	else if (c < 0xF5)
+	{
+		length = 4;
+		c &= 0x07;
+	}
+	else
+		return 0;
+
+	for (i = 1; i < length; i++)
+	{
+		if ((s [i] & 0xC0) != 0x80)
+			return 0;
+		c = (c << 6) | (s [i] & 0x3F);
+	}
+
+	if ((length == 3 && c < 0x800)
+		|| (length == 4 && c < 0x10000)
+		|| (0xD800 <= c && c <= 0xDFFF)
+		|| c > 0x10FFFF)
+		return 0;
+	return length;
+}
+
+static bool isValidUtf8 (const char *str)
+{
+	const unsigned char *s = (const unsigned char *) str;
+
+	while (*s)
+	{
+		int length = utf8SequenceLength (s);
+		if (length == 0)
+			return false;
+		s += length;
+	}
+	return true;
+}
+
+/* Write STR as a JSON string, escaped the way jansson does: '/' and
+   non-ASCII characters are kept as they are. A byte which is not part
+   of a valid UTF-8 sequence is written as a \u00XX escape. */
+static int writeJsonString (MIO *mio, const char *const str)
+{
+	const unsigned char *s = (const unsigned char *) str;
+	const unsigned char *run = s;
+	int length = 2;
+
+	mio_putc (mio, '"');
+	for (;;)
+	{
+		unsigned char c = *s;
+		const char *escape = NULL;
+		char seq [7];
+		int seqLength;
+
+		if (c >= 0x20 && c != '"' && c != '\\')
+		{
+			seqLength = (c < 0x80)? 1: utf8SequenceLength (s);
+			if (seqLength > 0)
+			{
+				s += seqLength;
+				continue;
+			}
+		}
+
+		if (s > run)
+		{
+			mio_write (mio, run, 1, s - run);
+			length += s - run;
+		}
+		if (c == '\0')
+			break;
+
+		switch (c)
+		{
+		case '"':  escape = "\\\""; break;
+		case '\\': escape = "\\\\"; break;
+		case '\b': escape = "\\b"; break;
+		case '\f': escape = "\\f"; break;
+		case '\n': escape = "\\n"; break;
+		case '\r': escape = "\\r"; break;
+		case '\t': escape = "\\t"; break;
+		default:
+			snprintf (seq, sizeof (seq), "\\u%04X", c);
+			escape = seq;
+			break;
+		}
+		mio_puts (mio, escape);
+		length += strlen (escape);
+		run = ++s;
+	}
+	mio_putc (mio, '"');
+
+	return length;
+}
 
-static json_t* escapeFieldValue (const tagEntryInfo * tag, fieldType ftype, bool returnEmptyStringAsNoValue)
+static void jsonObjectBegin (jsonObject *object, MIO *mio)
+{
+	object->mio = mio;
+	object->length = 1;
+	object->empty = true;
+	mio_putc (mio, '{');
+}
+
+static int jsonObjectEnd (jsonObject *object)
+{
+	mio_puts (object->mio, "}\n");
+	return object->length + 2;
+}
+
+static void jsonObjectKey (jsonObject *object, const char *const key)
+{
+	if (!object->empty)
+	{
+		mio_puts (object->mio, ", ");
+		object->length += 2;
+	}
+	object->empty = false;
+
+	object->length += writeJsonString (object->mio, key);
+	mio_puts (object->mio, ": ");
+	object->length += 2;
+}
+
+static void jsonObjectString (jsonObject *object, const char *const key,
+							  const char *const value)
+{
+	jsonObjectKey (object, key);
+	object->length += writeJsonString (object->mio, value);
+}
+
+static void jsonObjectInteger (jsonObject *object, const char *const key,
+							   long value)
+{
+	jsonObjectKey (object, key);
+	object->length += mio_printf (object->mio, "%ld", value);
+}
+
+static void jsonObjectBoolean (jsonObject *object, const char *const key,
+							   bool value)
+{
+	jsonObjectKey (object, key);
+	mio_puts (object->mio, value? "true": "false");
+	object->length += value? 4: 5;
+}
+
+/* A field having no value in JSON is left out of the object, like an
+   optional field not encoded in UTF-8, which jansson used to refuse.
+   RETURNEMPTYSTRINGASNOVALUE is for the members every entry has. */
+static void writeFieldValue (jsonObject *object, const char *const key,
+							 const tagEntryInfo * tag, fieldType ftype,
+							 bool returnEmptyStringAsNoValue)
 {
 	const char *str = renderFieldEscaped (jsonWriter.type, ftype, tag, NO_PARSER_FIELD, NULL);
 	if (str)
@@ -57,35 +241,31 @@ static json_t* escapeFieldValue (const tagEntryInfo * tag, fieldType ftype, bool
 		if (dt & FIELDTYPE_STRING)
 		{
 			if (dt & FIELDTYPE_BOOL && str[0] == '\0')
-				return json_false();
-			else
-				return json_string (str);
+				jsonObjectBoolean (object, key, false);
+			else if (returnEmptyStringAsNoValue || isValidUtf8 (str))
+				jsonObjectString (object, key, str);
 		}
 		else if (dt & FIELDTYPE_INTEGER)
 		{
 			long tmp;
 
 			if (strToLong (str, 10, &tmp))
-				return json_integer (tmp);
-			else
-				return NULL;
+				jsonObjectInteger (object, key, tmp);
 		}
 		else if (dt & FIELDTYPE_BOOL)
 		{
 			/* TODO: This must be fixed when new boolean field is added.
 			   Currently only `file:' field use this. */
-			return json_boolean (strcmp ("-", str)); /* "-" -> false */
+			jsonObjectBoolean (object, key, strcmp ("-", str)); /* "-" -> false */
 		}
-		AssertNotReached ();
-		return NULL;
+		else
+			AssertNotReached ();
 	}
 	else if (returnEmptyStringAsNoValue)
-		return json_false();
-	else
-		return NULL;
+		jsonObjectBoolean (object, key, false);
 }
 
-static void renderExtensionFieldMaybe (int xftype, const tagEntryInfo *const tag, json_t *response)
+static void renderExtensionFieldMaybe (int xftype, const tagEntryInfo *const tag, jsonObject *object)
 {
 	const char *fname = getFieldName (xftype);
 
@@ -94,21 +274,18 @@ static void renderExtensionFieldMaybe (int xftype, const tagEntryInfo *const tag
 		switch (xftype)
 		{
 		case FIELD_LINE_NUMBER:
-			json_object_set_new (response, fname,
-					     json_integer (tag->lineNumber));
+			jsonObjectInteger (object, fname, tag->lineNumber);
 			break;
 		case FIELD_FILE_SCOPE:
-			json_object_set_new (response, fname,
-					     json_boolean(1));
+			jsonObjectBoolean (object, fname, true);
 			break;
 		default:
-			json_object_set_new (response, fname,
-					     escapeFieldValue (tag, xftype, false));
+			writeFieldValue (object, fname, tag, xftype, false);
 		}
 	}
 }
 
-static void addParserFields (json_t *response, const tagEntryInfo *const tag)
+static void addParserFields (jsonObject *object, const tagEntryInfo *const tag)
 {
 	unsigned int i;
 	unsigned int ftype;
@@ -118,12 +295,14 @@ static void addParserFields (json_t *response, const tagEntryInfo *const tag)
 		ftype = tag->parserFields [i].ftype;
 		if (! isFieldEnabled (ftype))
 			continue;
+		if (! isValidUtf8 (tag->parserFields [i].value))
+			continue;
 
-		json_object_set_new (response, getFieldName (ftype), json_string (tag->parserFields [i].value));
+		jsonObjectString (object, getFieldName (ftype), tag->parserFields [i].value);
 	}
 }
 
-static void addExtensionFields (json_t *response, const tagEntryInfo *const tag)
+static void addExtensionFields (jsonObject *object, const tagEntryInfo *const tag)
 {
 	int k;
 
@@ -144,33 +323,37 @@ static void addExtensionFields (json_t *response, const tagEntryInfo *const tag)
 	}
 
 	for (k = FIELD_EXTENSION_START; k <= FIELD_BUILTIN_LAST; k++)
-		renderExtensionFieldMaybe (k, tag, response);
+		renderExtensionFieldMaybe (k, tag, object);
 }
 
 static int writeJsonEntry (tagWriter *writer CTAGS_ATTR_UNUSED,
 			       MIO * mio, const tagEntryInfo *const tag)
 {
-	json_t *pat = escapeFieldValue(tag, FIELD_PATTERN, true);
-	json_t *response = json_pack ("{ss ss ss sO}",
-		"_type", "tag",
-		"name", tag->name,
-		"path", tag->sourceFileName,
-		"pattern", pat);
-	json_decref (pat);
+	jsonObject object;
+
+	jsonObjectBegin (&object, mio);
+	jsonObjectString (&object, "_type", "tag");
+	jsonObjectString (&object, "name", tag->name);
+	if (isFieldEnabled (FIELD_INPUT_FILE))
+		jsonObjectString (&object, "path", tag->sourceFileName);
+	/* Without the pattern, the input line is not read again. */
+	if (isFieldEnabled (FIELD_PATTERN))
+		writeFieldValue (&object, "pattern", tag, FIELD_PATTERN, true);
 
 	if (includeExtensionFlags ())
 	{
-		addExtensionFields (response, tag);
-		addParserFields (response, tag);
+		addExtensionFields (&object, tag);
+		addParserFields (&object, tag);
 	}
 
-	char *buf = json_dumps (response, JSON_PRESERVE_ORDER);
-	int length = mio_printf (mio, "%s\n", buf);
-
-	free (buf);
-	json_decref (response);
+	return jsonObjectEnd (&object);
+}
 
-	return length;
+/* A consumer of JSON finds the members by their keys, so only the name
+   is needed in every object. */
+static bool treatJsonFieldAsFixed (int fieldType)
+{
+	return (fieldType == FIELD_NAME);
 }
 
 static void buildJsonFqTagCache (tagWriter *writer, tagEntryInfo *const tag)
@@ -188,32 +371,17 @@ static int writeJsonPtagEntry (tagWriter *writer CTAGS_ATTR_UNUSED,
 			       const char *const parserName)
 {
 #define OPT(X) ((X)?(X):"")
-	json_t *response;
+	jsonObject object;
 
+	jsonObjectBegin (&object, mio);
+	jsonObjectString (&object, "_type", "ptag");
+	jsonObjectString (&object, "name", desc->name);
 	if (parserName)
-	{
-		response = json_pack ("{ss ss ss ss ss}",
-				      "_type", "ptag",
-				      "name", desc->name,
-				      "parserName", parserName,
-				      "path", OPT(fileName),
-				      "pattern", OPT(pattern));
-	}
-	else
-	{
-		response = json_pack ("{ss ss ss ss}",
-				      "_type", "ptag",
-				      "name", desc->name,
-				      "path", OPT(fileName),
-				      "pattern", OPT(pattern));
-	}
-
-	char *buf = json_dumps (response, JSON_PRESERVE_ORDER);
-	int length = mio_printf (mio, "%s\n", buf);
-	free (buf);
-	json_decref (response);
+		jsonObjectString (&object, "parserName", parserName);
+	jsonObjectString (&object, "path", OPT(fileName));
+	jsonObjectString (&object, "pattern", OPT(pattern));
 
-	return length;
+	return jsonObjectEnd (&object);
 #undef OPT
 }
 
@@ -224,20 +392,3 @@ extern bool ptagMakeJsonOutputVersion (ptagDesc *desc, void *data CTAGS_ATTR_UNU
 			       "in development",
 			       NULL);
 }
-
-#else /* HAVE_JANSSON */
-
-tagWriter jsonWriter = {
-	.writeEntry = NULL,
-	.writePtagEntry = NULL,
-	.preWriteEntry = NULL,
-	.postWriteEntry = NULL,
-	.defaultFileName = "-",
-};
-
-extern bool ptagMakeJsonOutputVersion (ptagDesc *desc, void *data CTAGS_ATTR_UNUSED)
-{
-	return false;
-}
-
-#endif
@@ -0,0 +1,716 @@
+/*
+*   Copyright (c) 2026, Universal Ctags Team
+*
+*   This source code is released for free distribution under the terms of the
+*   GNU General Public License version 2 or (at your option) any later version.
+*
+*   This module contains functions for the protobuf output format
+*   (--output-format=protobuf): a stream of Protocol Buffers messages,
+*   each one preceded with its size as a varint, the way
+*   writeDelimitedTo () and parseDelimitedFrom () of the protobuf
+*   libraries do. The messages are these ones:
+*
+*   message Record {
+*     oneof record {
+*       File file = 1;      // starts the tags of an input file
+*       bytes string = 2;   // adds a string to the table of the file
+*       Tag tag = 3;
+*       string json = 15;   // a response of interactive mode
+*     }
+*   }
+*   message File { bytes path = 1; }
+*   message Tag {
+*     uint32 name = 1;
+*     uint32 path = 2;
+*     uint32 pattern = 3;
+*     repeated Field fields = 4;
+*   }
+*   message Field {
+*     uint32 key = 1;
+*     oneof value { uint32 string = 2; int64 integer = 3; bool boolean = 4; }
+*   }
+*
+*   A tag refers to its strings with their ids in the table of its
+*   file, which is emptied by a file record: the string records of the
+*   file number them from 1, and a string record comes just before the
+*   first tag using it. The fields of a tag are the ones of the JSON
+*   output, the keys being the names of the members.
+*
+*   The string table is made again for each parse, so the fragments of
+*   --jobs and --cache-dir can be concatenated like the ones of the
+*   other formats.
+*/
+
+/*
+*   INCLUDE FILES
+*/
+#include "general.h"  /* must always come first */
+
+#include <stdint.h>
+#include <string.h>
+
+#include "debug.h"
+#include "entry_private.h"
+#include "field.h"
+#include "htable.h"
+#include "mio.h"
+#include "options.h"
+#include "parse.h"
+#include "ptrarray.h"
+#include "routines.h"
+#include "writer.h"
+
+/*
+*   MACROS
+*/
+#define PROTOBUF_FILE  "tags.pb"
+
+#define WIRE_VARINT    0
+#define WIRE_LENGTH    2
+
+/*
+*   DATA DECLARATIONS
+*/
+enum eRecordField {
+	PB_RECORD_FILE    = 1,
+	PB_RECORD_STRING  = 2,
+	PB_RECORD_TAG     = 3,
+	PB_RECORD_JSON    = 15,
+};
+
+enum eFileField {
+	PB_FILE_PATH      = 1,
+};
+
+enum eTagField {
+	PB_TAG_NAME       = 1,
+	PB_TAG_PATH       = 2,
+	PB_TAG_PATTERN    = 3,
+	PB_TAG_FIELDS     = 4,
+};
+
+enum eFieldField {
+	PB_FIELD_KEY      = 1,
+	PB_FIELD_STRING   = 2,
+	PB_FIELD_INTEGER  = 3,
+	PB_FIELD_BOOLEAN  = 4,
+};
+
+typedef struct sProtobufBuffer {
+	unsigned char *data;
+	size_t length;
+	size_t size;
+} protobufBuffer;
+
+typedef struct sProtobufString {
+	char *str;					/* owned by ids */
+	long offset;				/* of its record */
+} protobufString;
+
+typedef struct sProtobufStream {
+	hashTable *ids;				/* string -> id */
+	protobufString *strings;	/* of ids 1, 2, ... */
+	uint32_t count;				/* of strings */
+	uint32_t length;			/* of strings */
+	bool fileStarted;
+	long fileOffset;			/* of the file record */
+	long end;					/* of the last record */
+	protobufBuffer tag;
+	protobufBuffer field;
+} protobufStream;
+
+static int writeProtobufEntry (tagWriter *writer, MIO * mio,
+							   const tagEntryInfo *const tag);
+static void *beginProtobufFile (tagWriter *writer, MIO * mio);
+static void buildProtobufFqTagCache (tagWriter *writer, tagEntryInfo *const tag);
+static bool treatProtobufFieldAsFixed (int fieldType);
+
+tagWriter protobufWriter = {
+	.writeEntry = writeProtobufEntry,
+	.writePtagEntry = NULL,
+	.preWriteEntry = beginProtobufFile,
+	.postWriteEntry = NULL,
+	.buildFqTagCache = buildProtobufFqTagCache,
+	.treatFieldAsFixed = treatProtobufFieldAsFixed,
+	.defaultFileName = PROTOBUF_FILE,
+};
+
+static protobufStream Stream;
+
+/*
+*   FUNCTION DEFINITIONS
+*/
+
+static void putBytes (protobufBuffer *buffer, const void *bytes, size_t length)
+{
+	if (buffer->length + length > buffer->size)
+	{
+		while (buffer->length + length > buffer->size)
+			buffer->size = buffer->size? buffer->size * 2: 256;
+		buffer->data = xRealloc (buffer->data, buffer->size, unsigned char);
+	}
+	memcpy (buffer->data + buffer->length, bytes, length);
+	buffer->length += length;
+}
+
+/* Encode N into BYTES, which has room for 10 bytes. */
+static size_t encodeVarint (unsigned char *bytes, uint64_t n)
+{
+	size_t length = 0;
+
+	while (n >= 0x80)
+	{
+		bytes [length++] = (unsigned char) (n | 0x80);
+		n >>= 7;
+	}
+	bytes [length++] = (unsigned char) n;
+	return length;
+}
+
+static void putVarint (protobufBuffer *buffer, uint64_t n)
+{
+	unsigned char bytes [10];
+
+	putBytes (buffer, bytes, encodeVarint (bytes, n));
+}
+
+static void putKey (protobufBuffer *buffer, unsigned int field, unsigned int wire)
+{
+	putVarint (buffer, (field << 3) | wire);
+}
+
+static void putVarintField (protobufBuffer *buffer, unsigned int field, uint64_t n)
+{
+	putKey (buffer, field, WIRE_VARINT);
+	putVarint (buffer, n);
+}
+
+static void putLengthField (protobufBuffer *buffer, unsigned int field,
+							const void *data, size_t length)
+{
+	putKey (buffer, field, WIRE_LENGTH);
+	putVarint (buffer, length);
+	putBytes (buffer, data, length);
+}
+
+/* Write a record holding LENGTH bytes of DATA as its FIELD. */
+static int writeRecord (MIO *mio, unsigned int field,
+						const void *data, size_t length)
+{
+	unsigned char head [22];
+	size_t headLength;
+	size_t lengthLength;
+
+	/* The key and the size of the field, then their size
+	   with the field in front of them. */
+	headLength = encodeVarint (head + 11, (field << 3) | WIRE_LENGTH);
+	headLength += encodeVarint (head + 11 + headLength, length);
+	lengthLength = encodeVarint (head, headLength + length);
+	memmove (head + lengthLength, head + 11, headLength);
+
+	mio_write (mio, head, 1, lengthLength + headLength);
+	if (length > 0)
+		mio_write (mio, data, 1, length);
+	return (int) (lengthLength + headLength + length);
+}
+
+static void *beginProtobufFile (tagWriter *writer CTAGS_ATTR_UNUSED,
+								MIO *mio CTAGS_ATTR_UNUSED)
+{
+	if (Stream.ids == NULL)
+		Stream.ids = hashTableNew (1021, hashCstrhash, hashCstreq, eFree, NULL);
+	else
+		hashTableClear (Stream.ids);
+	Stream.count = 0;
+	Stream.fileStarted = false;
+	Stream.end = 0;
+	return &Stream;
+}
+
+/* The records after POS were taken back by a parser rescan. */
+static void forgetRecordsAfter (protobufStream *stream, long pos)
+{
+	while (stream->count > 0 && stream->strings [stream->count - 1].offset >= pos)
+	{
+		stream->count--;
+		hashTableDeleteItem (stream->ids, stream->strings [stream->count].str);
+	}
+	if (stream->fileStarted && stream->fileOffset >= pos)
+		stream->fileStarted = false;
+}
+
+static uint32_t internString (protobufStream *stream, MIO *mio,
+							  const char *const str, int *length)
+{
+	uintptr_t id = (uintptr_t) hashTableGetItem (stream->ids, str);
+	char *key;
+
+	if (id > 0)
+		return (uint32_t) id;
+
+	if (stream->count == UINT32_MAX - 1)
+		error (FATAL, "too many strings in the tags of a file");
+	if (stream->count == stream->length)
+	{
+		stream->length = stream->length? stream->length * 2: 256;
+		stream->strings = xRealloc (stream->strings, stream->length, protobufString);
+	}
+	key = eStrdup (str);
+	stream->strings [stream->count].str = key;
+	stream->strings [stream->count].offset = mio_tell (mio);
+	id = ++stream->count;
+	hashTablePutItem (stream->ids, key, (void *) id);
+
+	*length += writeRecord (mio, PB_RECORD_STRING, str, strlen (str));
+	return (uint32_t) id;
+}
+
+static void putStringField (protobufStream *stream, MIO *mio, protobufBuffer *buffer,
+							unsigned int field, const char *const str, int *length)
+{
+	putVarintField (buffer, field, internString (stream, mio, str, length));
+}
+
+static void beginField (protobufStream *stream, MIO *mio,
+						const char *const key, int *length)
+{
+	stream->field.length = 0;
+	putStringField (stream, mio, &stream->field, PB_FIELD_KEY, key, length);
+}
+
+static void endField (protobufStream *stream)
+{
+	putLengthField (&stream->tag, PB_TAG_FIELDS,
+					stream->field.data, stream->field.length);
+}
+
+static void addStringField (protobufStream *stream, MIO *mio,
+							const char *const key, const char *const value,
+							int *length)
+{
+	beginField (stream, mio, key, length);
+	putStringField (stream, mio, &stream->field, PB_FIELD_STRING, value, length);
+	endField (stream);
+}
+
+static void addIntegerField (protobufStream *stream, MIO *mio,
+							 const char *const key, long value, int *length)
+{
+	beginField (stream, mio, key, length);
+	putVarintField (&stream->field, PB_FIELD_INTEGER, (uint64_t) (int64_t) value);
+	endField (stream);
+}
+
+static void addBooleanField (protobufStream *stream, MIO *mio,
+							 const char *const key, bool value, int *length)
+{
+	beginField (stream, mio, key, length);
+	putVarintField (&stream->field, PB_FIELD_BOOLEAN, value);
+	endField (stream);
+}
+
+/* Like writeFieldValue () of writer-json.c */
+static void addFieldValue (protobufStream *stream, MIO *mio,
+						   const char *const key, const tagEntryInfo *tag,
+						   fieldType ftype, int *length)
+{
+	const char *str = renderFieldEscaped (protobufWriter.type, ftype, tag,
+										  NO_PARSER_FIELD, NULL);
+	unsigned int dt;
+
+	if (str == NULL)
+		return;
+
+	dt = getFieldDataType (ftype);
+	if (dt & FIELDTYPE_STRING)
+	{
+		if (dt & FIELDTYPE_BOOL && str [0] == '\0')
+			addBooleanField (stream, mio, key, false, length);
+		else
+			addStringField (stream, mio, key, str, length);
+	}
+	else if (dt & FIELDTYPE_INTEGER)
+	{
+		long tmp;
+
+		if (strToLong (str, 10, &tmp))
+			addIntegerField (stream, mio, key, tmp, length);
+	}
+	else if (dt & FIELDTYPE_BOOL)
+		addBooleanField (stream, mio, key, strcmp ("-", str), length);
+	else
+		AssertNotReached ();
+}
+
+static void addExtensionFields (protobufStream *stream, MIO *mio,
+								const tagEntryInfo *const tag, int *length)
+{
+	int k;
+
+	/* The same keys as the JSON output; see addExtensionFields ()
+	   of writer-json.c. */
+	if (isFieldEnabled (FIELD_KIND) || isFieldEnabled (FIELD_KIND_LONG))
+		enableField (FIELD_KIND_KEY, true, false);
+	if (isFieldEnabled (FIELD_SCOPE))
+	{
+		enableField (FIELD_SCOPE_KEY, true, false);
+		enableField (FIELD_SCOPE_KIND_LONG, true, false);
+	}
+
+	for (k = FIELD_EXTENSION_START; k <= FIELD_BUILTIN_LAST; k++)
+	{
+		const char *fname = getFieldName (k);
+
+		if (! (fname && isFieldRenderable (k) && isFieldEnabled (k)
+			   && doesFieldHaveValue (k, tag)))
+			continue;
+
+		if (k == FIELD_LINE_NUMBER)
+			addIntegerField (stream, mio, fname, tag->lineNumber, length);
+		else if (k == FIELD_FILE_SCOPE)
+			addBooleanField (stream, mio, fname, true, length);
+		else
+			addFieldValue (stream, mio, fname, tag, k, length);
+	}
+}
+
+static void addParserFields (protobufStream *stream, MIO *mio,
+							 const tagEntryInfo *const tag, int *length)
+{
+	unsigned int i;
+
+	for (i = 0; i < tag->usedParserFields; i++)
+	{
+		const unsigned int ftype = tag->parserFields [i].ftype;
+
+		if (isFieldEnabled (ftype))
+			addStringField (stream, mio, getFieldName (ftype),
+							tag->parserFields [i].value, length);
+	}
+}
+
+static int writeProtobufEntry (tagWriter *writer,
+							   MIO * mio, const tagEntryInfo *const tag)
+{
+	protobufStream *stream = writer->private? writer->private: &Stream;
+	const long pos = mio_tell (mio);
+	int length = 0;
+
+	if (stream->ids == NULL)
+		beginProtobufFile (writer, mio);
+	if (pos >= 0 && pos < stream->end)
+		forgetRecordsAfter (stream, pos);
+
+	if (! stream->fileStarted)
+	{
+		protobufBuffer *file = &stream->field;
+
+		file->length = 0;
+		putLengthField (file, PB_FILE_PATH, tag->inputFileName, strlen (tag->inputFileName));
+		stream->fileOffset = pos;
+		stream->fileStarted = true;
+		length += writeRecord (mio, PB_RECORD_FILE, file->data, file->length);
+	}
+
+	stream->tag.length = 0;
+	putStringField (stream, mio, &stream->tag, PB_TAG_NAME, tag->name, &length);
+	if (isFieldEnabled (FIELD_INPUT_FILE))
+		putStringField (stream, mio, &stream->tag, PB_TAG_PATH,
+						tag->sourceFileName, &length);
+	if (isFieldEnabled (FIELD_PATTERN))
+	{
+		const char *pattern = renderFieldEscaped (writer->type, FIELD_PATTERN, tag,
+												  NO_PARSER_FIELD, NULL);
+		if (pattern && pattern [0] != '\0')
+			putStringField (stream, mio, &stream->tag, PB_TAG_PATTERN,
+							pattern, &length);
+	}
+
+	if (includeExtensionFlags ())
+	{
+		addExtensionFields (stream, mio, tag, &length);
+		addParserFields (stream, mio, tag, &length);
+	}
+
+	length += writeRecord (mio, PB_RECORD_TAG, stream->tag.data, stream->tag.length);
+	stream->end = mio_tell (mio);
+	return length;
+}
+
+/* Only the name is needed in every tag, like the JSON output. */
+static bool treatProtobufFieldAsFixed (int fieldType)
+{
+	return (fieldType == FIELD_NAME);
+}
+
+static void buildProtobufFqTagCache (tagWriter *writer, tagEntryInfo *const tag)
+{
+	renderFieldEscaped (writer->type, FIELD_SCOPE_KIND_LONG, tag,
+						NO_PARSER_FIELD, NULL);
+	renderFieldEscaped (writer->type, FIELD_SCOPE, tag,
+						NO_PARSER_FIELD, NULL);
+}
+
+extern int writeProtobufJsonRecord (MIO *mio, const char *const json)
+{
+	return writeRecord (mio, PB_RECORD_JSON, json, strlen (json));
+}
+
+extern bool readProtobufVarint (const unsigned char *data, size_t size,
+								size_t *offset, uint64_t *n)
+{
+	unsigned int shift;
+
+	*n = 0;
+	for (shift = 0; *offset < size && shift < 64; shift += 7)
+	{
+		const unsigned char c = data [(*offset)++];
+
+		*n |= (uint64_t) (c & 0x7F) << shift;
+		if (! (c & 0x80))
+			return true;
+	}
+	return false;
+}
+
+extern bool isProtobufTagStream (const unsigned char *data, size_t size)
+{
+	uint64_t length, key, fieldLength;
+	size_t offset = 0, start;
+
+	/* A stream starts with a file record, or a response in
+	   interactive mode. */
+	if (! readProtobufVarint (data, size, &offset, &length))
+		return false;
+	start = offset;
+	return (readProtobufVarint (data, size, &offset, &key)
+			&& (key == ((PB_RECORD_FILE << 3) | WIRE_LENGTH)
+				|| key == ((PB_RECORD_JSON << 3) | WIRE_LENGTH))
+			&& readProtobufVarint (data, size, &offset, &fieldLength)
+			&& offset - start + fieldLength == length);
+}
+
+extern bool readProtobufField (const unsigned char *data, size_t size,
+							   size_t *offset, unsigned int *field,
+							   uint64_t *n, const unsigned char **bytes)
+{
+	uint64_t key;
+
+	if (! readProtobufVarint (data, size, offset, &key)
+		|| ! readProtobufVarint (data, size, offset, n))
+		return false;
+	*field = (unsigned int) (key >> 3);
+	*bytes = NULL;
+	if ((key & 7) == WIRE_LENGTH)
+	{
+		if (*n > size - *offset)
+			return false;
+		*bytes = data + *offset;
+		*offset += (size_t) *n;
+	}
+	else if ((key & 7) != WIRE_VARINT)
+		return false;
+	return true;
+}
+
+/*
+ *  Reading a stream back, for --_dump-protobuf-stream
+ */
+
+typedef struct sProtobufSlice {
+	const unsigned char *data;
+	size_t length;
+} protobufSlice;
+
+typedef struct sProtobufReader {
+	const char *fileName;
+	const unsigned char *data;
+	size_t size;
+	size_t offset;
+} protobufReader;
+
+static void brokenStream (const protobufReader *reader)
+{
+	error (FATAL, "\"%s\" is a broken protobuf tag stream", reader->fileName);
+}
+
+/* Read the next field of the message READER holds: its number is
+   returned, and N is set to its value or SLICE to its bytes. */
+static unsigned int readField (protobufReader *reader, uint64_t *n,
+							   protobufSlice *slice)
+{
+	unsigned int field = 0;
+	const unsigned char *bytes;
+
+	if (! readProtobufField (reader->data, reader->size, &reader->offset,
+							 &field, n, &bytes))
+		brokenStream (reader);
+	if (bytes)
+	{
+		slice->data = bytes;
+		slice->length = (size_t) *n;
+	}
+	return field;
+}
+
+static protobufReader subReader (const protobufReader *reader,
+								 const protobufSlice *slice)
+{
+	protobufReader sub = { reader->fileName, slice->data, slice->length, 0 };
+	return sub;
+}
+
+static const protobufSlice *lookUpString (const protobufReader *reader,
+										  const ptrArray *table, uint64_t id)
+{
+	if (id == 0 || id > ptrArrayCount (table))
+		brokenStream (reader);
+	return ptrArrayItem (table, (unsigned int) (id - 1));
+}
+
+static void printSlice (FILE *fp, const protobufSlice *slice)
+{
+	fwrite (slice->data, 1, slice->length, fp);
+}
+
+static void dumpField (protobufReader *reader, const ptrArray *table, FILE *fp)
+{
+	uint64_t n;
+	protobufSlice slice;
+
+	fputc ('\t', fp);
+	while (reader->offset < reader->size)
+	{
+		switch (readField (reader, &n, &slice))
+		{
+		case PB_FIELD_KEY:
+			printSlice (fp, lookUpString (reader, table, n));
+			fputc (':', fp);
+			break;
+		case PB_FIELD_STRING:
+			printSlice (fp, lookUpString (reader, table, n));
+			break;
+		case PB_FIELD_INTEGER:
+			fprintf (fp, "%lld", (long long) (int64_t) n);
+			break;
+		case PB_FIELD_BOOLEAN:
+			fputs (n? "true": "false", fp);
+			break;
+		}
+	}
+}
+
+static void dumpTag (protobufReader *reader, const ptrArray *table, FILE *fp)
+{
+	const protobufSlice *columns [3] = { NULL, NULL, NULL };
+	protobufSlice *fields = NULL;
+	unsigned int count = 0, i;
+	uint64_t n;
+	protobufSlice slice;
+
+	while (reader->offset < reader->size)
+	{
+		const unsigned int field = readField (reader, &n, &slice);
+
+		if (PB_TAG_NAME <= field && field <= PB_TAG_PATTERN)
+			columns [field - PB_TAG_NAME] = lookUpString (reader, table, n);
+		else if (field == PB_TAG_FIELDS)
+		{
+			fields = xRealloc (fields, count + 1, protobufSlice);
+			fields [count++] = slice;
+		}
+	}
+
+	for (i = 0; i < 3; i++)
+	{
+		if (i > 0)
+			fputc ('\t', fp);
+		if (columns [i])
+			printSlice (fp, columns [i]);
+	}
+	for (i = 0; i < count; i++)
+	{
+		protobufReader sub = subReader (reader, fields + i);
+		dumpField (&sub, table, fp);
+	}
+	fputc ('\n', fp);
+
+	if (fields)
+		eFree (fields);
+}
+
+extern void dumpProtobufStream (const char *const fileName, FILE *fp)
+{
+	MIO *mio = mio_new_file (fileName, "rb");
+	ptrArray *table = ptrArrayNew (eFree);
+	unsigned char *data;
+	unsigned long fileSize;
+	protobufReader reader;
+
+	if (mio == NULL)
+		error (FATAL | PERROR, "cannot open \"%s\"", fileName);
+	mio_seek (mio, 0, SEEK_END);
+	fileSize = mio_tell (mio);
+	mio_rewind (mio);
+	data = xMalloc (fileSize + 1, unsigned char);
+	if (mio_read (mio, data, 1, fileSize) != fileSize)
+		error (FATAL | PERROR, "cannot read \"%s\"", fileName);
+	mio_free (mio);
+
+	if (fileSize > 0 && ! isProtobufTagStream (data, fileSize))
+		error (FATAL, "\"%s\" is not a protobuf tag stream", fileName);
+
+	reader.fileName = fileName;
+	reader.data = data;
+	reader.size = fileSize;
+	reader.offset = 0;
+	while (reader.offset < reader.size)
+	{
+		protobufReader record;
+		protobufSlice slice;
+		uint64_t n;
+
+		if (! readProtobufVarint (reader.data, reader.size, &reader.offset, &n)
+			|| n > reader.size - reader.offset)
+			brokenStream (&reader);
+		slice.data = reader.data + reader.offset;
+		slice.length = (size_t) n;
+		reader.offset += slice.length;
+
+		record = subReader (&reader, &slice);
+		while (record.offset < record.size)
+		{
+			protobufReader sub;
+			protobufSlice *str;
+
+			switch (readField (&record, &n, &slice))
+			{
+			case PB_RECORD_FILE:
+				ptrArrayClear (table);
+				sub = subReader (&record, &slice);
+				fputs ("--- ", fp);
+				while (sub.offset < sub.size)
+					if (readField (&sub, &n, &slice) == PB_FILE_PATH)
+						printSlice (fp, &slice);
+				fputc ('\n', fp);
+				break;
+			case PB_RECORD_STRING:
+				str = xMalloc (1, protobufSlice);
+				*str = slice;
+				ptrArrayAdd (table, str);
+				break;
+			case PB_RECORD_TAG:
+				sub = subReader (&record, &slice);
+				dumpTag (&sub, table, fp);
+				break;
+			case PB_RECORD_JSON:
+				printSlice (fp, &slice);
+				fputc ('\n', fp);
+				break;
+			}
+		}
+	}
+
+	ptrArrayDelete (table);
+	eFree (data);
+}
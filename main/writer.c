@@ -8,6 +8,9 @@
 */
 
 #include "general.h"
+
+#include <string.h>
+
 #include "entry.h"
 #include "writer.h"
 
@@ -16,6 +19,8 @@ extern tagWriter eCtagsWriter;
 extern tagWriter etagsWriter;
 extern tagWriter xrefWriter;
 extern tagWriter jsonWriter;
+extern tagWriter binaryWriter;
+extern tagWriter protobufWriter;
 
 static tagWriter *writerTable [WRITER_COUNT] = {
 	[WRITER_U_CTAGS] = &uCtagsWriter,
@@ -23,6 +28,18 @@ static tagWriter *writerTable [WRITER_COUNT] = {
 	[WRITER_ETAGS] = &etagsWriter,
 	[WRITER_XREF]  = &xrefWriter,
 	[WRITER_JSON]  = &jsonWriter,
+	[WRITER_BINARY] = &binaryWriter,
+	[WRITER_PROTOBUF] = &protobufWriter,
+};
+
+static const char *writerNames [WRITER_COUNT] = {
+	[WRITER_U_CTAGS] = "u-ctags",
+	[WRITER_E_CTAGS] = "e-ctags",
+	[WRITER_ETAGS] = "etags",
+	[WRITER_XREF]  = "xref",
+	[WRITER_JSON]  = "json",
+	[WRITER_BINARY] = "binary",
+	[WRITER_PROTOBUF] = "protobuf",
 };
 
 static tagWriter *writer;
@@ -33,6 +50,22 @@ extern void setTagWriter (writerType wtype)
 	writer->type = wtype;
 }
 
+extern writerType getTagWriterType (void)
+{
+	return writer->type;
+}
+
+extern writerType getNamedTagWriterType (const char *const name, size_t length)
+{
+	int i;
+
+	for (i = 0; i < WRITER_COUNT; i++)
+		if (strlen (writerNames [i]) == length
+			&& strncmp (writerNames [i], name, length) == 0)
+			return i;
+	return WRITER_COUNT;
+}
+
 extern void writerSetup (MIO *mio)
 {
 	if (writer->preWriteEntry)
@@ -78,6 +111,22 @@ extern void writerBuildFqTagCache (tagEntryInfo *const tag)
 		writer->buildFqTagCache (writer, tag);
 }
 
+extern bool writerDoesTreatFieldAsFixed (int fieldType)
+{
+	if (writer && writer->treatFieldAsFixed)
+		return writer->treatFieldAsFixed (fieldType);
+	return true;
+}
+
+extern bool writerRewritesOutput (void)
+{
+	return (writer->rewriteOutput)? true: false;
+}
+
+extern void writerRewriteOutput (MIO *entries, long size, MIO *output)
+{
+	writer->rewriteOutput (writer, entries, size, output);
+}
 
 extern bool ptagMakeCtagsOutputMode (ptagDesc *desc, void *data CTAGS_ATTR_UNUSED)
 {
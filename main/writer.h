@@ -10,6 +10,9 @@
 #define CTAGS_MAIN_WRITER_H
 
 #include "general.h"  /* must always come first */
+
+#include <stdint.h>
+
 #include "mio.h"
 #include "types.h"
 
@@ -25,6 +28,8 @@ typedef enum eWriterType {
 	WRITER_ETAGS,
 	WRITER_XREF,
 	WRITER_JSON,
+	WRITER_BINARY,
+	WRITER_PROTOBUF,
 	WRITER_COUNT,
 } writerType;
 
@@ -42,6 +47,15 @@ struct sTagWriter {
 	   In such case the callee may do truncate output file. */
 	bool (* postWriteEntry)  (tagWriter *writer, MIO * mio, const char* filename);
 	void (* buildFqTagCache) (tagWriter *writer, tagEntryInfo *const tag);
+
+	/* If not NULL, the entries are written to a temporary file, and
+	   this is called when the tag file is closed, to make the tag file
+	   from the SIZE bytes written to ENTRIES. */
+	void (* rewriteOutput) (tagWriter *writer, MIO *entries, long size, MIO *output);
+
+	/* If not NULL, whether the fixed field FIELDTYPE (see isFieldFixed ())
+	   stays enabled whatever --fields says. Otherwise all of them do. */
+	bool (* treatFieldAsFixed) (int fieldType);
 	const char *defaultFileName;
 
 	/* The value returned from preWriteEntry is stored `private' field.
@@ -52,6 +66,10 @@ struct sTagWriter {
 };
 
 extern void setTagWriter (writerType otype);
+extern writerType getTagWriterType (void);
+/* The writer of the output format named by the LENGTH bytes of NAME,
+   or WRITER_COUNT. */
+extern writerType getNamedTagWriterType (const char *const name, size_t length);
 extern void writerSetup  (MIO *mio);
 extern bool writerTeardown (MIO *mio, const char *filename);
 
@@ -64,6 +82,11 @@ int writerWritePtag (MIO * mio,
 
 extern void writerBuildFqTagCache (tagEntryInfo *const tag);
 
+extern bool writerDoesTreatFieldAsFixed (int fieldType);
+
+extern bool writerRewritesOutput (void);
+extern void writerRewriteOutput (MIO *entries, long size, MIO *output);
+
 extern const char *outputDefaultFileName (void);
 
 extern void truncateTagLineAfterTag (char *const line, const char *const token,
@@ -73,6 +96,26 @@ extern void abort_if_ferror(MIO *const fp);
 extern bool ptagMakeJsonOutputVersion (ptagDesc *desc, void *data CTAGS_ATTR_UNUSED);
 extern bool ptagMakeCtagsOutputMode (ptagDesc *desc, void *data CTAGS_ATTR_UNUSED);
 
+/* The first bytes of a tag file written with --output-format=binary */
+#define BINARY_INDEX_MAGIC "CTAGSIDX"
+extern void dumpBinaryIndex (const char *const fileName, FILE *fp);
+
+/* Whether the SIZE bytes of DATA start like a stream written with
+   --output-format=protobuf. */
+extern bool isProtobufTagStream (const unsigned char *data, size_t size);
+/* Write JSON as a record of the stream, for interactive mode. */
+extern int writeProtobufJsonRecord (MIO *mio, const char *const json);
+/* Read the varint, or the field of a message, at *OFFSET in the SIZE
+   bytes of DATA, moving *OFFSET past it. N is set to the value of the
+   field, or to its length with BYTES pointing to its bytes; BYTES is
+   NULL for a varint field. Return false if the data is broken. */
+extern bool readProtobufVarint (const unsigned char *data, size_t size,
+								size_t *offset, uint64_t *n);
+extern bool readProtobufField (const unsigned char *data, size_t size,
+							   size_t *offset, unsigned int *field,
+							   uint64_t *n, const unsigned char **bytes);
+extern void dumpProtobufStream (const char *const fileName, FILE *fp);
+
 extern bool writerCanPrintPtag (void);
 
 #endif
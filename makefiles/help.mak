@@ -17,6 +17,8 @@ help:
 	@echo "make chop                         - Verify the behavior of parsers for broken input: randomly truncated from tail"
 	@echo "make slap                         - Verify the behavior of parsers for broken input: randomly truncated from head"
 	@echo "make roundtrip                    - Verify the behavior of readtags command"
+	@echo "make bench                        - Measure the speed of the parsers over scaled-up Units inputs"
+	@echo "make scaling                      - Verify that the parsers take time and memory linear in the size of their inputs"
 	@echo
 	@echo "Arguments that can be used in testing targets:"
 	@echo "VG=1                              - Run test cases with Valgrind memory profiler"
@@ -24,3 +26,8 @@ help:
 	@echo "CATEGORIES=<category>             - Only run tests available under folder Units/<category>.r"
 	@echo "UNITS=<case>[,<case>]             - Only run tests named Units/[category.r/]/<case>.d in units target"
 	@echo "                                                         Tmain/<case>.d in tmain target"
+	@echo "BENCH_CORPORA=<dir> [<dir>...]    - Directories of input files for bench target [Units]"
+	@echo "BENCH_OUTPUT=<file>               - Write the results of bench target to <file>"
+	@echo "BENCH_BASELINE=<file>             - Compare the results of bench target with <file>"
+	@echo "SCALING_CORPORA=<dir> [<dir>...]  - Directories of input files for scaling target [Units]"
+	@echo "SCALING_SEEDS=<n>                 - Largest input files of each language taken by scaling target [1]"
@@ -0,0 +1,2717 @@
+# -*- makefile -*-
+# Generated by misc/dist-test-cases
+EXTRA_DIST += misc/units \
+    Tmain/abnormal-output-file-names.d/input.c\
+    Tmain/abnormal-output-file-names.d/run.sh\
+    Tmain/abnormal-output-file-names.d/stderr-expected.txt\
+    Tmain/abnormal-output-file-names.d/stdout-expected.txt\
+    Tmain/alias-for-unknown-language.d/exit-expected.txt\
+    Tmain/alias-for-unknown-language.d/run.sh\
+    Tmain/alias-for-unknown-language.d/stderr-expected.txt\
+    Tmain/alias-for-unknown-language.d/stdout-expected.txt\
+    Tmain/allow-null-tag.d/exit-expected.txt\
+    Tmain/allow-null-tag.d/input.json\
+    Tmain/allow-null-tag.d/run.sh\
+    Tmain/allow-null-tag.d/stderr-expected.txt\
+    Tmain/allow-null-tag.d/stdout-expected.txt\
+    Tmain/broken-fielddef.d/run.sh\
+    Tmain/broken-fielddef.d/stdout-expected.txt\
+    Tmain/broken-tagname-quiet.d/exit-expected.txt\
+    Tmain/broken-tagname-quiet.d/input.cst\
+    Tmain/broken-tagname-quiet.d/run.sh\
+    Tmain/broken-tagname-quiet.d/stderr-expected.txt\
+    Tmain/broken-tagname-quiet.d/stdout-expected.txt\
+    Tmain/broken-tagname.d/exit-expected.txt\
+    Tmain/broken-tagname.d/input.cst\
+    Tmain/broken-tagname.d/run.sh\
+    Tmain/broken-tagname.d/stderr-expected.txt\
+    Tmain/broken-tagname.d/stdout-expected.txt\
+    Tmain/c-anon-counter.d/exit-expected.txt\
+    Tmain/c-anon-counter.d/input1.c\
+    Tmain/c-anon-counter.d/input2.c\
+    Tmain/c-anon-counter.d/run.sh\
+    Tmain/c-anon-counter.d/stderr-expected.txt\
+    Tmain/c-anon-counter.d/stdout-expected.txt\
+    Tmain/case-insensitive-pattern.d/MAKEFILE\
+    Tmain/case-insensitive-pattern.d/run.sh\
+    Tmain/case-insensitive-pattern.d/stdout-expected.txt\
+    Tmain/clear-aliases.d/exit-expected.txt\
+    Tmain/clear-aliases.d/run.sh\
+    Tmain/clear-aliases.d/stdout-expected.txt\
+    Tmain/cxx-how-kinds-defs-are-shared-or-copyed.d/run.sh\
+    Tmain/cxx-how-kinds-defs-are-shared-or-copyed.d/stdout-expected.txt\
+    Tmain/disable-fixed-field.d/exit-expected.txt\
+    Tmain/disable-fixed-field.d/run.sh\
+    Tmain/disable-fixed-field.d/stderr-expected.txt\
+    Tmain/disable-fixed-field.d/stdout-expected.txt\
+    Tmain/disable-languages.d/input-matlab.m\
+    Tmain/disable-languages.d/input-objc.m\
+    Tmain/disable-languages.d/input.m\
+    Tmain/disable-languages.d/run.sh\
+    Tmain/disable-languages.d/stderr-expected.txt\
+    Tmain/disable-languages.d/stdout-expected.txt\
+    Tmain/dot-ctags-with-indentation.d/args.ctags\
+    Tmain/dot-ctags-with-indentation.d/exit-expected.txt\
+    Tmain/dot-ctags-with-indentation.d/run.sh\
+    Tmain/dot-ctags-with-indentation.d/stderr-expected.txt\
+    Tmain/dot-ctags-with-indentation.d/stdout-expected.txt\
+    Tmain/dynamic-kinds.d/exit-expected.txt\
+    Tmain/dynamic-kinds.d/run.sh\
+    Tmain/dynamic-kinds.d/stderr-expected.txt\
+    Tmain/dynamic-kinds.d/stdout-expected.txt\
+    Tmain/emacs-modeline-downcased-mode.d/exti-expected.txt\
+    Tmain/emacs-modeline-downcased-mode.d/functions\
+    Tmain/emacs-modeline-downcased-mode.d/run.sh\
+    Tmain/emacs-modeline-downcased-mode.d/stderr-expected.txt\
+    Tmain/emacs-modeline-downcased-mode.d/stdout-expected.txt\
+    Tmain/emacs-modeline-non-alnum-in-head.d/input\
+    Tmain/emacs-modeline-non-alnum-in-head.d/run.sh\
+    Tmain/emacs-modeline-non-alnum-in-head.d/stdout-expected.txt\
+    Tmain/emacs-modeline-non-alnum-in-head2.d/input\
+    Tmain/emacs-modeline-non-alnum-in-head2.d/run.sh\
+    Tmain/emacs-modeline-non-alnum-in-head2.d/stdout-expected.txt\
+    Tmain/emacs-modeline-non-alnum-in-tail.d/input\
+    Tmain/emacs-modeline-non-alnum-in-tail.d/run.sh\
+    Tmain/emacs-modeline-non-alnum-in-tail.d/stdout-expected.txt\
+    Tmain/enable-kind-postfix-with-wildcard.d/run.sh\
+    Tmain/enable-kind-postfix-with-wildcard.d/stderr-expected.txt\
+    Tmain/enable-kind-postfix-with-wildcard.d/stdout-expected.txt\
+    Tmain/enable-kind-postfix.d/run.sh\
+    Tmain/enable-kind-postfix.d/stderr-expected.txt\
+    Tmain/enable-kind-postfix.d/stdout-expected.txt\
+    Tmain/enable-kind-prefix-with-wildcard.d/run.sh\
+    Tmain/enable-kind-prefix-with-wildcard.d/stderr-expected.txt\
+    Tmain/enable-kind-prefix-with-wildcard.d/stdout-expected.txt\
+    Tmain/enable-kind-prefix.d/run.sh\
+    Tmain/enable-kind-prefix.d/stderr-expected.txt\
+    Tmain/enable-kind-prefix.d/stdout-expected.txt\
+    Tmain/enable-non-existing-kind.d/run.sh\
+    Tmain/enable-non-existing-kind.d/stderr-expected.txt\
+    Tmain/errors-about-parser-own-extras.d/run.sh\
+    Tmain/errors-about-parser-own-extras.d/stderr-expected.txt\
+    Tmain/extension-vs-pattern.d/exit-expected.txt\
+    Tmain/extension-vs-pattern.d/input.xxx\
+    Tmain/extension-vs-pattern.d/run.sh\
+    Tmain/extension-vs-pattern.d/stderr-expected.txt\
+    Tmain/extension-vs-pattern.d/stdout-expected.txt\
+    Tmain/extra-field.d/exit-expected.txt\
+    Tmain/extra-field.d/input.cpp\
+    Tmain/extra-field.d/run.sh\
+    Tmain/extra-field.d/stderr-expected.txt\
+    Tmain/extra-field.d/stdout-expected.txt\
+    Tmain/extras-long.d/run.sh\
+    Tmain/extras-long.d/stdout-expected.txt\
+    Tmain/filter-option-write-to-file.d/input.c\
+    Tmain/filter-option-write-to-file.d/run.sh\
+    Tmain/filter-option-write-to-file.d/stderr-expected.txt\
+    Tmain/filter-option-write-to-file.d/stdout-expected.txt\
+    Tmain/filter-option.d/input.c\
+    Tmain/filter-option.d/run.sh\
+    Tmain/filter-option.d/stdout-expected.txt\
+    Tmain/force-initializing-option.d/README\
+    Tmain/force-initializing-option.d/run.sh\
+    Tmain/force-initializing-option.d/stderr-expected.txt\
+    Tmain/force-initializing-option.d/xit-expected.txt\
+    Tmain/gcov-sandbox.d/exit-expected.txt\
+    Tmain/gcov-sandbox.d/run.sh\
+    Tmain/gcov-sandbox.d/stderr-expected.txt\
+    Tmain/gcov-sandbox.d/stdout-expected.txt\
+    Tmain/generate-anon-ids.d/input0.c\
+    Tmain/generate-anon-ids.d/input1.c\
+    Tmain/generate-anon-ids.d/run.sh\
+    Tmain/generate-anon-ids.d/stdout-expected.txt\
+    Tmain/input-encoding-option.d/exit-expected.txt\
+    Tmain/input-encoding-option.d/input.java\
+    Tmain/input-encoding-option.d/input.js\
+    Tmain/input-encoding-option.d/run.sh\
+    Tmain/input-encoding-option.d/stderr-expected.txt\
+    Tmain/input-encoding-option.d/stdout-expected.txt\
+    Tmain/input-encoding-option.d/tags-expected.txt\
+    Tmain/interactive-mode.d/run.sh\
+    Tmain/interactive-mode.d/stdout-expected.txt\
+    Tmain/interactive-mode.d/test.c\
+    Tmain/interactive-mode.d/test.rb\
+    Tmain/interactive-option-write-to-file.d/run.sh\
+    Tmain/interactive-option-write-to-file.d/stderr-expected.txt\
+    Tmain/interactive-option-write-to-file.d/stdout-expected.txt\
+    Tmain/interactive-option-write-to-file.d/test.rb\
+    Tmain/interactive-resource-management.d/input.c\
+    Tmain/interactive-resource-management.d/run.sh\
+    Tmain/interactive-resource-management.d/stdout-expected.txt\
+    Tmain/invalid-encoding-option.d/exit-expected.txt\
+    Tmain/invalid-encoding-option.d/input.java\
+    Tmain/invalid-encoding-option.d/input.js\
+    Tmain/invalid-encoding-option.d/run.sh\
+    Tmain/invalid-encoding-option.d/stderr-expected.txt\
+    Tmain/invalid-encoding-option.d/stdout-expected.txt\
+    Tmain/json-output-format.d/input.1\
+    Tmain/json-output-format.d/input.c\
+    Tmain/json-output-format.d/input.go\
+    Tmain/json-output-format.d/input.py\
+    Tmain/json-output-format.d/run.sh\
+    Tmain/json-output-format.d/stdout-expected.txt\
+    Tmain/json-output-to-file.d/input.c\
+    Tmain/json-output-to-file.d/run.sh\
+    Tmain/json-output-to-file.d/stdout-expected.txt\
+    Tmain/json-ptag-in-list-extras.d/run.sh\
+    Tmain/json-ptag-in-list-extras.d/stderr-expected.txt\
+    Tmain/json-ptag-in-list-extras.d/stdout-expected.txt\
+    Tmain/kind-abnormal-spec.d/input.x\
+    Tmain/kind-abnormal-spec.d/run.sh\
+    Tmain/kind-abnormal-spec.d/stderr-expected.txt\
+    Tmain/kind-abnormal-spec.d/stdout-expected.txt\
+    Tmain/kind-and-role-defaults.d/input.cst\
+    Tmain/kind-and-role-defaults.d/run.sh\
+    Tmain/kind-and-role-defaults.d/stdout-expected.txt\
+    Tmain/kind-long-lregex.d/run.sh\
+    Tmain/kind-long-lregex.d/stdout-expected.txt\
+    Tmain/kind-long.d/run.sh\
+    Tmain/kind-long.d/stdout-expected.txt\
+    Tmain/kinddef.d/dictfile\
+    Tmain/kinddef.d/run.sh\
+    Tmain/kinddef.d/stdout-expected.txt\
+    Tmain/langmap-option-including-patterns.d/exit-expected.txt\
+    Tmain/langmap-option-including-patterns.d/run.sh\
+    Tmain/langmap-option-including-patterns.d/stderr-expected.txt\
+    Tmain/langmap-option-including-patterns.d/stdout-expected.txt\
+    Tmain/langmap-option.d/exit-expected.txt\
+    Tmain/langmap-option.d/run.sh\
+    Tmain/langmap-option.d/stderr-expected.txt\
+    Tmain/langmap-option.d/stdout-expected.txt\
+    Tmain/languages-and-language-force-options.d/exit-expected.txt\
+    Tmain/languages-and-language-force-options.d/input.c\
+    Tmain/languages-and-language-force-options.d/run.sh\
+    Tmain/languages-and-language-force-options.d/stderr-expected.txt\
+    Tmain/list-aliases.d/run.sh\
+    Tmain/list-aliases.d/stdout-expected.txt\
+    Tmain/list-extras.d/exit-expected.txt\
+    Tmain/list-extras.d/run.sh\
+    Tmain/list-extras.d/stderr-expected.txt\
+    Tmain/list-extras.d/stdout-expected.txt\
+    Tmain/list-fields-with-prefix.d/dictfile\
+    Tmain/list-fields-with-prefix.d/run.sh\
+    Tmain/list-fields-with-prefix.d/stdout-expected.txt\
+    Tmain/list-fields.d/exit-expected.txt\
+    Tmain/list-fields.d/input.c\
+    Tmain/list-fields.d/input.java\
+    Tmain/list-fields.d/input.sh\
+    Tmain/list-fields.d/run.sh\
+    Tmain/list-fields.d/stderr-expected.txt\
+    Tmain/list-fields.d/stdout-expected.txt\
+    Tmain/list-kinds-full.d/exit-expected.txt\
+    Tmain/list-kinds-full.d/run.sh\
+    Tmain/list-kinds-full.d/stderr-expected.txt\
+    Tmain/list-kinds-full.d/stdout-expected.txt\
+    Tmain/list-language-fields.d/run.sh\
+    Tmain/list-language-fields.d/stdout-expected.txt\
+    Tmain/list-map-extensions.d/run.sh\
+    Tmain/list-map-extensions.d/stdout-expected.txt\
+    Tmain/list-map-patterns.d/run.sh\
+    Tmain/list-map-patterns.d/stdout-expected.txt\
+    Tmain/list-mline-regex-flags.d/run.sh\
+    Tmain/list-mline-regex-flags.d/stdout-expected.txt\
+    Tmain/list-params.d/run.sh\
+    Tmain/list-params.d/stderr-expected.txt\
+    Tmain/list-params.d/stdout-expected.txt\
+    Tmain/list-pseudo-tags.d/exit-expected.txt\
+    Tmain/list-pseudo-tags.d/run.sh\
+    Tmain/list-pseudo-tags.d/stderr-expected.txt\
+    Tmain/list-pseudo-tags.d/stdout-expected.txt\
+    Tmain/list-regex-flags.d/run.sh\
+    Tmain/list-regex-flags.d/stdout-expected.txt\
+    Tmain/list-roles-with-kind-names.d/run.sh\
+    Tmain/list-roles-with-kind-names.d/stdout-expected.txt\
+    Tmain/list-roles.d/dictfile\
+    Tmain/list-roles.d/exit-expected.txt\
+    Tmain/list-roles.d/run.sh\
+    Tmain/list-roles.d/stderr-expected.txt\
+    Tmain/list-roles.d/stdout-expected.txt\
+    Tmain/list-subparsers-all.d/run.sh\
+    Tmain/list-subparsers-all.d/stdout-expected.txt\
+    Tmain/load-conf-files-under-cwd-no-dot.d/ctags.d/a.ctags\
+    Tmain/load-conf-files-under-cwd-no-dot.d/ctags.d/b.ctags\
+    Tmain/load-conf-files-under-cwd-no-dot.d/ctags.d/c.ctags\
+    Tmain/load-conf-files-under-cwd-no-dot.d/exit-expected.txt\
+    Tmain/load-conf-files-under-cwd-no-dot.d/run.sh\
+    Tmain/load-conf-files-under-cwd-no-dot.d/stderr-expected.txt\
+    Tmain/load-conf-files-under-cwd-no-dot.d/stdout-expected.txt\
+    Tmain/load-conf-files-under-cwd.d/.ctags.d/a.ctags\
+    Tmain/load-conf-files-under-cwd.d/.ctags.d/b.ctags\
+    Tmain/load-conf-files-under-cwd.d/.ctags.d/c.ctags\
+    Tmain/load-conf-files-under-cwd.d/exit-expected.txt\
+    Tmain/load-conf-files-under-cwd.d/run.sh\
+    Tmain/load-conf-files-under-cwd.d/stderr-expected.txt\
+    Tmain/load-conf-files-under-cwd.d/stdout-expected.txt\
+    Tmain/load-conf-files-under-home.d/exit-expected.txt\
+    Tmain/load-conf-files-under-home.d/myhome/.ctags.d/a.ctags\
+    Tmain/load-conf-files-under-home.d/myhome/.ctags.d/b.ctags\
+    Tmain/load-conf-files-under-home.d/myhome/.ctags.d/c.ctags\
+    Tmain/load-conf-files-under-home.d/run.sh\
+    Tmain/load-conf-files-under-home.d/stderr-expected.txt\
+    Tmain/load-conf-files-under-home.d/stdout-expected.txt\
+    Tmain/load-dot-ctags-twice.d/dot.ctags\
+    Tmain/load-dot-ctags-twice.d/exit-expected.txt\
+    Tmain/load-dot-ctags-twice.d/run.sh\
+    Tmain/load-dot-ctags-twice.d/stderr-expected.txt\
+    Tmain/load-dot-ctags-twice.d/stdout-expected.txt\
+    Tmain/lregex-clear-patterns.d/input.c\
+    Tmain/lregex-clear-patterns.d/mylang.ctags\
+    Tmain/lregex-clear-patterns.d/run.sh\
+    Tmain/lregex-clear-patterns.d/stderr-expected.txt\
+    Tmain/lregex-clear-patterns.d/stdout-expected.txt\
+    Tmain/lregex-list-kinds-full.d/exit-expected.txt\
+    Tmain/lregex-list-kinds-full.d/run.sh\
+    Tmain/lregex-list-kinds-full.d/stderr-expected.txt\
+    Tmain/lregex-list-kinds-full.d/stdout-expected.txt\
+    Tmain/lregex-list-kinds-uniquely.d/run.sh\
+    Tmain/lregex-list-kinds-uniquely.d/stdout-expected.txt\
+    Tmain/lregex-list-kinds.d/exit-expected.txt\
+    Tmain/lregex-list-kinds.d/run.sh\
+    Tmain/lregex-list-kinds.d/stderr-expected.txt\
+    Tmain/lregex-list-kinds.d/stdout-expected.txt\
+    Tmain/lregex-reject-reserved-kind.d/exit-expected.txt\
+    Tmain/lregex-reject-reserved-kind.d/run.sh\
+    Tmain/lregex-reject-reserved-kind.d/stderr-expected.txt\
+    Tmain/lregex-reject-reserved-kind.d/stdout-expected.txt\
+    Tmain/map-for-unknown-language.d/exit-expected.txt\
+    Tmain/map-for-unknown-language.d/run.sh\
+    Tmain/map-for-unknown-language.d/stderr-expected.txt\
+    Tmain/map-for-unknown-language.d/stdout-expected.txt\
+    Tmain/map-lang-option.d/exit-expected.txt\
+    Tmain/map-lang-option.d/run.sh\
+    Tmain/map-lang-option.d/stderr-expected.txt\
+    Tmain/map-lang-option.d/stdout-expected.txt\
+    Tmain/map-removing.d/ada.m\
+    Tmain/map-removing.d/exit-expected.txt\
+    Tmain/map-removing.d/matlab.m\
+    Tmain/map-removing.d/objc.m\
+    Tmain/map-removing.d/run.sh\
+    Tmain/map-removing.d/stderr-expected.txt\
+    Tmain/map-removing.d/stdout-expected.txt\
+    Tmain/maxdepth.d/run.sh\
+    Tmain/maxdepth.d/src/a.c\
+    Tmain/maxdepth.d/src/subdir/b.c\
+    Tmain/maxdepth.d/stdout-expected.txt\
+    Tmain/nameless-long-option.d/exit-expected.txt\
+    Tmain/nameless-long-option.d/run.sh\
+    Tmain/nameless-long-option.d/stderr-expected.txt\
+    Tmain/nameless-long-option.d/stdout-expected.txt\
+    Tmain/nested-mio.d/exit-expected.txt\
+    Tmain/nested-mio.d/input.cst\
+    Tmain/nested-mio.d/run.sh\
+    Tmain/nested-mio.d/stdout-expected.txt\
+    Tmain/nested-subparsers-multilines.d/event.ctags\
+    Tmain/nested-subparsers-multilines.d/hook.ctags\
+    Tmain/nested-subparsers-multilines.d/input.c\
+    Tmain/nested-subparsers-multilines.d/run.sh\
+    Tmain/nested-subparsers-multilines.d/stdout-expected.txt\
+    Tmain/nested-subparsers.d/dictfile\
+    Tmain/nested-subparsers.d/event.ctags\
+    Tmain/nested-subparsers.d/hook.ctags\
+    Tmain/nested-subparsers.d/input.c\
+    Tmain/nested-subparsers.d/plugin.ctags\
+    Tmain/nested-subparsers.d/run.sh\
+    Tmain/nested-subparsers.d/stdout-expected.txt\
+    Tmain/nested-subparsers.d/unused-attr.ctags\
+    Tmain/no-input-encoding-option.d/exit-expected.txt\
+    Tmain/no-input-encoding-option.d/input.java\
+    Tmain/no-input-encoding-option.d/input.js\
+    Tmain/no-input-encoding-option.d/run.sh\
+    Tmain/no-input-encoding-option.d/stderr-expected.txt\
+    Tmain/no-input-encoding-option.d/stdout-expected.txt\
+    Tmain/null-description-in-pseudo-tag.d/exit-expected.txt\
+    Tmain/null-description-in-pseudo-tag.d/run.sh\
+    Tmain/null-description-in-pseudo-tag.d/stdout-expected.txt\
+    Tmain/omit-long-patterns-etags.d/input.sh\
+    Tmain/omit-long-patterns-etags.d/run.sh\
+    Tmain/omit-long-patterns-etags.d/stderr-expected.txt\
+    Tmain/omit-long-patterns-etags.d/stdout-expected.txt\
+    Tmain/omit-long-patterns.d/gen.sh\
+    Tmain/omit-long-patterns.d/input.sh\
+    Tmain/omit-long-patterns.d/run.sh\
+    Tmain/omit-long-patterns.d/stdout-expected.txt\
+    Tmain/option-dump-keywords.d/run.sh\
+    Tmain/option-dump-keywords.d/stdout-expected.txt\
+    Tmain/option-dump-options.d/run.sh\
+    Tmain/option-dump-options.d/stdout-expected.txt\
+    Tmain/option-echo-and-force-quit.d/exit-expected.txt\
+    Tmain/option-echo-and-force-quit.d/run.sh\
+    Tmain/option-echo-and-force-quit.d/stderr-expected.txt\
+    Tmain/option-echo-and-force-quit.d/stdout-expected.txt\
+    Tmain/option-extras-enabling-all.d/exit-expected.txt\
+    Tmain/option-extras-enabling-all.d/run.sh\
+    Tmain/option-extras-enabling-all.d/stderr-expected.txt\
+    Tmain/option-extras-enabling-all.d/stdout-expected.txt\
+    Tmain/options-directory.d/exit-expected.txt\
+    Tmain/options-directory.d/optlib/a.ctags\
+    Tmain/options-directory.d/optlib/b.ctags\
+    Tmain/options-directory.d/optlib/c.ctags\
+    Tmain/options-directory.d/run.sh\
+    Tmain/options-directory.d/stderr-expected.txt\
+    Tmain/options-maybe.d/exit-expected.txt\
+    Tmain/options-maybe.d/input-maybe.c\
+    Tmain/options-maybe.d/input.c\
+    Tmain/options-maybe.d/run.sh\
+    Tmain/options-maybe.d/stderr-expected.txt\
+    Tmain/options-maybe.d/stdout-expected.txt\
+    Tmain/optlib-dir-option.d/optlib/a.ctags\
+    Tmain/optlib-dir-option.d/optlib/b.ctags\
+    Tmain/optlib-dir-option.d/optlib/c.ctags\
+    Tmain/optlib-dir-option.d/run.sh\
+    Tmain/optlib-dir-option.d/stderr-expected.txt\
+    Tmain/output-encoding-option.d/exit-expected.txt\
+    Tmain/output-encoding-option.d/input.java\
+    Tmain/output-encoding-option.d/input.js\
+    Tmain/output-encoding-option.d/run.sh\
+    Tmain/output-encoding-option.d/stderr-expected.txt\
+    Tmain/output-encoding-option.d/stdout-expected.txt\
+    Tmain/output-encoding-option.d/tags-expected.txt\
+    Tmain/output-file-resource-management.d/input.c\
+    Tmain/output-file-resource-management.d/run.sh\
+    Tmain/output-file-resource-management.d/stdout-expected.txt\
+    Tmain/output-format-option.d/input.c\
+    Tmain/output-format-option.d/run.sh\
+    Tmain/output-format-option.d/stdout-expected.txt\
+    Tmain/output-input-field-with-no-escape.d/run.sh\
+    Tmain/output-input-field-with-no-escape.d/stdout-expected.txt\
+    Tmain/parser-own-extras.d/run.sh\
+    Tmain/parser-own-extras.d/stdout-expected.txt\
+    Tmain/parser-own-fields-clearing-all.d/run.sh\
+    Tmain/parser-own-fields-clearing-all.d/stdout-expected.txt\
+    Tmain/parser-own-fields.d/input.unknown\
+    Tmain/parser-own-fields.d/run.sh\
+    Tmain/parser-own-fields.d/stdout-expected.txt\
+    Tmain/parser-own-fields.d/unknown.ctags\
+    Tmain/pattern-length-limit.d/input.java\
+    Tmain/pattern-length-limit.d/run.sh\
+    Tmain/pattern-length-limit.d/stdout-expected.txt\
+    Tmain/ptag-kind-desc.d/input.foo\
+    Tmain/ptag-kind-desc.d/input.sh\
+    Tmain/ptag-kind-desc.d/run.sh\
+    Tmain/ptag-kind-desc.d/stdout-expected.txt\
+    Tmain/readtags-qualifier-end-field.d/exit-expected.txt\
+    Tmain/readtags-qualifier-end-field.d/output.tags\
+    Tmain/readtags-qualifier-end-field.d/run.sh\
+    Tmain/readtags-qualifier-end-field.d/stderr-expected.txt\
+    Tmain/readtags-qualifier-end-field.d/stdout-expected.txt\
+    Tmain/readtags-qualifier.d/base.py\
+    Tmain/readtags-qualifier.d/exit-expected.txt\
+    Tmain/readtags-qualifier.d/output.tags\
+    Tmain/readtags-qualifier.d/run.sh\
+    Tmain/readtags-qualifier.d/stderr-expected.txt\
+    Tmain/readtags-qualifier.d/stdout-expected.txt\
+    Tmain/regex-for-unknown-language.d/exit-expected.txt\
+    Tmain/regex-for-unknown-language.d/run.sh\
+    Tmain/regex-for-unknown-language.d/stderr-expected.txt\
+    Tmain/regex-for-unknown-language.d/stdout-expected.txt\
+    Tmain/regex-patterns-from-file.d/input.c\
+    Tmain/regex-patterns-from-file.d/list.regex\
+    Tmain/regex-patterns-from-file.d/run.sh\
+    Tmain/regex-patterns-from-file.d/stderr-expected.txt\
+    Tmain/regex-patterns-from-file.d/stdout-expected.txt\
+    Tmain/sandbox-crash.d/exit-expected.txt\
+    Tmain/sandbox-crash.d/run.sh\
+    Tmain/sandbox-crash.d/stdout-expected.txt\
+    Tmain/sandbox-default-req.d/exit-expected.txt\
+    Tmain/sandbox-default-req.d/input.c\
+    Tmain/sandbox-default-req.d/run.sh\
+    Tmain/sandbox-default-req.d/stderr-expected.txt\
+    Tmain/sandbox-default-req.d/stdout-expected.txt\
+    Tmain/sandbox-no-eager-guessing.d/exit-expected.txt\
+    Tmain/sandbox-no-eager-guessing.d/run.sh\
+    Tmain/sandbox-no-eager-guessing.d/stderr-expected.txt\
+    Tmain/sandbox-no-eager-guessing.d/stdout-expected.txt\
+    Tmain/sandbox-unknown-submode.d/exit-expected.txt\
+    Tmain/sandbox-unknown-submode.d/run.sh\
+    Tmain/sandbox-unknown-submode.d/stderr-expected.txt\
+    Tmain/sandbox-unknown-submode.d/stdout-expected.txt\
+    Tmain/sandbox-with-eager-guessing.d/exit-expected.txt\
+    Tmain/sandbox-with-eager-guessing.d/run.sh\
+    Tmain/sandbox-with-eager-guessing.d/stderr-expected.txt\
+    Tmain/sandbox-with-eager-guessing.d/stdout-expected.txt\
+    Tmain/sandbox.d/exit-expected.txt\
+    Tmain/sandbox.d/run.sh\
+    Tmain/sandbox.d/stderr-expected.txt\
+    Tmain/sandbox.d/stdout-expected.txt\
+    Tmain/selector-dont-select-disabled-lang.d/exit-expected.txt\
+    Tmain/selector-dont-select-disabled-lang.d/input.h\
+    Tmain/selector-dont-select-disabled-lang.d/run.sh\
+    Tmain/selector-dont-select-disabled-lang.d/stderr-expected.txt\
+    Tmain/selector-dont-select-disabled-lang.d/stdout-expected.txt\
+    Tmain/sorted-help-message.d/exit-expected.txt\
+    Tmain/sorted-help-message.d/run.sh\
+    Tmain/sorted-help-message.d/stderr-expected.txt\
+    Tmain/sorted-help-message.d/stdout-expected.txt\
+    Tmain/sorted-list-languages.d/exit-expected.txt\
+    Tmain/sorted-list-languages.d/run.sh\
+    Tmain/sorted-list-languages.d/stderr-expected.txt\
+    Tmain/sorted-list-languages.d/stdout-expected.txt\
+    Tmain/subparser-direction.d/input.cc\
+    Tmain/subparser-direction.d/input.mojom\
+    Tmain/subparser-direction.d/mojom-bidirectional.ctags\
+    Tmain/subparser-direction.d/mojom-dedicated.ctags\
+    Tmain/subparser-direction.d/mojom-default.ctags\
+    Tmain/subparser-direction.d/mojom-shared.ctags\
+    Tmain/subparser-direction.d/run.sh\
+    Tmain/subparser-direction.d/stdout-expected.txt\
+    Tmain/tag-relative-option-in-etags.d/indirect/src/input.c\
+    Tmain/tag-relative-option-in-etags.d/run.sh\
+    Tmain/tag-relative-option-in-etags.d/stdout-expected.txt\
+    Tmain/tag-relative-option.d/input.c\
+    Tmain/tag-relative-option.d/run.sh\
+    Tmain/tag-relative-option.d/stdout-expected.txt\
+    Tmain/tags-pseudo-tags.d/exit-expected.txt\
+    Tmain/tags-pseudo-tags.d/input.php\
+    Tmain/tags-pseudo-tags.d/run.sh\
+    Tmain/tags-pseudo-tags.d/stderr-expected.txt\
+    Tmain/tags-pseudo-tags.d/stdout-expected.txt\
+    Tmain/tmain-example.d/exit-expected.txt\
+    Tmain/tmain-example.d/run.sh\
+    Tmain/tmain-example.d/stderr-expected.txt\
+    Tmain/tmain-example.d/stdout-expected.txt\
+    Tmain/tmain-example.d/tags-expected.txt\
+    Tmain/tmain-skip-example.d/run.sh\
+    Tmain/tmain-skip-example.d/stdout-expected.txt\
+    Tmain/two-inputs-requiring-scope-stack.d/a.dts\
+    Tmain/two-inputs-requiring-scope-stack.d/b.dts\
+    Tmain/utils.sh\
+    Tmain/warn-reusing-kind-letter.d/run.sh\
+    Tmain/warn-reusing-kind-letter.d/stdout-expected.txt\
+    Tmain/wildcard-in-lang-of-fields-option.d/run.sh\
+    Tmain/wildcard-in-lang-of-fields-option.d/stdout-expected.txt\
+    Tmain/wrong-parser-name-in-field.d/exit-expected.txt\
+    Tmain/wrong-parser-name-in-field.d/run.sh\
+    Tmain/wrong-parser-name-in-field.d/stderr-expected.txt\
+    Tmain/xformat-and-parser-own-field.d/input.rst\
+    Tmain/xformat-and-parser-own-field.d/run.sh\
+    Tmain/xformat-and-parser-own-field.d/stderr-expected.txt\
+    Tmain/xformat-and-parser-own-field.d/stdout-expected.txt\
+    Tmain/xformat-common-fields.d/input.py\
+    Tmain/xformat-common-fields.d/run.sh\
+    Tmain/xformat-common-fields.d/stdout-expected.txt\
+    Tmain/xref-output-to-file.d/input.c\
+    Tmain/xref-output-to-file.d/run.sh\
+    Tmain/xref-output-to-file.d/stdout-expected.txt\
+    Tmain/xref-ptag-in-list-extras.d/run.sh\
+    Tmain/xref-ptag-in-list-extras.d/stdout-expected.txt\
+    Units/afl-fuzz.r/github-issue-528-sml.d/expected.tags\
+    Units/afl-fuzz.r/github-issue-528-sml.d/input.sml\
+    Units/afl-fuzz.r/github-issue-529-bas.d/input.bas\
+    Units/afl-fuzz.r/github-issue-530-css.d/input.css\
+    Units/afl-fuzz.r/github-issue-531-make.d/input.mk\
+    Units/afl-fuzz.r/github-issue-532-vim.d/input.vim\
+    Units/afl-fuzz.r/github-issue-536-flex.d/input.as\
+    Units/afl-fuzz.r/github-issue-537-beta.d/input.bet\
+    Units/afl-fuzz.r/github-issue-538-sql.d/input.sql\
+    Units/afl-fuzz.r/github-issue-539-js.d/input.js\
+    Units/afl-fuzz.r/github-issue-540-fortran.d/input.f\
+    Units/afl-fuzz.r/github-issue-541-json.d/input.json\
+    Units/afl-fuzz.r/github-issue-542-vhdl.d/input.vhdl\
+    Units/afl-fuzz.r/github-issue-543-eiffel.d/input.e\
+    Units/afl-fuzz.r/github-issue-625-r.d/input.r\
+    Units/afl-fuzz.r/github-issue-627-perl.d/input.pl\
+    Units/afl-fuzz.r/github-issue-628-vera.d/input.vr\
+    Units/conflib-recursive.d/args.ctags\
+    Units/conflib-recursive.d/expected.tags\
+    Units/conflib-recursive.d/features\
+    Units/conflib-recursive.d/input.cof\
+    Units/conflib-recursive.d/optlib/lang/a.ctags\
+    Units/conflib-recursive.d/optlib/lang/b.ctags\
+    Units/conflib-recursive.d/optlib/lang/c.ctags\
+    Units/conflib-recursive.d/optlib/lang/d.ctags\
+    Units/conflib-recursive.d/optlib/lang/e.ctags\
+    Units/conflib-simple.d/args.ctags\
+    Units/conflib-simple.d/expected.tags\
+    Units/conflib-simple.d/features\
+    Units/conflib-simple.d/input.coffee\
+    Units/conflib-simple.d/optlib/coffee.ctags\
+    Units/cork-etags.d/expected.tags-e\
+    Units/cork-etags.d/input.clj\
+    Units/cork-xref.d/expected.tags-x\
+    Units/cork-xref.d/input.clj\
+    Units/csharp-review-needed.r/array_ref_and_out.cs.t/expected.tags\
+    Units/csharp-review-needed.r/array_ref_and_out.cs.t/input.cs\
+    Units/csharp-review-needed.r/attributes.cs.t/expected.tags\
+    Units/csharp-review-needed.r/attributes.cs.t/input.cs\
+    Units/csharp-review-needed.r/bug1515910.cs.t/expected.tags\
+    Units/csharp-review-needed.r/bug1515910.cs.t/input.cs\
+    Units/csharp-review-needed.r/bug1611054.cs.t/expected.tags\
+    Units/csharp-review-needed.r/bug1611054.cs.t/input.cs\
+    Units/csharp-review-needed.r/bug1800065.cs.t/expected.tags\
+    Units/csharp-review-needed.r/bug1800065.cs.t/input.cs\
+    Units/csharp-review-needed.r/bug1830343.cs.t/expected.tags\
+    Units/csharp-review-needed.r/bug1830343.cs.t/input.cs\
+    Units/csharp-review-needed.r/bug1830344.cs.t/expected.tags\
+    Units/csharp-review-needed.r/bug1830344.cs.t/input.cs\
+    Units/csharp-review-needed.r/bug2411878.cs.t/expected.tags\
+    Units/csharp-review-needed.r/bug2411878.cs.t/input.cs\
+    Units/csharp-review-needed.r/events.cs.t/expected.tags\
+    Units/csharp-review-needed.r/events.cs.t/input.cs\
+    Units/csharp-review-needed.r/general.cs.t/expected.tags\
+    Units/csharp-review-needed.r/general.cs.t/input.cs\
+    Units/csharp-review-needed.r/indexer.cs.t/expected.tags\
+    Units/csharp-review-needed.r/indexer.cs.t/input.cs\
+    Units/csharp-review-needed.r/interface_indexers.cs.t/expected.tags\
+    Units/csharp-review-needed.r/interface_indexers.cs.t/input.cs\
+    Units/csharp-review-needed.r/interface_properties.cs.t/expected.tags\
+    Units/csharp-review-needed.r/interface_properties.cs.t/input.cs\
+    Units/csharp-review-needed.r/internal.cs.t/expected.tags\
+    Units/csharp-review-needed.r/internal.cs.t/input.cs\
+    Units/csharp-review-needed.r/keyword_abstract.cs.t/expected.tags\
+    Units/csharp-review-needed.r/keyword_abstract.cs.t/input.cs\
+    Units/csharp-review-needed.r/keyword_catch_try.cs.t/expected.tags\
+    Units/csharp-review-needed.r/keyword_catch_try.cs.t/input.cs\
+    Units/csharp-review-needed.r/keyword_class.cs.t/expected.tags\
+    Units/csharp-review-needed.r/keyword_class.cs.t/input.cs\
+    Units/csharp-review-needed.r/keyword_const.cs.t/expected.tags\
+    Units/csharp-review-needed.r/keyword_const.cs.t/input.cs\
+    Units/csharp-review-needed.r/keyword_delegate.cs.t/expected.tags\
+    Units/csharp-review-needed.r/keyword_delegate.cs.t/input.cs\
+    Units/csharp-review-needed.r/keyword_enum.cs.t/expected.tags\
+    Units/csharp-review-needed.r/keyword_enum.cs.t/input.cs\
+    Units/csharp-review-needed.r/keyword_event.cs.t/expected.tags\
+    Units/csharp-review-needed.r/keyword_event.cs.t/input.cs\
+    Units/csharp-review-needed.r/keyword_explicit.cs.t/expected.tags\
+    Units/csharp-review-needed.r/keyword_explicit.cs.t/input.cs\
+    Units/csharp-review-needed.r/keyword_extern.cs.t/expected.tags\
+    Units/csharp-review-needed.r/keyword_extern.cs.t/input.cs\
+    Units/csharp-review-needed.r/keyword_implicit.cs.t/expected.tags\
+    Units/csharp-review-needed.r/keyword_implicit.cs.t/input.cs\
+    Units/csharp-review-needed.r/keyword_interface.cs.t/expected.tags\
+    Units/csharp-review-needed.r/keyword_interface.cs.t/input.cs\
+    Units/csharp-review-needed.r/keyword_namespace.cs.t/expected.tags\
+    Units/csharp-review-needed.r/keyword_namespace.cs.t/input.cs\
+    Units/csharp-review-needed.r/keyword_out.cs.t/expected.tags\
+    Units/csharp-review-needed.r/keyword_out.cs.t/input.cs\
+    Units/csharp-review-needed.r/keyword_override.cs.t/expected.tags\
+    Units/csharp-review-needed.r/keyword_override.cs.t/input.cs\
+    Units/csharp-review-needed.r/keyword_params.cs.t/expected.tags\
+    Units/csharp-review-needed.r/keyword_params.cs.t/input.cs\
+    Units/csharp-review-needed.r/keyword_private.cs.t/expected.tags\
+    Units/csharp-review-needed.r/keyword_private.cs.t/input.cs\
+    Units/csharp-review-needed.r/keyword_protected.cs.t/expected.tags\
+    Units/csharp-review-needed.r/keyword_protected.cs.t/input.cs\
+    Units/csharp-review-needed.r/keyword_public.cs.t/expected.tags\
+    Units/csharp-review-needed.r/keyword_public.cs.t/input.cs\
+    Units/csharp-review-needed.r/keyword_sealed.cs.t/expected.tags\
+    Units/csharp-review-needed.r/keyword_sealed.cs.t/input.cs\
+    Units/csharp-review-needed.r/keyword_static.cs.t/expected.tags\
+    Units/csharp-review-needed.r/keyword_static.cs.t/input.cs\
+    Units/csharp-review-needed.r/keyword_struct.cs.t/expected.tags\
+    Units/csharp-review-needed.r/keyword_struct.cs.t/input.cs\
+    Units/csharp-review-needed.r/keyword_virtual.cs.t/expected.tags\
+    Units/csharp-review-needed.r/keyword_virtual.cs.t/input.cs\
+    Units/csharp-review-needed.r/keyword_volatile.cs.t/expected.tags\
+    Units/csharp-review-needed.r/keyword_volatile.cs.t/input.cs\
+    Units/csharp-review-needed.r/property.cs.t/expected.tags\
+    Units/csharp-review-needed.r/property.cs.t/input.cs\
+    Units/dotted-names.d/expected.tags\
+    Units/dotted-names.d/input.json\
+    Units/extension-with-template-suffix.d/expected.tags\
+    Units/extension-with-template-suffix.d/input.c.in\
+    Units/extra-file-scope-option.d/args.ctags\
+    Units/extra-file-scope-option.d/expected.tags\
+    Units/extra-file-scope-option.d/input.c\
+    Units/extra-subword.d/args.ctags\
+    Units/extra-subword.d/expected.tags-x\
+    Units/extra-subword.d/input.c\
+    Units/extra-total-lines.d/args.ctags\
+    Units/extra-total-lines.d/expected.tags\
+    Units/extra-total-lines.d/foo.h\
+    Units/extra-total-lines.d/input.c\
+    Units/fq-json.d/args.ctags\
+    Units/fq-json.d/expected.tags-json\
+    Units/fq-json.d/input.py\
+    Units/fq-xref.d/args.ctags\
+    Units/fq-xref.d/expected.tags-x\
+    Units/fq-xref.d/input.py\
+    Units/fuzz-hitting-assertions.r/README\
+    Units/fuzz-hitting-assertions.r/csharp-fha-0.d/expected.tags\
+    Units/fuzz-hitting-assertions.r/csharp-fha-0.d/input.cs\
+    Units/fuzz-hitting-assertions.r/d-fha-0.d/README\
+    Units/fuzz-hitting-assertions.r/d-fha-0.d/expected.tags\
+    Units/fuzz-hitting-assertions.r/d-fha-0.d/input.d\
+    Units/fuzz-hitting-assertions.r/eiffel-fha-0.d/expected.tags\
+    Units/fuzz-hitting-assertions.r/eiffel-fha-0.d/input.e\
+    Units/fuzz-hitting-assertions.r/java-fha-0.d/expected.tags\
+    Units/fuzz-hitting-assertions.r/java-fha-0.d/input.java\
+    Units/fuzz-hitting-assertions.r/systemverilog-fha-0.d/expected.tags\
+    Units/fuzz-hitting-assertions.r/systemverilog-fha-0.d/input.sv\
+    Units/fuzz-hitting-assertions.r/vera-fha-0.d/expected.tags\
+    Units/fuzz-hitting-assertions.r/vera-fha-0.d/input.vr\
+    Units/fuzz-hitting-assertions.r/verilog-fha-0.d/expected.tags\
+    Units/fuzz-hitting-assertions.r/verilog-fha-0.d/input.v\
+    Units/java-review-needed.r/bug1447756.java.t/expected.tags\
+    Units/java-review-needed.r/bug1447756.java.t/input.java\
+    Units/java-review-needed.r/bug1691412.java.t/expected.tags\
+    Units/java-review-needed.r/bug1691412.java.t/input.java\
+    Units/java-review-needed.r/bug1777340.java.t/expected.tags\
+    Units/java-review-needed.r/bug1777340.java.t/input.java\
+    Units/java-review-needed.r/bug1777344.java.t/expected.tags\
+    Units/java-review-needed.r/bug1777344.java.t/input.java\
+    Units/java-review-needed.r/bug2049723.java.t/expected.tags\
+    Units/java-review-needed.r/bug2049723.java.t/input.java\
+    Units/java-review-needed.r/bug2117073.java.t/expected.tags\
+    Units/java-review-needed.r/bug2117073.java.t/input.java\
+    Units/java-review-needed.r/bug814263.java.t/expected.tags\
+    Units/java-review-needed.r/bug814263.java.t/input.java\
+    Units/java-review-needed.r/enum.java.t/expected.tags\
+    Units/java-review-needed.r/enum.java.t/input.java\
+    Units/java-review-needed.r/infinite_loop.java.t/expected.tags\
+    Units/java-review-needed.r/infinite_loop.java.t/input.java\
+    Units/java-review-needed.r/java_enum.java.t/expected.tags\
+    Units/java-review-needed.r/java_enum.java.t/input.java\
+    Units/java-review-needed.r/unicode8.java.t/expected.tags\
+    Units/java-review-needed.r/unicode8.java.t/input.java\
+    Units/main-guessing.r/nolang-modeline-emacs-after-shbang.d/args.ctags\
+    Units/main-guessing.r/nolang-modeline-emacs-after-shbang.d/expected.tags\
+    Units/main-guessing.r/nolang-modeline-emacs-after-shbang.d/input.nolang\
+    Units/main-guessing.r/nolang-modeline-emacs-eof.d/args.ctags\
+    Units/main-guessing.r/nolang-modeline-emacs-eof.d/expected.tags\
+    Units/main-guessing.r/nolang-modeline-emacs-eof.d/input.nolang\
+    Units/main-guessing.r/nolang-modeline-emacs-firstline0.d/args.ctags\
+    Units/main-guessing.r/nolang-modeline-emacs-firstline0.d/expected.tags\
+    Units/main-guessing.r/nolang-modeline-emacs-firstline0.d/input.nolang\
+    Units/main-guessing.r/nolang-modeline-emacs-firstline1.d/args.ctags\
+    Units/main-guessing.r/nolang-modeline-emacs-firstline1.d/expected.tags\
+    Units/main-guessing.r/nolang-modeline-emacs-firstline1.d/input.nolang\
+    Units/main-guessing.r/nolang-modeline-vim0.d/args.ctags\
+    Units/main-guessing.r/nolang-modeline-vim0.d/expected.tags\
+    Units/main-guessing.r/nolang-modeline-vim0.d/input.nolang\
+    Units/main-guessing.r/nolang-modeline-vim1.d/args.ctags\
+    Units/main-guessing.r/nolang-modeline-vim1.d/expected.tags\
+    Units/main-guessing.r/nolang-modeline-vim1.d/input.nolang\
+    Units/main-guessing.r/nolang-modeline-vim2.d/args.ctags\
+    Units/main-guessing.r/nolang-modeline-vim2.d/expected.tags\
+    Units/main-guessing.r/nolang-modeline-vim2.d/input.nolang\
+    Units/main-guessing.r/nolang-modeline-zsh-autoload.d/args.ctags\
+    Units/main-guessing.r/nolang-modeline-zsh-autoload.d/expected.tags\
+    Units/main-guessing.r/nolang-modeline-zsh-autoload.d/input.nolang\
+    Units/main-guessing.r/nolang-modeline-zsh-compdef.d/args.ctags\
+    Units/main-guessing.r/nolang-modeline-zsh-compdef.d/expected.tags\
+    Units/main-guessing.r/nolang-modeline-zsh-compdef.d/input.nolang\
+    Units/main-guessing.r/nolang-shebang-python3.d/args.ctags\
+    Units/main-guessing.r/nolang-shebang-python3.d/expected.tags\
+    Units/main-guessing.r/nolang-shebang-python3.d/input.nolang\
+    Units/matlab-tg-corpus.d/expected.tags\
+    Units/matlab-tg-corpus.d/features\
+    Units/matlab-tg-corpus.d/input.m\
+    Units/modeline-vs-2gram.m/args.ctags\
+    Units/modeline-vs-2gram.m/expected.tags\
+    Units/modeline-vs-2gram.m/input.m\
+    Units/mtable-simple-with-continuation.d/args.ctags\
+    Units/mtable-simple-with-continuation.d/expected.tags\
+    Units/mtable-simple-with-continuation.d/input.mtable\
+    Units/mtable-simple-with-table-extending.d/args.ctags\
+    Units/mtable-simple-with-table-extending.d/expected.tags\
+    Units/mtable-simple-with-table-extending.d/input.mtable\
+    Units/mtable-simple.d/args.ctags\
+    Units/mtable-simple.d/expected.tags\
+    Units/mtable-simple.d/input.mtable\
+    Units/noext-tg-matlab.d/args.ctags\
+    Units/noext-tg-matlab.d/expected.tags\
+    Units/noext-tg-matlab.d/features\
+    Units/noext-tg-matlab.d/input.nolang\
+    Units/noext-tg-objc.d/args.ctags\
+    Units/noext-tg-objc.d/expected.tags\
+    Units/noext-tg-objc.d/input.nolang\
+    Units/objc-tg-corpus.d/expected.tags\
+    Units/objc-tg-corpus.d/input.m\
+    Units/option-add-alias.d/args.ctags\
+    Units/option-add-alias.d/expected.tags\
+    Units/option-add-alias.d/input.nolang\
+    Units/option-disable-kind-in-both.d/args.ctags\
+    Units/option-disable-kind-in-both.d/expected.tags\
+    Units/option-disable-kind-in-both.d/input.c\
+    Units/option-disable-kind-in-builtin.d/args.ctags\
+    Units/option-disable-kind-in-builtin.d/expected.tags\
+    Units/option-disable-kind-in-builtin.d/features\
+    Units/option-disable-kind-in-builtin.d/input.c\
+    Units/option-disable-kind-in-regex.d/args.ctags\
+    Units/option-disable-kind-in-regex.d/expected.tags\
+    Units/option-disable-kind-in-regex.d/input.c\
+    Units/option-extradef.d/args.ctags\
+    Units/option-extradef.d/expected.tags\
+    Units/option-extradef.d/input.py\
+    Units/option-input-file.d/README\
+    Units/option-input-file.d/args.ctags\
+    Units/option-input-file.d/expected.tags\
+    Units/option-input-file.d/input.c\
+    Units/option-lang-compatibility.d/args.ctags\
+    Units/option-lang-compatibility.d/expected.tags\
+    Units/option-lang-compatibility.d/features\
+    Units/option-lang-compatibility.d/input.foo\
+    Units/option-langmap-ext--ext.d/args.ctags\
+    Units/option-langmap-ext--ext.d/expected.tags\
+    Units/option-langmap-ext--ext.d/input.x\
+    Units/option-langmap-ext--pat-ext.d/args.ctags\
+    Units/option-langmap-ext--pat-ext.d/expected.tags\
+    Units/option-langmap-ext--pat-ext.d/input.zzz\
+    Units/option-langmap-ext-pat--ext.d/args.ctags\
+    Units/option-langmap-ext-pat--ext.d/expected.tags\
+    Units/option-langmap-ext-pat--ext.d/input.x\
+    Units/option-langmap-pat--ext.d/args.ctags\
+    Units/option-langmap-pat--ext.d/expected.tags\
+    Units/option-langmap-pat--ext.d/input.x\
+    Units/option-langmap-pat--pat-ext.d/args.ctags\
+    Units/option-langmap-pat--pat-ext.d/expected.tags\
+    Units/option-langmap-pat--pat-ext.d/input.zzz\
+    Units/option-same-kind-in-regex-and-builtin.d/args.ctags\
+    Units/option-same-kind-in-regex-and-builtin.d/expected.tags\
+    Units/option-same-kind-in-regex-and-builtin.d/features\
+    Units/option-same-kind-in-regex-and-builtin.d/input.c\
+    Units/parser-ada.r/ada-adb.d/expected.tags\
+    Units/parser-ada.r/ada-adb.d/input.adb\
+    Units/parser-ada.r/ada-ads.d/expected.tags\
+    Units/parser-ada.r/ada-ads.d/input.ads\
+    Units/parser-ada.r/ada-function.d/args.ctags\
+    Units/parser-ada.r/ada-function.d/input.broken\
+    Units/parser-ada.r/ada-partial-bug.d/expected.tags\
+    Units/parser-ada.r/ada-partial-bug.d/input.adb\
+    Units/parser-ada.r/ada-partial-bug2.d/input.adb\
+    Units/parser-ada.r/ada-partial-type.d/expected.tags\
+    Units/parser-ada.r/ada-partial-type.d/input.ads\
+    Units/parser-ada.r/ada-protected.d/input.adb\
+    Units/parser-ansibleplaybook.r/play-name.d/args.ctags\
+    Units/parser-ansibleplaybook.r/play-name.d/expected.tags\
+    Units/parser-ansibleplaybook.r/play-name.d/features\
+    Units/parser-ansibleplaybook.r/play-name.d/input.yml\
+    Units/parser-ant.r/regex-based.d/args.ctags\
+    Units/parser-ant.r/regex-based.d/expected.tags\
+    Units/parser-ant.r/regex-based.d/features\
+    Units/parser-ant.r/regex-based.d/input.xml\
+    Units/parser-ant.r/xpath-based.d/args.ctags\
+    Units/parser-ant.r/xpath-based.d/expected.tags\
+    Units/parser-ant.r/xpath-based.d/features\
+    Units/parser-ant.r/xpath-based.d/input.xml\
+    Units/parser-asm.r/68hc11.asm.d/expected.tags\
+    Units/parser-asm.r/68hc11.asm.d/input.asm\
+    Units/parser-asm.r/bd32.s.d/expected.tags\
+    Units/parser-asm.r/bd32.s.d/input.s\
+    Units/parser-asm.r/bug538629.asm.d/expected.tags\
+    Units/parser-asm.r/bug538629.asm.d/input.asm\
+    Units/parser-asm.r/gas-section.d/args.ctags\
+    Units/parser-asm.r/gas-section.d/expected.tags\
+    Units/parser-asm.r/gas-section.d/input.s\
+    Units/parser-asm.r/gas.s.d/args.ctags\
+    Units/parser-asm.r/gas.s.d/expected.tags\
+    Units/parser-asm.r/gas.s.d/input.s\
+    Units/parser-asm.r/masm.asm.d/expected.tags\
+    Units/parser-asm.r/masm.asm.d/input.asm\
+    Units/parser-asm.r/moniker.x68.d/expected.tags\
+    Units/parser-asm.r/moniker.x68.d/input.x68\
+    Units/parser-asm.r/unbalanced-end-macro.d/expected.tags\
+    Units/parser-asm.r/unbalanced-end-macro.d/input.S\
+    Units/parser-autoconf.r/disabling-m4.d/args.ctags\
+    Units/parser-autoconf.r/disabling-m4.d/expected.tags\
+    Units/parser-autoconf.r/disabling-m4.d/input.ac\
+    Units/parser-autoconf.r/forcing-autoconf-and-disabling-m4.d/args.ctags\
+    Units/parser-autoconf.r/forcing-autoconf-and-disabling-m4.d/expected.tags\
+    Units/parser-autoconf.r/forcing-autoconf-and-disabling-m4.d/input.m4\
+    Units/parser-autoconf.r/nested-block.ac.b/DESC.rst\
+    Units/parser-autoconf.r/nested-block.ac.b/args.ctags\
+    Units/parser-autoconf.r/nested-block.ac.b/expected.tags\
+    Units/parser-autoconf.r/nested-block.ac.b/input.ac\
+    Units/parser-autoconf.r/no-string-literal.d/expected.tags\
+    Units/parser-autoconf.r/no-string-literal.d/input.ac\
+    Units/parser-autoconf.r/simple.ac.d/args.ctags\
+    Units/parser-autoconf.r/simple.ac.d/expected.tags\
+    Units/parser-autoconf.r/simple.ac.d/input.ac\
+    Units/parser-autoconf.r/simple2.ac.d/args.ctags\
+    Units/parser-autoconf.r/simple2.ac.d/expected.tags\
+    Units/parser-autoconf.r/simple2.ac.d/input.ac\
+    Units/parser-automake.r/disable-make-parser.d/args.ctags\
+    Units/parser-automake.r/disable-make-parser.d/expected.tags\
+    Units/parser-automake.r/disable-make-parser.d/input.am\
+    Units/parser-automake.r/langstack.am.d/args.ctags\
+    Units/parser-automake.r/langstack.am.d/expected.tags\
+    Units/parser-automake.r/langstack.am.d/input.am\
+    Units/parser-automake.r/simple.am.d/args.ctags\
+    Units/parser-automake.r/simple.am.d/expected.tags\
+    Units/parser-automake.r/simple.am.d/input.am\
+    Units/parser-awk.r/gawk-alias.d/args.ctags\
+    Units/parser-awk.r/gawk-alias.d/expected.tags\
+    Units/parser-awk.r/gawk-alias.d/input.unknown\
+    Units/parser-awk.r/simple-awk.d/expected.tags\
+    Units/parser-awk.r/simple-awk.d/input.awk\
+    Units/parser-awk.r/simple2-awk.d/expected.tags\
+    Units/parser-awk.r/simple2-awk.d/input.awk\
+    Units/parser-c.r/attr-attached-to-array-failed.b/args.ctags\
+    Units/parser-c.r/attr-attached-to-array-failed.b/expected.tags\
+    Units/parser-c.r/attr-attached-to-array-failed.b/input.c\
+    Units/parser-c.r/attr-attached-to-array.d/args.ctags\
+    Units/parser-c.r/attr-attached-to-array.d/expected.tags\
+    Units/parser-c.r/attr-attached-to-array.d/input.c\
+    Units/parser-c.r/backslash-in-input.c.d/expected.tags\
+    Units/parser-c.r/backslash-in-input.c.d/input.c\
+    Units/parser-c.r/bit_field.c.d/args.ctags\
+    Units/parser-c.r/bit_field.c.d/expected.tags\
+    Units/parser-c.r/bit_field.c.d/input.c\
+    Units/parser-c.r/bug1020715.c.d/args.ctags\
+    Units/parser-c.r/bug1020715.c.d/expected.tags\
+    Units/parser-c.r/bug1020715.c.d/input.c\
+    Units/parser-c.r/bug1085585.c.d/args.ctags\
+    Units/parser-c.r/bug1085585.c.d/expected.tags\
+    Units/parser-c.r/bug1085585.c.d/input.c\
+    Units/parser-c.r/bug1086609.c.d/expected.tags\
+    Units/parser-c.r/bug1086609.c.d/input.c\
+    Units/parser-c.r/bug1198.c.d/args.ctags\
+    Units/parser-c.r/bug1198.c.d/expected.tags\
+    Units/parser-c.r/bug1198.c.d/input.c\
+    Units/parser-c.r/bug1201689.c.d/expected.tags\
+    Units/parser-c.r/bug1201689.c.d/input.c\
+    Units/parser-c.r/bug1458930.c.d/args.ctags\
+    Units/parser-c.r/bug1458930.c.d/expected.tags\
+    Units/parser-c.r/bug1458930.c.d/input.c\
+    Units/parser-c.r/bug1466117.c.d/expected.tags\
+    Units/parser-c.r/bug1466117.c.d/input.c\
+    Units/parser-c.r/bug1491666.c.d/args.ctags\
+    Units/parser-c.r/bug1491666.c.d/expected.tags\
+    Units/parser-c.r/bug1491666.c.d/input.c\
+    Units/parser-c.r/bug1764143.h.d/expected.tags\
+    Units/parser-c.r/bug1764143.h.d/input.h\
+    Units/parser-c.r/bug507864.c.d/README\
+    Units/parser-c.r/bug507864.c.d/expected.tags\
+    Units/parser-c.r/bug507864.c.d/input.c\
+    Units/parser-c.r/bug556645.c.d/README\
+    Units/parser-c.r/bug556645.c.d/expected.tags\
+    Units/parser-c.r/bug556645.c.d/input.c\
+    Units/parser-c.r/bug556646.c.d/expected.tags\
+    Units/parser-c.r/bug556646.c.d/input.c\
+    Units/parser-c.r/bug945.c.d/args.ctags\
+    Units/parser-c.r/bug945.c.d/expected.tags\
+    Units/parser-c.r/bug945.c.d/input.c\
+    Units/parser-c.r/bug950.c.d/args.ctags\
+    Units/parser-c.r/bug950.c.d/expected.tags\
+    Units/parser-c.r/bug950.c.d/input.c\
+    Units/parser-c.r/c-define-mixed.d/args.ctags\
+    Units/parser-c.r/c-define-mixed.d/expected.tags\
+    Units/parser-c.r/c-define-mixed.d/input.c\
+    Units/parser-c.r/c-digraphs.d/expected.tags\
+    Units/parser-c.r/c-digraphs.d/input.c\
+    Units/parser-c.r/c-include.d/args.ctags\
+    Units/parser-c.r/c-include.d/expected.tags\
+    Units/parser-c.r/c-include.d/input.c\
+    Units/parser-c.r/c-knr.d/args.ctags\
+    Units/parser-c.r/c-knr.d/expected.tags\
+    Units/parser-c.r/c-knr.d/input.c\
+    Units/parser-c.r/c-label.d/args.ctags\
+    Units/parser-c.r/c-label.d/expected.tags\
+    Units/parser-c.r/c-label.d/input.c\
+    Units/parser-c.r/c-multichars-between-single-quotes.d/expected.tags\
+    Units/parser-c.r/c-multichars-between-single-quotes.d/input.c\
+    Units/parser-c.r/c-sample.d/expected.tags\
+    Units/parser-c.r/c-sample.d/input.c\
+    Units/parser-c.r/c-size_t-wchar_t-typedef.d/expected.tags\
+    Units/parser-c.r/c-size_t-wchar_t-typedef.d/input.c\
+    Units/parser-c.r/c-struct-var-with-initializer.d/args.ctags\
+    Units/parser-c.r/c-struct-var-with-initializer.d/expected.tags\
+    Units/parser-c.r/c-struct-var-with-initializer.d/input.c\
+    Units/parser-c.r/c-trigraphs.d/expected.tags\
+    Units/parser-c.r/c-trigraphs.d/input.c\
+    Units/parser-c.r/complex_decl.c.d/expected.tags\
+    Units/parser-c.r/complex_decl.c.d/input.c\
+    Units/parser-c.r/cxx-keywords-simple.d/args.ctags\
+    Units/parser-c.r/cxx-keywords-simple.d/expected.tags\
+    Units/parser-c.r/cxx-keywords-simple.d/input.h\
+    Units/parser-c.r/cxx-scope-keywords.d/args.ctags\
+    Units/parser-c.r/cxx-scope-keywords.d/expected.tags\
+    Units/parser-c.r/cxx-scope-keywords.d/input.h\
+    Units/parser-c.r/directives-2.c.d/args.ctags\
+    Units/parser-c.r/directives-2.c.d/expected.tags\
+    Units/parser-c.r/directives-2.c.d/input.c\
+    Units/parser-c.r/directives.c.d/README\
+    Units/parser-c.r/directives.c.d/args.ctags\
+    Units/parser-c.r/directives.c.d/expected.tags\
+    Units/parser-c.r/directives.c.d/input.c\
+    Units/parser-c.r/end-field-of-macro.d/args.ctags\
+    Units/parser-c.r/end-field-of-macro.d/expected.tags\
+    Units/parser-c.r/end-field-of-macro.d/input.c\
+    Units/parser-c.r/enum.c.d/args.ctags\
+    Units/parser-c.r/enum.c.d/expected.tags\
+    Units/parser-c.r/enum.c.d/input.c\
+    Units/parser-c.r/extern_variable.h.b/README\
+    Units/parser-c.r/extern_variable.h.b/args.ctags\
+    Units/parser-c.r/extern_variable.h.b/expected.tags\
+    Units/parser-c.r/extern_variable.h.b/input.h\
+    Units/parser-c.r/func_typedef.h.d/expected.tags\
+    Units/parser-c.r/func_typedef.h.d/input.h\
+    Units/parser-c.r/if0.c.d/args.ctags\
+    Units/parser-c.r/if0.c.d/expected.tags\
+    Units/parser-c.r/if0.c.d/input.c\
+    Units/parser-c.r/line_directives.c.d/README\
+    Units/parser-c.r/line_directives.c.d/args.ctags\
+    Units/parser-c.r/line_directives.c.d/expected.tags\
+    Units/parser-c.r/line_directives.c.d/filter\
+    Units/parser-c.r/line_directives.c.d/input.c\
+    Units/parser-c.r/local.c.d/args.ctags\
+    Units/parser-c.r/local.c.d/expected.tags\
+    Units/parser-c.r/local.c.d/input.c\
+    Units/parser-c.r/macros.c.d/README\
+    Units/parser-c.r/macros.c.d/args.ctags\
+    Units/parser-c.r/macros.c.d/expected.tags\
+    Units/parser-c.r/macros.c.d/input.c\
+    Units/parser-c.r/option-disable-undef.c.d/args.ctags\
+    Units/parser-c.r/option-disable-undef.c.d/expected.tags\
+    Units/parser-c.r/option-disable-undef.c.d/input.c\
+    Units/parser-c.r/prototype.h.d/args.ctags\
+    Units/parser-c.r/prototype.h.d/expected.tags\
+    Units/parser-c.r/prototype.h.d/input.h\
+    Units/parser-c.r/spurious_label_tags.c.d/args.ctags\
+    Units/parser-c.r/spurious_label_tags.c.d/expected.tags\
+    Units/parser-c.r/spurious_label_tags.c.d/input.c\
+    Units/parser-c.r/static_array.c.d/expected.tags\
+    Units/parser-c.r/static_array.c.d/input.c\
+    Units/parser-c.r/using-cxx-keyword-in-c-code.d/args.ctags\
+    Units/parser-c.r/using-cxx-keyword-in-c-code.d/expected.tags\
+    Units/parser-c.r/using-cxx-keyword-in-c-code.d/input.c\
+    Units/parser-c.r/vardef-surrounded-by-parentheses.d/args.ctags\
+    Units/parser-c.r/vardef-surrounded-by-parentheses.d/expected.tags\
+    Units/parser-c.r/vardef-surrounded-by-parentheses.d/input.c\
+    Units/parser-cobol.r/comments.d/expected.tags\
+    Units/parser-cobol.r/comments.d/input.cbl\
+    Units/parser-cobol.r/issue-1324.d/README\
+    Units/parser-cobol.r/issue-1324.d/args.ctags\
+    Units/parser-cobol.r/issue-1324.d/dictfile\
+    Units/parser-cobol.r/issue-1324.d/expected.tags\
+    Units/parser-cobol.r/issue-1324.d/input.cbl\
+    Units/parser-cobol.r/simple.cbl.d/expected.tags\
+    Units/parser-cobol.r/simple.cbl.d/features\
+    Units/parser-cobol.r/simple.cbl.d/input.cbl\
+    Units/parser-cpreprocessor.r/disable-cpp-client--clinet-kind.d/README\
+    Units/parser-cpreprocessor.r/disable-cpp-client--clinet-kind.d/args.ctags\
+    Units/parser-cpreprocessor.r/disable-cpp-client--clinet-kind.d/expected.tags\
+    Units/parser-cpreprocessor.r/disable-cpp-client--clinet-kind.d/input.c\
+    Units/parser-cpreprocessor.r/disable-cpp-client--cpp-kind.d/README\
+    Units/parser-cpreprocessor.r/disable-cpp-client--cpp-kind.d/args.ctags\
+    Units/parser-cpreprocessor.r/disable-cpp-client--cpp-kind.d/expected.tags\
+    Units/parser-cpreprocessor.r/disable-cpp-client--cpp-kind.d/input.c\
+    Units/parser-cpreprocessor.r/disable-cpp-client.d/README\
+    Units/parser-cpreprocessor.r/disable-cpp-client.d/args.ctags\
+    Units/parser-cpreprocessor.r/disable-cpp-client.d/expected.tags\
+    Units/parser-cpreprocessor.r/disable-cpp-client.d/input.c\
+    Units/parser-cpreprocessor.r/disable-cpp-cpp.d/args.ctags\
+    Units/parser-cpreprocessor.r/disable-cpp-cpp.d/expected.tags\
+    Units/parser-cpreprocessor.r/disable-cpp-cpp.d/input.dts\
+    Units/parser-cpreprocessor.r/if0-false-with-param.c.d/args.ctags\
+    Units/parser-cpreprocessor.r/if0-false-with-param.c.d/expected.tags\
+    Units/parser-cpreprocessor.r/if0-false-with-param.c.d/input.c\
+    Units/parser-cpreprocessor.r/if0-true-with-param.c.d/args.ctags\
+    Units/parser-cpreprocessor.r/if0-true-with-param.c.d/expected.tags\
+    Units/parser-cpreprocessor.r/if0-true-with-param.c.d/input.c\
+    Units/parser-cpreprocessor.r/macros-specified-with-param.c.d/README\
+    Units/parser-cpreprocessor.r/macros-specified-with-param.c.d/args.ctags\
+    Units/parser-cpreprocessor.r/macros-specified-with-param.c.d/expected.tags\
+    Units/parser-cpreprocessor.r/macros-specified-with-param.c.d/input.c\
+    Units/parser-cpreprocessor.r/simple-cpreprocessor.d/args.ctags\
+    Units/parser-cpreprocessor.r/simple-cpreprocessor.d/expected.tags\
+    Units/parser-cpreprocessor.r/simple-cpreprocessor.d/input.c\
+    Units/parser-css.r/css-at-rules.d/expected.tags\
+    Units/parser-css.r/css-at-rules.d/input.css\
+    Units/parser-css.r/css-at-supports.d/expected.tags\
+    Units/parser-css.r/css-at-supports.d/input.css\
+    Units/parser-css.r/css-attribute-selectors.d/expected.tags\
+    Units/parser-css.r/css-attribute-selectors.d/input.css\
+    Units/parser-css.r/css-comma-no-space.d/expected.tags\
+    Units/parser-css.r/css-comma-no-space.d/input.css\
+    Units/parser-css.r/css-namespace-selectors.d/expected.tags\
+    Units/parser-css.r/css-namespace-selectors.d/input.css\
+    Units/parser-css.r/css-pseudo-classes.d/expected.tags\
+    Units/parser-css.r/css-pseudo-classes.d/input.css\
+    Units/parser-css.r/css-simple.d/expected.tags\
+    Units/parser-css.r/css-simple.d/input.css\
+    Units/parser-css.r/css-singlequote-in-comment-issue2.d/expected.tags\
+    Units/parser-css.r/css-singlequote-in-comment-issue2.d/input.css\
+    Units/parser-css.r/css-tag-types.d/expected.tags\
+    Units/parser-css.r/css-tag-types.d/input.css\
+    Units/parser-css.r/css-trivial.d/expected.tags\
+    Units/parser-css.r/css-trivial.d/input.css\
+    Units/parser-cuda.r/cuda-sample.d/args.ctags\
+    Units/parser-cuda.r/cuda-sample.d/expected.tags\
+    Units/parser-cuda.r/cuda-sample.d/input.cu\
+    Units/parser-cxx.r/1117-using-in-c.d/input.c\
+    Units/parser-cxx.r/README\
+    Units/parser-cxx.r/alignas-in-struct.d/expected.tags\
+    Units/parser-cxx.r/alignas-in-struct.d/input.cpp\
+    Units/parser-cxx.r/angle_bracket.cpp.d/expected.tags\
+    Units/parser-cxx.r/angle_bracket.cpp.d/input.cpp\
+    Units/parser-cxx.r/attribute.cpp.d/args.ctags\
+    Units/parser-cxx.r/attribute.cpp.d/expected.tags\
+    Units/parser-cxx.r/attribute.cpp.d/input.cpp\
+    Units/parser-cxx.r/brackets.cpp.d/args.ctags\
+    Units/parser-cxx.r/brackets.cpp.d/expected.tags\
+    Units/parser-cxx.r/brackets.cpp.d/input.cpp\
+    Units/parser-cxx.r/bug-github-1111.cpp.d/expected.tags\
+    Units/parser-cxx.r/bug-github-1111.cpp.d/input.cpp\
+    Units/parser-cxx.r/bug-github-871.cpp.d/args.ctags\
+    Units/parser-cxx.r/bug-github-871.cpp.d/expected.tags\
+    Units/parser-cxx.r/bug-github-871.cpp.d/input.cpp\
+    Units/parser-cxx.r/bug-github-pull-972.cpp.d/args.ctags\
+    Units/parser-cxx.r/bug-github-pull-972.cpp.d/expected.tags\
+    Units/parser-cxx.r/bug-github-pull-972.cpp.d/input.cpp\
+    Units/parser-cxx.r/bug1020715.cpp.d/expected.tags\
+    Units/parser-cxx.r/bug1020715.cpp.d/input.cpp\
+    Units/parser-cxx.r/bug1093123.cpp.d/args.ctags\
+    Units/parser-cxx.r/bug1093123.cpp.d/expected.tags\
+    Units/parser-cxx.r/bug1093123.cpp.d/input.cpp\
+    Units/parser-cxx.r/bug1187505.cpp.d/args.ctags\
+    Units/parser-cxx.r/bug1187505.cpp.d/expected.tags\
+    Units/parser-cxx.r/bug1187505.cpp.d/input.cpp\
+    Units/parser-cxx.r/bug1252.cpp.d/expected.tags\
+    Units/parser-cxx.r/bug1252.cpp.d/input.cpp\
+    Units/parser-cxx.r/bug1548443.cpp.d/args.ctags\
+    Units/parser-cxx.r/bug1548443.cpp.d/expected.tags\
+    Units/parser-cxx.r/bug1548443.cpp.d/input.cpp\
+    Units/parser-cxx.r/bug1563476.cpp.d/args.ctags\
+    Units/parser-cxx.r/bug1563476.cpp.d/expected.tags\
+    Units/parser-cxx.r/bug1563476.cpp.d/input.cpp\
+    Units/parser-cxx.r/bug1575055.cpp.d/README\
+    Units/parser-cxx.r/bug1575055.cpp.d/expected.tags\
+    Units/parser-cxx.r/bug1575055.cpp.d/input.cpp\
+    Units/parser-cxx.r/bug1585745.cpp.d/expected.tags\
+    Units/parser-cxx.r/bug1585745.cpp.d/input.cpp\
+    Units/parser-cxx.r/bug1770479.cpp.d/args.ctags\
+    Units/parser-cxx.r/bug1770479.cpp.d/expected.tags\
+    Units/parser-cxx.r/bug1770479.cpp.d/input.cpp\
+    Units/parser-cxx.r/bug1773926.cpp.d/args.ctags\
+    Units/parser-cxx.r/bug1773926.cpp.d/expected.tags\
+    Units/parser-cxx.r/bug1773926.cpp.d/input.cpp\
+    Units/parser-cxx.r/bug1799340.cpp.d/expected.tags\
+    Units/parser-cxx.r/bug1799340.cpp.d/input.cpp\
+    Units/parser-cxx.r/bug1799343-1.cpp.d/args.ctags\
+    Units/parser-cxx.r/bug1799343-1.cpp.d/expected.tags\
+    Units/parser-cxx.r/bug1799343-1.cpp.d/input.cpp\
+    Units/parser-cxx.r/bug1799343-2.cpp.d/args.ctags\
+    Units/parser-cxx.r/bug1799343-2.cpp.d/expected.tags\
+    Units/parser-cxx.r/bug1799343-2.cpp.d/input.cpp\
+    Units/parser-cxx.r/bug1907083.cpp.d/expected.tags\
+    Units/parser-cxx.r/bug1907083.cpp.d/input.cpp\
+    Units/parser-cxx.r/bug1924919.cpp.d/README\
+    Units/parser-cxx.r/bug1924919.cpp.d/args.ctags\
+    Units/parser-cxx.r/bug1924919.cpp.d/expected.tags\
+    Units/parser-cxx.r/bug1924919.cpp.d/input.cpp\
+    Units/parser-cxx.r/bug639639.cpp.d/expected.tags\
+    Units/parser-cxx.r/bug639639.cpp.d/input.h\
+    Units/parser-cxx.r/bug639644.cpp.d/expected.tags\
+    Units/parser-cxx.r/bug639644.cpp.d/input.h\
+    Units/parser-cxx.r/bug665086.cpp.d/expected.tags\
+    Units/parser-cxx.r/bug665086.cpp.d/input.cpp\
+    Units/parser-cxx.r/bug834.cpp.d/args.ctags\
+    Units/parser-cxx.r/bug834.cpp.d/expected.tags\
+    Units/parser-cxx.r/bug834.cpp.d/input.cpp\
+    Units/parser-cxx.r/bug849591.cpp.d/expected.tags\
+    Units/parser-cxx.r/bug849591.cpp.d/input.cpp\
+    Units/parser-cxx.r/bug852368.cpp.d/args.ctags\
+    Units/parser-cxx.r/bug852368.cpp.d/expected.tags\
+    Units/parser-cxx.r/bug852368.cpp.d/input.cpp\
+    Units/parser-cxx.r/bug872494.cpp.d/expected.tags\
+    Units/parser-cxx.r/bug872494.cpp.d/input.cpp\
+    Units/parser-cxx.r/c-header-as-cpp.d/args.ctags\
+    Units/parser-cxx.r/c-header-as-cpp.d/expected.tags\
+    Units/parser-cxx.r/c-header-as-cpp.d/input.h\
+    Units/parser-cxx.r/class-inheritance.cpp.d/args.ctags\
+    Units/parser-cxx.r/class-inheritance.cpp.d/expected.tags\
+    Units/parser-cxx.r/class-inheritance.cpp.d/input.cpp\
+    Units/parser-cxx.r/class.cpp.d/args.ctags\
+    Units/parser-cxx.r/class.cpp.d/expected.tags\
+    Units/parser-cxx.r/class.cpp.d/input.cpp\
+    Units/parser-cxx.r/complex-macros.d/args.ctags\
+    Units/parser-cxx.r/complex-macros.d/expected.tags\
+    Units/parser-cxx.r/complex-macros.d/input.cpp\
+    Units/parser-cxx.r/cpp-type-alias-with-using-keyword.d/expected.tags\
+    Units/parser-cxx.r/cpp-type-alias-with-using-keyword.d/input.cpp\
+    Units/parser-cxx.r/cpp_destructor.cpp.d/expected.tags\
+    Units/parser-cxx.r/cpp_destructor.cpp.d/input.cpp\
+    Units/parser-cxx.r/cxx-keywords-as-c-identifiers.b/README\
+    Units/parser-cxx.r/cxx-keywords-as-c-identifiers.b/args.ctags\
+    Units/parser-cxx.r/cxx-keywords-as-c-identifiers.b/expected.tags\
+    Units/parser-cxx.r/cxx-keywords-as-c-identifiers.b/gen-expected-tags.sh\
+    Units/parser-cxx.r/cxx-keywords-as-c-identifiers.b/gen-input.sh\
+    Units/parser-cxx.r/cxx-keywords-as-c-identifiers.b/input.c\
+    Units/parser-cxx.r/cxx-keywords-as-c-identifiers.b/input.h\
+    Units/parser-cxx.r/cxx-keywords-as-c-identifiers.b/keywords.sh\
+    Units/parser-cxx.r/cxx-shift-operators-in-template-parameters.d/README\
+    Units/parser-cxx.r/cxx-shift-operators-in-template-parameters.d/args.ctags\
+    Units/parser-cxx.r/cxx-shift-operators-in-template-parameters.d/expected.tags\
+    Units/parser-cxx.r/cxx-shift-operators-in-template-parameters.d/input.cpp\
+    Units/parser-cxx.r/cxx11-delete.d/args.ctags\
+    Units/parser-cxx.r/cxx11-delete.d/expected.tags\
+    Units/parser-cxx.r/cxx11-delete.d/input.cpp\
+    Units/parser-cxx.r/cxx11-final.d/args.ctags\
+    Units/parser-cxx.r/cxx11-final.d/expected.tags\
+    Units/parser-cxx.r/cxx11-final.d/input.cpp\
+    Units/parser-cxx.r/cxx11-lambdas.d/args.ctags\
+    Units/parser-cxx.r/cxx11-lambdas.d/expected.tags\
+    Units/parser-cxx.r/cxx11-lambdas.d/input.cpp\
+    Units/parser-cxx.r/cxx11-noexcept.d/args.ctags\
+    Units/parser-cxx.r/cxx11-noexcept.d/expected.tags\
+    Units/parser-cxx.r/cxx11-noexcept.d/input.cpp\
+    Units/parser-cxx.r/cxx11-override.d/args.ctags\
+    Units/parser-cxx.r/cxx11-override.d/expected.tags\
+    Units/parser-cxx.r/cxx11-override.d/input.cpp\
+    Units/parser-cxx.r/cxx11-raw-strings.d/expected.tags\
+    Units/parser-cxx.r/cxx11-raw-strings.d/input.cpp\
+    Units/parser-cxx.r/cxx11enum.cpp.d/args.ctags\
+    Units/parser-cxx.r/cxx11enum.cpp.d/expected.tags\
+    Units/parser-cxx.r/cxx11enum.cpp.d/input.cpp\
+    Units/parser-cxx.r/cxx14-combined.d/args.ctags\
+    Units/parser-cxx.r/cxx14-combined.d/expected.tags\
+    Units/parser-cxx.r/cxx14-combined.d/input.cpp\
+    Units/parser-cxx.r/digraph-and-template-angle-confliction.d/args.ctags\
+    Units/parser-cxx.r/digraph-and-template-angle-confliction.d/expected.tags\
+    Units/parser-cxx.r/digraph-and-template-angle-confliction.d/input.hh\
+    Units/parser-cxx.r/extern.d/args.ctags\
+    Units/parser-cxx.r/extern.d/expected.tags\
+    Units/parser-cxx.r/extern.d/input.cpp\
+    Units/parser-cxx.r/foreach.d/args.ctags\
+    Units/parser-cxx.r/foreach.d/expected.tags\
+    Units/parser-cxx.r/foreach.d/input.cpp\
+    Units/parser-cxx.r/function-return-type-via-macro.d/args.ctags\
+    Units/parser-cxx.r/function-return-type-via-macro.d/expected.tags\
+    Units/parser-cxx.r/function-return-type-via-macro.d/input.cpp\
+    Units/parser-cxx.r/function-return-types.d/args.ctags\
+    Units/parser-cxx.r/function-return-types.d/expected.tags\
+    Units/parser-cxx.r/function-return-types.d/input.cpp\
+    Units/parser-cxx.r/functions.cpp.d/args.ctags\
+    Units/parser-cxx.r/functions.cpp.d/expected.tags\
+    Units/parser-cxx.r/functions.cpp.d/input.cpp\
+    Units/parser-cxx.r/ignoring-macro-with-parameters.d/args.ctags\
+    Units/parser-cxx.r/ignoring-macro-with-parameters.d/expected.tags\
+    Units/parser-cxx.r/ignoring-macro-with-parameters.d/input.hxx\
+    Units/parser-cxx.r/iostream.d/args.ctags\
+    Units/parser-cxx.r/iostream.d/expected.tags\
+    Units/parser-cxx.r/iostream.d/input.cpp\
+    Units/parser-cxx.r/k-and-r.d/args.ctags\
+    Units/parser-cxx.r/k-and-r.d/expected.tags\
+    Units/parser-cxx.r/k-and-r.d/input.c\
+    Units/parser-cxx.r/less-than-operator-between-anglebrackets.d/args.ctags\
+    Units/parser-cxx.r/less-than-operator-between-anglebrackets.d/expected.tags\
+    Units/parser-cxx.r/less-than-operator-between-anglebrackets.d/input.cpp\
+    Units/parser-cxx.r/namespace-alias-in-function.d/args.ctags\
+    Units/parser-cxx.r/namespace-alias-in-function.d/expected.tags\
+    Units/parser-cxx.r/namespace-alias-in-function.d/input.cpp\
+    Units/parser-cxx.r/namespace-and-scope.b/args.ctags\
+    Units/parser-cxx.r/namespace-and-scope.b/expected.tags\
+    Units/parser-cxx.r/namespace-and-scope.b/input.cpp\
+    Units/parser-cxx.r/namespace.cpp.d/args.ctags\
+    Units/parser-cxx.r/namespace.cpp.d/expected.tags\
+    Units/parser-cxx.r/namespace.cpp.d/input.cpp\
+    Units/parser-cxx.r/new-delete.d/args.ctags\
+    Units/parser-cxx.r/new-delete.d/expected.tags\
+    Units/parser-cxx.r/new-delete.d/input.cpp\
+    Units/parser-cxx.r/operators.cpp.d/args.ctags\
+    Units/parser-cxx.r/operators.cpp.d/expected.tags\
+    Units/parser-cxx.r/operators.cpp.d/input.cpp\
+    Units/parser-cxx.r/pointer-to-array.d/args.ctags\
+    Units/parser-cxx.r/pointer-to-array.d/expected.tags\
+    Units/parser-cxx.r/pointer-to-array.d/input.c\
+    Units/parser-cxx.r/properties.cpp.d/args.ctags\
+    Units/parser-cxx.r/properties.cpp.d/expected.tags\
+    Units/parser-cxx.r/properties.cpp.d/input.cpp\
+    Units/parser-cxx.r/rojas.h.d/args.ctags\
+    Units/parser-cxx.r/rojas.h.d/expected.tags\
+    Units/parser-cxx.r/rojas.h.d/input.h\
+    Units/parser-cxx.r/signature.cpp.d/README\
+    Units/parser-cxx.r/signature.cpp.d/args.ctags\
+    Units/parser-cxx.r/signature.cpp.d/expected.tags\
+    Units/parser-cxx.r/signature.cpp.d/input.cpp\
+    Units/parser-cxx.r/template-specializations.d/args.ctags\
+    Units/parser-cxx.r/template-specializations.d/expected.tags\
+    Units/parser-cxx.r/template-specializations.d/input.cpp\
+    Units/parser-cxx.r/templates-in-labmdas-1.cpp.d/args.ctags\
+    Units/parser-cxx.r/templates-in-labmdas-1.cpp.d/expected.tags\
+    Units/parser-cxx.r/templates-in-labmdas-1.cpp.d/input.cpp\
+    Units/parser-cxx.r/templates-in-labmdas-2.cpp.d/args.ctags\
+    Units/parser-cxx.r/templates-in-labmdas-2.cpp.d/expected.tags\
+    Units/parser-cxx.r/templates-in-labmdas-2.cpp.d/input.cpp\
+    Units/parser-cxx.r/templates.d/args.ctags\
+    Units/parser-cxx.r/templates.d/expected.tags\
+    Units/parser-cxx.r/templates.d/input.cpp\
+    Units/parser-cxx.r/templates2.d/args.ctags\
+    Units/parser-cxx.r/templates2.d/expected.tags\
+    Units/parser-cxx.r/templates2.d/input.cpp\
+    Units/parser-cxx.r/templates3.d/args.ctags\
+    Units/parser-cxx.r/templates3.d/expected.tags\
+    Units/parser-cxx.r/templates3.d/input.cpp\
+    Units/parser-cxx.r/typedef-of-function-ptr-with-macro.d/expected.tags\
+    Units/parser-cxx.r/typedef-of-function-ptr-with-macro.d/input.cpp\
+    Units/parser-cxx.r/typedefs.cpp.d/args.ctags\
+    Units/parser-cxx.r/typedefs.cpp.d/expected.tags\
+    Units/parser-cxx.r/typedefs.cpp.d/input.cpp\
+    Units/parser-cxx.r/using.cpp.d/args.ctags\
+    Units/parser-cxx.r/using.cpp.d/expected.tags\
+    Units/parser-cxx.r/using.cpp.d/input.cpp\
+    Units/parser-cxx.r/variable-declarations.cpp.d/args.ctags\
+    Units/parser-cxx.r/variable-declarations.cpp.d/expected.tags\
+    Units/parser-cxx.r/variable-declarations.cpp.d/input.cpp\
+    Units/parser-cxx.r/variables-in-control-statements.d/args.ctags\
+    Units/parser-cxx.r/variables-in-control-statements.d/expected.tags\
+    Units/parser-cxx.r/variables-in-control-statements.d/input.cpp\
+    Units/parser-cxx.r/variables-prototypes-2.cpp.d/args.ctags\
+    Units/parser-cxx.r/variables-prototypes-2.cpp.d/expected.tags\
+    Units/parser-cxx.r/variables-prototypes-2.cpp.d/input.cpp\
+    Units/parser-cxx.r/variables-prototypes.cpp.b/args.ctags\
+    Units/parser-cxx.r/variables-prototypes.cpp.b/expected.tags\
+    Units/parser-cxx.r/variables-prototypes.cpp.b/input.cpp\
+    Units/parser-d.r/d-accessmod.d/args.ctags\
+    Units/parser-d.r/d-accessmod.d/expected.tags\
+    Units/parser-d.r/d-accessmod.d/input.d\
+    Units/parser-d.r/d-size_t-wchar_t-alias.d/expected.tags\
+    Units/parser-d.r/d-size_t-wchar_t-alias.d/input.d\
+    Units/parser-d.r/simple.d.d/expected.tags\
+    Units/parser-d.r/simple.d.d/input.d\
+    Units/parser-dtd.r/colons-in-name.d/args.ctags\
+    Units/parser-dtd.r/colons-in-name.d/expected.tags\
+    Units/parser-dtd.r/colons-in-name.d/input.dtd\
+    Units/parser-dtd.r/condtion.d/args.ctags\
+    Units/parser-dtd.r/condtion.d/expected.tags\
+    Units/parser-dtd.r/condtion.d/input.dtd\
+    Units/parser-dtd.r/elements.d/args.ctags\
+    Units/parser-dtd.r/elements.d/expected.tags\
+    Units/parser-dtd.r/elements.d/input.mod\
+    Units/parser-dtd.r/fq.d/args.ctags\
+    Units/parser-dtd.r/fq.d/expected.tags\
+    Units/parser-dtd.r/fq.d/input.dtd\
+    Units/parser-dtd.r/notation.d/expected.tags\
+    Units/parser-dtd.r/notation.d/input.dtd\
+    Units/parser-dtd.r/parameter-entities.d/args.ctags\
+    Units/parser-dtd.r/parameter-entities.d/expected.tags\
+    Units/parser-dtd.r/parameter-entities.d/input.dtd\
+    Units/parser-dtd.r/simple-dtd.d/args.ctags\
+    Units/parser-dtd.r/simple-dtd.d/expected.tags\
+    Units/parser-dtd.r/simple-dtd.d/input.dtd\
+    Units/parser-dts.r/dts-core-dump.d/input.dts\
+    Units/parser-dts.r/dts-fq-without-scope-field.d/README\
+    Units/parser-dts.r/dts-fq-without-scope-field.d/args.ctags\
+    Units/parser-dts.r/dts-fq-without-scope-field.d/expected.tags\
+    Units/parser-dts.r/dts-fq-without-scope-field.d/input.dts\
+    Units/parser-dts.r/dts-simple.d/args.ctags\
+    Units/parser-dts.r/dts-simple.d/expected.tags\
+    Units/parser-dts.r/dts-simple.d/input.dts\
+    Units/parser-eiffel.r/aliases.e.d/expected.tags\
+    Units/parser-eiffel.r/aliases.e.d/input.e\
+    Units/parser-eiffel.r/attributes.e.d/expected.tags\
+    Units/parser-eiffel.r/attributes.e.d/input.e\
+    Units/parser-eiffel.r/class.e.d/expected.tags\
+    Units/parser-eiffel.r/class.e.d/input.e\
+    Units/parser-eiffel.r/deprecated-syntax.e.d/README\
+    Units/parser-eiffel.r/deprecated-syntax.e.d/expected.tags\
+    Units/parser-eiffel.r/deprecated-syntax.e.d/input.e\
+    Units/parser-eiffel.r/functions.e.d/expected.tags\
+    Units/parser-eiffel.r/functions.e.d/input.e\
+    Units/parser-eiffel.r/inherit-rename.e.d/expected.tags\
+    Units/parser-eiffel.r/inherit-rename.e.d/input.e\
+    Units/parser-eiffel.r/local-kind.e.d/args.ctags\
+    Units/parser-eiffel.r/local-kind.e.d/expected.tags\
+    Units/parser-eiffel.r/local-kind.e.d/input.e\
+    Units/parser-eiffel.r/note.e.d/expected.tags\
+    Units/parser-eiffel.r/note.e.d/input.e\
+    Units/parser-eiffel.r/obsolete.e.d/expected.tags\
+    Units/parser-eiffel.r/obsolete.e.d/input.e\
+    Units/parser-eiffel.r/procedures.e.d/expected.tags\
+    Units/parser-eiffel.r/procedures.e.d/input.e\
+    Units/parser-eiffel.r/verbatim.e.d/expected.tags\
+    Units/parser-eiffel.r/verbatim.e.d/input.e\
+    Units/parser-flex.r/flex_comment.mxml.d/expected.tags\
+    Units/parser-flex.r/flex_comment.mxml.d/input.mxml\
+    Units/parser-flex.r/flex_only_mxml.mxml.d/expected.tags\
+    Units/parser-flex.r/flex_only_mxml.mxml.d/input.mxml\
+    Units/parser-flex.r/flex_with_actionscript.mxml.d/expected.tags\
+    Units/parser-flex.r/flex_with_actionscript.mxml.d/input.mxml\
+    Units/parser-fortran.r/array-spec.f90.d/expected.tags\
+    Units/parser-fortran.r/array-spec.f90.d/input.f90\
+    Units/parser-fortran.r/array_spec.f90.d/expected.tags\
+    Units/parser-fortran.r/array_spec.f90.d/input.f90\
+    Units/parser-fortran.r/auto.f.d/expected.tags\
+    Units/parser-fortran.r/auto.f.d/input.f\
+    Units/parser-fortran.r/bug565813.f90.d/expected.tags\
+    Units/parser-fortran.r/bug565813.f90.d/input.f90\
+    Units/parser-fortran.r/bug620288.f.d/expected.tags\
+    Units/parser-fortran.r/bug620288.f.d/input.f\
+    Units/parser-fortran.r/bug629.d/args.ctags\
+    Units/parser-fortran.r/bug629.d/expected.tags\
+    Units/parser-fortran.r/bug629.d/input.c\
+    Units/parser-fortran.r/bug670433.f90.d/README\
+    Units/parser-fortran.r/bug670433.f90.d/expected.tags\
+    Units/parser-fortran.r/bug670433.f90.d/input.f90\
+    Units/parser-fortran.r/bug726712.f90.d/expected.tags\
+    Units/parser-fortran.r/bug726712.f90.d/input.f90\
+    Units/parser-fortran.r/bug726875.f90.d/expected.tags\
+    Units/parser-fortran.r/bug726875.f90.d/input.f90\
+    Units/parser-fortran.r/bug734933.f90.d/expected.tags\
+    Units/parser-fortran.r/bug734933.f90.d/input.f90\
+    Units/parser-fortran.r/bug858165.f90.d/expected.tags\
+    Units/parser-fortran.r/bug858165.f90.d/input.f90\
+    Units/parser-fortran.r/bug877956.f90.d/args.ctags\
+    Units/parser-fortran.r/bug877956.f90.d/expected.tags-x\
+    Units/parser-fortran.r/bug877956.f90.d/input.f90\
+    Units/parser-fortran.r/byte.f.d/expected.tags\
+    Units/parser-fortran.r/byte.f.d/input.f\
+    Units/parser-fortran.r/char-selector.f90.d/expected.tags\
+    Units/parser-fortran.r/char-selector.f90.d/input.f90\
+    Units/parser-fortran.r/common-json.f.d/expected.tags-json\
+    Units/parser-fortran.r/common-json.f.d/input.f\
+    Units/parser-fortran.r/common-xref.f.d/args.ctags\
+    Units/parser-fortran.r/common-xref.f.d/expected.tags-x\
+    Units/parser-fortran.r/common-xref.f.d/input.f\
+    Units/parser-fortran.r/common.f.d/expected.tags\
+    Units/parser-fortran.r/common.f.d/input.f\
+    Units/parser-fortran.r/continuation.f90.d/expected.tags\
+    Units/parser-fortran.r/continuation.f90.d/input.f90\
+    Units/parser-fortran.r/debian_432872.f90.d/expected.tags\
+    Units/parser-fortran.r/debian_432872.f90.d/input.f90\
+    Units/parser-fortran.r/dopbl2.f.d/expected.tags\
+    Units/parser-fortran.r/dopbl2.f.d/input.f\
+    Units/parser-fortran.r/fortran-abstract-implementation.d/args.ctags\
+    Units/parser-fortran.r/fortran-abstract-implementation.d/expected.tags\
+    Units/parser-fortran.r/fortran-abstract-implementation.d/input.f90\
+    Units/parser-fortran.r/fortran-abstract-interface.d/args.ctags\
+    Units/parser-fortran.r/fortran-abstract-interface.d/expected.tags\
+    Units/parser-fortran.r/fortran-abstract-interface.d/input.f90\
+    Units/parser-fortran.r/fortran-associate.d/expected.tags\
+    Units/parser-fortran.r/fortran-associate.d/input.f90\
+    Units/parser-fortran.r/fortran-bind-c.d/args.ctags\
+    Units/parser-fortran.r/fortran-bind-c.d/expected.tags\
+    Units/parser-fortran.r/fortran-bind-c.d/input.f90\
+    Units/parser-fortran.r/fortran-block.d/expected.tags\
+    Units/parser-fortran.r/fortran-block.d/input.f90\
+    Units/parser-fortran.r/fortran-enum.d/expected.tags\
+    Units/parser-fortran.r/fortran-enum.d/input.f90\
+    Units/parser-fortran.r/fortran-extends-qualifier.d/args.ctags\
+    Units/parser-fortran.r/fortran-extends-qualifier.d/expected.tags\
+    Units/parser-fortran.r/fortran-extends-qualifier.d/input.f90\
+    Units/parser-fortran.r/fortran-forall.d/expected.tags\
+    Units/parser-fortran.r/fortran-forall.d/input.f90\
+    Units/parser-fortran.r/fortran-interface.d/args.ctags\
+    Units/parser-fortran.r/fortran-interface.d/expected.tags\
+    Units/parser-fortran.r/fortran-interface.d/input.f90\
+    Units/parser-fortran.r/fortran-method.d/args.ctags\
+    Units/parser-fortran.r/fortran-method.d/expected.tags\
+    Units/parser-fortran.r/fortran-method.d/input.f90\
+    Units/parser-fortran.r/fortran-pointer.d/expected.tags\
+    Units/parser-fortran.r/fortran-pointer.d/input.f90\
+    Units/parser-fortran.r/fortran-procedure-qualifiers.d/expected.tags\
+    Units/parser-fortran.r/fortran-procedure-qualifiers.d/input.f90\
+    Units/parser-fortran.r/fortran-procedure.d/expected.tags\
+    Units/parser-fortran.r/fortran-procedure.d/input.f90\
+    Units/parser-fortran.r/fortran-signature.d/args.ctags\
+    Units/parser-fortran.r/fortran-signature.d/expected.tags\
+    Units/parser-fortran.r/fortran-signature.d/input.f90\
+    Units/parser-fortran.r/fortran-square-parens.d/expected.tags\
+    Units/parser-fortran.r/fortran-square-parens.d/input.f90\
+    Units/parser-fortran.r/implied_program.f.d/expected.tags\
+    Units/parser-fortran.r/implied_program.f.d/input.f\
+    Units/parser-fortran.r/initialization.f90.d/expected.tags\
+    Units/parser-fortran.r/initialization.f90.d/input.f90\
+    Units/parser-fortran.r/invalid_name.f90.d/expected.tags\
+    Units/parser-fortran.r/invalid_name.f90.d/input.f90\
+    Units/parser-fortran.r/lanus.for.d/expected.tags\
+    Units/parser-fortran.r/lanus.for.d/input.for\
+    Units/parser-fortran.r/misc_types.f.d/expected.tags\
+    Units/parser-fortran.r/misc_types.f.d/input.f\
+    Units/parser-fortran.r/misc_types.f90.d/expected.tags\
+    Units/parser-fortran.r/misc_types.f90.d/input.f90\
+    Units/parser-fortran.r/namelist.f.d/expected.tags\
+    Units/parser-fortran.r/namelist.f.d/input.f\
+    Units/parser-fortran.r/numlib.f90.d/args.ctags\
+    Units/parser-fortran.r/numlib.f90.d/expected.tags\
+    Units/parser-fortran.r/numlib.f90.d/input.f90\
+    Units/parser-fortran.r/pure_elem.f95.d/README\
+    Units/parser-fortran.r/pure_elem.f95.d/expected.tags\
+    Units/parser-fortran.r/pure_elem.f95.d/input.f95\
+    Units/parser-fortran.r/recursive.f95.d/args.ctags\
+    Units/parser-fortran.r/recursive.f95.d/expected.tags\
+    Units/parser-fortran.r/recursive.f95.d/input.f95\
+    Units/parser-fortran.r/semicolon.f90.d/expected.tags\
+    Units/parser-fortran.r/semicolon.f90.d/input.f90\
+    Units/parser-fortran.r/stdcall.f.d/expected.tags\
+    Units/parser-fortran.r/stdcall.f.d/input.f\
+    Units/parser-fortran.r/structure.f.d/expected.tags\
+    Units/parser-fortran.r/structure.f.d/input.f\
+    Units/parser-fortran.r/union.f.d/expected.tags\
+    Units/parser-fortran.r/union.f.d/input.f\
+    Units/parser-fortran.r/value.f.d/expected.tags\
+    Units/parser-fortran.r/value.f.d/input.f\
+    Units/parser-go.r/go-anonmember.d/args.ctags\
+    Units/parser-go.r/go-anonmember.d/expected.tags\
+    Units/parser-go.r/go-anonmember.d/input.go\
+    Units/parser-go.r/go-funcs.d/args.ctags\
+    Units/parser-go.r/go-funcs.d/expected.tags\
+    Units/parser-go.r/go-funcs.d/input.go\
+    Units/parser-go.r/go-goroutines.d/args.ctags\
+    Units/parser-go.r/go-goroutines.d/expected.tags\
+    Units/parser-go.r/go-goroutines.d/input.go\
+    Units/parser-go.r/go-helloworld.d/args.ctags\
+    Units/parser-go.r/go-helloworld.d/expected.tags\
+    Units/parser-go.r/go-helloworld.d/input.go\
+    Units/parser-go.r/go-incomplete-func.d/input.go\
+    Units/parser-go.r/go-incomplete-input.d/args.ctags\
+    Units/parser-go.r/go-incomplete-input.d/input.go\
+    Units/parser-go.r/go-op-less-than.d/args.ctags\
+    Units/parser-go.r/go-op-less-than.d/expected.tags\
+    Units/parser-go.r/go-op-less-than.d/input.go\
+    Units/parser-go.r/go-scope.d/args.ctags\
+    Units/parser-go.r/go-scope.d/expected.tags\
+    Units/parser-go.r/go-scope.d/input.go\
+    Units/parser-go.r/go-timeouts.d/args.ctags\
+    Units/parser-go.r/go-timeouts.d/expected.tags\
+    Units/parser-go.r/go-timeouts.d/input.go\
+    Units/parser-go.r/go-torture.d/args.ctags\
+    Units/parser-go.r/go-torture.d/expected.tags\
+    Units/parser-go.r/go-torture.d/input.go\
+    Units/parser-html.r/script.html.d/args.ctags\
+    Units/parser-html.r/script.html.d/expected.tags\
+    Units/parser-html.r/script.html.d/input.html\
+    Units/parser-html.r/simple.html.t/args.ctags\
+    Units/parser-html.r/simple.html.t/expected.tags\
+    Units/parser-html.r/simple.html.t/features\
+    Units/parser-html.r/simple.html.t/input.html\
+    Units/parser-html.r/whitespace-prefixed.html.d/expected.tags\
+    Units/parser-html.r/whitespace-prefixed.html.d/input.html\
+    Units/parser-iniconf.r/ignore-utf8-bom.d/args.ctags\
+    Units/parser-iniconf.r/ignore-utf8-bom.d/expected.tags\
+    Units/parser-iniconf.r/ignore-utf8-bom.d/input.ini\
+    Units/parser-iniconf.r/simple-pythonLoggingConfig.d/args.ctags\
+    Units/parser-iniconf.r/simple-pythonLoggingConfig.d/expected.tags\
+    Units/parser-iniconf.r/simple-pythonLoggingConfig.d/input.conf\
+    Units/parser-itcl.r/fq-with-namespace.b/args.ctags\
+    Units/parser-itcl.r/fq-with-namespace.b/expected.tags\
+    Units/parser-itcl.r/fq-with-namespace.b/input.tcl\
+    Units/parser-itcl.r/itcl-1.d/args.ctags\
+    Units/parser-itcl.r/itcl-1.d/expected.tags\
+    Units/parser-itcl.r/itcl-1.d/input.tcl\
+    Units/parser-itcl.r/itcl-2.d/args.ctags\
+    Units/parser-itcl.r/itcl-2.d/expected.tags\
+    Units/parser-itcl.r/itcl-2.d/input.tcl\
+    Units/parser-itcl.r/no-itcl-1.d/expected.tags\
+    Units/parser-itcl.r/no-itcl-1.d/input.tcl\
+    Units/parser-itcl.r/no-itcl-2.d/expected.tags\
+    Units/parser-itcl.r/no-itcl-2.d/input.tcl\
+    Units/parser-itcl.r/simple-itcl.d/args.ctags\
+    Units/parser-itcl.r/simple-itcl.d/expected.tags\
+    Units/parser-itcl.r/simple-itcl.d/input.tcl\
+    Units/parser-java.r/accented-latin1-identifiers.java.d/README\
+    Units/parser-java.r/accented-latin1-identifiers.java.d/expected.tags\
+    Units/parser-java.r/accented-latin1-identifiers.java.d/input.java\
+    Units/parser-java.r/bug1447756.java.d/expected.tags\
+    Units/parser-java.r/bug1447756.java.d/input.java\
+    Units/parser-java.r/bug1691412.java.d/expected.tags\
+    Units/parser-java.r/bug1691412.java.d/input.java\
+    Units/parser-java.r/bug1777340.java.d/expected.tags\
+    Units/parser-java.r/bug1777340.java.d/input.java\
+    Units/parser-java.r/bug1777344.java.b/expected.tags\
+    Units/parser-java.r/bug1777344.java.b/input.java\
+    Units/parser-java.r/bug2049723.java.d/expected.tags\
+    Units/parser-java.r/bug2049723.java.d/input.java\
+    Units/parser-java.r/bug2117073.java.d/expected.tags\
+    Units/parser-java.r/bug2117073.java.d/input.java\
+    Units/parser-java.r/bug814263.java.d/expected.tags\
+    Units/parser-java.r/bug814263.java.d/input.java\
+    Units/parser-java.r/enum.java.d/args.ctags\
+    Units/parser-java.r/enum.java.d/expected.tags\
+    Units/parser-java.r/enum.java.d/input.java\
+    Units/parser-java.r/imported-role.d/args.ctags\
+    Units/parser-java.r/imported-role.d/expected.tags\
+    Units/parser-java.r/imported-role.d/input.java\
+    Units/parser-java.r/infinite_loop.java.d/expected.tags\
+    Units/parser-java.r/infinite_loop.java.d/input.java\
+    Units/parser-java.r/java-catch-block.d/args.ctags\
+    Units/parser-java.r/java-catch-block.d/expected.tags\
+    Units/parser-java.r/java-catch-block.d/input.java\
+    Units/parser-java.r/java_enum.java.d/args.ctags\
+    Units/parser-java.r/java_enum.java.d/expected.tags\
+    Units/parser-java.r/java_enum.java.d/input.java\
+    Units/parser-javascript.r/1795612.js.d/README\
+    Units/parser-javascript.r/1795612.js.d/expected.tags\
+    Units/parser-javascript.r/1795612.js.d/input.js\
+    Units/parser-javascript.r/1850914.js.d/expected.tags\
+    Units/parser-javascript.r/1850914.js.d/input.js\
+    Units/parser-javascript.r/1878155.js.d/expected.tags\
+    Units/parser-javascript.r/1878155.js.d/input.js\
+    Units/parser-javascript.r/1880687.js.d/expected.tags\
+    Units/parser-javascript.r/1880687.js.d/input.js\
+    Units/parser-javascript.r/2023624.js.d/expected.tags\
+    Units/parser-javascript.r/2023624.js.d/input.js\
+    Units/parser-javascript.r/3470609.js.d/expected.tags\
+    Units/parser-javascript.r/3470609.js.d/input.js\
+    Units/parser-javascript.r/bug1950327.js.d/expected.tags\
+    Units/parser-javascript.r/bug1950327.js.d/input.js\
+    Units/parser-javascript.r/bug2777310.js.d/expected.tags\
+    Units/parser-javascript.r/bug2777310.js.d/input.js\
+    Units/parser-javascript.r/bug2888482.js.d/expected.tags\
+    Units/parser-javascript.r/bug2888482.js.d/input.js\
+    Units/parser-javascript.r/bug3036476.js.d/expected.tags\
+    Units/parser-javascript.r/bug3036476.js.d/input.js\
+    Units/parser-javascript.r/bug3571233.js.d/expected.tags\
+    Units/parser-javascript.r/bug3571233.js.d/input.js\
+    Units/parser-javascript.r/generators.d/expected.tags\
+    Units/parser-javascript.r/generators.d/input.js\
+    Units/parser-javascript.r/js-arraylist.d/expected.tags\
+    Units/parser-javascript.r/js-arraylist.d/input.js\
+    Units/parser-javascript.r/js-async1.d/expected.tags\
+    Units/parser-javascript.r/js-async1.d/input.js\
+    Units/parser-javascript.r/js-async2.d/expected.tags\
+    Units/parser-javascript.r/js-async2.d/input.js\
+    Units/parser-javascript.r/js-broken-strings.d/expected.tags\
+    Units/parser-javascript.r/js-broken-strings.d/input.js\
+    Units/parser-javascript.r/js-broken-template-backslash.d/expected.tags\
+    Units/parser-javascript.r/js-broken-template-backslash.d/input.js\
+    Units/parser-javascript.r/js-broken-template-dollar.d/expected.tags\
+    Units/parser-javascript.r/js-broken-template-dollar.d/input.js\
+    Units/parser-javascript.r/js-broken-template.d/expected.tags\
+    Units/parser-javascript.r/js-broken-template.d/input.js\
+    Units/parser-javascript.r/js-class-related-unterminated.d/expected.tags\
+    Units/parser-javascript.r/js-class-related-unterminated.d/input.js\
+    Units/parser-javascript.r/js-comma-at-end-of-object.d/expected.tags\
+    Units/parser-javascript.r/js-comma-at-end-of-object.d/input.js\
+    Units/parser-javascript.r/js-commas-and-missing-semicolons.d/args.ctags\
+    Units/parser-javascript.r/js-commas-and-missing-semicolons.d/expected.tags\
+    Units/parser-javascript.r/js-commas-and-missing-semicolons.d/input.js\
+    Units/parser-javascript.r/js-complex-return.d/expected.tags\
+    Units/parser-javascript.r/js-complex-return.d/input.js\
+    Units/parser-javascript.r/js-const.d/expected.tags\
+    Units/parser-javascript.r/js-const.d/input.js\
+    Units/parser-javascript.r/js-crlf.d/args.ctags\
+    Units/parser-javascript.r/js-crlf.d/expected.tags\
+    Units/parser-javascript.r/js-crlf.d/input.js\
+    Units/parser-javascript.r/js-default-export.d/expected.tags\
+    Units/parser-javascript.r/js-default-export.d/input.js\
+    Units/parser-javascript.r/js-do-while.d/args.ctags\
+    Units/parser-javascript.r/js-do-while.d/expected.tags\
+    Units/parser-javascript.r/js-do-while.d/input.js\
+    Units/parser-javascript.r/js-es6-class.d/expected.tags\
+    Units/parser-javascript.r/js-es6-class.d/input.js\
+    Units/parser-javascript.r/js-es6-mixin.d/args.ctags\
+    Units/parser-javascript.r/js-es6-mixin.d/expected.tags\
+    Units/parser-javascript.r/js-es6-mixin.d/input.js\
+    Units/parser-javascript.r/js-export.d/expected.tags\
+    Units/parser-javascript.r/js-export.d/input.js\
+    Units/parser-javascript.r/js-function-in-arglist.d/expected.tags\
+    Units/parser-javascript.r/js-function-in-arglist.d/input.js\
+    Units/parser-javascript.r/js-implicit-semicolons.d/expected.tags\
+    Units/parser-javascript.r/js-implicit-semicolons.d/input.js\
+    Units/parser-javascript.r/js-let.d/expected.tags\
+    Units/parser-javascript.r/js-let.d/input.js\
+    Units/parser-javascript.r/js-many-functions.d/expected.tags\
+    Units/parser-javascript.r/js-many-functions.d/input.js\
+    Units/parser-javascript.r/js-methods.d/expected.tags\
+    Units/parser-javascript.r/js-methods.d/input.js\
+    Units/parser-javascript.r/js-multiple-vars.d/expected.tags\
+    Units/parser-javascript.r/js-multiple-vars.d/input.js\
+    Units/parser-javascript.r/js-naked-blocks.d/args.ctags\
+    Units/parser-javascript.r/js-naked-blocks.d/expected.tags\
+    Units/parser-javascript.r/js-naked-blocks.d/input.js\
+    Units/parser-javascript.r/js-non-printable-in-signature.d/args.ctags\
+    Units/parser-javascript.r/js-non-printable-in-signature.d/expected.tags\
+    Units/parser-javascript.r/js-non-printable-in-signature.d/input.js\
+    Units/parser-javascript.r/js-null-tag-for-broken-input0.d/args.ctags\
+    Units/parser-javascript.r/js-null-tag-for-broken-input0.d/expected.tags\
+    Units/parser-javascript.r/js-null-tag-for-broken-input0.d/input.js\
+    Units/parser-javascript.r/js-null-tag-for-broken-input1.d/args.ctags\
+    Units/parser-javascript.r/js-null-tag-for-broken-input1.d/expected.tags\
+    Units/parser-javascript.r/js-null-tag-for-broken-input1.d/input.js\
+    Units/parser-javascript.r/js-null-tag-for-broken-input2.d/args.ctags\
+    Units/parser-javascript.r/js-null-tag-for-broken-input2.d/expected.tags\
+    Units/parser-javascript.r/js-null-tag-for-broken-input2.d/input.js\
+    Units/parser-javascript.r/js-null-tag-for-broken-input3.d/README\
+    Units/parser-javascript.r/js-null-tag-for-broken-input3.d/args.ctags\
+    Units/parser-javascript.r/js-null-tag-for-broken-input3.d/expected.tags\
+    Units/parser-javascript.r/js-null-tag-for-broken-input3.d/input.js\
+    Units/parser-javascript.r/js-null-tag-for-broken-input4.d/README\
+    Units/parser-javascript.r/js-null-tag-for-broken-input4.d/args.ctags\
+    Units/parser-javascript.r/js-null-tag-for-broken-input4.d/expected.tags\
+    Units/parser-javascript.r/js-null-tag-for-broken-input4.d/input.js\
+    Units/parser-javascript.r/js-parenthesis-rvalue.d/expected.tags\
+    Units/parser-javascript.r/js-parenthesis-rvalue.d/input.js\
+    Units/parser-javascript.r/js-scope-resolution.b/args.ctags\
+    Units/parser-javascript.r/js-scope-resolution.b/expected.tags\
+    Units/parser-javascript.r/js-scope-resolution.b/input.js\
+    Units/parser-javascript.r/js-scope.d/expected.tags\
+    Units/parser-javascript.r/js-scope.d/input.js\
+    Units/parser-javascript.r/js-shebang-gjs.d/args.ctags\
+    Units/parser-javascript.r/js-shebang-gjs.d/expected.tags\
+    Units/parser-javascript.r/js-shebang-gjs.d/input.nolang\
+    Units/parser-javascript.r/js-shebang-node.d/args.ctags\
+    Units/parser-javascript.r/js-shebang-node.d/expected.tags\
+    Units/parser-javascript.r/js-shebang-node.d/input.nolang\
+    Units/parser-javascript.r/js-shebang-nodejs.d/args.ctags\
+    Units/parser-javascript.r/js-shebang-nodejs.d/expected.tags\
+    Units/parser-javascript.r/js-shebang-nodejs.d/input.nolang\
+    Units/parser-javascript.r/js-shebang-seed.d/args.ctags\
+    Units/parser-javascript.r/js-shebang-seed.d/expected.tags\
+    Units/parser-javascript.r/js-shebang-seed.d/input.nolang\
+    Units/parser-javascript.r/js-shebang.d/expected.tags\
+    Units/parser-javascript.r/js-shebang.d/input.js\
+    Units/parser-javascript.r/js-signature.d/args.ctags\
+    Units/parser-javascript.r/js-signature.d/expected.tags\
+    Units/parser-javascript.r/js-signature.d/input.js\
+    Units/parser-javascript.r/js-string-continuation.d/expected.tags\
+    Units/parser-javascript.r/js-string-continuation.d/input.js\
+    Units/parser-javascript.r/js-sub-block-scope.d/expected.tags\
+    Units/parser-javascript.r/js-sub-block-scope.d/input.js\
+    Units/parser-javascript.r/js-template-strings.d/expected.tags\
+    Units/parser-javascript.r/js-template-strings.d/input.js\
+    Units/parser-javascript.r/js-tricky-newlines.d/expected.tags\
+    Units/parser-javascript.r/js-tricky-newlines.d/input.js\
+    Units/parser-javascript.r/js-two-vars.d/expected.tags\
+    Units/parser-javascript.r/js-two-vars.d/input.js\
+    Units/parser-javascript.r/js-unknown-construct-nesting.d/expected.tags\
+    Units/parser-javascript.r/js-unknown-construct-nesting.d/input.js\
+    Units/parser-javascript.r/js-unterminated-leak.d/input.js\
+    Units/parser-javascript.r/js-unterminated-new.d/args.ctags\
+    Units/parser-javascript.r/js-unterminated-new.d/expected.tags\
+    Units/parser-javascript.r/js-unterminated-new.d/input.js\
+    Units/parser-javascript.r/js-var-at-eof.d/expected.tags\
+    Units/parser-javascript.r/js-var-at-eof.d/input.js\
+    Units/parser-javascript.r/jsFunc_tutorial.js.d/expected.tags\
+    Units/parser-javascript.r/jsFunc_tutorial.js.d/input.js\
+    Units/parser-javascript.r/no_terminator.js.d/expected.tags\
+    Units/parser-javascript.r/no_terminator.js.d/input.js\
+    Units/parser-javascript.r/regexp.js.d/expected.tags\
+    Units/parser-javascript.r/regexp.js.d/input.js\
+    Units/parser-javascript.r/secondary_fcn_name.js.d/expected.tags\
+    Units/parser-javascript.r/secondary_fcn_name.js.d/input.js\
+    Units/parser-javascript.r/simple-jsx.d/expected.tags\
+    Units/parser-javascript.r/simple-jsx.d/input.jsx\
+    Units/parser-javascript.r/ui5.controller.js.d/expected.tags\
+    Units/parser-javascript.r/ui5.controller.js.d/input.js\
+    Units/parser-ldscript.r/discard.d/args.ctags\
+    Units/parser-ldscript.r/discard.d/expected.tags\
+    Units/parser-ldscript.r/discard.d/input.lds\
+    Units/parser-ldscript.r/input-sections.d/args.ctags\
+    Units/parser-ldscript.r/input-sections.d/expected.tags\
+    Units/parser-ldscript.r/input-sections.d/input.lds\
+    Units/parser-ldscript.r/simple-ldscript.d/README\
+    Units/parser-ldscript.r/simple-ldscript.d/args.ctags\
+    Units/parser-ldscript.r/simple-ldscript.d/expected.tags\
+    Units/parser-ldscript.r/simple-ldscript.d/input.lds.S\
+    Units/parser-ldscript.r/versions.d/README\
+    Units/parser-ldscript.r/versions.d/args.ctags\
+    Units/parser-ldscript.r/versions.d/expected.tags\
+    Units/parser-ldscript.r/versions.d/input.lds\
+    Units/parser-lua.r/lua-double-equals.d/expected.tags\
+    Units/parser-lua.r/lua-double-equals.d/input.lua\
+    Units/parser-lua.r/lua-equal-after-function.d/expected.tags\
+    Units/parser-lua.r/lua-equal-after-function.d/input.lua\
+    Units/parser-lua.r/lua-skip-whitespaces-in-name.d/expected.tags\
+    Units/parser-lua.r/lua-skip-whitespaces-in-name.d/input.lua\
+    Units/parser-lua.r/simple.lua.d/expected.tags\
+    Units/parser-lua.r/simple.lua.d/input.lua\
+    Units/parser-m4.r/disabling-autoconf.d/args.ctags\
+    Units/parser-m4.r/disabling-autoconf.d/expected.tags\
+    Units/parser-m4.r/disabling-autoconf.d/input.m4\
+    Units/parser-m4.r/disabling-subparser.d/args.ctags\
+    Units/parser-m4.r/disabling-subparser.d/expected.tags\
+    Units/parser-m4.r/disabling-subparser.d/input.m4\
+    Units/parser-m4.r/m4-autoconf-and-optlib.d/README\
+    Units/parser-m4.r/m4-autoconf-and-optlib.d/args.ctags\
+    Units/parser-m4.r/m4-autoconf-and-optlib.d/expected.tags\
+    Units/parser-m4.r/m4-autoconf-and-optlib.d/input.m4\
+    Units/parser-m4.r/m4-comment.d/args.ctags\
+    Units/parser-m4.r/m4-comment.d/expected.tags\
+    Units/parser-m4.r/m4-comment.d/input.m4\
+    Units/parser-m4.r/m4-multi-undef.d/args.ctags\
+    Units/parser-m4.r/m4-multi-undef.d/expected.tags\
+    Units/parser-m4.r/m4-multi-undef.d/input.m4\
+    Units/parser-m4.r/m4-quotestring.b/DESC.rst\
+    Units/parser-m4.r/m4-quotestring.b/expected.tags\
+    Units/parser-m4.r/m4-quotestring.b/input.m4\
+    Units/parser-m4.r/m4-simple.d/args.ctags\
+    Units/parser-m4.r/m4-simple.d/expected.tags\
+    Units/parser-m4.r/m4-simple.d/input.m4\
+    Units/parser-m4.r/m4-switch-lang-by-ac.d/args.ctags\
+    Units/parser-m4.r/m4-switch-lang-by-ac.d/expected.tags\
+    Units/parser-m4.r/m4-switch-lang-by-ac.d/input.m4\
+    Units/parser-m4.r/m4-switch-lang-by-m4.d/args.ctags\
+    Units/parser-m4.r/m4-switch-lang-by-m4.d/expected.tags\
+    Units/parser-m4.r/m4-switch-lang-by-m4.d/input.m4\
+    Units/parser-make.r/bug2959889.mak.d/expected.tags\
+    Units/parser-make.r/bug2959889.mak.d/input.mak\
+    Units/parser-make.r/make.comment-in-rule.d/expected.tags\
+    Units/parser-make.r/make.comment-in-rule.d/input.mak\
+    Units/parser-make.r/make.continuation.d/expected.tags\
+    Units/parser-make.r/make.continuation.d/input.mak\
+    Units/parser-make.r/make.gnumake-not-special-targets.d/expected.tags\
+    Units/parser-make.r/make.gnumake-not-special-targets.d/input.mak\
+    Units/parser-make.r/make.gnumake-pattern-rules.d/expected.tags\
+    Units/parser-make.r/make.gnumake-pattern-rules.d/input.mak\
+    Units/parser-make.r/make.include.d/args.ctags\
+    Units/parser-make.r/make.include.d/expected.tags\
+    Units/parser-make.r/make.include.d/input.mk\
+    Units/parser-make.r/make.multi-target.d/expected.tags\
+    Units/parser-make.r/make.multi-target.d/input.mak\
+    Units/parser-make.r/make.parenthesis.d/expected.tags\
+    Units/parser-make.r/make.parenthesis.d/input.mk\
+    Units/parser-make.r/make.target-with-parentheses.d/expected.tags\
+    Units/parser-make.r/make.target-with-parentheses.d/input.mak\
+    Units/parser-make.r/make.variable-on-cmdline.d/expected.tags\
+    Units/parser-make.r/make.variable-on-cmdline.d/input.mak\
+    Units/parser-make.r/make.variable-set-if-undefined.d/expected.tags\
+    Units/parser-make.r/make.variable-set-if-undefined.d/input.mak\
+    Units/parser-man.r/double-quoted.d/expected.tags\
+    Units/parser-man.r/double-quoted.d/input.1\
+    Units/parser-man.r/simple.d/expected.tags\
+    Units/parser-man.r/simple.d/input.1\
+    Units/parser-myrddin.r/simple.d/expected.tags\
+    Units/parser-myrddin.r/simple.d/input.myr\
+    Units/parser-objectivec.r/objc-signature.d/args.ctags\
+    Units/parser-objectivec.r/objc-signature.d/expected.tags\
+    Units/parser-objectivec.r/objc-signature.d/input.m\
+    Units/parser-objectivec.r/objc.m.d/expected.tags\
+    Units/parser-objectivec.r/objc.m.d/input.m\
+    Units/parser-objectivec.r/objectivec_implementation.m.d/args.ctags\
+    Units/parser-objectivec.r/objectivec_implementation.m.d/expected.tags\
+    Units/parser-objectivec.r/objectivec_implementation.m.d/input.m\
+    Units/parser-objectivec.r/objectivec_interface.h.d/args.ctags\
+    Units/parser-objectivec.r/objectivec_interface.h.d/expected.tags\
+    Units/parser-objectivec.r/objectivec_interface.h.d/input.h\
+    Units/parser-objectivec.r/objectivec_property.h.d/args.ctags\
+    Units/parser-objectivec.r/objectivec_property.h.d/expected.tags\
+    Units/parser-objectivec.r/objectivec_property.h.d/input.h\
+    Units/parser-objectivec.r/objectivec_protocol.h.d/args.ctags\
+    Units/parser-objectivec.r/objectivec_protocol.h.d/expected.tags\
+    Units/parser-objectivec.r/objectivec_protocol.h.d/input.h\
+    Units/parser-ocaml.r/github-451-improved.d/args.ctags\
+    Units/parser-ocaml.r/github-451-improved.d/expected.tags\
+    Units/parser-ocaml.r/github-451-improved.d/input.ml\
+    Units/parser-ocaml.r/ocamlAllKinds.ml.t/args.ctags\
+    Units/parser-ocaml.r/ocamlAllKinds.ml.t/expected.tags\
+    Units/parser-ocaml.r/ocamlAllKinds.ml.t/input.ml\
+    Units/parser-ocaml.r/ocamlCommentInStringAllowed.ml.d/expected.tags\
+    Units/parser-ocaml.r/ocamlCommentInStringAllowed.ml.d/input.ml\
+    Units/parser-ocaml.r/ocaml_empty.ml.d/expected.tags\
+    Units/parser-ocaml.r/ocaml_empty.ml.d/input.ml\
+    Units/parser-ocaml.r/ocaml_empty.ml_etags.d/expected.tags-e\
+    Units/parser-ocaml.r/ocaml_empty.ml_etags.d/input.ml\
+    Units/parser-ocaml.r/ocaml_empty.ml_xref.d/expected.tags-x\
+    Units/parser-ocaml.r/ocaml_empty.ml_xref.d/input.ml\
+    Units/parser-ocaml.r/ocaml_only_str.ml.d/expected.tags\
+    Units/parser-ocaml.r/ocaml_only_str.ml.d/input.ml\
+    Units/parser-ocaml.r/ocaml_string_tests.ml.d/expected.tags\
+    Units/parser-ocaml.r/ocaml_string_tests.ml.d/input.ml\
+    Units/parser-ocaml.r/ocaml_two_files.d/args.ctags\
+    Units/parser-ocaml.r/ocaml_two_files.d/expected.tags\
+    Units/parser-ocaml.r/ocaml_two_files.d/input-0.ml\
+    Units/parser-ocaml.r/ocaml_two_files.d/input.ml\
+    Units/parser-perl.r/bug612621.pl.d/expected.tags\
+    Units/parser-perl.r/bug612621.pl.d/input.pl\
+    Units/parser-perl.r/bug842077.pl.d/expected.tags\
+    Units/parser-perl.r/bug842077.pl.d/input.pl\
+    Units/parser-perl.r/format.pl.d/expected.tags\
+    Units/parser-perl.r/format.pl.d/input.pl\
+    Units/parser-perl.r/package.pm.d/expected.tags\
+    Units/parser-perl.r/package.pm.d/input.pm\
+    Units/parser-perl.r/perl-autoloader.d/expected.tags\
+    Units/parser-perl.r/perl-autoloader.d/input.pm\
+    Units/parser-perl.r/perl-selfloader.d/expected.tags\
+    Units/parser-perl.r/perl-selfloader.d/input.pm\
+    Units/parser-perl.r/perl-two-line-package.d/args.ctags\
+    Units/parser-perl.r/perl-two-line-package.d/expected.tags\
+    Units/parser-perl.r/perl-two-line-package.d/input.pm\
+    Units/parser-perl.r/simple.pl.d/args.ctags\
+    Units/parser-perl.r/simple.pl.d/expected.tags\
+    Units/parser-perl.r/simple.pl.d/input.pl\
+    Units/parser-perl6.r/perl6-bunch1.d/expected.tags\
+    Units/parser-perl6.r/perl6-bunch1.d/input.pm\
+    Units/parser-perl6.r/perl6-bunch2.d/expected.tags\
+    Units/parser-perl6.r/perl6-bunch2.d/input.pm\
+    Units/parser-perl6.r/perl6-package.d/expected.tags\
+    Units/parser-perl6.r/perl6-package.d/input.pm\
+    Units/parser-php.r/anonymous_functions.php.d/expected.tags\
+    Units/parser-php.r/anonymous_functions.php.d/input.php\
+    Units/parser-php.r/bug681824.php.d/expected.tags\
+    Units/parser-php.r/bug681824.php.d/input.php\
+    Units/parser-php.r/classes.php.d/expected.tags\
+    Units/parser-php.r/classes.php.d/input.php\
+    Units/parser-php.r/mode.php.d/expected.tags\
+    Units/parser-php.r/mode.php.d/input.php\
+    Units/parser-php.r/php-anonymous-classes.d/args.ctags\
+    Units/parser-php.r/php-anonymous-classes.d/expected.tags\
+    Units/parser-php.r/php-anonymous-classes.d/input.php\
+    Units/parser-php.r/php-anonymous_functions.d/args.ctags\
+    Units/parser-php.r/php-anonymous_functions.d/expected.tags\
+    Units/parser-php.r/php-anonymous_functions.d/input.php\
+    Units/parser-php.r/php-bug681824.d/args.ctags\
+    Units/parser-php.r/php-bug681824.d/expected.tags\
+    Units/parser-php.r/php-bug681824.d/input.php\
+    Units/parser-php.r/php-case_sensitivity.d/expected.tags\
+    Units/parser-php.r/php-case_sensitivity.d/input.php\
+    Units/parser-php.r/php-classes.d/args.ctags\
+    Units/parser-php.r/php-classes.d/expected.tags\
+    Units/parser-php.r/php-classes.d/input.php\
+    Units/parser-php.r/php-full-qualified-tags-no-esc.d/args.ctags\
+    Units/parser-php.r/php-full-qualified-tags-no-esc.d/expected.tags\
+    Units/parser-php.r/php-full-qualified-tags-no-esc.d/input.php\
+    Units/parser-php.r/php-full-qualified-tags.d/args.ctags\
+    Units/parser-php.r/php-full-qualified-tags.d/expected.tags\
+    Units/parser-php.r/php-full-qualified-tags.d/input.php\
+    Units/parser-php.r/php-marker.d/args.ctags\
+    Units/parser-php.r/php-marker.d/expected.tags\
+    Units/parser-php.r/php-marker.d/input.unknown-lang\
+    Units/parser-php.r/php-mode.d/expected.tags\
+    Units/parser-php.r/php-mode.d/input.php\
+    Units/parser-php.r/php-namespaces.d/expected.tags\
+    Units/parser-php.r/php-namespaces.d/input.php\
+    Units/parser-php.r/php-namespaces2.d/expected.tags\
+    Units/parser-php.r/php-namespaces2.d/input.php\
+    Units/parser-php.r/php-php5_5_class_kw.d/expected.tags\
+    Units/parser-php.r/php-php5_5_class_kw.d/input.php\
+    Units/parser-php.r/php-return-type-declaration.d/args.ctags\
+    Units/parser-php.r/php-return-type-declaration.d/expected.tags\
+    Units/parser-php.r/php-return-type-declaration.d/input.php\
+    Units/parser-php.r/php-semi-reserved-keywords.d/expected.tags\
+    Units/parser-php.r/php-semi-reserved-keywords.d/input.php\
+    Units/parser-php.r/php-simple.d/args.ctags\
+    Units/parser-php.r/php-simple.d/expected.tags\
+    Units/parser-php.r/php-simple.d/input.php\
+    Units/parser-php.r/php-strings.d/expected.tags\
+    Units/parser-php.r/php-strings.d/input.php\
+    Units/parser-php.r/php-traits.d/args.ctags\
+    Units/parser-php.r/php-traits.d/expected.tags\
+    Units/parser-php.r/php-traits.d/input.php\
+    Units/parser-php.r/php-use.d/expected.tags\
+    Units/parser-php.r/php-use.d/input.php\
+    Units/parser-php.r/php-whitespaces.d/expected.tags\
+    Units/parser-php.r/php-whitespaces.d/input.php\
+    Units/parser-php.r/simple.php.d/expected.tags\
+    Units/parser-php.r/simple.php.d/input.php\
+    Units/parser-php.r/traits.php.d/expected.tags\
+    Units/parser-php.r/traits.php.d/input.php\
+    Units/parser-php.r/whitespaces.php.d/expected.tags\
+    Units/parser-php.r/whitespaces.php.d/input.php\
+    Units/parser-puppetManifest.r/README\
+    Units/parser-puppetManifest.r/node.d/args.ctags\
+    Units/parser-puppetManifest.r/node.d/expected.tags\
+    Units/parser-puppetManifest.r/node.d/input.pp\
+    Units/parser-puppetManifest.r/puppet-aliastest.d/args.ctags\
+    Units/parser-puppetManifest.r/puppet-aliastest.d/expected.tags\
+    Units/parser-puppetManifest.r/puppet-aliastest.d/input.pp\
+    Units/parser-puppetManifest.r/puppet-append.d/args.ctags\
+    Units/parser-puppetManifest.r/puppet-append.d/expected.tags\
+    Units/parser-puppetManifest.r/puppet-append.d/input.pp\
+    Units/parser-puppetManifest.r/puppet-argumentdefaults.d/args.ctags\
+    Units/parser-puppetManifest.r/puppet-argumentdefaults.d/expected.tags\
+    Units/parser-puppetManifest.r/puppet-argumentdefaults.d/input.pp\
+    Units/parser-puppetManifest.r/puppet-arithmetic_expression.d/args.ctags\
+    Units/parser-puppetManifest.r/puppet-arithmetic_expression.d/expected.tags\
+    Units/parser-puppetManifest.r/puppet-arithmetic_expression.d/input.pp\
+    Units/parser-puppetManifest.r/puppet-arraytrailingcomma.d/args.ctags\
+    Units/parser-puppetManifest.r/puppet-arraytrailingcomma.d/expected.tags\
+    Units/parser-puppetManifest.r/puppet-arraytrailingcomma.d/input.pp\
+    Units/parser-puppetManifest.r/puppet-casestatement.d/args.ctags\
+    Units/parser-puppetManifest.r/puppet-casestatement.d/expected.tags\
+    Units/parser-puppetManifest.r/puppet-casestatement.d/input.pp\
+    Units/parser-puppetManifest.r/puppet-classheirarchy.d/README\
+    Units/parser-puppetManifest.r/puppet-classheirarchy.d/args.ctags\
+    Units/parser-puppetManifest.r/puppet-classheirarchy.d/expected.tags\
+    Units/parser-puppetManifest.r/puppet-classheirarchy.d/input.pp\
+    Units/parser-puppetManifest.r/puppet-classincludes.d/args.ctags\
+    Units/parser-puppetManifest.r/puppet-classincludes.d/expected.tags\
+    Units/parser-puppetManifest.r/puppet-classincludes.d/input.pp\
+    Units/parser-puppetManifest.r/puppet-classpathtest.d/args.ctags\
+    Units/parser-puppetManifest.r/puppet-classpathtest.d/expected.tags\
+    Units/parser-puppetManifest.r/puppet-classpathtest.d/input.pp\
+    Units/parser-puppetManifest.r/puppet-collection.d/args.ctags\
+    Units/parser-puppetManifest.r/puppet-collection.d/expected.tags\
+    Units/parser-puppetManifest.r/puppet-collection.d/input.pp\
+    Units/parser-puppetManifest.r/puppet-collection_override.d/args.ctags\
+    Units/parser-puppetManifest.r/puppet-collection_override.d/expected.tags\
+    Units/parser-puppetManifest.r/puppet-collection_override.d/input.pp\
+    Units/parser-puppetManifest.r/puppet-collection_within_virtual_definitions.d/args.ctags\
+    Units/parser-puppetManifest.r/puppet-collection_within_virtual_definitions.d/expected.tags\
+    Units/parser-puppetManifest.r/puppet-collection_within_virtual_definitions.d/input.pp\
+    Units/parser-puppetManifest.r/puppet-componentmetaparams.d/args.ctags\
+    Units/parser-puppetManifest.r/puppet-componentmetaparams.d/expected.tags\
+    Units/parser-puppetManifest.r/puppet-componentmetaparams.d/input.pp\
+    Units/parser-puppetManifest.r/puppet-componentrequire.d/args.ctags\
+    Units/parser-puppetManifest.r/puppet-componentrequire.d/expected.tags\
+    Units/parser-puppetManifest.r/puppet-componentrequire.d/input.pp\
+    Units/parser-puppetManifest.r/puppet-deepclassheirarchy.d/args.ctags\
+    Units/parser-puppetManifest.r/puppet-deepclassheirarchy.d/expected.tags\
+    Units/parser-puppetManifest.r/puppet-deepclassheirarchy.d/input.pp\
+    Units/parser-puppetManifest.r/puppet-defineoverrides.d/args.ctags\
+    Units/parser-puppetManifest.r/puppet-defineoverrides.d/expected.tags\
+    Units/parser-puppetManifest.r/puppet-defineoverrides.d/input.pp\
+    Units/parser-puppetManifest.r/puppet-emptyclass.d/args.ctags\
+    Units/parser-puppetManifest.r/puppet-emptyclass.d/expected.tags\
+    Units/parser-puppetManifest.r/puppet-emptyclass.d/input.pp\
+    Units/parser-puppetManifest.r/puppet-emptyexec.d/args.ctags\
+    Units/parser-puppetManifest.r/puppet-emptyexec.d/expected.tags\
+    Units/parser-puppetManifest.r/puppet-emptyexec.d/input.pp\
+    Units/parser-puppetManifest.r/puppet-emptyifelse.d/args.ctags\
+    Units/parser-puppetManifest.r/puppet-emptyifelse.d/expected.tags\
+    Units/parser-puppetManifest.r/puppet-emptyifelse.d/input.pp\
+    Units/parser-puppetManifest.r/puppet-falsevalues.d/args.ctags\
+    Units/parser-puppetManifest.r/puppet-falsevalues.d/expected.tags\
+    Units/parser-puppetManifest.r/puppet-falsevalues.d/input.pp\
+    Units/parser-puppetManifest.r/puppet-filecreate.d/args.ctags\
+    Units/parser-puppetManifest.r/puppet-filecreate.d/expected.tags\
+    Units/parser-puppetManifest.r/puppet-filecreate.d/input.pp\
+    Units/parser-puppetManifest.r/puppet-fqdefinition.d/args.ctags\
+    Units/parser-puppetManifest.r/puppet-fqdefinition.d/expected.tags\
+    Units/parser-puppetManifest.r/puppet-fqdefinition.d/input.pp\
+    Units/parser-puppetManifest.r/puppet-fqparents.d/args.ctags\
+    Units/parser-puppetManifest.r/puppet-fqparents.d/expected.tags\
+    Units/parser-puppetManifest.r/puppet-fqparents.d/input.pp\
+    Units/parser-puppetManifest.r/puppet-funccomma.d/args.ctags\
+    Units/parser-puppetManifest.r/puppet-funccomma.d/expected.tags\
+    Units/parser-puppetManifest.r/puppet-funccomma.d/input.pp\
+    Units/parser-puppetManifest.r/puppet-hash.d/args.ctags\
+    Units/parser-puppetManifest.r/puppet-hash.d/expected.tags\
+    Units/parser-puppetManifest.r/puppet-hash.d/input.pp\
+    Units/parser-puppetManifest.r/puppet-ifexpression.d/args.ctags\
+    Units/parser-puppetManifest.r/puppet-ifexpression.d/expected.tags\
+    Units/parser-puppetManifest.r/puppet-ifexpression.d/input.pp\
+    Units/parser-puppetManifest.r/puppet-implicititeration.d/args.ctags\
+    Units/parser-puppetManifest.r/puppet-implicititeration.d/expected.tags\
+    Units/parser-puppetManifest.r/puppet-implicititeration.d/input.pp\
+    Units/parser-puppetManifest.r/puppet-multilinecomments.d/args.ctags\
+    Units/parser-puppetManifest.r/puppet-multilinecomments.d/expected.tags\
+    Units/parser-puppetManifest.r/puppet-multilinecomments.d/input.pp\
+    Units/parser-puppetManifest.r/puppet-multipleclass.d/args.ctags\
+    Units/parser-puppetManifest.r/puppet-multipleclass.d/expected.tags\
+    Units/parser-puppetManifest.r/puppet-multipleclass.d/input.pp\
+    Units/parser-puppetManifest.r/puppet-multipleinstances.d/args.ctags\
+    Units/parser-puppetManifest.r/puppet-multipleinstances.d/expected.tags\
+    Units/parser-puppetManifest.r/puppet-multipleinstances.d/input.pp\
+    Units/parser-puppetManifest.r/puppet-multisubs.d/args.ctags\
+    Units/parser-puppetManifest.r/puppet-multisubs.d/expected.tags\
+    Units/parser-puppetManifest.r/puppet-multisubs.d/input.pp\
+    Units/parser-puppetManifest.r/puppet-namevartest.d/args.ctags\
+    Units/parser-puppetManifest.r/puppet-namevartest.d/expected.tags\
+    Units/parser-puppetManifest.r/puppet-namevartest.d/input.pp\
+    Units/parser-puppetManifest.r/puppet-scopetest.d/args.ctags\
+    Units/parser-puppetManifest.r/puppet-scopetest.d/expected.tags\
+    Units/parser-puppetManifest.r/puppet-scopetest.d/input.pp\
+    Units/parser-puppetManifest.r/puppet-selectorvalues.d/args.ctags\
+    Units/parser-puppetManifest.r/puppet-selectorvalues.d/expected.tags\
+    Units/parser-puppetManifest.r/puppet-selectorvalues.d/input.pp\
+    Units/parser-puppetManifest.r/puppet-simpledefaults.d/args.ctags\
+    Units/parser-puppetManifest.r/puppet-simpledefaults.d/expected.tags\
+    Units/parser-puppetManifest.r/puppet-simpledefaults.d/input.pp\
+    Units/parser-puppetManifest.r/puppet-simpleselector.d/args.ctags\
+    Units/parser-puppetManifest.r/puppet-simpleselector.d/expected.tags\
+    Units/parser-puppetManifest.r/puppet-simpleselector.d/input.pp\
+    Units/parser-puppetManifest.r/puppet-singleary.d/args.ctags\
+    Units/parser-puppetManifest.r/puppet-singleary.d/expected.tags\
+    Units/parser-puppetManifest.r/puppet-singleary.d/input.pp\
+    Units/parser-puppetManifest.r/puppet-singlequote.d/args.ctags\
+    Units/parser-puppetManifest.r/puppet-singlequote.d/expected.tags\
+    Units/parser-puppetManifest.r/puppet-singlequote.d/input.pp\
+    Units/parser-puppetManifest.r/puppet-singleselector.d/args.ctags\
+    Units/parser-puppetManifest.r/puppet-singleselector.d/expected.tags\
+    Units/parser-puppetManifest.r/puppet-singleselector.d/input.pp\
+    Units/parser-puppetManifest.r/puppet-subclass_name_duplication.d/args.ctags\
+    Units/parser-puppetManifest.r/puppet-subclass_name_duplication.d/expected.tags\
+    Units/parser-puppetManifest.r/puppet-subclass_name_duplication.d/input.pp\
+    Units/parser-puppetManifest.r/puppet-tag.b/README\
+    Units/parser-puppetManifest.r/puppet-tag.b/args.ctags\
+    Units/parser-puppetManifest.r/puppet-tag.b/input.pp\
+    Units/parser-puppetManifest.r/puppet-tagged.b/README\
+    Units/parser-puppetManifest.r/puppet-tagged.b/args.ctags\
+    Units/parser-puppetManifest.r/puppet-tagged.b/input.pp\
+    Units/parser-puppetManifest.r/puppet-virtualresources.b/args.ctags\
+    Units/parser-puppetManifest.r/puppet-virtualresources.b/expected.tags\
+    Units/parser-puppetManifest.r/puppet-virtualresources.b/input.pp\
+    Units/parser-puppetManifest.r/unless.d/args.ctags\
+    Units/parser-puppetManifest.r/unless.d/expected.tags\
+    Units/parser-puppetManifest.r/unless.d/input.pp\
+    Units/parser-python.r/async.d/args.ctags\
+    Units/parser-python.r/async.d/expected.tags\
+    Units/parser-python.r/async.d/input.py\
+    Units/parser-python.r/blanks.d/expected.tags\
+    Units/parser-python.r/blanks.d/input.py\
+    Units/parser-python.r/bug1764148.d/args.ctags\
+    Units/parser-python.r/bug1764148.d/expected.tags\
+    Units/parser-python.r/bug1764148.d/input.bug1764148\
+    Units/parser-python.r/bug1809024.py.d/expected.tags\
+    Units/parser-python.r/bug1809024.py.d/input.py\
+    Units/parser-python.r/bug1856363.py.d/expected.tags\
+    Units/parser-python.r/bug1856363.py.d/input.py\
+    Units/parser-python.r/bug1906062.py.d/expected.tags\
+    Units/parser-python.r/bug1906062.py.d/input.py\
+    Units/parser-python.r/bug1988026.py.d/expected.tags\
+    Units/parser-python.r/bug1988026.py.d/input.py\
+    Units/parser-python.r/bug1988027.py.d/expected.tags\
+    Units/parser-python.r/bug1988027.py.d/input.py\
+    Units/parser-python.r/bug1988130.py.d/expected.tags\
+    Units/parser-python.r/bug1988130.py.d/input.py\
+    Units/parser-python.r/bug2075402.py.d/expected.tags\
+    Units/parser-python.r/bug2075402.py.d/input.py\
+    Units/parser-python.r/bug3168705.py.d/expected.tags\
+    Units/parser-python.r/bug3168705.py.d/input.py\
+    Units/parser-python.r/bug699171.py.d/expected.tags\
+    Units/parser-python.r/bug699171.py.d/input.py\
+    Units/parser-python.r/cython-external.d/expected.tags\
+    Units/parser-python.r/cython-external.d/input.pyx\
+    Units/parser-python.r/cython_sample.pyx.d/expected.tags\
+    Units/parser-python.r/cython_sample.pyx.d/input.pyx\
+    Units/parser-python.r/cython_sample2.d/args.ctags\
+    Units/parser-python.r/cython_sample2.d/expected.tags\
+    Units/parser-python.r/cython_sample2.d/input.pyx\
+    Units/parser-python.r/dotted-variable-leftovers.d/expected.tags\
+    Units/parser-python.r/dotted-variable-leftovers.d/input.py\
+    Units/parser-python.r/f-strings.d/args.ctags\
+    Units/parser-python.r/f-strings.d/expected.tags\
+    Units/parser-python.r/f-strings.d/input.py\
+    Units/parser-python.r/matrix-multiplication-operator.d/args.ctags\
+    Units/parser-python.r/matrix-multiplication-operator.d/expected.tags\
+    Units/parser-python.r/matrix-multiplication-operator.d/input.py\
+    Units/parser-python.r/multiline-arglist.d/args.ctags\
+    Units/parser-python.r/multiline-arglist.d/expected.tags\
+    Units/parser-python.r/multiline-arglist.d/input.py\
+    Units/parser-python.r/multiline-class-def.d/expected.tags\
+    Units/parser-python.r/multiline-class-def.d/input.py\
+    Units/parser-python.r/multiline-def.d/expected.tags\
+    Units/parser-python.r/multiline-def.d/input.py\
+    Units/parser-python.r/nested-parenthesis.d/args.ctags\
+    Units/parser-python.r/nested-parenthesis.d/expected.tags\
+    Units/parser-python.r/nested-parenthesis.d/input.py\
+    Units/parser-python.r/newlines-cr.b/README\
+    Units/parser-python.r/newlines-cr.b/expected.tags\
+    Units/parser-python.r/newlines-cr.b/input.py\
+    Units/parser-python.r/newlines-crlf.d/expected.tags\
+    Units/parser-python.r/newlines-crlf.d/input.py\
+    Units/parser-python.r/py-skipped-string.d/expected.tags\
+    Units/parser-python.r/py-skipped-string.d/input.py\
+    Units/parser-python.r/python-access.d/args.ctags\
+    Units/parser-python.r/python-access.d/expected.tags\
+    Units/parser-python.r/python-access.d/input.py\
+    Units/parser-python.r/python-anonymous-nestlevel_ctags-bug-356.d/expected.tags\
+    Units/parser-python.r/python-anonymous-nestlevel_ctags-bug-356.d/input.py\
+    Units/parser-python.r/python-arguments.d/args.ctags\
+    Units/parser-python.r/python-arguments.d/expected.tags\
+    Units/parser-python.r/python-arguments.d/input.py\
+    Units/parser-python.r/python-comments.d/args.ctags\
+    Units/parser-python.r/python-comments.d/expected.tags\
+    Units/parser-python.r/python-comments.d/input.py\
+    Units/parser-python.r/python-decorators.d/args.ctags\
+    Units/parser-python.r/python-decorators.d/expected.tags\
+    Units/parser-python.r/python-decorators.d/input.py\
+    Units/parser-python.r/python-disable-member-kind.d/args.ctags\
+    Units/parser-python.r/python-disable-member-kind.d/input.py\
+    Units/parser-python.r/python-dot-in-import.d/args.ctags\
+    Units/parser-python.r/python-dot-in-import.d/expected.tags\
+    Units/parser-python.r/python-dot-in-import.d/input.py\
+    Units/parser-python.r/python-dotted-variable.d/README\
+    Units/parser-python.r/python-dotted-variable.d/expected.tags\
+    Units/parser-python.r/python-dotted-variable.d/input.py\
+    Units/parser-python.r/python-end-field.d/args.ctags\
+    Units/parser-python.r/python-end-field.d/expected.tags\
+    Units/parser-python.r/python-end-field.d/input.py\
+    Units/parser-python.r/python-fullqualified-tags.d/args.ctags\
+    Units/parser-python.r/python-fullqualified-tags.d/expected.tags\
+    Units/parser-python.r/python-fullqualified-tags.d/input.py\
+    Units/parser-python.r/python-geany-bug-612.d/expected.tags\
+    Units/parser-python.r/python-geany-bug-612.d/input.py\
+    Units/parser-python.r/python-import.d/args.ctags\
+    Units/parser-python.r/python-import.d/expected.tags\
+    Units/parser-python.r/python-import.d/input.py\
+    Units/parser-python.r/python-keyword-tabulation.d/expected.tags\
+    Units/parser-python.r/python-keyword-tabulation.d/input.py\
+    Units/parser-python.r/python-local-lambdas.d/expected.tags\
+    Units/parser-python.r/python-local-lambdas.d/input.py\
+    Units/parser-python.r/python-local-variables.d/args.ctags\
+    Units/parser-python.r/python-local-variables.d/expected.tags\
+    Units/parser-python.r/python-local-variables.d/input.py\
+    Units/parser-python.r/python-multivar-no-declaration.d/expected.tags\
+    Units/parser-python.r/python-multivar-no-declaration.d/input.py\
+    Units/parser-python.r/python-multivar-statement-with-lambdas.d/expected.tags\
+    Units/parser-python.r/python-multivar-statement-with-lambdas.d/input.py\
+    Units/parser-python.r/python-multivar-statement.d/expected.tags\
+    Units/parser-python.r/python-multivar-statement.d/input.py\
+    Units/parser-python.r/python-semicolon.d/expected.tags\
+    Units/parser-python.r/python-semicolon.d/input.py\
+    Units/parser-python.r/python2-arglists.d/args.ctags\
+    Units/parser-python.r/python2-arglists.d/expected.tags\
+    Units/parser-python.r/python2-arglists.d/input.py\
+    Units/parser-python.r/python3-arglists.d/args.ctags\
+    Units/parser-python.r/python3-arglists.d/expected.tags\
+    Units/parser-python.r/python3-arglists.d/input.py\
+    Units/parser-python.r/python3-function-annotations.d/args.ctags\
+    Units/parser-python.r/python3-function-annotations.d/expected.tags\
+    Units/parser-python.r/python3-function-annotations.d/input.py\
+    Units/parser-python.r/simple.py.d/args.ctags\
+    Units/parser-python.r/simple.py.d/expected.tags\
+    Units/parser-python.r/simple.py.d/input.py\
+    Units/parser-python.r/strings.d/expected.tags\
+    Units/parser-python.r/strings.d/input.py\
+    Units/parser-python.r/tabindent.py.d/expected.tags\
+    Units/parser-python.r/tabindent.py.d/input.py\
+    Units/parser-python.r/test.py.d/expected.tags\
+    Units/parser-python.r/test.py.d/input.py\
+    Units/parser-python.r/toplevel-funcall-with-keyword-args.d/expected.tags\
+    Units/parser-python.r/toplevel-funcall-with-keyword-args.d/input.py\
+    Units/parser-python.r/triple-quotes-after-def.d/expected.tags\
+    Units/parser-python.r/triple-quotes-after-def.d/input.py\
+    Units/parser-python.r/triple-quotes-in-class.d/expected.tags\
+    Units/parser-python.r/triple-quotes-in-class.d/input.py\
+    Units/parser-python.r/triple-quotes-in-default-arg.d/expected.tags\
+    Units/parser-python.r/triple-quotes-in-default-arg.d/input.py\
+    Units/parser-python.r/triple-quotes-in-list.d/expected.tags\
+    Units/parser-python.r/triple-quotes-in-list.d/input.py\
+    Units/parser-python.r/triple-quotes.d/expected.tags\
+    Units/parser-python.r/triple-quotes.d/input.py\
+    Units/parser-python.r/underscore-numeric-literals.d/args.ctags\
+    Units/parser-python.r/underscore-numeric-literals.d/expected.tags\
+    Units/parser-python.r/underscore-numeric-literals.d/input.py\
+    Units/parser-python.r/variable-annotations.d/args.ctags\
+    Units/parser-python.r/variable-annotations.d/expected.tags\
+    Units/parser-python.r/variable-annotations.d/input.py\
+    Units/parser-qemuhx.r/disable.d/README\
+    Units/parser-qemuhx.r/disable.d/args.ctags\
+    Units/parser-qemuhx.r/disable.d/expected.tags\
+    Units/parser-qemuhx.r/disable.d/input.hx\
+    Units/parser-qemuhx.r/enable.d/README\
+    Units/parser-qemuhx.r/enable.d/args.ctags\
+    Units/parser-qemuhx.r/enable.d/expected.tags\
+    Units/parser-qemuhx.r/enable.d/input.hx\
+    Units/parser-r.r/r-extended.d/expected.tags\
+    Units/parser-r.r/r-extended.d/input.r\
+    Units/parser-r.r/r-simple.d/expected.tags\
+    Units/parser-r.r/r-simple.d/input.r\
+    Units/parser-r.r/r-uppercase-extension.d/expected.tags\
+    Units/parser-r.r/r-uppercase-extension.d/input.R\
+    Units/parser-relaxng.r/element.d/args.ctags\
+    Units/parser-relaxng.r/element.d/expected.tags\
+    Units/parser-relaxng.r/element.d/features\
+    Units/parser-relaxng.r/element.d/input.rng\
+    Units/parser-relaxng.r/grammar.d/args.ctags\
+    Units/parser-relaxng.r/grammar.d/expected.tags\
+    Units/parser-relaxng.r/grammar.d/features\
+    Units/parser-relaxng.r/grammar.d/input.rng\
+    Units/parser-restructuredtext.r/iso8859-1-restructuredtext.d/expected.tags\
+    Units/parser-restructuredtext.r/iso8859-1-restructuredtext.d/input.rst\
+    Units/parser-restructuredtext.r/simple-restructuredtext.d/args.ctags\
+    Units/parser-restructuredtext.r/simple-restructuredtext.d/expected.tags\
+    Units/parser-restructuredtext.r/simple-restructuredtext.d/input.rst\
+    Units/parser-restructuredtext.r/utf8-restructuredtext.d/expected.tags\
+    Units/parser-restructuredtext.r/utf8-restructuredtext.d/input.rst\
+    Units/parser-robot.r/dashes-in-identifiers.d/README\
+    Units/parser-robot.r/dashes-in-identifiers.d/expected.tags\
+    Units/parser-robot.r/dashes-in-identifiers.d/input.robot\
+    Units/parser-robot.r/keyword-started-from-varref.d/args.ctags\
+    Units/parser-robot.r/keyword-started-from-varref.d/expected.tags\
+    Units/parser-robot.r/keyword-started-from-varref.d/input.robot\
+    Units/parser-robot.r/simple-robot-no-extra.d/args.ctags\
+    Units/parser-robot.r/simple-robot-no-extra.d/expected.tags\
+    Units/parser-robot.r/simple-robot-no-extra.d/input.robot\
+    Units/parser-robot.r/simple-robot.d/args.ctags\
+    Units/parser-robot.r/simple-robot.d/expected.tags\
+    Units/parser-robot.r/simple-robot.d/input.robot\
+    Units/parser-ruby.r/bug1742588.rb.d/expected.tags\
+    Units/parser-ruby.r/bug1742588.rb.d/input.rb\
+    Units/parser-ruby.r/ruby-block-call.d/expected.tags\
+    Units/parser-ruby.r/ruby-block-call.d/input.rb\
+    Units/parser-ruby.r/ruby-class-method-in-lt-lt-self.d/expected.tags\
+    Units/parser-ruby.r/ruby-class-method-in-lt-lt-self.d/input.rb\
+    Units/parser-ruby.r/ruby-doc.d/expected.tags\
+    Units/parser-ruby.r/ruby-doc.d/input.rb\
+    Units/parser-ruby.r/ruby-geany-sf-bug-302.d/expected.tags\
+    Units/parser-ruby.r/ruby-geany-sf-bug-302.d/input.rb\
+    Units/parser-ruby.r/ruby-geany-sf-bug-542.d/expected.tags\
+    Units/parser-ruby.r/ruby-geany-sf-bug-542.d/input.rb\
+    Units/parser-ruby.r/ruby-kind-option.d/args.ctags\
+    Units/parser-ruby.r/ruby-kind-option.d/expected.tags\
+    Units/parser-ruby.r/ruby-kind-option.d/input.rb\
+    Units/parser-ruby.r/ruby-namespaced-class.d/expected.tags\
+    Units/parser-ruby.r/ruby-namespaced-class.d/input.rb\
+    Units/parser-ruby.r/ruby-scope-after-anonymous-class.d/expected.tags\
+    Units/parser-ruby.r/ruby-scope-after-anonymous-class.d/input.rb\
+    Units/parser-ruby.r/ruby-sf-bug-364.d/expected.tags\
+    Units/parser-ruby.r/ruby-sf-bug-364.d/input.rb\
+    Units/parser-ruby.r/simple.rb.d/expected.tags\
+    Units/parser-ruby.r/simple.rb.d/input.rb\
+    Units/parser-rust.r/rust-simple.d/args.ctags\
+    Units/parser-rust.r/rust-simple.d/expected.tags\
+    Units/parser-rust.r/rust-simple.d/features\
+    Units/parser-rust.r/rust-simple.d/input.rs\
+    Units/parser-rust.r/rust-test_input.d/args.ctags\
+    Units/parser-rust.r/rust-test_input.d/expected.tags\
+    Units/parser-rust.r/rust-test_input.d/input.rs\
+    Units/parser-rust.r/rust-test_input2.d/args.ctags\
+    Units/parser-rust.r/rust-test_input2.d/expected.tags\
+    Units/parser-rust.r/rust-test_input2.d/input.rs\
+    Units/parser-scheme.r/scheme-simple-define.d/expected.tags\
+    Units/parser-scheme.r/scheme-simple-define.d/input.scm\
+    Units/parser-scheme.r/scheme-simple-setbang.d/expected.tags\
+    Units/parser-scheme.r/scheme-simple-setbang.d/input.scm\
+    Units/parser-scheme.r/scheme-srfi-30-comment.b/expected.tags\
+    Units/parser-scheme.r/scheme-srfi-30-comment.b/input.scm\
+    Units/parser-scheme.r/scheme-string.b/expected.tags\
+    Units/parser-scheme.r/scheme-string.b/input.scm\
+    Units/parser-sh.r/function-identifiers-bash.d/expected.tags\
+    Units/parser-sh.r/function-identifiers-bash.d/input.bash\
+    Units/parser-sh.r/function-identifiers-no-function-keyword-bash.d/expected.tags\
+    Units/parser-sh.r/function-identifiers-no-function-keyword-bash.d/input.bash\
+    Units/parser-sh.r/sh-alias.d/expected.tags\
+    Units/parser-sh.r/sh-alias.d/input.sh\
+    Units/parser-sh.r/sh-comments.d/expected.tags\
+    Units/parser-sh.r/sh-comments.d/input.sh\
+    Units/parser-sh.r/sh-heredoc-broken.d/input.sh\
+    Units/parser-sh.r/sh-heredoc-broken2.d/input.sh\
+    Units/parser-sh.r/sh-heredoc-checks.d/args.ctags\
+    Units/parser-sh.r/sh-heredoc-checks.d/expected.tags\
+    Units/parser-sh.r/sh-heredoc-checks.d/input.sh\
+    Units/parser-sh.r/sh-heredoc-role.d/args.ctags\
+    Units/parser-sh.r/sh-heredoc-role.d/expected.tags\
+    Units/parser-sh.r/sh-heredoc-role.d/input.sh\
+    Units/parser-sh.r/sh-heredoc-run-guest-parser.d/args.ctags\
+    Units/parser-sh.r/sh-heredoc-run-guest-parser.d/expected.tags\
+    Units/parser-sh.r/sh-heredoc-run-guest-parser.d/input.sh\
+    Units/parser-sh.r/sh-heredoc.d/args.ctags\
+    Units/parser-sh.r/sh-heredoc.d/expected.tags\
+    Units/parser-sh.r/sh-heredoc.d/input.sh\
+    Units/parser-sh.r/sh-herestring.d/expected.tags\
+    Units/parser-sh.r/sh-herestring.d/input.sh\
+    Units/parser-sh.r/sh-modeline-1-emacs-shell-script.d/args.ctags\
+    Units/parser-sh.r/sh-modeline-1-emacs-shell-script.d/expected.tags\
+    Units/parser-sh.r/sh-modeline-1-emacs-shell-script.d/input.nolang\
+    Units/parser-sh.r/sh-modeline-2-emacs-shell-script.d/args.ctags\
+    Units/parser-sh.r/sh-modeline-2-emacs-shell-script.d/expected.tags\
+    Units/parser-sh.r/sh-modeline-2-emacs-shell-script.d/input.nolang\
+    Units/parser-sh.r/sh-modeline-at-eof-emacs-shell-script.d/args.ctags\
+    Units/parser-sh.r/sh-modeline-at-eof-emacs-shell-script.d/expected.tags\
+    Units/parser-sh.r/sh-modeline-at-eof-emacs-shell-script.d/input.nolang\
+    Units/parser-sh.r/sh-quoted-func.d/expected.tags\
+    Units/parser-sh.r/sh-quoted-func.d/input.sh\
+    Units/parser-sh.r/sh-quotes.d/expected.tags\
+    Units/parser-sh.r/sh-quotes.d/input.sh\
+    Units/parser-sh.r/sh-source.d/args.ctags\
+    Units/parser-sh.r/sh-source.d/expected.tags\
+    Units/parser-sh.r/sh-source.d/input.sh\
+    Units/parser-sh.r/sh-spaces-in-funcdef.d/expected.tags\
+    Units/parser-sh.r/sh-spaces-in-funcdef.d/input.sh\
+    Units/parser-sh.r/sh-statements.d/expected.tags\
+    Units/parser-sh.r/sh-statements.d/input.sh\
+    Units/parser-sh.r/simple.ksh.d/expected.tags\
+    Units/parser-sh.r/simple.ksh.d/input.ksh\
+    Units/parser-sh.r/simple.sh.d/README\
+    Units/parser-sh.r/simple.sh.d/expected.tags\
+    Units/parser-sh.r/simple.sh.d/input.sh\
+    Units/parser-sql.r/3184782.sql.d/expected.tags\
+    Units/parser-sql.r/3184782.sql.d/input.sql\
+    Units/parser-sql.r/bug1324663.sql.d/args.ctags\
+    Units/parser-sql.r/bug1324663.sql.d/expected.tags\
+    Units/parser-sql.r/bug1324663.sql.d/input.sql\
+    Units/parser-sql.r/bug1428714.sql.d/args.ctags\
+    Units/parser-sql.r/bug1428714.sql.d/expected.tags\
+    Units/parser-sql.r/bug1428714.sql.d/input.sql\
+    Units/parser-sql.r/bug1570779.sql.d/args.ctags\
+    Units/parser-sql.r/bug1570779.sql.d/expected.tags\
+    Units/parser-sql.r/bug1570779.sql.d/input.sql\
+    Units/parser-sql.r/bug1938565.sql.d/expected.tags\
+    Units/parser-sql.r/bug1938565.sql.d/input.sql\
+    Units/parser-sql.r/bug1944150.sql.d/expected.tags\
+    Units/parser-sql.r/bug1944150.sql.d/input.sql\
+    Units/parser-sql.r/bug2961855.sql.d/args.ctags\
+    Units/parser-sql.r/bug2961855.sql.d/expected.tags\
+    Units/parser-sql.r/bug2961855.sql.d/input.sql\
+    Units/parser-sql.r/bug629115.sql.d/expected.tags\
+    Units/parser-sql.r/bug629115.sql.d/input.sql\
+    Units/parser-sql.r/bug722501.sql.d/args.ctags\
+    Units/parser-sql.r/bug722501.sql.d/expected.tags\
+    Units/parser-sql.r/bug722501.sql.d/input.sql\
+    Units/parser-sql.r/bug823000.sql.d/expected.tags\
+    Units/parser-sql.r/bug823000.sql.d/input.sql\
+    Units/parser-sql.r/countall.sql.d/args.ctags\
+    Units/parser-sql.r/countall.sql.d/expected.tags\
+    Units/parser-sql.r/countall.sql.d/input.sql\
+    Units/parser-sql.r/db-trig.sql.d/args.ctags\
+    Units/parser-sql.r/db-trig.sql.d/expected.tags\
+    Units/parser-sql.r/db-trig.sql.d/input.sql\
+    Units/parser-sql.r/hex2dec.sql.d/expected.tags\
+    Units/parser-sql.r/hex2dec.sql.d/input.sql\
+    Units/parser-sql.r/labels.sql.r/expected.tags\
+    Units/parser-sql.r/labels.sql.r/input.sql\
+    Units/parser-sql.r/partial.d/input.sql\
+    Units/parser-sql.r/random.sql.d/args.ctags\
+    Units/parser-sql.r/random.sql.d/expected.tags\
+    Units/parser-sql.r/random.sql.d/input.sql\
+    Units/parser-sql.r/readlob.sql.d/args.ctags\
+    Units/parser-sql.r/readlob.sql.d/expected.tags\
+    Units/parser-sql.r/readlob.sql.d/input.sql\
+    Units/parser-sql.r/readlong.sql.d/args.ctags\
+    Units/parser-sql.r/readlong.sql.d/expected.tags\
+    Units/parser-sql.r/readlong.sql.d/input.sql\
+    Units/parser-sql.r/refcurs.sql.d/args.ctags\
+    Units/parser-sql.r/refcurs.sql.d/expected.tags\
+    Units/parser-sql.r/refcurs.sql.d/input.sql\
+    Units/parser-sql.r/sql_pgSQL_dollar_quote.d/expected.tags\
+    Units/parser-sql.r/sql_pgSQL_dollar_quote.d/input.sql\
+    Units/parser-sql.r/sql_pgSQL_dollar_quote_complicated.d/expected.tags\
+    Units/parser-sql.r/sql_pgSQL_dollar_quote_complicated.d/input.sql\
+    Units/parser-sql.r/sql_pgSQL_empty_decl.d/expected.tags\
+    Units/parser-sql.r/sql_pgSQL_empty_decl.d/input.sql\
+    Units/parser-sql.r/sql_pgSQL_with_function_x.d/expected.tags\
+    Units/parser-sql.r/sql_pgSQL_with_function_x.d/input.sql\
+    Units/parser-sql.r/sql_single_quote.sql.d/expected.tags\
+    Units/parser-sql.r/sql_single_quote.sql.d/input.sql\
+    Units/parser-tcl.r/comments.tcl.d/args.ctags\
+    Units/parser-tcl.r/comments.tcl.d/expected.tags\
+    Units/parser-tcl.r/comments.tcl.d/input.tcl\
+    Units/parser-tcl.r/end-of-cmdline.d/expected.tags\
+    Units/parser-tcl.r/end-of-cmdline.d/input.tcl\
+    Units/parser-tcl.r/namespace.d/args.ctags\
+    Units/parser-tcl.r/namespace.d/expected.tags\
+    Units/parser-tcl.r/namespace.d/input.tcl\
+    Units/parser-tcl.r/simple.tcl.d/expected.tags\
+    Units/parser-tcl.r/simple.tcl.d/input.tcl\
+    Units/parser-tcl.r/tcl-issue-1368.d/expected.tags\
+    Units/parser-tcl.r/tcl-issue-1368.d/input.tcl\
+    Units/parser-tcloo.r/namespace-class.d/args.ctags\
+    Units/parser-tcloo.r/namespace-class.d/expected.tags\
+    Units/parser-tcloo.r/namespace-class.d/input.tcl\
+    Units/parser-tcloo.r/namespace-wildcard.d/args.ctags\
+    Units/parser-tcloo.r/namespace-wildcard.d/expected.tags\
+    Units/parser-tcloo.r/namespace-wildcard.d/input.tcl\
+    Units/parser-tcloo.r/simple-tcloo.d/args.ctags\
+    Units/parser-tcloo.r/simple-tcloo.d/expected.tags\
+    Units/parser-tcloo.r/simple-tcloo.d/input.tcl\
+    Units/parser-tex.r/cleveref-label.d/expected.tags\
+    Units/parser-tex.r/cleveref-label.d/input.tex\
+    Units/parser-ttcn.r/ttcn-altstep.d/args.ctags\
+    Units/parser-ttcn.r/ttcn-altstep.d/expected.tags\
+    Units/parser-ttcn.r/ttcn-altstep.d/input.ttcn\
+    Units/parser-ttcn.r/ttcn-comments.d/args.ctags\
+    Units/parser-ttcn.r/ttcn-comments.d/expected.tags\
+    Units/parser-ttcn.r/ttcn-comments.d/input.ttcn\
+    Units/parser-ttcn.r/ttcn-component.d/args.ctags\
+    Units/parser-ttcn.r/ttcn-component.d/expected.tags\
+    Units/parser-ttcn.r/ttcn-component.d/input.ttcn\
+    Units/parser-ttcn.r/ttcn-constants.d/args.ctags\
+    Units/parser-ttcn.r/ttcn-constants.d/expected.tags\
+    Units/parser-ttcn.r/ttcn-constants.d/input.ttcn\
+    Units/parser-ttcn.r/ttcn-enum.d/args.ctags\
+    Units/parser-ttcn.r/ttcn-enum.d/expected.tags\
+    Units/parser-ttcn.r/ttcn-enum.d/input.ttcn\
+    Units/parser-ttcn.r/ttcn-function.d/args.ctags\
+    Units/parser-ttcn.r/ttcn-function.d/expected.tags\
+    Units/parser-ttcn.r/ttcn-function.d/input.ttcn\
+    Units/parser-ttcn.r/ttcn-group.d/args.ctags\
+    Units/parser-ttcn.r/ttcn-group.d/expected.tags\
+    Units/parser-ttcn.r/ttcn-group.d/input.ttcn\
+    Units/parser-ttcn.r/ttcn-module.d/args.ctags\
+    Units/parser-ttcn.r/ttcn-module.d/expected.tags\
+    Units/parser-ttcn.r/ttcn-module.d/input.ttcn\
+    Units/parser-ttcn.r/ttcn-numbers.d/args.ctags\
+    Units/parser-ttcn.r/ttcn-numbers.d/expected.tags\
+    Units/parser-ttcn.r/ttcn-numbers.d/input.ttcn\
+    Units/parser-ttcn.r/ttcn-signature.d/args.ctags\
+    Units/parser-ttcn.r/ttcn-signature.d/expected.tags\
+    Units/parser-ttcn.r/ttcn-signature.d/input.ttcn\
+    Units/parser-ttcn.r/ttcn-strings.d/args.ctags\
+    Units/parser-ttcn.r/ttcn-strings.d/expected.tags\
+    Units/parser-ttcn.r/ttcn-strings.d/input.ttcn\
+    Units/parser-ttcn.r/ttcn-template.d/args.ctags\
+    Units/parser-ttcn.r/ttcn-template.d/expected.tags\
+    Units/parser-ttcn.r/ttcn-template.d/input.ttcn\
+    Units/parser-ttcn.r/ttcn-testcase.d/args.ctags\
+    Units/parser-ttcn.r/ttcn-testcase.d/expected.tags\
+    Units/parser-ttcn.r/ttcn-testcase.d/input.ttcn\
+    Units/parser-ttcn.r/ttcn-timer.d/args.ctags\
+    Units/parser-ttcn.r/ttcn-timer.d/expected.tags\
+    Units/parser-ttcn.r/ttcn-timer.d/input.ttcn\
+    Units/parser-ttcn.r/ttcn-types.d/args.ctags\
+    Units/parser-ttcn.r/ttcn-types.d/expected.tags\
+    Units/parser-ttcn.r/ttcn-types.d/input.ttcn\
+    Units/parser-ttcn.r/ttcn-variables.d/args.ctags\
+    Units/parser-ttcn.r/ttcn-variables.d/expected.tags\
+    Units/parser-ttcn.r/ttcn-variables.d/input.ttcn\
+    Units/parser-verilog.r/systemverilog-assertion.d/args.ctags\
+    Units/parser-verilog.r/systemverilog-assertion.d/expected.tags\
+    Units/parser-verilog.r/systemverilog-assertion.d/input.sv\
+    Units/parser-verilog.r/systemverilog-basic.d/args.ctags\
+    Units/parser-verilog.r/systemverilog-basic.d/expected.tags\
+    Units/parser-verilog.r/systemverilog-basic.d/input.sv\
+    Units/parser-verilog.r/systemverilog-class.d/args.ctags\
+    Units/parser-verilog.r/systemverilog-class.d/expected.tags\
+    Units/parser-verilog.r/systemverilog-class.d/input.sv\
+    Units/parser-verilog.r/systemverilog-covergroup.d/args.ctags\
+    Units/parser-verilog.r/systemverilog-covergroup.d/expected.tags\
+    Units/parser-verilog.r/systemverilog-covergroup.d/input.sv\
+    Units/parser-verilog.r/systemverilog-github646.d/expected.tags\
+    Units/parser-verilog.r/systemverilog-github646.d/input.sv\
+    Units/parser-verilog.r/systemverilog-interface.d/args.ctags\
+    Units/parser-verilog.r/systemverilog-interface.d/expected.tags\
+    Units/parser-verilog.r/systemverilog-interface.d/input.sv\
+    Units/parser-verilog.r/systemverilog-nocontext.d/args.ctags\
+    Units/parser-verilog.r/systemverilog-nocontext.d/expected.tags\
+    Units/parser-verilog.r/systemverilog-nocontext.d/input.sv\
+    Units/parser-verilog.r/systemverilog-package.d/args.ctags\
+    Units/parser-verilog.r/systemverilog-package.d/expected.tags\
+    Units/parser-verilog.r/systemverilog-package.d/input.sv\
+    Units/parser-verilog.r/systemverilog-program.d/args.ctags\
+    Units/parser-verilog.r/systemverilog-program.d/expected.tags\
+    Units/parser-verilog.r/systemverilog-program.d/input.sv\
+    Units/parser-verilog.r/systemverilog-qualifiers.d/args.ctags\
+    Units/parser-verilog.r/systemverilog-qualifiers.d/expected.tags\
+    Units/parser-verilog.r/systemverilog-qualifiers.d/input.sv\
+    Units/parser-verilog.r/systemverilog-typedef.d/args.ctags\
+    Units/parser-verilog.r/systemverilog-typedef.d/expected.tags\
+    Units/parser-verilog.r/systemverilog-typedef.d/input.sv\
+    Units/parser-verilog.r/verilog-2001.d/args.ctags\
+    Units/parser-verilog.r/verilog-2001.d/expected.tags\
+    Units/parser-verilog.r/verilog-2001.d/input.v\
+    Units/parser-verilog.r/verilog-basic.d/args.ctags\
+    Units/parser-verilog.r/verilog-basic.d/expected.tags\
+    Units/parser-verilog.r/verilog-basic.d/input.v\
+    Units/parser-verilog.r/verilog-github624.d/expected.tags\
+    Units/parser-verilog.r/verilog-github624.d/input.v\
+    Units/parser-verilog.r/verilog-memleak.d/expected.tags\
+    Units/parser-verilog.r/verilog-memleak.d/input.v\
+    Units/parser-verilog.r/verilog-nocontext.d/args.ctags\
+    Units/parser-verilog.r/verilog-nocontext.d/expected.tags\
+    Units/parser-verilog.r/verilog-nocontext.d/input.v\
+    Units/parser-verilog.r/verilog-sf_bug108_1.d/expected.tags\
+    Units/parser-verilog.r/verilog-sf_bug108_1.d/input.v\
+    Units/parser-verilog.r/verilog-sf_bug108_2.d/expected.tags\
+    Units/parser-verilog.r/verilog-sf_bug108_2.d/input.v\
+    Units/parser-verilog.r/verilog-sf_bug174.d/expected.tags\
+    Units/parser-verilog.r/verilog-sf_bug174.d/input.v\
+    Units/parser-verilog.r/verilog-sf_bug73_1.d/expected.tags\
+    Units/parser-verilog.r/verilog-sf_bug73_1.d/input.v\
+    Units/parser-verilog.r/verilog-sf_bug73_2.d/expected.tags\
+    Units/parser-verilog.r/verilog-sf_bug73_2.d/input.v\
+    Units/parser-verilog.r/verilog-sf_bug73_3.d/expected.tags\
+    Units/parser-verilog.r/verilog-sf_bug73_3.d/input.v\
+    Units/parser-verilog.r/verilog-sf_bug98.d/expected.tags\
+    Units/parser-verilog.r/verilog-sf_bug98.d/input.v\
+    Units/parser-verilog.r/verilog-sf_bug99.d/expected.tags\
+    Units/parser-verilog.r/verilog-sf_bug99.d/input.v\
+    Units/parser-verilog.r/verilog-sf_patch57.d/expected.tags\
+    Units/parser-verilog.r/verilog-sf_patch57.d/input.v\
+    Units/parser-vim.r/3214129.vim.d/expected.tags\
+    Units/parser-vim.r/3214129.vim.d/input.vim\
+    Units/parser-vim.r/3548393.vim.d/expected.tags\
+    Units/parser-vim.r/3548393.vim.d/input.vim\
+    Units/parser-vim.r/bug3032253.vim.d/expected.tags\
+    Units/parser-vim.r/bug3032253.vim.d/input.vim\
+    Units/parser-vim.r/bug358.vim.d/expected.tags\
+    Units/parser-vim.r/bug358.vim.d/input.vim\
+    Units/parser-vim.r/bug359.vim.d/expected.tags\
+    Units/parser-vim.r/bug359.vim.d/input.vim\
+    Units/parser-vim.r/end-field.vim.d/args.ctags\
+    Units/parser-vim.r/end-field.vim.d/expected.tags\
+    Units/parser-vim.r/end-field.vim.d/input.vim\
+    Units/parser-vim.r/simple.vim.d/expected.tags\
+    Units/parser-vim.r/simple.vim.d/input.vim\
+    Units/parser-vim.r/vim-command-in-function.d/expected.tags\
+    Units/parser-vim.r/vim-command-in-function.d/input.vim\
+    Units/parser-vim.r/vim-command-not-command.d/README\
+    Units/parser-vim.r/vim-command-not-command.d/expected.tags\
+    Units/parser-vim.r/vim-command-not-command.d/input.vim\
+    Units/parser-vim.r/vim-command.d/expected.tags\
+    Units/parser-vim.r/vim-command.d/input.vim\
+    Units/parser-vim.r/vim-let-in-function.d/expected.tags\
+    Units/parser-vim.r/vim-let-in-function.d/input.vim\
+    Units/parser-vim.r/vim-map-special-args.d/expected.tags\
+    Units/parser-vim.r/vim-map-special-args.d/input.vim\
+    Units/parser-vim.r/vimball.vim.d/expected.tags\
+    Units/parser-vim.r/vimball.vim.d/input.vba\
+    Units/parser-xslt.r/xslt-simple.d/args.ctags\
+    Units/parser-xslt.r/xslt-simple.d/expected.tags\
+    Units/parser-xslt.r/xslt-simple.d/features\
+    Units/parser-xslt.r/xslt-simple.d/input.xsl\
+    Units/parser-yacc.r/bom.d/args.ctags\
+    Units/parser-yacc.r/bom.d/expected.tags\
+    Units/parser-yacc.r/bom.d/input.y\
+    Units/parser-yacc.r/c-anon-ids.d/README\
+    Units/parser-yacc.r/c-anon-ids.d/args.ctags\
+    Units/parser-yacc.r/c-anon-ids.d/expected.tags\
+    Units/parser-yacc.r/c-anon-ids.d/input.y\
+    Units/parser-yacc.r/nested.d/args.ctags\
+    Units/parser-yacc.r/nested.d/expected.tags\
+    Units/parser-yacc.r/nested.d/input.y\
+    Units/parser-yacc.r/not-union.d/README\
+    Units/parser-yacc.r/not-union.d/args.ctags\
+    Units/parser-yacc.r/not-union.d/expected.tags\
+    Units/parser-yacc.r/not-union.d/input.y\
+    Units/parser-yaml.r/yaml-anchor.d/args.ctags\
+    Units/parser-yaml.r/yaml-anchor.d/expected.tags\
+    Units/parser-yaml.r/yaml-anchor.d/features\
+    Units/parser-yaml.r/yaml-anchor.d/input.yml\
+    Units/readtags.r/backslash-at-the-end-of-pattern.d/expected.tags\
+    Units/readtags.r/backslash-at-the-end-of-pattern.d/input.c\
+    Units/regex-flag-long.d/args.ctags\
+    Units/regex-flag-long.d/expected.tags\
+    Units/regex-flag-long.d/features\
+    Units/regex-flag-long.d/input.dummy\
+    Units/regex-flag-simple.d/args.ctags\
+    Units/regex-flag-simple.d/expected.tags\
+    Units/regex-flag-simple.d/features\
+    Units/regex-flag-simple.d/input.dummy\
+    Units/regex-multiline-flag-advnaceTo.d/args.ctags\
+    Units/regex-multiline-flag-advnaceTo.d/expected.tags\
+    Units/regex-multiline-flag-advnaceTo.d/input-0.bar\
+    Units/regex-multiline-flag-advnaceTo.d/input-1.baz\
+    Units/regex-multiline-flag-advnaceTo.d/input.foo\
+    Units/regex-multiline-flag-dos.d/args.ctags\
+    Units/regex-multiline-flag-dos.d/expected.tags\
+    Units/regex-multiline-flag-dos.d/input.mlt\
+    Units/regex-multiline-flag-hat-and-doller.d/args.ctags\
+    Units/regex-multiline-flag-hat-and-doller.d/expected.tags\
+    Units/regex-multiline-flag-hat-and-doller.d/input.foobar\
+    Units/regex-multiline-flag-newline.d/args.ctags\
+    Units/regex-multiline-flag-newline.d/expected.tags\
+    Units/regex-multiline-flag-newline.d/input.foobar\
+    Units/regex-multiline-flag.d/args.ctags\
+    Units/regex-multiline-flag.d/expected.tags\
+    Units/regex-multiline-flag.d/input.java\
+    Units/regex-with-scope-nested.d/args.ctags\
+    Units/regex-with-scope-nested.d/expected.tags\
+    Units/regex-with-scope-nested.d/input.foo\
+    Units/regex-with-scope.d/args.ctags\
+    Units/regex-with-scope.d/expected.tags\
+    Units/regex-with-scope.d/input.foo\
+    Units/review-needed.r/bug2374109.vhd.t/expected.tags\
+    Units/review-needed.r/bug2374109.vhd.t/input.vhd\
+    Units/review-needed.r/bug612019.pas.t/expected.tags\
+    Units/review-needed.r/bug612019.pas.t/input.pas\
+    Units/review-needed.r/bug816636.sml.t/expected.tags\
+    Units/review-needed.r/bug816636.sml.t/input.sml\
+    Units/review-needed.r/dosbatch_test.cmd.t/expected.tags\
+    Units/review-needed.r/dosbatch_test.cmd.t/features\
+    Units/review-needed.r/dosbatch_test.cmd.t/input.cmd\
+    Units/review-needed.r/flex_override.mxml.t/expected.tags\
+    Units/review-needed.r/flex_override.mxml.t/input.mxml\
+    Units/review-needed.r/generalized_stack.ads.t/expected.tags\
+    Units/review-needed.r/generalized_stack.ads.t/input.ads\
+    Units/review-needed.r/ingres_procedures.sql.t/README\
+    Units/review-needed.r/ingres_procedures.sql.t/args.ctags\
+    Units/review-needed.r/ingres_procedures.sql.t/expected.tags\
+    Units/review-needed.r/ingres_procedures.sql.t/input.sql\
+    Units/review-needed.r/jbrown.vr.t/args.ctags\
+    Units/review-needed.r/jbrown.vr.t/expected.tags\
+    Units/review-needed.r/jbrown.vr.t/input.vr\
+    Units/review-needed.r/matlab_backtracking.m.t/expected.tags\
+    Units/review-needed.r/matlab_backtracking.m.t/features\
+    Units/review-needed.r/matlab_backtracking.m.t/input.m\
+    Units/review-needed.r/matlab_test.m.t/expected.tags\
+    Units/review-needed.r/matlab_test.m.t/features\
+    Units/review-needed.r/matlab_test.m.t/input.m\
+    Units/review-needed.r/maze.erl.t/expected.tags\
+    Units/review-needed.r/maze.erl.t/input.erl\
+    Units/review-needed.r/maze.hrl.t/expected.tags\
+    Units/review-needed.r/maze.hrl.t/input.hrl\
+    Units/review-needed.r/simple.asp.t/expected.tags\
+    Units/review-needed.r/simple.asp.t/input.asp\
+    Units/review-needed.r/simple.bas.t/expected.tags\
+    Units/review-needed.r/simple.bas.t/input.bas\
+    Units/review-needed.r/simple.bb.t/expected.tags\
+    Units/review-needed.r/simple.bb.t/input.bb\
+    Units/review-needed.r/simple.fal.t/expected.tags\
+    Units/review-needed.r/simple.fal.t/input.fal\
+    Units/review-needed.r/simple.js.t/expected.tags\
+    Units/review-needed.r/simple.js.t/input.js\
+    Units/review-needed.r/simple.mak.t/expected.tags\
+    Units/review-needed.r/simple.mak.t/input.mak\
+    Units/review-needed.r/simple.pb.t/expected.tags\
+    Units/review-needed.r/simple.pb.t/input.pb\
+    Units/review-needed.r/simple.sml.t/expected.tags\
+    Units/review-needed.r/simple.sml.t/input.sml\
+    Units/review-needed.r/simple.vr.t/args.ctags\
+    Units/review-needed.r/simple.vr.t/expected.tags\
+    Units/review-needed.r/simple.vr.t/input.vr\
+    Units/review-needed.r/test.vhd.t/expected.tags\
+    Units/review-needed.r/test.vhd.t/input.vhd\
+    Units/simple-clojure.d/expected.tags\
+    Units/simple-clojure.d/input.clj\
+    Units/simple-ctags-aspell.d/args.ctags\
+    Units/simple-ctags-aspell.d/dictfile\
+    Units/simple-ctags-aspell.d/expected.tags-x\
+    Units/simple-ctags-aspell.d/features\
+    Units/simple-ctags-aspell.d/input.patch\
+    Units/simple-ctags-aspell.d/mydict.list\
+    Units/simple-ctags.d/expected.tags\
+    Units/simple-ctags.d/features\
+    Units/simple-ctags.d/input.ctags\
+    Units/simple-dbusinspect.d/expected.tags\
+    Units/simple-dbusinspect.d/features\
+    Units/simple-dbusinspect.d/input.xml\
+    Units/simple-diff.d/expected.tags\
+    Units/simple-diff.d/input.diff\
+    Units/simple-elm.d/args.ctags\
+    Units/simple-elm.d/expected.tags\
+    Units/simple-elm.d/input.elm\
+    Units/simple-etags.d/expected.tags-e\
+    Units/simple-etags.d/input.c\
+    Units/simple-gdbinit.d/args.ctags\
+    Units/simple-gdbinit.d/expected.tags\
+    Units/simple-gdbinit.d/input.gdb\
+    Units/simple-glade.d/args.ctags\
+    Units/simple-glade.d/expected.tags\
+    Units/simple-glade.d/features\
+    Units/simple-glade.d/input.glade\
+    Units/simple-javaproperties.d/expected.tags\
+    Units/simple-javaproperties.d/input.properties\
+    Units/simple-json.d/expected.tags\
+    Units/simple-json.d/input.json\
+    Units/simple-maven2.d/args.ctags\
+    Units/simple-maven2.d/expected.tags\
+    Units/simple-maven2.d/features\
+    Units/simple-maven2.d/input.xml\
+    Units/simple-plist.d/args.ctags\
+    Units/simple-plist.d/expected.tags\
+    Units/simple-plist.d/features\
+    Units/simple-plist.d/input.plist\
+    Units/simple-pod.d/args.ctags\
+    Units/simple-pod.d/expected.tags\
+    Units/simple-pod.d/input.pod\
+    Units/simple-protobuf.d/args.ctags\
+    Units/simple-protobuf.d/expected.tags\
+    Units/simple-protobuf.d/input.proto\
+    Units/simple-rpmspec.d/args.ctags\
+    Units/simple-rpmspec.d/expected.tags\
+    Units/simple-rpmspec.d/input.spec\
+    Units/simple-rspec.d/args.ctags\
+    Units/simple-rspec.d/expected.tags\
+    Units/simple-rspec.d/input.rb\
+    Units/simple-svg.d/args.ctags\
+    Units/simple-svg.d/expected.tags\
+    Units/simple-svg.d/features\
+    Units/simple-svg.d/input.svg\
+    Units/simple-systemdunit.d/args.ctags\
+    Units/simple-systemdunit.d/expected.tags\
+    Units/simple-systemdunit.d/input.service\
+    Units/simple-windres.d/expected.tags\
+    Units/simple-windres.d/input.rc\
+    Units/simple-xref.d/expected.tags-x\
+    Units/simple-xref.d/input.c\
+    Units/simple-yumrepo.d/args.ctags\
+    Units/simple-yumrepo.d/expected.tags\
+    Units/simple-yumrepo.d/input.repo\
+    Units/tex-review-needed.r/3526726.tex.t/expected.tags\
+    Units/tex-review-needed.r/3526726.tex.t/input.tex\
+    Units/tex-review-needed.r/bug2886870.tex.t/expected.tags\
+    Units/tex-review-needed.r/bug2886870.tex.t/input.tex\
+    Units/tex-review-needed.r/intro.tex.t/expected.tags\
+    Units/tex-review-needed.r/intro.tex.t/input.tex\
+    Units/tex-review-needed.r/intro_orig.tex.t/expected.tags\
+    Units/tex-review-needed.r/intro_orig.tex.t/input.tex\
+    Units/unit-example-multi-inputs.d/args.ctags\
+    Units/unit-example-multi-inputs.d/expected.tags\
+    Units/unit-example-multi-inputs.d/input-0.h\
+    Units/unit-example-multi-inputs.d/input-1.sh\
+    Units/unit-example-multi-inputs.d/input-2.c\
+    Units/unit-example-multi-inputs.d/input-3.c\
+    Units/unit-example-multi-inputs.d/input.c\
+    Units/vera-interface.d/expected.tags\
+    Units/vera-interface.d/input.vr\
+    Units/xformat-option.r/format-CfSt.d/args.ctags\
+    Units/xformat-option.r/format-CfSt.d/expected.tags-x\
+    Units/xformat-option.r/format-CfSt.d/input.c\
+    Units/xformat-option.r/format-NlKkFnP.d/args.ctags\
+    Units/xformat-option.r/format-NlKkFnP.d/expected.tags-x\
+    Units/xformat-option.r/format-NlKkFnP.d/filter\
+    Units/xformat-option.r/format-NlKkFnP.d/input.m\
+    Units/xformat-option.r/format-aim.d/args.ctags\
+    Units/xformat-option.r/format-aim.d/expected.tags-x\
+    Units/xformat-option.r/format-aim.d/input.java\
+    Units/zephir-return-hint.d/args.ctags\
+    Units/zephir-return-hint.d/expected.tags\
+    Units/zephir-return-hint.d/input.zep\
+    Units/zephir-simple.d/args.ctags\
+    Units/zephir-simple.d/expected.tags\
+    Units/zephir-simple.d/input.zep\
+$(NULL)
@@ -1,5 +1,5 @@
 # -*- makefile -*-
-.PHONY: check units fuzz noise tmain tinst clean-units clean-tmain clean-gcov run-gcov codecheck cppcheck dicts cspell
+.PHONY: check units fuzz noise bench scaling tmain tinst clean-units clean-tmain clean-gcov run-gcov codecheck cppcheck dicts cspell
 
 check: tmain units
 
@@ -17,6 +17,13 @@ endif
 LANGUAGES=
 CATEGORIES=
 UNITS=
+BENCH_CORPORA=$(srcdir)/Units
+BENCH_SIZE=
+BENCH_OUTPUT=
+BENCH_BASELINE=
+SCALING_CORPORA=$(srcdir)/Units
+SCALING_SIZE=
+SCALING_SEEDS=
 
 #
 # FUZZ Target
@@ -80,6 +87,31 @@ slap: $(CTAGS_TEST)
 		--with-timeout=$(TIMEOUT)"; \
 	$(SHELL) $${c} $(srcdir)/Units
 
+#
+# BENCH Target
+#
+bench: $(CTAGS_TEST)
+	@ \
+	c="$(srcdir)/misc/bench \
+		--ctags=$(CTAGS_TEST) \
+		--languages=$(LANGUAGES) \
+		--size=$(BENCH_SIZE) \
+		--output=$(BENCH_OUTPUT) \
+		--baseline=$(BENCH_BASELINE)"; \
+	$(SHELL) $${c} $(BENCH_CORPORA)
+
+#
+# SCALING Target
+#
+scaling: $(CTAGS_TEST)
+	@ \
+	c="$(srcdir)/misc/scaling \
+		--ctags=$(CTAGS_TEST) \
+		--languages=$(LANGUAGES) \
+		--size=$(SCALING_SIZE) \
+		--seeds=$(SCALING_SEEDS)"; \
+	$(SHELL) $${c} $(SCALING_CORPORA)
+
 #
 # UNITS Target
 #
@@ -46,6 +46,13 @@ if [ "$TARGET" = "Unix" ]; then
         make -j2
         make -j2 check TRAVIS=1
     fi
+elif [ "$TARGET" = "AllocProfiling" ]; then
+	# eMalloc and friends record each block for --totals in this build;
+	# run the tests through the recording paths with assertions on.
+	./autogen.sh
+	./configure --enable-debugging --enable-alloc-profiling
+	make -j2
+	make -j2 check TRAVIS=1
 elif [ "$TARGET" = "Mingw32" ]; then
     make -j2 CC=i686-w64-mingw32-gcc -f mk_mingw.mak
     # Don't run test units in Mingw32 target
@@ -97,6 +97,7 @@
 #include <ctype.h>      /* to define isxxx() macros */
 #include <setjmp.h>
 
+#include "keyword.h"    /* to look up keywords */
 #include "parse.h"      /* always include */
 #include "read.h"       /* to define file readLineFromInputFile() */
 #include "entry.h"      /* for the tag entry manipulation */
@@ -305,6 +306,24 @@ static int eofCount;
 static const char *line;
 static int lineLen;
 static int pos;
+
+/* bumped for every line read, so that keywordCache can tell lines apart
+ * even when their contents are read into the same buffer */
+static unsigned long lineSerial;
+
+/* the keyword at pos, looked up once for all the adaKeywordCmp() calls
+ * trying the keywords one by one at the same position */
+static struct
+{
+  unsigned long serial;
+  int pos;
+  int keyword;
+} keywordCache;
+
+static langType Lang_ada;
+
+/* the length of the longest keyword, "exception" */
+#define ADA_KEYWORD_MAX_LENGTH 9
 static unsigned long matchLineNum;
 static MIOPos matchFilePos;
 
@@ -569,16 +588,30 @@ static void appendAdaTokenList(adaTokenInfo *parent, adaTokenList *children)
   }
 } /* static void appendAdaTokenList(adaTokenInfo *parent, ... ) */
 
+/* read the next line into line and lineLen, returning false at the end of
+ * the file */
+static bool readLine(void)
+{
+  line = (const char *) readLineFromInputFile();
+  pos = 0;
+  lineSerial++;
+
+  if(line == NULL)
+  {
+    lineLen = 0;
+    return false;
+  }
+
+  lineLen = strlen(line);
+  return true;
+}
+
 static void readNewLine(void)
 {
   while(true)
   {
-    line = (const char *) readLineFromInputFile();
-    pos = 0;
-
-    if(line == NULL)
+    if(!readLine())
     {
-      lineLen = 0;
       exception = EXCEPTION_EOF;
       eofCount++;
 
@@ -590,9 +623,7 @@ static void readNewLine(void)
       {
         return;
       }
-    } /* if(line == NULL) */
-
-    lineLen = strlen(line);
+    } /* if(!readLine()) */
 
     if(lineLen > 0)
     {
@@ -614,9 +645,12 @@ static void movePos(int amount)
  * cmp() because comments don't have to have whitespace or separation-type
  * characters following the "--" */
 #define isAdaComment(buf, pos, len) \
-  (((pos) == 0 || (!isalnum((buf)[(pos) - 1]) && (buf)[(pos) - 1] != '_')) && \
-   (pos) < (len) && \
-   strncasecmp(&(buf)[(pos)], "--", strlen("--")) == 0)
+  ((pos) < (len) && (buf)[(pos)] == '-' && (buf)[(pos) + 1] == '-' && \
+   ((pos) == 0 || (!isalnum((buf)[(pos) - 1]) && (buf)[(pos) - 1] != '_')))
+
+/* the characters which can follow a word matched by cmp() */
+#define isAdaWordEnd(c) \
+  (isspace(c) || (c) == '(' || (c) == ')' || (c) == ':' || (c) == ';')
 
 static bool cmp(const char *buf, int len, const char *match)
 {
@@ -635,6 +669,12 @@ static bool cmp(const char *buf, int len, const char *match)
     return status;
   }
 
+  /* most positions differ at the first character already */
+  if(len <= 0 || tolower((unsigned char) buf[0]) != tolower((unsigned char) match[0]))
+  {
+    return status;
+  }
+
   matchLen = strlen(match);
 
   /* A match only happens the number of chars in the matching string match,
@@ -643,10 +683,7 @@ static bool cmp(const char *buf, int len, const char *match)
    * separation characters such as (, ), :, or ; */
   if ((strncasecmp(buf, match, matchLen) == 0) &&
 	  (matchLen == len ||
-	  (matchLen < len &&
-	   (isspace(buf[matchLen]) || buf[matchLen] == '(' ||
-	    buf[matchLen] == ')' || buf[matchLen] == ':' ||
-	    buf[matchLen] == ';'))))
+	  (matchLen < len && isAdaWordEnd(buf[matchLen]))))
   {
     status = true;
   }
@@ -654,6 +691,17 @@ static bool cmp(const char *buf, int len, const char *match)
   return status;
 } /* static bool cmp(char *buf, int len, char *match) */
 
+/* the position of the tag of the last match; the position only changes
+ * with the line */
+static void setMatchPosition(void)
+{
+  if(matchLineNum != getInputLineNumber())
+  {
+    matchLineNum = getInputLineNumber();
+    matchFilePos = getInputFilePosition();
+  }
+}
+
 static bool adaCmp(const char *match)
 {
   bool status = false;
@@ -670,15 +718,41 @@ static bool adaCmp(const char *match)
   /* if we match, increment the position pointer */
   if(status == true && match != NULL)
   {
-    matchLineNum = getInputLineNumber();
-    matchFilePos = getInputFilePosition();
-
+    setMatchPosition();
     movePos((strlen(match)));
   }
 
   return status;
 } /* static bool adaCmp(char *match) */
 
+/* the keyword cmp() would match at pos, or KEYWORD_NONE: the word up to
+ * the next character which can end a keyword */
+static int keywordAtPos(void)
+{
+  char word[ADA_KEYWORD_MAX_LENGTH + 1];
+  int len;
+
+  if(keywordCache.serial == lineSerial && keywordCache.pos == pos)
+  {
+    return keywordCache.keyword;
+  }
+
+  for(len = 0; pos + len < lineLen && len <= ADA_KEYWORD_MAX_LENGTH &&
+      !isAdaWordEnd(line[pos + len]); len++);
+
+  keywordCache.serial = lineSerial;
+  keywordCache.pos = pos;
+  keywordCache.keyword = KEYWORD_NONE;
+  if(len > 0 && len <= ADA_KEYWORD_MAX_LENGTH)
+  {
+    memcpy(word, &line[pos], len);
+    word[len] = '\0';
+    keywordCache.keyword = lookupCaseKeyword(word, Lang_ada);
+  }
+
+  return keywordCache.keyword;
+} /* static int keywordAtPos(void) */
+
 /* just a version of adaCmp that is a bit more optimized for keywords */
 static bool adaKeywordCmp(adaKeyword keyword)
 {
@@ -691,14 +765,12 @@ static bool adaKeywordCmp(adaKeyword keyword)
     return status;
   }
 
-  status = cmp(&line[pos], lineLen - pos, AdaKeywords[keyword]);
+  status = (keywordAtPos() == (int) keyword);
 
   /* if we match, increment the position pointer */
   if(status == true)
   {
-    matchLineNum = getInputLineNumber();
-    matchFilePos = getInputFilePosition();
-
+    setMatchPosition();
     movePos((strlen(AdaKeywords[keyword])));
   }
 
@@ -724,18 +796,11 @@ static void skipUntilWhiteSpace(void)
      * immediately */
     if(pos >= lineLen)
     {
-      line = (const char *) readLineFromInputFile();
-      pos = 0;
-
-      if(line == NULL)
+      if(!readLine())
       {
-        lineLen = 0;
         exception = EXCEPTION_EOF;
-        return;
       }
 
-      lineLen = strlen(line);
-
       return;
     } /* if(pos >= lineLen) */
 
@@ -835,18 +900,11 @@ static void skipPastWord(void)
      * immediately */
     if(pos >= lineLen)
     {
-      line = (const char *) readLineFromInputFile();
-      pos = 0;
-
-      if(line == NULL)
+      if(!readLine())
       {
-        lineLen = 0;
         exception = EXCEPTION_EOF;
-        return;
       }
 
-      lineLen = strlen(line);
-
       return;
     } /* if(pos >= lineLen) */
 
@@ -2180,6 +2238,8 @@ static void findAdaTags(void)
   exception = EXCEPTION_NONE;
   line = NULL;
   pos = 0;
+  lineSerial = 0;
+  keywordCache.serial = 0;
   matchLineNum = 0;
   eofCount = 0;
 
@@ -2217,6 +2277,17 @@ static void findAdaTags(void)
   freeAdaTokenList(&root.children);
 } /* static void findAdaTags(void) */
 
+static void initialize(const langType language)
+{
+  size_t i;
+
+  Lang_ada = language;
+  for(i = 0; i < ARRAY_SIZE(AdaKeywords); i++)
+  {
+    addKeyword(AdaKeywords[i], language, (int) i);
+  }
+} /* static void initialize(const langType language) */
+
 /* parser definition function */
 extern parserDefinition* AdaParser(void)
 {
@@ -2226,5 +2297,6 @@ extern parserDefinition* AdaParser(void)
   def->kindCount = ADA_KIND_COUNT;
   def->extensions = extensions;
   def->parser = findAdaTags;
+  def->initialize = initialize;
   return def;
 } /* extern parserDefinition* AdaParser(void) */
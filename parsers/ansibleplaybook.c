@@ -14,6 +14,7 @@
 #include "kind.h"
 #include "yaml.h"
 #include "parse.h"
+#include "read.h"
 #include "subparser.h"
 
 #include <stdio.h>
@@ -186,6 +187,8 @@ static void inputStart(subparser *s)
 {
 	((struct sAnsiblePlaybookSubparser*)s)->play_detection_state = DSTAT_PLAY_NAME_INITIAL;
 	((struct sAnsiblePlaybookSubparser*)s)->type_stack = NULL;
+	/* Plays are all this parser tags. */
+	((yamlSubparser*)s)->interestEnded = !isInputLanguageKindEnabled (K_PLAY);
 }
 
 static void inputEnd(subparser *s)
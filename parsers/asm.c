@@ -133,13 +133,9 @@ static const opKind OpKinds [] = {
 */
 static opKeyword analyzeOperator (const vString *const op)
 {
-	vString *keyword = vStringNew ();
-	opKeyword result;
-
-	vStringCopyToLower (keyword, op);
-	result = (opKeyword) lookupKeyword (vStringValue (keyword), Lang_asm);
-	vStringDelete (keyword);
-	return result;
+	/* The keywords are in lower case; they are looked up ignoring the
+	 * case, so that no lower case copy of OP is needed. */
+	return (opKeyword) lookupCaseKeyword (vStringValue (op), Lang_asm);
 }
 
 static bool isInitialSymbolCharacter (int c)
@@ -283,9 +279,13 @@ static const unsigned char *asmReadLineFromInputFile (void)
 
 	line = vStringNewOrClear (line);
 
-	while ((c = cppGetc()) != EOF)
+	/* The characters the preprocessor has nothing to do with are taken
+	 * in runs; cppGetc () is left the others. */
+	for (;;)
 	{
-		if (c == '\n')
+		cppReadPlainChars (line);
+		c = cppGetc ();
+		if (c == EOF || c == '\n')
 			break;
 		vStringPut (line, c);
 	}
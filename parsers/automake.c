@@ -23,6 +23,7 @@
 #include "parse.h"
 #include "read.h"
 #include "subparser.h"
+#include "trashbox.h"
 
 
 typedef enum {
@@ -298,7 +299,12 @@ static void inputStart (subparser *s)
 {
 	struct sAutomakeSubparser *automake = (struct sAutomakeSubparser*)s;
 
-	automake->directories = hashTableNew (11, hashCstrhash, hashCstreq, eFree, eFree);
+	/* The table is kept from a file to the next. */
+	if (automake->directories == NULL)
+	{
+		automake->directories = hashTableNew (11, hashCstrhash, hashCstreq, eFree, eFree);
+		DEFAULT_TRASH_BOX (automake->directories, hashTableDelete);
+	}
 	automake->index = CORK_NIL;
 }
 
@@ -306,8 +312,7 @@ static void inputEnd (subparser *s)
 {
 	struct sAutomakeSubparser *automake = (struct sAutomakeSubparser*)s;
 
-	hashTableDelete (automake->directories);
-	automake->directories = NULL;
+	hashTableClear (automake->directories);
 }
 
 static void findAutomakeTags (void)
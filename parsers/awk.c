@@ -14,6 +14,7 @@
 
 #include <string.h>
 
+#include "lineprefix.h"
 #include "parse.h"
 #include "read.h"
 #include "routines.h"
@@ -34,34 +35,49 @@ static kindDefinition AwkKinds [] = {
 *   FUNCTION DEFINITIONS
 */
 
-static void findAwkTags (void)
+static void parseFunction (const linePrefix *prefix CTAGS_ATTR_UNUSED,
+						   const char *line CTAGS_ATTR_UNUSED, const char *rest,
+						   void *data)
 {
-	vString *name = vStringNew ();
-	const unsigned char *line;
+	vString *name = data;
+	const unsigned char *cp = (const unsigned char *) rest;
 
-	while ((line = readLineFromInputFile ()) != NULL)
+	while (isspace ((int) *cp))
+		++cp;
+	while (isalnum ((int) *cp)  ||  *cp == '_')
 	{
-		if (strncmp ((const char*) line, "function", (size_t) 8) == 0  &&
-			isspace ((int) line [8]))
-		{
-			const unsigned char *cp = line + 8;
-
-			while (isspace ((int) *cp))
-				++cp;
-			while (isalnum ((int) *cp)  ||  *cp == '_')
-			{
-				vStringPut (name, (int) *cp);
-				++cp;
-			}
-			while (isspace ((int) *cp))
-				++cp;
-			if (*cp == '(')
-				makeSimpleTag (name, K_FUNCTION);
-			vStringClear (name);
-			if (*cp != '\0')
-				++cp;
-		}
+		vStringPut (name, (int) *cp);
+		++cp;
 	}
+	while (isspace ((int) *cp))
+		++cp;
+	if (*cp == '(')
+		makeSimpleTag (name, K_FUNCTION);
+	vStringClear (name);
+}
+
+static const linePrefix AwkPrefixes [] = {
+	{ "function", parseFunction, K_FUNCTION, LINE_PREFIX_WORD },
+};
+
+static linePrefixTable *AwkPrefixTable;
+
+static void initialize (const langType language CTAGS_ATTR_UNUSED)
+{
+	AwkPrefixTable = linePrefixTableNew (AwkPrefixes, ARRAY_SIZE (AwkPrefixes), 0);
+}
+
+static void finalize (const langType language CTAGS_ATTR_UNUSED, bool initialized)
+{
+	if (initialized)
+		linePrefixTableDelete (AwkPrefixTable);
+}
+
+static void findAwkTags (void)
+{
+	vString *name = vStringNew ();
+
+	dispatchInputLinesWithPrefixes (AwkPrefixTable, name);
 	vStringDelete (name);
 }
 
@@ -75,5 +91,7 @@ extern parserDefinition* AwkParser (void)
 	def->extensions = extensions;
 	def->aliases    = aliases;
 	def->parser     = findAwkTags;
+	def->initialize = initialize;
+	def->finalize   = finalize;
 	return def;
 }
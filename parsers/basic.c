@@ -17,6 +17,7 @@
 
 #include <string.h>
 
+#include "lineprefix.h"
 #include "options.h"
 #include "parse.h"
 #include "read.h"
@@ -35,12 +36,6 @@ typedef enum {
 	K_ENUM
 } BasicKind;
 
-typedef struct {
-	char const *token;
-	BasicKind kind;
-	int skip;
-} KeyWord;
-
 static kindDefinition BasicKinds[] = {
 	{true, 'c', "constant", "constants"},
 	{true, 'f', "function", "functions"},
@@ -50,41 +45,6 @@ static kindDefinition BasicKinds[] = {
 	{true, 'g', "enum", "enumerations"}
 };
 
-static KeyWord blitzbasic_keywords[] = {
-	{"const", K_CONST, 0},
-	{"global", K_VARIABLE, 0},
-	{"dim", K_VARIABLE, 0},
-	{"function", K_FUNCTION, 0},
-	{"type", K_TYPE, 0},
-	{NULL, 0, 0}
-};
-
-static KeyWord purebasic_keywords[] = {
-	{"newlist", K_VARIABLE, 0},
-	{"global", K_VARIABLE, 0},
-	{"dim", K_VARIABLE, 0},
-	{"procedure", K_FUNCTION, 0},
-	{"interface", K_TYPE, 0},
-	{"structure", K_TYPE, 0},
-	{NULL, 0, 0}
-};
-
-static KeyWord freebasic_keywords[] = {
-	{"const", K_CONST, 0},
-	{"dim as", K_VARIABLE, 1},
-	{"dim", K_VARIABLE, 0},
-	{"common", K_VARIABLE, 0},
-	{"function", K_FUNCTION, 0},
-	{"sub", K_FUNCTION, 0},
-	{"private sub", K_FUNCTION, 0},
-	{"public sub", K_FUNCTION, 0},
-	{"private function", K_FUNCTION, 0},
-	{"public function", K_FUNCTION, 0},
-	{"type", K_TYPE, 0},
-	{"enum", K_ENUM, 0},
-	{NULL, 0, 0}
-};
-
 /*
  *   FUNCTION DEFINITIONS
  */
@@ -100,28 +60,64 @@ static char const *extract_name (char const *pos, vString * name)
 	return pos;
 }
 
-/* Match a keyword starting at p (case insensitive). */
-static int match_keyword (const char *p, KeyWord const *kw)
+/* Make a tag of the name after the keyword. */
+static void extract_tag (const linePrefix *prefix, const char *line CTAGS_ATTR_UNUSED,
+						 const char *rest, void *data)
 {
-	vString *name;
-	size_t i;
-	int j;
-	for (i = 0; i < strlen (kw->token); i++)
-	{
-		if (tolower (p[i]) != kw->token[i])
-			return 0;
-	}
-	name = vStringNew ();
-	p += i;
-	for (j = 0; j < 1 + kw->skip; j++)
-	{
-		p = extract_name (p, name);
-	}
-	makeSimpleTag (name, kw->kind);
-	vStringDelete (name);
-	return 1;
+	vString *name = data;
+
+	extract_name (rest, name);
+	makeSimpleTag (name, prefix->kind);
+}
+
+/* Make a tag of the second name after the keyword, as in "dim as T x". */
+static void extract_second_tag (const linePrefix *prefix, const char *line CTAGS_ATTR_UNUSED,
+								const char *rest, void *data)
+{
+	vString *name = data;
+
+	extract_name (extract_name (rest, name), name);
+	makeSimpleTag (name, prefix->kind);
 }
 
+/* In Basic, keywords always are at the start of the line; they are
+ * matched case insensitively, the first of a table matching winning. */
+static const linePrefix blitzbasic_keywords[] = {
+	{"const", extract_tag, K_CONST, 0},
+	{"global", extract_tag, K_VARIABLE, 0},
+	{"dim", extract_tag, K_VARIABLE, 0},
+	{"function", extract_tag, K_FUNCTION, 0},
+	{"type", extract_tag, K_TYPE, 0},
+};
+
+static const linePrefix purebasic_keywords[] = {
+	{"newlist", extract_tag, K_VARIABLE, 0},
+	{"global", extract_tag, K_VARIABLE, 0},
+	{"dim", extract_tag, K_VARIABLE, 0},
+	{"procedure", extract_tag, K_FUNCTION, 0},
+	{"interface", extract_tag, K_TYPE, 0},
+	{"structure", extract_tag, K_TYPE, 0},
+};
+
+static const linePrefix freebasic_keywords[] = {
+	{"const", extract_tag, K_CONST, 0},
+	{"dim as", extract_second_tag, K_VARIABLE, 0},
+	{"dim", extract_tag, K_VARIABLE, 0},
+	{"common", extract_tag, K_VARIABLE, 0},
+	{"function", extract_tag, K_FUNCTION, 0},
+	{"sub", extract_tag, K_FUNCTION, 0},
+	{"private sub", extract_tag, K_FUNCTION, 0},
+	{"public sub", extract_tag, K_FUNCTION, 0},
+	{"private function", extract_tag, K_FUNCTION, 0},
+	{"public function", extract_tag, K_FUNCTION, 0},
+	{"type", extract_tag, K_TYPE, 0},
+	{"enum", extract_tag, K_ENUM, 0},
+};
+
+static linePrefixTable *BlitzBasicKeywords;
+static linePrefixTable *PureBasicKeywords;
+static linePrefixTable *FreeBasicKeywords;
+
 /* Match a "label:" style label. */
 static void match_colon_label (char const *p)
 {
@@ -149,23 +145,47 @@ static void match_dot_label (char const *p)
 	}
 }
 
+static void initialize (const langType language CTAGS_ATTR_UNUSED)
+{
+	const unsigned int flags = LINE_PREFIX_SKIP_BLANKS | LINE_PREFIX_IGNORE_CASE;
+
+	BlitzBasicKeywords = linePrefixTableNew (blitzbasic_keywords,
+											 ARRAY_SIZE (blitzbasic_keywords), flags);
+	PureBasicKeywords = linePrefixTableNew (purebasic_keywords,
+											ARRAY_SIZE (purebasic_keywords), flags);
+	FreeBasicKeywords = linePrefixTableNew (freebasic_keywords,
+											ARRAY_SIZE (freebasic_keywords), flags);
+}
+
+static void finalize (const langType language CTAGS_ATTR_UNUSED, bool initialized)
+{
+	if (!initialized)
+		return;
+
+	linePrefixTableDelete (FreeBasicKeywords);
+	linePrefixTableDelete (PureBasicKeywords);
+	linePrefixTableDelete (BlitzBasicKeywords);
+}
+
 static void findBasicTags (void)
 {
 	const char *line;
 	const char *extension = fileExtension (getInputFileName ());
-	KeyWord *keywords;
+	const linePrefixTable *keywords;
+	vString *name = vStringNew ();
 
 	if (strcmp (extension, "bb") == 0)
-		keywords = blitzbasic_keywords;
+		keywords = BlitzBasicKeywords;
 	else if (strcmp (extension, "pb") == 0)
-		keywords = purebasic_keywords;
+		keywords = PureBasicKeywords;
 	else
-		keywords = freebasic_keywords;
+		keywords = FreeBasicKeywords;
 
 	while ((line = (const char *) readLineFromInputFile ()) != NULL)
 	{
 		const char *p = line;
-		KeyWord const *kw;
+		const char *rest;
+		const linePrefix *kw;
 
 		while (isspace (*p))
 			p++;
@@ -174,9 +194,9 @@ static void findBasicTags (void)
 		if (!*p)
 			continue;
 
-		/* In Basic, keywords always are at the start of the line. */
-		for (kw = keywords; kw->token; kw++)
-			if (match_keyword (p, kw)) break;
+		kw = matchLinePrefix (keywords, p, &rest);
+		if (kw)
+			kw->handler (kw, p, rest, name);
 
 		/* Is it a label? */
 		if (strcmp (extension, "bb") == 0)
@@ -184,6 +204,7 @@ static void findBasicTags (void)
 		else
 			match_colon_label (p);
 	}
+	vStringDelete (name);
 }
 
 parserDefinition *BasicParser (void)
@@ -194,5 +215,7 @@ parserDefinition *BasicParser (void)
 	def->kindCount = ARRAY_SIZE (BasicKinds);
 	def->extensions = extensions;
 	def->parser = findBasicTags;
+	def->initialize = initialize;
+	def->finalize = finalize;
 	return def;
 }
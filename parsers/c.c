@@ -1676,6 +1676,8 @@ static int skipToNonWhite (void)
 #else
 	while (1)
 	{
+		if (cppSkipOverBlanks () > 0)
+			found = true;
 		c = cppGetc ();
 		if (isspace (c))
 			found = true;
@@ -1722,8 +1724,14 @@ static void skipToMatch (const char *const pair)
 	int matchLevel = 1;
 	int c = '\0';
 
-	while (matchLevel > 0  &&  (c = skipToNonWhite ()) != EOF)
+	while (matchLevel > 0)
 	{
+		/* Nothing but the brackets matters here unless the text
+		 * is collected. */
+		if (! CollectingSignature)
+			cppSkipOverPlainChars ();
+		if ((c = skipToNonWhite ()) == EOF)
+			break;
 		if (CollectingSignature)
 			vStringPut (Signature, c);
 		if (c == begin)
@@ -1923,6 +1931,8 @@ static void readIdentifier (tokenInfo *const token, const int firstChar)
 				vStringPut (Signature, c);
 			first = false;
 		}
+		else
+			cppReadIdentifierChars (name);
 		c = cppGetc ();
 	} while (cppIsident (c) || ((isInputLanguage (Lang_java) || isInputLanguage (Lang_csharp)) && (isHighChar (c) || c == '.')));
 	cppUngetc (c);        /* unget non-identifier character */
@@ -3127,17 +3137,32 @@ static void nextToken (statementInfo *const st)
 
 static statementInfo *CurrentStatement = NULL;
 
+/*  Statements left by deleteStatement (), linked through their parent
+ *  field, to be taken again by newStatement () with their tokens.
+ */
+static statementInfo *StatementPool = NULL;
+
 static statementInfo *newStatement (statementInfo *const parent)
 {
-	statementInfo *const st = xMalloc (1, statementInfo);
-	unsigned int i;
+	statementInfo *st;
 
-	for (i = 0  ;  i < (unsigned int) NumTokens  ;  ++i)
-		st->token [i] = newToken ();
+	if (StatementPool != NULL)
+	{
+		st = StatementPool;
+		StatementPool = st->parent;
+	}
+	else
+	{
+		unsigned int i;
+
+		st = xMalloc (1, statementInfo);
+		for (i = 0  ;  i < (unsigned int) NumTokens  ;  ++i)
+			st->token [i] = newToken ();
 
-	st->context = newToken ();
-	st->blockName = newToken ();
-	st->parentClasses = vStringNew ();
+		st->context = newToken ();
+		st->blockName = newToken ();
+		st->parentClasses = vStringNew ();
+	}
 
 	initStatement (st, parent);
 	CurrentStatement = st;
@@ -3148,18 +3173,27 @@ static statementInfo *newStatement (statementInfo *const parent)
 static void deleteStatement (void)
 {
 	statementInfo *const st = CurrentStatement;
-	statementInfo *const parent = st->parent;
-	unsigned int i;
 
-	for (i = 0  ;  i < (unsigned int) NumTokens  ;  ++i)
+	CurrentStatement = st->parent;
+	st->parent = StatementPool;
+	StatementPool = st;
+}
+
+static void deleteStatementPool (void)
+{
+	while (StatementPool != NULL)
 	{
-		deleteToken (st->token [i]);       st->token [i] = NULL;
+		statementInfo *const st = StatementPool;
+		unsigned int i;
+
+		StatementPool = st->parent;
+		for (i = 0  ;  i < (unsigned int) NumTokens  ;  ++i)
+			deleteToken (st->token [i]);
+		deleteToken (st->blockName);
+		deleteToken (st->context);
+		vStringDelete (st->parentClasses);
+		eFree (st);
 	}
-	deleteToken (st->blockName);           st->blockName = NULL;
-	deleteToken (st->context);             st->context = NULL;
-	vStringDelete (st->parentClasses);     st->parentClasses = NULL;
-	eFree (st);
-	CurrentStatement = parent;
 }
 
 static void deleteAllStatements (void)
@@ -3514,6 +3548,7 @@ static rescanReason findCTags (const unsigned int passCount)
 					getInputFileName ());
 		}
 	}
+	deleteStatementPool ();
 	vStringDelete (Signature);
 	cppTerminate ();
 	return rescan;
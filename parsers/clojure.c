@@ -14,6 +14,7 @@
 #include "parse.h"
 #include "read.h"
 #include "routines.h"
+#include "sexp.h"
 #include "vstring.h"
 #include "entry.h"
 
@@ -27,42 +28,30 @@ static kindDefinition ClojureKinds[] = {
 	{true, 'n', "namespace", "namespaces"}
 };
 
-static int isNamespace (const char *strp)
+static void functionName (sexpSkimmer *skimmer, vString * const name)
 {
-	return strncmp (++strp, "ns", 2) == 0 && isspace (strp[2]);
-}
-
-static int isFunction (const char *strp)
-{
-	return strncmp (++strp, "defn", 4) == 0 && isspace (strp[4]);
-}
-
-static int isQuote (const char *strp)
-{
-	return strncmp (++strp, "quote", 5) == 0 && isspace (strp[5]);
-}
-
-static void functionName (vString * const name, const char *dbp)
-{
-	const char *p;
+	const int c = skipSexpBlanks (skimmer, false);
 
-	if (*dbp == '\'')
-		dbp++;
-	else if (*dbp == '(' && isQuote (dbp))
+	if (c == '\'')
+		skipSexpChar (skimmer, c);
+	else if (c == '(')
 	{
-		dbp += 7;
-		while (isspace (*dbp))
-			dbp++;
+		skipSexpChar (skimmer, c);
+		readSexpSymbol (skimmer, name);
+		if (strcmp (vStringValue (name), "quote") != 0)
+		{
+			vStringClear (name);
+			return;
+		}
+		skipSexpBlanks (skimmer, false);
 	}
 
-	for (p = dbp; *p != '\0' && *p != '(' && !isspace ((int) *p) && *p != ')';
-		p++)
-		vStringPut (name, *p);
+	readSexpSymbol (skimmer, name);
 }
 
-static int makeNamespaceTag (vString * const name, const char *dbp)
+static int makeNamespaceTag (sexpSkimmer *skimmer, vString * const name)
 {
-	functionName (name, dbp);
+	functionName (skimmer, name);
 	if (vStringLength (name) > 0 && ClojureKinds[K_NAMESPACE].enabled)
 	{
 		tagEntryInfo e;
@@ -76,9 +65,9 @@ static int makeNamespaceTag (vString * const name, const char *dbp)
 		return CORK_NIL;
 }
 
-static void makeFunctionTag (vString * const name, const char *dbp, int scope_index)
+static void makeFunctionTag (sexpSkimmer *skimmer, vString * const name, int scope_index)
 {
-	functionName (name, dbp);
+	functionName (skimmer, name);
 	if (vStringLength (name) > 0 && ClojureKinds[K_FUNCTION].enabled)
 	{
 		tagEntryInfo e;
@@ -91,42 +80,24 @@ static void makeFunctionTag (vString * const name, const char *dbp, int scope_in
 	}
 }
 
-static void skipToSymbol (const char **p)
-{
-	while (**p != '\0' && !isspace ((int) **p))
-		*p = *p + 1;
-	while (isspace ((int) **p))
-		*p = *p + 1;
-}
-
 static void findClojureTags (void)
 {
+	vString *head = vStringNew ();
 	vString *name = vStringNew ();
-	const char *p;
+	sexpSkimmer skimmer;
 	int scope_index = CORK_NIL;
 
-	while ((p = (char *)readLineFromInputFile ()) != NULL)
+	initSexpSkimmer (&skimmer, SEXP_READER_CONDITIONAL);
+	while (skimToTopLevelForm (&skimmer))
 	{
-		vStringClear (name);
-
-		while (isspace (*p))
-			p++;
-
-		if (*p == '(')
-		{
-			if (isNamespace (p))
-			{
-				skipToSymbol (&p);
-				scope_index = makeNamespaceTag (name, p);
-			}
-			else if (isFunction (p))
-			{
-				skipToSymbol (&p);
-				makeFunctionTag (name, p, scope_index);
-			}
-		}
+		readSexpSymbol (&skimmer, head);
+		if (strcmp (vStringValue (head), "ns") == 0)
+			scope_index = makeNamespaceTag (&skimmer, name);
+		else if (strcmp (vStringValue (head), "defn") == 0)
+			makeFunctionTag (&skimmer, name, scope_index);
 	}
 	vStringDelete (name);
+	vStringDelete (head);
 }
 
 extern parserDefinition *ClojureParser (void)
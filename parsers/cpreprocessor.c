@@ -150,6 +150,21 @@ static int externalParserBlockNestLevel;
  */
 static bool BraceFormat = false;
 
+/* Characters without meaning inside comments and strings, skipped in bulk */
+static inputCharClass CCommentChars;		/* all but '*' */
+static inputCharClass CplusCommentChars;	/* all but '\\' and '\n' */
+static inputCharClass DCommentChars;		/* all but '+' */
+static inputCharClass StringChars;			/* all but '\\' and '"' */
+static inputCharClass RawStringChars;		/* all but '"' */
+static inputCharClass IgnoredChars;		/* all but the ones starting a comment,
+											   a literal, a line continuation,
+											   a trigraph, or a new line */
+static inputCharClass BlankChars;			/* ' ' and '\t' */
+static inputCharClass PlainChars;			/* the ones cppGetc () returns as is,
+											   but blanks and brackets */
+static inputCharClass PlainOrBlankChars;	/* PlainChars and BlankChars */
+static inputCharClass IdentifierChars;		/* cppIsident () ones, but 'R' */
+
 void cppPushExternalParserBlock(void)
 {
 	externalParserBlockNestLevel++;
@@ -233,8 +248,9 @@ static void cppInitCommon(langType clientLang,
 	}
 
 	Cpp.clientLang = clientLang;
-	Cpp.ungetBuffer = NULL;
+	/* The buffer of the last file is kept. */
 	Cpp.ungetPointer = NULL;
+	Cpp.ungetDataSize = 0;
 
 	Cpp.resolveRequired = false;
 	Cpp.hasAtLiteralStrings = hasAtLiteralStrings;
@@ -301,20 +317,11 @@ extern void cppInit (const bool state, const bool hasAtLiteralStrings,
 				   headerSystemRoleIndex, headerLocalRoleIndex);
 }
 
+/*  The buffers are kept for the next file, and released by the finalizer
+ *  of the CPreProcessor parser.
+ */
 extern void cppTerminate (void)
 {
-	if (Cpp.directive.name != NULL)
-	{
-		vStringDelete (Cpp.directive.name);
-		Cpp.directive.name = NULL;
-	}
-
-	if(Cpp.ungetBuffer)
-	{
-		eFree(Cpp.ungetBuffer);
-		Cpp.ungetBuffer = NULL;
-	}
-
 	Cpp.clientLang = LANG_IGNORE;
 }
 
@@ -448,6 +455,71 @@ static int cppGetcFromUngetBufferOrFile(void)
 	return getcFromInputFile();
 }
 
+static void cppSkipCharsInClass (const inputCharClass *klass)
+{
+	if (Cpp.ungetPointer == NULL)
+		skipInputCharsInClass (klass);
+}
+
+/*  Bulk alternatives to cppGetc () for a client skipping or reading
+ *  characters that cppGetc () would return unchanged. They consume nothing
+ *  while the unget buffer is in use; the caller goes on with cppGetc ().
+ */
+extern size_t cppSkipOverBlanks (void)
+{
+	if (Cpp.ungetPointer != NULL)
+		return 0;
+	return skipInputCharsInClass (&BlankChars);
+}
+
+extern size_t cppSkipOverPlainChars (void)
+{
+	size_t count = 0;
+
+	if (Cpp.ungetPointer != NULL)
+		return 0;
+
+	for (;;)
+	{
+		size_t n;
+
+		count += skipInputCharsInClass (&BlankChars);
+		n = skipInputCharsInClass (&PlainChars);
+		if (n == 0)
+			break;
+		Cpp.directive.accept = false;
+		count += n;
+	}
+	return count;
+}
+
+extern size_t cppReadPlainChars (vString *const chars)
+{
+	const size_t start = vStringLength (chars);
+	size_t count;
+
+	if (Cpp.ungetPointer != NULL)
+		return 0;
+
+	count = readInputCharsInClass (&PlainOrBlankChars, chars);
+	if (strspn (vStringValue (chars) + start, " \t") < count)
+		Cpp.directive.accept = false;
+	return count;
+}
+
+extern size_t cppReadIdentifierChars (vString *const name)
+{
+	size_t count;
+
+	if (Cpp.ungetPointer != NULL)
+		return 0;
+
+	count = readInputCharsInClass (&IdentifierChars, name);
+	if (count > 0)
+		Cpp.directive.accept = false;
+	return count;
+}
+
 
 /*  Reads a directive, whose first character is given by "c", into "name".
  */
@@ -916,12 +988,17 @@ static Comment isComment (void)
  */
 int cppSkipOverCComment (void)
 {
-	int c = cppGetcFromUngetBufferOrFile ();
+	int c;
 
+	cppSkipCharsInClass (&CCommentChars);
+	c = cppGetcFromUngetBufferOrFile ();
 	while (c != EOF)
 	{
 		if (c != '*')
+		{
+			cppSkipCharsInClass (&CCommentChars);
 			c = cppGetcFromUngetBufferOrFile ();
+		}
 		else
 		{
 			const int next = cppGetcFromUngetBufferOrFile ();
@@ -944,8 +1021,11 @@ static int skipOverCplusComment (void)
 {
 	int c;
 
-	while ((c = cppGetcFromUngetBufferOrFile ()) != EOF)
+	for (;;)
 	{
+		cppSkipCharsInClass (&CplusCommentChars);
+		if ((c = cppGetcFromUngetBufferOrFile ()) == EOF)
+			break;
 		if (c == BACKSLASH)
 			cppGetcFromUngetBufferOrFile ();  /* throw away next character, too */
 		else if (c == NEWLINE)
@@ -959,12 +1039,17 @@ static int skipOverCplusComment (void)
  */
 static int skipOverDComment (void)
 {
-	int c = cppGetcFromUngetBufferOrFile ();
+	int c;
 
+	cppSkipCharsInClass (&DCommentChars);
+	c = cppGetcFromUngetBufferOrFile ();
 	while (c != EOF)
 	{
 		if (c != '+')
+		{
+			cppSkipCharsInClass (&DCommentChars);
 			c = cppGetcFromUngetBufferOrFile ();
+		}
 		else
 		{
 			const int next = cppGetcFromUngetBufferOrFile ();
@@ -986,10 +1071,14 @@ static int skipOverDComment (void)
  */
 static int skipToEndOfString (bool ignoreBackslash)
 {
+	const inputCharClass *const plain = ignoreBackslash? &RawStringChars: &StringChars;
 	int c;
 
-	while ((c = cppGetcFromUngetBufferOrFile ()) != EOF)
+	for (;;)
 	{
+		cppSkipCharsInClass (plain);
+		if ((c = cppGetcFromUngetBufferOrFile ()) == EOF)
+			break;
 		if (c == BACKSLASH && ! ignoreBackslash)
 			cppGetcFromUngetBufferOrFile ();  /* throw away next character, too */
 		else if (c == DOUBLE_QUOTE)
@@ -1338,7 +1427,14 @@ process:
 			enter:
 				Cpp.directive.accept = false;
 				if (directive)
+				{
 					ignore = handleDirective (c, &macroCorkIndex);
+					/* Outside of a directive, the rest of a line of a
+					 * skipped branch matters only if it opens a comment
+					 * or a literal. */
+					if (ignore && Cpp.directive.state == DRCTV_NONE)
+						cppSkipCharsInClass (&IgnoredChars);
+				}
 				break;
 		}
 	} while (directive || ignore);
@@ -1817,10 +1913,40 @@ static void initializeCpp (const langType language)
 {
 	Cpp.lang = language;
 
+	initInputCharClass (&CCommentChars, "*", true);
+	initInputCharClass (&CplusCommentChars, "\\\n", true);
+	initInputCharClass (&DCommentChars, "+", true);
+	initInputCharClass (&StringChars, "\\\"", true);
+	initInputCharClass (&RawStringChars, "\"", true);
+	initInputCharClass (&IgnoredChars, "\n/\"'\\?@R", true);
+	initInputCharClass (&BlankChars, " \t", false);
+	initInputCharClass (&PlainChars, " \t\n/\"'\\?@R#<>:%{}()[]", true);
+	initInputCharClass (&PlainOrBlankChars, "\n/\"'\\?@R#<>:%{}()[]", true);
+	/* 'R' may start a C++ raw string literal */
+	initInputCharClass (&IdentifierChars,
+						"abcdefghijklmnopqrstuvwxyz"
+						"ABCDEFGHIJKLMNOPQSTUVWXYZ"
+						"0123456789_$", false);
+
 	defineMacroTable = makeMacroTable ();
 	DEFAULT_TRASH_BOX(defineMacroTable,hashTableDelete);
 }
 
+static void finalizeCpp (const langType language CTAGS_ATTR_UNUSED, bool initialized)
+{
+	if (!initialized)
+		return;
+
+	vStringDelete (Cpp.directive.name);	/* NULL is acceptable */
+	Cpp.directive.name = NULL;
+	if (Cpp.ungetBuffer)
+	{
+		eFree (Cpp.ungetBuffer);
+		Cpp.ungetBuffer = NULL;
+		Cpp.ungetBufferSize = 0;
+	}
+}
+
 static void CpreProInstallIgnoreToken (const langType language CTAGS_ATTR_UNUSED, const char *optname CTAGS_ATTR_UNUSED, const char *arg)
 {
 	if (arg == NULL || arg[0] == '\0')
@@ -1875,6 +2001,7 @@ extern parserDefinition* CPreProParser (void)
 	def->kindTable      = CPreProKinds;
 	def->kindCount  = ARRAY_SIZE (CPreProKinds);
 	def->initialize = initializeCpp;
+	def->finalize   = finalizeCpp;
 	def->parser     = findCppTags;
 
 	def->parameterHandlerTable = CpreProParameterHandlerTable;
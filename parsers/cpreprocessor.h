@@ -77,6 +77,10 @@ extern void cppUngetc (const int c);
 extern void cppUngetString(const char * string,int len);
 extern int cppGetc (void);
 extern int cppSkipOverCComment (void);
+extern size_t cppSkipOverBlanks (void);
+extern size_t cppSkipOverPlainChars (void);
+extern size_t cppReadPlainChars (vString *const chars);
+extern size_t cppReadIdentifierChars (vString *const name);
 
 /* notify the external parser state for the purpose of conditional
    branch choice. The CXX parser stores the block level here. */
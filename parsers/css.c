@@ -51,16 +51,34 @@ typedef struct {
 	vString *string;
 } tokenInfo;
 
+static inputCharClass SelectorChars;	/* isSelectorChar () ones */
+static inputCharClass BlockChars;		/* all but curlies, quotes and '/' */
+static inputCharClass CommentChars;		/* all but '*' */
+static inputCharClass StringChars [2];	/* all but the delimiter */
+
 
 static void parseSelector (vString *const string, const int firstChar)
 {
-	int c = firstChar;
+	vStringPut (string, (char) firstChar);
+	readInputCharsInClass (&SelectorChars, string);
+}
+
+/* Skip a comment, whose opening is read. */
+static void skipComment (void)
+{
+	int c;
+
 	do
 	{
-		vStringPut (string, (char) c);
+		skipInputCharsInClass (&CommentChars);
 		c = getcFromInputFile ();
-	} while (isSelectorChar (c));
-	ungetcToInputFile (c);
+		while (c == '*')
+		{
+			c = getcFromInputFile ();
+			if (c == '/')
+				return;
+		}
+	} while (c != EOF);
 }
 
 static void readToken (tokenInfo *const token)
@@ -109,13 +127,7 @@ getNextChar:
 			}
 			else
 			{
-				d = getcFromInputFile ();
-				do
-				{
-					c = d;
-					d = getcFromInputFile ();
-				}
-				while (d != EOF && ! (c == '*' && d == '/'));
+				skipComment ();
 				goto getNextChar;
 			}
 			break;
@@ -136,6 +148,47 @@ getNextChar:
 	}
 }
 
+/* Skip a declaration block, whose opening curly is read, to its closing
+ * curly. The tags are made of selectors and at-rules only, so the block
+ * is scanned for the curly closing it without making tokens of it; only
+ * strings and comments, which may contain curlies, are looked into. A
+ * string ends at its delimiter even after a backslash, as readToken ()
+ * ends it. */
+static void skipBlock (void)
+{
+	int depth = 1;
+	int c;
+
+	while (depth > 0)
+	{
+		skipInputCharsInClass (&BlockChars);
+		c = getcFromInputFile ();
+		switch (c)
+		{
+			case EOF:
+				return;
+			case '{':
+				depth++;
+				break;
+			case '}':
+				depth--;
+				break;
+			case '"':
+			case '\'':
+				skipInputCharsInClass (&StringChars [c == '"'? 0: 1]);
+				getcFromInputFile ();
+				break;
+			case '/':
+				c = getcFromInputFile ();
+				if (c == '*')
+					skipComment ();
+				else
+					ungetcToInputFile (c);
+				break;
+		}
+	}
+}
+
 /* sets selector kind in @p kind if found, otherwise don't touches @p kind */
 static cssKind classifySelector (const vString *const selector)
 {
@@ -234,23 +287,26 @@ static void findCssTags (void)
 			vStringDelete (selector);
 		}
 		else if (token.type == '{')
-		{ /* skip over { ... } */
-			int depth = 1;
-			while (depth > 0 && token.type != TOKEN_EOF)
-			{
-				readToken (&token);
-				if (token.type == '{')
-					depth++;
-				else if (token.type == '}')
-					depth--;
-			}
-		}
+			skipBlock ();
 	}
 	while (token.type != TOKEN_EOF);
 
 	vStringDelete (token.string);
 }
 
+static void initialize (const langType language CTAGS_ATTR_UNUSED)
+{
+	unsigned int c;
+
+	initInputCharClass (&SelectorChars, "", false);
+	for (c = 1; c < ARRAY_SIZE (SelectorChars.members); c++)
+		SelectorChars.members [c] = isSelectorChar (c);
+	initInputCharClass (&BlockChars, "{}\"'/", true);
+	initInputCharClass (&CommentChars, "*", true);
+	initInputCharClass (&StringChars [0], "\"", true);
+	initInputCharClass (&StringChars [1], "'", true);
+}
+
 /* parser definition */
 extern parserDefinition* CssParser (void)
 {
@@ -260,5 +316,6 @@ extern parserDefinition* CssParser (void)
 	def->kindCount  = ARRAY_SIZE (CssKinds);
 	def->extensions = extensions;
 	def->parser     = findCssTags;
+	def->initialize = initialize;
 	return def;
 }
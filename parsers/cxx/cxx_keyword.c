@@ -13,6 +13,8 @@
 
 #include "keyword.h"
 
+#include <string.h>
+
 enum CXXKeywordFlag
 {
 	// int, void, const, float, stuff like that
@@ -604,12 +606,100 @@ void cxxKeywordEnableFinal(bool bEnableIt)
 }
 
 
+// The keywords of a length and a first character are a bucket of
+// g_aKeywordsByStart, so that cxxKeywordLookup() rejects most identifiers
+// by looking at them only, and compares the others with a few keywords.
+#define CXX_KEYWORD_MAX_LENGTH 31
+
+typedef struct _CXXKeywordBucket
+{
+	unsigned short uFirst; // in g_aKeywordsByStart
+	unsigned char uCount;
+	unsigned char uLanguages; // of its keywords
+} CXXKeywordBucket;
+
+static CXXKeywordBucket g_aKeywordBuckets[CXX_KEYWORD_MAX_LENGTH + 1][128];
+static unsigned short g_aKeywordsByStart[
+		sizeof(g_aCXXKeywordTable) / sizeof(CXXKeywordDescriptor)
+	];
+static bool g_bKeywordBucketsBuilt = false;
+
+static void cxxBuildKeywordBuckets(void)
+{
+	const size_t count = sizeof(g_aCXXKeywordTable) / sizeof(CXXKeywordDescriptor);
+	unsigned short uNext = 0;
+	size_t i;
+
+	// Count the keywords of each bucket, then give each bucket its range
+	for(i = 0;i < count;i++)
+	{
+		const char * szName = g_aCXXKeywordTable[i].szName;
+		size_t uLength = strlen(szName);
+
+		CXX_DEBUG_ASSERT(uLength <= CXX_KEYWORD_MAX_LENGTH,"Keyword too long");
+		CXX_DEBUG_ASSERT((unsigned char)szName[0] < 0x80,"Keyword not starting with an ASCII character");
+
+		CXXKeywordBucket * b = &g_aKeywordBuckets[uLength][(unsigned char)szName[0]];
+		b->uCount++;
+		b->uLanguages |= g_aCXXKeywordTable[i].uLanguages;
+	}
+
+	size_t l, c;
+	for(l = 0;l <= CXX_KEYWORD_MAX_LENGTH;l++)
+	{
+		for(c = 0;c < 128;c++)
+		{
+			g_aKeywordBuckets[l][c].uFirst = uNext;
+			uNext += g_aKeywordBuckets[l][c].uCount;
+			g_aKeywordBuckets[l][c].uCount = 0;
+		}
+	}
+
+	for(i = 0;i < count;i++)
+	{
+		const char * szName = g_aCXXKeywordTable[i].szName;
+		CXXKeywordBucket * b = &g_aKeywordBuckets[strlen(szName)][(unsigned char)szName[0]];
+
+		g_aKeywordsByStart[b->uFirst + b->uCount] = (unsigned short)i;
+		b->uCount++;
+	}
+
+	g_bKeywordBucketsBuilt = true;
+}
+
+int cxxKeywordLookup(const char * szWord,size_t uLength,unsigned int uLanguage)
+{
+	unsigned char c = (unsigned char)szWord[0];
+
+	if((uLength > CXX_KEYWORD_MAX_LENGTH) || (c >= 0x80))
+		return -1;
+
+	const CXXKeywordBucket * b = &g_aKeywordBuckets[uLength][c];
+
+	if(!(b->uLanguages & uLanguage))
+		return -1;
+
+	unsigned int i;
+	for(i = b->uFirst;i < (unsigned int)b->uFirst + b->uCount;i++)
+	{
+		const CXXKeywordDescriptor * p = g_aCXXKeywordTable + g_aKeywordsByStart[i];
+
+		if((p->uLanguages & uLanguage) && (memcmp(p->szName,szWord,uLength) == 0))
+			return g_aKeywordsByStart[i];
+	}
+
+	return -1;
+}
+
 void cxxBuildKeywordHash(const langType eLangType,unsigned int uLanguage)
 {
 	const size_t count = sizeof(g_aCXXKeywordTable) / sizeof(CXXKeywordDescriptor);
 
 	size_t i;
 
+	if(!g_bKeywordBucketsBuilt)
+		cxxBuildKeywordBuckets();
+
 	for(i = 0;i < count;i++)
 	{
 		const CXXKeywordDescriptor * p = g_aCXXKeywordTable + i;
@@ -138,6 +138,11 @@ const char * cxxKeywordName(CXXKeyword eKeywordId);
 // problems with header inclusions. It works anyway.
 void cxxBuildKeywordHash(const langType eLangType,unsigned int uLanguage);
 
+// The CXXKeyword of the uLength characters of szWord in uLanguage,
+// or -1 if they are not a keyword of it. It gives what lookupKeyword()
+// gives for the keywords added with cxxBuildKeywordHash().
+int cxxKeywordLookup(const char * szWord,size_t uLength,unsigned int uLanguage);
+
 // Keyword enabled/disabled state management.
 //
 // public, protected, private, class, namespace... keywords are C++ only.
@@ -1587,6 +1587,7 @@ static rescanReason cxxParserMain(const unsigned int passCount)
 		);
 
 	g_cxx.iChar = ' ';
+	g_cxx.bSkipFunctionBodies = cxxParserCanSkipFunctionBodies();
 
 	bool bRet = cxxParserParseBlock(false);
 
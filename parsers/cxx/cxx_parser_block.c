@@ -22,9 +22,179 @@
 #include "debug.h"
 #include "keyword.h"
 #include "read.h"
+#include "xtag.h"
 
+#include <ctype.h>
 #include <string.h>
 
+//
+// Tells whether no tag found inside a function body could be emitted in
+// the current file. Locals and labels are found only there. The local
+// classes, enums, typedefs and lambdas (and the members, functions and
+// parameters inside them) are all file scoped outside of headers,
+// and so are dropped along with the fileScope extra. The using
+// declarations aren't file scoped, so their kinds must be disabled too.
+//
+bool cxxParserCanSkipFunctionBodies(void)
+{
+	// Whatever is found in a function body has a scope
+	if(isInputFileShallow())
+		return true;
+
+	if(cxxTagKindEnabled(CXXTagKindLOCAL) || cxxTagKindEnabled(CXXTagKindLABEL))
+		return false;
+
+	if(
+			cxxParserCurrentLanguageIsCPP() &&
+			(
+				cxxTagKindEnabled(CXXTagCPPKindNAME) ||
+				cxxTagKindEnabled(CXXTagCPPKindUSING)
+			)
+		)
+		return false;
+
+	return (!isXtagEnabled(XTAG_FILE_SCOPE)) && (!isInputHeaderFile());
+}
+
+#define cxxParserIsIdentifierChar(c) \
+	(((c) < 0x80) && (isalnum(c) || ((c) == '_')))
+
+//
+// Skip the body of a function, being just after its opening bracket, up
+// to and including the matching closing bracket without building any
+// token. cppGetc() already takes care of comments, strings, raw string
+// literals, character constants and preprocessor directives. The cpp
+// statement state and block nesting level are kept as the full parser
+// would keep them, so that the same #if branches are followed: nothing
+// changes them inside parentheses, which the full parser condenses.
+//
+static bool cxxParserSkipFunctionBody(void)
+{
+	CXX_DEBUG_ENTER();
+
+	int iBlockLevel = 0;
+	int iParenthesisLevel = 0;
+	int iBracketInParenthesisLevel = 0;
+	bool bSeenCase = false;
+	int c = g_cxx.iChar;
+
+	cppPushExternalParserBlock();
+	cppBeginStatement();
+
+	for(;;)
+	{
+		if(c == EOF)
+		{
+			while(iBlockLevel-- >= 0)
+				cppPopExternalParserBlock();
+			g_cxx.iChar = EOF;
+			CXX_DEBUG_LEAVE_TEXT("Syntax error: found EOF in function body");
+			return false;
+		}
+
+		if((c < 0x80) && isspace(c))
+		{
+			c = cppGetc();
+			continue;
+		}
+
+		if(cxxParserIsIdentifierChar(c))
+		{
+			char aWord[5];
+			unsigned int uLength = 0;
+
+			cppBeginStatement();
+			do {
+				if(uLength < sizeof(aWord))
+					aWord[uLength] = (char)c;
+				uLength++;
+				c = cppGetc();
+			} while(cxxParserIsIdentifierChar(c));
+
+			if((uLength == 4) && (strncmp(aWord,"case",4) == 0))
+				bSeenCase = true;
+			continue;
+		}
+
+		if(iParenthesisLevel > 0)
+		{
+			if(c == '(')
+				iParenthesisLevel++;
+			else if(c == ')')
+				iParenthesisLevel--;
+			else if(c == '{')
+				iBracketInParenthesisLevel++;
+			else if(c == '}')
+			{
+				if(iBracketInParenthesisLevel > 0)
+					iBracketInParenthesisLevel--;
+				else
+					iParenthesisLevel = 0; // out of sync: let's recover
+			}
+			if(iParenthesisLevel == 0)
+				iBracketInParenthesisLevel = 0;
+
+			if(c != '}' || iParenthesisLevel > 0 || iBracketInParenthesisLevel > 0)
+			{
+				cppBeginStatement();
+				c = cppGetc();
+				continue;
+			}
+		}
+
+		switch(c)
+		{
+			case '{':
+				iBlockLevel++;
+				cppPushExternalParserBlock();
+				cppBeginStatement();
+			break;
+			case '}':
+				cppPopExternalParserBlock();
+				if(iBlockLevel == 0)
+				{
+					g_cxx.iChar = cppGetc();
+					cxxParserNewStatement();
+					CXX_DEBUG_LEAVE();
+					return true;
+				}
+				iBlockLevel--;
+				bSeenCase = false;
+				cppEndStatement();
+			break;
+			case '(':
+				iParenthesisLevel++;
+				cppBeginStatement();
+			break;
+			case ';':
+				bSeenCase = false;
+				cppEndStatement();
+			break;
+			case ':':
+				c = cppGetc();
+				if(c == ':')
+				{
+					cppBeginStatement();
+					break;
+				}
+				if(bSeenCase)
+				{
+					// case X: ends a statement, labels and default: don't
+					bSeenCase = false;
+					cppEndStatement();
+				} else {
+					cppBeginStatement();
+				}
+			continue;
+			default:
+				cppBeginStatement();
+			break;
+		}
+
+		c = cppGetc();
+	}
+}
+
 bool cxxParserParseBlockHandleOpeningBracket(void)
 {
 	CXX_DEBUG_ENTER();
@@ -135,7 +305,18 @@ bool cxxParserParseBlockHandleOpeningBracket(void)
 
 	cxxParserNewStatement();
 
-	if(!cxxParserParseBlock(true))
+	if(
+			g_cxx.bSkipFunctionBodies &&
+			(iScopes > 0) &&
+			(cxxScopeGetType() == CXXScopeTypeFunction)
+		)
+	{
+		if(!cxxParserSkipFunctionBody())
+		{
+			CXX_DEBUG_LEAVE_TEXT("Failed to skip function body");
+			return false;
+		}
+	} else if(!cxxParserParseBlock(true))
 	{
 		CXX_DEBUG_LEAVE_TEXT("Failed to parse nested block");
 		return false;
@@ -173,6 +354,16 @@ static bool cxxParserParseBlockInternal(bool bExpectClosingBracket)
 
 	for(;;)
 	{
+		// Between two statements of the main block no tag is referred
+		// to by the parser any longer: let the ones in the cork queue be
+		// written now instead of at the end of the file.
+		if(
+				(!bExpectClosingBracket) &&
+				(g_cxx.pTokenChain->iCount == 0) &&
+				cxxScopeIsGlobal()
+			)
+			flushCorkQueue(countEntryInCorkQueue());
+
 		if(!cxxParserParseNextToken())
 		{
 found_eof:
@@ -42,6 +42,7 @@ bool cxxParserHandleLambda(CXXToken * pParenthesis);
 // cxx_parser_block.c
 bool cxxParserParseBlock(bool bExpectClosingBracket);
 bool cxxParserParseBlockHandleOpeningBracket(void);
+bool cxxParserCanSkipFunctionBodies(void);
 
 enum CXXExtractVariableDeclarationsFlags
 {
@@ -305,6 +306,10 @@ typedef struct _CXXParserState
 	// definitely confirm we're parsing C++.
 	bool bConfirmedCPPLanguage;
 
+	// This is set to true when no tag found inside a function body would be
+	// emitted: the bodies are then skipped by matching the brackets only.
+	bool bSkipFunctionBodies;
+
 } CXXParserState;
 
 
@@ -24,7 +24,8 @@
 
 #include <string.h>
 
-#define UINFO(c) (((c) < 0x80 && (c) >= 0) ? g_aCharTable[c].uType : 0)
+// A single comparison for EOF and the characters past the table
+#define UINFO(c) (((unsigned int)(c) < 0x80) ? g_aCharTable[c].uType : 0)
 
 static void cxxParserSkipToNonWhiteSpace(void)
 {
@@ -1164,7 +1165,11 @@ bool cxxParserParseNextToken(void)
 			g_cxx.iChar = cppGetc();
 		}
 
-		int iCXXKeyword = lookupKeyword(t->pszWord->buffer,g_cxx.eLangType);
+		int iCXXKeyword = cxxKeywordLookup(
+				vStringValue(t->pszWord),
+				vStringLength(t->pszWord),
+				g_cxx.eLanguage
+			);
 		if(iCXXKeyword >= 0)
 		{
 			if(cxxKeywordIsDisabled((CXXKeyword)iCXXKeyword))
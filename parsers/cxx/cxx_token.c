@@ -21,13 +21,51 @@
 
 #define CXX_TOKEN_POOL_MAXIMUM_SIZE 8192
 
+// Tokens are allocated CXX_TOKEN_SLAB_SIZE at a time, in contiguous
+// slabs, so that the tokens of a statement are mostly next to each other
+// in memory and creating one rarely calls malloc. A slab is freed when
+// the last of its tokens is.
+#define CXX_TOKEN_SLAB_SIZE 256
+
+typedef struct _CXXTokenSlab
+{
+	// The number of tokens of aTokens not deleted yet, plus one while
+	// the slab is the one new tokens are taken from
+	unsigned int uReferences;
+	unsigned int uUsed;
+	CXXToken aTokens[CXX_TOKEN_SLAB_SIZE];
+} CXXTokenSlab;
+
 static objPool * g_pTokenPool = NULL;
+static CXXTokenSlab * g_pTokenSlab = NULL; // the slab new tokens are taken from
 
 void cxxTokenForceDestroy(CXXToken * t);
 
+static void releaseSlab(CXXTokenSlab * pSlab)
+{
+	pSlab->uReferences--;
+	if(pSlab->uReferences == 0)
+		eFree(pSlab);
+}
+
 static CXXToken *createToken(void *createArg CTAGS_ATTR_UNUSED)
 {
-	CXXToken *t = xMalloc(sizeof(CXXToken),CXXToken);
+	CXXTokenSlab * pSlab = g_pTokenSlab;
+	CXXToken *t;
+
+	if(!pSlab || (pSlab->uUsed == CXX_TOKEN_SLAB_SIZE))
+	{
+		if(pSlab)
+			releaseSlab(pSlab);
+		pSlab = xMalloc(1,CXXTokenSlab);
+		pSlab->uReferences = 1;
+		pSlab->uUsed = 0;
+		g_pTokenSlab = pSlab;
+	}
+
+	t = &pSlab->aTokens[pSlab->uUsed++];
+	pSlab->uReferences++;
+	t->pSlab = pSlab;
 	// we almost always want a string, and since this token
 	// is being reused..well.. we always want it
 	t->pszWord = vStringNew();
@@ -37,7 +75,7 @@ static CXXToken *createToken(void *createArg CTAGS_ATTR_UNUSED)
 static void deleteToken(CXXToken *token)
 {
 	vStringDelete(token->pszWord);
-	eFree(token);
+	releaseSlab(token->pSlab);
 }
 
 static void clearToken(CXXToken *t)
@@ -65,12 +103,17 @@ void cxxTokenAPIInit(void)
 
 void cxxTokenAPINewFile(void)
 {
-	/* Stub */
+	// The pool grows up to the number of tokens live at once: release
+	// what a large previous file left beyond the usual amount.
+	objPoolTrim(g_pTokenPool);
 }
 
 void cxxTokenAPIDone(void)
 {
 	objPoolDelete (g_pTokenPool);
+	if(g_pTokenSlab)
+		releaseSlab(g_pTokenSlab);
+	g_pTokenSlab = NULL;
 }
 
 CXXToken * cxxTokenCreate(void)
@@ -105,9 +148,7 @@ void cxxTokenForceDestroy(CXXToken * t)
 
 	CXX_DEBUG_ASSERT(t->pszWord,"There should be a word here");
 
-	vStringDelete(t->pszWord);
-
-	eFree(t);
+	deleteToken(t);
 }
 
 CXXToken * cxxTokenCreateKeyword(int iLineNumber,MIOPos oFilePosition,CXXKeyword eKeyword)
@@ -86,6 +86,9 @@ typedef struct _CXXToken
 	// uninitialized and must be treated as undefined.
 	unsigned char uInternalScopeType;
 	unsigned char uInternalScopeAccess;
+
+	// The slab the token was allocated from (see cxx_token.c)
+	struct _CXXTokenSlab * pSlab;
 } CXXToken;
 
 CXXToken * cxxTokenCreate(void);
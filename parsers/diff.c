@@ -14,6 +14,7 @@
 #include "general.h"	/* must always come first */
 
 #include <ctype.h>
+#include <stdlib.h>
 #include <string.h>
 
 #include "entry.h"
@@ -54,6 +55,12 @@ static const char *HunkDelim[2] = {
 	" @@",
 };
 
+/* The lines of the hunk body left to skip, as counted in its header */
+typedef struct sHunkBody {
+	unsigned long oldLines;
+	unsigned long newLines;
+} hunkBody;
+
 /*
 *   FUNCTION DEFINITIONS
 */
@@ -126,6 +133,79 @@ static int parseHunk (const unsigned char* cp, vString *hunk, int scope_index)
 	return i;
 }
 
+static bool parseHunkRange (const char *cp, char sign, unsigned long *lines,
+							const char **end)
+{
+	char *next;
+
+	if (*cp++ != sign || ! isdigit ((unsigned char) *cp))
+		return false;
+	strtoul (cp, &next, 10);
+	*lines = 1;
+	if (*next == ',')
+	{
+		cp = next + 1;
+		if (! isdigit ((unsigned char) *cp))
+			return false;
+		*lines = strtoul (cp, &next, 10);
+	}
+	*end = next;
+	return true;
+}
+
+/* Take the line counts of the hunk body from "@@ -a,b +c,d @@"; the
+ * counts of a one line range may be left out. */
+static void parseHunkBody (const unsigned char *cp, hunkBody *body)
+{
+	const char *p = (const char *) cp + 3;
+	hunkBody b;
+
+	if (parseHunkRange (p, '-', &b.oldLines, &p)
+		&& *p++ == ' '
+		&& parseHunkRange (p, '+', &b.newLines, &p)
+		&& strncmp (p, HunkDelim[1], 3u) == 0)
+		*body = b;
+}
+
+/* The body of a hunk is made of context lines, starting with a space,
+ * or left empty by tools dropping the trailing spaces, and of removed
+ * and added lines, all counted in the header; "\ No newline at end of
+ * file" lines are not. The body ends when the counts run out, or at the
+ * first line not fitting in them. */
+static bool isPastHunkBody (const unsigned char *line, size_t length, void *data)
+{
+	hunkBody *const body = data;
+
+	if (body->oldLines == 0 && body->newLines == 0)
+		return true;
+
+	switch (length == 0? '\n': *line)
+	{
+		case ' ':
+		case '\n':
+		case '\r':
+			if (body->oldLines == 0 || body->newLines == 0)
+				break;
+			body->oldLines--;
+			body->newLines--;
+			return false;
+		case '-':
+			if (body->oldLines == 0)
+				break;
+			body->oldLines--;
+			return false;
+		case '+':
+			if (body->newLines == 0)
+				break;
+			body->newLines--;
+			return false;
+		case '\\':
+			return false;
+	}
+	body->oldLines = body->newLines = 0;
+	return true;
+}
+
 static void markTheLastTagAsDeletedFile (int scope_index)
 {
 	tagEntryInfo *e =  getEntryInCorkQueue (scope_index);
@@ -140,8 +220,11 @@ static void findDiffTags (void)
 	int delim = DIFF_DELIM_MINUS;
 	diffKind kind;
 	int scope_index = CORK_NIL;
+	hunkBody body = { 0, 0 };
 
-	while ((line = readLineFromInputFile ()) != NULL)
+	/* Hunk bodies, nearly all of a patch, are skipped by their counts
+	 * without being copied. */
+	while ((line = readWantedLineFromInputFile (isPastHunkBody, &body)) != NULL)
 	{
 		const unsigned char* cp = line;
 
@@ -194,6 +277,7 @@ static void findDiffTags (void)
 		{
 			if (parseHunk (cp, hunk, scope_index) != CORK_NIL)
 				vStringClear (hunk);
+			parseHunkBody (cp, &body);
 		}
 	}
 	vStringDelete (hunk);
@@ -215,9 +215,16 @@ static langType Lang_fortran;
 static int Ungetc;
 static unsigned int Column;
 static bool FreeSourceForm;
-static bool FreeSourceFormFound = false;
+static bool FreeSourceFormFound;
 static bool ParsingString;
 
+/* Characters which getChar () returns as they are in both source forms,
+ * so that runs of them can be read from the input in one go. */
+static inputCharClass IdentifierChars;
+static inputCharClass StringChars;
+static inputCharClass CommentChars;
+static inputCharClass LineChars;
+
 /* indexed by tagType */
 static kindDefinition FortranKinds [] = {
 	{ true,  'b', "blockData",  "block data"},
@@ -562,13 +569,8 @@ static void makeFortranTag (tokenInfo *const token, tagType tag)
 
 static int skipLine (void)
 {
-	int c;
-
-	do
-		c = getcFromInputFile ();
-	while (c != EOF  &&  c != '\n');
-
-	return c;
+	skipInputCharsInClass (&LineChars);
+	return getcFromInputFile ();
 }
 
 static void makeLabelTag (vString *const label)
@@ -821,6 +823,27 @@ static void ungetChar (const int c)
 	Ungetc = c;
 }
 
+/*  Append the run of characters in "klass" that follows to "string" (or
+ *  skip it if "string" is NULL) without going through getChar () for each
+ *  of them. The caller must just have read a character on the same line,
+ *  so no line type or continuation handling can be involved.
+ */
+static void readCharsInClass (const inputCharClass *const klass,
+							  vString *const string)
+{
+	size_t length;
+
+	if (Ungetc != '\0')
+		return;
+#ifdef STRICT_FIXED_FORM
+	if (! FreeSourceForm)
+		return;
+#endif
+	length = readInputCharsInClass (klass, string);
+	if (! FreeSourceForm)
+		Column += length;
+}
+
 /*  If a numeric is passed in 'c', this is used as the first digit of the
  *  numeric being parsed.
  */
@@ -883,10 +906,12 @@ static void parseString (vString *const string, const int delimiter)
 	const unsigned long inputLineNumber = getInputLineNumber ();
 	int c;
 	ParsingString = true;
+	readCharsInClass (&StringChars, string);
 	c = getChar ();
 	while (c != delimiter  &&  c != '\n'  &&  c != EOF)
 	{
 		vStringPut (string, c);
+		readCharsInClass (&StringChars, string);
 		c = getChar ();
 	}
 	if (c == '\n'  ||  c == EOF)
@@ -908,6 +933,7 @@ static void parseIdentifier (vString *const string, const int firstChar)
 	do
 	{
 		vStringPut (string, c);
+		readCharsInClass (&IdentifierChars, string);
 		c = getChar ();
 	} while (isident (c));
 
@@ -984,17 +1010,21 @@ static void readToken (tokenInfo *const token)
 	token->isMethod = false;
 	token->signature = NULL;
 
-getNextChar:
-	c = getChar ();
+	do
+		c = getChar ();
+	while (isBlank (c));
 
-	token->lineNumber	= getInputLineNumber ();
-	token->filePosition	= getInputFilePosition ();
+	/* The position only changes with the line; most tokens share the line
+	 * of the one read before them. */
+	if (token->lineNumber != getInputLineNumber ())
+	{
+		token->lineNumber	= getInputLineNumber ();
+		token->filePosition	= getInputFilePosition ();
+	}
 
 	switch (c)
 	{
 		case EOF:  token->type = TOKEN_EOF;         break;
-		case ' ':  goto getNextChar;
-		case '\t': goto getNextChar;
 		case ',':  token->type = TOKEN_COMMA;       break;
 		case '(':  token->type = TOKEN_PAREN_OPEN;  break;
 		case ')':  token->type = TOKEN_PAREN_CLOSE; break;
@@ -1024,8 +1054,10 @@ getNextChar:
 			if (FreeSourceForm)
 			{
 				do
-				   c = getChar ();
-				while (c != '\n' && c != EOF);
+				{
+					readCharsInClass (&CommentChars, NULL);
+					c = getChar ();
+				} while (c != '\n' && c != EOF);
 			}
 			else
 			{
@@ -2531,6 +2563,9 @@ static rescanReason findFortranTags (const unsigned int passCount)
 	token = newToken ();
 
 	FreeSourceForm = (bool) (passCount > 1);
+	FreeSourceFormFound = false;
+	ParsingString = false;
+	Ungetc = '\0';
 	Column = 0;
 	parseProgramUnit (token);
 	if (FreeSourceFormFound  &&  ! FreeSourceForm)
@@ -2551,7 +2586,16 @@ static rescanReason findFortranTags (const unsigned int passCount)
 
 static void initialize (const langType language)
 {
+	int c;
+
 	Lang_fortran = language;
+
+	initInputCharClass (&IdentifierChars, "", false);
+	for (c = 1; c < ARRAY_SIZE (IdentifierChars.members); c++)
+		IdentifierChars.members [c] = isident (c);
+	initInputCharClass (&StringChars, "\"'&\n", true);
+	initInputCharClass (&CommentChars, "&\n", true);
+	initInputCharClass (&LineChars, "\n", true);
 }
 
 extern parserDefinition* FortranParser (void)
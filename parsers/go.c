@@ -82,6 +82,16 @@ typedef struct sTokenInfo {
 static int Lang_go;
 static objPool *TokenPool = NULL;
 static vString *signature = NULL;
+static tokenType lastTokenType = TOKEN_NONE;
+static unsigned long lastLineNumber;	/* of lastFilePosition */
+static MIOPos lastFilePosition;
+
+static inputCharClass IdentifierChars;	/* isIdentChar () ones */
+static inputCharClass BlankChars;		/* whitespace but '\n' */
+static inputCharClass CommentChars;		/* all but '*' and '\n' */
+static inputCharClass LineCommentChars;	/* all but '\n' */
+static inputCharClass BodyChars;		/* all but curlies, quotes and '/' */
+static inputCharClass StringChars [3];	/* all but the delimiter and '\\' */
 
 typedef enum {
 	GOTAG_UNDEFINED = -1,
@@ -173,8 +183,21 @@ static void deletePoolToken (void* data)
 
 static void initialize (const langType language)
 {
+	unsigned int c;
+
 	Lang_go = language;
 	TokenPool = objPoolNew (16, newPoolToken, deletePoolToken, clearPoolToken, NULL);
+
+	initInputCharClass (&IdentifierChars, "", false);
+	for (c = 1; c < ARRAY_SIZE (IdentifierChars.members); c++)
+		IdentifierChars.members [c] = isIdentChar (c);
+	initInputCharClass (&BlankChars, " \t\r", false);
+	initInputCharClass (&CommentChars, "*\n", true);
+	initInputCharClass (&LineCommentChars, "\n", true);
+	initInputCharClass (&BodyChars, "{}\"'`/", true);
+	initInputCharClass (&StringChars [0], "\"\\", true);
+	initInputCharClass (&StringChars [1], "'\\", true);
+	initInputCharClass (&StringChars [2], "`", true);
 }
 
 static void finalize (const langType language, bool initialized)
@@ -191,10 +214,15 @@ static void finalize (const langType language, bool initialized)
 
 static void parseString (vString *const string, const int delimiter)
 {
+	const inputCharClass *const klass = &StringChars [(delimiter == '"')? 0:
+													  (delimiter == '\'')? 1: 2];
 	bool end = false;
 	while (!end)
 	{
-		int c = getcFromInputFile ();
+		int c;
+
+		readInputCharsInClass (klass, string);
+		c = getcFromInputFile ();
 		if (c == EOF)
 			end = true;
 		else if (c == '\\' && delimiter != '`')
@@ -213,19 +241,28 @@ static void parseString (vString *const string, const int delimiter)
 
 static void parseIdentifier (vString *const string, const int firstChar)
 {
-	int c = firstChar;
-	do
+	vStringPut (string, firstChar);
+	/* The character after it is left to be read: LF might add a semicolon */
+	readInputCharsInClass (&IdentifierChars, string);
+}
+
+/* The position of a line is only looked up when the line changes. */
+static void setTokenPosition (tokenInfo *const token)
+{
+	const unsigned long lineNumber = getInputLineNumber ();
+
+	if (lineNumber != lastLineNumber)
 	{
-		vStringPut (string, c);
-		c = getcFromInputFile ();
-	} while (isIdentChar (c));
-	ungetcToInputFile (c);		/* always unget, LF might add a semicolon */
+		lastLineNumber = lineNumber;
+		lastFilePosition = getInputFilePosition ();
+	}
+	token->lineNumber = lineNumber;
+	token->filePosition = lastFilePosition;
 }
 
 static void readToken (tokenInfo *const token)
 {
 	int c;
-	static tokenType lastTokenType = TOKEN_NONE;
 	bool firstWhitespace = true;
 	bool whitespace;
 
@@ -237,8 +274,6 @@ getNextChar:
 	do
 	{
 		c = getcFromInputFile ();
-		token->lineNumber = getInputLineNumber ();
-		token->filePosition = getInputFilePosition ();
 		if (c == '\n' && (lastTokenType == TOKEN_IDENTIFIER ||
 						  lastTokenType == TOKEN_STRING ||
 						  lastTokenType == TOKEN_OTHER ||
@@ -254,8 +289,11 @@ getNextChar:
 			firstWhitespace = false;
 			vStringPut(signature, ' ');
 		}
+		if (whitespace && c != '\n')
+			skipInputCharsInClass (&BlankChars);
 	}
 	while (whitespace);
+	setTokenPosition (token);
 
 	switch (c)
 	{
@@ -274,7 +312,8 @@ getNextChar:
 				switch (d)
 				{
 					case '/':
-						skipToCharacterInInputFile ('\n');
+						skipInputCharsInClass (&LineCommentChars);
+						getcFromInputFile ();
 						/* Line comments start with the
 						 * character sequence // and
 						 * continue through the next
@@ -287,6 +326,7 @@ getNextChar:
 						{
 							do
 							{
+								skipInputCharsInClass (&CommentChars);
 								d = getcFromInputFile ();
 								if (d == '\n')
 								{
@@ -316,8 +356,7 @@ getNextChar:
 		case '`':
 			token->type = TOKEN_STRING;
 			parseString (token->string, c);
-			token->lineNumber = getInputLineNumber ();
-			token->filePosition = getInputFilePosition ();
+			setTokenPosition (token);
 			break;
 
 		case '<':
@@ -373,8 +412,6 @@ getNextChar:
 			if (isStartIdentChar (c))
 			{
 				parseIdentifier (token->string, c);
-				token->lineNumber = getInputLineNumber ();
-				token->filePosition = getInputFilePosition ();
 				token->keyword = lookupKeyword (vStringValue (token->string), Lang_go);
 				if (isKeyword (token, KEYWORD_NONE))
 					token->type = TOKEN_IDENTIFIER;
@@ -451,6 +488,67 @@ static void skipToMatched (tokenInfo *const token)
 		readToken (token);
 }
 
+/* Skip a function body, whose opening curly is TOKEN, and read the token
+ * after it. Nothing in the body is tagged, so it is scanned for the curly
+ * closing it without making tokens of it; only strings and comments, which
+ * may contain curlies, are looked into. */
+static void skipFunctionBody (tokenInfo *const token)
+{
+	int nest_level = 1;
+	int c;
+
+	while (nest_level > 0)
+	{
+		skipInputCharsInClass (&BodyChars);
+		c = getcFromInputFile ();
+		if (c == EOF)
+			break;
+		switch (c)
+		{
+			case '{':
+				nest_level++;
+				break;
+			case '}':
+				nest_level--;
+				break;
+			case '"':
+			case '\'':
+			case '`':
+				vStringClear (token->string);
+				parseString (token->string, c);
+				break;
+			case '/':
+				c = getcFromInputFile ();
+				if (c == '/')
+				{
+					skipInputCharsInClass (&LineCommentChars);
+					getcFromInputFile ();
+				}
+				else if (c == '*')
+				{
+					do
+					{
+						skipInputCharsInClass (&CommentChars);
+						c = getcFromInputFile ();
+						if (c == '*')
+						{
+							c = getcFromInputFile ();
+							if (c == '/')
+								break;
+							ungetcToInputFile (c);
+						}
+					} while (c != EOF);
+				}
+				else
+					ungetcToInputFile (c);
+				break;
+		}
+	}
+
+	lastTokenType = (nest_level > 0)? TOKEN_EOF: TOKEN_CLOSE_CURLY;
+	readToken (token);
+}
+
 static bool skipType (tokenInfo *const token)
 {
 	// Type      = TypeName | TypeLit | "(" Type ")" .
@@ -658,7 +756,7 @@ static void parseFunctionOrMethod (tokenInfo *const token, const int scope)
 
 		// Skip over function body.
 		if (isType (token, TOKEN_OPEN_CURLY))
-			skipToMatched (token);
+			skipFunctionBody (token);
 	}
 
 	if (receiver_type_token)
@@ -903,6 +1001,8 @@ static void findGoTags (void)
 {
 	tokenInfo *const token = newToken ();
 
+	lastLineNumber = getInputLineNumber ();
+	lastFilePosition = getInputFilePosition ();
 	parseGoFile (token);
 
 	deleteToken (token);
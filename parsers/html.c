@@ -137,6 +137,14 @@ typedef struct {
 
 static int Lang_html;
 
+/* The characters read in bulk, one span at a time */
+static inputCharClass BlankChars;
+static inputCharClass TextChars;			/* all but '<' */
+static inputCharClass CommentChars;			/* all but '-' and '>' */
+static inputCharClass DoubleQuotedChars;	/* all but '"' */
+static inputCharClass SingleQuotedChars;	/* all but '\'' */
+static inputCharClass NameChars;			/* all but the ones ending a name */
+
 
 static void readTag (tokenInfo *token, vString *text, int depth);
 
@@ -158,6 +166,8 @@ static void readTokenText (tokenInfo *const token, bool collectText)
 
 getNextChar:
 
+	if (!collectText)
+		skipInputCharsInClass (&TextChars);
 	c = getcFromInputFile ();
 
 	switch (c)
@@ -196,6 +206,7 @@ static void readToken (tokenInfo *const token, bool skipComments)
 
 getNextChar:
 
+	skipInputCharsInClass (&BlankChars);
 	c = getcFromInputFile ();
 	while (isspace (c))
 		c = getcFromInputFile ();
@@ -222,6 +233,13 @@ getNextChar:
 						int f = ' ';
 						do
 						{
+							/* Neither '-' nor '>' is skipped */
+							size_t n = skipInputCharsInClass (&CommentChars);
+							if (n > 0)
+							{
+								e = (n == 1)? f: ' ';
+								f = ' ';
+							}
 							d = e;
 							e = f;
 							f = getcFromInputFile ();
@@ -275,6 +293,9 @@ getNextChar:
 		case '\'':
 		{
 			const int delimiter = c;
+			readInputCharsInClass ((delimiter == '"')
+								   ? &DoubleQuotedChars: &SingleQuotedChars,
+								   token->string);
 			c = getcFromInputFile ();
 			while (c != EOF && c != delimiter)
 			{
@@ -287,21 +308,55 @@ getNextChar:
 
 		default:
 		{
-			do
-			{
-				vStringPut (token->string, tolower (c));
-				c = getcFromInputFile ();
-			}
-			while (!isspace (c) && c != '<' && c != '>' && c != '/' &&
-				   c != '=' && c != '\'' && c != '"' && c != EOF);
-			if (c != EOF)
-				ungetcToInputFile (c);
+			vStringPut (token->string, c);
+			readInputCharsInClass (&NameChars, token->string);
+			vStringLower (token->string);
 			token->type = TOKEN_NAME;
 			break;
 		}
 	}
 }
 
+/*  Pass over the blanks and the names that follow in a tag, and over an
+ *  attribute value in quotes, as readToken () would read them. Return
+ *  false, having consumed nothing else, when readToken () is to read what
+ *  follows.
+ */
+static bool skimAttribute (tokenInfo *const token)
+{
+	size_t n = 0;
+	size_t m;
+	int c;
+
+	do
+	{
+		m = skipInputCharsInClass (&BlankChars);
+		m += skipInputCharsInClass (&NameChars);
+		n += m;
+	}
+	while (m > 0);
+
+	c = getcFromInputFile ();
+
+	if (c == '"' || c == '\'')
+	{
+		skipInputCharsInClass ((c == '"')? &DoubleQuotedChars: &SingleQuotedChars);
+		getcFromInputFile ();	/* the delimiter, or EOF */
+		vStringClear (token->string);
+		token->type = TOKEN_STRING;
+		return true;
+	}
+
+	ungetcToInputFile (c);
+	if (n > 0)
+	{
+		vStringClear (token->string);
+		token->type = TOKEN_NAME;
+		return true;
+	}
+	return false;
+}
+
 static void appendText (vString *text, vString *appendedText)
 {
 	if (text != NULL && vStringLength (appendedText) > 0)
@@ -403,6 +458,11 @@ static void readTag (tokenInfo *token, vString *text, int depth)
 
 		do
 		{
+			/* Only the attributes of <a> are looked at. The names and
+			 * values of the others are passed over without being read. */
+			if (startTag != KEYWORD_a && skimAttribute (token))
+				continue;
+
 			readToken (token, true);
 			if (startTag == KEYWORD_a && token->type == TOKEN_NAME)
 			{
@@ -502,6 +562,13 @@ static void findHtmlTags (void)
 static void initialize (const langType language)
 {
 	Lang_html = language;
+
+	initInputCharClass (&BlankChars, " \t\n\v\f\r", false);
+	initInputCharClass (&TextChars, "<", true);
+	initInputCharClass (&CommentChars, "->", true);
+	initInputCharClass (&DoubleQuotedChars, "\"", true);
+	initInputCharClass (&SingleQuotedChars, "'", true);
+	initInputCharClass (&NameChars, " \t\n\v\f\r<>/='\"", true);
 }
 
 /* parser definition */
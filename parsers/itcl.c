@@ -105,10 +105,8 @@ static void parseInherit (tokenInfo *token, int r)
 	{
 		tagEntryInfo *e = getEntryInCorkQueue (r);
 		if (e)
-		{
-			e->extensionFields.inheritance = vStringDeleteUnwrap (inherits);
-			return;
-		}
+			e->extensionFields.inheritance = copyStringToCorkEntry (r,
+																	vStringValue (inherits));
 	}
 
 	vStringDelete (inherits);
@@ -293,6 +291,8 @@ static void inputStart (subparser *s)
 	itcl->foundITclNamespaceImported = false;
 }
 
+static const char *const ITclCommands [] = { "class", "itcl::class", NULL };
+
 struct itclSubparser itclSubparser = {
 	.tcl = {
 		.subparser = {
@@ -300,6 +300,7 @@ struct itclSubparser itclSubparser = {
 			.inputStart = inputStart,
 		},
 		.commandNotify = commandNotify,
+		.commands = ITclCommands,
 		.packageRequirementNotify = packageRequirementNotify,
 		.namespaceImportNotify = namespaceImportNotify,
 	},
@@ -28,6 +28,7 @@
 #include "debug.h"
 #include "entry.h"
 #include "keyword.h"
+#include "options.h"
 #include "parse.h"
 #include "read.h"
 #include "routines.h"
@@ -46,6 +47,13 @@
 #define newToken() (objPoolGet (TokenPool))
 #define deleteToken(t) (objPoolPut (TokenPool, (t)))
 
+/*
+ * A file whose first MINIFIED_SAMPLE_SIZE bytes have lines longer than
+ * MINIFIED_LINE_LENGTH on average is taken for a minified bundle.
+ */
+#define MINIFIED_SAMPLE_SIZE	(64 * 1024)
+#define MINIFIED_LINE_LENGTH	512
+
 /*
  * Debugging
  *
@@ -2194,6 +2202,218 @@ static bool parseLine (tokenInfo *const token, bool is_inside_class)
 	return is_terminated;
 }
 
+/*
+ *	 Minified input
+ *
+ * The statement parser above descends into every nested function, which
+ * stalls on bundles made of a single huge line of deeply nested code.
+ * For these only the names declared by the top-level statements are
+ * tagged, also when they are exported:
+ *	   function f(a,b) {}		class C {}
+ *	   var a = 1, b = function (c) {}, D = class {};
+ * Everything between brackets is skipped by counting them. A single token
+ * is looked at a time; only the name of a declaration is copied.
+ */
+
+static bool isMinifiedInput (void)
+{
+	size_t size = 0;
+	size_t lines = 0;
+	const unsigned char *const data = getInputFileData (&size);
+	const unsigned char *p, *end;
+
+	if (data == NULL || size == 0 || doesParserRunAsGuest ())
+		return false;
+
+	if (size > MINIFIED_SAMPLE_SIZE)
+		size = MINIFIED_SAMPLE_SIZE;
+	for (p = data, end = data + size;
+		 (p = memchr (p, '\n', end - p)) != NULL; p++)
+		lines++;
+	if (data [size - 1] != '\n')
+		lines++;	/* the last line, cut or not terminated */
+
+	return size / lines > MINIFIED_LINE_LENGTH;
+}
+
+/* Read the argument list starting at TOKEN into SIGNATURE, up to its
+ * closing parenthesis. */
+static void readMinifiedSignature (tokenInfo *const token, vString *const signature)
+{
+	int nest_level = 1;
+
+	vStringPut (signature, '(');
+	while (nest_level > 0 && ! isType (token, TOKEN_EOF))
+	{
+		readTokenFull (token, false, signature);
+		if (isType (token, TOKEN_OPEN_PAREN))
+			nest_level++;
+		else if (isType (token, TOKEN_CLOSE_PAREN))
+			nest_level--;
+	}
+}
+
+/* Tag the function or class whose keyword is TOKEN, named NAME, or the
+ * token following it when NAME is NULL. TOKEN is left on the last token
+ * looked at: the end of the argument list of a function. */
+static void parseMinifiedDefinition (tokenInfo *const token, tokenInfo *const name)
+{
+	tokenInfo *const defName = name? name: newToken ();
+	const bool is_class = isKeyword (token, KEYWORD_class);
+	bool is_generator = false;
+
+	readTokenFull (token, true, NULL);
+	if (! is_class && isType (token, TOKEN_STAR))
+	{
+		is_generator = true;
+		readTokenFull (token, true, NULL);
+	}
+	if (isType (token, TOKEN_IDENTIFIER))
+	{
+		if (! name)
+			copyToken (defName, token, false);
+		readTokenFull (token, true, NULL);
+	}
+
+	if (vStringLength (defName->string) == 0)
+		/* anonymous */;
+	else if (is_class)
+		makeJsTag (defName, JSTAG_CLASS, NULL, NULL);
+	else if (isType (token, TOKEN_OPEN_PAREN))
+	{
+		vString *const signature = vStringNew ();
+
+		readMinifiedSignature (token, signature);
+		makeJsTag (defName, is_generator? JSTAG_GENERATOR: JSTAG_FUNCTION,
+				   signature, NULL);
+		vStringDelete (signature);
+	}
+
+	if (! name)
+		deleteToken (defName);
+}
+
+/* Tag the variable declared by the declarator starting at TOKEN in a
+ * var, let or const statement. TOKEN is left on the first token not
+ * looked at. */
+static void parseMinifiedDeclarator (tokenInfo *const token, const bool is_const)
+{
+	tokenInfo *name;
+
+	if (! isType (token, TOKEN_IDENTIFIER))
+		return;	/* destructuring */
+
+	name = newToken ();
+	copyToken (name, token, false);
+	readTokenFull (token, true, NULL);
+	if (isType (token, TOKEN_EQUAL_SIGN))
+	{
+		readTokenFull (token, true, NULL);
+		if (isKeyword (token, KEYWORD_function) || isKeyword (token, KEYWORD_class))
+		{
+			parseMinifiedDefinition (token, name);
+			readTokenFull (token, true, NULL);
+			deleteToken (name);
+			return;
+		}
+	}
+	makeJsTag (name, is_const ? JSTAG_CONSTANT : JSTAG_VARIABLE, NULL, NULL);
+	deleteToken (name);
+}
+
+static void parseMinifiedJsFile (tokenInfo *const token)
+{
+	JSCRIPT_DEBUG_ENTER();
+
+	int depth = 0;
+	bool at_statement_start = true;
+	bool in_declaration = false;
+	bool is_const = false;
+
+	readTokenFull (token, true, NULL);
+	while (! isType (token, TOKEN_EOF))
+	{
+		bool read_next = true;
+
+		switch (token->type)
+		{
+			case TOKEN_OPEN_PAREN:
+			case TOKEN_OPEN_CURLY:
+			case TOKEN_OPEN_SQUARE:
+				depth++;
+				at_statement_start = false;
+				break;
+
+			case TOKEN_CLOSE_PAREN:
+			case TOKEN_CLOSE_CURLY:
+			case TOKEN_CLOSE_SQUARE:
+				if (depth > 0)
+					depth--;
+				/* the end of the body of a function, class or block */
+				at_statement_start = (depth == 0 && ! in_declaration &&
+									  isType (token, TOKEN_CLOSE_CURLY));
+				break;
+
+			case TOKEN_SEMICOLON:
+				if (depth == 0)
+				{
+					at_statement_start = true;
+					in_declaration = false;
+				}
+				break;
+
+			case TOKEN_COMMA:
+				if (depth == 0 && in_declaration)
+				{
+					readTokenFull (token, true, NULL);
+					parseMinifiedDeclarator (token, is_const);
+					read_next = false;
+				}
+				break;
+
+			case TOKEN_KEYWORD:
+				if (depth > 0 || ! at_statement_start)
+					break;
+				switch (token->keyword)
+				{
+					case KEYWORD_export:
+					case KEYWORD_default:
+					case KEYWORD_async:
+						break;
+					case KEYWORD_function:
+					case KEYWORD_class:
+						parseMinifiedDefinition (token, NULL);
+						at_statement_start = false;
+						break;
+					case KEYWORD_var:
+					case KEYWORD_let:
+					case KEYWORD_const:
+						is_const = isKeyword (token, KEYWORD_const);
+						in_declaration = true;
+						at_statement_start = false;
+						readTokenFull (token, true, NULL);
+						parseMinifiedDeclarator (token, is_const);
+						read_next = false;
+						break;
+					default:
+						at_statement_start = false;
+						break;
+				}
+				break;
+
+			default:
+				if (depth == 0)
+					at_statement_start = false;
+				break;
+		}
+
+		if (read_next)
+			readTokenFull (token, true, NULL);
+	}
+
+	JSCRIPT_DEBUG_LEAVE();
+}
+
 static void parseJsFile (tokenInfo *const token)
 {
 	JSCRIPT_DEBUG_ENTER();
@@ -2239,7 +2459,14 @@ static void findJsTags (void)
 	FunctionNames = stringListNew ();
 	LastTokenType = TOKEN_UNDEFINED;
 
-	parseJsFile (token);
+	if (isInputFileShallow () || isMinifiedInput ())
+	{
+		verbose ("%s: minified or generated input, tagging its top-level names only\n",
+				 getInputFileName ());
+		parseMinifiedJsFile (token);
+	}
+	else
+		parseJsFile (token);
 
 	stringListDelete (ClassNames);
 	stringListDelete (FunctionNames);
@@ -72,6 +72,11 @@ typedef enum {
 
 static langType Lang_json;
 
+static inputCharClass BlankChars;
+/* The characters of a string which need no special care */
+static inputCharClass StringChars;
+static inputCharClass IdentChars;
+
 static kindDefinition JsonKinds [] = {
 	{ true,  'o', "object",		"objects"	},
 	{ true,  'a', "array",		"arrays"	},
@@ -149,12 +154,15 @@ static void readTokenFull (tokenInfo *const token,
 	token->type = TOKEN_UNDEFINED;
 	vStringClear (token->string);
 
-	do
-		c = getcFromInputFile ();
-	while (c == '\t' || c == ' ' || c == '\r' || c == '\n');
+	skipInputCharsInClass (&BlankChars);
+	c = getcFromInputFile ();
 
-	token->lineNumber   = getInputLineNumber ();
-	token->filePosition = getInputFilePosition ();
+	/* Many tokens share a line: only look up the position on a new one */
+	if (token->lineNumber != getInputLineNumber ())
+	{
+		token->lineNumber   = getInputLineNumber ();
+		token->filePosition = getInputFilePosition ();
+	}
 
 	switch (c)
 	{
@@ -172,6 +180,12 @@ static void readTokenFull (tokenInfo *const token,
 			token->type = TOKEN_STRING;
 			while (true)
 			{
+				if (escaped)
+					; /* read the escaped character below */
+				else if (includeStringRepr)
+					readInputCharsInClass (&StringChars, token->string);
+				else
+					skipInputCharsInClass (&StringChars);
 				c = getcFromInputFile ();
 				/* we don't handle unicode escapes but they are safe */
 				if (escaped)
@@ -193,13 +207,8 @@ static void readTokenFull (tokenInfo *const token,
 				token->type = TOKEN_UNDEFINED;
 			else
 			{
-				do
-				{
-					vStringPut (token->string, c);
-					c = getcFromInputFile ();
-				}
-				while (c != EOF && isIdentChar (c));
-				ungetcToInputFile (c);
+				vStringPut (token->string, c);
+				readInputCharsInClass (&IdentChars, token->string);
 				switch (lookupKeyword (vStringValue (token->string), Lang_json))
 				{
 					case KEYWORD_true:	token->type = TOKEN_TRUE;	break;
@@ -371,7 +380,17 @@ static void findJsonTags (void)
 
 static void initialize (const langType language)
 {
+	int c;
+
 	Lang_json = language;
+
+	initInputCharClass (&BlankChars, "\t \r\n", false);
+	initInputCharClass (&StringChars, "\"\\", true);
+	for (c = 0x01; c <= 0x1F; c++)
+		StringChars.members [c] = false;
+	initInputCharClass (&IdentChars, "", false);
+	for (c = 1; c < ARRAY_SIZE (IdentChars.members); c++)
+		IdentChars.members [c] = isIdentChar (c);
 }
 
 /* Create parser definition structure */
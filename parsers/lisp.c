@@ -12,9 +12,12 @@
 */
 #include "general.h"  /* must always come first */
 
+#include <string.h>
+
 #include "parse.h"
 #include "read.h"
 #include "routines.h"
+#include "sexp.h"
 #include "vstring.h"
 
 /*
@@ -36,41 +39,42 @@ static kindDefinition LispKinds [] = {
  * lisp tag functions
  *  look for (def or (DEF, quote or QUOTE
  */
-static int L_isdef (const unsigned char *strp)
+static bool L_isdef (const char *strp)
 {
-	return ( (strp [1] == 'd' || strp [1] == 'D')
-		  && (strp [2] == 'e' || strp [2] == 'E')
-		  && (strp [3] == 'f' || strp [3] == 'F'));
+	return strncasecmp (strp, "def", 3) == 0;
 }
 
-static int L_isquote (const unsigned char *strp)
+/* (def..., or (foo::defmumble... */
+static bool L_isdefform (const vString *const head)
 {
-	return ( (*(++strp) == 'q' || *strp == 'Q')
-		  && (*(++strp) == 'u' || *strp == 'U')
-		  && (*(++strp) == 'o' || *strp == 'O')
-		  && (*(++strp) == 't' || *strp == 'T')
-		  && (*(++strp) == 'e' || *strp == 'E')
-		  && isspace (*(++strp)));
+	const char *colon;
+
+	if (L_isdef (vStringValue (head)))
+		return true;
+	colon = strchr (vStringValue (head), ':');
+	if (colon == NULL)
+		return false;
+	while (*colon == ':')
+		colon++;
+	return L_isdef (colon);
 }
 
-static void L_getit (vString *const name, const unsigned char *dbp)
+static void L_getit (sexpSkimmer *skimmer, vString *const name)
 {
-	const unsigned char *p;
+	const int c = skipSexpBlanks (skimmer, false);
 
-	if (*dbp == '\'')  /* Skip prefix quote */
-		dbp++;
-	else if (*dbp == '(' && L_isquote (dbp))  /* Skip "(quote " */
+	if (c == '\'')  /* Skip prefix quote */
+		skipSexpChar (skimmer, c);
+	else if (c == '(')  /* Skip "(quote " */
 	{
-		dbp += 7;
-		while (isspace (*dbp))
-		dbp++;
+		skipSexpChar (skimmer, c);
+		readSexpSymbol (skimmer, name);
+		if (strcasecmp (vStringValue (name), "quote") != 0)
+			return;
+		skipSexpBlanks (skimmer, false);
 	}
-	for (p=dbp ; *p!='\0' && *p!='(' && !isspace ((int) *p) && *p!=')' ; p++)
-		vStringPut (name, *p);
-
-	if (vStringLength (name) > 0)
-		makeSimpleTag (name, K_FUNCTION);
-	vStringClear (name);
+	readSexpSymbol (skimmer, name);
+	makeSimpleTag (name, K_FUNCTION);
 }
 
 /* Algorithm adapted from from GNU etags.
@@ -78,45 +82,14 @@ static void L_getit (vString *const name, const unsigned char *dbp)
 static void findLispTags (void)
 {
 	vString *name = vStringNew ();
-	const unsigned char* p;
+	sexpSkimmer skimmer;
 
-
-	while ((p = readLineFromInputFile ()) != NULL)
+	initSexpSkimmer (&skimmer, SEXP_BLOCK_COMMENT);
+	while (skimToTopLevelForm (&skimmer))
 	{
-		if (*p == '(')
-		{
-			if (L_isdef (p))
-			{
-				while (*p != '\0' && !isspace ((int) *p))
-					p++;
-				while (isspace ((int) *p))
-					p++;
-				L_getit (name, p);
-			}
-			else
-			{
-				/* Check for (foo::defmumble name-defined ... */
-				do
-					p++;
-				while (*p != '\0' && !isspace ((int) *p)
-						&& *p != ':' && *p != '(' && *p != ')');
-				if (*p == ':')
-				{
-					do
-						p++;
-					while (*p == ':');
-
-					if (L_isdef (p - 1))
-					{
-						while (*p != '\0' && !isspace ((int) *p))
-							p++;
-						while (isspace (*p))
-							p++;
-						L_getit (name, p);
-					}
-				}
-			}
-		}
+		readSexpSymbol (&skimmer, name);
+		if (L_isdefform (name))
+			L_getit (&skimmer, name);
 	}
 	vStringDelete (name);
 }
@@ -83,10 +83,21 @@ static const keywordTable m4KeywordTable[] = {
 static char m4QuoteOpen = 0;
 static char m4QuoteClose = 0;
 
+/* The characters a quoted string is made of, other than its quotes:
+   they are skipped in bulk rather than one by one. */
+static inputCharClass m4QuotedChars;
+/* The characters of a line, other than its ending */
+static inputCharClass m4LineChars;
+
 extern void setM4Quotes(char openQuote, char closeQuote)
 {
+	const char quotes [] = { openQuote, closeQuote, '\0' };
+
 	m4QuoteOpen = openQuote;
 	m4QuoteClose = closeQuote;
+
+	/* A NUL open quote ends the string, but also disables quoting. */
+	initInputCharClass (&m4QuotedChars, quotes, true);
 }
 
 /* gets the close quote corresponding to openQuote.
@@ -119,6 +130,8 @@ static void skipQuotes(int c)
 			depth ++;
 		if (depth == 0)
 			break;
+		/* Macro bodies and the shell code in them make no tags. */
+		skipInputCharsInClass (&m4QuotedChars);
 	}
 }
 
@@ -152,7 +165,12 @@ static void readQuotedWord(vString *const name)
 			depth --;
 		else if (c == openQuote)
 			depth ++;
-		else if (IS_WORD(c) || depth > 0)
+		else if (depth > 0)
+		{
+			vStringPut(name, c);
+			readInputCharsInClass (&m4QuotedChars, name);
+		}
+		else if (IS_WORD(c))
 			vStringPut(name, c);
 		else
 		{
@@ -197,6 +215,7 @@ static void skipLine(int c)
 	{
 		if (skipLineEnding(c))
 			break;
+		skipInputCharsInClass (&m4LineChars);
 	}
 }
 
@@ -209,9 +228,11 @@ static m4Subparser * maySwitchLanguage (const char* token)
 	{
 		m4Subparser *m4tmp = (m4Subparser *)tmp;
 
+		if (!m4tmp->probeLanguage)
+			continue;
+
 		enterSubparser(tmp);
-		if (m4tmp->probeLanguage
-			&& m4tmp->probeLanguage (m4tmp, token))
+		if (m4tmp->probeLanguage (m4tmp, token))
 		{
 			chooseExclusiveSubparser (tmp, NULL);
 			m4found = m4tmp;
@@ -468,6 +489,7 @@ static void findM4Tags(void)
 	int index = CORK_NIL;
 
 	setM4Quotes ('`', '\'');
+	initInputCharClass (&m4LineChars, "\r\n", true);
 
 	sub = (m4Subparser *)getSubparserRunningBaseparser();
 	if (sub)
@@ -67,11 +67,19 @@ static int nextChar (void)
 	return c;
 }
 
+/* The characters read in bulk, one span at a time */
+static inputCharClass LineChars;		/* all but '\\' and '\n' */
+static inputCharClass IdentifierChars;	/* isIdentifier () ones but "(){}" */
+static inputCharClass NestedChars;		/* all but "(){}", '\\' and '\n' */
+
 static void skipLine (void)
 {
 	int c;
 	do
+	{
+		skipInputCharsInClass (&LineChars);
 		c = nextChar ();
+	}
 	while (c != EOF  &&  c != '\n');
 	if (c == '\n')
 		ungetcToInputFile (c);
@@ -143,10 +151,12 @@ static void newMacro (vString *const name, bool with_define_directive, bool appe
 	foreachSubparser(s, false)
 	{
 		makeSubparser *m = (makeSubparser *)s;
-		enterSubparser(s);
 		if (m->newMacroNotify)
+		{
+			enterSubparser(s);
 			m->newMacroNotify (m, vStringValue(name), with_define_directive, appending);
-		leaveSubparser();
+			leaveSubparser();
+		}
 	}
 }
 
@@ -156,10 +166,12 @@ static void valueFound (vString *const name)
 	foreachSubparser(s, false)
 	{
 		makeSubparser *m = (makeSubparser *)s;
-		enterSubparser(s);
 		if (m->valueNotify)
+		{
+			enterSubparser(s);
 			m->valueNotify (m, vStringValue (name));
-		leaveSubparser();
+			leaveSubparser();
+		}
 	}
 }
 
@@ -169,10 +181,12 @@ static void directiveFound (vString *const name)
 	foreachSubparser (s, false)
 	{
 		makeSubparser *m = (makeSubparser *)s;
-		enterSubparser(s);
 		if (m->directiveNotify)
+		{
+			enterSubparser(s);
 			m->directiveNotify (m, vStringValue (name));
-		leaveSubparser();
+			leaveSubparser();
+		}
 	}
 }
 
@@ -201,6 +215,7 @@ static void readIdentifier (const int first, vString *const id)
 		else if (depth > 0 && (c == ')' || c == '}'))
 			depth--;
 		vStringPut (id, c);
+		readInputCharsInClass (depth > 0? &NestedChars: &IdentifierChars, id);
 		c = nextChar ();
 	}
 	ungetcToInputFile (c);
@@ -361,6 +376,17 @@ static void findMakeTags (void)
 }
 
 
+static void initialize (const langType language CTAGS_ATTR_UNUSED)
+{
+	int c;
+
+	initInputCharClass (&LineChars, "\\\n", true);
+	initInputCharClass (&IdentifierChars, "", false);
+	for (c = 1; c < ARRAY_SIZE (IdentifierChars.members); c++)
+		IdentifierChars.members [c] = (isIdentifier (c) && !strchr ("(){}", c));
+	initInputCharClass (&NestedChars, "(){}\\\n", true);
+}
+
 extern parserDefinition* MakefileParser (void)
 {
 	static const char *const patterns [] = { "[Mm]akefile", "GNUmakefile", NULL };
@@ -376,5 +402,6 @@ extern parserDefinition* MakefileParser (void)
 	def->extensions = extensions;
 	def->aliases = aliases;
 	def->parser     = findMakeTags;
+	def->initialize = initialize;
 	return def;
 }
@@ -642,7 +642,8 @@ static void parseMethodsNameCommon (vString * const ident, objcToken what,
 				vStringCatS (signature, "id");
 			vStringPut (signature, ')');
 
-			e->extensionFields.signature = eStrdup (vStringValue (signature));
+			e->extensionFields.signature = copyStringToCorkEntry (index,
+																  vStringValue (signature));
 
 			vStringClear (signature);
 			vStringPut (signature, '(');
@@ -172,6 +172,7 @@ static bool exportLocalInfo = false;
 //// lexingInit             */
 typedef struct _lexingState {
 	vString *name;	/* current parsed identifier/operator */
+	bool named;		/* whether name was set by the last lex () */
 	const unsigned char *cp;	/* position in stream */
 } lexingState;
 
@@ -334,17 +335,19 @@ static void eatComment (lexingState * st)
 
 static void readIdentifier (lexingState * st)
 {
+	const unsigned char *start = st->cp;
 	const unsigned char *p;
-	vStringClear (st->name);
 
 	/* first char is a simple letter */
-	if (isAlpha (*st->cp) || *st->cp == '_')
-		vStringPut (st->name, (int) *st->cp);
+	if (! (isAlpha (*start) || *start == '_'))
+		start++;
 
 	/* Go till you get identifier chars */
 	for (p = st->cp + 1; isIdent (*p); p++)
-		vStringPut (st->name, (int) *p);
+		;
 
+	vStringNCopyS (st->name, (const char *) start, p - start);
+	st->named = true;
 	st->cp = p;
 }
 
@@ -365,10 +368,9 @@ static ocamlKeyword eatOperator (lexingState * st)
 	vStringClear (st->name);
 
 	while (isOperator[st->cp[count]])
-	{
-		vStringPut (st->name, st->cp[count]);
 		count++;
-	}
+	vStringNCatS (st->name, (const char *) root, count);
+	st->named = true;
 
 	st->cp += count;
 	if (count <= 1)
@@ -399,6 +401,8 @@ static ocamlKeyword eatOperator (lexingState * st)
 static ocamlKeyword lex (lexingState * st)
 {
 	int retType;
+
+	st->named = false;
 	/* handling data input here */
 	while (st->cp == NULL || st->cp[0] == '\0')
 	{
@@ -893,6 +897,17 @@ static contextType killCurrentState ( void )
 static unsigned long ocaLineNumber;
 static MIOPos ocaFilePosition;
 
+/* The position only changes with the line; most tokens share the line
+ * of the one read before them. */
+static void updateOcaPosition (void)
+{
+	if (ocaLineNumber != getInputLineNumber ())
+	{
+		ocaLineNumber = getInputLineNumber ();
+		ocaFilePosition = getInputFilePosition ();
+	}
+}
+
 /* Used to prepare an OCaml tag, just in case there is a need to
  * add additional information to the tag. */
 static void prepareTag (tagEntryInfo * tag, vString const *name, int kind)
@@ -2022,7 +2037,6 @@ static void findOcamlTags (void)
 	tempIdent = vStringNew ();
 	lastModule = vStringNew ();
 	lastClass = vStringNew ();
-	vString *temp_cp = vStringNew ();
 
 	nextSt.name = vStringNew ();
 	nextSt.cp = readLineFromInputFile ();
@@ -2034,13 +2048,13 @@ static void findOcamlTags (void)
 	if (nextTok != Tok_EOF)
 		computeModuleName ();
 
-	/* prime the lookahead token */
-	st = nextSt;	// preserve the old state for our first token
-	st.name = vStringNewCopy (st.name);
-	st.cp = (const unsigned char *) temp_cp->buffer;
+	/* prime the lookahead token. Only the name of the current token is
+	 * looked at by the parsing functions: the input is read through
+	 * nextSt alone. */
+	st.name = vStringNewCopy (nextSt.name);
+	st.cp = NULL;
 	tok = nextTok;
-	ocaLineNumber = getInputLineNumber(); /* ??? getSourceLineNumber() */
-	ocaFilePosition = getInputFilePosition();
+	updateOcaPosition (); /* ??? getSourceLineNumber() */
 	nextTok = lex (&nextSt);
 
 	/* main loop */
@@ -2049,15 +2063,20 @@ static void findOcamlTags (void)
 		(*toDoNext) (st.name, tok, nextTok);
 
 		tok = nextTok;
-		ocaLineNumber = getInputLineNumber(); /* ??? */
-		ocaFilePosition = getInputFilePosition();
+		updateOcaPosition (); /* ??? */
 
 		if (nextTok != Tok_EOF)
 		{
-			vStringCopyS (temp_cp, (const char *) nextSt.cp);
-			st.cp = (const unsigned char *) temp_cp->buffer;
-			vStringCopy (st.name, nextSt.name);
+			/* The name of the lookahead token is taken over instead
+			 * of copied. A token without a name of its own keeps the
+			 * one of the token before it. */
+			vString *const name = st.name;
+
+			st.name = nextSt.name;
+			nextSt.name = name;
 			nextTok = lex (&nextSt);
+			if (! nextSt.named)
+				vStringCopy (nextSt.name, st.name);
 		}
 		else
 			break;
@@ -2065,7 +2084,6 @@ static void findOcamlTags (void)
 
 	vStringDelete (st.name);
 	vStringDelete (nextSt.name);
-	vStringDelete (temp_cp);
 	vStringDelete (tempIdent);
 	vStringDelete (lastModule);
 	vStringDelete (lastClass);
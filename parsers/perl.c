@@ -272,9 +272,7 @@ static void findPerlTags (void)
 {
 	vString *name = vStringNew ();
 	vString *package = NULL;
-	bool skipPodDoc = false;
 	const unsigned char *line;
-	unsigned long podStart = 0UL;
 
 	/* Core modules AutoLoader and SelfLoader support delayed compilation
 	 * by allowing Perl code that follows __END__ and __DATA__ tokens,
@@ -296,29 +294,21 @@ static void findPerlTags (void)
 		perlKind kind = K_NONE;
 		tagEntryInfo e;
 
-		if (skipPodDoc)
+		if (line [0] == '=')
 		{
-			if (strncmp ((const char*) line, "=cut", (size_t) 4) == 0)
+			if (isPodWord ((const char*)line + 1))
 			{
-				skipPodDoc = false;
-				if (podStart != 0UL)
-				{
-					makePromise ("Pod",
-						     podStart, 0,
-						     getInputLineNumber(), 0,
-						     getSourceLineNumber());
-					podStart = 0UL;
-				}
+				unsigned long podStart = getSourceLineNumber ();
+
+				if (readLineWithPrefixFromInputFile ("=cut") == NULL)
+					break;
+				makePromise ("Pod",
+					     podStart, 0,
+					     getInputLineNumber(), 0,
+					     getSourceLineNumber());
 			}
 			continue;
 		}
-		else if (line [0] == '=')
-		{
-			skipPodDoc = isPodWord ((const char*)line + 1);
-			if (skipPodDoc)
-				podStart = getSourceLineNumber ();
-			continue;
-		}
 		else if (strcmp ((const char*) line, "__DATA__") == 0)
 		{
 			if (respect_token & RESPECT_DATA)
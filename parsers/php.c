@@ -246,6 +246,10 @@ static langType Lang_zephir;
 
 static bool InPhp = false; /* whether we are between <? ?> */
 
+/* Anything but what may start a PHP block; the HTML between the blocks
+ * is skipped over in spans of these. */
+static inputCharClass HtmlChars;
+
 /* current statement details */
 static struct {
 	accessType access;
@@ -750,6 +754,7 @@ static int findPhpStart (void)
 	int c;
 	do
 	{
+		skipInputCharsInClass (&HtmlChars);
 		if ((c = getcFromInputFile ()) == '<')
 		{
 			c = getcFromInputFile ();
@@ -1669,12 +1674,14 @@ static void initializePhpParser (const langType language)
 {
 	Lang_php = language;
 	initializePool ();
+	initInputCharClass (&HtmlChars, "<", true);
 }
 
 static void initializeZephirParser (const langType language)
 {
 	Lang_zephir = language;
 	initializePool ();
+	initInputCharClass (&HtmlChars, "<", true);
 }
 
 static void finalize (langType language CTAGS_ATTR_UNUSED, bool initialized)
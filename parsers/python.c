@@ -24,6 +24,7 @@
 #include "debug.h"
 #include "xtag.h"
 #include "objpool.h"
+#include "param.h"
 
 #define isIdentifierChar(c) \
 	(isalnum (c) || (c) == '_' || (c) >= 0x80)
@@ -183,6 +184,7 @@ typedef struct {
 
 struct pythonNestingLevelUserData {
 	int indentation;
+	bool skipBody;	/* of a function, when SkipFunctionBodies */
 };
 #define PY_NL(nl) ((struct pythonNestingLevelUserData *) nestingLevelGetUserData (nl))
 
@@ -192,6 +194,16 @@ static tokenInfo *NextToken = NULL;
 static NestingLevels *PythonNestingLevels = NULL;
 static objPool *TokenPool = NULL;
 
+static inputCharClass IdentifierChars;
+static inputCharClass CommentChars;
+static inputCharClass StringChars [2];	/* of '"' and '\'' strings */
+static inputCharClass BodyChars;		/* not looked at by skipFunctionBody () */
+
+/* --param-Python:nested, and whether the function bodies of the current
+   file are skipped because it is false and locals are not tagged. */
+static bool TagFunctionBodies = true;
+static bool SkipFunctionBodies;
+
 
 /* follows PEP-8, and always reports single-underscores as protected
  * See:
@@ -327,8 +339,7 @@ static int makeSimplePythonRefTag (const tokenInfo *const token,
                                    pythonKind const kind,
                                    int roleIndex, xtagType xtag)
 {
-	if (isXtagEnabled (XTAG_REFERENCE_TAGS) &&
-	    PythonKinds[kind].roles[roleIndex].enabled)
+	if (isInputTagWritable (kind, roleIndex))
 	{
 		tagEntryInfo e;
 
@@ -383,17 +394,24 @@ static void copyToken (tokenInfo *const dest, const tokenInfo *const src)
 	vStringCopy(dest->string, src->string);
 }
 
-/* Skip a single or double quoted string. */
+/* Skip a single or double quoted string. STRING may be NULL. */
 static void readString (vString *const string, const int delimiter)
 {
+	const inputCharClass *const plain = &StringChars [delimiter == '"'? 0: 1];
 	int escaped = 0;
 	int c;
 
-	while ((c = getcFromInputFile ()) != EOF)
+	for (;;)
 	{
+		if (! escaped)
+			readInputCharsInClass (plain, string);
+		if ((c = getcFromInputFile ()) == EOF)
+			break;
+
 		if (escaped)
 		{
-			vStringPut (string, c);
+			if (string)
+				vStringPut (string, c);
 			escaped--;
 		}
 		else if (c == '\\')
@@ -404,12 +422,12 @@ static void readString (vString *const string, const int delimiter)
 				ungetcToInputFile (c);
 			break;
 		}
-		else
+		else if (string)
 			vStringPut (string, c);
 	}
 }
 
-/* Skip a single or double triple quoted string. */
+/* Skip a single or double triple quoted string. STRING may be NULL. */
 static void readTripleString (vString *const string, const int delimiter)
 {
 	int c;
@@ -422,7 +440,7 @@ static void readTripleString (vString *const string, const int delimiter)
 			if (++n >= 3)
 				break;
 		}
-		else
+		else if (string)
 		{
 			for (; n > 0; n--)
 				vStringPut (string, delimiter);
@@ -430,6 +448,8 @@ static void readTripleString (vString *const string, const int delimiter)
 				vStringPut (string, c);
 			n = 0;
 		}
+		else
+			n = 0;
 
 		if (escaped)
 			escaped--;
@@ -440,14 +460,8 @@ static void readTripleString (vString *const string, const int delimiter)
 
 static void readIdentifier (vString *const string, const int firstChar)
 {
-	int c = firstChar;
-	do
-	{
-		vStringPut (string, (char) c);
-		c = getcFromInputFile ();
-	}
-	while (isIdentifierChar (c));
-	ungetcToInputFile (c);
+	vStringPut (string, (char) firstChar);
+	readInputCharsInClass (&IdentifierChars, string);
 }
 
 static void ungetToken (tokenInfo *const token)
@@ -457,6 +471,40 @@ static void ungetToken (tokenInfo *const token)
 	copyToken (NextToken, token);
 }
 
+/* Read the indentation of the next line that is neither blank nor only
+ * a comment, C being the end of line, as readTokenFull () does. */
+static int readIndent (int c)
+{
+	int indent = 0;
+	do
+	{
+		if (c == '#')
+		{
+			skipInputCharsInClass (&CommentChars);
+			c = getcFromInputFile ();
+		}
+		if (c == '\r')
+		{
+			int d = getcFromInputFile ();
+			if (d != '\n')
+				ungetcToInputFile (d);
+		}
+		indent = 0;
+		while ((c = getcFromInputFile ()) == ' ' || c == '\t' || c == '\f')
+		{
+			if (c == '\t')
+				indent += 8 - (indent % 8);
+			else if (c == '\f') /* yeah, it's weird */
+				indent = 0;
+			else
+				indent++;
+		}
+	} /* skip completely empty lines, so retry */
+	while (c == '\r' || c == '\n' || c == '#');
+	ungetcToInputFile (c);
+	return indent;
+}
+
 static void readTokenFull (tokenInfo *const token, bool inclWhitespaces)
 {
 	int c;
@@ -578,34 +626,7 @@ getNextChar:
 		case '\r': /* newlines for indent */
 		case '\n':
 		{
-			int indent = 0;
-			do
-			{
-				if (c == '#')
-				{
-					do
-						c = getcFromInputFile ();
-					while (c != EOF && c != '\r' && c != '\n');
-				}
-				if (c == '\r')
-				{
-					int d = getcFromInputFile ();
-					if (d != '\n')
-						ungetcToInputFile (d);
-				}
-				indent = 0;
-				while ((c = getcFromInputFile ()) == ' ' || c == '\t' || c == '\f')
-				{
-					if (c == '\t')
-						indent += 8 - (indent % 8);
-					else if (c == '\f') /* yeah, it's weird */
-						indent = 0;
-					else
-						indent++;
-				}
-			} /* skip completely empty lines, so retry */
-			while (c == '\r' || c == '\n' || c == '#');
-			ungetcToInputFile (c);
+			int indent = readIndent (c);
 			if (TokenContinuationDepth > 0)
 			{
 				if (inclWhitespaces)
@@ -916,6 +937,7 @@ static bool parseClassOrDef (tokenInfo *const token,
 
 	lv = nestingLevelsPush (PythonNestingLevels, corkIndex);
 	PY_NL (lv)->indentation = token->indent;
+	PY_NL (lv)->skipBody = (SkipFunctionBodies && kind != K_CLASS);
 
 	deleteToken (name);
 	vStringDelete (arglist);
@@ -1219,6 +1241,84 @@ static bool parseVariable (tokenInfo *const token, const pythonKind kind)
 	return false;
 }
 
+/* Skip the body of a function without making tokens, from the start of
+ * its first line to the end of its last line. TOKEN is then the INDENT
+ * token readToken () would return for the next line not indented more
+ * than INDENTATION, or EOF.  Only the brackets, strings, comments and
+ * line continuations are looked at, to find the ends of logical lines. */
+static void skipFunctionBody (tokenInfo *const token, const int indentation)
+{
+	unsigned int depth = 0;
+
+	vStringClear (token->string);
+	token->keyword = KEYWORD_NONE;
+
+	for (;;)
+	{
+		int c, d;
+
+		skipInputCharsInClass (&BodyChars);
+		switch (c = getcFromInputFile ())
+		{
+			case EOF:
+				token->type = TOKEN_EOF;
+				return;
+
+			case '\'':
+			case '"':
+				if ((d = getcFromInputFile ()) != c)
+				{
+					ungetcToInputFile (d);
+					readString (NULL, c);
+				}
+				else if ((d = getcFromInputFile ()) == c)
+					readTripleString (NULL, c);
+				else /* empty string */
+					ungetcToInputFile (d);
+				break;
+
+			case '#':
+				skipInputCharsInClass (&CommentChars);
+				break;
+
+			case '\\':
+				d = getcFromInputFile ();
+				if (d == '\r')
+					d = getcFromInputFile ();
+				if (d != '\n')
+					ungetcToInputFile (d);
+				break;
+
+			case '(': case '[': case '{':
+				depth++;
+				break;
+
+			case ')': case ']': case '}':
+				if (depth > 0)
+					depth--;
+				break;
+
+			case '\r':
+			case '\n':
+				if (depth == 0)
+				{
+					const unsigned long lineNumber = getInputLineNumber ();
+					const int indent = readIndent (c);
+
+					if (indent <= indentation)
+					{
+						token->type = TOKEN_INDENT;
+						token->indent = indent;
+						token->lineNumber = lineNumber;
+						token->filePosition = getInputFilePositionForLine (lineNumber);
+						return;
+					}
+				}
+				break;
+		}
+	}
+}
+
 /* pops any level >= to indent */
 static void setIndent (tokenInfo *const token)
 {
@@ -1246,7 +1346,9 @@ static void findPythonTags (void)
 
 	TokenContinuationDepth = 0;
 	NextToken = NULL;
-	PythonNestingLevels = nestingLevelsNew (sizeof (struct pythonNestingLevelUserData));
+	SkipFunctionBodies = (isInputFileShallow () ||
+	                      (! TagFunctionBodies &&
+	                       ! PythonKinds[K_LOCAL_VARIABLE].enabled));
 
 	readToken (token);
 	while (token->type != TOKEN_EOF)
@@ -1259,7 +1361,19 @@ static void findPythonTags (void)
 			readToken (token);
 
 		if (token->type == TOKEN_INDENT)
+		{
+			NestingLevel *lv;
+
 			setIndent (token);
+			lv = nestingLevelsGetCurrent (PythonNestingLevels);
+			if (lv && PY_NL (lv)->skipBody &&
+			    token->indent > PY_NL (lv)->indentation)
+			{
+				skipFunctionBody (token, PY_NL (lv)->indentation);
+				if (token->type == TOKEN_INDENT)
+					setIndent (token);
+			}
+		}
 		else if (token->keyword == KEYWORD_class ||
 		         token->keyword == KEYWORD_def)
 		{
@@ -1325,7 +1439,6 @@ static void findPythonTags (void)
 			readToken (token);
 	}
 
-	nestingLevelsFree (PythonNestingLevels);
 	vStringDelete (decorators);
 	deleteToken (token);
 	Assert (NextToken == NULL);
@@ -1333,8 +1446,18 @@ static void findPythonTags (void)
 
 static void initialize (const langType language)
 {
+	unsigned int c;
+
 	Lang_python = language;
 
+	initInputCharClass (&IdentifierChars, "", false);
+	for (c = 1; c < ARRAY_SIZE (IdentifierChars.members); c++)
+		IdentifierChars.members [c] = isIdentifierChar (c);
+	initInputCharClass (&CommentChars, "\r\n", true);
+	initInputCharClass (&StringChars [0], "\"\\\r\n", true);
+	initInputCharClass (&StringChars [1], "'\\\r\n", true);
+	initInputCharClass (&BodyChars, "'\"#\\()[]{}\r\n", true);
+
 	TokenPool = objPoolNew (16, newPoolToken, deletePoolToken, clearPoolToken, NULL);
 }
 
@@ -1344,8 +1467,31 @@ static void finalize (langType language CTAGS_ATTR_UNUSED, bool initialized)
 		return;
 
 	objPoolDelete (TokenPool);
+	if (PythonNestingLevels)
+		nestingLevelsFree (PythonNestingLevels);
+}
+
+static void reset (langType language CTAGS_ATTR_UNUSED)
+{
+	if (PythonNestingLevels)
+		nestingLevelsClear (PythonNestingLevels);
+	else
+		PythonNestingLevels = nestingLevelsNew (sizeof (struct pythonNestingLevelUserData));
 }
 
+static void setTagFunctionBodies (const langType language CTAGS_ATTR_UNUSED,
+                                  const char *name, const char *arg)
+{
+	TagFunctionBodies = paramParserBool (arg, TagFunctionBodies, name, "parameter");
+}
+
+static parameterHandlerTable PythonParameterHandlerTable [] = {
+	{ .name = "nested",
+	  .desc = "tag the definitions and imports in function bodies ([true] or false)",
+	  .handleParameter = setTagFunctionBodies,
+	},
+};
+
 extern parserDefinition* PythonParser (void)
 {
 	static const char *const extensions[] = { "py", "pyx", "pxd", "pxi", "scons", NULL };
@@ -1358,10 +1504,13 @@ extern parserDefinition* PythonParser (void)
 	def->parser = findPythonTags;
 	def->initialize = initialize;
 	def->finalize = finalize;
+	def->reset = reset;
 	def->keywordTable = PythonKeywordTable;
 	def->keywordCount = ARRAY_SIZE (PythonKeywordTable);
 	def->fieldTable = PythonFields;
 	def->fieldCount = ARRAY_SIZE (PythonFields);
+	def->parameterHandlerTable = PythonParameterHandlerTable;
+	def->parameterHandlerCount = ARRAY_SIZE (PythonParameterHandlerTable);
 	def->useCork = true;
 	def->requestAutomaticFQTag = true;
 	return def;
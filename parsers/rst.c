@@ -218,32 +218,36 @@ static void findRstTags (void)
 
 	memset(&filepos, 0, sizeof(filepos));
 	memset(kindchars, 0, sizeof kindchars);
-	nestingLevels = nestingLevelsNew(0);
 
 	while ((line = readLineFromInputFile ()) != NULL)
 	{
-		int line_len = strlen((const char*) line);
-		int name_len_bytes = vStringLength(name);
-		/* FIXME: this isn't right, actually we need the real display width,
-		 * taking into account double-width characters and stuff like that.
-		 * But duh. */
-		int name_len = utf8_strlen(vStringValue(name), name_len_bytes);
-
-		/* if the name doesn't look like UTF-8, assume one-byte charset */
-		if (name_len < 0)
-			name_len = name_len_bytes;
-
-		/* underlines must be the same length or more */
-		if (line_len >= name_len && name_len > 0 &&
-			ispunct(line[0]) && issame((const char*) line))
+		/* Only a line following a candidate title and starting with a
+		 * punctuation character can be an underline: the lengths are
+		 * computed for those only. */
+		if (vStringLength(name) > 0 && ispunct(line[0]))
 		{
-			char c = line[0];
-			int kind = get_kind(c);
-
-			if (kind >= 0)
+			int line_len = strlen((const char*) line);
+			int name_len_bytes = vStringLength(name);
+			/* FIXME: this isn't right, actually we need the real display width,
+			 * taking into account double-width characters and stuff like that.
+			 * But duh. */
+			int name_len = utf8_strlen(vStringValue(name), name_len_bytes);
+
+			/* if the name doesn't look like UTF-8, assume one-byte charset */
+			if (name_len < 0)
+				name_len = name_len_bytes;
+
+			/* underlines must be the same length or more */
+			if (line_len >= name_len && issame((const char*) line))
 			{
-				makeRstTag(name, kind, filepos, c);
-				continue;
+				char c = line[0];
+				int kind = get_kind(c);
+
+				if (kind >= 0)
+				{
+					makeRstTag(name, kind, filepos, c);
+					continue;
+				}
 			}
 		}
 		vStringClear (name);
@@ -256,7 +260,23 @@ static void findRstTags (void)
 	/* Force popping all nesting levels */
 	getNestingLevel (K_EOF);
 	vStringDelete (name);
-	nestingLevelsFree(nestingLevels);
+}
+
+static void resetRst (langType language CTAGS_ATTR_UNUSED)
+{
+	if (nestingLevels)
+		nestingLevelsClear(nestingLevels);
+	else
+		nestingLevels = nestingLevelsNew(0);
+}
+
+static void finalizeRst (langType language CTAGS_ATTR_UNUSED, bool initialized CTAGS_ATTR_UNUSED)
+{
+	if (nestingLevels)
+	{
+		nestingLevelsFree(nestingLevels);
+		nestingLevels = NULL;
+	}
 }
 
 extern parserDefinition* RstParser (void)
@@ -268,6 +288,8 @@ extern parserDefinition* RstParser (void)
 	def->kindCount = ARRAY_SIZE (RstKinds);
 	def->extensions = extensions;
 	def->parser = findRstTags;
+	def->reset = resetRst;
+	def->finalize = finalizeRst;
 
 	def->fieldTable = RstFields;
 	def->fieldCount = ARRAY_SIZE (RstFields);
@@ -19,6 +19,7 @@
 
 #include "debug.h"
 #include "entry.h"
+#include "keyword.h"
 #include "parse.h"
 #include "nestlevel.h"
 #include "read.h"
@@ -37,6 +38,24 @@ typedef enum {
 	K_UNDEFINED = -1, K_CLASS, K_METHOD, K_MODULE, K_SINGLETON,
 } rubyKind;
 
+/* The keywords the lines are scanned for */
+enum {
+	KEYWORD_begin, KEYWORD_case, KEYWORD_class, KEYWORD_def, KEYWORD_do,
+	KEYWORD_end, KEYWORD_for, KEYWORD_if, KEYWORD_module, KEYWORD_unless,
+	KEYWORD_until, KEYWORD_while,
+};
+
+/* The longest of them */
+#define MAX_KEYWORD_LENGTH 6
+
+/* A here document, whose body follows the line it is started in */
+typedef struct {
+	char id [32];				/* the line ending it */
+	bool indented;				/* <<~ID and <<-ID: ID may be indented */
+} hereDocument;
+
+#define MAX_HERE_DOCUMENTS 8
+
 /*
 *   DATA DEFINITIONS
 */
@@ -52,6 +71,23 @@ static kindDefinition RubyKinds [] = {
 #endif
 };
 
+static const keywordTable RubyKeywordTable [] = {
+	{ "begin",  KEYWORD_begin  },
+	{ "case",   KEYWORD_case   },
+	{ "class",  KEYWORD_class  },
+	{ "def",    KEYWORD_def    },
+	{ "do",     KEYWORD_do     },
+	{ "end",    KEYWORD_end    },
+	{ "for",    KEYWORD_for    },
+	{ "if",     KEYWORD_if     },
+	{ "module", KEYWORD_module },
+	{ "unless", KEYWORD_unless },
+	{ "until",  KEYWORD_until  },
+	{ "while",  KEYWORD_while  },
+};
+
+static langType Lang_ruby;
+
 static NestingLevels* nesting = NULL;
 
 #define SCOPE_SEPARATOR '.'
@@ -97,17 +133,15 @@ static vString* nestingLevelsToScope (const NestingLevels* nls)
 static bool canMatch (const unsigned char** s, const char* literal,
                          bool (*end_check) (int))
 {
-	const int literal_length = strlen (literal);
-	const int s_length = strlen ((const char *)*s);
+	const size_t literal_length = strlen (literal);
 
-	if (s_length < literal_length)
-		return false;
-
-	const unsigned char next_char = *(*s + literal_length);
+	/* strncmp () stops at the end of a shorter 's'. */
 	if (strncmp ((const char*) *s, literal, literal_length) != 0)
 	{
 	    return false;
 	}
+
+	const unsigned char next_char = *(*s + literal_length);
 	/* Additionally check that we're at the end of a token. */
 	if (! end_check (next_char))
 	{
@@ -117,11 +151,6 @@ static bool canMatch (const unsigned char** s, const char* literal,
 	return true;
 }
 
-static bool notIdentChar (int c)
-{
-	return ! isIdentChar (c);
-}
-
 static bool notOperatorChar (int c)
 {
 	return ! (c == '[' || c == ']' ||
@@ -137,9 +166,29 @@ static bool isWhitespace (int c)
 	return c == 0 || isspace (c);
 }
 
-static bool canMatchKeyword (const unsigned char** s, const char* literal)
+/*
+* Looks up the identifier at 's' in the keyword table, instead of trying
+* the keywords one after another. Returns the keyword and sets 'length'
+* to that of the identifier, or returns KEYWORD_NONE.
+*/
+static int lookupIdentifierKeyword (const unsigned char* s, size_t* length)
 {
-	return canMatch (s, literal, notIdentChar);
+	char word [MAX_KEYWORD_LENGTH + 1];
+	size_t n = 0;
+
+	while (isIdentChar (s [n]))
+	{
+		if (n == MAX_KEYWORD_LENGTH)
+			return KEYWORD_NONE;
+		word [n] = (char) s [n];
+		n++;
+	}
+	if (n == 0)
+		return KEYWORD_NONE;
+
+	word [n] = '\0';
+	*length = n;
+	return lookupKeyword (word, Lang_ruby);
 }
 
 /*
@@ -385,12 +434,76 @@ static void enterUnnamedScope (void)
 	nestingLevelsPush (nesting, r);
 }
 
+/* Whether LINE, of LENGTH bytes which may count its line break, ends an
+   "=begin" block comment. */
+static bool isBlockCommentEnd (const unsigned char *line, size_t length,
+							   void *data CTAGS_ATTR_UNUSED)
+{
+	return length >= 4 && memcmp (line, "=end", 4) == 0
+		&& (length == 4 || isspace (line [4]));
+}
+
+/* Whether LINE ends the here document DATA. */
+static bool isHereDocumentEnd (const unsigned char *line, size_t length, void *data)
+{
+	const hereDocument *const doc = data;
+	const size_t idLength = strlen (doc->id);
+
+	while (length > 0 && (line [length - 1] == '\n' || line [length - 1] == '\r'))
+		length--;
+	if (doc->indented)
+		while (length > 0 && (*line == ' ' || *line == '\t'))
+		{
+			line++;
+			length--;
+		}
+	return length == idLength && memcmp (line, doc->id, idLength) == 0;
+}
+
+/*
+* Reads the here document started at 'cp', "<<ID", "<<~ID", "<<-ID", or
+* with ID quoted, into 'doc' and advances 'cp' past it. Returns false,
+* leaving 'cp' where it was, if it is not one: "<<" followed by an
+* identifier starting with a lower case letter is taken as an operator.
+*/
+static bool parseHereDocument (const unsigned char** cp, hereDocument* doc)
+{
+	const unsigned char *p = *cp + 2;
+	unsigned char quote = 0;
+	size_t n = 0;
+
+	doc->indented = (*p == '~' || *p == '-');
+	if (doc->indented)
+		p++;
+	if (*p == '"' || *p == '\'' || *p == '`')
+		quote = *p++;
+	else if (! doc->indented && ! (isupper (*p) || *p == '_'))
+		return false;
+
+	if (! (isalpha (*p) || *p == '_'))
+		return false;
+	while (isIdentChar (*p))
+	{
+		if (n + 1 == sizeof (doc->id))
+			return false;
+		doc->id [n++] = (char) *p++;
+	}
+	doc->id [n] = '\0';
+
+	if (quote)
+	{
+		if (*p != quote)
+			return false;
+		p++;
+	}
+	*cp = p;
+	return true;
+}
+
 static void findRubyTags (void)
 {
 	const unsigned char *line;
-	bool inMultiLineComment = false;
-
-	nesting = nestingLevelsNew (0);
+	hereDocument docs [MAX_HERE_DOCUMENTS];
 
 	/* FIXME: this whole scheme is wrong, because Ruby isn't line-based.
 	* You could perfectly well write:
@@ -408,18 +521,19 @@ static void findRubyTags (void)
 		/* if we expect a separator after a while, for, or until statement
 		 * separators are "do", ";" or newline */
 		bool expect_separator = false;
+		unsigned int docCount = 0;
+		unsigned int i;
+		size_t length;
+		int keyword;
 
 		if (canMatch (&cp, "=begin", isWhitespace))
 		{
-			inMultiLineComment = true;
+			/* The comment is skipped to its end without copying its
+			   lines. */
+			readWantedLineFromInputFile (isBlockCommentEnd, NULL);
 			continue;
 		}
 		if (canMatch (&cp, "=end", isWhitespace))
-		{
-			inMultiLineComment = false;
-			continue;
-		}
-		if (inMultiLineComment)
 			continue;
 
 		skipWhitespace (&cp);
@@ -441,17 +555,20 @@ static void findRubyTags (void)
 		*   puts("hello") \
 		*       unless <exp>
 		*/
-		if (canMatchKeyword (&cp, "for") ||
-		    canMatchKeyword (&cp, "until") ||
-		    canMatchKeyword (&cp, "while"))
+		keyword = lookupIdentifierKeyword (cp, &length);
+		if (keyword == KEYWORD_for ||
+		    keyword == KEYWORD_until ||
+		    keyword == KEYWORD_while)
 		{
+			cp += length;
 			expect_separator = true;
 			enterUnnamedScope ();
 		}
-		else if (canMatchKeyword (&cp, "case") ||
-		         canMatchKeyword (&cp, "if") ||
-		         canMatchKeyword (&cp, "unless"))
+		else if (keyword == KEYWORD_case ||
+		         keyword == KEYWORD_if ||
+		         keyword == KEYWORD_unless)
 		{
+			cp += length;
 			enterUnnamedScope ();
 		}
 
@@ -459,16 +576,21 @@ static void findRubyTags (void)
 		* "module M", "class C" and "def m" should only be at the beginning
 		* of a line.
 		*/
-		if (canMatchKeyword (&cp, "module"))
+		keyword = lookupIdentifierKeyword (cp, &length);
+		if (keyword == KEYWORD_module)
 		{
+			cp += length;
 			readAndEmitTag (&cp, K_MODULE);
 		}
-		else if (canMatchKeyword (&cp, "class"))
+		else if (keyword == KEYWORD_class)
 		{
+			cp += length;
 			readAndEmitTag (&cp, K_CLASS);
 		}
-		else if (canMatchKeyword (&cp, "def"))
+		else if (keyword == KEYWORD_def)
 		{
+			cp += length;
+
 			rubyKind kind = K_METHOD;
 			NestingLevel *nl = nestingLevelsGetCurrent (nesting);
 			tagEntryInfo *e  = getEntryOfNestingLevel (nl);
@@ -490,13 +612,14 @@ static void findRubyTags (void)
 		}
 		while (*cp != '\0')
 		{
-			/* FIXME: we don't cope with here documents,
-			* or regular expression literals, or ... you get the idea.
+			/* FIXME: we don't cope with regular expression literals,
+			* or ... you get the idea.
 			* Hopefully, the restriction above that insists on seeing
 			* definitions at the starts of lines should keep us out of
 			* mischief.
 			*/
-			if (inMultiLineComment || isspace (*cp))
+			keyword = isIdentChar (*cp)? lookupIdentifierKeyword (cp, &length): KEYWORD_NONE;
+			if (isspace (*cp))
 			{
 				++cp;
 			}
@@ -508,22 +631,31 @@ static void findRubyTags (void)
 				*/
 				break;
 			}
-			else if (canMatchKeyword (&cp, "begin"))
+			else if (keyword == KEYWORD_begin)
 			{
+				cp += length;
 				enterUnnamedScope ();
 			}
-			else if (canMatchKeyword (&cp, "do"))
+			else if (keyword == KEYWORD_do)
 			{
+				cp += length;
 				if (! expect_separator)
 					enterUnnamedScope ();
 				else
 					expect_separator = false;
 			}
-			else if (canMatchKeyword (&cp, "end") && nesting->n > 0)
+			else if (keyword == KEYWORD_end && nesting->n > 0)
 			{
+				cp += length;
 				/* Leave the most recent scope. */
 				nestingLevelsPop (nesting);
 			}
+			else if (*cp == '<' && cp [1] == '<' && docCount < MAX_HERE_DOCUMENTS
+					 && parseHereDocument (&cp, docs + docCount))
+			{
+				/* The body follows this line. */
+				docCount++;
+			}
 			else if (*cp == '"')
 			{
 				/* Skip string literals.
@@ -547,8 +679,34 @@ static void findRubyTags (void)
 				while (isIdentChar (*cp));
 			}
 		}
+
+		/* The bodies of the here documents are skipped to their ends
+		   without copying their lines. */
+		for (i = 0; i < docCount; i++)
+			readWantedLineFromInputFile (isHereDocumentEnd, docs + i);
+	}
+}
+
+static void initializeRuby (const langType language)
+{
+	Lang_ruby = language;
+}
+
+static void resetRuby (langType language CTAGS_ATTR_UNUSED)
+{
+	if (nesting)
+		nestingLevelsClear (nesting);
+	else
+		nesting = nestingLevelsNew (0);
+}
+
+static void finalizeRuby (langType language CTAGS_ATTR_UNUSED, bool initialized CTAGS_ATTR_UNUSED)
+{
+	if (nesting)
+	{
+		nestingLevelsFree (nesting);
+		nesting = NULL;
 	}
-	nestingLevelsFree (nesting);
 }
 
 extern parserDefinition* RubyParser (void)
@@ -559,6 +717,11 @@ extern parserDefinition* RubyParser (void)
 	def->kindCount  = ARRAY_SIZE (RubyKinds);
 	def->extensions = extensions;
 	def->parser     = findRubyTags;
+	def->initialize = initializeRuby;
+	def->keywordTable = RubyKeywordTable;
+	def->keywordCount = ARRAY_SIZE (RubyKeywordTable);
+	def->reset      = resetRuby;
+	def->finalize   = finalizeRuby;
 	def->useCork    = true;
 	return def;
 }
@@ -84,6 +84,11 @@ typedef struct {
 	MIOPos pos;
 } lexerState;
 
+static inputCharClass IdentifierChars;	/* isIdentifierContinue () ones */
+static inputCharClass WhitespaceChars;
+static inputCharClass CommentChars;		/* all but '\n' */
+static inputCharClass StringChars;		/* all but '"' and '\\' */
+
 /*
 *   FUNCTION PROTOTYPES
 */
@@ -160,6 +165,44 @@ static void advanceAndStoreChar (lexerState *lexer)
 	advanceChar(lexer);
 }
 
+static bool isCharInClass (const inputCharClass *klass, int c)
+{
+	return c > 0 && c < (int) ARRAY_SIZE (klass->members) && klass->members[c];
+}
+
+/* Advance while the current character is in KLASS, appending the
+ * characters to OUT_STR unless it is NULL. Those after the two already
+ * read are consumed in a run instead of one by one. */
+static void advanceCharsInClass (lexerState *lexer, const inputCharClass *klass,
+								 vString *out_str)
+{
+	if (!isCharInClass(klass, lexer->cur_c))
+		return;
+	if (out_str)
+		vStringPut(out_str, (char) lexer->cur_c);
+	if (!isCharInClass(klass, lexer->next_c))
+	{
+		advanceChar(lexer);
+		return;
+	}
+	if (out_str)
+		vStringPut(out_str, (char) lexer->next_c);
+	readInputCharsInClass(klass, out_str);
+	lexer->next_c = getcFromInputFile();
+	advanceChar(lexer);
+}
+
+/* Like advanceCharsInClass (), but keeping lexerState::token_str within
+ * MAX_STRING_LENGTH as advanceAndStoreChar () does */
+static void advanceAndStoreCharsInClass (lexerState *lexer, const inputCharClass *klass)
+{
+	bool full = vStringLength(lexer->token_str) >= MAX_STRING_LENGTH;
+
+	advanceCharsInClass(lexer, klass, full? NULL: lexer->token_str);
+	if (vStringLength(lexer->token_str) > MAX_STRING_LENGTH)
+		vStringTruncate(lexer->token_str, MAX_STRING_LENGTH);
+}
+
 static bool isWhitespace (int c)
 {
 	return c == ' ' || c == '\t' || c == '\r' || c == '\n';
@@ -184,8 +227,7 @@ static bool isIdentifierContinue (int c)
 
 static void scanWhitespace (lexerState *lexer)
 {
-	while (isWhitespace(lexer->cur_c))
-		advanceChar(lexer);
+	advanceCharsInClass(lexer, &WhitespaceChars, NULL);
 }
 
 /* Normal line comments start with two /'s and continue until the next \n
@@ -199,8 +241,7 @@ static void scanComments (lexerState *lexer)
 	if (lexer->next_c == '/')
 	{
 		advanceNChar(lexer, 2);
-		while (lexer->cur_c != EOF && lexer->cur_c != '\n')
-			advanceChar(lexer);
+		advanceCharsInClass(lexer, &CommentChars, NULL);
 	}
 	/* #! */
 	else if (lexer->next_c == '!')
@@ -209,8 +250,7 @@ static void scanComments (lexerState *lexer)
 		/* If it is exactly #![ then it is not a comment, but an attribute */
 		if (lexer->cur_c == '[')
 			return;
-		while (lexer->cur_c != EOF && lexer->cur_c != '\n')
-			advanceChar(lexer);
+		advanceCharsInClass(lexer, &CommentChars, NULL);
 	}
 	/* block comment */
 	else if (lexer->next_c == '*')
@@ -240,10 +280,7 @@ static void scanComments (lexerState *lexer)
 static void scanIdentifier (lexerState *lexer)
 {
 	vStringClear(lexer->token_str);
-	do
-	{
-		advanceAndStoreChar(lexer);
-	} while(lexer->cur_c != EOF && isIdentifierContinue(lexer->cur_c));
+	advanceAndStoreCharsInClass(lexer, &IdentifierChars);
 }
 
 /* Double-quoted strings, we only care about the \" escape. These
@@ -257,9 +294,14 @@ static void scanString (lexerState *lexer)
 	advanceAndStoreChar(lexer);
 	while (lexer->cur_c != EOF && lexer->cur_c != '"')
 	{
-		if (lexer->cur_c == '\\' && lexer->next_c == '"')
+		if (lexer->cur_c == '\\')
+		{
+			if (lexer->next_c == '"')
+				advanceAndStoreChar(lexer);
 			advanceAndStoreChar(lexer);
-		advanceAndStoreChar(lexer);
+		}
+		else
+			advanceAndStoreCharsInClass(lexer, &StringChars);
 	}
 	advanceAndStoreChar(lexer);
 }
@@ -339,6 +381,19 @@ static void scanCharacterOrLifetime (lexerState *lexer)
 	/* Otherwise it is malformed, or a lifetime */
 }
 
+/* Take the position of the token to be read. The position of a line is
+ * only looked up when the line changes. */
+static void updateTokenPosition (lexerState *lexer)
+{
+	unsigned long line = getInputLineNumber();
+
+	if (line != lexer->line)
+	{
+		lexer->line = line;
+		lexer->pos = getInputFilePosition();
+	}
+}
+
 /* Advances the parser one token, optionally skipping whitespace
  * (otherwise it is concatenated and returned as a single whitespace token).
  * Whitespace is needed to properly render function signatures. Unrecognized
@@ -346,8 +401,7 @@ static void scanCharacterOrLifetime (lexerState *lexer)
 static int advanceToken (lexerState *lexer, bool skip_whitspace)
 {
 	bool have_whitespace = false;
-	lexer->line = getInputLineNumber();
-	lexer->pos = getInputFilePosition();
+	updateTokenPosition(lexer);
 	while (lexer->cur_c != EOF)
 	{
 		if (isWhitespace(lexer->cur_c))
@@ -367,8 +421,7 @@ static int advanceToken (lexerState *lexer, bool skip_whitspace)
 			break;
 		}
 	}
-	lexer->line = getInputLineNumber();
-	lexer->pos = getInputFilePosition();
+	updateTokenPosition(lexer);
 	while (lexer->cur_c != EOF)
 	{
 		if (lexer->cur_c == '"')
@@ -420,6 +473,8 @@ static int advanceToken (lexerState *lexer, bool skip_whitspace)
 
 static void initLexer (lexerState *lexer)
 {
+	lexer->line = getInputLineNumber();
+	lexer->pos = getInputFilePosition();
 	advanceNChar(lexer, 2);
 	lexer->token_str = vStringNew();
 
@@ -957,6 +1012,18 @@ static void parseBlock (lexerState *lexer, bool delim, int kind, vString *scope)
 	}
 }
 
+static void initialize (const langType language CTAGS_ATTR_UNUSED)
+{
+	unsigned int c;
+
+	initInputCharClass(&IdentifierChars, "", false);
+	for (c = 1; c < ARRAY_SIZE(IdentifierChars.members); c++)
+		IdentifierChars.members[c] = isIdentifierContinue(c);
+	initInputCharClass(&WhitespaceChars, " \t\r\n", false);
+	initInputCharClass(&CommentChars, "\n", true);
+	initInputCharClass(&StringChars, "\"\\", true);
+}
+
 static void findRustTags (void)
 {
 	lexerState lexer;
@@ -977,6 +1044,7 @@ extern parserDefinition *RustParser (void)
 	def->kindCount = ARRAY_SIZE (rustKinds);
 	def->extensions = extensions;
 	def->parser = findRustTags;
+	def->initialize = initialize;
 
 	return def;
 }
@@ -18,6 +18,7 @@
 #include "parse.h"
 #include "read.h"
 #include "routines.h"
+#include "sexp.h"
 #include "vstring.h"
 
 /*
@@ -43,69 +44,34 @@ static kindDefinition SchemeKinds [] = {
  * look for (def ... ((... (xyzzy ....
  * look for (set! xyzzy
  */
-static void readIdentifier (vString *const name, const unsigned char *cp)
-{
-	const unsigned char *p;
-	vStringClear (name);
-	/* Go till you get to white space or a syntactic break */
-	for (p = cp; *p != '\0' && *p != '(' && *p != ')' && !isspace (*p); p++)
-		vStringPut (name, (int) *p);
-}
-
 static void findSchemeTags (void)
 {
+	vString *head = vStringNew ();
 	vString *name = vStringNew ();
-	const unsigned char *line;
+	sexpSkimmer skimmer;
 
-	while ((line = readLineFromInputFile ()) != NULL)
+	initSexpSkimmer (&skimmer, SEXP_BLOCK_COMMENT);
+	while (skimToTopLevelForm (&skimmer))
 	{
-		const unsigned char *cp = line;
-
-		if (cp [0] == '(' &&
-			(cp [1] == 'D' || cp [1] == 'd') &&
-			(cp [2] == 'E' || cp [2] == 'e') &&
-			(cp [3] == 'F' || cp [3] == 'f'))
+		readSexpSymbol (&skimmer, head);
+		if (strncasecmp (vStringValue (head), "def", 3) == 0)
 		{
-			while (*cp != '\0'  &&  !isspace (*cp))
-				cp++;
 			/* Skip over open parens and white space */
-			do {
-				while (*cp != '\0' && (isspace (*cp) || *cp == '('))
-					cp++;
-				if (*cp == '\0')
-					cp = line = readLineFromInputFile ();
-				else
-					break;
-			} while (line);
-			if (line == NULL)
-				break;
-			readIdentifier (name, cp);
+			while (skipSexpBlanks (&skimmer, true) == '(')
+				skipSexpChar (&skimmer, '(');
+			readSexpSymbol (&skimmer, name);
 			makeSimpleTag (name, K_FUNCTION);
 		}
-		if (cp [0] == '(' &&
-			(cp [1] == 'S' || cp [1] == 's') &&
-			(cp [2] == 'E' || cp [2] == 'e') &&
-			(cp [3] == 'T' || cp [3] == 't') &&
-			(cp [4] == '!') &&
-			(isspace (cp [5]) || cp[5] == '\0'))
+		else if (strcasecmp (vStringValue (head), "set!") == 0)
 		{
-			cp += 5;
 			/* Skip over white space */
-			do {
-				while (*cp != '\0' && isspace (*cp))
-					cp++;
-				if (*cp == '\0')
-					cp = line = readLineFromInputFile ();
-				else
-					break;
-			} while (line);
-			if (line == NULL)
-				break;
-			readIdentifier (name, cp);
+			skipSexpBlanks (&skimmer, true);
+			readSexpSymbol (&skimmer, name);
 			makeSimpleTag (name, K_SET);
 		}
 	}
 	vStringDelete (name);
+	vStringDelete (head);
 }
 
 extern parserDefinition* SchemeParser (void)
@@ -0,0 +1,259 @@
+/*
+*   Copyright (c) 2026, Universal Ctags Team
+*
+*   This source code is released for free distribution under the terms of the
+*   GNU General Public License version 2 or (at your option) any later version.
+*
+*   This module contains functions shared by the parsers of Lisp dialects
+*   for skimming S-expressions: the input is scanned for the top-level
+*   forms, skipping the runs of characters in between with a table.
+*/
+
+/*
+*   INCLUDE FILES
+*/
+#include "general.h"  /* must always come first */
+
+#include <string.h>
+
+#include "read.h"
+#include "sexp.h"
+
+/*
+*   DATA DEFINITIONS
+*/
+static bool CharClassesInitialized;
+static inputCharClass PlainChars;		/* all but the ones skimToTopLevelForm () looks at */
+static inputCharClass StringChars;		/* all but '"' and '\\' */
+static inputCharClass CommentChars;		/* all but '\n' */
+static inputCharClass BlockCommentChars;	/* all but '|' and '#' */
+static inputCharClass BlankChars;		/* " \t\r" */
+static inputCharClass SymbolChars;		/* all but the delimiters */
+static inputCharClass DataChars;		/* all but the brackets and what skipData () skips */
+
+/*
+*   FUNCTION DEFINITIONS
+*/
+
+extern void initSexpSkimmer (sexpSkimmer *skimmer, unsigned int syntax)
+{
+	skimmer->syntax = syntax;
+	skimmer->depth = 0;
+	skimmer->top = 0;
+
+	if (CharClassesInitialized)
+		return;
+	initInputCharClass (&PlainChars, "()\"';`#\\", true);
+	initInputCharClass (&StringChars, "\"\\", true);
+	initInputCharClass (&CommentChars, "\n", true);
+	initInputCharClass (&BlockCommentChars, "|#", true);
+	initInputCharClass (&BlankChars, " \t\r", false);
+	initInputCharClass (&SymbolChars, " \t\r\n\f\v()\";", true);
+	initInputCharClass (&DataChars, "()[]{}\";\\", true);
+	CharClassesInitialized = true;
+}
+
+static void skipString (void)
+{
+	int c;
+
+	do
+	{
+		skipInputCharsInClass (&StringChars);
+		c = getcFromInputFile ();
+		if (c == '\\' && getcFromInputFile () == EOF)
+			break;
+	} while (c != EOF && c != '"');
+}
+
+/* The "#|" is consumed. */
+static void skipBlockComment (void)
+{
+	int level = 1;
+
+	while (level > 0)
+	{
+		int c;
+
+		skipInputCharsInClass (&BlockCommentChars);
+		c = getcFromInputFile ();
+		if (c == EOF)
+			break;
+		else if (c == '|' || c == '#')
+		{
+			const int d = getcFromInputFile ();
+
+			if (c == '|' && d == '#')
+				level--;
+			else if (c == '#' && d == '|')
+				level++;
+			else
+				ungetcToInputFile (d);
+		}
+	}
+}
+
+static void closeParen (sexpSkimmer *skimmer)
+{
+	if (skimmer->depth > 0)
+		skimmer->depth--;
+	if (skimmer->top > skimmer->depth)
+		skimmer->top = skimmer->depth;
+}
+
+/* Skip a vector or a map, the OPEN bracket of which is consumed, up to
+ * its close bracket. All the brackets are counted alike. */
+static void skipData (int open)
+{
+	int level = 1;
+	int c = open;
+
+	while (level > 0 && c != EOF)
+	{
+		skipInputCharsInClass (&DataChars);
+		c = getcFromInputFile ();
+		switch (c)
+		{
+			case '(': case '[': case '{':
+				level++;
+				break;
+			case ')': case ']': case '}':
+				level--;
+				break;
+			case '"':
+				skipString ();
+				break;
+			case ';':
+				skipInputCharsInClass (&CommentChars);
+				break;
+			case '\\':
+				getcFromInputFile ();
+				break;
+		}
+	}
+}
+
+/* What a quote, a backquote or a '#' is a prefix of, like '(...), '[...]
+ * or #(...), is data, not a form. The chain of prefix characters, PREFIX
+ * being its consumed first one, is consumed, and so is the paren after
+ * it; a quoted vector or map is skipped whole. The forms of a reader
+ * conditional, #?(...) or #?@(...), are walked as top-level forms. */
+static void skipQuotedForm (sexpSkimmer *skimmer, int prefix)
+{
+	char chain [4];
+	size_t length = 0;
+	int c = prefix;
+
+	do
+	{
+		if (length < sizeof (chain) - 1)
+			chain [length++] = (char) c;
+		c = getcFromInputFile ();
+	}
+	while (c == '\'' || c == '`' || c == '#' || c == '_' || c == '?'
+		   || c == ',' || c == '@');
+	chain [length] = '\0';
+
+	if (c == '(')
+	{
+		skimmer->depth++;
+		if ((skimmer->syntax & SEXP_READER_CONDITIONAL)
+			&& (strcmp (chain, "#?") == 0 || strcmp (chain, "#?@") == 0))
+			skimmer->top = skimmer->depth;
+	}
+	else if (c == '[' || c == '{')
+		skipData (c);
+	else
+		ungetcToInputFile (c);
+}
+
+extern bool skimToTopLevelForm (sexpSkimmer *skimmer)
+{
+	for (;;)
+	{
+		int c;
+
+		skipInputCharsInClass (&PlainChars);
+		c = getcFromInputFile ();
+		switch (c)
+		{
+			case EOF:
+				return false;
+			case '(':
+				if (getInputLineOffset () == 1)
+				{
+					skimmer->depth = 1;
+					skimmer->top = 0;
+					return true;
+				}
+				if (skimmer->depth++ == skimmer->top)
+					return true;
+				break;
+			case ')':
+				closeParen (skimmer);
+				break;
+			case '"':
+				skipString ();
+				break;
+			case ';':
+				skipInputCharsInClass (&CommentChars);
+				break;
+			case '\\':
+				getcFromInputFile ();
+				break;
+			case '#':
+				if (skimmer->syntax & SEXP_BLOCK_COMMENT)
+				{
+					c = getcFromInputFile ();
+					if (c == '|')
+					{
+						skipBlockComment ();
+						break;
+					}
+					ungetcToInputFile (c);
+					c = '#';
+				}
+				/* Fall through */
+			case '\'':
+			case '`':
+				if (skimmer->depth == skimmer->top)
+					skipQuotedForm (skimmer, c);
+				break;
+		}
+	}
+}
+
+extern int skipSexpBlanks (sexpSkimmer *skimmer CTAGS_ATTR_UNUSED, bool acrossLines)
+{
+	int c;
+
+	do
+	{
+		skipInputCharsInClass (&BlankChars);
+		c = getcFromInputFile ();
+	} while (acrossLines && c == '\n');
+	ungetcToInputFile (c);
+	return c;
+}
+
+extern bool skipSexpChar (sexpSkimmer *skimmer, int c)
+{
+	const int d = getcFromInputFile ();
+
+	if (d != c || d == EOF)
+	{
+		ungetcToInputFile (d);
+		return false;
+	}
+	if (c == '(')
+		skimmer->depth++;
+	else if (c == ')')
+		closeParen (skimmer);
+	return true;
+}
+
+extern void readSexpSymbol (sexpSkimmer *skimmer CTAGS_ATTR_UNUSED, vString *const symbol)
+{
+	vStringClear (symbol);
+	readInputCharsInClass (&SymbolChars, symbol);
+}
@@ -0,0 +1,59 @@
+/*
+*   Copyright (c) 2026, Universal Ctags Team
+*
+*   This source code is released for free distribution under the terms of the
+*   GNU General Public License version 2 or (at your option) any later version.
+*
+*   This module contains functions shared by the parsers of Lisp dialects
+*   for skimming S-expressions.
+*/
+
+#ifndef CTAGS_PARSER_SEXP_H
+#define CTAGS_PARSER_SEXP_H
+
+/*
+*   INCLUDE FILES
+*/
+#include "general.h"  /* must always come first */
+#include "vstring.h"
+
+/*
+*   DATA DECLARATIONS
+*/
+enum eSexpSyntax {
+	SEXP_BLOCK_COMMENT = 1 << 0,	/* #| ... |#, nesting */
+	SEXP_READER_CONDITIONAL = 1 << 1,	/* #?(...) and #?@(...) of Clojure */
+};
+
+/* The skimmer only counts the parens: a form is well balanced in all
+ * the brackets, so the others do not change what is at the top level.
+ * Strings, comments and escaped characters are skipped over, and an
+ * open paren at the start of a line is taken to start a top-level form,
+ * whatever came before it. The forms of a reader conditional at the top
+ * level are at the top level too. */
+typedef struct sSexpSkimmer {
+	unsigned int syntax;		/* eSexpSyntax flags */
+	int depth;					/* of the parens the input is in */
+	int top;					/* depth of the top level, in reader conditionals */
+} sexpSkimmer;
+
+/*
+*   FUNCTION PROTOTYPES
+*/
+extern void initSexpSkimmer (sexpSkimmer *skimmer, unsigned int syntax);
+
+/* Skip to the next top-level form which is not quoted, and consume its
+   open paren. Return false at the end of the input. */
+extern bool skimToTopLevelForm (sexpSkimmer *skimmer);
+
+/* Skip blanks, and line breaks if ACROSS_LINES; return the character
+   after them, which is left to be read. */
+extern int skipSexpBlanks (sexpSkimmer *skimmer, bool acrossLines);
+
+/* Consume the next character if it is C, which may be a paren. */
+extern bool skipSexpChar (sexpSkimmer *skimmer, int c);
+
+/* Read into SYMBOL the characters before the next delimiter. */
+extern void readSexpSymbol (sexpSkimmer *skimmer, vString *const symbol);
+
+#endif  /* CTAGS_PARSER_SEXP_H */
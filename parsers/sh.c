@@ -377,13 +377,16 @@ static void findShTags (void)
 
 			check_char = isBashFunctionChar;
 
-			if (strncmp ((const char*) cp, "function", (size_t) 8) == 0  &&
+			/* The first byte rules out all the keywords but one at most. */
+			if (cp [0] == 'f'
+				&& strncmp ((const char*) cp, "function", (size_t) 8) == 0  &&
 				isspace ((int) cp [8]))
 			{
 				found_kind = K_FUNCTION;
 				cp += 8;
 			}
-			else if (strncmp ((const char*) cp, "alias", (size_t) 5) == 0  &&
+			else if (cp [0] == 'a'
+				&& strncmp ((const char*) cp, "alias", (size_t) 5) == 0  &&
 				isspace ((int) cp [5]))
 			{
 				check_char = isIdentChar;
@@ -397,7 +400,8 @@ static void findShTags (void)
 				++cp;
 				check_char = isFileChar;
 			}
-			else if (strncmp ((const char*) cp, "source", (size_t) 6) == 0
+			else if (cp [0] == 's'
+					 && strncmp ((const char*) cp, "source", (size_t) 6) == 0
 					 && isspace((int) cp [6]))
 			{
 				found_kind = K_SOURCE;
@@ -140,6 +140,8 @@ enum eKeywordId {
 	KEYWORD_go,
 	KEYWORD_with,
 	KEYWORD_without,
+	KEYWORD_insert,
+	KEYWORD_values,
 };
 typedef int keywordId; /* to allow KEYWORD_NONE */
 
@@ -186,6 +188,12 @@ typedef struct sTokenInfoSQL {
 
 static langType Lang_sql;
 
+/* For skipValueList (): the characters of a row not looked at, those of
+   the strings quoted with ', " and `, and the blanks between rows. */
+static inputCharClass RowChars;
+static inputCharClass QuotedChars [3];
+static inputCharClass BlankChars;
+
 typedef enum {
 	SQLTAG_CURSOR,
 	SQLTAG_PROTOTYPE,
@@ -316,6 +324,8 @@ static const keywordTable SqlKeywordTable [] = {
 	{ "go",								KEYWORD_go				      },
 	{ "with",							KEYWORD_with			      },
 	{ "without",						KEYWORD_without			      },
+	{ "insert",							KEYWORD_insert			      },
+	{ "values",							KEYWORD_values			      },
 };
 
 /*
@@ -2402,6 +2412,89 @@ static void parseComment (tokenInfo *const token)
 }
 
 
+static void skipQuoted (const int delimiter)
+{
+	const inputCharClass *const plain =
+		&QuotedChars [delimiter == '\''? 0: delimiter == '"'? 1: 2];
+	int c;
+
+	do
+	{
+		skipInputCharsInClass (plain);
+		c = getcFromInputFile ();
+		if (c == '\\')	/* as in the dumps of MySQL */
+			c = getcFromInputFile ();
+		else if (c == delimiter)
+			break;
+	} while (c != EOF);
+}
+
+/*
+ * Skip the rows of a VALUES clause, which make most of the bytes of a
+ * database dump and have no tags, without making tokens:
+ *	   insert into t values (1, 'a;b'), (2, 'it''s');
+ * Only the parentheses and quotes of a row are looked at. The skipping
+ * stops after the first row not followed by a comma, leaving the rest of
+ * the statement to readToken ().
+ */
+static void skipValueList (tokenInfo *const token)
+{
+	int c;
+
+	do
+	{
+		int nest_level = 1;
+
+		skipInputCharsInClass (&BlankChars);
+		if ((c = getcFromInputFile ()) != '(')
+			break;
+
+		while (nest_level > 0 && c != EOF)
+		{
+			skipInputCharsInClass (&RowChars);
+			switch (c = getcFromInputFile ())
+			{
+				case '(': nest_level++; break;
+				case ')': nest_level--; break;
+				case '\'':
+				case '"':
+				case '`': skipQuoted (c); break;
+			}
+		}
+
+		skipInputCharsInClass (&BlankChars);
+		c = getcFromInputFile ();
+	} while (c == ',');
+
+	ungetcToInputFile (c);
+	token->type    = TOKEN_UNDEFINED;
+	token->keyword = KEYWORD_NONE;
+	vStringClear (token->string);
+}
+
+static void parseInsert (tokenInfo *const token)
+{
+	/*
+	 * This deals with these formats, without tags
+	 *	   insert into t values (1, 'a'), (2, 'b');
+	 *	   insert into t (c1, c2) values (1, 'a');
+	 *	   insert into t select * from s;
+	 */
+	readToken (token);
+	while (! isKeyword (token, KEYWORD_values) &&
+		   ! isCmdTerm (token) &&
+		   ! isType (token, TOKEN_EOF))
+	{
+		if (isType (token, TOKEN_OPEN_PAREN))
+			skipToMatched (token);
+		else
+			readToken (token);
+	}
+
+	if (isKeyword (token, KEYWORD_values))
+		skipValueList (token);
+}
+
 static void parseKeywords (tokenInfo *const token)
 {
 		switch (token->keyword)
@@ -2417,6 +2510,7 @@ static void parseKeywords (tokenInfo *const token)
 			case KEYWORD_function:		parseSubProgram (token); break;
 			case KEYWORD_if:			parseStatements (token, false); break;
 			case KEYWORD_index:			parseIndex (token); break;
+			case KEYWORD_insert:		parseInsert (token); break;
 			case KEYWORD_ml_table:		parseMLTable (token); break;
 			case KEYWORD_ml_table_lang: parseMLTable (token); break;
 			case KEYWORD_ml_table_dnet: parseMLTable (token); break;
@@ -2465,6 +2559,12 @@ static void initialize (const langType language)
 {
 	Assert (ARRAY_SIZE (SqlKinds) == SQLTAG_COUNT);
 	Lang_sql = language;
+
+	initInputCharClass (&RowChars, "()'\"`", true);
+	initInputCharClass (&QuotedChars [0], "'\\", true);
+	initInputCharClass (&QuotedChars [1], "\"\\", true);
+	initInputCharClass (&QuotedChars [2], "`\\", true);
+	initInputCharClass (&BlankChars, " \t\r\n\f", false);
 }
 
 static void findSqlTags (void)
@@ -21,6 +21,7 @@
 #include "entry.h"
 #include "routines.h"
 #include "debug.h"
+#include "htable.h"
 #include "ptrarray.h"
 #include "tcl.h"
 
@@ -77,6 +78,11 @@ static void copyToken (tokenInfo *dest, tokenInfo *src, void *data CTAGS_ATTR_UN
 
 struct sTclParserState {
 	enum TclTokenType lastTokenType;
+
+	/* The subparsers to notify of a command, by the name of the
+	   command, and those to notify of the other commands */
+	hashTable *commandSubparsers;
+	ptrArray *anyCommandSubparsers;
 };
 
 #define TOKEN_PSTATE(TOKEN) \
@@ -127,6 +133,18 @@ static void copyToken (tokenInfo *dest, tokenInfo *src, void *data CTAGS_ATTR_UN
 		TOKENX (src, struct tokenExtra)->pstate;
 }
 
+/* The characters read in bulk, one span at a time */
+static inputCharClass StringChars;		/* all but '\\' and '"' */
+static inputCharClass IdentifierChars;	/* isgraph () ones but "{}[]" */
+static inputCharClass CommentChars;		/* all but '\r' and '\n' */
+
+/* STRING is NULL when the text of the token is not needed. */
+static void putcToString (vString *string, int c)
+{
+	if (string)
+		vStringPut (string, c);
+}
+
 static void readString (vString *string)
 {
 	int c;
@@ -134,17 +152,20 @@ static void readString (vString *string)
 
 	while (1)
 	{
+		if (readInputCharsInClass (&StringChars, string) > 0)
+			escaped = false;
+
 		c = getcFromInputFile ();
 		switch (c)
 		{
 		case EOF:
 			return;
 		case '\\':
-			vStringPut (string, c);
+			putcToString (string, c);
 			escaped = true;
 			break;
 		case '"':
-			vStringPut (string, c);
+			putcToString (string, c);
 			if (escaped)
 				escaped = false;
 			else
@@ -152,7 +173,7 @@ static void readString (vString *string)
 			break;
 		default:
 			escaped = false;
-			vStringPut (string, c);
+			putcToString (string, c);
 			break;
 		}
 	}
@@ -160,17 +181,7 @@ static void readString (vString *string)
 
 static void readIdentifier (vString *string)
 {
-	while (1)
-	{
-		int c = getcFromInputFile ();
-		if (isgraph (c) && (!strchr ("{}[]", c)))
-			vStringPut (string, c);
-		else
-		{
-			ungetcToInputFile (c);
-			break;
-		}
-	}
+	readInputCharsInClass (&IdentifierChars, string);
 }
 
 static keywordId resolveKeyword (vString *string)
@@ -193,6 +204,9 @@ static void readToken0 (tokenInfo *const token, struct sTclParserState *pstate)
 {
 	int c = EOF;
 	bool escaped;
+	/* Only the types of the tokens matter while skipping over a pair */
+	const bool skipping = token->klass->skipping;
+	vString *const string = skipping? NULL: token->string;
 	bool bol = (pstate->lastTokenType == TOKEN_TCL_EOL
 				|| pstate->lastTokenType == ';'
 				|| pstate->lastTokenType == TOKEN_TCL_UNDEFINED);
@@ -224,7 +238,8 @@ static void readToken0 (tokenInfo *const token, struct sTclParserState *pstate)
 	}
 
 	token->lineNumber   = getInputLineNumber ();
-	token->filePosition = getInputFilePosition ();
+	if (!skipping)
+		token->filePosition = getInputFilePosition ();
 
 	switch (c)
 	{
@@ -240,9 +255,8 @@ static void readToken0 (tokenInfo *const token, struct sTclParserState *pstate)
 		{
 			if (bol)
 			{
-				do
-					c = getcFromInputFile ();
-				while (c != EOF && c != '\r' && c != '\n');
+				skipInputCharsInClass (&CommentChars);
+				c = getcFromInputFile ();
 			}
 			goto getNextChar;
 		}
@@ -250,8 +264,8 @@ static void readToken0 (tokenInfo *const token, struct sTclParserState *pstate)
 		if (!escaped)
 		{
 			token->type = TOKEN_TCL_STRING;
-			vStringPut (token->string, c);
-			readString (token->string);
+			putcToString (string, c);
+			readString (string);
 			break;
 		}
 	case ';':
@@ -267,33 +281,34 @@ static void readToken0 (tokenInfo *const token, struct sTclParserState *pstate)
 	case '$':
 		if (!escaped)
 		{
-			vStringPut (token->string, c);
+			putcToString (string, c);
 			token->type = TOKEN_TCL_VARIABLE;
 
 			int c0 = getcFromInputFile ();
 			if (c0 == EOF)
 				break;
 
-			vStringPut (token->string, c0);
+			putcToString (string, c0);
 			if (c0 == '{')
 			{
 
 				while ((c0 = getcFromInputFile ()) != EOF)
 				{
-					vStringPut (token->string, c0);
+					putcToString (string, c0);
 					if (c0 == '}')
 						break;
 				}
 			}
 			else
-				readIdentifier (token->string);
+				readIdentifier (string);
 			break;
 		}
 	default:
-			vStringPut (token->string, c);
-			readIdentifier (token->string);
+			putcToString (string, c);
+			readIdentifier (string);
 
-			token->keyword = resolveKeyword (token->string);
+			if (!skipping)
+				token->keyword = resolveKeyword (token->string);
 			if (token->keyword == KEYWORD_NONE)
 				token->type = TOKEN_TCL_IDENTIFIER;
 			else
@@ -388,24 +403,77 @@ static void notifyNamespaceImport (tokenInfo *const token)
 	}
 }
 
-static int notifyCommand (tokenInfo *const token, unsigned int parent)
+static void addCommandSubparser (void *key CTAGS_ATTR_UNUSED, void *value, void *user_data)
+{
+	ptrArrayAdd ((ptrArray *)value, user_data);
+}
+
+/* Index the subparsers by the commands they consume, keeping them in
+ * the order of foreachSubparser for each command. */
+static void indexCommandSubparsers (struct sTclParserState *pstate)
 {
 	subparser *sub;
-	int r;
+
+	pstate->commandSubparsers = hashTableNew (17, hashCstrhash, hashCstreq,
+											  NULL, (hashTableFreeFunc)ptrArrayDelete);
+	pstate->anyCommandSubparsers = ptrArrayNew (NULL);
 
 	foreachSubparser (sub, false)
 	{
 		tclSubparser *tclsub = (tclSubparser *)sub;
+		const char *const *command;
 
-		if (tclsub->commandNotify)
+		if (!tclsub->commandNotify)
+			continue;
+
+		if (tclsub->commands == NULL)
 		{
-			enterSubparser(sub);
-			r = tclsub->commandNotify (tclsub, vStringValue (token->string), parent,
-									   TOKEN_PSTATE(token));
-			leaveSubparser();
-			if (r != CORK_NIL)
-				break;
+			ptrArrayAdd (pstate->anyCommandSubparsers, sub);
+			hashTableForeachItem (pstate->commandSubparsers, addCommandSubparser, sub);
+			continue;
 		}
+
+		for (command = tclsub->commands; *command; command++)
+		{
+			ptrArray *subs = hashTableGetItem (pstate->commandSubparsers, *command);
+
+			if (subs == NULL)
+			{
+				unsigned int i;
+
+				subs = ptrArrayNew (NULL);
+				for (i = 0; i < ptrArrayCount (pstate->anyCommandSubparsers); i++)
+					ptrArrayAdd (subs, ptrArrayItem (pstate->anyCommandSubparsers, i));
+				hashTablePutItem (pstate->commandSubparsers, (void *)*command, subs);
+			}
+			if (!ptrArrayHas (subs, sub))
+				ptrArrayAdd (subs, sub);
+		}
+	}
+}
+
+static int notifyCommand (tokenInfo *const token, unsigned int parent)
+{
+	struct sTclParserState *pstate = TOKEN_PSTATE(token);
+	ptrArray *subs;
+	unsigned int i;
+	int r = CORK_NIL;
+
+	subs = hashTableGetItem (pstate->commandSubparsers, vStringValue (token->string));
+	if (subs == NULL)
+		subs = pstate->anyCommandSubparsers;
+
+	for (i = 0; i < ptrArrayCount (subs); i++)
+	{
+		subparser *sub = ptrArrayItem (subs, i);
+		tclSubparser *tclsub = (tclSubparser *)sub;
+
+		enterSubparser(sub);
+		r = tclsub->commandNotify (tclsub, vStringValue (token->string), parent,
+								   pstate);
+		leaveSubparser();
+		if (r != CORK_NIL)
+			break;
 	}
 	return r;
 }
@@ -597,7 +665,10 @@ static void findTclTags (void)
 	struct sTclParserState pstate = {
 		.lastTokenType = TOKEN_TCL_UNDEFINED,
 	};
-	tokenInfo *const token = newTclToken (&pstate);
+	tokenInfo *token;
+
+	indexCommandSubparsers (&pstate);
+	token = newTclToken (&pstate);
 
 	do {
 		tokenRead (token);
@@ -618,6 +689,20 @@ static void findTclTags (void)
 
 	tokenDestroy (token);
 	flashTokenBacklog (&tclTokenInfoClass);
+
+	hashTableDelete (pstate.commandSubparsers);
+	ptrArrayDelete (pstate.anyCommandSubparsers);
+}
+
+static void initialize (const langType language CTAGS_ATTR_UNUSED)
+{
+	int c;
+
+	initInputCharClass (&StringChars, "\\\"", true);
+	initInputCharClass (&IdentifierChars, "", false);
+	for (c = 1; c < ARRAY_SIZE (IdentifierChars.members); c++)
+		IdentifierChars.members [c] = (isgraph (c) && !strchr ("{}[]", c));
+	initInputCharClass (&CommentChars, "\r\n", true);
 }
 
 extern parserDefinition* TclParser (void)
@@ -634,6 +719,7 @@ extern parserDefinition* TclParser (void)
 	def->keywordCount = ARRAY_SIZE (TclKeywordTable);
 
 	def->parser     = findTclTags;
+	def->initialize = initialize;
 	def->useCork    = true;
 	def->requestAutomaticFQTag = true;
 	return def;
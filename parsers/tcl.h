@@ -45,6 +45,10 @@ struct sTclSubparser {
 	int (* commandNotify) (tclSubparser *s, char *command,
 						   int parentIndex,
 						   void *pstate);
+	/* The commands commandNotify may consume, terminated with NULL.
+	   commandNotify is called only for them, or for any command
+	   if this is NULL. */
+	const char *const *commands;
 };
 
 extern tokenInfo *newTclToken (void *pstate);
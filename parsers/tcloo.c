@@ -56,11 +56,9 @@ static void parseSuperclass (tokenInfo *token, int parent)
 	{
 		tagEntryInfo *e = getEntryInCorkQueue(parent);
 
-		if (e->extensionFields.inheritance)
-		{   /* superclass is used twice in a class. */
-			eFree ((void *)e->extensionFields.inheritance);
-		}
-		e->extensionFields.inheritance = eStrdup(tokenString(token));
+		/* If superclass is used twice in a class, the last one wins. */
+		e->extensionFields.inheritance = copyStringToCorkEntry (parent,
+																tokenString(token));
 	}
 	skipToEndOfTclCmdline (token);
 }
@@ -141,6 +139,8 @@ static void inputStart (subparser *s)
 	tcloo->foundTclOONamespaceImported = false;
 }
 
+static const char *const TclOOCommands [] = { "class", "oo::class", NULL };
+
 struct tclooSubparser tclooSubparser = {
 	.tcl = {
 		.subparser = {
@@ -148,6 +148,7 @@ struct tclooSubparser tclooSubparser = {
 			.inputStart = inputStart,
 		},
 		.commandNotify = commandNotify,
+		.commands = TclOOCommands,
 		.namespaceImportNotify = namespaceImportNotify,
 	},
 };
@@ -96,6 +96,22 @@ static vString *lastSection;
 static vString *lastSubS;
 static vString *lastSubSubS;
 
+/* The characters of the text between the commands and the comments,
+   and of the comments up to their line breaks: they are skipped in bulk. */
+static inputCharClass TextChars;
+static inputCharClass CommentChars;
+
+/* The characters of a verbatim environment but the backslash which may
+   start its end, and those of an environment name */
+static inputCharClass VerbatimChars;
+static inputCharClass EnvironmentNameChars;
+
+/* The environments whose contents are not TeX, thus make no tags */
+static const char *const VerbatimEnvironments [] = {
+	"verbatim", "verbatim*", "Verbatim", "Verbatim*", "BVerbatim", "LVerbatim",
+	"lstlisting", "minted", "comment",
+};
+
 typedef enum {
 	TEXTAG_PART,
 	TEXTAG_CHAPTER,
@@ -270,6 +286,53 @@ static void parseIdentifier (vString *const string, const int firstChar)
 		ungetcToInputFile (c);		/* unget non-identifier character */
 }
 
+/*
+ *	Read a command name, beginning with "firstChar", into "string". \verb
+ *	and \verb* are recognised before the name is over, as their delimiter
+ *	may be a character of an identifier: their argument, which may be a
+ *	\begin{verbatim}, is skipped up to the next delimiter in the line and
+ *	"string" is left empty.
+ */
+static void parseCommandName (vString *const string, const int firstChar)
+{
+	static const char verb [] = "verb";
+	int c = firstChar;
+	int delimiter;
+	size_t i;
+
+	for (i = 0; verb [i] != '\0' && c == verb [i]; ++i)
+		c = getcFromInputFile ();
+
+	if (verb [i] != '\0' || isalpha (c))
+	{
+		vStringNCatS (string, verb, i);
+		if (isIdentChar (c))
+			parseIdentifier (string, c);
+		else if (c != EOF && !isspace (c))
+			ungetcToInputFile (c);
+		return;
+	}
+
+	delimiter = (c == '*')? getcFromInputFile (): c;
+	if (delimiter == '\n' || delimiter == EOF)
+		return;
+
+	do
+		c = getcFromInputFile ();
+	while (c != delimiter && c != '\n' && c != EOF);
+}
+
+static void skipComment (void)
+{
+	int c;
+
+	do
+	{
+		skipInputCharsInClass (&CommentChars);
+		c = getcFromInputFile ();
+	} while (c != '\n' && c != EOF);
+}
+
 static bool readToken (tokenInfo *const token)
 {
 	int c;
@@ -310,7 +373,9 @@ getNextChar:
 					  ungetcToInputFile (c);
 				  else
 				  {
-					  parseIdentifier (token->string, c);
+					  parseCommandName (token->string, c);
+					  if (vStringLength (token->string) == 0)
+						  goto getNextChar;	/* \verb and its argument */
 					  token->lineNumber = getInputLineNumber ();
 					  token->filePosition = getInputFilePosition ();
 					  token->keyword = lookupKeyword (vStringValue (token->string), Lang_tex);
@@ -322,7 +387,7 @@ getNextChar:
 				  break;
 
 		case '%':
-				  skipToCharacterInInputFile ('\n'); /* % are single line comments */
+				  skipComment (); /* % are single line comments */
 				  goto getNextChar;
 				  break;
 
@@ -355,6 +420,97 @@ static void copyToken (tokenInfo *const dest, tokenInfo *const src)
  *	 Scanning functions
  */
 
+static bool isVerbatimEnvironment (const char *name)
+{
+	unsigned int i;
+
+	for (i = 0; i < ARRAY_SIZE (VerbatimEnvironments); i++)
+		if (strcmp (name, VerbatimEnvironments [i]) == 0)
+			return true;
+	return false;
+}
+
+/*
+ *	Skip the contents of the environment "name" up to its
+ *	\end{name}, looking only at the backslashes in them.
+ */
+static void skipEnvironment (const char *name)
+{
+	vString *const end = vStringNewInit ("end{");
+	int c;
+
+	vStringCatS (end, name);
+	vStringPut (end, '}');
+
+	do
+	{
+		size_t i;
+
+		skipInputCharsInClass (&VerbatimChars);
+		c = getcFromInputFile ();
+		if (c != '\\')
+			continue;
+
+		for (i = 0; i < vStringLength (end); i++)
+		{
+			c = getcFromInputFile ();
+			if (c != vStringChar (end, i))
+				break;
+		}
+		if (i == vStringLength (end))
+			break;
+		if (c == '\\')
+			ungetcToInputFile (c);
+	} while (c != EOF);
+
+	vStringDelete (end);
+}
+
+/*
+ *	After \begin, skip the environment if it is a verbatim one.
+ */
+static void parseBegin (void)
+{
+	vString *name;
+	int c = getcFromInputFile ();
+
+	if (c != '{')
+	{
+		if (c != EOF)
+			ungetcToInputFile (c);
+		return;
+	}
+
+	name = vStringNew ();
+	readInputCharsInClass (&EnvironmentNameChars, name);
+	c = getcFromInputFile ();
+	if (c == '}' && isVerbatimEnvironment (vStringValue (name)))
+		skipEnvironment (vStringValue (name));
+	else if (c != EOF)
+		ungetcToInputFile (c);
+	vStringDelete (name);
+}
+
+/*
+ *	Skip the text up to the next command, which only is looked at out of
+ *	the arguments of the sectioning commands, and the comments before it.
+ */
+static void skipText (void)
+{
+	int c;
+
+	for (;;)
+	{
+		skipInputCharsInClass (&TextChars);
+		c = getcFromInputFile ();
+		if (c != '%')
+			break;
+		skipComment ();
+	}
+	if (c != EOF)
+		ungetcToInputFile (c);
+}
+
 static bool parseTag (tokenInfo *const token, texKind kind)
 {
 	tokenInfo *const name = newToken ();
@@ -513,10 +669,14 @@ static void parseTexFile (tokenInfo *const token)
 
 	do
 	{
+		skipText ();
 		if (!readToken (token))
 			break;
 
-		if (isType (token, TOKEN_KEYWORD))
+		if (isType (token, TOKEN_IDENTIFIER)
+			&& strcmp (vStringValue (token->string), "begin") == 0)
+			parseBegin ();
+		else if (isType (token, TOKEN_KEYWORD))
 		{
 			switch (token->keyword)
 			{
@@ -566,6 +726,12 @@ static void initialize (const langType language)
 	lastSection = vStringNew();
 	lastSubS    = vStringNew();
 	lastSubSubS = vStringNew();
+
+	initInputCharClass (&TextChars, "\\%", true);
+	initInputCharClass (&CommentChars, "\n", true);
+	initInputCharClass (&VerbatimChars, "\\", true);
+	initInputCharClass (&EnvironmentNameChars,
+						"abcdefghijklmnopqrstuvwxyzABCDEFGHIJKLMNOPQRSTUVWXYZ*", false);
 }
 
 static void finalize (const langType language CTAGS_ATTR_UNUSED,
@@ -590,6 +756,12 @@ static void findTexTags (void)
 {
 	tokenInfo *const token = newToken ();
 
+	vStringClear (lastPart);
+	vStringClear (lastChapter);
+	vStringClear (lastSection);
+	vStringClear (lastSubS);
+	vStringClear (lastSubSubS);
+
 	parseTexFile (token);
 
 	deleteToken (token);
@@ -93,6 +93,13 @@ static int Ungetc;
 static int Lang_verilog;
 static int Lang_systemverilog;
 
+/* Runs of characters which vGetc () returns as they are, so that they
+ * can be read from the input in one go. */
+static inputCharClass IdentifierChars;
+static inputCharClass WhiteChars;
+static inputCharClass CommentChars;
+static inputCharClass StringChars;
+
 static kindDefinition VerilogKinds [] = {
  { true, 'c', "constant",  "constants (define, parameter, specparam)" },
  { true, 'e', "event",     "events" },
@@ -361,15 +368,28 @@ static void buildKeywordHash (const langType language, unsigned int idx)
 	}
 }
 
+static void initializeCharClasses (void)
+{
+	initInputCharClass (&IdentifierChars,
+						"abcdefghijklmnopqrstuvwxyz"
+						"ABCDEFGHIJKLMNOPQRSTUVWXYZ"
+						"0123456789_`", false);
+	initInputCharClass (&WhiteChars, " \t\n\v\f\r", false);
+	initInputCharClass (&CommentChars, "\n", true);
+	initInputCharClass (&StringChars, "\"", true);
+}
+
 static void initializeVerilog (const langType language)
 {
 	Lang_verilog = language;
+	initializeCharClasses ();
 	buildKeywordHash (language, IDX_VERILOG);
 }
 
 static void initializeSystemVerilog (const langType language)
 {
 	Lang_systemverilog = language;
+	initializeCharClasses ();
 	buildKeywordHash (language, IDX_SYSTEMVERILOG);
 }
 
@@ -396,9 +416,8 @@ static int vGetc (void)
 			return EOF;
 		else if (c2 == '/')  /* strip comment until end-of-line */
 		{
-			do
-				c = getcFromInputFile ();
-			while (c != '\n'  &&  c != EOF);
+			skipInputCharsInClass (&CommentChars);
+			c = getcFromInputFile ();
 		}
 		else if (c2 == '*')  /* strip block comment */
 		{
@@ -411,10 +430,8 @@ static int vGetc (void)
 	}
 	else if (c == '"')  /* strip string contents */
 	{
-		int c2;
-		do
-			c2 = getcFromInputFile ();
-		while (c2 != '"'  &&  c2 != EOF);
+		skipInputCharsInClass (&StringChars);
+		getcFromInputFile ();
 		c = '@';
 	}
 	return c;
@@ -428,7 +445,11 @@ static bool isIdentifierCharacter (const int c)
 static int skipWhite (int c)
 {
 	while (isspace (c))
+	{
+		if (Ungetc == '\0')
+			skipInputCharsInClass (&WhiteChars);
 		c = vGetc ();
+	}
 	return c;
 }
 
@@ -466,11 +487,18 @@ static bool readIdentifier (tokenInfo *const token, int c)
 		while (isIdentifierCharacter (c))
 		{
 			vStringPut (token->name, c);
+			if (Ungetc == '\0')
+				readInputCharsInClass (&IdentifierChars, token->name);
 			c = vGetc ();
 		}
 		vUngetc (c);
-		token->lineNumber = getInputLineNumber ();
-		token->filePosition = getInputFilePosition ();
+		/* The position only changes with the line; most identifiers
+		 * share the line of the one read before them. */
+		if (token->lineNumber != getInputLineNumber ())
+		{
+			token->lineNumber = getInputLineNumber ();
+			token->filePosition = getInputFilePosition ();
+		}
 	}
 	return (bool)(vStringLength (token->name) > 0);
 }
@@ -543,12 +571,24 @@ static void createContext (tokenInfo *const scope)
 	}
 }
 
+/* Whether NAME is "end" followed by the name of KIND, as in "endmodule" */
+static bool isEndOfKind (const vString *const name, const verilogKind kind)
+{
+	const char *const s = vStringValue (name);
+
+	return (strncmp (s, "end", 3) == 0
+			&& strcmp (s + 3, getNameForKind (kind)) == 0);
+}
+
 static void dropEndContext (tokenInfo *const token)
 {
 	verbose ("current context %s; context kind %0d; nest level %0d\n", vStringValue (currentContext->name), currentContext->kind, currentContext->nestLevel);
-	vString *endTokenName = vStringNewInit("end");
+	/* Every end keyword starts with "end" */
+	if (vStringLength (token->name) < 3
+	    || strncmp (vStringValue (token->name), "end", 3) != 0)
+		return;
 	if ((currentContext->kind == K_COVERGROUP && strcmp (vStringValue (token->name), "endgroup") == 0) ||
-	    (currentContext->kind == K_BLOCK && currentContext->nestLevel == 0 && strcmp (vStringValue (token->name), vStringValue (endTokenName)) == 0)
+	    (currentContext->kind == K_BLOCK && currentContext->nestLevel == 0 && vStringLength (token->name) == 3)
 	    )
 	{
 		verbose ("Dropping context %s\n", vStringValue (currentContext->name));
@@ -556,8 +596,7 @@ static void dropEndContext (tokenInfo *const token)
 	}
 	else
 	{
-		vStringCatS (endTokenName, getNameForKind (currentContext->kind));
-		if (strcmp (vStringValue (token->name), vStringValue (endTokenName)) == 0)
+		if (isEndOfKind (token->name, currentContext->kind))
 		{
 			verbose ("Dropping context %s\n", vStringValue (currentContext->name));
 			currentContext = popToken (currentContext);
@@ -568,7 +607,6 @@ static void dropEndContext (tokenInfo *const token)
 			}
 		}
 	}
-	vStringDelete(endTokenName);
 }
 
 
@@ -80,7 +80,7 @@ static jmp_buf Exception;
  *  FUNCTION DEFINITIONS
  */
 
-static bool parseVimLine (const unsigned char *line, int infunction);
+static bool parseVimLine (const unsigned char **linep, int infunction);
 
 /* This function takes a char pointer, tries to find a scope separator in the
  * string, and if it does, returns a pointer to the character after the colon,
@@ -277,7 +277,7 @@ static void parseFunction (const unsigned char *line)
 			break;
 		}
 
-		parseVimLine (line, true);
+		parseVimLine (&line, true);
 	}
 	vStringDelete (name);
 }
@@ -309,7 +309,7 @@ static void parseAutogroup (const unsigned char *line)
 	vStringDelete (name);
 }
 
-static bool parseCommand (const unsigned char *line)
+static bool parseCommand (const unsigned char **linep)
 {
 	vString *name = vStringNew ();
 	bool cmdProcessed = true;
@@ -322,6 +322,7 @@ static bool parseCommand (const unsigned char *line)
 	 * The name of the command should be the first word not preceded by a dash
 	 *
 	 */
+	const unsigned char *line = *linep;
 	const unsigned char *cp = line;
 
 	if (cp && (*cp == '\\'))
@@ -411,9 +412,11 @@ static bool parseCommand (const unsigned char *line)
 		/*
 		 * We have reached the end of the line without finding the command name.
 		 * Read the next line and continue processing it as a command.
+		 * The caller gets the line read here through linep, NULL at the
+		 * end of the input, and must parse it instead of the old one.
 		 */
-		if ((line = readVimLine ()) != NULL)
-			cmdProcessed = parseCommand (line);
+		if ((*linep = readVimLine ()) != NULL)
+			cmdProcessed = parseCommand (linep);
 		else
 			cmdProcessed = false;
 		goto cleanUp;
@@ -571,14 +574,15 @@ static bool parseMap (const unsigned char *line)
 	return true;
 }
 
-static bool parseVimLine (const unsigned char *line, int infunction)
+static bool parseVimLine (const unsigned char **linep, int infunction)
 {
+	const unsigned char *line = *linep;
 	bool readNextLine = true;
 
 	if (wordMatchLen (line, "command", 3))
 	{
-		readNextLine = parseCommand (line);
-		/* TODO - Handle parseCommand returning false */
+		/* On false, *linep holds the line parseCommand stopped at */
+		readNextLine = parseCommand (linep);
 	}
 
 	else if (isMap (line))
@@ -610,7 +614,7 @@ static void parseVimFile (const unsigned char *line)
 
 	while (line != NULL)
 	{
-		readNextLine = parseVimLine (line, false);
+		readNextLine = parseVimLine (&line, false);
 
 		if (readNextLine)
 			line = readVimLine ();
@@ -19,6 +19,7 @@
 #include "read.h"
 #include "subparser.h"
 #include "types.h"
+#include "xtag.h"
 #include "yaml.h"
 
 
@@ -97,6 +98,13 @@ static kindDefinition YamlKinds [] = {
 	  .referenceOnly = false, ATTACH_ROLES(YamlAnchorRoles) },
 };
 
+static bool doesYamlTagAnchors (void)
+{
+	return isInputLanguageKindEnabled (K_ANCHOR)
+		|| (isXtagEnabled (XTAG_REFERENCE_TAGS)
+			&& isLanguageRoleEnabled (getInputLanguage (), K_ANCHOR, R_ANCHOR_ALIAS));
+}
+
 static void handlYamlToken (yaml_token_t *token)
 {
 	tagEntryInfo tag;
@@ -108,7 +116,8 @@ static void handlYamlToken (yaml_token_t *token)
 		attachYamlPosition (&tag, token, false);
 		makeTagEntry (&tag);
 	}
-	else if (token->type == YAML_ALIAS_TOKEN)
+	else if (token->type == YAML_ALIAS_TOKEN
+			 && isXtagEnabled (XTAG_REFERENCE_TAGS))
 	{
 		initRefTagEntry (&tag, (char *)token->data.alias.value,
 						 K_ANCHOR, R_ANCHOR_ALIAS);
@@ -123,6 +132,7 @@ static void findYamlTags (void)
 	subparser *sub;
 	yaml_parser_t yaml;
 	yaml_token_t token;
+	bool tagAnchors;
 	bool done;
 
 	yamlInit (&yaml);
@@ -133,24 +143,40 @@ static void findYamlTags (void)
 	if (sub)
 		chooseExclusiveSubparser (sub, NULL);
 
+	tagAnchors = doesYamlTagAnchors ();
 	done = false;
 	while (!done)
 	{
+		bool interested = tagAnchors;
+
 		if (!yaml_parser_scan (&yaml, &token))
 			break;
 
-		handlYamlToken (&token);
+		if (tagAnchors)
+			handlYamlToken (&token);
 		foreachSubparser(sub, false)
 		{
+			yamlSubparser *ysub = (yamlSubparser *)sub;
+
+			if (ysub->interestEnded)
+				continue;
 			enterSubparser (sub);
-			((yamlSubparser *)sub)->newTokenNotfify ((yamlSubparser *)sub, &token);
+			ysub->newTokenNotfify (ysub, &token);
 			leaveSubparser ();
+			if (!ysub->interestEnded)
+				interested = true;
 		}
 
 		verbose("yaml token:%s<%d>@Line:%"PRIuPTR"\n", tokenTypeName[token.type], token.type,
 				token.start_mark.line + 1);
 		if (token.type == YAML_STREAM_END_TOKEN)
 			done = true;
+		else if (!interested)
+		{
+			verbose ("yaml: no more tokens wanted; stop scanning at line %"PRIuPTR"\n",
+					 token.start_mark.line + 1);
+			done = true;
+		}
 
 		yaml_token_delete (&token);
 	}
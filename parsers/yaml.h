@@ -25,6 +25,12 @@ typedef struct sYamlSubparser yamlSubparser;
 struct sYamlSubparser {
 	subparser subparser;
 	void (* newTokenNotfify) (yamlSubparser *s, yaml_token_t *token);
+
+	/* Set by the subparser when it needs no more tokens of the current
+	 * input; it should be cleared in inputStart. Once the base parser
+	 * and all the subparsers are done, the rest of the input is not
+	 * scanned. */
+	bool interestEnded;
 };
 
 extern void attachYamlPosition (tagEntryInfo *tag, yaml_token_t *token, bool asEndPosition);
@@ -6,22 +6,68 @@
 *   This module contains functions for reading tag files.
 */
 
+#ifdef HAVE_CONFIG_H
+# include <config.h>
+#endif
+
 #include "readtags.h"
 #include <string.h>		/* strerror */
 #include <stdlib.h>		/* exit */
 #include <stdio.h>		/* stderr */
+#include <errno.h>
+#ifdef HAVE_WORKING_FORK
+# include <unistd.h>	/* fork */
+# include <sys/types.h>
+# include <sys/wait.h>	/* waitpid */
+#endif
+#if defined (HAVE_SYS_SOCKET_H) && defined (HAVE_SYS_UN_H)
+# include <unistd.h>	/* close, unlink */
+# include <signal.h>
+# include <sys/types.h>
+# include <sys/stat.h>
+# include <sys/socket.h>
+# include <sys/un.h>
+# define SERVER_SUPPORTED
+#endif
 
 static const char *TagFileName = "tags";
+/* The tag files given with -T, searched in order after the one of -t */
+static const char **MoreTagFileNames;
+static tagFile **MoreOpenedFiles;
+static int moreTagFileCount;
 static const char *ProgramName;
 static int extensionFields;
 static int SortOverride;
 static sortType SortMethod;
 static int allowPrintLineNumber;
+static int countTags;
+static int jobCount = 1;
+static const char *KindFilter;
+#ifdef SERVER_SUPPORTED
+/* With -C, the queries are sent to the readtags serving on this socket. */
+static const char *ServerName;
+#endif
+/* The tag file is kept open from name to name, so the searches after
+   the first one can use it mapped in memory. */
+static tagFile *OpenedFile;
+static const char *OpenedFileName;
 #ifdef QUALIFIER
 #include "dsl/qualifier.h"
 static QCode *Qualifier;
 #endif
 
+static int isKindAccepted (const char *const kind)
+{
+	return KindFilter == NULL  ||  (kind != NULL  &&  strcmp (kind, KindFilter) == 0);
+}
+
+static int isKindOfViewAccepted (const tagString *const kind)
+{
+	return KindFilter == NULL
+		||  (kind->length == strlen (KindFilter)
+			 &&  memcmp (kind->value, KindFilter, kind->length) == 0);
+}
+
 static void printTag (const tagEntry *entry)
 {
 	int i;
@@ -60,100 +106,769 @@ static void printTag (const tagEntry *entry)
 #undef sep
 }
 
+static void printString (const tagString *const string)
+{
+	fwrite (string->value, 1, string->length, stdout);
+}
+
+/* Like printTag, for a view */
+static void printTagView (const tagEntryView *view)
+{
+	int first = 1;
+	const char *position = NULL;
+	tagString key, value;
+
+	printString (&view->name);
+	putchar ('\t');
+	printString (&view->file);
+	putchar ('\t');
+	printString (&view->address.pattern);
+	if (extensionFields)
+	{
+		if (view->kind.length > 0)
+		{
+			fputs (";\"\tkind:", stdout);
+			printString (&view->kind);
+			first = 0;
+		}
+		if (view->fileScope)
+		{
+			printf ("%s\tfile:", first? ";\"": "");
+			first = 0;
+		}
+		if (allowPrintLineNumber && view->address.lineNumber > 0)
+		{
+			printf ("%s\tline:%lu", first? ";\"": "", view->address.lineNumber);
+			first = 0;
+		}
+		while (tagsViewNextField (view, &position, &key, &value) == TagSuccess)
+		{
+			printf ("%s\t", first? ";\"": "");
+			printString (&key);
+			putchar (':');
+			printString (&value);
+			first = 0;
+		}
+	}
+	putchar ('\n');
+}
+
+static void closeTagFile (void)
+{
+	if (OpenedFile != NULL)
+	{
+		tagsClose (OpenedFile);
+		OpenedFile = NULL;
+		OpenedFileName = NULL;
+	}
+}
+
+static tagFile *openTagFile (tagFileInfo *const info)
+{
+	if (OpenedFile != NULL  &&  OpenedFileName != TagFileName)
+		closeTagFile ();
+	if (OpenedFile == NULL)
+	{
+		OpenedFile = tagsOpen (TagFileName, info);
+		OpenedFileName = TagFileName;
+	}
+	return OpenedFile;
+}
+
+static void closeMoreTagFiles (void)
+{
+	int i;
+
+	for (i = 0  ;  i < moreTagFileCount  ;  ++i)
+		if (MoreOpenedFiles [i] != NULL)
+			tagsClose (MoreOpenedFiles [i]);
+	free (MoreOpenedFiles);
+	free (MoreTagFileNames);
+	MoreOpenedFiles = NULL;
+	MoreTagFileNames = NULL;
+	moreTagFileCount = 0;
+}
+
+static void addTagFile (const char *const path)
+{
+	const char **const names = (const char **) realloc (MoreTagFileNames,
+		(moreTagFileCount + 1) * sizeof (*names));
+	tagFile **files;
+
+	if (names == NULL)
+	{
+		perror (ProgramName);
+		exit (1);
+	}
+	MoreTagFileNames = names;
+	files = (tagFile **) realloc (MoreOpenedFiles,
+		(moreTagFileCount + 1) * sizeof (*files));
+	if (files == NULL)
+	{
+		perror (ProgramName);
+		exit (1);
+	}
+	MoreOpenedFiles = files;
+	MoreTagFileNames [moreTagFileCount] = path;
+	MoreOpenedFiles [moreTagFileCount] = NULL;
+	++moreTagFileCount;
+}
+
+/* Open the tag file I of -T, which is kept open like the one of -t. */
+static tagFile *openMoreTagFile (const int i, tagFileInfo *const info)
+{
+	if (MoreOpenedFiles [i] == NULL)
+		MoreOpenedFiles [i] = tagsOpen (MoreTagFileNames [i], info);
+	return MoreOpenedFiles [i];
+}
+
+/* The path of the tag file I, counting the one of -t and those of -T */
+static const char *tagFilePath (const int i)
+{
+	return (i == 0)? TagFileName: MoreTagFileNames [i - 1];
+}
+
+static void cannotOpenTagFile (const tagFileInfo *const info, const char *const path)
+{
+	fprintf (stderr, "%s: cannot open tag file: %s: %s\n",
+			ProgramName, strerror (info->status.error_number), path);
+	exit (1);
+}
+
+#ifdef SERVER_SUPPORTED
+static void queryServer (const char *const name, const int options, const int list);
+#endif
+
+/* Print the tags of FILE matching NAME, or add their number to COUNT
+   with -c. */
+static void findTagInFile (tagFile *const file, const char *const name,
+						   const int options, unsigned long *const count)
+{
+	tagEntry entry;
+
+	if (SortOverride)
+		tagsSetSortType (file, SortMethod);
+	if (countTags  &&  KindFilter == NULL
+#ifdef QUALIFIER
+		&&  Qualifier == NULL
+#endif
+		)
+	{
+		unsigned long n = 0;
+		tagsCount (file, name, options, &n);
+		*count += n;
+	}
+	else if (tagsFind (file, &entry, name, options) == TagSuccess)
+	{
+		do
+		{
+			if (! isKindAccepted (entry.kind))
+				continue;
+#ifdef QUALIFIER
+			if (Qualifier)
+			{
+				int i = q_is_acceptable (Qualifier, &entry);
+				switch (i)
+				{
+				case Q_REJECT:
+					continue;
+				case Q_ERROR:
+					exit (1);
+				}
+			}
+#endif
+			if (countTags)
+				++*count;
+			else
+				printTag (&entry);
+		} while (tagsFindNext (file, &entry) == TagSuccess);
+	}
+}
+
+#ifdef HAVE_WORKING_FORK
+static int findTagInParallel (const char *const name, const int options);
+#endif
+
 static void findTag (const char *const name, const int options)
 {
 	tagFileInfo info;
-	tagEntry entry;
-	tagFile *const file = tagsOpen (TagFileName, &info);
+	tagFile *file;
+	unsigned long count = 0;
+	int i;
+
+#ifdef SERVER_SUPPORTED
+	if (ServerName != NULL)
+	{
+		queryServer (name, options, 0);
+		return;
+	}
+#endif
+#ifdef HAVE_WORKING_FORK
+	if (jobCount > 1  &&  moreTagFileCount > 0  &&  findTagInParallel (name, options))
+		return;
+#endif
+	file = openTagFile (&info);
 	if (file == NULL)
 	{
 		fprintf (stderr, "%s: cannot open tag file: %s: %s\n",
 				ProgramName, strerror (info.status.error_number), name);
 		exit (1);
 	}
-	else
+	findTagInFile (file, name, options, &count);
+	for (i = 0  ;  i < moreTagFileCount  ;  ++i)
 	{
-		if (SortOverride)
-			tagsSetSortType (file, SortMethod);
-		if (tagsFind (file, &entry, name, options) == TagSuccess)
+		file = openMoreTagFile (i, &info);
+		if (file == NULL)
+			cannotOpenTagFile (&info, MoreTagFileNames [i]);
+		findTagInFile (file, name, options, &count);
+	}
+	if (countTags)
+		printf ("%lu\n", count);
+}
+
+/* Print the tags read from FILE, the first of which is in ENTRY if FOUND
+   is TagSuccess. */
+static void printTags (tagFile *const file, tagEntry *const entry, tagResult found)
+{
+	for (; found == TagSuccess; found = tagsNext (file, entry))
+	{
+		if (! isKindAccepted (entry->kind))
+			continue;
+#ifdef QUALIFIER
+		if (Qualifier)
 		{
-			do
+			int i = q_is_acceptable (Qualifier, entry);
+			switch (i)
 			{
-#ifdef QUALIFIER
-				if (Qualifier)
-				{
-					int i = q_is_acceptable (Qualifier, &entry);
-					switch (i)
-					{
-					case Q_REJECT:
-						continue;
-					case Q_ERROR:
-						exit (1);
-					}
-				}
+			case Q_REJECT:
+				continue;
+			case Q_ERROR:
+				exit (1);
+			}
+		}
 #endif
-				printTag (&entry);
-			} while (tagsFindNext (file, &entry) == TagSuccess);
+		printTag (entry);
+	}
+}
+
+#ifdef HAVE_WORKING_FORK
+/* With -j, the lines of the tag file are split into as many ranges as
+   jobs, listed by worker processes. A worker writes its output and its
+   errors into temporary files, which are copied to the ones of readtags
+   in the order of the ranges, up to the range of the first worker which
+   failed; the result is the same as listing the file in one process.
+   With -T, the name is looked up in each tag file by a worker in the
+   same way, the outputs being copied in the order of the tag files. */
+typedef struct {
+	pid_t pid;
+	FILE *out;
+	FILE *err;
+	int failed;
+} listJob;
+
+static FILE *newTemporaryFile (void)
+{
+	FILE *fp = tmpfile ();
+	if (fp == NULL)
+	{
+		fprintf (stderr, "%s: cannot create a temporary file: %s\n",
+				ProgramName, strerror (errno));
+		exit (1);
+	}
+	return fp;
+}
+
+static void copyTemporaryFile (FILE *const from, FILE *const to)
+{
+	char buffer [BUFSIZ];
+	size_t n;
+
+	rewind (from);
+	while ((n = fread (buffer, 1, sizeof buffer, from)) > 0)
+		fwrite (buffer, 1, n, to);
+	fclose (from);
+}
+
+/* Start the worker of JOB; return 1 in the worker, whose output and
+   errors go to the temporary files of JOB. */
+static int forkJob (listJob *const job)
+{
+	job->out = newTemporaryFile ();
+	job->err = newTemporaryFile ();
+	job->pid = fork ();
+	if (job->pid < 0)
+	{
+		fprintf (stderr, "%s: cannot fork a worker: %s\n",
+				ProgramName, strerror (errno));
+		exit (1);
+	}
+	else if (job->pid == 0)
+	{
+		dup2 (fileno (job->out), STDOUT_FILENO);
+		dup2 (fileno (job->err), STDERR_FILENO);
+		return 1;
+	}
+	return 0;
+}
+
+static void waitJob (listJob *const job)
+{
+	int status;
+	if (waitpid (job->pid, &status, 0) < 0
+		||  ! WIFEXITED (status)  ||  WEXITSTATUS (status) != 0)
+		job->failed = 1;
+}
+
+/* Copy the outputs of the COUNT JOBS up to the first which failed, or
+   with -c, sum the counts they printed into COUNT. Return 1 if one of
+   them failed. */
+static int copyJobs (listJob *const jobs, const int n, unsigned long *const count)
+{
+	int i, failed = 0;
+
+	for (i = 0  ;  i < n  ;  ++i)
+	{
+		if (! failed)
+		{
+			if (count != NULL)
+			{
+				unsigned long c;
+				rewind (jobs [i].out);
+				if (fscanf (jobs [i].out, "%lu", &c) == 1)
+					*count += c;
+				fclose (jobs [i].out);
+			}
+			else
+				copyTemporaryFile (jobs [i].out, stdout);
+			fflush (stdout);
+			copyTemporaryFile (jobs [i].err, stderr);
+			failed = jobs [i].failed;
+		}
+		else
+		{
+			fclose (jobs [i].out);
+			fclose (jobs [i].err);
 		}
-		tagsClose (file);
 	}
+	return failed;
 }
 
-static void listTags (void)
+static void listTagRange (const char *const path, const long start, const long end)
 {
 	tagFileInfo info;
 	tagEntry entry;
-	tagFile *const file = tagsOpen (TagFileName, &info);
+	tagFile *const file = tagsOpen (path, &info);
 	if (file == NULL)
+		cannotOpenTagFile (&info, path);
+	printTags (file, &entry, tagsFirstInRange (file, &entry, start, end));
+	tagsClose (file);
+}
+
+/* Return 0 if the tag file at PATH is to be listed in one process. */
+static int listTagsInParallel (const char *const path)
+{
+	listJob *jobs;
+	FILE *fp;
+	long size, piece;
+	int i, failed;
+
+	fp = fopen (path, "rb");
+	if (fp == NULL)
+		return 0;
+	fseek (fp, 0, SEEK_END);
+	size = ftell (fp);
+	fclose (fp);
+	if (size < jobCount)
+		return 0;
+
+	piece = size / jobCount;
+	jobs = (listJob *) calloc ((size_t) jobCount, sizeof (listJob));
+	if (jobs == NULL)
+		return 0;
+	fflush (NULL);
+	for (i = 0  ;  i < jobCount  ;  ++i)
+	{
+		const long start = piece * i;
+		const long end = (i + 1 == jobCount)? size: start + piece;
+
+		if (forkJob (jobs + i))
+		{
+			listTagRange (path, start, end);
+			fflush (NULL);
+			_exit (0);
+		}
+	}
+
+	for (i = 0  ;  i < jobCount  ;  ++i)
+		waitJob (jobs + i);
+	failed = copyJobs (jobs, jobCount, NULL);
+	free (jobs);
+	if (failed)
+		exit (1);
+	return 1;
+}
+
+/* Look NAME up in the tag files of -t and -T, in at most as many worker
+   processes at a time as jobs. Return 0 if it is to be done in one
+   process. */
+static int findTagInParallel (const char *const name, const int options)
+{
+	const int n = 1 + moreTagFileCount;
+	listJob *jobs;
+	unsigned long count = 0;
+	int i, failed;
+
+	jobs = (listJob *) calloc ((size_t) n, sizeof (listJob));
+	if (jobs == NULL)
+		return 0;
+	fflush (NULL);
+	for (i = 0  ;  i < n  ;  ++i)
+	{
+		if (i >= jobCount)
+			waitJob (jobs + i - jobCount);
+		if (forkJob (jobs + i))
+		{
+			tagFileInfo info;
+			unsigned long c = 0;
+			const char *const path = tagFilePath (i);
+			/* The files opened by the parent share their positions
+			   with it: the worker opens its own. */
+			tagFile *const file = tagsOpen (path, &info);
+
+			if (file == NULL)
+				cannotOpenTagFile (&info, path);
+			findTagInFile (file, name, options, &c);
+			if (countTags)
+				printf ("%lu\n", c);
+			tagsClose (file);
+			fflush (NULL);
+			_exit (0);
+		}
+	}
+
+	for (i = (n > jobCount)? n - jobCount: 0  ;  i < n  ;  ++i)
+		waitJob (jobs + i);
+	failed = copyJobs (jobs, n, countTags? &count: NULL);
+	free (jobs);
+	if (failed)
+		exit (1);
+	if (countTags)
+		printf ("%lu\n", count);
+	return 1;
+}
+#endif
+
+#ifdef SERVER_SUPPORTED
+/* With -S, readtags opens the tag file once, and answers the queries
+   sent on a Unix socket by readtags -C, each connection in a process of
+   its own forked from the server; the processes share the pages of the
+   file mapped in memory by the server.
+
+   A query is a line made of the letters of the options (c, e, f for -F,
+   i, l, n and p), the kind given with -k and the name, separated by tabs. The
+   answer begins with "ok" or "error MESSAGE" on a line, and ends with an
+   empty line. */
+
+static void socketError (const char *const what, const char *const path)
+{
+	fprintf (stderr, "%s: %s: %s: %s\n",
+			 ProgramName, what, path, strerror (errno));
+	exit (1);
+}
+
+static int makeSocketAddress (const char *const path, struct sockaddr_un *const address)
+{
+	memset (address, 0, sizeof (*address));
+	address->sun_family = AF_UNIX;
+	if (strlen (path) >= sizeof (address->sun_path))
+	{
+		errno = ENAMETOOLONG;
+		return 0;
+	}
+	strcpy (address->sun_path, path);
+	return 1;
+}
+
+/* Read a line of at most SIZE - 1 bytes from IN without its newline.
+   Return 0 at the end of the input. */
+static int readLine (FILE *const in, char *const buffer, const size_t size)
+{
+	size_t length;
+
+	if (fgets (buffer, (int) size, in) == NULL)
+		return 0;
+	length = strlen (buffer);
+	if (length > 0  &&  buffer [length - 1] == '\n')
+		buffer [--length] = '\0';
+	else if (! feof (in))
+	{
+		int c;
+		/* Too long: what is left is dropped. */
+		while ((c = getc (in)) != EOF  &&  c != '\n')
+			;
+	}
+	return 1;
+}
+
+static void answerQuery (char *const query)
+{
+	char *const kind = strchr (query, '\t');
+	char *name = (kind != NULL)? strchr (kind + 1, '\t'): NULL;
+	int options = 0;
+	tagFileInfo info;
+
+	if (name == NULL)
+	{
+		printf ("error malformed query\n\n");
+		return;
+	}
+	*kind = '\0';
+	*name++ = '\0';
+	countTags = (strchr (query, 'c') != NULL);
+	extensionFields = (strchr (query, 'e') != NULL);
+	allowPrintLineNumber = (strchr (query, 'n') != NULL);
+	if (strchr (query, 'i') != NULL)
+		options |= TAG_IGNORECASE;
+	if (strchr (query, 'p') != NULL)
+		options |= TAG_PARTIALMATCH;
+	if (strchr (query, 'f') != NULL)
+		options |= TAG_INPUTMATCH;
+	if (strchr (query, 'm') != NULL)
+		options |= TAG_SUBSTRINGMATCH;
+	KindFilter = (kind [1] != '\0')? kind + 1: NULL;
+
+	printf ("ok\n");
+	if (strchr (query, 'l') != NULL)
+	{
+		tagEntry entry;
+		tagFile *const file = openTagFile (&info);
+		printTags (file, &entry, tagsFirst (file, &entry));
+	}
+	else
+		findTag (name, options);
+	putchar ('\n');
+}
+
+static void serveConnection (const int connection)
+{
+	FILE *const in = fdopen (connection, "r");
+	char query [BUFSIZ];
+
+	if (in == NULL)
+		return;
+	/* The answers are printed as readtags prints the tags. */
+	fflush (stdout);
+	dup2 (connection, STDOUT_FILENO);
+	while (readLine (in, query, sizeof query))
+	{
+		answerQuery (query);
+		fflush (stdout);
+	}
+	fclose (in);
+}
+
+static void serveTags (const char *const path)
+{
+	struct sockaddr_un address;
+	struct stat status;
+	tagFileInfo info;
+	int server;
+
+	if (openTagFile (&info) == NULL)
 	{
 		fprintf (stderr, "%s: cannot open tag file: %s: %s\n",
 				ProgramName, strerror (info.status.error_number), TagFileName);
 		exit (1);
 	}
-	else
+	if (! makeSocketAddress (path, &address))
+		socketError ("cannot serve on", path);
+	/* Left by a server which was killed; anything else is kept. */
+	if (stat (path, &status) == 0  &&  S_ISSOCK (status.st_mode))
+		unlink (path);
+	server = socket (AF_UNIX, SOCK_STREAM, 0);
+	if (server < 0
+		||  bind (server, (struct sockaddr *) &address, sizeof (address)) < 0
+		||  listen (server, 64) < 0)
+		socketError ("cannot serve on", path);
+#ifdef HAVE_WORKING_FORK
+	signal (SIGCHLD, SIG_IGN);	/* no zombie */
+#endif
+	for (;;)
 	{
-		while (tagsNext (file, &entry) == TagSuccess)
+		const int connection = accept (server, NULL, NULL);
+		if (connection < 0)
 		{
+			if (errno == EINTR  ||  errno == ECONNABORTED)
+				continue;
+			socketError ("cannot accept a connection on", path);
+		}
+#ifdef HAVE_WORKING_FORK
+		fflush (NULL);
+		if (fork () == 0)
+		{
+			close (server);
+			serveConnection (connection);
+			_exit (0);
+		}
+		close (connection);
+#else
+		serveConnection (connection);
+#endif
+	}
+}
+
+static FILE *ServerIn;
+static FILE *ServerOut;
+
+static void connectServer (void)
+{
+	struct sockaddr_un address;
+	int connection;
+
+	if (! makeSocketAddress (ServerName, &address))
+		socketError ("cannot connect to", ServerName);
+	connection = socket (AF_UNIX, SOCK_STREAM, 0);
+	if (connection < 0
+		||  connect (connection, (struct sockaddr *) &address, sizeof (address)) < 0)
+		socketError ("cannot connect to", ServerName);
+	ServerOut = fdopen (connection, "w");
+	ServerIn = fdopen (dup (connection), "r");
+	if (ServerOut == NULL  ||  ServerIn == NULL)
+		socketError ("cannot connect to", ServerName);
+}
+
+static void queryServer (const char *const name, const int options, const int list)
+{
+	char status [BUFSIZ];
+	int c, lineStart = 1;
+
 #ifdef QUALIFIER
-			if (Qualifier)
-			{
-				int i = q_is_acceptable (Qualifier, &entry);
-				switch (i)
-				{
-				case Q_REJECT:
-					continue;
-				case Q_ERROR:
-					exit (1);
-				}
-			}
+	if (Qualifier)
+	{
+		fprintf (stderr, "%s: -Q is applied by the server, not with -C\n",
+				 ProgramName);
+		exit (1);
+	}
 #endif
-			printTag (&entry);
-		}
-		tagsClose (file);
+	if (ServerOut == NULL)
+		connectServer ();
+	fprintf (ServerOut, "%s%s%s%s%s%s%s%s\t%s\t%s\n",
+			 countTags? "c": "", extensionFields? "e": "",
+			 (options & TAG_INPUTMATCH)? "f": "",
+			 (options & TAG_IGNORECASE)? "i": "", list? "l": "",
+			 (options & TAG_SUBSTRINGMATCH)? "m": "",
+			 allowPrintLineNumber? "n": "",
+			 (options & TAG_PARTIALMATCH)? "p": "",
+			 KindFilter? KindFilter: "", name);
+	if (fflush (ServerOut) != 0)
+		socketError ("cannot send a query to", ServerName);
+
+	if (! readLine (ServerIn, status, sizeof status))
+	{
+		fprintf (stderr, "%s: connection closed by the server: %s\n",
+				 ProgramName, ServerName);
+		exit (1);
+	}
+	if (strcmp (status, "ok") != 0)
+	{
+		fprintf (stderr, "%s: %s: %s\n", ProgramName, ServerName,
+				 strncmp (status, "error ", 6) == 0? status + 6: status);
+		exit (1);
+	}
+	while ((c = getc (ServerIn)) != EOF)
+	{
+		if (c == '\n'  &&  lineStart)
+			return;
+		putchar (c);
+		lineStart = (c == '\n');
+	}
+	fprintf (stderr, "%s: connection closed by the server: %s\n",
+			 ProgramName, ServerName);
+	exit (1);
+}
+#endif
+
+static void listTagFile (const char *const path)
+{
+	tagFileInfo info;
+	tagEntry entry;
+	tagFile *file;
+
+#ifdef HAVE_WORKING_FORK
+	if (jobCount > 1  &&  listTagsInParallel (path))
+		return;
+#endif
+	file = tagsOpen (path, &info);
+	if (file == NULL)
+		cannotOpenTagFile (&info, path);
+#ifdef QUALIFIER
+	if (Qualifier)
+		printTags (file, &entry, tagsNext (file, &entry));
+	else
+#endif
+	{
+		/* Without a qualifier, the lines are printed without being
+		   copied. */
+		tagEntryView views [64];
+		unsigned int i, n;
+		while ((n = tagsViewNext (file, views, 64)) > 0)
+			for (i = 0  ;  i < n  ;  ++i)
+				if (isKindOfViewAccepted (&views [i].kind))
+					printTagView (views + i);
 	}
+	tagsClose (file);
+}
+
+static void listTags (void)
+{
+	int i;
+
+#ifdef SERVER_SUPPORTED
+	if (ServerName != NULL)
+	{
+		queryServer ("", 0, 1);
+		return;
+	}
+#endif
+	for (i = 0  ;  i <= moreTagFileCount  ;  ++i)
+		listTagFile (tagFilePath (i));
 }
 
 static const char *const Usage =
 	"Find tag file entries matching specified names.\n\n"
 	"Usage: \n"
 	"    %s -h\n"
-	"    %s [-ilp] [-n] "
+	"    %s [-ciFlmp] [-n] [-j N] [-k kind] "
 #ifdef QUALIFIER
 	"[-Q EXP] "
 #endif
-	"[-s[0|1]] [-t file] [-] [name(s)]\n\n"
+	"[-s[0|1]] [-t file] [-T file]... "
+#ifdef SERVER_SUPPORTED
+	"[-S socket | -C socket] "
+#endif
+	"[-] [name(s)]\n\n"
 	"Options:\n"
+	"    -c           Print the number of tags matching each name instead of them.\n"
 	"    -e           Include extension fields in output.\n"
+	"    -F           Match the names with the input files of the tags.\n"
 	"    -h           Print this help message.\n"
 	"    -i           Perform case-insensitive matching.\n"
+	"    -j N         List the tags, or search the tag files of -T, with N processes.\n"
+	"    -k kind      Print only the tags of kind, as written in the tag file.\n"
 	"    -l           List all tags.\n"
+	"    -m           Match the names containing NAME.\n"
 	"    -n           Allow print line numbers if -e option is given.\n"
 	"    -p           Perform partial matching.\n"
 #ifdef QUALIFIER
 	"    -Q EXP       Filter the result with EXP.\n"
 #endif
 	"    -s[0|1|2]    Override sort detection of tag file.\n"
+#ifdef SERVER_SUPPORTED
+	"    -S socket    Answer the queries of readtags -C on the Unix socket.\n"
+	"    -C socket    Send the queries to readtags -S on the Unix socket.\n"
+#endif
 	"    -t file      Use specified tag file (default: \"tags\").\n"
+	"    -T file      Also use the tag file, after the ones before; -t starts over.\n"
 	"    -            Treat arguments after this as NAME even if they start with -.\n"
 	"Note that options are acted upon as encountered, so order is significant.\n";
 
@@ -220,13 +935,17 @@ extern int main (int argc, char **argv)
 			{
 				switch (arg [j])
 				{
+					case 'c': countTags = 1;               break;
 					case 'h': printUsage (stdout, 0); break;
 					case 'e': extensionFields = 1;         break;
 					case 'i': options |= TAG_IGNORECASE;   break;
 					case 'p': options |= TAG_PARTIALMATCH; break;
+					case 'F': options |= TAG_INPUTMATCH;   break;
+					case 'm': options |= TAG_SUBSTRINGMATCH; break;
 					case 'l': listTags (); actionSupplied = 1; break;
 					case 'n': allowPrintLineNumber = 1; break;
 					case 't':
+						closeMoreTagFiles ();
 						if (arg [j+1] != '\0')
 						{
 							TagFileName = arg + j + 1;
@@ -237,6 +956,64 @@ extern int main (int argc, char **argv)
 						else
 							printUsage(stderr, 1);
 						break;
+					case 'T':
+						if (arg [j+1] != '\0')
+						{
+							addTagFile (arg + j + 1);
+							j += strlen (arg + j + 1);
+						}
+						else if (i + 1 < argc)
+							addTagFile (argv [++i]);
+						else
+							printUsage(stderr, 1);
+						break;
+					case 'k':
+						if (arg [j+1] != '\0')
+						{
+							KindFilter = arg + j + 1;
+							j += strlen (KindFilter);
+						}
+						else if (i + 1 < argc)
+							KindFilter = argv [++i];
+						else
+							printUsage(stderr, 1);
+						break;
+#ifdef SERVER_SUPPORTED
+					case 'S':
+					case 'C':
+						{
+							const char opt = arg [j];
+							const char *path = NULL;
+							if (arg [j+1] != '\0')
+							{
+								path = arg + j + 1;
+								j += strlen (path);
+							}
+							else if (i + 1 < argc)
+								path = argv [++i];
+							else
+								printUsage(stderr, 1);
+							if (opt == 'S')
+								serveTags (path);
+							else
+								ServerName = path;
+						}
+						break;
+#endif
+					case 'j':
+						{
+							const char *n = NULL;
+							if (arg [j+1] != '\0')
+							{
+								n = arg + j + 1;
+								j += strlen (n);
+							}
+							else if (i + 1 < argc)
+								n = argv [++i];
+							if (n == NULL  ||  (jobCount = atoi (n)) < 1)
+								printUsage(stderr, 1);
+						}
+						break;
 					case 's':
 						SortOverride = 1;
 						++j;
@@ -263,6 +1040,8 @@ extern int main (int argc, char **argv)
 			}
 		}
 	}
+	closeTagFile ();
+	closeMoreTagFiles ();
 	if (! actionSupplied)
 	{
 		fprintf (stderr,
@@ -9,12 +9,26 @@
 /*
 *   INCLUDE FILES
 */
+#ifdef HAVE_CONFIG_H
+# include <config.h>
+#endif
+
 #include <stdlib.h>
 #include <string.h>
 #include <ctype.h>
 #include <stdio.h>
 #include <errno.h>
 #include <sys/types.h>  /* to declare off_t */
+#include <sys/stat.h>
+
+#if defined (HAVE_MMAP) && defined (HAVE_SYS_MMAN_H)
+# include <sys/mman.h>
+# define READTAGS_USE_MMAP
+#endif
+
+#ifdef HAVE_ZLIB
+# include <zlib.h>
+#endif
 
 #include "readtags.h"
 
@@ -23,6 +37,28 @@
 */
 #define TAB '\t'
 
+/* The name index is described in main/nameindex.c of ctags. */
+#define NAME_INDEX_MAGIC "CTAGSNDX"
+#define NAME_INDEX_SUFFIX ".idx"
+#define FOLD_INDEX_MAGIC "CTAGSFDX"
+#define FOLD_INDEX_SUFFIX ".fidx"
+#define INPUT_INDEX_MAGIC "CTAGSINX"
+#define INPUT_INDEX_SUFFIX ".iidx"
+#define NAME_FILTER_MAGIC "CTAGSBLM"
+#define NAME_FILTER_SUFFIX ".bflt"
+#define TRIGRAM_INDEX_MAGIC "CTAGSTRI"
+#define TRIGRAM_INDEX_SUFFIX ".tidx"
+#define NAME_INDEX_VERSION 1
+#define NAME_INDEX_HEADER_SIZE 32
+#define NAME_INDEX_ENTRY_SIZE 32
+#define NAME_INDEX_KEY_SIZE 16
+#define INPUT_INDEX_ENTRY_SIZE 16
+#define TRIGRAM_INDEX_ENTRY_SIZE 16
+
+/* The compressed tag file is described in main/compressed.c of ctags. */
+#define FRAME_FOOTER_SIZE 42
+#define FRAME_FORMAT_VERSION 1
+
 
 /*
 *   DATA DECLARATIONS
@@ -32,6 +68,46 @@ typedef struct {
 	char *buffer;
 } vstring;
 
+/* An entry of the name index, for a run of lines of the same name */
+typedef struct {
+		/* first bytes of the name, padded with NUL */
+	char key [NAME_INDEX_KEY_SIZE];
+		/* file position of the first line */
+	off_t pos;
+		/* number of lines before it, or of lines of the run in a fold
+		   index */
+	unsigned long ordinal;
+	size_t nameLength;
+} indexEntry;
+
+/* An input of the input index */
+typedef struct {
+		/* name of the input, not terminated */
+	const char *name;
+	size_t nameLength;
+		/* its runs of lines, from `firstRun' to before `endRun' */
+	unsigned long firstRun;
+	unsigned long endRun;
+} inputEntry;
+
+/* A name index of the tag file, or its input index, which has `count'
+   inputs and `lines' runs, or its name filter, which has `count' hashes
+   and 2^`lines' bits, or its trigram index, which has `count' trigrams
+   and `lines' runs */
+typedef struct {
+		/* NULL if the tag file has no index */
+	FILE *fp;
+		/* the index mapped in memory, or NULL */
+	const unsigned char *data;
+	size_t size;
+		/* how the tag file was sorted, and its size */
+	sortType sortMethod;
+	off_t tagFileSize;
+		/* number of entries, and of lines in the tag file */
+	unsigned long count;
+	unsigned long lines;
+} nameIndex;
+
 /* Information about current tag file */
 struct sTagFile {
 		/* has the file been opened and this structure initialized? */
@@ -46,10 +122,83 @@ struct sTagFile {
 	off_t pos;
 		/* size of tag file in seekable positions */
 	off_t size;
+		/* position where tagsNext() stops, set by tagsFirstInRange(),
+		   or 0 to read to the end of the file */
+	off_t limit;
 		/* last line read */
 	vstring line;
 		/* name of tag in last line read */
 	vstring name;
+		/* the tag file mapped in memory when it is searched more than
+		   once. The lines are then read in place, and copied to `line'
+		   only when an entry is made of one; `name' is not used. */
+	struct {
+				/* NULL if the tag file is read with `fp' */
+			const char *data;
+				/* size of `data' */
+			off_t size;
+				/* position of the next line to read */
+			off_t next;
+				/* last line read, without the end of line */
+			const char *line;
+			size_t length;
+				/* length of the name of tag at `line' */
+			size_t nameLength;
+				/* has `line' been copied to `line' of tagFile? */
+			short copied;
+				/* is `data' read into memory allocated with malloc? */
+			short loaded;
+				/* are there views into `data', which is then kept as
+				   long as the file is open? */
+			short pinned;
+	} map;
+		/* the name index of the tag file (TAGFILE.idx, written by ctags
+		   with --name-index), with which a sorted tag file is searched
+		   without bisecting its lines */
+	nameIndex index;
+		/* the fold index of the tag file (TAGFILE.fidx, written by ctags
+		   with --fold-index), with which a tag file sorted with case is
+		   searched ignoring case without reading all its lines */
+	nameIndex foldIndex;
+		/* the input index of the tag file (TAGFILE.iidx, written by ctags
+		   with --input-index), with which the lines of an input file are
+		   found without reading the others */
+	nameIndex inputIndex;
+		/* the name filter of the tag file (TAGFILE.bflt, written by ctags
+		   with --name-filter), with which a name which is not in the tag
+		   file is told without reading it */
+	nameIndex nameFilter;
+		/* the trigram index of the tag file (TAGFILE.tidx, written by
+		   ctags with --trigram-index), with which the names containing a
+		   string are found without reading all the lines */
+	nameIndex trigramIndex;
+		/* name of an input read from the input index when the index is
+		   not mapped */
+	vstring inputName;
+		/* the frames of a tag file compressed by ctags with --compress,
+		   decompressed one at a time as they are read. `pos', `size',
+		   and the positions of the indexes are the ones in the tag file
+		   decompressed. */
+	struct {
+				/* is the tag file compressed? */
+			short compressed;
+				/* number of frames */
+			unsigned long count;
+				/* offsets of the frames in the compressed tag file, and
+				   their positions in the decompressed one, with the end
+				   of the last one: count + 1 of each */
+			off_t *offset;
+			off_t *start;
+				/* the frame decompressed in `data', or count if none */
+			unsigned long current;
+			char *data;
+			size_t dataSize;
+				/* the compressed frame read for `data' */
+			unsigned char *input;
+			size_t inputSize;
+				/* position of the next line to read */
+			off_t next;
+	} frames;
 		/* defines tag search state */
 	struct {
 				/* file position of last match for tag */
@@ -62,6 +211,37 @@ struct sTagFile {
 			short partial;
 				/* ignoring case */
 			short ignorecase;
+				/* number of searches since the file was opened */
+			unsigned int count;
+				/* is the search going through the fold index? */
+			short folded;
+				/* the entry of the fold index of the last match, and
+				   the number of lines of its run after the match */
+			unsigned long foldEntry;
+			unsigned long foldLines;
+				/* matching the input file of the tags instead of their
+				   name? */
+			short input;
+				/* is the search going through the input index? */
+			short indexed;
+				/* the input of the last match in the index, its run,
+				   the end of its runs, and the number of lines of the
+				   run after the match */
+			unsigned long inputEntry;
+			unsigned long inputRun;
+			unsigned long inputRunEnd;
+			unsigned long inputLines;
+				/* matching the names containing the name searched for? */
+			short substring;
+				/* is the search going through the trigram index? */
+			short trigrams;
+				/* the runs of the trigram index having all the trigrams
+				   of the name, the one of the last match, and the number
+				   of lines of the run after the match */
+			unsigned long *candidates;
+			unsigned long candidateCount;
+			unsigned long candidate;
+			unsigned long trigramLines;
 	} search;
 		/* miscellaneous extension fields */
 	struct {
@@ -168,11 +348,496 @@ static void copyName (tagFile *const file)
 	file->name.buffer [length] = '\0';
 }
 
+static void unmapTagFile (tagFile *const file)
+{
+	if (file->map.data != NULL)
+	{
+		if (file->map.loaded)
+			free ((void *) file->map.data);
+#ifdef READTAGS_USE_MMAP
+		else
+			munmap ((void *) file->map.data, (size_t) file->map.size);
+#endif
+		file->map.data = NULL;
+		file->map.size = 0;
+		file->map.loaded = 0;
+	}
+}
+
+#ifdef READTAGS_USE_MMAP
+
+/* Map the SIZE bytes of the tag file in memory. Reads go through `fp'
+ * if it fails, or if the file is empty. */
+static void mapTagFile (tagFile *const file, const off_t size)
+{
+	void *data;
+
+	unmapTagFile (file);
+	if (size <= 0  ||  (off_t) (size_t) size != size)
+		return;
+	data = mmap (NULL, (size_t) size, PROT_READ, MAP_SHARED,
+				 fileno (file->fp), 0);
+	if (data != MAP_FAILED)
+	{
+#ifdef HAVE_MADVISE
+		/* A binary search touches a few pages here and there. */
+		madvise (data, (size_t) size, MADV_RANDOM);
+#endif
+		file->map.data = (const char *) data;
+		file->map.size = size;
+		file->map.next = 0;
+	}
+}
+#endif
+
+/* Like copyName, for the line at LINE in the mapped tag file */
+static size_t mappedNameLength (const char *const line, size_t length)
+{
+	const char *end;
+	const char *const nul = (const char *) memchr (line, '\0', length);
+
+	if (nul != NULL)
+		length = nul - line;
+	end = (const char *) memchr (line, '\t', length);
+	if (end == NULL)
+		end = (const char *) memchr (line, '\r', length);
+	return (end != NULL)? (size_t) (end - line): length;
+}
+
+static int readMappedTagLine (tagFile *const file)
+{
+	const char *const line = file->map.data + file->map.next;
+	const char *newline;
+	size_t length;
+
+	if (file->map.next >= file->map.size)
+		return 0;
+
+	length = (size_t) (file->map.size - file->map.next);
+	newline = (const char *) memchr (line, '\n', length);
+	if (newline != NULL)
+		length = newline - line;
+
+	file->pos = file->map.next;
+	file->map.next += length + (newline != NULL);
+	while (length > 0  &&  line [length - 1] == '\r')
+		--length;
+
+	file->map.line = line;
+	file->map.length = length;
+	file->map.nameLength = mappedNameLength (line, length);
+	file->map.copied = 0;
+	return 1;
+}
+
+/* Return the last line read, copying it from the mapping if needed. */
+static char *lineBuffer (tagFile *const file)
+{
+	if (file->map.data != NULL  &&  ! file->map.copied)
+	{
+		while (file->map.length >= file->line.size)
+			growString (&file->line);
+		memcpy (file->line.buffer, file->map.line, file->map.length);
+		file->line.buffer [file->map.length] = '\0';
+		file->map.copied = 1;
+	}
+	return file->line.buffer;
+}
+
+static unsigned long getNumber (const unsigned char *const bytes, unsigned int size)
+{
+	unsigned long n = 0;
+	while (size > 0)
+		n = (n << 8) | bytes [--size];
+	return n;
+}
+
+static off_t getOffset (const unsigned char *const bytes)
+{
+	off_t n = 0;
+	unsigned int i = 8;
+	while (i > 0)
+		n = (n << 8) | bytes [--i];
+	return n;
+}
+
+static void closeFrames (tagFile *const file)
+{
+	free (file->frames.offset);
+	free (file->frames.start);
+	free (file->frames.data);
+	free (file->frames.input);
+	memset (&file->frames, 0, sizeof (file->frames));
+}
+
+#ifdef HAVE_ZLIB
+
+static int growBuffer (void *buffer, size_t *size, size_t needed)
+{
+	void **const p = (void **) buffer;
+	void *grown;
+
+	if (*size >= needed)
+		return 1;
+	grown = realloc (*p, needed);
+	if (grown == NULL)
+		return 0;
+	*p = grown;
+	*size = needed;
+	return 1;
+}
+
+/* Decompress the LENGTH bytes of INPUT, gzip members, into the `data' of
+ * the frames, and return the length of the contents, or -1 on error.
+ * EXPECTED is the length, or 0 if it is not known. */
+static long inflateFrame (tagFile *const file, const unsigned char *input,
+						  size_t length, size_t expected)
+{
+	z_stream z;
+	int r;
+	size_t used = 0;
+
+	memset (&z, 0, sizeof (z));
+	if (inflateInit2 (&z, 15 + 16) != Z_OK)
+		return -1;
+	z.next_in = (Bytef *) input;
+	z.avail_in = (uInt) length;
+	do
+	{
+		if (! growBuffer (&file->frames.data, &file->frames.dataSize,
+						  expected? expected + 1: used + length * 4 + 4096))
+		{
+			r = Z_MEM_ERROR;
+			break;
+		}
+		z.next_out = (Bytef *) file->frames.data + used;
+		z.avail_out = (uInt) (file->frames.dataSize - used);
+		r = inflate (&z, Z_NO_FLUSH);
+		used = (size_t) ((char *) z.next_out - file->frames.data);
+		/* The members of a file made by "cat a.gz b.gz" */
+		if (r == Z_STREAM_END  &&  z.avail_in > 0)
+			r = inflateReset (&z);
+	} while (r == Z_OK  &&  (z.avail_in > 0  ||  z.avail_out == 0));
+	inflateEnd (&z);
+
+	if (r != Z_STREAM_END  ||  (expected > 0  &&  used != expected))
+		return -1;
+	return (long) used;
+}
+
+static int readFully (tagFile *const file, off_t offset, size_t length)
+{
+	if (! growBuffer (&file->frames.input, &file->frames.inputSize, length + 1))
+		return 0;
+	return (fseek (file->fp, offset, SEEK_SET) == 0
+			&&  fread (file->frames.input, 1, length, file->fp) == length);
+}
+
+/* Parse the footer and the frame index of the COMPRESSEDSIZE bytes of the
+ * tag file. */
+static int readFrameIndex (tagFile *const file, off_t compressedSize)
+{
+	static const unsigned char member [] = {
+		0x1f, 0x8b, 8, 4, 0, 0, 0, 0, 0, 255,
+	};
+	static const unsigned char trailer [10] = { 0x03, 0x00, };
+	const unsigned char *p, *end;
+	off_t indexOffset;
+	unsigned long count, i = 0;
+
+	if (compressedSize < FRAME_FOOTER_SIZE
+		||  ! readFully (file, compressedSize - FRAME_FOOTER_SIZE, FRAME_FOOTER_SIZE))
+		return 0;
+	p = file->frames.input;
+	if (memcmp (p, member, sizeof (member)) != 0
+		||  getNumber (p + 10, 2) != 20  ||  p [12] != 'C'  ||  p [13] != 'T'
+		||  getNumber (p + 14, 2) != 16
+		||  memcmp (p + 32, trailer, sizeof (trailer)) != 0
+		||  getNumber (p + 28, 4) != FRAME_FORMAT_VERSION)
+		return 0;
+	indexOffset = getOffset (p + 16);
+	count = getNumber (p + 24, 4);
+	if (indexOffset < 0  ||  indexOffset > compressedSize - FRAME_FOOTER_SIZE)
+		return 0;
+
+	file->frames.offset = (off_t *) calloc (count + 1, sizeof (off_t));
+	file->frames.start = (off_t *) calloc (count + 1, sizeof (off_t));
+	if (file->frames.offset == NULL  ||  file->frames.start == NULL
+		||  ! readFully (file, indexOffset,
+						 (size_t) (compressedSize - FRAME_FOOTER_SIZE - indexOffset)))
+		return 0;
+
+	p = file->frames.input;
+	end = p + (compressedSize - FRAME_FOOTER_SIZE - indexOffset);
+	while (p < end)
+	{
+		size_t length;
+		const unsigned char *entry;
+
+		if (end - p < 16 + (long) sizeof (trailer)
+			||  memcmp (p, member, sizeof (member)) != 0
+			||  p [12] != 'C'  ||  p [13] != 'I')
+			return 0;
+		length = getNumber (p + 14, 2);
+		if (getNumber (p + 10, 2) != length + 4  ||  length % 8 != 0
+			||  (size_t) (end - p) < 16 + length + sizeof (trailer))
+			return 0;
+		for (entry = p + 16; entry < p + 16 + length; entry += 8, i++)
+		{
+			if (i >= count)
+				return 0;
+			file->frames.offset [i + 1] = file->frames.offset [i]
+				+ (off_t) getNumber (entry, 4);
+			file->frames.start [i + 1] = file->frames.start [i]
+				+ (off_t) getNumber (entry + 4, 4);
+		}
+		p += 16 + length + sizeof (trailer);
+	}
+	if (i != count  ||  file->frames.offset [count] != indexOffset)
+		return 0;
+
+	file->frames.count = count;
+	file->frames.current = count;
+	return 1;
+}
+
+/* Are the contents of the tag file gzip members? If they have no frame
+ * index, they are decompressed into a single frame now. Return 0 if the
+ * tag file is broken. */
+static int openFrames (tagFile *const file)
+{
+	unsigned char magic [2];
+	const off_t compressedSize = file->size;
+	long length;
+
+	if (fread (magic, 1, sizeof (magic), file->fp) != sizeof (magic)
+		||  magic [0] != 0x1f  ||  magic [1] != 0x8b)
+	{
+		rewind (file->fp);
+		return 1;
+	}
+
+	file->frames.compressed = 1;
+	if (! readFrameIndex (file, compressedSize))
+	{
+		closeFrames (file);
+		file->frames.compressed = 1;
+		file->frames.offset = (off_t *) calloc (2, sizeof (off_t));
+		file->frames.start = (off_t *) calloc (2, sizeof (off_t));
+		if (file->frames.offset == NULL  ||  file->frames.start == NULL
+			||  (off_t) (size_t) compressedSize != compressedSize
+			||  ! readFully (file, 0, (size_t) compressedSize))
+			return 0;
+		length = inflateFrame (file, file->frames.input, (size_t) compressedSize, 0);
+		if (length < 0)
+			return 0;
+		file->frames.count = 1;
+		file->frames.current = 0;
+		file->frames.offset [1] = compressedSize;
+		file->frames.start [1] = (off_t) length;
+	}
+	file->size = file->frames.start [file->frames.count];
+	file->frames.next = 0;
+	return 1;
+}
+
+/* Decompress the frame F into `data' of the frames, unless it is there. */
+static int loadFrame (tagFile *const file, unsigned long f)
+{
+	const size_t length = (size_t) (file->frames.offset [f + 1] - file->frames.offset [f]);
+	const size_t expected = (size_t) (file->frames.start [f + 1] - file->frames.start [f]);
+
+	if (f == file->frames.current)
+		return 1;
+	file->frames.current = file->frames.count;
+	if (! readFully (file, file->frames.offset [f], length)
+		||  inflateFrame (file, file->frames.input, length, expected) < 0)
+		return 0;
+	file->frames.current = f;
+	return 1;
+}
+
+/* The frame holding the position POS, which is before the end */
+static unsigned long frameAt (tagFile *const file, off_t pos)
+{
+	unsigned long low = 0, high = file->frames.count;
+
+	if (file->frames.current < file->frames.count
+		&&  file->frames.start [file->frames.current] <= pos
+		&&  pos < file->frames.start [file->frames.current + 1])
+		return file->frames.current;
+	while (high - low > 1)
+	{
+		const unsigned long middle = low + (high - low) / 2;
+		if (file->frames.start [middle] <= pos)
+			low = middle;
+		else
+			high = middle;
+	}
+	return low;
+}
+
+/* Like readMappedTagLine, for a compressed tag file. The lines are copied
+ * into `line', as a frame may be replaced by another one before the line
+ * is used. A frame ends with a whole line. */
+static int readFramedTagLine (tagFile *const file)
+{
+	const off_t pos = file->frames.next;
+	unsigned long f;
+	const char *line, *newline;
+	size_t length;
+
+	if (pos >= file->size)
+		return 0;
+	f = frameAt (file, pos);
+	if (! loadFrame (file, f))
+	{
+		fprintf (stderr, "readTagLine: broken frame in the compressed tag file\n");
+		return 0;
+	}
+
+	line = file->frames.data + (pos - file->frames.start [f]);
+	length = (size_t) (file->frames.start [f + 1] - pos);
+	newline = (const char *) memchr (line, '\n', length);
+	if (newline != NULL)
+		length = newline - line;
+
+	file->pos = pos;
+	file->frames.next = pos + (off_t) length + (newline != NULL);
+	while (length > 0  &&  line [length - 1] == '\r')
+		--length;
+
+	while (length >= file->line.size)
+		growString (&file->line);
+	memcpy (file->line.buffer, line, length);
+	file->line.buffer [length] = '\0';
+	copyName (file);
+	return 1;
+}
+
+/* Decompress all the frames into DATA, of the size of the tag file. */
+static int readAllFrames (tagFile *const file, char *const data)
+{
+	unsigned long f;
+
+	for (f = 0; f < file->frames.count; f++)
+	{
+		if (! loadFrame (file, f))
+			return 0;
+		memcpy (data + file->frames.start [f], file->frames.data,
+				(size_t) (file->frames.start [f + 1] - file->frames.start [f]));
+	}
+	return 1;
+}
+
+#else
+
+static int openFrames (tagFile *const file)
+{
+	(void) file;
+	return 1;
+}
+
+static int readFramedTagLine (tagFile *const file)
+{
+	(void) file;
+	return 0;
+}
+
+static int readAllFrames (tagFile *const file, char *const data)
+{
+	(void) file;
+	(void) data;
+	return 0;
+}
+
+#endif
+
+static off_t tellTagFile (tagFile *const file)
+{
+	if (file->map.data != NULL)
+		return file->map.next;
+	if (file->frames.compressed)
+		return file->frames.next;
+	return ftell (file->fp);
+}
+
+static int seekTagFile (tagFile *const file, const off_t pos)
+{
+	if (file->map.data != NULL)
+	{
+		if (pos < 0  ||  pos > file->map.size)
+			return -1;
+		file->map.next = pos;
+		return 0;
+	}
+	if (file->frames.compressed)
+	{
+		if (pos < 0  ||  pos > file->size)
+			return -1;
+		file->frames.next = pos;
+		return 0;
+	}
+	return fseek (file->fp, pos, SEEK_SET);
+}
+
+/* Keep the whole tag file in memory for views into it, mapping it or else
+ * reading it, and go on reading it where it was. The memory is not
+ * released before the file is closed. */
+static int pinTagFile (tagFile *const file)
+{
+	const off_t pos = tellTagFile (file);
+
+	if (file->map.pinned)
+		return 1;
+#ifdef READTAGS_USE_MMAP
+	if (file->map.data == NULL  &&  ! file->frames.compressed)
+		mapTagFile (file, file->size);
+#endif
+	if (file->map.data == NULL  &&  file->size > 0
+		&&  (off_t) (size_t) file->size == file->size)
+	{
+		char *data = (char *) malloc ((size_t) file->size);
+		if (data == NULL)
+			return 0;
+		if (file->frames.compressed)
+		{
+			if (! readAllFrames (file, data))
+			{
+				free (data);
+				return 0;
+			}
+		}
+		else
+		{
+			rewind (file->fp);
+			if (fread (data, 1, (size_t) file->size, file->fp) != (size_t) file->size)
+			{
+				free (data);
+				return 0;
+			}
+		}
+		file->map.data = data;
+		file->map.size = file->size;
+		file->map.loaded = 1;
+	}
+	if (file->map.data == NULL)
+		return 0;
+	file->map.next = pos;
+	file->map.pinned = 1;
+	return 1;
+}
+
 static int readTagLineRaw (tagFile *const file)
 {
 	int result = 1;
 	int reReadLine;
 
+	if (file->map.data != NULL)
+		return readMappedTagLine (file);
+	if (file->frames.compressed)
+		return readFramedTagLine (file);
+
 	/*  If reading the line places any character other than a null or a
 	 *  newline at the last character position in the buffer (one less than
 	 *  the buffer size), then we must resize the buffer and reattempt to read
@@ -224,7 +889,9 @@ static int readTagLine (tagFile *const file)
 	do
 	{
 		result = readTagLineRaw (file);
-	} while (result && *file->name.buffer == '\0');
+	} while (result && ((file->map.data != NULL)
+						? file->map.nameLength == 0
+						: *file->name.buffer == '\0'));
 	return result;
 }
 
@@ -310,7 +977,7 @@ static unsigned int countContinuousBackslashesBackward(const char *from,
 static void parseTagLine (tagFile *file, tagEntry *const entry)
 {
 	int i;
-	char *p = file->line.buffer;
+	char *p = lineBuffer (file);
 	char *tab = strchr (p, TAB);
 
 	entry->fields.list = NULL;
@@ -377,6 +1044,95 @@ static void parseTagLine (tagFile *file, tagEntry *const entry)
 	}
 }
 
+static void setString (tagString *const string, const char *const value,
+					   const char *const end)
+{
+	string->value = value;
+	string->length = (size_t) (end - value);
+}
+
+/* Like atol, for the digits between P and END */
+static unsigned long parseNumber (const char *p, const char *const end)
+{
+	unsigned long n = 0;
+	while (p < end  &&  isdigit ((int) *(unsigned char*) p))
+		n = n * 10 + (unsigned long) (*p++ - '0');
+	return n;
+}
+
+/* Like parseTagLine, for the last line read in the pinned tag file */
+static void parseTagView (tagFile *const file, tagEntryView *const view)
+{
+	const char *p = file->map.line;
+	const char *const end = p + file->map.length;
+	const char *tab = (const char *) memchr (p, TAB, end - p);
+
+	memset (view, 0, sizeof (*view));
+	setString (&view->name, p, tab? tab: end);
+	if (tab == NULL)
+		return;
+
+	p = tab + 1;
+	tab = (const char *) memchr (p, TAB, end - p);
+	setString (&view->file, p, tab? tab: end);
+	if (tab == NULL)
+		return;
+
+	p = tab + 1;
+	view->address.pattern.value = p;
+	if (p < end  &&  (*p == '/'  ||  *p == '?'))
+	{
+		const char delimiter = *p;
+		do
+		{
+			p = (const char *) memchr (p + 1, delimiter, end - p - 1);
+		} while (p != NULL
+			 &&  isOdd (countContinuousBackslashesBackward (p - 1,
+									view->address.pattern.value)));
+		/* An invalid pattern runs to the end of the line. */
+		p = (p == NULL)? end: p + 1;
+	}
+	else if (p < end  &&  isdigit ((int) *(unsigned char*) p))
+	{
+		view->address.lineNumber = parseNumber (p, end);
+		while (p < end  &&  isdigit ((int) *(unsigned char*) p))
+			++p;
+	}
+	setString (&view->address.pattern, view->address.pattern.value, p);
+
+	if (end - p >= 2  &&  p [0] == ';'  &&  p [1] == '"')
+	{
+		const char *field = p + 2;
+		tagString key, value;
+
+		setString (&view->fields, field, end);
+		while (field < end)
+		{
+			const char *const next = (const char *) memchr (field, TAB, end - field);
+			const char *const fieldEnd = next? next: end;
+			const char *const colon = (const char *) memchr (field, ':', fieldEnd - field);
+
+			if (colon == NULL)
+			{
+				if (field < fieldEnd)
+					setString (&view->kind, field, fieldEnd);
+			}
+			else
+			{
+				setString (&key, field, colon);
+				setString (&value, colon + 1, fieldEnd);
+				if (key.length == 4  &&  strncmp (key.value, "kind", 4) == 0)
+					view->kind = value;
+				else if (key.length == 4  &&  strncmp (key.value, "file", 4) == 0)
+					view->fileScope = 1;
+				else if (key.length == 4  &&  strncmp (key.value, "line", 4) == 0)
+					view->address.lineNumber = parseNumber (value.value, fieldEnd);
+			}
+			field = fieldEnd + 1;
+		}
+	}
+}
+
 static char *duplicate (const char *str)
 {
 	char *result = NULL;
@@ -391,7 +1147,7 @@ static char *duplicate (const char *str)
 
 static void readPseudoTags (tagFile *const file, tagFileInfo *const info)
 {
-	fpos_t startOfLine;
+	off_t startOfLine = 0;
 	const size_t prefixLength = strlen (PseudoTagPrefix);
 	if (info != NULL)
 	{
@@ -404,10 +1160,10 @@ static void readPseudoTags (tagFile *const file, tagFileInfo *const info)
 	}
 	while (1)
 	{
-		fgetpos (file->fp, &startOfLine);
+		startOfLine = tellTagFile (file);
 		if (! readTagLine (file))
 			break;
-		if (strncmp (file->line.buffer, PseudoTagPrefix, prefixLength) != 0)
+		if (strncmp (lineBuffer (file), PseudoTagPrefix, prefixLength) != 0)
 			break;
 		else
 		{
@@ -439,23 +1195,99 @@ static void readPseudoTags (tagFile *const file, tagFileInfo *const info)
 			}
 		}
 	}
-	fsetpos (file->fp, &startOfLine);
+	seekTagFile (file, startOfLine);
 }
 
 static void gotoFirstLogicalTag (tagFile *const file)
 {
-	fpos_t startOfLine;
+	off_t startOfLine = 0;
 	const size_t prefixLength = strlen (PseudoTagPrefix);
-	rewind (file->fp);
+	seekTagFile (file, 0);
 	while (1)
 	{
-		fgetpos (file->fp, &startOfLine);
+		startOfLine = tellTagFile (file);
 		if (! readTagLine (file))
 			break;
-		if (strncmp (file->line.buffer, PseudoTagPrefix, prefixLength) != 0)
+		if (strncmp (lineBuffer (file), PseudoTagPrefix, prefixLength) != 0)
 			break;
 	}
-	fsetpos (file->fp, &startOfLine);
+	seekTagFile (file, startOfLine);
+}
+
+/* Does the size of an index match its HEADER? The names of the input
+ * index, and the lists of the trigram index, come after their entries. */
+static int isIndexSizeValid (const unsigned char *const header,
+							 const char *const magic, const off_t size)
+{
+	const off_t count = (off_t) getNumber (header + 24, 4);
+
+	if (strcmp (magic, NAME_FILTER_MAGIC) == 0)
+	{
+		const unsigned long log2 = getNumber (header + 28, 4);
+		return count > 0  &&  log2 >= 3  &&  log2 <= 31  &&
+			(off_t) NAME_INDEX_HEADER_SIZE + ((off_t) 1 << (log2 - 3)) == size;
+	}
+	if (strcmp (magic, TRIGRAM_INDEX_MAGIC) == 0)
+		return (off_t) NAME_INDEX_HEADER_SIZE + (off_t) TRIGRAM_INDEX_ENTRY_SIZE
+			* (count + (off_t) getNumber (header + 28, 4)) <= size;
+	if (strcmp (magic, INPUT_INDEX_MAGIC) == 0)
+		return (off_t) NAME_INDEX_HEADER_SIZE + (off_t) INPUT_INDEX_ENTRY_SIZE
+			* (count + (off_t) getNumber (header + 28, 4)) <= size;
+	return (off_t) NAME_INDEX_HEADER_SIZE + (off_t) NAME_INDEX_ENTRY_SIZE
+		* count == size;
+}
+
+static void closeNameIndex (nameIndex *const index)
+{
+#ifdef READTAGS_USE_MMAP
+	if (index->data != NULL)
+		munmap ((void *) index->data, index->size);
+#endif
+	if (index->fp != NULL)
+		fclose (index->fp);
+	memset (index, 0, sizeof (*index));
+}
+
+/* Open the name index of the tag file at FILEPATH, which is named after it
+ * with SUFFIX and starts with MAGIC. It is not used if it is older than
+ * the tag file, or was not written for it. */
+static void openNameIndex (tagFile *const file, nameIndex *const index,
+						   const char *const filePath,
+						   const char *const suffix, const char *const magic)
+{
+	unsigned char header [NAME_INDEX_HEADER_SIZE];
+	struct stat tagStatus, indexStatus;
+	char *const indexPath = (char *) malloc (strlen (filePath) + strlen (suffix) + 1);
+	FILE *fp;
+
+	if (indexPath == NULL)
+		return;
+	strcpy (indexPath, filePath);
+	strcat (indexPath, suffix);
+	fp = fopen (indexPath, "rb");
+	free (indexPath);
+	if (fp == NULL)
+		return;
+	/* The entries are read one by one until the index is mapped. */
+	setvbuf (fp, NULL, _IOFBF, NAME_INDEX_ENTRY_SIZE);
+
+	if (fread (header, 1, sizeof (header), fp) == sizeof (header)  &&
+		memcmp (header, magic, 8) == 0  &&
+		getNumber (header + 8, 4) == NAME_INDEX_VERSION  &&
+		fstat (fileno (file->fp), &tagStatus) == 0  &&
+		fstat (fileno (fp), &indexStatus) == 0  &&
+		indexStatus.st_mtime >= tagStatus.st_mtime  &&
+		isIndexSizeValid (header, magic, indexStatus.st_size))
+	{
+		index->fp = fp;
+		index->size = (size_t) indexStatus.st_size;
+		index->sortMethod = (sortType) getNumber (header + 12, 4);
+		index->tagFileSize = getOffset (header + 16);
+		index->count = getNumber (header + 24, 4);
+		index->lines = getNumber (header + 28, 4);
+	}
+	else
+		fclose (fp);
 }
 
 static tagFile *initialize (const char *const filePath, tagFileInfo *const info)
@@ -480,7 +1312,28 @@ static tagFile *initialize (const char *const filePath, tagFileInfo *const info)
 			fseek (result->fp, 0, SEEK_END);
 			result->size = ftell (result->fp);
 			rewind (result->fp);
+			if (! openFrames (result))
+			{
+				closeFrames (result);
+				fclose (result->fp);
+				free (result->line.buffer);
+				free (result->name.buffer);
+				free (result->fields.list);
+				free (result);
+				info->status.error_number = EINVAL;
+				return NULL;
+			}
 			readPseudoTags (result, info);
+			openNameIndex (result, &result->index, filePath,
+						   NAME_INDEX_SUFFIX, NAME_INDEX_MAGIC);
+			openNameIndex (result, &result->foldIndex, filePath,
+						   FOLD_INDEX_SUFFIX, FOLD_INDEX_MAGIC);
+			openNameIndex (result, &result->inputIndex, filePath,
+						   INPUT_INDEX_SUFFIX, INPUT_INDEX_MAGIC);
+			openNameIndex (result, &result->nameFilter, filePath,
+						   NAME_FILTER_SUFFIX, NAME_FILTER_MAGIC);
+			openNameIndex (result, &result->trigramIndex, filePath,
+						   TRIGRAM_INDEX_SUFFIX, TRIGRAM_INDEX_MAGIC);
 			info->status.opened = 1;
 			result->initialized = 1;
 		}
@@ -490,10 +1343,19 @@ static tagFile *initialize (const char *const filePath, tagFileInfo *const info)
 
 static void terminate (tagFile *const file)
 {
+	unmapTagFile (file);
+	closeNameIndex (&file->index);
+	closeNameIndex (&file->foldIndex);
+	closeNameIndex (&file->inputIndex);
+	closeNameIndex (&file->nameFilter);
+	closeNameIndex (&file->trigramIndex);
+	closeFrames (file);
 	fclose (file->fp);
 
 	free (file->line.buffer);
 	free (file->name.buffer);
+	if (file->inputName.buffer != NULL)
+		free (file->inputName.buffer);
 	free (file->fields.list);
 
 	if (file->program.author != NULL)
@@ -506,6 +1368,8 @@ static void terminate (tagFile *const file)
 		free (file->program.version);
 	if (file->search.name != NULL)
 		free (file->search.name);
+	if (file->search.candidates != NULL)
+		free (file->search.candidates);
 
 	memset (file, 0, sizeof (tagFile));
 
@@ -519,6 +1383,8 @@ static tagResult readNext (tagFile *const file, tagEntry *const entry)
 		result = TagFailure;
 	else if (! readTagLine (file))
 		result = TagFailure;
+	else if (file->limit > 0  &&  file->pos >= file->limit)
+		result = TagFailure;
 	else
 	{
 		if (entry != NULL)
@@ -546,7 +1412,7 @@ static const char *readFieldValue (
 static int readTagLineSeek (tagFile *const file, const off_t pos)
 {
 	int result = 0;
-	if (fseek (file->fp, pos, SEEK_SET) == 0)
+	if (seekTagFile (file, pos) == 0)
 	{
 		result = readTagLine (file);  /* read probable partial line */
 		if (pos > 0  &&  result)
@@ -555,10 +1421,43 @@ static int readTagLineSeek (tagFile *const file, const off_t pos)
 	return result;
 }
 
+/* Compare the name searched for with the name at NAME, LENGTH bytes
+ * long and not terminated, as nameComparison does with the copied one. */
+static int mappedNameComparison (tagFile *const file,
+								 const char *const name, const size_t length)
+{
+	const char *const s = file->search.name;
+	const size_t n = file->search.nameLength;
+	size_t i;
+	int result = 0;
+
+	if (file->search.partial  &&  n == 0  &&  ! file->search.ignorecase)
+		return 0;
+
+	for (i = 0  ;  ; ++i)
+	{
+		const char c1 = s [i];
+		const char c2 = (i < length)? name [i]: '\0';
+
+		if (file->search.ignorecase)
+			result = toupper ((int) c1) - toupper ((int) c2);
+		else
+			result = (int) (unsigned char) c1 - (int) (unsigned char) c2;
+		if (result != 0  ||  c1 == '\0'  ||  c2 == '\0')
+			break;
+		if (file->search.partial  &&  i + 1 == n)
+			break;
+	}
+	return result;
+}
+
 static int nameComparison (tagFile *const file)
 {
 	int result;
-	if (file->search.ignorecase)
+	if (file->map.data != NULL)
+		result = mappedNameComparison (file, file->map.line,
+									   file->map.nameLength);
+	else if (file->search.ignorecase)
 	{
 		if (file->search.partial)
 			result = strnuppercmp (file->search.name, file->name.buffer,
@@ -653,35 +1552,953 @@ static tagResult findBinary (tagFile *const file)
 	return result;
 }
 
-static tagResult findSequential (tagFile *const file)
+/* The input file of the tag in the last line read, not terminated */
+static const char *lineInput (tagFile *const file, size_t *const length)
 {
-	tagResult result = TagFailure;
-	if (file->initialized)
+	const char *line, *input, *end;
+	size_t lineLength, nameLength;
+
+	if (file->map.data != NULL)
 	{
-		while (result == TagFailure  &&  readTagLine (file))
+		line = file->map.line;
+		lineLength = file->map.length;
+		nameLength = file->map.nameLength;
+	}
+	else
+	{
+		line = file->line.buffer;
+		lineLength = strlen (line);
+		nameLength = strlen (file->name.buffer);
+	}
+	if (nameLength >= lineLength  ||  line [nameLength] != TAB)
+	{
+		*length = 0;
+		return line + lineLength;
+	}
+	input = line + nameLength + 1;
+	end = (const char *) memchr (input, TAB, line + lineLength - input);
+	*length = (end != NULL)? (size_t) (end - input): (size_t) (line + lineLength - input);
+	return input;
+}
+
+/* Does NAME, LENGTH bytes long and not terminated, contain the name
+ * searched for? */
+static int containsSearchName (tagFile *const file,
+							   const char *const name, const size_t length)
+{
+	const char *const s = file->search.name;
+	const size_t n = file->search.nameLength;
+	size_t i, j;
+
+	for (i = 0  ;  i + n <= length  ;  ++i)
+	{
+		for (j = 0  ;  j < n  ;  ++j)
 		{
-			if (nameComparison (file) == 0)
-				result = TagSuccess;
+			if (file->search.ignorecase
+				? toupper ((int) s [j]) != toupper ((int) name [i + j])
+				: s [j] != name [i + j])
+				break;
 		}
+		if (j == n)
+			return 1;
 	}
-	return result;
+	return 0;
 }
 
-static tagResult find (tagFile *const file, tagEntry *const entry,
-					   const char *const name, const int options)
+/* Compare the name searched for with the input file of the tag in the
+ * last line read, or its name. For a substring match, 0 is returned if
+ * it is contained, and 1 if not. */
+static int matchComparison (tagFile *const file)
 {
-	tagResult result;
-	if (file->search.name != NULL)
-		free (file->search.name);
+	if (file->search.input)
+	{
+		size_t length;
+		const char *const input = lineInput (file, &length);
+		if (file->search.substring)
+			return containsSearchName (file, input, length)? 0: 1;
+		return mappedNameComparison (file, input, length);
+	}
+	if (file->search.substring)
+	{
+		if (file->map.data != NULL)
+			return containsSearchName (file, file->map.line,
+									   file->map.nameLength)? 0: 1;
+		return containsSearchName (file, file->name.buffer,
+								   strlen (file->name.buffer))? 0: 1;
+	}
+	return nameComparison (file);
+}
+
+static tagResult findSequential (tagFile *const file)
+{
+	tagResult result = TagFailure;
+	if (file->initialized)
+	{
+		while (result == TagFailure  &&  readTagLine (file))
+		{
+			if (matchComparison (file) == 0)
+				result = TagSuccess;
+		}
+	}
+	return result;
+}
+
+static void mapNameIndex (tagFile *const file, nameIndex *const index)
+{
+#ifdef READTAGS_USE_MMAP
+	/* Like the tag file, the index is mapped from the second search on. */
+	if (index->data == NULL  &&  file->search.count > 1)
+	{
+		void *data = mmap (NULL, index->size, PROT_READ, MAP_SHARED,
+						   fileno (index->fp), 0);
+		if (data != MAP_FAILED)
+			index->data = (const unsigned char *) data;
+	}
+#else
+	(void) file;
+	(void) index;
+#endif
+}
+
+/* Can INDEX be used for the search which is started? */
+static int useNameIndex (tagFile *const file, nameIndex *const index)
+{
+	const size_t prefixLength = strlen (PseudoTagPrefix);
+	const size_t n = file->search.nameLength;
+
+	/* The pseudo tags are not in the index. */
+	if (index->fp == NULL  ||
+		index->sortMethod != file->sortMethod  ||
+		index->tagFileSize != file->size  ||
+		strncmp (file->search.name, PseudoTagPrefix, prefixLength) == 0  ||
+		(file->search.partial  &&
+		 strncmp (file->search.name, PseudoTagPrefix, n < prefixLength? n: prefixLength) == 0))
+		return 0;
+	mapNameIndex (file, index);
+	return 1;
+}
+
+/* Can the input index be used for the search which is started? Its
+ * inputs are sorted with case. */
+static int useInputIndex (tagFile *const file)
+{
+	nameIndex *const index = &file->inputIndex;
+
+	if (index->fp == NULL  ||  index->tagFileSize != file->size  ||
+		file->search.ignorecase  ||  file->search.substring)
+		return 0;
+	mapNameIndex (file, index);
+	return 1;
+}
+
+/* Read LENGTH bytes at OFFSET in INDEX, into BUFFER if it is not mapped. */
+static const unsigned char *readIndexBytes (nameIndex *const index,
+											const size_t offset, const size_t length,
+											void *const buffer)
+{
+	if (offset > index->size  ||  length > index->size - offset)
+		return NULL;
+	if (index->data != NULL)
+		return index->data + offset;
+	if (fseek (index->fp, (long) offset, SEEK_SET) == 0  &&
+		fread (buffer, 1, length, index->fp) == length)
+		return (const unsigned char *) buffer;
+	return NULL;
+}
+
+static int readIndexEntry (nameIndex *const index, const unsigned long i,
+						   indexEntry *const entry)
+{
+	unsigned char buffer [NAME_INDEX_ENTRY_SIZE];
+	const unsigned char *const bytes = readIndexBytes (index,
+		NAME_INDEX_HEADER_SIZE + NAME_INDEX_ENTRY_SIZE * (size_t) i,
+		NAME_INDEX_ENTRY_SIZE, buffer);
+
+	if (bytes == NULL)
+		return 0;
+
+	memcpy (entry->key, bytes, NAME_INDEX_KEY_SIZE);
+	entry->pos = getOffset (bytes + 16);
+	entry->ordinal = getNumber (bytes + 24, 4);
+	entry->nameLength = (size_t) getNumber (bytes + 28, 4);
+	return 1;
+}
+
+/* Does the name searched for start with the key of an entry, which
+ * then does not tell how the names compare? */
+static int isKeyPrefixOfSearch (tagFile *const file, const indexEntry *const entry)
+{
+	size_t i;
+
+	if (file->search.partial  &&  file->search.nameLength <= NAME_INDEX_KEY_SIZE)
+		return 0;
+	for (i = 0  ;  i < NAME_INDEX_KEY_SIZE  ;  ++i)
+	{
+		const int c1 = (unsigned char) file->search.name [i];
+		const int c2 = (unsigned char) entry->key [i];
+		if (c1 == '\0'  ||  (file->search.ignorecase
+							  ? toupper (c1) != toupper (c2): c1 != c2))
+			return 0;
+	}
+	return 1;
+}
+
+/* Compare the name searched for with the name of ENTRY, as nameComparison
+ * does. The name is read in the tag file only if it is longer than the
+ * key, and the name searched for starts with the key. */
+static int indexComparison (tagFile *const file, const indexEntry *const entry)
+{
+	const size_t keyLength = (entry->nameLength < NAME_INDEX_KEY_SIZE)
+		? entry->nameLength: NAME_INDEX_KEY_SIZE;
+	int result = mappedNameComparison (file, entry->key, keyLength);
+
+	if (entry->nameLength > NAME_INDEX_KEY_SIZE  &&
+		isKeyPrefixOfSearch (file, entry)  &&
+		seekTagFile (file, entry->pos) == 0  &&  readTagLine (file))
+		result = nameComparison (file);
+	return result;
+}
+
+/* Find the first entry of INDEX whose name comes after the name searched
+ * for or, unless AFTER, matches it. */
+static int searchNameIndex (tagFile *const file, nameIndex *const index,
+							const int after, unsigned long *const found)
+{
+	unsigned long low = 0;
+	unsigned long high = index->count;
+	while (low < high)
+	{
+		const unsigned long middle = low + (high - low) / 2;
+		indexEntry entry;
+		int comp;
+
+		if (! readIndexEntry (index, middle, &entry))
+			return 0;
+		comp = indexComparison (file, &entry);
+		if (comp < 0  ||  (comp == 0  &&  ! after))
+			high = middle;
+		else
+			low = middle + 1;
+	}
+	*found = low;
+	return 1;
+}
+
+/* Find the first entry of INDEX matching the name searched for, and read
+ * its first line. Return 0 if the index cannot be read, or does not match
+ * the tag file. */
+static int findIndexed (tagFile *const file, nameIndex *const index,
+						tagResult *const result, unsigned long *const found)
+{
+	indexEntry entry;
+
+	*result = TagFailure;
+	if (! searchNameIndex (file, index, 0, found))
+		return 0;
+	if (*found == index->count)
+		return 1;
+	if (! readIndexEntry (index, *found, &entry))
+		return 0;
+	if (indexComparison (file, &entry) != 0)
+		return 1;
+	if (seekTagFile (file, entry.pos) != 0  ||  ! readTagLine (file)  ||
+		nameComparison (file) != 0)
+		return 0;
+	*result = TagSuccess;
+	return 1;
+}
+
+/* Count the lines matching the name searched for with the index. */
+static int countIndexed (tagFile *const file, unsigned long *const count)
+{
+	nameIndex *const index = &file->index;
+	tagResult result;
+	unsigned long first, last;
+	indexEntry entry;
+
+	*count = 0;
+	if (! findIndexed (file, index, &result, &first))
+		return 0;
+	if (result != TagSuccess)
+		return 1;
+	if (! searchNameIndex (file, index, 1, &last))
+		return 0;
+	if (last == index->count)
+		*count = index->lines;
+	else if (readIndexEntry (index, last, &entry))
+		*count = entry.ordinal;
+	else
+		return 0;
+	if (! readIndexEntry (index, first, &entry)  ||  *count < entry.ordinal)
+		return 0;
+	*count -= entry.ordinal;
+	return 1;
+}
+
+/* Can the fold index be used for the search which is started? The lines
+ * matching a name ignoring case are spread over a tag file sorted with
+ * case, and are found in runs listed by the index. */
+static int useFoldIndex (tagFile *const file)
+{
+	return (file->sortMethod == TAG_SORTED  &&  file->search.ignorecase  &&
+			! file->search.substring  &&  useNameIndex (file, &file->foldIndex));
+}
+
+/* Find the first line matching the name searched for with the fold index. */
+static int findFolded (tagFile *const file, tagResult *const result)
+{
+	indexEntry entry;
+
+	if (! findIndexed (file, &file->foldIndex, result, &file->search.foldEntry))
+		return 0;
+	if (*result == TagSuccess)
+	{
+		if (! readIndexEntry (&file->foldIndex, file->search.foldEntry, &entry)  ||
+			entry.ordinal == 0)
+			return 0;
+		file->search.folded = 1;
+		file->search.foldLines = entry.ordinal - 1;
+	}
+	return 1;
+}
+
+/* Read the next line matching the name searched for with the fold index:
+ * the next line of the run, or the first one of the next run. */
+static tagResult findNextFolded (tagFile *const file)
+{
+	indexEntry entry;
+
+	if (file->search.foldLines > 0)
+	{
+		--file->search.foldLines;
+		return readTagLine (file)? TagSuccess: TagFailure;
+	}
+	if (++file->search.foldEntry >= file->foldIndex.count  ||
+		! readIndexEntry (&file->foldIndex, file->search.foldEntry, &entry)  ||
+		entry.ordinal == 0  ||
+		indexComparison (file, &entry) != 0  ||
+		seekTagFile (file, entry.pos) != 0  ||  ! readTagLine (file)  ||
+		nameComparison (file) != 0)
+		return TagFailure;
+	file->search.foldLines = entry.ordinal - 1;
+	return TagSuccess;
+}
+
+/* Count the lines matching the name searched for with the fold index. */
+static int countFolded (tagFile *const file, unsigned long *const count)
+{
+	nameIndex *const index = &file->foldIndex;
+	tagResult result;
+	unsigned long i;
+	indexEntry entry;
+
+	*count = 0;
+	if (! findIndexed (file, index, &result, &i))
+		return 0;
+	for (  ;  result == TagSuccess  &&  i < index->count  ;  ++i)
+	{
+		if (! readIndexEntry (index, i, &entry))
+			return 0;
+		if (indexComparison (file, &entry) != 0)
+			break;
+		*count += entry.ordinal;
+	}
+	return 1;
+}
+
+/* Read the input I of the input index, with its name. */
+static int readInputEntry (tagFile *const file, const unsigned long i,
+						   inputEntry *const entry)
+{
+	nameIndex *const index = &file->inputIndex;
+	unsigned char buffer [INPUT_INDEX_ENTRY_SIZE];
+	const size_t offset = NAME_INDEX_HEADER_SIZE + INPUT_INDEX_ENTRY_SIZE * (size_t) i;
+	const unsigned char *bytes = readIndexBytes (index, offset,
+												 INPUT_INDEX_ENTRY_SIZE, buffer);
+	size_t nameOffset;
+
+	if (bytes == NULL)
+		return 0;
+	nameOffset = (size_t) getOffset (bytes);
+	entry->nameLength = (size_t) getNumber (bytes + 8, 4);
+	entry->firstRun = getNumber (bytes + 12, 4);
+	if (i + 1 == index->count)
+		entry->endRun = index->lines;
+	else if ((bytes = readIndexBytes (index, offset + INPUT_INDEX_ENTRY_SIZE,
+									  INPUT_INDEX_ENTRY_SIZE, buffer)) != NULL)
+		entry->endRun = getNumber (bytes + 12, 4);
+	else
+		return 0;
+	if (entry->firstRun >= entry->endRun  ||  entry->endRun > index->lines)
+		return 0;
+
+	while (index->data == NULL  &&  entry->nameLength >= file->inputName.size)
+		if (! growString (&file->inputName))
+			return 0;
+	bytes = readIndexBytes (index, nameOffset, entry->nameLength,
+							file->inputName.buffer);
+	if (bytes == NULL)
+		return 0;
+	entry->name = (const char *) bytes;
+	return 1;
+}
+
+/* Read the run R of the input index. */
+static int readInputRun (tagFile *const file, const unsigned long r,
+						 off_t *const pos, unsigned long *const lines)
+{
+	nameIndex *const index = &file->inputIndex;
+	unsigned char buffer [INPUT_INDEX_ENTRY_SIZE];
+	const unsigned char *const bytes = readIndexBytes (index,
+		NAME_INDEX_HEADER_SIZE + INPUT_INDEX_ENTRY_SIZE * (size_t) (index->count + r),
+		INPUT_INDEX_ENTRY_SIZE, buffer);
+
+	if (bytes == NULL)
+		return 0;
+	*pos = getOffset (bytes);
+	*lines = getNumber (bytes + 8, 4);
+	return *lines > 0;
+}
+
+/* Find the first input of the input index whose name matches the name
+ * searched for or comes after it. */
+static int searchInputIndex (tagFile *const file, unsigned long *const found)
+{
+	unsigned long low = 0;
+	unsigned long high = file->inputIndex.count;
+	while (low < high)
+	{
+		const unsigned long middle = low + (high - low) / 2;
+		inputEntry entry;
+
+		if (! readInputEntry (file, middle, &entry))
+			return 0;
+		if (mappedNameComparison (file, entry.name, entry.nameLength) <= 0)
+			high = middle;
+		else
+			low = middle + 1;
+	}
+	*found = low;
+	return 1;
+}
+
+/* Read the first line of the run of the search in the input index. */
+static int readFirstOfInputRun (tagFile *const file)
+{
+	off_t pos;
+	unsigned long lines;
+
+	if (! readInputRun (file, file->search.inputRun, &pos, &lines)  ||
+		seekTagFile (file, pos) != 0  ||  ! readTagLine (file)  ||
+		matchComparison (file) != 0)
+		return 0;
+	file->search.inputLines = lines - 1;
+	return 1;
+}
+
+/* Find the first line of the first input matching the name searched for
+ * with the input index. Return 0 if the index cannot be read, or does not
+ * match the tag file. */
+static int findInputIndexed (tagFile *const file, tagResult *const result)
+{
+	inputEntry entry;
+	unsigned long found;
+
+	*result = TagFailure;
+	if (! searchInputIndex (file, &found))
+		return 0;
+	if (found == file->inputIndex.count)
+		return 1;
+	if (! readInputEntry (file, found, &entry))
+		return 0;
+	if (mappedNameComparison (file, entry.name, entry.nameLength) != 0)
+		return 1;
+	file->search.inputEntry = found;
+	file->search.inputRun = entry.firstRun;
+	file->search.inputRunEnd = entry.endRun;
+	if (! readFirstOfInputRun (file))
+		return 0;
+	file->search.indexed = 1;
+	*result = TagSuccess;
+	return 1;
+}
+
+/* Read the next line matching the name searched for with the input
+ * index: the next line of the run, the first one of the next run of the
+ * input, or the first one of the next input for a partial match. */
+static tagResult findNextInputIndexed (tagFile *const file)
+{
+	if (file->search.inputLines > 0)
+	{
+		--file->search.inputLines;
+		return readTagLine (file)? TagSuccess: TagFailure;
+	}
+	if (++file->search.inputRun >= file->search.inputRunEnd)
+	{
+		inputEntry entry;
+
+		if (++file->search.inputEntry >= file->inputIndex.count  ||
+			! readInputEntry (file, file->search.inputEntry, &entry)  ||
+			mappedNameComparison (file, entry.name, entry.nameLength) != 0)
+			return TagFailure;
+		file->search.inputRun = entry.firstRun;
+		file->search.inputRunEnd = entry.endRun;
+	}
+	return readFirstOfInputRun (file)? TagSuccess: TagFailure;
+}
+
+/* Count the lines matching the name searched for with the input index. */
+static int countInputIndexed (tagFile *const file, unsigned long *const count)
+{
+	unsigned long i, r;
+	inputEntry entry;
+
+	*count = 0;
+	if (! searchInputIndex (file, &i))
+		return 0;
+	for (  ;  i < file->inputIndex.count  ;  ++i)
+	{
+		if (! readInputEntry (file, i, &entry))
+			return 0;
+		if (mappedNameComparison (file, entry.name, entry.nameLength) != 0)
+			break;
+		for (r = entry.firstRun  ;  r < entry.endRun  ;  ++r)
+		{
+			off_t pos;
+			unsigned long lines;
+			if (! readInputRun (file, r, &pos, &lines))
+				return 0;
+			*count += lines;
+		}
+	}
+	return 1;
+}
+
+/* Does the name filter tell that no tag has the name searched for? It
+ * does not for the partial and substring matches, nor for the pseudo
+ * tags, which are not in it. */
+static int isFilteredOut (tagFile *const file)
+{
+	nameIndex *const filter = &file->nameFilter;
+	const unsigned char *name = (const unsigned char *) file->search.name;
+	unsigned long h1 = 2166136261UL;
+	unsigned long h2 = 5381;
+	unsigned long mask, i;
+
+	if (filter->fp == NULL  ||  filter->tagFileSize != file->size  ||
+		file->search.partial  ||  file->search.input  ||  file->search.substring  ||
+		strncmp (file->search.name, PseudoTagPrefix, strlen (PseudoTagPrefix)) == 0)
+		return 0;
+	mapNameIndex (file, filter);
+
+	/* The hashes of the name with its letters folded, as ctags makes them. */
+	for (  ;  *name != '\0'  ;  ++name)
+	{
+		const unsigned char c = (*name >= 'a'  &&  *name <= 'z')
+			? (unsigned char) (*name - 'a' + 'A'): *name;
+		h1 = ((h1 ^ c) * 16777619UL) & 0xFFFFFFFFUL;
+		h2 = (h2 * 33 + c) & 0xFFFFFFFFUL;
+	}
+	h2 |= 1;
+
+	mask = (filter->lines < 32)? (1UL << filter->lines) - 1: 0xFFFFFFFFUL;
+	for (i = 0  ;  i < filter->count  ;  ++i)
+	{
+		const unsigned long bit = (h1 + i * h2) & mask;
+		unsigned char buffer;
+		const unsigned char *const byte = readIndexBytes (filter,
+			NAME_INDEX_HEADER_SIZE + (size_t) (bit / 8), 1, &buffer);
+
+		if (byte == NULL)
+		{
+			/* The filter is not the one of the tag file. */
+			closeNameIndex (filter);
+			return 0;
+		}
+		if ((*byte & (1U << (bit % 8))) == 0)
+			return 1;
+	}
+	return 0;
+}
+
+/* Can the trigram index be used for the search which is started? A name
+ * shorter than a trigram is searched for in all the lines. */
+static int useTrigramIndex (tagFile *const file)
+{
+	nameIndex *const index = &file->trigramIndex;
+
+	if (index->fp == NULL  ||  index->tagFileSize != file->size  ||
+		file->search.nameLength < 3)
+		return 0;
+	mapNameIndex (file, index);
+	return 1;
+}
+
+/* A trigram of the trigram index, with its list of runs */
+typedef struct {
+	unsigned char trigram [3];
+	unsigned long count;
+	size_t offset;
+	size_t length;
+} trigramEntry;
+
+static int readTrigramEntry (nameIndex *const index, const unsigned long i,
+							 trigramEntry *const entry)
+{
+	unsigned char buffer [2 * TRIGRAM_INDEX_ENTRY_SIZE];
+	const size_t offset = NAME_INDEX_HEADER_SIZE + TRIGRAM_INDEX_ENTRY_SIZE * (size_t) i;
+	const size_t end = NAME_INDEX_HEADER_SIZE + TRIGRAM_INDEX_ENTRY_SIZE
+		* (size_t) (index->count + index->lines);
+	const int last = (i + 1 == index->count);
+	const unsigned char *const bytes = readIndexBytes (index, offset,
+		(last? 1: 2) * TRIGRAM_INDEX_ENTRY_SIZE, buffer);
+	size_t next;
+
+	if (bytes == NULL)
+		return 0;
+	memcpy (entry->trigram, bytes, 3);
+	entry->count = getNumber (bytes + 4, 4);
+	entry->offset = (size_t) getOffset (bytes + 8);
+	next = last? index->size: (size_t) getOffset (bytes + TRIGRAM_INDEX_ENTRY_SIZE + 8);
+	if (entry->offset < end  ||  next < entry->offset  ||  next > index->size)
+		return 0;
+	entry->length = next - entry->offset;
+	return 1;
+}
+
+/* Find TRIGRAM in the trigram index, setting FOUND to 0 if it is not in
+ * it. Return 0 if the index cannot be read. */
+static int searchTrigramIndex (tagFile *const file, const unsigned char *const trigram,
+							   trigramEntry *const entry, int *const found)
+{
+	unsigned long low = 0;
+	unsigned long high = file->trigramIndex.count;
+
+	*found = 0;
+	while (low < high)
+	{
+		const unsigned long mid = low + (high - low) / 2;
+		int comp;
+
+		if (! readTrigramEntry (&file->trigramIndex, mid, entry))
+			return 0;
+		comp = memcmp (trigram, entry->trigram, 3);
+		if (comp == 0)
+		{
+			*found = 1;
+			return 1;
+		}
+		else if (comp < 0)
+			high = mid;
+		else
+			low = mid + 1;
+	}
+	return 1;
+}
+
+/* Read a number of the list of runs at P, before END. */
+static int readPostingNumber (const unsigned char **const p,
+							  const unsigned char *const end, unsigned long *const n)
+{
+	unsigned int shift = 0;
+
+	*n = 0;
+	while (*p < end  &&  shift < 32)
+	{
+		const unsigned char c = *(*p)++;
+		*n |= (unsigned long) (c & 0x7F) << shift;
+		if ((c & 0x80) == 0)
+			return 1;
+		shift += 7;
+	}
+	return 0;
+}
+
+/* Keep of the candidates of the search the runs listed by ENTRY, or take
+ * them all if there is no candidate yet. */
+static int intersectTrigramRuns (tagFile *const file, const trigramEntry *const entry,
+								 const int first)
+{
+	nameIndex *const index = &file->trigramIndex;
+	unsigned long *const candidates = file->search.candidates;
+	unsigned char *buffer = NULL;
+	const unsigned char *p, *end;
+	unsigned long run = 0, i = 0, kept = 0, k;
+	int result = 1;
+
+	if (index->data == NULL  &&  entry->length > 0)
+	{
+		buffer = (unsigned char *) malloc (entry->length);
+		if (buffer == NULL)
+			return 0;
+	}
+	p = readIndexBytes (index, entry->offset, entry->length, buffer);
+	if (p == NULL)
+	{
+		free (buffer);
+		return 0;
+	}
+	end = p + entry->length;
+
+	for (k = 0  ;  k < entry->count  &&  (first  ||  i < file->search.candidateCount)  ;  ++k)
+	{
+		unsigned long delta;
+
+		if (! readPostingNumber (&p, end, &delta)  ||  run + delta >= index->lines)
+		{
+			result = 0;
+			break;
+		}
+		run += delta;
+		if (first)
+			candidates [kept++] = run;
+		else
+		{
+			while (i < file->search.candidateCount  &&  candidates [i] < run)
+				++i;
+			if (i < file->search.candidateCount  &&  candidates [i] == run)
+				candidates [kept++] = candidates [i++];
+		}
+	}
+	file->search.candidateCount = kept;
+	free (buffer);
+	return result;
+}
+
+/* Read the first line of the candidate run in which the name searched for
+ * is, from the one of the last match, and set `candidate' to it. */
+static tagResult findTrigramCandidate (tagFile *const file)
+{
+	nameIndex *const index = &file->trigramIndex;
+
+	for (  ;  file->search.candidate < file->search.candidateCount  ;  ++file->search.candidate)
+	{
+		unsigned char buffer [TRIGRAM_INDEX_ENTRY_SIZE];
+		const unsigned long run = file->search.candidates [file->search.candidate];
+		const unsigned char *const bytes = readIndexBytes (index,
+			NAME_INDEX_HEADER_SIZE + TRIGRAM_INDEX_ENTRY_SIZE
+			* (size_t) (index->count + run), TRIGRAM_INDEX_ENTRY_SIZE, buffer);
+		unsigned long lines;
+
+		if (bytes == NULL)
+			return TagFailure;
+		lines = getNumber (bytes + 8, 4);
+		if (lines == 0  ||  seekTagFile (file, getOffset (bytes)) != 0  ||
+			! readTagLine (file))
+			return TagFailure;
+		if (matchComparison (file) == 0)
+		{
+			file->search.trigramLines = lines - 1;
+			return TagSuccess;
+		}
+	}
+	return TagFailure;
+}
+
+/* Find the first line whose name contains the name searched for with the
+ * trigram index: the runs having all its trigrams, from the trigram of
+ * the fewest runs on, are checked one by one. Return 0 if the index
+ * cannot be read, or does not match the tag file. */
+static int findTrigramIndexed (tagFile *const file, tagResult *const result)
+{
+	const size_t n = file->search.nameLength - 2;
+	trigramEntry *const entries = (trigramEntry *) malloc (n * sizeof (trigramEntry));
+	size_t i, fewest = 0;
+	int ok = 1;
+
+	*result = TagFailure;
+	if (entries == NULL)
+		return 0;
+	for (i = 0  ;  i < n  ;  ++i)
+	{
+		unsigned char trigram [3];
+		int found, j;
+
+		for (j = 0  ;  j < 3  ;  ++j)
+		{
+			const unsigned char c = (unsigned char) file->search.name [i + j];
+			trigram [j] = (c >= 'a'  &&  c <= 'z')? (unsigned char) (c - 'a' + 'A'): c;
+		}
+		if (! searchTrigramIndex (file, trigram, entries + i, &found))
+		{
+			free (entries);
+			return 0;
+		}
+		if (! found)
+		{
+			free (entries);
+			return 1;
+		}
+		if (entries [i].count < entries [fewest].count)
+			fewest = i;
+	}
+
+	file->search.candidates = (unsigned long *) malloc (
+		(entries [fewest].count? entries [fewest].count: 1) * sizeof (unsigned long));
+	if (file->search.candidates == NULL)
+		ok = 0;
+	else
+		ok = intersectTrigramRuns (file, entries + fewest, 1);
+	for (i = 0  ;  ok  &&  i < n  &&  file->search.candidateCount > 0  ;  ++i)
+		if (i != fewest)
+			ok = intersectTrigramRuns (file, entries + i, 0);
+	free (entries);
+	if (! ok)
+		return 0;
+
+	file->search.candidate = 0;
+	file->search.trigrams = 1;
+	*result = findTrigramCandidate (file);
+	return 1;
+}
+
+/* Read the next line whose name contains the name searched for with the
+ * trigram index: the next line of the run, or the first one of the next
+ * candidate run in which it is. */
+static tagResult findNextTrigramIndexed (tagFile *const file)
+{
+	if (file->search.trigramLines > 0)
+	{
+		--file->search.trigramLines;
+		return readTagLine (file)? TagSuccess: TagFailure;
+	}
+	++file->search.candidate;
+	return findTrigramCandidate (file);
+}
+
+static int isSortedForSearch (tagFile *const file)
+{
+	if (file->search.input  ||  file->search.substring)
+		return 0;
+	return ((file->sortMethod == TAG_SORTED      && !file->search.ignorecase) ||
+			(file->sortMethod == TAG_FOLDSORTED  &&  file->search.ignorecase));
+}
+
+static void beginSearch (tagFile *const file, const char *const name,
+						 const int options)
+{
+	if (file->search.name != NULL)
+		free (file->search.name);
 	file->search.name = duplicate (name);
 	file->search.nameLength = strlen (name);
 	file->search.partial = (options & TAG_PARTIALMATCH) != 0;
 	file->search.ignorecase = (options & TAG_IGNORECASE) != 0;
-	fseek (file->fp, 0, SEEK_END);
-	file->size = ftell (file->fp);
-	rewind (file->fp);
-	if ((file->sortMethod == TAG_SORTED      && !file->search.ignorecase) ||
-		(file->sortMethod == TAG_FOLDSORTED  &&  file->search.ignorecase))
+	file->search.folded = 0;
+	file->search.input = (options & TAG_INPUTMATCH) != 0;
+	file->search.indexed = 0;
+	file->search.substring = (options & TAG_SUBSTRINGMATCH) != 0;
+	file->search.trigrams = 0;
+	if (file->search.substring)
+		file->search.partial = 0;
+	if (file->search.candidates != NULL)
+		free (file->search.candidates);
+	file->search.candidates = NULL;
+	file->search.candidateCount = 0;
+	file->limit = 0;
+	if (! file->frames.compressed)
+	{
+		fseek (file->fp, 0, SEEK_END);
+		file->size = ftell (file->fp);
+		rewind (file->fp);
+	}
+#ifdef READTAGS_USE_MMAP
+	/* Mapping the file costs more than it saves for a single search,
+	 * which is the recommended use; it pays from the second one on. */
+	if (file->search.count++ > 0  &&  ! file->map.pinned  &&  ! file->frames.compressed
+		&&  (file->map.data == NULL  ||  file->map.size != file->size))
+		mapTagFile (file, file->size);
+#endif
+	seekTagFile (file, 0);
+}
+
+static tagResult findFirst (tagFile *const file, tagEntry *const entry)
+{
+	tagResult result;
+	unsigned long found;
+	if (isFilteredOut (file))
+	{
+#ifdef DEBUG
+		printf ("<filtered out>\n");
+#endif
+		result = TagFailure;
+	}
+	else if (file->search.input)
+	{
+		int indexed = 0;
+		if (useInputIndex (file))
+		{
+#ifdef DEBUG
+			printf ("<performing input indexed search>\n");
+#endif
+			indexed = findInputIndexed (file, &result);
+			if (! indexed)
+			{
+				/* The index is not the one of the tag file. */
+				closeNameIndex (&file->inputIndex);
+				file->search.indexed = 0;
+			}
+		}
+		if (! indexed)
+		{
+#ifdef DEBUG
+			printf ("<performing sequential search of inputs>\n");
+#endif
+			gotoFirstLogicalTag (file);
+			result = findSequential (file);
+		}
+	}
+	else if (file->search.substring)
+	{
+		int indexed = 0;
+		if (useTrigramIndex (file))
+		{
+#ifdef DEBUG
+			printf ("<performing trigram indexed search>\n");
+#endif
+			indexed = findTrigramIndexed (file, &result);
+			if (! indexed)
+			{
+				/* The index is not the one of the tag file. */
+				closeNameIndex (&file->trigramIndex);
+				file->search.trigrams = 0;
+			}
+		}
+		if (! indexed)
+		{
+#ifdef DEBUG
+			printf ("<performing sequential search of substrings>\n");
+#endif
+			gotoFirstLogicalTag (file);
+			result = findSequential (file);
+		}
+	}
+	else if (isSortedForSearch (file)  &&  useNameIndex (file, &file->index))
+	{
+#ifdef DEBUG
+		printf ("<performing indexed search>\n");
+#endif
+		if (! findIndexed (file, &file->index, &result, &found))
+		{
+			/* The index is not the one of the tag file. */
+			closeNameIndex (&file->index);
+			seekTagFile (file, 0);
+			result = findBinary (file);
+		}
+	}
+	else if (useFoldIndex (file))
+	{
+#ifdef DEBUG
+		printf ("<performing folded indexed search>\n");
+#endif
+		if (! findFolded (file, &result))
+		{
+			closeNameIndex (&file->foldIndex);
+			file->search.folded = 0;
+			seekTagFile (file, 0);
+			result = findSequential (file);
+		}
+	}
+	else if (isSortedForSearch (file))
 	{
 #ifdef DEBUG
 		printf ("<performing binary search>\n");
@@ -707,11 +2524,35 @@ static tagResult find (tagFile *const file, tagEntry *const entry,
 	return result;
 }
 
+static tagResult find (tagFile *const file, tagEntry *const entry,
+					   const char *const name, const int options)
+{
+	beginSearch (file, name, options);
+	return findFirst (file, entry);
+}
+
 static tagResult findNext (tagFile *const file, tagEntry *const entry)
 {
 	tagResult result;
-	if ((file->sortMethod == TAG_SORTED      && !file->search.ignorecase) ||
-		(file->sortMethod == TAG_FOLDSORTED  &&  file->search.ignorecase))
+	if (file->search.indexed)
+	{
+		result = findNextInputIndexed (file);
+		if (result == TagSuccess  &&  entry != NULL)
+			parseTagLine (file, entry);
+	}
+	else if (file->search.trigrams)
+	{
+		result = findNextTrigramIndexed (file);
+		if (result == TagSuccess  &&  entry != NULL)
+			parseTagLine (file, entry);
+	}
+	else if (file->search.folded)
+	{
+		result = findNextFolded (file);
+		if (result == TagSuccess  &&  entry != NULL)
+			parseTagLine (file, entry);
+	}
+	else if (isSortedForSearch (file))
 	{
 		result = tagsNext (file, entry);
 		if (result == TagSuccess  && nameComparison (file) != 0)
@@ -726,6 +2567,60 @@ static tagResult findNext (tagFile *const file, tagEntry *const entry)
 	return result;
 }
 
+static tagResult countMatches (tagFile *const file, const char *const name,
+							  const int options, unsigned long *const count)
+{
+	tagResult result;
+
+	beginSearch (file, name, options);
+	if (isFilteredOut (file))
+	{
+		*count = 0;
+		file->search.pos = file->size;
+		return TagFailure;
+	}
+	else if (file->search.input  &&  useInputIndex (file))
+	{
+		if (countInputIndexed (file, count))
+		{
+			file->search.pos = file->size;
+			return (*count > 0)? TagSuccess: TagFailure;
+		}
+		closeNameIndex (&file->inputIndex);
+		seekTagFile (file, 0);
+	}
+	else if (isSortedForSearch (file)  &&  useNameIndex (file, &file->index))
+	{
+		if (countIndexed (file, count))
+		{
+			file->search.pos = file->size;
+			return (*count > 0)? TagSuccess: TagFailure;
+		}
+		closeNameIndex (&file->index);
+		seekTagFile (file, 0);
+	}
+	else if (useFoldIndex (file))
+	{
+		if (countFolded (file, count))
+		{
+			file->search.pos = file->size;
+			return (*count > 0)? TagSuccess: TagFailure;
+		}
+		closeNameIndex (&file->foldIndex);
+		seekTagFile (file, 0);
+	}
+
+	*count = 0;
+	result = findFirst (file, NULL);
+	if (result == TagSuccess)
+	{
+		do
+			++*count;
+		while (findNext (file, NULL) == TagSuccess);
+	}
+	return result;
+}
+
 /*
 *  EXTERNAL INTERFACE
 */
@@ -751,12 +2646,31 @@ extern tagResult tagsFirst (tagFile *const file, tagEntry *const entry)
 	tagResult result = TagFailure;
 	if (file != NULL  &&  file->initialized)
 	{
+		file->limit = 0;
 		gotoFirstLogicalTag (file);
 		result = readNext (file, entry);
 	}
 	return result;
 }
 
+extern tagResult tagsFirstInRange (tagFile *const file, tagEntry *const entry,
+								   const long start, const long end)
+{
+	tagResult result = TagFailure;
+	if (file != NULL  &&  file->initialized  &&  start < end)
+	{
+		file->limit = 0;
+		gotoFirstLogicalTag (file);
+		/* Skip the line START - 1 is on, which begins before START. */
+		if (start > tellTagFile (file)
+			&&  (seekTagFile (file, start - 1) != 0  ||  ! readTagLineRaw (file)))
+			return result;
+		file->limit = end;
+		result = readNext (file, entry);
+	}
+	return result;
+}
+
 extern tagResult tagsNext (tagFile *const file, tagEntry *const entry)
 {
 	tagResult result = TagFailure;
@@ -782,6 +2696,17 @@ extern tagResult tagsFind (tagFile *const file, tagEntry *const entry,
 	return result;
 }
 
+extern tagResult tagsCount (tagFile *const file, const char *const name,
+							const int options, unsigned long *const count)
+{
+	tagResult result = TagFailure;
+	if (count != NULL)
+		*count = 0;
+	if (file != NULL  &&  file->initialized  &&  count != NULL)
+		result = countMatches (file, name, options, count);
+	return result;
+}
+
 extern tagResult tagsFindNext (tagFile *const file, tagEntry *const entry)
 {
 	tagResult result = TagFailure;
@@ -790,6 +2715,103 @@ extern tagResult tagsFindNext (tagFile *const file, tagEntry *const entry)
 	return result;
 }
 
+extern unsigned int tagsViewNext (tagFile *const file, tagEntryView *const views,
+								  const unsigned int count)
+{
+	unsigned int n = 0;
+	if (file != NULL  &&  file->initialized  &&  pinTagFile (file))
+	{
+		while (n < count  &&  readNext (file, NULL) == TagSuccess)
+			parseTagView (file, views + n++);
+	}
+	return n;
+}
+
+extern unsigned int tagsViewFind (tagFile *const file, tagEntryView *const views,
+								  const unsigned int count,
+								  const char *const name, const int options)
+{
+	unsigned int n = 0;
+	if (file != NULL  &&  file->initialized  &&  count > 0  &&  pinTagFile (file)
+		&&  find (file, NULL, name, options) == TagSuccess)
+	{
+		parseTagView (file, views + n++);
+		while (n < count  &&  findNext (file, NULL) == TagSuccess)
+			parseTagView (file, views + n++);
+	}
+	return n;
+}
+
+extern unsigned int tagsViewFindNext (tagFile *const file, tagEntryView *const views,
+									  const unsigned int count)
+{
+	unsigned int n = 0;
+	if (file != NULL  &&  file->initialized  &&  pinTagFile (file))
+	{
+		while (n < count  &&  findNext (file, NULL) == TagSuccess)
+			parseTagView (file, views + n++);
+	}
+	return n;
+}
+
+extern tagResult tagsViewNextField (const tagEntryView *const view,
+									const char **const position,
+									tagString *const key, tagString *const value)
+{
+	const char *const end = view->fields.value + view->fields.length;
+	const char *field = (*position != NULL)? *position: view->fields.value;
+
+	if (view->fields.value == NULL)
+		return TagFailure;
+	while (field < end)
+	{
+		const char *const next = (const char *) memchr (field, TAB, end - field);
+		const char *const fieldEnd = next? next: end;
+		const char *const colon = (const char *) memchr (field, ':', fieldEnd - field);
+
+		*position = fieldEnd + 1;
+		if (colon != NULL)
+		{
+			setString (key, field, colon);
+			setString (value, colon + 1, fieldEnd);
+			if (! ((key->length == 4  &&  strncmp (key->value, "kind", 4) == 0)  ||
+				   (key->length == 4  &&  strncmp (key->value, "file", 4) == 0)  ||
+				   (key->length == 4  &&  strncmp (key->value, "line", 4) == 0)))
+				return TagSuccess;
+		}
+		field = fieldEnd + 1;
+	}
+	*position = end;
+	return TagFailure;
+}
+
+extern tagResult tagsViewField (const tagEntryView *const view, const char *const key,
+								tagString *const value)
+{
+	const size_t length = strlen (key);
+	const char *position = NULL;
+	tagString k;
+
+	if (strcmp (key, "kind") == 0)
+	{
+		*value = view->kind;
+		return (view->kind.value != NULL)? TagSuccess: TagFailure;
+	}
+	else if (strcmp (key, "file") == 0)
+	{
+		/* as tagsField() does */
+		value->value = EmptyString;
+		value->length = 0;
+		return TagSuccess;
+	}
+	while (tagsViewNextField (view, &position, &k, value) == TagSuccess)
+	{
+		if (k.length == length  &&  strncmp (k.value, key, length) == 0)
+			return TagSuccess;
+	}
+	return TagFailure;
+}
+
 extern tagResult tagsClose (tagFile *const file)
 {
 	tagResult result = TagFailure;
@@ -15,10 +15,15 @@
 *   to this approach permits a user to regenerate a tag file at will without
 *   the tool needing to detect and resynchronize with changes to the tag file.
 *   Even for an unsorted 24MB tag file, tag searches take about one second.
+*
+*   The library keeps no state out of the tagFile handles, so that several
+*   tag files can be searched at once, each handle by one thread.
 */
 #ifndef READTAGS_H
 #define READTAGS_H
 
+#include <stddef.h>  /* to declare size_t */
+
 #ifdef __cplusplus
 extern "C" {
 #endif
@@ -39,6 +44,10 @@ typedef enum {
 #define TAG_OBSERVECASE   0x0
 #define TAG_IGNORECASE    0x2
 
+#define TAG_INPUTMATCH    0x4
+
+#define TAG_SUBSTRINGMATCH 0x8
+
 /*
 *  DATA DECLARATIONS
 */
@@ -137,6 +146,53 @@ typedef struct {
 
 } tagEntry;
 
+/* This structure contains a string in a tag file, which is not terminated
+ * with a null character.
+ */
+typedef struct {
+
+		/* first character of the string (null if not present) */
+	const char *value;
+
+		/* number of characters of the string */
+	size_t length;
+
+} tagString;
+
+/* This structure contains the same information as tagEntry, for the views
+ * functions. The strings point into the tag file, which is kept in memory
+ * until tagsClose(), and are not overwritten by following calls.
+ */
+typedef struct {
+
+		/* name of tag */
+	tagString name;
+
+		/* path of source file containing definition of tag */
+	tagString file;
+
+		/* address for locating tag in source file */
+	struct {
+			/* pattern or line number for locating source line */
+		tagString pattern;
+
+			/* line number in source file of tag definition
+			 * (may be zero if not known) */
+		unsigned long lineNumber;
+	} address;
+
+		/* kind of tag (may by name, character, or not present) */
+	tagString kind;
+
+		/* is tag of file-limited scope? */
+	short fileScope;
+
+		/* extension fields, separated with tabs, as they are in the tag
+		 * file; see tagsViewNextField() */
+	tagString fields;
+
+} tagEntryView;
+
 
 /*
 *  FUNCTION PROTOTYPES
@@ -189,6 +245,17 @@ extern tagResult tagsFirst (tagFile *const file, tagEntry *const entry);
 */
 extern tagResult tagsNext (tagFile *const file, tagEntry *const entry);
 
+/*
+*  Like tagsFirst(), but for the part of the file made of the lines which
+*  begin at offset `start' or after it, and before offset `end', which must
+*  be greater; tagsNext() then returns TagFailure at the first line beginning
+*  at `end' or after it. The lines of a file split at any offsets are so read
+*  once each, in order, by reading ranges one after the other, or in parallel
+*  with a tag file opened for each range. Calling tagsFirst() reads the whole
+*  file again.
+*/
+extern tagResult tagsFirstInRange (tagFile *const file, tagEntry *const entry, const long start, const long end);
+
 /*
 *  Retrieve the value associated with the extension field for a specified key.
 *  It is passed a pointer to a structure already populated with values by a
@@ -220,8 +287,41 @@ extern const char *tagsField (const tagEntry *const entry, const char *const key
 *        Matching will be performed in a case-sensitive manner. Note that
 *        this enables binary searches of the tag file.
 *
+*    TAG_INPUTMATCH
+*        Match `name' with the input file of the tags (the path of their
+*        source file) instead of their name, with the other options. The
+*        tags of an input come in the order of the tag file, which need not
+*        be sorted; with TAG_PARTIALMATCH, the tags of the inputs starting
+*        with `name' may come input by input.
+*
+*    TAG_SUBSTRINGMATCH
+*        Tags whose names contain `name' anywhere will qualify, in the order
+*        of the tag file; the pseudo tags do not. With TAG_INPUTMATCH, the
+*        tags whose input file contains `name'. It takes over
+*        TAG_PARTIALMATCH.
+*
 *  The function will return TagSuccess if a tag matching the name is found, or
 *  TagFailure if not.
+*
+*  If the tag file has an input index, a file named after it with ".iidx"
+*  appended and written by ctags with --input-index, the tags of an input
+*  are found with it without reading the lines of the other inputs, unless
+*  TAG_IGNORECASE is given.
+*
+*  If the tag file has a name index, a file named after it with ".idx"
+*  appended and written by ctags with --name-index, the first matching tag
+*  is found with it instead of bisecting the lines of the tag file.
+*
+*  If the tag file has a name filter, a file named after it with ".bflt"
+*  appended and written by ctags with --name-filter, a name which has no
+*  tag is mostly told by it without reading the tag file, unless
+*  TAG_PARTIALMATCH or TAG_INPUTMATCH is given. tagsCount() uses it too.
+*
+*  If the tag file has a trigram index, a file named after it with ".tidx"
+*  appended and written by ctags with --trigram-index, the tags whose name
+*  contains `name' are found with it for TAG_SUBSTRINGMATCH when `name' is at
+*  least three bytes long, reading only the lines of the names having all
+*  its trigrams.
 */
 extern tagResult tagsFind (tagFile *const file, tagEntry *const entry, const char *const name, const int options);
 
@@ -234,6 +334,45 @@ extern tagResult tagsFind (tagFile *const file, tagEntry *const entry, const cha
 */
 extern tagResult tagsFindNext (tagFile *const file, tagEntry *const entry);
 
+/*
+*  Count the tags which tagsFind() and tagsFindNext() would find for `name'
+*  and `options', and store the number at `count'. With the name index of
+*  a sorted tag file, the tags are counted without being read, which makes
+*  counting the tags of a prefix (TAG_PARTIALMATCH) cheap. The function will
+*  return TagSuccess if a tag matching the name is found, or TagFailure if
+*  not. tagsFindNext() must not be called after it.
+*/
+extern tagResult tagsCount (tagFile *const file, const char *const name, const int options, unsigned long *const count);
+
+/*
+*  The following functions are like tagsNext(), tagsFind() and
+*  tagsFindNext(), but store up to `count' entries at once in the array at
+*  `views', and return the number of entries stored, which is less than
+*  `count' only if there are no more entries. The strings of the entries
+*  are not copied: they point into the tag file, which the first call maps
+*  or reads into memory, and stay valid until tagsClose(). They may be
+*  mixed with the other functions, which go on after the last entry stored.
+*/
+extern unsigned int tagsViewNext (tagFile *const file, tagEntryView *const views, const unsigned int count);
+extern unsigned int tagsViewFind (tagFile *const file, tagEntryView *const views, const unsigned int count, const char *const name, const int options);
+extern unsigned int tagsViewFindNext (tagFile *const file, tagEntryView *const views, const unsigned int count);
+
+/*
+*  Step to the next extension field of an entry stored by the views
+*  functions, skipping `kind', `file' and `line' like the `fields' of
+*  tagEntry. `position' must point to a null pointer for the first field.
+*  The function will return TagSuccess and store the key and the value of
+*  the field if there is another field, or TagFailure if not.
+*/
+extern tagResult tagsViewNextField (const tagEntryView *const view, const char **const position, tagString *const key, tagString *const value);
+
+/*
+*  Like tagsField(), for an entry stored by the views functions. The
+*  function will return TagSuccess and store the value if the entry has a
+*  field of the key, or TagFailure if not.
+*/
+extern tagResult tagsViewField (const tagEntryView *const view, const char *const key, tagString *const value);
+
 /*
 *  Call tagsTerminate() at completion of reading the tag file, which will
 *  close the file and free any internal memory allocated. The function will
@@ -13,7 +13,9 @@ MIO_SRCS  = main/mio.c
 
 MAIN_HEADS =			\
 	main/args.h		\
+	main/cache.h		\
 	main/colprint.h		\
+	main/compressed.h	\
 	main/ctags.h		\
 	main/dependency.h	\
 	main/entry.h		\
@@ -24,15 +26,21 @@ MAIN_HEADS =			\
 	main/fmt.h		\
 	main/gcc-attr.h		\
 	main/general.h		\
+	main/gittree.h		\
 	main/htable.h		\
+	main/ignorefile.h	\
 	main/inline.h		\
 	main/interactive.h	\
 	main/keyword.h		\
 	main/kind.h		\
+	main/lineprefix.h	\
+	main/litmatch.h		\
 	main/lregex.h		\
 	main/lxpath.h		\
 	main/main.h		\
 	main/mbcs.h		\
+	main/microbench.h	\
+	main/nameindex.h	\
 	main/nestlevel.h	\
 	main/objpool.h		\
 	main/options.h		\
@@ -44,12 +52,16 @@ MAIN_HEADS =			\
 	main/ptag.h		\
 	main/ptrarray.h		\
 	main/read.h		\
+	main/regexset.h		\
 	main/routines.h		\
 	main/selectors.h	\
 	main/sort.h		\
 	main/strlist.h		\
 	main/subparser.h	\
+	main/tagbuffer.h	\
+	main/tagindex.h		\
 	main/trace.h		\
+	main/traceevent.h	\
 	main/tokeninfo.h	\
 	main/trashbox.h		\
 	main/types.h		\
@@ -61,7 +73,9 @@ MAIN_HEADS =			\
 
 MAIN_SRCS =				\
 	main/args.c			\
+	main/cache.c			\
 	main/colprint.c			\
+	main/compressed.c		\
 	main/dependency.c		\
 	main/entry.c			\
 	main/entry_private.c		\
@@ -69,13 +83,19 @@ MAIN_SRCS =				\
 	main/field.c			\
 	main/flags.c			\
 	main/fmt.c			\
+	main/gittree.c			\
 	main/htable.c			\
+	main/ignorefile.c		\
 	main/keyword.c			\
 	main/kind.c			\
+	main/lineprefix.c		\
+	main/litmatch.c		\
 	main/lregex.c			\
 	main/lxpath.c			\
 	main/main.c			\
 	main/mbcs.c			\
+	main/microbench.c		\
+	main/nameindex.c		\
 	main/nestlevel.c		\
 	main/objpool.c			\
 	main/options.c			\
@@ -86,16 +106,22 @@ MAIN_SRCS =				\
 	main/ptag.c			\
 	main/ptrarray.c			\
 	main/read.c			\
+	main/regexset.c		\
 	main/routines.c			\
 	main/seccomp.c			\
 	main/selectors.c		\
 	main/sort.c			\
 	main/strlist.c			\
+	main/tagbuffer.c		\
+	main/tagindex.c			\
 	main/trace.c			\
+	main/traceevent.c		\
 	main/trashbox.c			\
 	main/tokeninfo.c		\
 	main/vstring.c			\
 	main/writer.c			\
+	main/writer-binary.c		\
+	main/writer-protobuf.c		\
 	main/writer-etags.c		\
 	main/writer-ctags.c		\
 	main/writer-json.c		\
@@ -124,6 +150,7 @@ PARSER_HEADS = \
 	parsers/iniconf.h \
 	parsers/m4.h \
 	parsers/make.h \
+	parsers/sexp.h \
 	parsers/tcl.h \
 	\
 	$(NULL)
@@ -202,6 +229,7 @@ PARSER_SRCS =				\
 	parsers/ruby.c			\
 	parsers/rust.c			\
 	parsers/scheme.c		\
+	parsers/sexp.c			\
 	parsers/sh.c			\
 	parsers/slang.c			\
 	parsers/sml.c			\